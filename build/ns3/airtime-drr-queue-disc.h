@@ -0,0 +1,206 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef AIRTIME_DRR_QUEUE_DISC_H
+#define AIRTIME_DRR_QUEUE_DISC_H
+
+#include "ns3/queue-disc.h"
+#include "ns3/object-factory.h"
+#include "ns3/mac48-address.h"
+#include "ns3/nstime.h"
+#include <list>
+#include <map>
+#include <set>
+
+namespace ns3 {
+
+class NetDevice;
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A station queue used by the AirtimeDrr queue disc
+ */
+class AirtimeDrrStation : public QueueDiscClass {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief AirtimeDrrStation constructor
+   */
+  AirtimeDrrStation ();
+
+  virtual ~AirtimeDrrStation ();
+
+  /**
+   * \brief Set the airtime deficit of this station
+   * \param deficit the airtime deficit of this station
+   */
+  void SetDeficit (Time deficit);
+  /**
+   * \brief Get the airtime deficit of this station
+   * \return the airtime deficit of this station
+   */
+  Time GetDeficit (void) const;
+  /**
+   * \brief Increase the airtime deficit of this station
+   * \param deficit the airtime by which the deficit is to be increased
+   */
+  void IncreaseDeficit (Time deficit);
+  /**
+   * \brief Estimate the airtime needed to transmit the given amount of bytes
+   *        to this station, at the rate of the last reported transmission
+   * \param size the amount of bytes
+   * \return the estimated airtime, or zero if no transmission was reported
+   */
+  Time EstimateAirtime (uint32_t size) const;
+  /**
+   * \brief Charge this station with the estimated airtime of bytes dequeued
+   *        for it, until the actual airtime is reported
+   * \param size the amount of bytes dequeued
+   * \param airtime the estimated airtime of the bytes dequeued
+   */
+  void ChargeEstimate (uint32_t size, Time airtime);
+  /**
+   * \brief Charge this station with the actual airtime of a transmission,
+   *        replacing the estimated airtime charged for the bytes transmitted
+   * \param size the amount of bytes transmitted
+   * \param airtime the airtime used by the transmission
+   */
+  void ChargeAirtime (uint32_t size, Time airtime);
+  /**
+   * \brief Set whether this station is in the list of active stations
+   * \param active whether this station is in the list of active stations
+   */
+  void SetActive (bool active);
+  /**
+   * \brief Get whether this station is in the list of active stations
+   * \return true if this station is in the list of active stations
+   */
+  bool IsActive (void) const;
+
+private:
+  Time m_deficit;            //!< the airtime deficit of this station
+  bool m_active;             //!< whether this station is in the list of active stations
+  uint32_t m_pendingBytes;   //!< bytes dequeued whose airtime is not reported yet
+  Time m_pendingAirtime;     //!< estimated airtime charged for the pending bytes
+  uint32_t m_lastTxBytes;    //!< bytes of the last reported transmission
+  Time m_lastTxAirtime;      //!< airtime of the last reported transmission
+};
+
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief An airtime deficit round robin packet queue disc
+ *
+ * The packets are classified by their destination address into station
+ * queues, each with a child CoDel queue disc. When the queue disc is full, a
+ * packet is dropped from the station queue with the largest backlog. The
+ * station queues are served in deficit round robin, where the deficit is the
+ * airtime of the station instead of bytes: a station at the head of the list
+ * of active stations is served as long as its deficit is positive, otherwise
+ * it gets a quantum of airtime and moves to the end of the list.
+ *
+ * When a packet is dequeued, the deficit of its station is decreased by an
+ * estimate of its airtime, based on the rate of the last transmission to the
+ * station. When the device reports the airtime actually used to transmit to
+ * the station, the estimate charged for the bytes transmitted is replaced by
+ * the actual airtime, which accounts for the retransmissions and for the
+ * overhead of the preambles shared by the MPDUs of an A-MPDU.
+ *
+ * At initialization time, the queue disc connects to the TxAirtime trace
+ * source of the device it is attached to (such as WifiNetDevice) and fails if
+ * the device does not provide it. A child of an mq queue disc is attached to
+ * the device too, and is only charged the airtime reported for its
+ * transmission queue. A queue disc that is not attached to any device (e.g.,
+ * the child of a queue disc other than mq) must be reported the airtime
+ * through ReportAirtime.
+ *
+ * Since the station at the head of the list is served until it runs out of
+ * deficit, its packets are handed to the device back to back, so that the
+ * device can aggregate them in an A-MPDU for that station.
+ */
+class AirtimeDrrQueueDisc : public QueueDisc {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief AirtimeDrrQueueDisc constructor
+   */
+  AirtimeDrrQueueDisc ();
+
+  virtual ~AirtimeDrrQueueDisc ();
+
+  /**
+   * \brief Charge a station with the airtime used to transmit to it
+   * \param station the address of the station
+   * \param size the size in bytes of the packets transmitted
+   * \param airtime the airtime used to transmit to the station
+   */
+  void ReportAirtime (Mac48Address station, uint32_t size, Time airtime);
+
+  // Reasons for dropping packets
+  static constexpr const char* LIMIT_EXCEEDED_DROP = "Queue disc limit exceeded";  //!< Packet dropped due to queue disc limit exceeded
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  virtual bool DoEnqueue (Ptr<QueueDiscItem> item);
+  virtual Ptr<QueueDiscItem> DoDequeue (void);
+  virtual bool CheckConfig (void);
+  virtual void InitializeParams (void);
+
+  /**
+   * \brief Drop a packet from the head of the station queue with the largest
+   *        backlog, when the queue disc is full
+   */
+  void AirtimeDrrDrop (void);
+
+  /**
+   * \brief Charge a station with the airtime reported by the device, if the
+   *        transmission queue is served by this queue disc
+   * \param station the address of the station
+   * \param txQueue the index of the transmission queue
+   * \param size the size in bytes of the packets transmitted
+   * \param airtime the airtime used to transmit to the station
+   */
+  void NotifyTxAirtime (Mac48Address station, uint8_t txQueue, uint32_t size, Time airtime);
+
+  std::string m_interval;    //!< CoDel interval attribute
+  std::string m_target;      //!< CoDel target attribute
+  Time m_quantum;            //!< Airtime deficit assigned to stations at each round
+
+  std::list<Ptr<AirtimeDrrStation> > m_activeStations;  //!< The list of active stations
+
+  std::map<Mac48Address, uint32_t> m_stationsIndices;  //!< Map with the index of class for each station
+  std::set<uint8_t> m_txQueues;                     //!< The transmission queues of the packets enqueued
+
+  Ptr<NetDevice> m_device;             //!< The device reporting the airtime, if any
+  ObjectFactory m_stationFactory;      //!< Factory to create a new station
+  ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
+};
+
+} // namespace ns3
+
+#endif /* AIRTIME_DRR_QUEUE_DISC_H */
@@ -0,0 +1,81 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2019 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Sébastien Deronne <sebastien.deronne@gmail.com>
+ */
+
+#ifndef CHANNEL_BONDING_MANAGER_H
+#define CHANNEL_BONDING_MANAGER_H
+
+#include "ns3/object.h"
+
+namespace ns3 {
+
+class WifiPhy;
+class WifiMode;
+
+/**
+ * \brief Channel Bonding Manager interface
+ * \ingroup wifi
+ *
+ * This object provides the interface for all channel bonding manager implementations
+ * and is designed to be subclassed.
+ *
+ */
+class ChannelBondingManager : public Object
+{
+public:
+  static TypeId GetTypeId (void);
+
+  /**
+   * Sets the WifiPhy this manager is associated with.
+   *
+   * \param phy the WifiPhy this manager is associated with
+   */
+  virtual void SetPhy (const Ptr<WifiPhy> phy);
+
+  /**
+   * Returns the selected channel width (in MHz).
+   *
+   * \param mode the WifiMode that will be used for the transmission
+   *
+   * \return the selected channel width in MHz
+   */
+  virtual uint16_t GetUsableChannelWidth (WifiMode mode) = 0;
+
+  /**
+   * Returns the 20 MHz subchannels to puncture for a transmission over the
+   * channel width returned by the last call to GetUsableChannelWidth.
+   * Bit i corresponds to the i-th 20 MHz subchannel of the transmission,
+   * starting from the lowest frequency. No subchannel is punctured by default.
+   *
+   * \param channelWidth the channel width (in MHz) of the transmission
+   *
+   * \return the bitmap of punctured 20 MHz subchannels
+   */
+  virtual uint8_t GetPuncturedSubchannels (uint16_t channelWidth) const;
+
+
+protected:
+  virtual void DoDispose (void);
+
+  Ptr<WifiPhy> m_phy; //!< Pointer to the WifiPhy
+};
+
+} //namespace ns3
+
+#endif /* CHANNEL_BONDING_MANAGER_H */
@@ -0,0 +1,101 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FF_MAC_RBG_ALLOCATOR_H
+#define FF_MAC_RBG_ALLOCATOR_H
+
+#include <stdint.h>
+#include <map>
+#include <vector>
+#include <ns3/ptr.h>
+
+namespace ns3 {
+
+class LteAmc;
+
+/**
+ * \ingroup ff-api
+ *
+ * \brief Shared core of the frequency domain FF MAC schedulers which allocate
+ * each RBG of a TTI to the UE with the highest metric for this RBG.
+ *
+ * At each TTI, the scheduler adds the UEs which can be allocated, looking up
+ * their CQIs, flow statistics and HARQ state in its maps once per UE, and sets
+ * the metric of each UE for each free RBG in a dense UE-indexed array. Then
+ * Allocate finds the best UE of every RBG in a single pass over the arrays, so
+ * that the cost of a TTI is linear in the number of UEs times the number of
+ * RBGs, instead of looking up the state of every UE for every RBG.
+ *
+ * A metric which is not greater than 0 (the initial value) never gets the
+ * RBG, and the ties are broken in favor of the UE added first, as done by the
+ * schedulers iterating over their UE maps in RNTI order.
+ */
+class FfMacRbgAllocator
+{
+public:
+  FfMacRbgAllocator ();
+
+  /**
+   * \brief Start the allocation of a TTI, removing all the UEs
+   * \param rbgNum the number of RBGs
+   * \param rbgSize the size of a RBG (in RBs)
+   * \param amc the AMC model used to evaluate the rate of the RBGs
+   */
+  void Reset (int rbgNum, int rbgSize, Ptr<LteAmc> amc);
+  /**
+   * \brief Add a UE which can be allocated in this TTI
+   * \param rnti the RNTI of the UE
+   * \return the metrics of the UE, one per RBG, initialized to 0, valid
+   * until the next UE is added
+   */
+  double* AddUe (uint16_t rnti);
+  /**
+   * \return the number of UEs added in this TTI
+   */
+  uint32_t GetNUes (void) const;
+  /**
+   * \brief Evaluate the achievable rate of a RBG
+   * \param sbCqi the subband CQI of each layer reported for the RBG
+   * \param nLayer the number of layers of the UE
+   * \return the achievable rate (bytes/s), i.e., the size of the TBs of all
+   * the layers, whose MCS is selected from the CQI (or is the lowest one
+   * without CQI for the layer), over a TTI
+   */
+  double GetRbgRate (const std::vector<uint8_t> &sbCqi, int nLayer) const;
+  /**
+   * \brief Allocate each free RBG to the UE with the highest metric for it
+   * \param rbgMap the RBGs already allocated, updated with the new allocations
+   * \param allocationMap the RBGs allocated to each RNTI, updated with the new
+   * allocations
+   */
+  void Allocate (std::vector<bool> &rbgMap, std::map<uint16_t, std::vector<uint16_t> > &allocationMap);
+
+private:
+  int m_rbgNum; ///< the number of RBGs
+  std::vector<uint16_t> m_rntis; ///< the RNTI of each UE
+  std::vector<double> m_metrics; ///< the metrics of each UE for each RBG, UE by UE
+  std::vector<double> m_bestMetric; ///< the highest metric of each RBG
+  std::vector<int32_t> m_bestUe; ///< the index of the UE with the highest metric of each RBG, or -1
+
+  Ptr<LteAmc> m_amc; ///< the AMC model of the rate table
+  int m_rbgSize; ///< the RBG size of the rate table
+  double m_cqiRate[16]; ///< the rate of a layer of a RBG for each CQI
+  double m_lowestMcsRate; ///< the rate of a layer of a RBG with MCS 0
+};
+
+} // namespace ns3
+
+#endif /* FF_MAC_RBG_ALLOCATOR_H */
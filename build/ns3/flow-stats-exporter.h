@@ -0,0 +1,197 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#ifndef FLOW_STATS_EXPORTER_H
+#define FLOW_STATS_EXPORTER_H
+
+#include <fstream>
+#include <map>
+#include <set>
+#include <string>
+
+#include "ns3/object.h"
+#include "ns3/ptr.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+#include "ns3/flow-monitor.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup flow-monitor
+ * \brief Periodically append the per-interval deltas of the FlowStats of a
+ * FlowMonitor to a time-series file
+ *
+ * Every Interval, the exporter checks the FlowMonitor for lost packets and
+ * writes one record per flow that has been active during the interval,
+ * holding the number of packets and bytes transmitted, received and lost,
+ * and the sums of the delays and jitters of the packets received during the
+ * interval. The records are written as they are computed, so that the
+ * memory used by the exporter only depends on the number of flows (the
+ * counters of the previous interval), not on the duration of the run.
+ *
+ * The records are written either as CSV, with the columns
+ *
+ * \verbatim
+   time,flowId,txPackets,rxPackets,lostPackets,txBytes,rxBytes,throughput,delaySum,jitterSum
+   \endverbatim
+ *
+ * where time is the end of the interval in seconds, throughput is the
+ * received throughput in bit/s and delaySum and jitterSum are in seconds,
+ * or in a binary format made of a header (the 8 characters "NS3FSEXP",
+ * followed by the format version and the record size as 32-bit integers)
+ * followed by fixed-size records (see BinaryRecord), both in the byte
+ * order of the host.
+ *
+ * Only the flows accepted by the flow filters are exported: the flows
+ * added by AddFlow, if any, and the flows for which the callback set by
+ * SetFlowFilter returns true, if any. By default, all the flows are
+ * exported.
+ *
+ * The exported deltas are not affected by the EnableHistograms attribute of
+ * the FlowMonitor, which can be disabled to bound the memory used by the
+ * FlowMonitor itself during long runs.
+ */
+class FlowStatsExporter : public Object
+{
+public:
+  /// Output format
+  enum Format
+  {
+    CSV,    //!< text, comma-separated values
+    BINARY  //!< fixed-size binary records
+  };
+
+  /// Record of the binary format
+  struct BinaryRecord
+  {
+    int64_t time;         //!< end of the interval, in nanoseconds
+    uint32_t flowId;      //!< flow identifier
+    uint32_t txPackets;   //!< packets transmitted during the interval
+    uint32_t rxPackets;   //!< packets received during the interval
+    uint32_t lostPackets; //!< packets declared lost during the interval
+    uint64_t txBytes;     //!< bytes transmitted during the interval
+    uint64_t rxBytes;     //!< bytes received during the interval
+    int64_t delaySum;     //!< sum of the delays, in nanoseconds
+    int64_t jitterSum;    //!< sum of the jitters, in nanoseconds
+  };
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId ();
+  FlowStatsExporter ();
+  virtual ~FlowStatsExporter ();
+
+  /**
+   * Set the FlowMonitor whose statistics are exported.
+   *
+   * \param monitor the FlowMonitor
+   */
+  void SetMonitor (Ptr<FlowMonitor> monitor);
+  /**
+   * Open the output file, truncating it, and write the header of the
+   * selected format.
+   *
+   * \param fileName name or path of the output file
+   */
+  void Open (std::string fileName);
+  /**
+   * Export the given flow. Once this method has been called, the flows
+   * which have not been added are only exported if the flow filter
+   * callback accepts them.
+   *
+   * \param flowId the flow identifier
+   */
+  void AddFlow (FlowId flowId);
+  /**
+   * Set a callback deciding whether a flow is exported, e.g., based on
+   * the five-tuple returned by the flow classifier.
+   *
+   * \param filter the callback, returning true if the flow is exported
+   */
+  void SetFlowFilter (Callback<bool, FlowId> filter);
+
+  /// Set the time, counting from the current time, from which to start
+  /// exporting. The first interval starts at that time.
+  /// \param time delta time to start
+  void Start (const Time &time);
+  /// Set the time, counting from the current time, from which to stop
+  /// exporting. The statistics of the current interval are exported.
+  /// \param time delta time to stop
+  void Stop (const Time &time);
+
+  /**
+   * Export the deltas since the previous export right now, and flush the
+   * output file.
+   */
+  void Export (void);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /// Counters of a flow at the end of the previous interval
+  struct Snapshot
+  {
+    Snapshot ();
+    uint32_t txPackets;   //!< transmitted packets
+    uint32_t rxPackets;   //!< received packets
+    uint32_t lostPackets; //!< lost packets
+    uint64_t txBytes;     //!< transmitted bytes
+    uint64_t rxBytes;     //!< received bytes
+    Time delaySum;        //!< sum of the delays
+    Time jitterSum;       //!< sum of the jitters
+  };
+
+  /// Start exporting
+  void DoStart (void);
+  /// Stop exporting, exporting the current interval
+  void DoStop (void);
+  /// Export and schedule the next export
+  void PeriodicExport (void);
+  /**
+   * \param flowId the flow identifier
+   * \return true if the flow is exported
+   */
+  bool IsExported (FlowId flowId) const;
+  /**
+   * Write a record in the selected format.
+   *
+   * \param record the record
+   * \param duration the duration of the interval
+   */
+  void Write (const BinaryRecord &record, Time duration);
+
+  Ptr<FlowMonitor> m_monitor;          //!< the FlowMonitor
+  Time m_interval;                     //!< export interval
+  Format m_format;                     //!< output format
+  std::ofstream m_os;                  //!< output file
+  std::set<FlowId> m_flows;            //!< flows to export
+  Callback<bool, FlowId> m_filter;     //!< flow filter callback
+  std::map<FlowId, Snapshot> m_snapshots; //!< counters of the previous interval
+  Time m_lastExport;                   //!< end of the previous interval
+  bool m_enabled;                      //!< whether the exporter is running
+  EventId m_exportEvent;               //!< next periodic export
+  EventId m_startEvent;                //!< start event
+  EventId m_stopEvent;                 //!< stop event
+};
+
+} // namespace ns3
+
+#endif /* FLOW_STATS_EXPORTER_H */
@@ -0,0 +1,297 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2016 Universita' degli Studi di Napoli Federico II
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Authors: Pasquale Imputato <p.imputato@gmail.com>
+ *          Stefano Avallone <stefano.avallone@unina.it>
+ */
+
+#ifndef FQ_CODEL_QUEUE_DISC
+#define FQ_CODEL_QUEUE_DISC
+
+#include "ns3/queue-disc.h"
+#include "ns3/object-factory.h"
+#include <list>
+#include <map>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A flow queue used by the FqCoDel queue disc
+ */
+
+class FqCoDelFlow : public QueueDiscClass {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief FqCoDelFlow constructor
+   */
+  FqCoDelFlow ();
+
+  virtual ~FqCoDelFlow ();
+
+  /**
+   * \enum FlowStatus
+   * \brief Used to determine the status of this flow queue
+   */
+  enum FlowStatus
+    {
+      INACTIVE,
+      NEW_FLOW,
+      OLD_FLOW
+    };
+
+  /**
+   * \brief Set the deficit for this flow
+   * \param deficit the deficit for this flow
+   */
+  void SetDeficit (uint32_t deficit);
+  /**
+   * \brief Get the deficit for this flow
+   * \return the deficit for this flow
+   */
+  int32_t GetDeficit (void) const;
+  /**
+   * \brief Increase the deficit for this flow
+   * \param deficit the amount by which the deficit is to be increased
+   */
+  void IncreaseDeficit (int32_t deficit);
+  /**
+   * \brief Set the status for this flow
+   * \param status the status for this flow
+   */
+  void SetStatus (FlowStatus status);
+  /**
+   * \brief Get the status of this flow
+   * \return the status of this flow
+   */
+  FlowStatus GetStatus (void) const;
+
+private:
+  int32_t m_deficit;    //!< the deficit for this flow
+  FlowStatus m_status;  //!< the status of this flow
+};
+
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief A FqCoDel packet queue disc
+ *
+ * By default, each flow queue is a FqCoDelFlow class with a child
+ * CoDelQueueDisc, created when the first packet of the flow arrives. If the
+ * Lightweight attribute is set, the flow queues are instead pre-allocated in
+ * an array indexed by the hash bucket, with their CoDel state inline, and are
+ * linked into the lists of new and old flows by index. The packets are stored
+ * in a pool of slots shared by all the flows, so that no object is created
+ * per flow and the enqueue and dequeue operations do not go through a child
+ * queue disc. The scheduling, the CoDel algorithm, the drops and their
+ * reasons are the same in both modes, but no queue disc class is created in
+ * the lightweight mode.
+ */
+
+class FqCoDelQueueDisc : public QueueDisc {
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief FqCoDelQueueDisc constructor
+   */
+  FqCoDelQueueDisc ();
+
+  virtual ~FqCoDelQueueDisc ();
+
+   /**
+    * \brief Set the quantum value.
+    *
+    * \param quantum The number of bytes each queue gets to dequeue on each round of the scheduling algorithm
+    */
+   void SetQuantum (uint32_t quantum);
+
+   /**
+    * \brief Get the quantum value.
+    *
+    * \returns The number of bytes each queue gets to dequeue on each round of the scheduling algorithm
+    */
+   uint32_t GetQuantum (void) const;
+
+  // Reasons for dropping packets
+  static constexpr const char* UNCLASSIFIED_DROP = "Unclassified drop";  //!< No packet filter able to classify packet
+  static constexpr const char* OVERLIMIT_DROP = "Overlimit drop";        //!< Overlimit dropped packets
+
+private:
+  virtual bool DoEnqueue (Ptr<QueueDiscItem> item);
+  virtual Ptr<QueueDiscItem> DoDequeue (void);
+  virtual bool CheckConfig (void);
+  virtual void InitializeParams (void);
+
+  virtual void DoDispose (void);
+
+  /**
+   * \brief Drop a packet from the head of the queue with the largest current byte count
+   * \return the index of the queue with the largest current byte count
+   */
+  uint32_t FqCoDelDrop (void);
+
+  /// Index of no flow or no packet slot in the lightweight mode
+  static const uint32_t NO_INDEX = 0xffffffff;
+
+  /**
+   * \brief A flow queue of the lightweight mode, with its CoDel state
+   */
+  struct FlowState
+  {
+    uint32_t head;                   //!< the slot of the first packet, or NO_INDEX
+    uint32_t tail;                   //!< the slot of the last packet, or NO_INDEX
+    uint32_t nPackets;               //!< the number of packets in the flow queue
+    uint32_t nBytes;                 //!< the number of bytes in the flow queue
+    int32_t deficit;                 //!< the deficit for this flow
+    FqCoDelFlow::FlowStatus status;  //!< the status of this flow
+    uint32_t next;                   //!< the next flow in the list of new or old flows, or NO_INDEX
+    uint32_t order;                  //!< the order of the first packet of this flow among the flows, or NO_INDEX
+    uint32_t count;                  //!< CoDel count
+    uint32_t lastCount;              //!< CoDel lastcount
+    bool dropping;                   //!< True if CoDel is in dropping state
+    uint16_t recInvSqrt;             //!< CoDel reciprocal inverse square root
+    uint32_t firstAboveTime;         //!< CoDel time to declare sojourn time above target
+    uint32_t dropNext;               //!< CoDel time to drop next packet
+  };
+
+  /**
+   * \brief A slot of the packet pool of the lightweight mode
+   */
+  struct PacketSlot
+  {
+    Ptr<QueueDiscItem> item;  //!< the packet, if the slot is used
+    uint32_t next;            //!< the next slot of the flow queue or of the free slots, or NO_INDEX
+  };
+
+  /**
+   * \brief A list of flows of the lightweight mode, linked by index
+   */
+  struct FlowList
+  {
+    uint32_t head;  //!< the first flow, or NO_INDEX
+    uint32_t tail;  //!< the last flow, or NO_INDEX
+  };
+
+  /**
+   * \brief Enqueue a packet into a flow queue of the lightweight mode
+   * \param h the hash bucket of the packet
+   * \param item the packet
+   * \return false if the flow queue is full and the packet has been dropped
+   */
+  bool FlowArrayEnqueue (uint32_t h, Ptr<QueueDiscItem> item);
+  /**
+   * \brief Dequeue a packet in the lightweight mode
+   * \return the packet, or 0 if there is no packet to dequeue
+   */
+  Ptr<QueueDiscItem> FlowArrayDequeue (void);
+  /**
+   * \brief Drop packets from the head of the flow queue of the lightweight
+   * mode with the largest current byte count
+   * \return the index of the flow queue with the largest current byte count
+   */
+  uint32_t FlowArrayDrop (void);
+  /**
+   * \brief Remove the first packet of a flow queue of the lightweight mode
+   * \param flow the flow queue
+   * \return the packet, or 0 if the flow queue is empty
+   */
+  Ptr<QueueDiscItem> PopPacket (FlowState &flow);
+  /**
+   * \brief Dequeue a packet of a flow queue of the lightweight mode through
+   * the CoDel algorithm, as done by CoDelQueueDisc
+   * \param flow the flow queue
+   * \return the packet, or 0 if the flow queue is or becomes empty
+   */
+  Ptr<QueueDiscItem> CoDelDequeue (FlowState &flow);
+  /**
+   * \brief Determine whether CoDel may drop a packet of a flow queue of the
+   * lightweight mode
+   * \param flow the flow queue
+   * \param item the packet
+   * \param now the current CoDel time
+   * \return true if the sojourn time has been above target for at least interval
+   */
+  bool CoDelOkToDrop (FlowState &flow, Ptr<QueueDiscItem> item, uint32_t now);
+  /**
+   * \brief Update the CoDel reciprocal inverse square root of the count of
+   * a flow queue of the lightweight mode
+   * \param flow the flow queue
+   */
+  void CoDelNewtonStep (FlowState &flow);
+  /**
+   * \brief Determine the time of the next CoDel drop of a flow queue of the
+   * lightweight mode
+   * \param flow the flow queue
+   * \param t the current next drop time
+   * \return the new next drop time
+   */
+  uint32_t CoDelControlLaw (const FlowState &flow, uint32_t t) const;
+  /**
+   * \brief Append a flow to a list of flows of the lightweight mode
+   * \param list the list of flows
+   * \param index the index of the flow
+   */
+  void PushFlow (FlowList &list, uint32_t index);
+  /**
+   * \brief Remove the first flow of a list of flows of the lightweight mode
+   * \param list the list of flows
+   */
+  void PopFlow (FlowList &list);
+
+  std::string m_interval;    //!< CoDel interval attribute
+  std::string m_target;      //!< CoDel target attribute
+  uint32_t m_quantum;        //!< Deficit assigned to flows at each round
+  uint32_t m_flows;          //!< Number of flow queues
+  uint32_t m_dropBatchSize;  //!< Max number of packets dropped from the fat flow
+  uint32_t m_perturbation;   //!< hash perturbation value
+  bool m_lightweight;        //!< True to keep the flow queues in a pre-allocated array
+
+  std::list<Ptr<FqCoDelFlow> > m_newFlows;    //!< The list of new flows
+  std::list<Ptr<FqCoDelFlow> > m_oldFlows;    //!< The list of old flows
+
+  std::map<uint32_t, uint32_t> m_flowsIndices;    //!< Map with the index of class for each flow
+
+  ObjectFactory m_flowFactory;         //!< Factory to create a new flow
+  ObjectFactory m_queueDiscFactory;    //!< Factory to create a new queue
+
+  std::vector<FlowState> m_flowStates;    //!< The flow queues of the lightweight mode, by hash bucket
+  std::vector<PacketSlot> m_packetSlots;  //!< The packet pool of the lightweight mode
+  uint32_t m_freeSlot;                    //!< The first free packet slot, or NO_INDEX
+  FlowList m_newFlowList;                 //!< The list of new flows of the lightweight mode
+  FlowList m_oldFlowList;                 //!< The list of old flows of the lightweight mode
+  uint32_t m_nUsedFlows;                  //!< The number of flows which received a packet in the lightweight mode
+  uint32_t m_codelInterval;               //!< CoDel interval in CoDel time units
+  uint32_t m_codelTarget;                 //!< CoDel target in CoDel time units
+  std::string m_targetExceededDropMsg;    //!< Reason of the CoDel drops, as reported for a child queue disc
+  std::string m_overlimitDropMsg;         //!< Reason of the drops of a full flow queue, as reported for a child queue disc
+};
+
+} // namespace ns3
+
+#endif /* FQ_CODEL_QUEUE_DISC */
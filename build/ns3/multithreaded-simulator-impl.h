@@ -0,0 +1,297 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef MULTITHREADED_SIMULATOR_IMPL_H
+#define MULTITHREADED_SIMULATOR_IMPL_H
+
+#include "simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "event-id.h"
+#include "nstime.h"
+
+#include "ptr.h"
+
+#include <list>
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl declaration.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup simulator
+ *
+ * A shared-memory, conservative parallel simulator implementation.
+ *
+ * Events are partitioned by execution context: the events of the node
+ * whose id is \c context are handled by partition <tt>context % ThreadCount</tt>
+ * and each partition is executed by its own thread. Events without a context
+ * (e.g., scheduled from the main program by means of Simulator::Schedule)
+ * belong to a global partition, which is executed by the main thread while
+ * all the other partitions are paused.
+ *
+ * Partitions are synchronized by means of barriers. At every round, the
+ * timestamp T of the earliest pending event is determined and all the
+ * partitions execute, in parallel, their events whose timestamp is less than
+ * T + Lookahead (or less than the timestamp of the next global event, if
+ * earlier). Hence, an event scheduled by a partition for a context handled
+ * by another partition must have a delay not less than the Lookahead, which
+ * should be set to the minimum delay between nodes in different partitions
+ * (e.g., the minimum propagation delay). Violations are detected and reported
+ * as fatal errors.
+ *
+ * Events exchanged between partitions are not serialized: each partition
+ * owns an outbox per destination partition, which is only written by the
+ * owner thread during a round and only read once all threads have reached
+ * the barrier, so no lock is needed. Events received by a partition are
+ * inserted in deterministic order (by source partition), hence results do
+ * not depend on thread scheduling.
+ *
+ * Likewise, Simulator::Cancel and Simulator::Remove of an event handled by
+ * another partition are deferred to the end of the round. This is only
+ * possible for events whose timestamp is not less than the end of the
+ * current window, the other ones being possibly executed during the round;
+ * violations are reported as fatal errors.
+ *
+ * While partitions are executed in parallel, the reference counts of
+ * SimpleRefCount objects and of packet data are updated atomically (see
+ * AtomicRefCount), hence objects such as packets and channels can be
+ * referenced by several partitions. Note that models must not share other
+ * mutable state across partitions without synchronization. Models whose
+ * nodes only interact by means of events scheduled with
+ * Simulator::ScheduleWithContext carrying data that is not modified once
+ * sent (e.g., packets, which are copied on write) can be run unmodified.
+ * The uids of the packets created during the parallel phase depend on
+ * thread scheduling.
+ */
+class MultithreadedSimulatorImpl : public SimulatorImpl
+{
+public:
+  /**
+   *  Register this type.
+   *  \return The object TypeId.
+   */
+  static TypeId GetTypeId (void);
+
+  /** Constructor. */
+  MultithreadedSimulatorImpl ();
+  /** Destructor. */
+  ~MultithreadedSimulatorImpl ();
+
+  // Inherited
+  virtual void Destroy ();
+  virtual bool IsFinished (void) const;
+  virtual void Stop (void);
+  virtual void Stop (const Time &delay);
+  virtual EventId Schedule (const Time &delay, EventImpl *event);
+  virtual void ScheduleWithContext (uint32_t context, const Time &delay, EventImpl *event);
+  virtual EventId ScheduleNow (EventImpl *event);
+  virtual EventId ScheduleDestroy (EventImpl *event);
+  virtual void Remove (const EventId &id);
+  virtual void Cancel (const EventId &id);
+  virtual bool IsExpired (const EventId &id) const;
+  virtual void Run (void);
+  virtual Time Now (void) const;
+  virtual Time GetDelayLeft (const EventId &id) const;
+  virtual Time GetMaximumSimulationTime (void) const;
+  virtual void SetScheduler (ObjectFactory schedulerFactory);
+  virtual uint32_t GetSystemId (void) const;
+  virtual uint32_t GetContext (void) const;
+  virtual uint64_t GetEventCount (void) const;
+
+  /**
+   * \return the number of synchronization rounds performed so far
+   */
+  uint64_t GetRoundCount (void) const;
+
+private:
+  virtual void DoDispose (void);
+
+  /** Wrap an event with its execution context. */
+  struct EventWithContext
+  {
+    /** The event context. */
+    uint32_t context;
+    /** Event timestamp (absolute, or relative for events from foreign threads). */
+    uint64_t timestamp;
+    /** The event implementation. */
+    EventImpl *event;
+  };
+  /** Container type for the events sent to a partition. */
+  typedef std::vector<EventWithContext> Outbox;
+
+  /** An operation on an event handled by another partition. */
+  struct DeferredOperation
+  {
+    /** The event. */
+    EventId id;
+    /** Whether the event is removed (or only cancelled). */
+    bool remove;
+  };
+
+  /** The state of a partition (a logical process). */
+  struct Partition
+  {
+    /** The event priority queue. */
+    Ptr<Scheduler> events;
+    /** Next event unique id. */
+    uint32_t uid;
+    /** Unique id of the current event. */
+    uint32_t currentUid;
+    /** Timestamp of the current event. */
+    uint64_t currentTs;
+    /** Execution context of the current event. */
+    uint32_t currentContext;
+    /** The event count. */
+    uint64_t eventCount;
+    /** The events sent to every other partition during the current round. */
+    std::vector<Outbox> outboxes;
+    /** The events of other partitions cancelled or removed during the current round. */
+    std::vector<DeferredOperation> deferred;
+  };
+
+  /** Create the partitions, if not done yet. */
+  void CreatePartitions (void);
+  /**
+   * \param context the execution context
+   * \return the index of the partition handling the given context
+   */
+  uint32_t GetPartitionIndex (uint32_t context) const;
+  /**
+   * \return the index of the partition executed by the calling thread. The
+   *         global partition is returned for the main thread outside of the
+   *         parallel phase and for foreign threads.
+   */
+  uint32_t GetCurrentPartitionIndex (void) const;
+  /**
+   * \return true if the calling thread is the main thread and no partition
+   *         is being executed in parallel
+   */
+  bool IsSerialPhase (void) const;
+  /**
+   * Insert an event in the queue of the given partition.
+   *
+   * \param index the index of the partition
+   * \param ts the absolute timestamp of the event
+   * \param context the execution context of the event
+   * \param event the event implementation
+   * \return the identifier of the inserted event
+   */
+  EventId Insert (uint32_t index, uint64_t ts, uint32_t context, EventImpl *event);
+  /**
+   * Move the events exchanged during the last round, as well as the events
+   * scheduled by foreign threads, into the queues of the destination partitions,
+   * and apply the deferred cancellations and removals.
+   */
+  void DeliverEvents (void);
+  /**
+   * Check whether an event is handled by another partition than the one
+   * executed by the calling thread, while partitions are executed in parallel.
+   * In that case, a fatal error is raised if the event may be executed during
+   * the current round.
+   *
+   * \param id the event
+   * \param operation the name of the operation on the event, for error reporting
+   * eturn true if the event is handled by another partition
+   */
+  bool IsForeignPartitionEvent (const EventId &id, const char *operation) const;
+  /**
+   * \param id an event handled by another partition
+   * eturn true if the calling partition cancelled or removed the event
+   *         during the current round
+   */
+  bool IsDeferredCancel (const EventId &id) const;
+  /**
+   * Process the next event of the given partition.
+   *
+   * \param index the index of the partition
+   */
+  void ProcessOneEvent (uint32_t index);
+  /**
+   * Process all the events of the given partition whose timestamp is less
+   * than the end of the current window.
+   *
+   * \param index the index of the partition
+   */
+  void ProcessWindow (uint32_t index);
+  /**
+   * The body of the worker threads.
+   *
+   * \param index the index of the partition handled by the worker thread
+   */
+  void WorkerThread (uint32_t index);
+  /** Wait until all the threads reach the barrier. */
+  void WaitBarrier (void);
+
+  uint32_t m_threadCount;             //!< number of threads (and of non-global partitions)
+  Time m_lookahead;                   //!< minimum delay of events between partitions
+  ObjectFactory m_schedulerFactory;   //!< the factory of the event queues
+  std::vector<Partition> m_partitions; //!< the partitions, the last one being the global partition
+
+  /** Container type for the events to run at Simulator::Destroy() */
+  typedef std::list<EventId> DestroyEvents;
+  /** The container of events to run at Destroy. */
+  DestroyEvents m_destroyEvents;
+  /** Mutex to control access to the events to run at Destroy. */
+  mutable std::mutex m_destroyEventsMutex;
+
+  /** Flag calling for the end of the simulation. */
+  bool m_stop;
+  /** Absolute time at which the simulation stops. */
+  uint64_t m_stopTs;
+  /** Mutex to control access to the stop time. */
+  std::mutex m_stopMutex;
+  /** Start of the window being processed. */
+  uint64_t m_windowStart;
+  /** End (excluded) of the window being processed. */
+  uint64_t m_windowEnd;
+  /** Flag whether partitions are being executed in parallel. */
+  bool m_parallelPhase;
+  /** Number of synchronization rounds. */
+  uint64_t m_roundCount;
+
+  /** The events scheduled by threads not owned by the simulator. */
+  std::list<EventWithContext> m_foreignEvents;
+  /** Flag \c true if there is no event scheduled by foreign threads. */
+  std::atomic<bool> m_foreignEventsEmpty;
+  /** Mutex to control access to the list of events from foreign threads. */
+  std::mutex m_foreignEventsMutex;
+
+  /** Main execution thread. */
+  std::thread::id m_main;
+  /** The worker threads. */
+  std::vector<std::thread> m_threads;
+  /** Flag telling the worker threads to exit. */
+  bool m_exit;
+
+  std::mutex m_barrierMutex;              //!< mutex of the barrier
+  std::condition_variable m_barrierCond;  //!< condition variable of the barrier
+  uint32_t m_barrierCount;                //!< number of threads waiting at the barrier
+  uint64_t m_barrierGeneration;           //!< number of times the barrier was passed
+};
+
+} // namespace ns3
+
+#endif /* MULTITHREADED_SIMULATOR_IMPL_H */
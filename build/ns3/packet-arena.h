@@ -0,0 +1,103 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef PACKET_ARENA_H
+#define PACKET_ARENA_H
+
+#include <stdint.h>
+
+namespace ns3 {
+
+/**
+ * \ingroup packet
+ *
+ * \brief Slab allocator for the storage of the packets.
+ *
+ * The data of the Buffer, PacketMetadata, ByteTagList and PacketTagList
+ * instances is allocated from a single arena, so that copying and
+ * destroying a packet does not hit the heap. The arena serves blocks of
+ * a few size classes (powers of two from 64 bytes to 64 KiB) carved from
+ * large slabs; larger blocks are allocated from the heap directly.
+ *
+ * Released blocks are kept in a free list owned by the releasing thread,
+ * hence allocations and releases do not require any synchronization
+ * (e.g., with the MultithreadedSimulatorImpl, a packet can be created by
+ * a thread and destroyed by another one). The free blocks of a thread are
+ * handed over to the other threads when the thread exits or when its free
+ * list grows too large. The slabs whose blocks are all free are returned to
+ * the system by Release, which is called when the simulator is destroyed and
+ * when the program exits.
+ *
+ * This class is used internally by the packet data structures; the
+ * allocation statistics are available through Packet::GetAllocationStats.
+ */
+class PacketArena
+{
+public:
+  /**
+   * \brief Allocation statistics, cumulated over all the threads.
+   */
+  struct Stats
+  {
+    uint64_t allocatedBytes;   //!< number of bytes allocated
+    uint64_t allocatedBlocks;  //!< number of blocks allocated
+    uint64_t releasedBytes;    //!< number of bytes released
+    uint64_t releasedBlocks;   //!< number of blocks released
+    uint64_t copies;           //!< number of packet copies
+    uint64_t slabBytes;        //!< number of bytes of the slabs not returned to the system
+  };
+
+  /**
+   * Allocate a block.
+   *
+   * \param size the minimum size of the block
+   * \param pooled whether the block is served by the slabs (otherwise, the
+   *        block is allocated from the heap and returned to the heap when
+   *        released)
+   * \return the block, whose capacity is returned by GetCapacity
+   */
+  static void* Allocate (uint32_t size, bool pooled = true);
+  /**
+   * Release a block.
+   *
+   * \param block the block, previously returned by Allocate
+   */
+  static void Deallocate (void *block);
+  /**
+   * \param block a block returned by Allocate
+   * \return the number of bytes that can be used in the block
+   */
+  static uint32_t GetCapacity (const void *block);
+  /**
+   * Record a packet copy in the allocation statistics.
+   */
+  static void NotifyCopy (void);
+  /**
+   * \return the allocation statistics
+   */
+  static Stats GetStats (void);
+  /**
+   * Return to the system the slabs whose blocks are all free. The free
+   * blocks kept by the calling thread are handed over to the shared depot
+   * first; those kept by the other running threads are not, hence their
+   * slabs are not released.
+   */
+  static void Release (void);
+};
+
+} // namespace ns3
+
+#endif /* PACKET_ARENA_H */
@@ -0,0 +1,123 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUEUE_DISC_TIMING_WHEEL_H
+#define QUEUE_DISC_TIMING_WHEEL_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+#include <list>
+#include <map>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Timing wheel shared by the queue discs for their periodic updates
+ *
+ * Queue discs such as PIE update their state periodically. Rather than
+ * scheduling an event per queue disc and per update, they add a timer to
+ * the timing wheel shared by all the queue discs of the simulation. The
+ * timers are gathered in slots by expiration time and only the earliest
+ * slot has an event in the simulator: when it expires, all the timers of the
+ * slot are run in the order they were added, so that the queue discs
+ * updating at the same time (e.g., those installed at the same time with the
+ * same update interval) take one event instead of one each.
+ *
+ * The timing wheel is created when first requested and cleared when the
+ * simulator is destroyed.
+ */
+class QueueDiscTimingWheel : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief QueueDiscTimingWheel constructor
+   */
+  QueueDiscTimingWheel ();
+
+  virtual ~QueueDiscTimingWheel ();
+
+  /**
+   * \brief Get the timing wheel shared by the queue discs
+   * \return the timing wheel shared by the queue discs
+   */
+  static Ptr<QueueDiscTimingWheel> Get (void);
+
+  /**
+   * \brief Add a timer to the timing wheel
+   * \param delay the delay after which the timer expires
+   * \param cb the callback to invoke when the timer expires
+   * \return the identifier of the timer, which is never zero
+   */
+  uint64_t Schedule (Time delay, Callback<void> cb);
+  /**
+   * \brief Remove a timer from the timing wheel, if it has not expired yet
+   * \param id the identifier of the timer
+   */
+  void Cancel (uint64_t id);
+  /**
+   * \brief Check whether a timer has not expired yet
+   * \param id the identifier of the timer
+   * \return true if the timer has not expired nor has been cancelled
+   */
+  bool IsPending (uint64_t id) const;
+  /**
+   * \brief Get the number of timers that have not expired yet
+   * \return the number of timers that have not expired yet
+   */
+  uint32_t GetNTimers (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Get the timing wheel shared by the queue discs
+   * \return a pointer to the timing wheel shared by the queue discs
+   */
+  static Ptr<QueueDiscTimingWheel> *DoGet (void);
+  /**
+   * \brief Clear the timing wheel shared by the queue discs
+   */
+  static void Delete (void);
+  /**
+   * \brief Run the timers of the earliest slot and schedule the next slot
+   */
+  void Expire (void);
+
+  /// A timer: the identifier and the callback
+  typedef std::pair<uint64_t, Callback<void> > Timer;
+  /// A slot: the timers expiring at the same time
+  typedef std::list<Timer> Slot;
+
+  std::map<Time, Slot> m_slots;       //!< Slots indexed by expiration time
+  std::map<uint64_t, Time> m_timers;  //!< Expiration time of the pending timers
+  uint64_t m_lastId;                  //!< Identifier of the last timer added
+  EventId m_event;                    //!< Expiration event of the earliest slot
+  bool m_expiring;                    //!< Whether the timers of a slot are being run
+};
+
+} // namespace ns3
+
+#endif /* QUEUE_DISC_TIMING_WHEEL_H */
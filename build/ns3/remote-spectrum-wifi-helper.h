@@ -0,0 +1,50 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REMOTE_SPECTRUM_WIFI_HELPER_H
+#define REMOTE_SPECTRUM_WIFI_HELPER_H
+
+#include <ns3/ptr.h>
+
+namespace ns3 {
+
+class RemoteSpectrumChannel;
+
+/**
+ * \ingroup mpi-spectrum
+ *
+ * Prepare a RemoteSpectrumChannel to carry the signals of SpectrumWifiPhy
+ * instances between the systems of a distributed simulation.
+ */
+class RemoteSpectrumWifiHelper
+{
+public:
+  /**
+   * Register the WifiSpectrumSignalParameters type with the given channel
+   * and reserve a range of PPDU UIDs to the local system, so that the PPDUs
+   * exchanged with the other systems have distinct UIDs. This must be
+   * called on every system, in the same order with respect to the other
+   * signal parameter types registered with the channel, before the
+   * simulation starts.
+   *
+   * \param channel the channel
+   */
+  static void Configure (Ptr<RemoteSpectrumChannel> channel);
+};
+
+} // namespace ns3
+
+#endif /* REMOTE_SPECTRUM_WIFI_HELPER_H */
@@ -0,0 +1,141 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef WIFI_RADIO_ENVIRONMENT_MAP_HELPER_H
+#define WIFI_RADIO_ENVIRONMENT_MAP_HELPER_H
+
+#include <vector>
+#include <ns3/object.h>
+#include <ns3/net-device-container.h>
+#include <ns3/analytical-rem-generator.h>
+
+namespace ns3 {
+
+class SpectrumWifiPhy;
+
+/**
+ * \ingroup wifi
+ *
+ * \brief Generates a 2D map of the signals received on the 20 MHz subchannels
+ * of the operating channel of a Wi-Fi receiver, and of the channel width
+ * which would be found idle by the CCA of the receiver.
+ *
+ * The map is generated analytically with an AnalyticalRemGenerator, at once
+ * and at the current simulation time, assuming that all the transmitters
+ * registered transmit simultaneously over their whole operating channel at
+ * their maximum power (TxPowerEnd). The receiver is a SpectrumWifiPhy, whose
+ * operating channel, primary channel, CCA thresholds, RX gain, noise figure
+ * and antenna are used for all the points of the map.
+ *
+ * The map is written to the output file, one point per line, with the
+ * following columns:
+ *  - the x, y and z coordinates of the point;
+ *  - the widest channel width (MHz) found idle by the CCA, or 0 if the
+ *    primary 20 MHz channel is busy: the primary channel is busy if the
+ *    strongest signal is above the RX sensitivity, or if the received power
+ *    is above the CCA-ED threshold, and a secondary channel is busy if the
+ *    power received on any of its 20 MHz subchannels is above the default
+ *    CCA-ED threshold of the secondary channels;
+ *  - the SINR (in linear units) of the strongest transmitter on the primary
+ *    20 MHz channel;
+ *  - the power received (dBm) on each 20 MHz subchannel of the operating
+ *    channel, from the lowest frequency.
+ */
+class WifiRadioEnvironmentMapHelper : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  WifiRadioEnvironmentMapHelper ();
+  virtual ~WifiRadioEnvironmentMapHelper ();
+
+  /**
+   * Set the receiver, whose channel and configuration are used for the map.
+   *
+   * \param device the WifiNetDevice of the receiver, with a SpectrumWifiPhy
+   */
+  void SetReceiver (Ptr<NetDevice> device);
+  /**
+   * Register a transmitter.
+   *
+   * \param device the WifiNetDevice of the transmitter, with a SpectrumWifiPhy
+   */
+  void AddTransmitter (Ptr<NetDevice> device);
+  /**
+   * Register transmitters.
+   *
+   * \param devices the WifiNetDevices of the transmitters
+   */
+  void AddTransmitters (NetDeviceContainer devices);
+
+  /**
+   * Generate the map and write it to the output file.
+   */
+  void Generate (void);
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \param device a WifiNetDevice
+   * \return the SpectrumWifiPhy of the device
+   */
+  static Ptr<SpectrumWifiPhy> GetSpectrumWifiPhy (Ptr<NetDevice> device);
+  /**
+   * Evaluate a point of the map.
+   *
+   * \param rxPsds the PSDs received from each transmitter
+   * \param values the values of the point
+   */
+  void EvaluatePoint (const std::vector<SpectrumValue> &rxPsds, std::vector<double> &values) const;
+  /**
+   * \param psd a received PSD
+   * \param subchannel the index of a 20 MHz subchannel
+   * \return the power (W) of the PSD in the subchannel
+   */
+  double GetSubchannelPower (const SpectrumValue &psd, uint32_t subchannel) const;
+
+  AnalyticalRemGenerator m_generator; //!< the generator
+  Ptr<SpectrumWifiPhy> m_receiver;    //!< the PHY of the receiver
+
+  /// the first and last band of the receiver spectrum model of each 20 MHz subchannel
+  std::vector<std::pair<uint32_t, uint32_t> > m_subchannels;
+  uint32_t m_primary;         //!< the index of the primary 20 MHz subchannel
+  double m_rxGain;            //!< the RX gain of the receiver (linear)
+  double m_noisePowerW;       //!< the noise power in a 20 MHz subchannel (W)
+  double m_rxSensitivityW;    //!< the RX sensitivity of the receiver (W)
+  double m_ccaEdThresholdW;   //!< the CCA-ED threshold of the primary channel (W)
+  double m_ccaEdThresholdSecondaryW; //!< the CCA-ED threshold of the secondary channels (W)
+
+  double m_xMin;   ///< The `XMin` attribute.
+  double m_xMax;   ///< The `XMax` attribute.
+  uint16_t m_xRes; ///< The `XRes` attribute.
+  double m_yMin;   ///< The `YMin` attribute.
+  double m_yMax;   ///< The `YMax` attribute.
+  uint16_t m_yRes; ///< The `YRes` attribute.
+  double m_z;      ///< The `Z` attribute.
+  uint32_t m_threads;        ///< The `Threads` attribute.
+  std::string m_outputFile;  ///< The `OutputFile` attribute.
+};
+
+} // namespace ns3
+
+#endif /* WIFI_RADIO_ENVIRONMENT_MAP_HELPER_H */
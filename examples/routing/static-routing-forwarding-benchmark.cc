@@ -0,0 +1,217 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// This program benchmarks the forwarding decisions of the IPv4 and IPv6
+// static routing protocols, for routing tables made of a given number of
+// host routes (as installed by helpers in large routed scenarios), a network
+// route every 256 host routes and a default route.
+//
+// A router with an input and an output interface is asked to forward
+// packets towards random destinations, by calling the RouteInput method of
+// its static routing protocol directly, and the number of packets forwarded
+// per second of wall-clock time is printed.
+//
+// Sample usage:
+//   ./waf --run 'static-routing-forwarding-benchmark --routes=10000 --packets=1000000'
+
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/internet-module.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("StaticRoutingForwardingBenchmark");
+
+static uint32_t g_forwarded = 0; //!< number of packets forwarded
+
+/// IPv4 unicast forwarding callback
+static void
+ForwardIpv4 (Ptr<Ipv4Route> route, Ptr<const Packet> p, const Ipv4Header &header)
+{
+  g_forwarded++;
+}
+
+/// IPv4 multicast forwarding callback
+static void
+MulticastIpv4 (Ptr<Ipv4MulticastRoute> route, Ptr<const Packet> p, const Ipv4Header &header)
+{
+}
+
+/// IPv4 local delivery callback
+static void
+DeliverIpv4 (Ptr<const Packet> p, const Ipv4Header &header, uint32_t iif)
+{
+}
+
+/// IPv4 error callback
+static void
+ErrorIpv4 (Ptr<const Packet> p, const Ipv4Header &header, Socket::SocketErrno sockerr)
+{
+}
+
+/// IPv6 unicast forwarding callback
+static void
+ForwardIpv6 (Ptr<const NetDevice> idev, Ptr<Ipv6Route> route, Ptr<const Packet> p, const Ipv6Header &header)
+{
+  g_forwarded++;
+}
+
+/// IPv6 multicast forwarding callback
+static void
+MulticastIpv6 (Ptr<const NetDevice> idev, Ptr<Ipv6MulticastRoute> route, Ptr<const Packet> p, const Ipv6Header &header)
+{
+}
+
+/// IPv6 local delivery callback
+static void
+DeliverIpv6 (Ptr<const Packet> p, const Ipv6Header &header, uint32_t iif)
+{
+}
+
+/// IPv6 error callback
+static void
+ErrorIpv6 (Ptr<const Packet> p, const Ipv6Header &header, Socket::SocketErrno sockerr)
+{
+}
+
+/**
+ * Print the forwarding rate.
+ * \param name the name of the protocol
+ * \param packets the number of packets
+ * \param ms the wall-clock time, in milliseconds
+ */
+static void
+PrintRate (std::string name, uint32_t packets, int64_t ms)
+{
+  std::cout << name << ": " << g_forwarded << "/" << packets << " packets forwarded in "
+            << ms << " ms (" << (ms > 0 ? packets * 1000.0 / ms : 0) << " packets/s)" << std::endl;
+}
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nRoutes = 10000;
+  uint32_t nPackets = 1000000;
+
+  CommandLine cmd;
+  cmd.AddValue ("routes", "Number of host routes", nRoutes);
+  cmd.AddValue ("packets", "Number of packets to forward", nPackets);
+  cmd.Parse (argc, argv);
+
+  Ptr<Node> router = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (router);
+
+  Ptr<SimpleNetDevice> devices[2];
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      devices[i] = CreateObject<SimpleNetDevice> ();
+      devices[i]->SetAddress (Mac48Address::Allocate ());
+      router->AddDevice (devices[i]);
+    }
+
+  // IPv4: 10.0.0.1/24 on the input interface, 10.1.0.1/16 on the output one
+  Ptr<Ipv4> ipv4 = router->GetObject<Ipv4> ();
+  const char *ipv4Addresses[2] = { "10.0.0.1", "10.1.0.1" };
+  const char *ipv4Masks[2] = { "/24", "/16" };
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      int32_t ifIndex = ipv4->AddInterface (devices[i]);
+      ipv4->AddAddress (ifIndex, Ipv4InterfaceAddress (Ipv4Address (ipv4Addresses[i]), Ipv4Mask (ipv4Masks[i])));
+      ipv4->SetUp (ifIndex);
+    }
+
+  // IPv6: 2001:db8::/64 on the input interface, 2001:db8:1::/64 on the output one
+  Ptr<Ipv6> ipv6 = router->GetObject<Ipv6> ();
+  const char *ipv6Addresses[2] = { "2001:db8::1", "2001:db8:1::1" };
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      int32_t ifIndex = ipv6->AddInterface (devices[i]);
+      ipv6->AddAddress (ifIndex, Ipv6InterfaceAddress (Ipv6Address (ipv6Addresses[i]), Ipv6Prefix (64)));
+      ipv6->SetUp (ifIndex);
+      ipv6->SetForwarding (ifIndex, true);
+    }
+
+  Ipv4StaticRoutingHelper ipv4RoutingHelper;
+  Ptr<Ipv4StaticRouting> ipv4Routing = ipv4RoutingHelper.GetStaticRouting (ipv4);
+  Ipv6StaticRoutingHelper ipv6RoutingHelper;
+  Ptr<Ipv6StaticRouting> ipv6Routing = ipv6RoutingHelper.GetStaticRouting (ipv6);
+
+  // the destinations are 172.16.0.0/12 and 2001:db8:2::/48 addresses
+  std::vector<Ipv4Address> ipv4Destinations;
+  std::vector<Ipv6Address> ipv6Destinations;
+  for (uint32_t i = 0; i < nRoutes; i++)
+    {
+      Ipv4Address ipv4Destination (0xac100000 + i);
+      ipv4Routing->AddHostRouteTo (ipv4Destination, Ipv4Address (0x0a010000 + 2 + i % 1000), 2);
+      ipv4Destinations.push_back (ipv4Destination);
+
+      uint8_t buf[16];
+      Ipv6Address ("2001:db8:2::").GetBytes (buf);
+      buf[12] = (i >> 24) & 0xff;
+      buf[13] = (i >> 16) & 0xff;
+      buf[14] = (i >> 8) & 0xff;
+      buf[15] = i & 0xff;
+      Ipv6Address ipv6Destination (buf);
+      ipv6Routing->AddHostRouteTo (ipv6Destination, Ipv6Address ("2001:db8:1::2"), 2);
+      ipv6Destinations.push_back (ipv6Destination);
+
+      if (i % 256 == 0)
+        {
+          ipv4Routing->AddNetworkRouteTo (Ipv4Address (0xac100000 + i), Ipv4Mask ("/24"), Ipv4Address ("10.1.0.3"), 2);
+          ipv6Routing->AddNetworkRouteTo (ipv6Destination, Ipv6Prefix (120), Ipv6Address ("2001:db8:1::3"), 2);
+        }
+    }
+  ipv4Routing->SetDefaultRoute (Ipv4Address ("10.1.0.4"), 2);
+  ipv6Routing->SetDefaultRoute (Ipv6Address ("2001:db8:1::4"), 2);
+
+  Ptr<UniformRandomVariable> random = CreateObject<UniformRandomVariable> ();
+  Ptr<Packet> packet = Create<Packet> (100);
+  SystemWallClockMs clock;
+
+  Ipv4Header ipv4Header;
+  ipv4Header.SetSource (Ipv4Address ("10.0.0.2"));
+  g_forwarded = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nPackets; i++)
+    {
+      ipv4Header.SetDestination (ipv4Destinations[random->GetInteger (0, nRoutes - 1)]);
+      ipv4Routing->RouteInput (packet, ipv4Header, devices[0],
+                               MakeCallback (&ForwardIpv4), MakeCallback (&MulticastIpv4),
+                               MakeCallback (&DeliverIpv4), MakeCallback (&ErrorIpv4));
+    }
+  PrintRate ("Ipv4StaticRouting", nPackets, clock.End ());
+
+  Ipv6Header ipv6Header;
+  ipv6Header.SetSourceAddress (Ipv6Address ("2001:db8::2"));
+  g_forwarded = 0;
+  clock.Start ();
+  for (uint32_t i = 0; i < nPackets; i++)
+    {
+      ipv6Header.SetDestinationAddress (ipv6Destinations[random->GetInteger (0, nRoutes - 1)]);
+      ipv6Routing->RouteInput (packet, ipv6Header, devices[0],
+                               MakeCallback (&ForwardIpv6), MakeCallback (&MulticastIpv6),
+                               MakeCallback (&DeliverIpv6), MakeCallback (&ErrorIpv6));
+    }
+  PrintRate ("Ipv6StaticRouting", nPackets, clock.End ());
+
+  Simulator::Destroy ();
+  return 0;
+}
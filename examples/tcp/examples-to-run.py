@@ -14,6 +14,7 @@ cpp_examples = [
     ("tcp-nsc-zoo", "NSC_ENABLED == True", "False"),
     ("tcp-star-server", "True", "True"),
     ("tcp-variants-comparison", "True", "True"),
+    ("tcp-high-bdp-benchmark --simTime=2", "True", "False"),
 ]
 
 # A list of Python examples to run in order to ensure that they remain
@@ -0,0 +1,145 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Network topology
+//
+//       n0 ----------- n1
+//            1 Gbps
+//            50 ms
+//
+// - A single bulk TCP flow from n0 to n1 over a long fat link, with random
+//   packet losses on the receiver side.
+// - With the default values, the bandwidth-delay product is 12.5 MB, so that
+//   thousands of segments are in flight and the SACK scoreboard of the sender
+//   (TcpTxBuffer) is updated with many holes at each ACK.
+// - The program reports the bytes received, the maximum bytes in flight and
+//   the wall clock time spent, to benchmark the TCP sender with a high
+//   bandwidth-delay product.
+
+#include <algorithm>
+#include <iostream>
+#include "ns3/core-module.h"
+#include "ns3/point-to-point-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/network-module.h"
+#include "ns3/packet-sink.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("TcpHighBdpBenchmark");
+
+static uint32_t g_maxBytesInFlight = 0; //!< Maximum bytes in flight of the sender
+
+static void
+BytesInFlightTracer (uint32_t oldValue, uint32_t newValue)
+{
+  g_maxBytesInFlight = std::max (g_maxBytesInFlight, newValue);
+}
+
+static void
+TraceBytesInFlight (void)
+{
+  Config::ConnectWithoutContext ("/NodeList/0/$ns3::TcpL4Protocol/SocketList/0/BytesInFlight",
+                                 MakeCallback (&BytesInFlightTracer));
+}
+
+int
+main (int argc, char *argv[])
+{
+  std::string dataRate = "1Gbps";
+  std::string delay = "50ms";
+  double errorRate = 0.0001;
+  double simTime = 10.0;
+  bool sack = true;
+  uint32_t segmentSize = 1448;
+  uint32_t bufferSize = 64 << 20;
+
+  CommandLine cmd;
+  cmd.AddValue ("dataRate", "Data rate of the link", dataRate);
+  cmd.AddValue ("delay", "One-way delay of the link", delay);
+  cmd.AddValue ("errorRate", "Packet error rate on the receiver side", errorRate);
+  cmd.AddValue ("simTime", "Simulation time (s)", simTime);
+  cmd.AddValue ("sack", "Enable or disable SACK", sack);
+  cmd.AddValue ("segmentSize", "TCP segment size (bytes)", segmentSize);
+  cmd.AddValue ("bufferSize", "TCP send and receive buffer size (bytes)", bufferSize);
+  cmd.Parse (argc, argv);
+
+  Config::SetDefault ("ns3::TcpSocketBase::Sack", BooleanValue (sack));
+  Config::SetDefault ("ns3::TcpSocket::SegmentSize", UintegerValue (segmentSize));
+  Config::SetDefault ("ns3::TcpSocket::SndBufSize", UintegerValue (bufferSize));
+  Config::SetDefault ("ns3::TcpSocket::RcvBufSize", UintegerValue (bufferSize));
+
+  NS_LOG_INFO ("Create nodes.");
+  NodeContainer nodes;
+  nodes.Create (2);
+
+  NS_LOG_INFO ("Create channels.");
+  PointToPointHelper pointToPoint;
+  pointToPoint.SetDeviceAttribute ("DataRate", StringValue (dataRate));
+  pointToPoint.SetChannelAttribute ("Delay", StringValue (delay));
+  // Enough room for the whole window, so that losses are only random
+  pointToPoint.SetQueue ("ns3::DropTailQueue", "MaxSize", StringValue ("100000p"));
+
+  NetDeviceContainer devices;
+  devices = pointToPoint.Install (nodes);
+
+  Ptr<RateErrorModel> em = CreateObject<RateErrorModel> ();
+  em->SetAttribute ("ErrorRate", DoubleValue (errorRate));
+  em->SetAttribute ("ErrorUnit", StringValue ("ERROR_UNIT_PACKET"));
+  devices.Get (1)->SetAttribute ("ReceiveErrorModel", PointerValue (em));
+
+  InternetStackHelper internet;
+  internet.Install (nodes);
+
+  NS_LOG_INFO ("Assign IP Addresses.");
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  Ipv4InterfaceContainer i = ipv4.Assign (devices);
+
+  NS_LOG_INFO ("Create Applications.");
+  uint16_t port = 9;
+  BulkSendHelper source ("ns3::TcpSocketFactory",
+                         InetSocketAddress (i.GetAddress (1), port));
+  source.SetAttribute ("SendSize", UintegerValue (segmentSize));
+  ApplicationContainer sourceApps = source.Install (nodes.Get (0));
+  sourceApps.Start (Seconds (0.0));
+  sourceApps.Stop (Seconds (simTime));
+
+  PacketSinkHelper sink ("ns3::TcpSocketFactory",
+                         InetSocketAddress (Ipv4Address::GetAny (), port));
+  ApplicationContainer sinkApps = sink.Install (nodes.Get (1));
+  sinkApps.Start (Seconds (0.0));
+  sinkApps.Stop (Seconds (simTime));
+
+  // The socket of the sender is created when the application starts
+  Simulator::Schedule (Seconds (0.001), &TraceBytesInFlight);
+
+  NS_LOG_INFO ("Run Simulation.");
+  SystemWallClockMs clock;
+  clock.Start ();
+  Simulator::Stop (Seconds (simTime));
+  Simulator::Run ();
+  int64_t elapsed = clock.End ();
+  Simulator::Destroy ();
+  NS_LOG_INFO ("Done.");
+
+  Ptr<PacketSink> sink1 = DynamicCast<PacketSink> (sinkApps.Get (0));
+  std::cout << "Total Bytes Received: " << sink1->GetTotalRx () << std::endl;
+  std::cout << "Goodput: " << sink1->GetTotalRx () * 8.0 / simTime / 1e6 << " Mbps" << std::endl;
+  std::cout << "Max Bytes In Flight: " << g_maxBytesInFlight << std::endl;
+  std::cout << "Wall Clock Time: " << elapsed / 1000.0 << " s" << std::endl;
+}
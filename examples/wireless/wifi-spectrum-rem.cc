@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/command-line.h"
+#include "ns3/config.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/log.h"
+#include "ns3/ssid.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/multi-model-spectrum-channel.h"
+#include "ns3/propagation-loss-model.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-radio-environment-map-helper.h"
+
+// This example generates a radio environment map of the 80 MHz channel 42
+// (channels 36 to 48), as seen by a receiver of configurable primary channel,
+// in presence of three 802.11ac access points operating on different channels:
+//   - AP 0 at (0,0) on the 20 MHz channel 36;
+//   - AP 1 at (50,0) on the 40 MHz channel 38, with primary channel 40;
+//   - AP 2 at (25,40) on the 80 MHz channel 42, with primary channel 48.
+//
+// The map is written to the file given by --remFile. Its columns are the
+// coordinates of the point, the widest channel width found idle by the CCA of
+// the receiver (0 if its primary channel is busy), the SINR of the strongest
+// AP on the primary channel, and the power received on channels 36, 40, 44
+// and 48 (dBm). The map can be plotted with gnuplot, e.g. for the idle width:
+//     set view map; plot "wifi-rem.out" using ($1):($2):($4) with image
+//
+// The points are spread over several threads with --threads; the propagation
+// loss model used here is deterministic, so the map does not depend on it:
+//     ./waf --run "wifi-spectrum-rem --primaryChannel=36 --threads=4"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiSpectrumRem");
+
+int main (int argc, char *argv[])
+{
+  uint16_t primaryChannel = 36;
+  uint32_t threads = 1;
+  uint16_t resolution = 100;
+  std::string remFile = "wifi-rem.out";
+
+  CommandLine cmd;
+  cmd.AddValue ("primaryChannel", "The primary 20 MHz channel of the receiver (36, 40, 44 or 48)", primaryChannel);
+  cmd.AddValue ("threads", "The number of threads generating the map", threads);
+  cmd.AddValue ("resolution", "The number of points of the map along each axis", resolution);
+  cmd.AddValue ("remFile", "The file to which the map is written", remFile);
+  cmd.Parse (argc, argv);
+
+  NodeContainer apNodes;
+  apNodes.Create (3);
+  NodeContainer rxNode;
+  rxNode.Create (1);
+
+  SpectrumWifiPhyHelper phy = SpectrumWifiPhyHelper::Default ();
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  Ptr<LogDistancePropagationLossModel> lossModel = CreateObject<LogDistancePropagationLossModel> ();
+  lossModel->SetAttribute ("ReferenceDistance", DoubleValue (1));
+  lossModel->SetAttribute ("Exponent", DoubleValue (3.5));
+  lossModel->SetAttribute ("ReferenceLoss", DoubleValue (50));
+  channel->AddPropagationLossModel (lossModel);
+  phy.SetChannel (channel);
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ac);
+  WifiMacHelper mac;
+  mac.SetType ("ns3::ApWifiMac", "Ssid", SsidValue (Ssid ("rem")));
+  NetDeviceContainer apDevices = wifi.Install (phy, mac, apNodes);
+  mac.SetType ("ns3::StaWifiMac", "Ssid", SsidValue (Ssid ("rem")));
+  NetDeviceContainer rxDevice = wifi.Install (phy, mac, rxNode);
+
+  uint16_t channels[3] = {36, 38, 42};
+  uint16_t primaryChannels[3] = {36, 40, 48};
+  for (uint32_t i = 0; i < 3; i++)
+    {
+      Ptr<WifiPhy> apPhy = DynamicCast<WifiNetDevice> (apDevices.Get (i))->GetPhy ();
+      apPhy->SetChannelNumber (channels[i]);
+      apPhy->SetPrimaryChannelNumber (primaryChannels[i]);
+    }
+  Ptr<WifiPhy> rxPhy = DynamicCast<WifiNetDevice> (rxDevice.Get (0))->GetPhy ();
+  rxPhy->SetChannelNumber (42);
+  rxPhy->SetPrimaryChannelNumber (primaryChannel);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 1.5));
+  positionAlloc->Add (Vector (50.0, 0.0, 1.5));
+  positionAlloc->Add (Vector (25.0, 40.0, 1.5));
+  positionAlloc->Add (Vector (0.0, 0.0, 1.5));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (apNodes);
+  mobility.Install (rxNode);
+
+  Ptr<WifiRadioEnvironmentMapHelper> remHelper = CreateObject<WifiRadioEnvironmentMapHelper> ();
+  remHelper->SetAttribute ("XMin", DoubleValue (-50.0));
+  remHelper->SetAttribute ("XMax", DoubleValue (100.0));
+  remHelper->SetAttribute ("XRes", UintegerValue (resolution));
+  remHelper->SetAttribute ("YMin", DoubleValue (-50.0));
+  remHelper->SetAttribute ("YMax", DoubleValue (90.0));
+  remHelper->SetAttribute ("YRes", UintegerValue (resolution));
+  remHelper->SetAttribute ("Z", DoubleValue (1.5));
+  remHelper->SetAttribute ("Threads", UintegerValue (threads));
+  remHelper->SetAttribute ("OutputFile", StringValue (remFile));
+  remHelper->SetReceiver (rxDevice.Get (0));
+  remHelper->AddTransmitters (apDevices);
+  remHelper->Generate ();
+
+  Simulator::Destroy ();
+  return 0;
+}
@@ -0,0 +1,35 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "atomic-ref-count.h"
+
+/**
+ * \file
+ * \ingroup ptr
+ * ns3::AtomicRefCount implementation.
+ */
+
+namespace ns3 {
+
+std::atomic<bool> AtomicRefCount::m_enabled (false);
+
+void
+AtomicRefCount::Enable (bool enable)
+{
+  m_enabled.store (enable, std::memory_order_relaxed);
+}
+
+} // namespace ns3
@@ -0,0 +1,125 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ATOMIC_REF_COUNT_H
+#define ATOMIC_REF_COUNT_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * \file
+ * \ingroup ptr
+ * ns3::AtomicRefCount declaration and implementation.
+ */
+
+namespace ns3 {
+
+/**
+ * \ingroup ptr
+ * \brief Reference counts that can be shared by several threads.
+ *
+ * The reference counts of SimpleRefCount, as well as those of the buffers,
+ * metadata and tags shared by the copies of a Packet, are updated by means
+ * of the static methods of this class. While enabled, the updates are atomic
+ * read-modify-write operations, hence an object can be referenced by several
+ * threads at the same time. Otherwise, the updates are plain loads and stores,
+ * which cost as much as the increments of a non-atomic counter.
+ *
+ * The atomic updates are enabled by the MultithreadedSimulatorImpl while
+ * partitions are executed in parallel, and must only be enabled or disabled
+ * while no other thread uses the counters.
+ *
+ * While enabled, data shared by several copies (e.g., by the copies of a
+ * packet) must not be written in place, even where the copy-on-write logic
+ * would otherwise allow it, because the copies may be owned by different
+ * threads.
+ */
+class AtomicRefCount
+{
+public:
+  /**
+   * Enable or disable the atomic updates of the reference counts.
+   *
+   * \param [in] enable whether the updates must be atomic
+   */
+  static void Enable (bool enable);
+  /**
+   * \return true if the updates of the reference counts are atomic
+   */
+  static inline bool IsEnabled (void)
+  {
+    return m_enabled.load (std::memory_order_relaxed);
+  }
+  /**
+   * \param [in] count The reference count.
+   * \return the value of the reference count
+   */
+  static inline uint32_t Get (const std::atomic<uint32_t> &count)
+  {
+    return count.load (std::memory_order_relaxed);
+  }
+  /**
+   * Initialize a reference count owned by the calling thread.
+   *
+   * \param [in] count The reference count.
+   * \param [in] value The value of the reference count.
+   */
+  static inline void Set (std::atomic<uint32_t> &count, uint32_t value)
+  {
+    count.store (value, std::memory_order_relaxed);
+  }
+  /**
+   * Increment a reference count.
+   *
+   * \param [in] count The reference count.
+   */
+  static inline void Increment (std::atomic<uint32_t> &count)
+  {
+    if (IsEnabled ())
+      {
+        count.fetch_add (1, std::memory_order_relaxed);
+      }
+    else
+      {
+        count.store (count.load (std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+      }
+  }
+  /**
+   * Decrement a reference count.
+   *
+   * \param [in] count The reference count.
+   * \return true if the reference count dropped to zero
+   */
+  static inline bool Decrement (std::atomic<uint32_t> &count)
+  {
+    if (IsEnabled ())
+      {
+        return count.fetch_sub (1, std::memory_order_acq_rel) == 1;
+      }
+    uint32_t value = count.load (std::memory_order_relaxed) - 1;
+    count.store (value, std::memory_order_relaxed);
+    return value == 0;
+  }
+
+private:
+  /** Whether the updates of the reference counts are atomic. */
+  static std::atomic<bool> m_enabled;
+};
+
+} // namespace ns3
+
+#endif /* ATOMIC_REF_COUNT_H */
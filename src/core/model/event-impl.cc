@@ -46,7 +46,7 @@ void
 EventImpl::Invoke (void)
 {
   NS_LOG_FUNCTION (this);
-  if (!m_cancel)
+  if (!m_cancel.load (std::memory_order_relaxed))
     {
       Notify ();
     }
@@ -56,14 +56,14 @@ void
 EventImpl::Cancel (void)
 {
   NS_LOG_FUNCTION (this);
-  m_cancel = true;
+  m_cancel.store (true, std::memory_order_relaxed);
 }
 
 bool
 EventImpl::IsCancelled (void)
 {
   NS_LOG_FUNCTION (this);
-  return m_cancel;
+  return m_cancel.load (std::memory_order_relaxed);
 }
 
 } // namespace ns3
@@ -21,6 +21,7 @@
 #define EVENT_IMPL_H
 
 #include <stdint.h>
+#include <atomic>
 #include "simple-ref-count.h"
 
 /**
@@ -76,7 +77,11 @@ protected:
   virtual void Notify (void) = 0;
 
 private:
-  bool m_cancel;  /**< Has this event been cancelled. */
+  /**
+   * Has this event been cancelled. Atomic, since the partitions of the
+   * MultithreadedSimulatorImpl may check the events of other partitions.
+   */
+  std::atomic<bool> m_cancel;
 };
 
 } // namespace ns3
@@ -0,0 +1,773 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "simulator.h"
+#include "multithreaded-simulator-impl.h"
+#include "scheduler.h"
+#include "event-impl.h"
+#include "atomic-ref-count.h"
+
+#include "ptr.h"
+#include "pointer.h"
+#include "uinteger.h"
+#include "assert.h"
+#include "log.h"
+
+#include <algorithm>
+#include <limits>
+#include <thread>
+
+
+/**
+ * \file
+ * \ingroup simulator
+ * ns3::MultithreadedSimulatorImpl implementation.
+ */
+
+namespace ns3 {
+
+// Note:  Logging in this file is largely avoided due to the
+// number of calls that are made to these functions and the possibility
+// of causing recursions leading to stack overflow
+NS_LOG_COMPONENT_DEFINE ("MultithreadedSimulatorImpl");
+
+NS_OBJECT_ENSURE_REGISTERED (MultithreadedSimulatorImpl);
+
+namespace {
+
+/** Value of g_partitionIndex for threads that do not execute any partition. */
+const uint32_t NO_PARTITION = 0xffffffff;
+
+/** The index of the partition executed by the calling thread. */
+thread_local uint32_t g_partitionIndex = NO_PARTITION;
+
+} // unnamed namespace
+
+TypeId
+MultithreadedSimulatorImpl::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::MultithreadedSimulatorImpl")
+    .SetParent<SimulatorImpl> ()
+    .SetGroupName ("Core")
+    .AddConstructor<MultithreadedSimulatorImpl> ()
+    .AddAttribute ("ThreadCount",
+                   "The number of threads executing the simulation, which is also "
+                   "the number of partitions the nodes are distributed across. "
+                   "If zero, the number of hardware threads is used.",
+                   UintegerValue (0),
+                   MakeUintegerAccessor (&MultithreadedSimulatorImpl::m_threadCount),
+                   MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Lookahead",
+                   "The minimum delay of the events scheduled for a node handled "
+                   "by another partition, e.g., the minimum propagation delay "
+                   "between any two nodes in different partitions.",
+                   TimeValue (MicroSeconds (1)),
+                   MakeTimeAccessor (&MultithreadedSimulatorImpl::m_lookahead),
+                   MakeTimeChecker (TimeStep (1)))
+  ;
+  return tid;
+}
+
+MultithreadedSimulatorImpl::MultithreadedSimulatorImpl ()
+  : m_threadCount (0),
+    m_stop (false),
+    m_stopTs (std::numeric_limits<uint64_t>::max ()),
+    m_windowStart (0),
+    m_windowEnd (0),
+    m_parallelPhase (false),
+    m_roundCount (0),
+    m_foreignEventsEmpty (true),
+    m_exit (false),
+    m_barrierCount (0),
+    m_barrierGeneration (0)
+{
+  NS_LOG_FUNCTION (this);
+  m_main = std::this_thread::get_id ();
+}
+
+MultithreadedSimulatorImpl::~MultithreadedSimulatorImpl ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+MultithreadedSimulatorImpl::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  DeliverEvents ();
+
+  for (auto& partition : m_partitions)
+    {
+      while (!partition.events->IsEmpty ())
+        {
+          Scheduler::Event next = partition.events->RemoveNext ();
+          next.impl->Unref ();
+        }
+      partition.events = 0;
+    }
+  m_partitions.clear ();
+  SimulatorImpl::DoDispose ();
+}
+
+void
+MultithreadedSimulatorImpl::Destroy ()
+{
+  NS_LOG_FUNCTION (this);
+  while (true)
+    {
+      Ptr<EventImpl> ev;
+      {
+        std::lock_guard<std::mutex> lock (m_destroyEventsMutex);
+        if (m_destroyEvents.empty ())
+          {
+            break;
+          }
+        ev = m_destroyEvents.front ().PeekEventImpl ();
+        m_destroyEvents.pop_front ();
+      }
+      NS_LOG_LOGIC ("handle destroy " << ev);
+      if (!ev->IsCancelled ())
+        {
+          ev->Invoke ();
+        }
+    }
+}
+
+void
+MultithreadedSimulatorImpl::CreatePartitions (void)
+{
+  if (!m_partitions.empty ())
+    {
+      return;
+    }
+  if (m_threadCount == 0)
+    {
+      m_threadCount = std::max (std::thread::hardware_concurrency (), 1u);
+    }
+  NS_LOG_DEBUG ("Creating " << m_threadCount << " partitions plus the global partition");
+
+  // the last partition is the global partition
+  m_partitions.resize (m_threadCount + 1);
+  for (auto& partition : m_partitions)
+    {
+      // uids are allocated from 4.
+      // uid 0 is "invalid" events
+      // uid 1 is "now" events
+      // uid 2 is "destroy" events
+      partition.uid = 4;
+      // before ::Run is entered, the currentUid will be zero
+      partition.currentUid = 0;
+      partition.currentTs = 0;
+      partition.currentContext = Simulator::NO_CONTEXT;
+      partition.eventCount = 0;
+      partition.outboxes.resize (m_partitions.size ());
+      partition.events = m_schedulerFactory.Create<Scheduler> ();
+    }
+}
+
+void
+MultithreadedSimulatorImpl::SetScheduler (ObjectFactory schedulerFactory)
+{
+  NS_LOG_FUNCTION (this << schedulerFactory);
+  m_schedulerFactory = schedulerFactory;
+
+  if (m_partitions.empty ())
+    {
+      CreatePartitions ();
+      return;
+    }
+
+  for (auto& partition : m_partitions)
+    {
+      Ptr<Scheduler> scheduler = schedulerFactory.Create<Scheduler> ();
+      while (!partition.events->IsEmpty ())
+        {
+          Scheduler::Event next = partition.events->RemoveNext ();
+          scheduler->Insert (next);
+        }
+      partition.events = scheduler;
+    }
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetPartitionIndex (uint32_t context) const
+{
+  if (context == Simulator::NO_CONTEXT)
+    {
+      return m_threadCount;
+    }
+  return context % m_threadCount;
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetCurrentPartitionIndex (void) const
+{
+  if (g_partitionIndex == NO_PARTITION)
+    {
+      return m_threadCount;
+    }
+  return g_partitionIndex;
+}
+
+bool
+MultithreadedSimulatorImpl::IsSerialPhase (void) const
+{
+  return std::this_thread::get_id () == m_main && !m_parallelPhase;
+}
+
+// System ID for non-distributed simulation is always zero
+uint32_t
+MultithreadedSimulatorImpl::GetSystemId (void) const
+{
+  return 0;
+}
+
+EventId
+MultithreadedSimulatorImpl::Insert (uint32_t index, uint64_t ts, uint32_t context, EventImpl *event)
+{
+  Partition &partition = m_partitions[index];
+  NS_ASSERT (ts >= partition.currentTs);
+
+  Scheduler::Event ev;
+  ev.impl = event;
+  ev.key.m_ts = ts;
+  ev.key.m_context = context;
+  ev.key.m_uid = partition.uid;
+  partition.uid++;
+  partition.events->Insert (ev);
+  return EventId (event, ev.key.m_ts, ev.key.m_context, ev.key.m_uid);
+}
+
+void
+MultithreadedSimulatorImpl::DeliverEvents (void)
+{
+  // cancellations and removals of events of other partitions, applied in
+  // the order of the source partition
+  for (auto& source : m_partitions)
+    {
+      for (auto& operation : source.deferred)
+        {
+          if (operation.remove)
+            {
+              Remove (operation.id);
+            }
+          else
+            {
+              Cancel (operation.id);
+            }
+        }
+      source.deferred.clear ();
+    }
+
+  // events exchanged between partitions, delivered in the order of the
+  // source partition so that the assignment of uids is deterministic
+  for (auto& source : m_partitions)
+    {
+      for (uint32_t dest = 0; dest < source.outboxes.size (); dest++)
+        {
+          for (auto& ev : source.outboxes[dest])
+            {
+              Insert (dest, ev.timestamp, ev.context, ev.event);
+            }
+          source.outboxes[dest].clear ();
+        }
+    }
+
+  if (m_foreignEventsEmpty.load (std::memory_order_acquire))
+    {
+      return;
+    }
+
+  std::list<EventWithContext> foreignEvents;
+  {
+    std::lock_guard<std::mutex> lock (m_foreignEventsMutex);
+    m_foreignEvents.swap (foreignEvents);
+    m_foreignEventsEmpty.store (true, std::memory_order_relaxed);
+  }
+  // all the partitions have processed the events before the end of the last
+  // window, hence the delay of events from foreign threads counts from there
+  uint64_t now = std::max (m_windowEnd, m_partitions.back ().currentTs);
+  for (auto& ev : foreignEvents)
+    {
+      uint32_t index = GetPartitionIndex (ev.context);
+      Insert (index, std::max (now, m_partitions[index].currentTs) + ev.timestamp,
+              ev.context, ev.event);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::ProcessOneEvent (uint32_t index)
+{
+  Partition &partition = m_partitions[index];
+  Scheduler::Event next = partition.events->RemoveNext ();
+
+  NS_ASSERT (next.key.m_ts >= partition.currentTs);
+  partition.eventCount++;
+
+  NS_LOG_LOGIC ("handle " << next.key.m_ts);
+  partition.currentTs = next.key.m_ts;
+  partition.currentContext = next.key.m_context;
+  partition.currentUid = next.key.m_uid;
+  next.impl->Invoke ();
+  next.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::ProcessWindow (uint32_t index)
+{
+  Ptr<Scheduler> events = m_partitions[index].events;
+  while (!events->IsEmpty () && events->PeekNext ().key.m_ts < m_windowEnd)
+    {
+      ProcessOneEvent (index);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::WaitBarrier (void)
+{
+  std::unique_lock<std::mutex> lock (m_barrierMutex);
+  uint64_t generation = m_barrierGeneration;
+
+  if (++m_barrierCount == m_threadCount)
+    {
+      m_barrierCount = 0;
+      m_barrierGeneration++;
+      m_barrierCond.notify_all ();
+      return;
+    }
+  m_barrierCond.wait (lock, [this, generation] { return m_barrierGeneration != generation; });
+}
+
+void
+MultithreadedSimulatorImpl::WorkerThread (uint32_t index)
+{
+  g_partitionIndex = index;
+  while (true)
+    {
+      // wait for the start of the next round
+      WaitBarrier ();
+      if (m_exit)
+        {
+          break;
+        }
+      ProcessWindow (index);
+      // wait for the end of the round
+      WaitBarrier ();
+    }
+  g_partitionIndex = NO_PARTITION;
+}
+
+bool
+MultithreadedSimulatorImpl::IsFinished (void) const
+{
+  if (m_stop)
+    {
+      return true;
+    }
+  for (auto& partition : m_partitions)
+    {
+      if (!partition.events->IsEmpty ())
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+void
+MultithreadedSimulatorImpl::Run (void)
+{
+  NS_LOG_FUNCTION (this);
+  // Set the current threadId as the main threadId
+  m_main = std::this_thread::get_id ();
+  CreatePartitions ();
+  m_stop = false;
+  m_exit = false;
+
+  for (uint32_t i = 1; i < m_threadCount; i++)
+    {
+      m_threads.emplace_back (&MultithreadedSimulatorImpl::WorkerThread, this, i);
+    }
+
+  const uint32_t global = m_threadCount;
+  Ptr<Scheduler> globalEvents = m_partitions[global].events;
+
+  while (true)
+    {
+      DeliverEvents ();
+      if (m_stop)
+        {
+          break;
+        }
+
+      // the timestamp of the earliest pending event
+      uint64_t minTs = std::numeric_limits<uint64_t>::max ();
+      for (auto& partition : m_partitions)
+        {
+          if (!partition.events->IsEmpty ())
+            {
+              minTs = std::min (minTs, partition.events->PeekNext ().key.m_ts);
+            }
+        }
+      if (minTs == std::numeric_limits<uint64_t>::max ())
+        {
+          // no more events
+          break;
+        }
+      if (minTs >= m_stopTs)
+        {
+          m_partitions[global].currentTs = std::max (m_partitions[global].currentTs, m_stopTs);
+          m_stopTs = std::numeric_limits<uint64_t>::max ();
+          break;
+        }
+
+      // global events are executed while all the other partitions are paused
+      if (!globalEvents->IsEmpty () && globalEvents->PeekNext ().key.m_ts == minTs)
+        {
+          while (!globalEvents->IsEmpty () && globalEvents->PeekNext ().key.m_ts == minTs && !m_stop)
+            {
+              ProcessOneEvent (global);
+            }
+          continue;
+        }
+
+      // all the partitions process the events in [minTs, minTs + lookahead)
+      m_windowStart = minTs;
+      m_windowEnd = std::min<uint64_t> (minTs + m_lookahead.GetTimeStep (), m_stopTs);
+      if (!globalEvents->IsEmpty ())
+        {
+          m_windowEnd = std::min (m_windowEnd, globalEvents->PeekNext ().key.m_ts);
+        }
+      m_roundCount++;
+
+      // the worker threads are waiting at the barrier, hence they see the
+      // reference counts switching to atomic updates once released
+      m_parallelPhase = true;
+      AtomicRefCount::Enable (m_threadCount > 1);
+      WaitBarrier ();
+      g_partitionIndex = 0;
+      ProcessWindow (0);
+      g_partitionIndex = NO_PARTITION;
+      WaitBarrier ();
+      AtomicRefCount::Enable (false);
+      m_parallelPhase = false;
+    }
+
+  m_exit = true;
+  WaitBarrier ();
+  for (auto& thread : m_threads)
+    {
+      thread.join ();
+    }
+  m_threads.clear ();
+
+  // the main program resumes at the time of the latest executed event
+  for (auto& partition : m_partitions)
+    {
+      m_partitions[global].currentTs = std::max (m_partitions[global].currentTs, partition.currentTs);
+    }
+}
+
+void
+MultithreadedSimulatorImpl::Stop (void)
+{
+  NS_LOG_FUNCTION (this);
+  std::lock_guard<std::mutex> lock (m_stopMutex);
+  m_stop = true;
+}
+
+void
+MultithreadedSimulatorImpl::Stop (Time const &delay)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep ());
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Stop(): Negative delay");
+  uint64_t stopTs = m_partitions[GetCurrentPartitionIndex ()].currentTs + delay.GetTimeStep ();
+  std::lock_guard<std::mutex> lock (m_stopMutex);
+  m_stopTs = std::min (m_stopTs, stopTs);
+}
+
+//
+// Schedule an event for a _relative_ time in the future.
+//
+EventId
+MultithreadedSimulatorImpl::Schedule (Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << delay.GetTimeStep () << event);
+  NS_ASSERT_MSG (IsSerialPhase () || g_partitionIndex != NO_PARTITION,
+                 "Simulator::Schedule Thread-unsafe invocation!");
+  NS_ASSERT_MSG (delay.IsPositive (), "MultithreadedSimulatorImpl::Schedule(): Negative delay");
+
+  uint32_t index = GetCurrentPartitionIndex ();
+  Partition &partition = m_partitions[index];
+  return Insert (index, partition.currentTs + delay.GetTimeStep (), partition.currentContext, event);
+}
+
+void
+MultithreadedSimulatorImpl::ScheduleWithContext (uint32_t context, Time const &delay, EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << context << delay.GetTimeStep () << event);
+
+  if (g_partitionIndex == NO_PARTITION && !IsSerialPhase ())
+    {
+      // foreign thread. Current time added in DeliverEvents()
+      EventWithContext ev;
+      ev.context = context;
+      ev.timestamp = delay.GetTimeStep ();
+      ev.event = event;
+      {
+        std::lock_guard<std::mutex> lock (m_foreignEventsMutex);
+        m_foreignEvents.push_back (ev);
+        m_foreignEventsEmpty.store (false, std::memory_order_release);
+      }
+      return;
+    }
+
+  uint32_t index = GetCurrentPartitionIndex ();
+  uint32_t dest = GetPartitionIndex (context);
+  uint64_t ts = m_partitions[index].currentTs + delay.GetTimeStep ();
+
+  if (dest == index || IsSerialPhase ())
+    {
+      Insert (dest, ts, context, event);
+      return;
+    }
+
+  // the event is handled by another partition, which may be processing
+  // events up to the end of the current window
+  if (ts < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Event scheduled with a delay of " << delay.GetTimeStep ()
+                      << " time steps for context " << context << " in another partition;"
+                      << " the Lookahead (" << m_lookahead.GetTimeStep ()
+                      << " time steps) must not exceed the delay between partitions");
+    }
+  EventWithContext ev;
+  ev.context = context;
+  ev.timestamp = ts;
+  ev.event = event;
+  m_partitions[index].outboxes[dest].push_back (ev);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleNow (EventImpl *event)
+{
+  return Schedule (TimeStep (0), event);
+}
+
+EventId
+MultithreadedSimulatorImpl::ScheduleDestroy (EventImpl *event)
+{
+  NS_LOG_FUNCTION (this << event);
+
+  EventId id (Ptr<EventImpl> (event, false), m_partitions[GetCurrentPartitionIndex ()].currentTs, 0xffffffff, 2);
+  std::lock_guard<std::mutex> lock (m_destroyEventsMutex);
+  m_destroyEvents.push_back (id);
+  return id;
+}
+
+Time
+MultithreadedSimulatorImpl::Now (void) const
+{
+  // Do not add function logging here, to avoid stack overflow
+  return TimeStep (m_partitions[GetCurrentPartitionIndex ()].currentTs);
+}
+
+Time
+MultithreadedSimulatorImpl::GetDelayLeft (const EventId &id) const
+{
+  if (IsExpired (id))
+    {
+      return TimeStep (0);
+    }
+  else
+    {
+      return TimeStep (id.GetTs ()) - Now ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsForeignPartitionEvent (const EventId &id, const char *operation) const
+{
+  if (g_partitionIndex == NO_PARTITION
+      || id.PeekEventImpl () == 0
+      || id.GetUid () == 2
+      || GetPartitionIndex (id.GetContext ()) == g_partitionIndex)
+    {
+      return false;
+    }
+  // the other partition may be processing events up to the end of the window
+  if (id.GetTs () >= m_windowStart && id.GetTs () < m_windowEnd)
+    {
+      NS_FATAL_ERROR ("Simulator::" << operation << " of an event at time step " << id.GetTs ()
+                      << " for context " << id.GetContext () << " in another partition,"
+                      << " which may execute it before the end of the current window"
+                      << " (time step " << m_windowEnd << ")");
+    }
+  return true;
+}
+
+bool
+MultithreadedSimulatorImpl::IsDeferredCancel (const EventId &id) const
+{
+  for (auto& operation : m_partitions[g_partitionIndex].deferred)
+    {
+      if (operation.id == id)
+        {
+          return true;
+        }
+    }
+  return false;
+}
+
+void
+MultithreadedSimulatorImpl::Remove (const EventId &id)
+{
+  if (id.GetUid () == 2)
+    {
+      // destroy events.
+      std::lock_guard<std::mutex> lock (m_destroyEventsMutex);
+      for (DestroyEvents::iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              m_destroyEvents.erase (i);
+              break;
+            }
+        }
+      return;
+    }
+  if (IsForeignPartitionEvent (id, "Remove"))
+    {
+      // removed once the other partition is paused
+      if (!IsExpired (id))
+        {
+          DeferredOperation operation = {id, true};
+          m_partitions[g_partitionIndex].deferred.push_back (operation);
+        }
+      return;
+    }
+  if (IsExpired (id))
+    {
+      return;
+    }
+  uint32_t index = GetPartitionIndex (id.GetContext ());
+  NS_ASSERT_MSG (IsSerialPhase () || index == g_partitionIndex,
+                 "Simulator::Remove Thread-unsafe invocation!");
+
+  Scheduler::Event event;
+  event.impl = id.PeekEventImpl ();
+  event.key.m_ts = id.GetTs ();
+  event.key.m_context = id.GetContext ();
+  event.key.m_uid = id.GetUid ();
+  m_partitions[index].events->Remove (event);
+  event.impl->Cancel ();
+  // whenever we remove an event from the event list, we have to unref it.
+  event.impl->Unref ();
+}
+
+void
+MultithreadedSimulatorImpl::Cancel (const EventId &id)
+{
+  if (IsForeignPartitionEvent (id, "Cancel"))
+    {
+      // cancelled once the other partition is paused
+      if (!IsExpired (id))
+        {
+          DeferredOperation operation = {id, false};
+          m_partitions[g_partitionIndex].deferred.push_back (operation);
+        }
+      return;
+    }
+  if (!IsExpired (id))
+    {
+      id.PeekEventImpl ()->Cancel ();
+    }
+}
+
+bool
+MultithreadedSimulatorImpl::IsExpired (const EventId &id) const
+{
+  if (id.GetUid () == 2)
+    {
+      if (id.PeekEventImpl () == 0
+          || id.PeekEventImpl ()->IsCancelled ())
+        {
+          return true;
+        }
+      // destroy events.
+      std::lock_guard<std::mutex> lock (m_destroyEventsMutex);
+      for (DestroyEvents::const_iterator i = m_destroyEvents.begin (); i != m_destroyEvents.end (); i++)
+        {
+          if (*i == id)
+            {
+              return false;
+            }
+        }
+      return true;
+    }
+  if (IsForeignPartitionEvent (id, "IsExpired"))
+    {
+      // the event was executed before the current window, or is executed
+      // after the end of the round unless cancelled
+      return id.GetTs () < m_windowStart
+             || id.PeekEventImpl ()->IsCancelled ()
+             || IsDeferredCancel (id);
+    }
+  // the event is compared to the current event of the partition handling it
+  const Partition &partition = m_partitions[GetPartitionIndex (id.GetContext ())];
+  if (id.PeekEventImpl () == 0
+      || id.GetTs () < partition.currentTs
+      || (id.GetTs () == partition.currentTs && id.GetUid () <= partition.currentUid)
+      || id.PeekEventImpl ()->IsCancelled ())
+    {
+      return true;
+    }
+  else
+    {
+      return false;
+    }
+}
+
+Time
+MultithreadedSimulatorImpl::GetMaximumSimulationTime (void) const
+{
+  return TimeStep (0x7fffffffffffffffLL);
+}
+
+uint32_t
+MultithreadedSimulatorImpl::GetContext (void) const
+{
+  return m_partitions[GetCurrentPartitionIndex ()].currentContext;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetEventCount (void) const
+{
+  uint64_t eventCount = 0;
+  for (auto& partition : m_partitions)
+    {
+      eventCount += partition.eventCount;
+    }
+  return eventCount;
+}
+
+uint64_t
+MultithreadedSimulatorImpl::GetRoundCount (void) const
+{
+  return m_roundCount;
+}
+
+} // namespace ns3
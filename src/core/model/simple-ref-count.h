@@ -26,6 +26,7 @@
 #include "default-deleter.h"
 #include "assert.h"
 #include "unused.h"
+#include "atomic-ref-count.h"
 #include <stdint.h>
 #include <limits>
 
@@ -104,8 +105,8 @@ public:
    */
   inline void Ref (void) const
   {
-    NS_ASSERT (m_count < std::numeric_limits<uint32_t>::max());
-    m_count++;
+    NS_ASSERT (AtomicRefCount::Get (m_count) < std::numeric_limits<uint32_t>::max());
+    AtomicRefCount::Increment (m_count);
   }
   /**
    * Decrement the reference count. This method should not be called
@@ -115,8 +116,7 @@ public:
    */
   inline void Unref (void) const
   {
-    m_count--;
-    if (m_count == 0)
+    if (AtomicRefCount::Decrement (m_count))
       {
         DELETER::Delete (static_cast<T*> (const_cast<SimpleRefCount *> (this)));
       }
@@ -130,7 +130,7 @@ public:
    */
   inline uint32_t GetReferenceCount (void) const
   {
-    return m_count;
+    return AtomicRefCount::Get (m_count);
   }
 
 private:
@@ -139,9 +139,11 @@ private:
    *
    * \internal
    * Note we make this mutable so that the const methods can still
-   * change it.
+   * change it. It is only updated by means of AtomicRefCount, so that
+   * the object can be shared by the partitions of the
+   * MultithreadedSimulatorImpl.
    */
-  mutable uint32_t m_count;
+  mutable std::atomic<uint32_t> m_count;
 };
 
 } // namespace ns3
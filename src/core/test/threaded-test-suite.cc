@@ -26,12 +26,15 @@
 #include "ns3/config.h"
 #include "ns3/string.h"
 #include "ns3/system-thread.h"
+#include "ns3/uinteger.h"
+#include "ns3/multithreaded-simulator-impl.h"
 
 #include <chrono>  // seconds, milliseconds
 #include <ctime>
 #include <list>
 #include <thread>  // sleep_for
 #include <utility>
+#include <vector>
 
 using namespace ns3;
 
@@ -226,6 +229,137 @@ ThreadedSimulatorEventsTestCase::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (m_a, m_d, "Bad scheduling");
 }
 
+/**
+ * Check that the MultithreadedSimulatorImpl executes the events of each
+ * context at the expected time and in the expected context, and that the
+ * results are the same as those obtained with the DefaultSimulatorImpl.
+ *
+ * Each context runs a local timer and forwards a token to the next context
+ * with a delay not less than the lookahead.
+ */
+class MultithreadedSimulatorTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   * \param threads the number of threads
+   */
+  MultithreadedSimulatorTestCase (unsigned int threads);
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Run the scenario with the given simulator implementation.
+   * \param simulatorType the simulator implementation type
+   */
+  void RunScenario (const std::string &simulatorType);
+  /**
+   * Receive the token.
+   * \param context the context the event is expected to be executed in
+   * \param expected the time the event is expected to be executed at
+   */
+  void Hop (uint32_t context, Time expected);
+  /**
+   * Local timer.
+   * \param context the context the event is expected to be executed in
+   * \param expected the time the event is expected to be executed at
+   */
+  void Tick (uint32_t context, Time expected);
+
+  static const uint32_t N_CONTEXTS = 8;   //!< number of contexts
+
+  unsigned int m_threads;                 //!< number of threads
+  std::vector<uint64_t> m_hops;           //!< number of tokens received per context
+  std::vector<uint64_t> m_ticks;          //!< number of local timer expirations per context
+  std::vector<uint64_t> m_errors;         //!< number of events executed in the wrong context or at the wrong time
+};
+
+MultithreadedSimulatorTestCase::MultithreadedSimulatorTestCase (unsigned int threads)
+  : TestCase ("Check multithreaded simulator with " + std::to_string (threads) + " threads"),
+    m_threads (threads)
+{
+}
+
+void
+MultithreadedSimulatorTestCase::Hop (uint32_t context, Time expected)
+{
+  if (Simulator::GetContext () != context || Simulator::Now () != expected)
+    {
+      m_errors[context]++;
+    }
+  m_hops[context]++;
+  uint32_t next = (context + 1) % N_CONTEXTS;
+  Simulator::ScheduleWithContext (next, MicroSeconds (3), &MultithreadedSimulatorTestCase::Hop,
+                                  this, next, expected + MicroSeconds (3));
+}
+
+void
+MultithreadedSimulatorTestCase::Tick (uint32_t context, Time expected)
+{
+  if (Simulator::GetContext () != context || Simulator::Now () != expected)
+    {
+      m_errors[context]++;
+    }
+  m_ticks[context]++;
+  Time delay = NanoSeconds (300 + 100 * context);
+  Simulator::Schedule (delay, &MultithreadedSimulatorTestCase::Tick, this, context, expected + delay);
+}
+
+void
+MultithreadedSimulatorTestCase::RunScenario (const std::string &simulatorType)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+  m_hops.assign (N_CONTEXTS, 0);
+  m_ticks.assign (N_CONTEXTS, 0);
+  m_errors.assign (N_CONTEXTS, 0);
+
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      Simulator::ScheduleWithContext (context, MicroSeconds (context), &MultithreadedSimulatorTestCase::Hop,
+                                      this, context, MicroSeconds (context));
+      Simulator::ScheduleWithContext (context, NanoSeconds (context), &MultithreadedSimulatorTestCase::Tick,
+                                      this, context, NanoSeconds (context));
+    }
+  Simulator::Stop (MilliSeconds (1));
+  Simulator::Run ();
+
+  NS_TEST_EXPECT_MSG_EQ (Simulator::Now (), MilliSeconds (1), "Unexpected stop time with " << simulatorType);
+  if (simulatorType == "ns3::MultithreadedSimulatorImpl")
+    {
+      Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+      NS_TEST_ASSERT_MSG_NE (impl, 0, "Unexpected simulator implementation");
+      NS_TEST_EXPECT_MSG_GT (impl->GetRoundCount (), 0, "No parallel round was performed");
+    }
+  Simulator::Destroy ();
+
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (m_errors[context], 0, "Event executed in the wrong context or at the wrong time");
+    }
+}
+
+void
+MultithreadedSimulatorTestCase::DoRun (void)
+{
+  RunScenario ("ns3::DefaultSimulatorImpl");
+  std::vector<uint64_t> hops = m_hops;
+  std::vector<uint64_t> ticks = m_ticks;
+
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (m_threads));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (3)));
+  RunScenario ("ns3::MultithreadedSimulatorImpl");
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (0));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (1)));
+
+  for (uint32_t context = 0; context < N_CONTEXTS; context++)
+    {
+      NS_TEST_EXPECT_MSG_GT (hops[context], 0, "Token not received by context " << context);
+      NS_TEST_EXPECT_MSG_EQ (m_hops[context], hops[context], "Unexpected number of tokens received by context " << context);
+      NS_TEST_EXPECT_MSG_EQ (m_ticks[context], ticks[context], "Unexpected number of timer expirations in context " << context);
+    }
+}
+
 class ThreadedSimulatorTestSuite : public TestSuite
 {
 public:
@@ -236,7 +370,8 @@ public:
 #ifdef HAVE_RT
       "ns3::RealtimeSimulatorImpl",
 #endif
-      "ns3::DefaultSimulatorImpl"
+      "ns3::DefaultSimulatorImpl",
+      "ns3::MultithreadedSimulatorImpl"
     };
     std::string schedulerTypes[] = {
       "ns3::ListScheduler",
@@ -263,5 +398,7 @@ public:
               }
           }
       }
+    AddTestCase (new MultithreadedSimulatorTestCase (1), TestCase::QUICK);
+    AddTestCase (new MultithreadedSimulatorTestCase (4), TestCase::QUICK);
   }
 } g_threadedSimulatorTestSuite;
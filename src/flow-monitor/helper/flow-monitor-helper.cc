@@ -29,6 +29,7 @@
 #include "ns3/ipv6-l3-protocol.h"
 #include "ns3/node.h"
 #include "ns3/node-list.h"
+#include "ns3/enum.h"
 
 
 namespace ns3 {
@@ -40,6 +41,12 @@ FlowMonitorHelper::FlowMonitorHelper ()
 
 FlowMonitorHelper::~FlowMonitorHelper ()
 {
+  for (std::vector<Ptr<FlowStatsExporter> >::iterator it = m_exporters.begin ();
+       it != m_exporters.end (); ++it)
+    {
+      (*it)->Dispose ();
+    }
+  m_exporters.clear ();
   if (m_flowMonitor)
     {
       m_flowMonitor->Dispose ();
@@ -174,5 +181,17 @@ FlowMonitorHelper::SerializeToXmlFile (std::string fileName, bool enableHistogra
     }
 }
 
+Ptr<FlowStatsExporter>
+FlowMonitorHelper::EnableStatsExport (std::string fileName, Time interval,
+                                      FlowStatsExporter::Format format)
+{
+  Ptr<FlowStatsExporter> exporter = CreateObject<FlowStatsExporter> ();
+  exporter->SetAttribute ("Interval", TimeValue (interval));
+  exporter->SetAttribute ("Format", EnumValue (format));
+  exporter->SetMonitor (GetMonitor ());
+  exporter->Open (fileName);
+  m_exporters.push_back (exporter);
+  return exporter;
+}
 
 } // namespace ns3
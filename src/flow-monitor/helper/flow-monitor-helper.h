@@ -24,7 +24,9 @@
 #include "ns3/object-factory.h"
 #include "ns3/flow-monitor.h"
 #include "ns3/flow-classifier.h"
+#include "ns3/flow-stats-exporter.h"
 #include <string>
+#include <vector>
 
 namespace ns3 {
 
@@ -112,6 +114,18 @@ public:
    */
   void SerializeToXmlFile (std::string fileName, bool enableHistograms, bool enableProbes);
 
+  /**
+   * Append the per-interval statistics of the flows to a file during the
+   * simulation (see FlowStatsExporter), instead of or in addition to
+   * serializing the results at the end.
+   * \param fileName name or path of the output file that will be created
+   * \param interval the duration of the intervals
+   * \param format the format of the output file
+   * \returns the FlowStatsExporter, e.g., to set flow filters
+   */
+  Ptr<FlowStatsExporter> EnableStatsExport (std::string fileName, Time interval,
+                                            FlowStatsExporter::Format format = FlowStatsExporter::CSV);
+
 private:
   /**
    * \brief Copy constructor
@@ -131,6 +145,7 @@ private:
   Ptr<FlowMonitor> m_flowMonitor;        //!< the FlowMonitor object
   Ptr<FlowClassifier> m_flowClassifier4; //!< the FlowClassifier object for IPv4
   Ptr<FlowClassifier> m_flowClassifier6; //!< the FlowClassifier object for IPv6
+  std::vector<Ptr<FlowStatsExporter> > m_exporters; //!< the FlowStatsExporter objects
 };
 
 } // namespace ns3
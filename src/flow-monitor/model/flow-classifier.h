@@ -38,6 +38,13 @@ typedef uint32_t FlowId;
  */
 typedef uint32_t FlowPacketId;
 
+/**
+ * \ingroup flow-monitor
+ * \brief Flow identifiers below this value are indexed by the per-flow
+ * vectors of FlowMonitor and FlowProbe, in addition to their maps
+ */
+static const uint32_t MAX_DENSE_FLOW_ID = 65536;
+
 
 /// \ingroup flow-monitor
 /// Provides a method to translate raw packet data into abstract
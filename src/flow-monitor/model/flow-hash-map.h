@@ -0,0 +1,255 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef FLOW_HASH_MAP_H
+#define FLOW_HASH_MAP_H
+
+#include <stdint.h>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup flow-monitor
+ *
+ * \brief Hash map with open addressing, used by the FlowMonitor and the
+ * flow classifiers to look up flows and packets on every probe hit.
+ *
+ * The entries are stored in a single array (linear probing), so that a
+ * lookup usually touches a single cache line and inserting an entry does
+ * not allocate memory, except when the table grows. Entries are removed
+ * by shifting back the entries that follow them, hence no tombstone is
+ * left behind.
+ *
+ * The references returned by Find and Insert are invalidated by the
+ * subsequent calls to Insert and Erase.
+ *
+ * \tparam Key the type of the keys, which must be equality comparable
+ * \tparam Value the type of the values, which must be default constructible
+ * \tparam Hash a functor returning a well-mixed uint32_t hash of a key
+ */
+template <typename Key, typename Value, typename Hash>
+class FlowHashMap
+{
+public:
+  FlowHashMap ();
+
+  /**
+   * \param key the key
+   * \return the value associated with the given key, or 0 if none
+   */
+  Value * Find (const Key &key);
+  /**
+   * \param key the key
+   * \return the value associated with the given key, or 0 if none
+   */
+  const Value * Find (const Key &key) const;
+  /**
+   * Find the value associated with the given key, inserting a default
+   * constructed value if none.
+   *
+   * \param key the key
+   * \param inserted set to true if the value has been inserted
+   * \return the value associated with the given key
+   */
+  Value & Insert (const Key &key, bool *inserted);
+  /**
+   * \param key the key
+   * \return true if the entry with the given key has been removed
+   */
+  bool Erase (const Key &key);
+  /**
+   * \return the number of entries
+   */
+  uint32_t GetSize (void) const;
+  /**
+   * Remove all the entries.
+   */
+  void Clear (void);
+
+private:
+  /// An entry of the table
+  struct Slot
+  {
+    Slot () : used (false) {}
+    Key key;      //!< the key
+    Value value;  //!< the value
+    bool used;    //!< whether the slot holds an entry
+  };
+
+  /**
+   * \param key the key
+   * \return the index of the slot holding the given key, or of the empty
+   *         slot where it would be inserted
+   */
+  uint32_t Probe (const Key &key) const;
+  /**
+   * Double the number of slots and rehash the entries.
+   */
+  void Grow (void);
+
+  std::vector<Slot> m_slots;  //!< the slots (a power of two)
+  uint32_t m_mask;            //!< the number of slots minus one
+  uint32_t m_size;            //!< the number of entries
+};
+
+/**
+ * \ingroup flow-monitor
+ *
+ * Mix the bits of a 64-bit integer into a 32-bit hash (Fibonacci hashing).
+ *
+ * \param x the integer
+ * \return the hash
+ */
+inline uint32_t
+FlowHashMix (uint64_t x)
+{
+  return static_cast<uint32_t> ((x * 0x9e3779b97f4a7c15ULL) >> 32);
+}
+
+
+template <typename Key, typename Value, typename Hash>
+FlowHashMap<Key, Value, Hash>::FlowHashMap ()
+  : m_slots (16),
+    m_mask (15),
+    m_size (0)
+{
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t
+FlowHashMap<Key, Value, Hash>::Probe (const Key &key) const
+{
+  uint32_t i = Hash () (key) & m_mask;
+  while (m_slots[i].used && !(m_slots[i].key == key))
+    {
+      i = (i + 1) & m_mask;
+    }
+  return i;
+}
+
+template <typename Key, typename Value, typename Hash>
+Value *
+FlowHashMap<Key, Value, Hash>::Find (const Key &key)
+{
+  uint32_t i = Probe (key);
+  return m_slots[i].used ? &m_slots[i].value : 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+const Value *
+FlowHashMap<Key, Value, Hash>::Find (const Key &key) const
+{
+  uint32_t i = Probe (key);
+  return m_slots[i].used ? &m_slots[i].value : 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+Value &
+FlowHashMap<Key, Value, Hash>::Insert (const Key &key, bool *inserted)
+{
+  uint32_t i = Probe (key);
+  if (m_slots[i].used)
+    {
+      *inserted = false;
+      return m_slots[i].value;
+    }
+  // keep the load factor below one half
+  if (2 * (m_size + 1) > m_slots.size ())
+    {
+      Grow ();
+      i = Probe (key);
+    }
+  m_slots[i].used = true;
+  m_slots[i].key = key;
+  m_slots[i].value = Value ();
+  m_size++;
+  *inserted = true;
+  return m_slots[i].value;
+}
+
+template <typename Key, typename Value, typename Hash>
+bool
+FlowHashMap<Key, Value, Hash>::Erase (const Key &key)
+{
+  uint32_t i = Probe (key);
+  if (!m_slots[i].used)
+    {
+      return false;
+    }
+  // shift back the following entries of the cluster which can be moved
+  // closer to their home slot
+  uint32_t j = i;
+  while (true)
+    {
+      j = (j + 1) & m_mask;
+      if (!m_slots[j].used)
+        {
+          break;
+        }
+      uint32_t home = Hash () (m_slots[j].key) & m_mask;
+      // the entry can be moved to slot i unless its home slot is
+      // cyclically within (i, j]
+      bool between = (i <= j) ? (i < home && home <= j) : (i < home || home <= j);
+      if (!between)
+        {
+          m_slots[i].key = m_slots[j].key;
+          m_slots[i].value = m_slots[j].value;
+          i = j;
+        }
+    }
+  m_slots[i].used = false;
+  m_slots[i].value = Value ();
+  m_size--;
+  return true;
+}
+
+template <typename Key, typename Value, typename Hash>
+uint32_t
+FlowHashMap<Key, Value, Hash>::GetSize (void) const
+{
+  return m_size;
+}
+
+template <typename Key, typename Value, typename Hash>
+void
+FlowHashMap<Key, Value, Hash>::Clear (void)
+{
+  m_slots.assign (16, Slot ());
+  m_mask = 15;
+  m_size = 0;
+}
+
+template <typename Key, typename Value, typename Hash>
+void
+FlowHashMap<Key, Value, Hash>::Grow (void)
+{
+  std::vector<Slot> old (2 * m_slots.size ());
+  old.swap (m_slots);
+  m_mask = m_slots.size () - 1;
+  for (typename std::vector<Slot>::const_iterator it = old.begin (); it != old.end (); ++it)
+    {
+      if (it->used)
+        {
+          uint32_t i = Probe (it->key);
+          m_slots[i] = *it;
+        }
+    }
+}
+
+} // namespace ns3
+
+#endif /* FLOW_HASH_MAP_H */
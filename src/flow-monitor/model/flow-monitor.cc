@@ -22,10 +22,14 @@
 #include "ns3/simulator.h"
 #include "ns3/log.h"
 #include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
 #include <fstream>
 #include <sstream>
+#include <algorithm>
 
 #define PERIODIC_CHECK_INTERVAL (Seconds (1))
+#define LOSS_WHEEL_SLOT (MilliSeconds (100))
 
 namespace ns3 {
 
@@ -69,6 +73,24 @@ FlowMonitor::GetTypeId (void)
                    TimeValue (Seconds (0.5)),
                    MakeTimeAccessor (&FlowMonitor::m_flowInterruptionsMinTime),
                    MakeTimeChecker ())
+    .AddAttribute ("EnableHistograms", ("Whether the delay, jitter, packet size and flow interruptions "
+                                        "histograms are collected. Disabling them bounds the memory used "
+                                        "by the flows during long runs (see FlowStatsExporter)."),
+                   BooleanValue (true),
+                   MakeBooleanAccessor (&FlowMonitor::m_enableHistograms),
+                   MakeBooleanChecker ())
+    .AddAttribute ("EnableLogLinearHistograms", ("Whether the log-linear histograms of the delays, "
+                                                 "jitters and packet sizes are collected. Their memory "
+                                                 "does not depend on the values observed, and they give "
+                                                 "the percentiles with a bounded relative error."),
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&FlowMonitor::m_enableLogLinearHistograms),
+                   MakeBooleanChecker ())
+    .AddAttribute ("LogLinearHistogramPrecision", ("The number of bits of precision of the log-linear "
+                                                   "histograms (the relative error is 2^(1-precision))."),
+                   UintegerValue (7),
+                   MakeUintegerAccessor (&FlowMonitor::m_logLinearHistogramPrecision),
+                   MakeUintegerChecker<uint8_t> (2, 16))
   ;
   return tid;
 }
@@ -80,7 +102,8 @@ FlowMonitor::GetInstanceTypeId (void) const
 }
 
 FlowMonitor::FlowMonitor ()
-  : m_enabled (false)
+  : m_lossWheelStart (0),
+    m_enabled (false)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -109,11 +132,26 @@ inline FlowMonitor::FlowStats&
 FlowMonitor::GetStatsForFlow (FlowId flowId)
 {
   NS_LOG_FUNCTION (this);
+  if (flowId < m_flowStatsIndex.size () && m_flowStatsIndex[flowId] != 0)
+    {
+      return *m_flowStatsIndex[flowId];
+    }
   FlowStatsContainerI iter;
   iter = m_flowStats.find (flowId);
   if (iter == m_flowStats.end ())
     {
       FlowMonitor::FlowStats &ref = m_flowStats[flowId];
+      // the flow identifiers assigned by the classifiers are dense, hence
+      // the stats of the flows are also indexed by a vector (the elements
+      // of a map are not moved by the insertions)
+      if (flowId < MAX_DENSE_FLOW_ID)
+        {
+          if (flowId >= m_flowStatsIndex.size ())
+            {
+              m_flowStatsIndex.resize (flowId + 1, 0);
+            }
+          m_flowStatsIndex[flowId] = &ref;
+        }
       ref.delaySum = Seconds (0);
       ref.jitterSum = Seconds (0);
       ref.lastDelay = Seconds (0);
@@ -127,6 +165,9 @@ FlowMonitor::GetStatsForFlow (FlowId flowId)
       ref.jitterHistogram.SetDefaultBinWidth (m_jitterBinWidth);
       ref.packetSizeHistogram.SetDefaultBinWidth (m_packetSizeBinWidth);
       ref.flowInterruptionsHistogram.SetDefaultBinWidth (m_flowInterruptionsBinWidth);
+      ref.delayLogHistogram = LogLinearHistogram (m_logLinearHistogramPrecision);
+      ref.jitterLogHistogram = LogLinearHistogram (m_logLinearHistogramPrecision);
+      ref.packetSizeLogHistogram = LogLinearHistogram (m_logLinearHistogramPrecision);
       return ref;
     }
   else
@@ -146,10 +187,16 @@ FlowMonitor::ReportFirstTx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t pack
       return;
     }
   Time now = Simulator::Now ();
-  TrackedPacket &tracked = m_trackedPackets[std::make_pair (flowId, packetId)];
+  uint64_t key = GetTrackedPacketKey (flowId, packetId);
+  bool inserted;
+  TrackedPacket &tracked = m_trackedPackets.Insert (key, &inserted);
   tracked.firstSeenTime = now;
   tracked.lastSeenTime = tracked.firstSeenTime;
   tracked.timesForwarded = 0;
+  if (inserted)
+    {
+      AddToLossWheel (key, now);
+    }
   NS_LOG_DEBUG ("ReportFirstTx: adding tracked packet (flowId=" << flowId << ", packetId=" << packetId
                                                                 << ").");
 
@@ -175,19 +222,18 @@ FlowMonitor::ReportForwarding (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t p
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  std::pair<FlowId, FlowPacketId> key (flowId, packetId);
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (key);
-  if (tracked == m_trackedPackets.end ())
+  TrackedPacket *tracked = m_trackedPackets.Find (GetTrackedPacketKey (flowId, packetId));
+  if (tracked == 0)
     {
       NS_LOG_WARN ("Received packet forward report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
       return;
     }
 
-  tracked->second.timesForwarded++;
-  tracked->second.lastSeenTime = Simulator::Now ();
+  tracked->timesForwarded++;
+  tracked->lastSeenTime = Simulator::Now ();
 
-  Time delay = (Simulator::Now () - tracked->second.firstSeenTime);
+  Time delay = (Simulator::Now () - tracked->firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 }
 
@@ -201,8 +247,9 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
       NS_LOG_DEBUG ("FlowMonitor not enabled; returning");
       return;
     }
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked == m_trackedPackets.end ())
+  uint64_t key = GetTrackedPacketKey (flowId, packetId);
+  TrackedPacket *tracked = m_trackedPackets.Find (key);
+  if (tracked == 0)
     {
       NS_LOG_WARN ("Received packet last-tx report (flowId=" << flowId << ", packetId=" << packetId
                                                              << ") but not known to be transmitted.");
@@ -210,30 +257,51 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     }
 
   Time now = Simulator::Now ();
-  Time delay = (now - tracked->second.firstSeenTime);
+  Time delay = (now - tracked->firstSeenTime);
   probe->AddPacketStats (flowId, packetSize, delay);
 
   FlowStats &stats = GetStatsForFlow (flowId);
   stats.delaySum += delay;
-  stats.delayHistogram.AddValue (delay.GetSeconds ());
+  if (m_enableHistograms)
+    {
+      stats.delayHistogram.AddValue (delay.GetSeconds ());
+    }
+  if (m_enableLogLinearHistograms)
+    {
+      stats.delayLogHistogram.AddValue (delay.GetNanoSeconds ());
+    }
   if (stats.rxPackets > 0 )
     {
       Time jitter = stats.lastDelay - delay;
       if (jitter > Seconds (0))
         {
           stats.jitterSum += jitter;
-          stats.jitterHistogram.AddValue (jitter.GetSeconds ());
         }
       else 
         {
           stats.jitterSum -= jitter;
-          stats.jitterHistogram.AddValue (-jitter.GetSeconds ());
+          jitter = Seconds (0) - jitter;
+        }
+      if (m_enableHistograms)
+        {
+          stats.jitterHistogram.AddValue (jitter.GetSeconds ());
+        }
+      if (m_enableLogLinearHistograms)
+        {
+          stats.jitterLogHistogram.AddValue (jitter.GetNanoSeconds ());
         }
     }
   stats.lastDelay = delay;
 
   stats.rxBytes += packetSize;
-  stats.packetSizeHistogram.AddValue ((double) packetSize);
+  if (m_enableHistograms)
+    {
+      stats.packetSizeHistogram.AddValue ((double) packetSize);
+    }
+  if (m_enableLogLinearHistograms)
+    {
+      stats.packetSizeLogHistogram.AddValue (packetSize);
+    }
   stats.rxPackets++;
   if (stats.rxPackets == 1)
     {
@@ -243,18 +311,20 @@ FlowMonitor::ReportLastRx (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packe
     {
       // measure possible flow interruptions
       Time interArrivalTime = now - stats.timeLastRxPacket;
-      if (interArrivalTime > m_flowInterruptionsMinTime)
+      if (interArrivalTime > m_flowInterruptionsMinTime && m_enableHistograms)
         {
           stats.flowInterruptionsHistogram.AddValue (interArrivalTime.GetSeconds ());
         }
     }
   stats.timeLastRxPacket = now;
-  stats.timesForwarded += tracked->second.timesForwarded;
+  stats.timesForwarded += tracked->timesForwarded;
 
   NS_LOG_DEBUG ("ReportLastTx: removing tracked packet (flowId="
                 << flowId << ", packetId=" << packetId << ").");
 
-  m_trackedPackets.erase (tracked); // we don't need to track this packet anymore
+  // we don't need to track this packet anymore (its entry in the time
+  // wheel is discarded when its slot is checked)
+  m_trackedPackets.Erase (key);
 }
 
 void
@@ -281,14 +351,12 @@ FlowMonitor::ReportDrop (Ptr<FlowProbe> probe, uint32_t flowId, uint32_t packetI
   stats.bytesDropped[reasonCode] += packetSize;
   NS_LOG_DEBUG ("++stats.packetsDropped[" << reasonCode<< "]; // becomes: " << stats.packetsDropped[reasonCode]);
 
-  TrackedPacketMap::iterator tracked = m_trackedPackets.find (std::make_pair (flowId, packetId));
-  if (tracked != m_trackedPackets.end ())
+  if (m_trackedPackets.Erase (GetTrackedPacketKey (flowId, packetId)))
     {
       // we don't need to track this packet anymore
       // FIXME: this will not necessarily be true with broadcast/multicast
-      NS_LOG_DEBUG ("ReportDrop: removing tracked packet (flowId="
+      NS_LOG_DEBUG ("ReportDrop: removed tracked packet (flowId="
                     << flowId << ", packetId=" << packetId << ").");
-      m_trackedPackets.erase (tracked);
     }
 }
 
@@ -299,29 +367,83 @@ FlowMonitor::GetFlowStats () const
 }
 
 
+uint64_t
+FlowMonitor::GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId)
+{
+  return (static_cast<uint64_t> (flowId) << 32) | packetId;
+}
+
+void
+FlowMonitor::AddToLossWheel (uint64_t key, Time lastSeenTime)
+{
+  int64_t slot = lastSeenTime.GetTimeStep () / LOSS_WHEEL_SLOT.GetTimeStep ();
+  if (m_lossWheel.empty ())
+    {
+      m_lossWheelStart = slot;
+    }
+  // a packet cannot be added to a slot already checked, but the first
+  // slot is checked again anyway
+  slot = std::max (slot, m_lossWheelStart);
+  while (m_lossWheelStart + static_cast<int64_t> (m_lossWheel.size ()) <= slot)
+    {
+      m_lossWheel.push_back (std::vector<uint64_t> ());
+    }
+  m_lossWheel[slot - m_lossWheelStart].push_back (key);
+}
+
 void
 FlowMonitor::CheckForLostPackets (Time maxDelay)
 {
   NS_LOG_FUNCTION (this << maxDelay.GetSeconds ());
-  Time now = Simulator::Now ();
+  // packets last seen at or before this time are considered lost
+  int64_t threshold = (Simulator::Now () - maxDelay).GetTimeStep ();
+  int64_t slotDuration = LOSS_WHEEL_SLOT.GetTimeStep ();
 
-  for (TrackedPacketMap::iterator iter = m_trackedPackets.begin ();
-       iter != m_trackedPackets.end (); )
+  // only visit the slots of the time wheel which may hold lost packets
+  while (!m_lossWheel.empty () && m_lossWheelStart * slotDuration <= threshold)
     {
-      if (now - iter->second.lastSeenTime >= maxDelay)
+      // whether all the packets still in this slot are lost
+      bool expired = (m_lossWheelStart + 1) * slotDuration - 1 <= threshold;
+      std::vector<uint64_t> keys;
+      keys.swap (m_lossWheel.front ());
+      std::vector<uint64_t> pending;
+      for (std::vector<uint64_t>::const_iterator it = keys.begin (); it != keys.end (); ++it)
         {
-          // packet is considered lost, add it to the loss statistics
-          FlowStatsContainerI flow = m_flowStats.find (iter->first.first);
-          NS_ASSERT (flow != m_flowStats.end ());
-          flow->second.lostPackets++;
-
-          // we won't track it anymore
-          m_trackedPackets.erase (iter++);
+          TrackedPacket *tracked = m_trackedPackets.Find (*it);
+          if (tracked == 0)
+            {
+              // already received or dropped
+              continue;
+            }
+          int64_t lastSeen = tracked->lastSeenTime.GetTimeStep ();
+          if (lastSeen <= threshold)
+            {
+              // packet is considered lost, add it to the loss statistics
+              FlowId flowId = static_cast<FlowId> (*it >> 32);
+              NS_ASSERT (m_flowStats.find (flowId) != m_flowStats.end ());
+              GetStatsForFlow (flowId).lostPackets++;
+
+              // we won't track it anymore
+              m_trackedPackets.Erase (*it);
+            }
+          else if (lastSeen / slotDuration == m_lossWheelStart)
+            {
+              pending.push_back (*it);
+            }
+          else
+            {
+              // the packet has been seen since it was added to this slot
+              AddToLossWheel (*it, tracked->lastSeenTime);
+            }
         }
-      else
+      if (!expired)
         {
-          iter++;
+          m_lossWheel.front ().swap (pending);
+          break;
         }
+      NS_ASSERT (pending.empty ());
+      m_lossWheel.pop_front ();
+      m_lossWheelStart++;
     }
 }
 
@@ -468,6 +590,12 @@ FlowMonitor::SerializeToXmlStream (std::ostream &os, uint16_t indent, bool enabl
           flowI->second.jitterHistogram.SerializeToXmlStream (os, indent, "jitterHistogram");
           flowI->second.packetSizeHistogram.SerializeToXmlStream (os, indent, "packetSizeHistogram");
           flowI->second.flowInterruptionsHistogram.SerializeToXmlStream (os, indent, "flowInterruptionsHistogram");
+          if (m_enableLogLinearHistograms)
+            {
+              flowI->second.delayLogHistogram.SerializeToXmlStream (os, indent, "delayLogHistogram");
+              flowI->second.jitterLogHistogram.SerializeToXmlStream (os, indent, "jitterLogHistogram");
+              flowI->second.packetSizeLogHistogram.SerializeToXmlStream (os, indent, "packetSizeLogHistogram");
+            }
         }
       indent -= 2;
 
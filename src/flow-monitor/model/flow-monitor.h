@@ -23,12 +23,15 @@
 
 #include <vector>
 #include <map>
+#include <deque>
 
 #include "ns3/ptr.h"
 #include "ns3/object.h"
 #include "ns3/flow-probe.h"
 #include "ns3/flow-classifier.h"
 #include "ns3/histogram.h"
+#include "ns3/log-linear-histogram.h"
+#include "ns3/flow-hash-map.h"
 #include "ns3/nstime.h"
 #include "ns3/event-id.h"
 
@@ -135,6 +138,16 @@ public:
     /// comment in attribute packetsDropped.
     std::vector<uint64_t> bytesDropped; // bytesDropped[reasonCode] => number of dropped bytes
     Histogram flowInterruptionsHistogram; //!< histogram of durations of flow interruptions
+
+    /// Log-linear histogram of the packet delays, in nanoseconds (only
+    /// filled if the EnableLogLinearHistograms attribute is set), which
+    /// gives the percentiles of the delays with a bounded relative error
+    /// and can be merged with the histograms of other runs
+    LogLinearHistogram delayLogHistogram;
+    /// Log-linear histogram of the packet jitters, in nanoseconds
+    LogLinearHistogram jitterLogHistogram;
+    /// Log-linear histogram of the packet sizes, in bytes
+    LogLinearHistogram packetSizeLogHistogram;
   };
 
   // --- basic methods ---
@@ -276,10 +289,30 @@ private:
 
   /// FlowId --> FlowStats
   FlowStatsContainer m_flowStats;
+  /// FlowId --> FlowStats, for the dense range of flow identifiers
+  std::vector<FlowStats *> m_flowStatsIndex;
 
+  /// Hash of the key of a tracked packet
+  struct TrackedPacketHash
+  {
+    /// \param key the key
+    /// \return the hash of the key
+    uint32_t operator() (uint64_t key) const
+    {
+      return FlowHashMix (key);
+    }
+  };
   /// (FlowId,PacketId) --> TrackedPacket
-  typedef std::map< std::pair<FlowId, FlowPacketId>, TrackedPacket> TrackedPacketMap;
+  typedef FlowHashMap<uint64_t, TrackedPacket, TrackedPacketHash> TrackedPacketMap;
   TrackedPacketMap m_trackedPackets; //!< Tracked packets
+  /**
+   * Time wheel of the tracked packets: each slot holds the keys of the
+   * packets last seen during a period of LOSS_WHEEL_SLOT. A packet whose
+   * last seen time is updated is moved to its new slot lazily, when its
+   * former slot is checked for lost packets.
+   */
+  std::deque<std::vector<uint64_t> > m_lossWheel;
+  int64_t m_lossWheelStart; //!< index of the first slot of the time wheel
   Time m_maxPerHopDelay; //!< Minimum per-hop delay
   FlowProbeContainer m_flowProbes; //!< all the FlowProbes
 
@@ -294,12 +327,25 @@ private:
   double m_packetSizeBinWidth;  //!< packet size bin width (for histograms)
   double m_flowInterruptionsBinWidth; //!< Flow interruptions bin width (for histograms)
   Time m_flowInterruptionsMinTime; //!< Flow interruptions minimum time
+  bool m_enableHistograms; //!< whether the histograms are collected
+  bool m_enableLogLinearHistograms; //!< whether the log-linear histograms are collected
+  uint8_t m_logLinearHistogramPrecision; //!< precision bits of the log-linear histograms
 
   /// Get the stats for a given flow
   /// \param flowId the Flow identification
   /// \returns the stats of the flow
   FlowStats& GetStatsForFlow (FlowId flowId);
 
+  /// \param flowId the Flow identification
+  /// \param packetId the Packet identification
+  /// \returns the key of the tracked packet
+  static uint64_t GetTrackedPacketKey (FlowId flowId, FlowPacketId packetId);
+
+  /// Add a tracked packet to the time wheel
+  /// \param key the key of the tracked packet
+  /// \param lastSeenTime the time when the packet was last seen
+  void AddToLossWheel (uint64_t key, Time lastSeenTime);
+
   /// Periodic function to check for lost packets and prune statistics
   void PeriodicCheckForLostPackets ();
 };
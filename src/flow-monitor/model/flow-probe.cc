@@ -53,10 +53,30 @@ FlowProbe::DoDispose (void)
   Object::DoDispose ();
 }
 
+FlowProbe::FlowStats &
+FlowProbe::GetStatsForFlow (FlowId flowId)
+{
+  if (flowId < m_statsIndex.size () && m_statsIndex[flowId] != 0)
+    {
+      return *m_statsIndex[flowId];
+    }
+  FlowStats &flow = m_stats[flowId];
+  // the flow identifiers are dense, see FlowMonitor::GetStatsForFlow
+  if (flowId < MAX_DENSE_FLOW_ID)
+    {
+      if (flowId >= m_statsIndex.size ())
+        {
+          m_statsIndex.resize (flowId + 1, 0);
+        }
+      m_statsIndex[flowId] = &flow;
+    }
+  return flow;
+}
+
 void
 FlowProbe::AddPacketStats (FlowId flowId, uint32_t packetSize, Time delayFromFirstProbe)
 {
-  FlowStats &flow = m_stats[flowId];
+  FlowStats &flow = GetStatsForFlow (flowId);
   flow.delayFromFirstProbeSum += delayFromFirstProbe;
   flow.bytes += packetSize;
   ++flow.packets;
@@ -65,7 +85,7 @@ FlowProbe::AddPacketStats (FlowId flowId, uint32_t packetSize, Time delayFromFir
 void
 FlowProbe::AddPacketDropStats (FlowId flowId, uint32_t packetSize, uint32_t reasonCode)
 {
-  FlowStats &flow = m_stats[flowId];
+  FlowStats &flow = GetStatsForFlow (flowId);
 
   if (flow.packetsDropped.size () < reasonCode + 1)
     {
@@ -106,6 +106,13 @@ protected:
   Ptr<FlowMonitor> m_flowMonitor; //!< the FlowMonitor instance
   Stats m_stats; //!< The flow stats
 
+private:
+  /// \param flowId the flow identifier
+  /// \return the stats of the given flow
+  FlowStats & GetStatsForFlow (FlowId flowId);
+
+  std::vector<FlowStats *> m_statsIndex; //!< The flow stats, indexed by flow identifier
+
 };
 
 
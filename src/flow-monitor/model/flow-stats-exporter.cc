@@ -0,0 +1,285 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License version 2 as
+// published by the Free Software Foundation;
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+//
+
+#include "flow-stats-exporter.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/enum.h"
+
+#define BINARY_FORMAT_VERSION 1
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FlowStatsExporter");
+
+NS_OBJECT_ENSURE_REGISTERED (FlowStatsExporter);
+
+TypeId
+FlowStatsExporter::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::FlowStatsExporter")
+    .SetParent<Object> ()
+    .SetGroupName ("FlowMonitor")
+    .AddConstructor<FlowStatsExporter> ()
+    .AddAttribute ("Interval", "The duration of the intervals whose statistics are exported.",
+                   TimeValue (Seconds (1.0)),
+                   MakeTimeAccessor (&FlowStatsExporter::m_interval),
+                   MakeTimeChecker (NanoSeconds (1)))
+    .AddAttribute ("Format", "The format of the output file.",
+                   EnumValue (FlowStatsExporter::CSV),
+                   MakeEnumAccessor (&FlowStatsExporter::m_format),
+                   MakeEnumChecker (FlowStatsExporter::CSV, "Csv",
+                                    FlowStatsExporter::BINARY, "Binary"))
+    .AddAttribute ("StartTime", "The time when the export starts.",
+                   TimeValue (Seconds (0.0)),
+                   MakeTimeAccessor (&FlowStatsExporter::Start),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+FlowStatsExporter::Snapshot::Snapshot ()
+  : txPackets (0),
+    rxPackets (0),
+    lostPackets (0),
+    txBytes (0),
+    rxBytes (0)
+{
+}
+
+FlowStatsExporter::FlowStatsExporter ()
+  : m_enabled (false)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+FlowStatsExporter::~FlowStatsExporter ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+FlowStatsExporter::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_startEvent);
+  Simulator::Cancel (m_stopEvent);
+  Simulator::Cancel (m_exportEvent);
+  if (m_os.is_open ())
+    {
+      m_os.close ();
+    }
+  m_monitor = 0;
+  m_filter = Callback<bool, FlowId> ();
+  m_snapshots.clear ();
+  Object::DoDispose ();
+}
+
+void
+FlowStatsExporter::SetMonitor (Ptr<FlowMonitor> monitor)
+{
+  NS_LOG_FUNCTION (this << monitor);
+  m_monitor = monitor;
+}
+
+void
+FlowStatsExporter::Open (std::string fileName)
+{
+  NS_LOG_FUNCTION (this << fileName);
+  if (m_os.is_open ())
+    {
+      m_os.close ();
+    }
+  m_os.open (fileName.c_str (), std::ios::out | std::ios::trunc | std::ios::binary);
+  NS_ABORT_MSG_UNLESS (m_os.is_open (), "Unable to open " << fileName);
+  if (m_format == CSV)
+    {
+      m_os << "time,flowId,txPackets,rxPackets,lostPackets,txBytes,rxBytes,throughput,delaySum,jitterSum"
+           << std::endl;
+    }
+  else
+    {
+      uint32_t header[2] = { BINARY_FORMAT_VERSION, sizeof (BinaryRecord) };
+      m_os.write ("NS3FSEXP", 8);
+      m_os.write (reinterpret_cast<const char *> (header), sizeof (header));
+      m_os.flush ();
+    }
+}
+
+void
+FlowStatsExporter::AddFlow (FlowId flowId)
+{
+  NS_LOG_FUNCTION (this << flowId);
+  m_flows.insert (flowId);
+}
+
+void
+FlowStatsExporter::SetFlowFilter (Callback<bool, FlowId> filter)
+{
+  NS_LOG_FUNCTION (this);
+  m_filter = filter;
+}
+
+void
+FlowStatsExporter::Start (const Time &time)
+{
+  NS_LOG_FUNCTION (this << time.GetSeconds ());
+  if (m_enabled)
+    {
+      NS_LOG_DEBUG ("FlowStatsExporter already enabled; returning");
+      return;
+    }
+  Simulator::Cancel (m_startEvent);
+  m_startEvent = Simulator::Schedule (time, &FlowStatsExporter::DoStart, this);
+}
+
+void
+FlowStatsExporter::Stop (const Time &time)
+{
+  NS_LOG_FUNCTION (this << time.GetSeconds ());
+  Simulator::Cancel (m_stopEvent);
+  m_stopEvent = Simulator::Schedule (time, &FlowStatsExporter::DoStop, this);
+}
+
+void
+FlowStatsExporter::DoStart (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_enabled || m_monitor == 0)
+    {
+      NS_LOG_DEBUG ("FlowStatsExporter already enabled or without monitor; returning");
+      return;
+    }
+  m_enabled = true;
+  // the first interval only accounts for the packets seen from now on
+  m_snapshots.clear ();
+  const FlowMonitor::FlowStatsContainer &stats = m_monitor->GetFlowStats ();
+  for (FlowMonitor::FlowStatsContainerCI it = stats.begin (); it != stats.end (); ++it)
+    {
+      Snapshot &snapshot = m_snapshots[it->first];
+      snapshot.txPackets = it->second.txPackets;
+      snapshot.rxPackets = it->second.rxPackets;
+      snapshot.lostPackets = it->second.lostPackets;
+      snapshot.txBytes = it->second.txBytes;
+      snapshot.rxBytes = it->second.rxBytes;
+      snapshot.delaySum = it->second.delaySum;
+      snapshot.jitterSum = it->second.jitterSum;
+    }
+  m_lastExport = Simulator::Now ();
+  m_exportEvent = Simulator::Schedule (m_interval, &FlowStatsExporter::PeriodicExport, this);
+}
+
+void
+FlowStatsExporter::DoStop (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_enabled)
+    {
+      return;
+    }
+  Simulator::Cancel (m_exportEvent);
+  Export ();
+  m_enabled = false;
+}
+
+void
+FlowStatsExporter::PeriodicExport (void)
+{
+  NS_LOG_FUNCTION (this);
+  Export ();
+  m_exportEvent = Simulator::Schedule (m_interval, &FlowStatsExporter::PeriodicExport, this);
+}
+
+bool
+FlowStatsExporter::IsExported (FlowId flowId) const
+{
+  if (m_flows.empty () && m_filter.IsNull ())
+    {
+      return true;
+    }
+  return m_flows.find (flowId) != m_flows.end ()
+         || (!m_filter.IsNull () && m_filter (flowId));
+}
+
+void
+FlowStatsExporter::Export (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_UNLESS (m_os.is_open (), "FlowStatsExporter: no output file");
+  NS_ABORT_MSG_IF (m_monitor == 0, "FlowStatsExporter: no FlowMonitor");
+
+  Time now = Simulator::Now ();
+  Time duration = now - m_lastExport;
+  // account for the packets lost during the interval
+  m_monitor->CheckForLostPackets ();
+
+  const FlowMonitor::FlowStatsContainer &stats = m_monitor->GetFlowStats ();
+  for (FlowMonitor::FlowStatsContainerCI it = stats.begin (); it != stats.end (); ++it)
+    {
+      const FlowMonitor::FlowStats &flow = it->second;
+      Snapshot &snapshot = m_snapshots[it->first];
+      if (flow.txPackets == snapshot.txPackets && flow.rxPackets == snapshot.rxPackets
+          && flow.lostPackets == snapshot.lostPackets)
+        {
+          // inactive during the interval
+          continue;
+        }
+      if (IsExported (it->first))
+        {
+          BinaryRecord record;
+          record.time = now.GetNanoSeconds ();
+          record.flowId = it->first;
+          record.txPackets = flow.txPackets - snapshot.txPackets;
+          record.rxPackets = flow.rxPackets - snapshot.rxPackets;
+          record.lostPackets = flow.lostPackets - snapshot.lostPackets;
+          record.txBytes = flow.txBytes - snapshot.txBytes;
+          record.rxBytes = flow.rxBytes - snapshot.rxBytes;
+          record.delaySum = (flow.delaySum - snapshot.delaySum).GetNanoSeconds ();
+          record.jitterSum = (flow.jitterSum - snapshot.jitterSum).GetNanoSeconds ();
+          Write (record, duration);
+        }
+      snapshot.txPackets = flow.txPackets;
+      snapshot.rxPackets = flow.rxPackets;
+      snapshot.lostPackets = flow.lostPackets;
+      snapshot.txBytes = flow.txBytes;
+      snapshot.rxBytes = flow.rxBytes;
+      snapshot.delaySum = flow.delaySum;
+      snapshot.jitterSum = flow.jitterSum;
+    }
+  m_os.flush ();
+  m_lastExport = now;
+}
+
+void
+FlowStatsExporter::Write (const BinaryRecord &record, Time duration)
+{
+  if (m_format == BINARY)
+    {
+      m_os.write (reinterpret_cast<const char *> (&record), sizeof (record));
+      return;
+    }
+  double throughput = duration.IsStrictlyPositive ()
+    ? record.rxBytes * 8.0 / duration.GetSeconds () : 0;
+  m_os << NanoSeconds (record.time).GetSeconds () << "," << record.flowId << ","
+       << record.txPackets << "," << record.rxPackets << ","
+       << record.lostPackets << "," << record.txBytes << ","
+       << record.rxBytes << "," << throughput << ","
+       << NanoSeconds (record.delaySum).GetSeconds () << ","
+       << NanoSeconds (record.jitterSum).GetSeconds () << "\n";
+}
+
+} // namespace ns3
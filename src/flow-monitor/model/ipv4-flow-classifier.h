@@ -26,6 +26,7 @@
 
 #include "ns3/ipv4-header.h"
 #include "ns3/flow-classifier.h"
+#include "ns3/flow-hash-map.h"
 
 namespace ns3 {
 
@@ -92,12 +93,27 @@ public:
 
 private:
 
+  /// Hash function of a FiveTuple
+  struct FiveTupleHash
+  {
+    /// \param tuple the FiveTuple
+    /// \return the hash of the FiveTuple
+    uint32_t operator() (const FiveTuple &tuple) const;
+  };
+
+  /// Per-flow data
+  struct Flow
+  {
+    FiveTuple tuple;            //!< the FiveTuple of the flow
+    FlowPacketId lastPacketId;  //!< the identifier of the last packet of the flow
+    /// (DSCP value, packet count) pairs, sorted by DSCP value
+    std::vector<std::pair<Ipv4Header::DscpType, uint32_t> > dscpCounts;
+  };
+
   /// Map to Flows Identifiers to FlowIds
-  std::map<FiveTuple, FlowId> m_flowMap;
-  /// Map to FlowIds to FlowPacketId
-  std::map<FlowId, FlowPacketId> m_flowPktIdMap;
-  /// Map FlowIds to (DSCP value, packet count) pairs
-  std::map<FlowId, std::map<Ipv4Header::DscpType, uint32_t> > m_flowDscpMap;
+  FlowHashMap<FiveTuple, FlowId, FiveTupleHash> m_flowMap;
+  /// The flows, indexed by FlowId - 1 (the FlowIds are assigned in sequence)
+  std::vector<Flow> m_flows;
 
 };
 
@@ -101,6 +101,16 @@ Ipv6FlowClassifier::Ipv6FlowClassifier ()
 {
 }
 
+uint32_t
+Ipv6FlowClassifier::FiveTupleHash::operator() (const FiveTuple &tuple) const
+{
+  uint64_t ports = (static_cast<uint64_t> (tuple.protocol) << 32)
+    | (static_cast<uint64_t> (tuple.sourcePort) << 16) | tuple.destinationPort;
+  uint64_t addresses = (static_cast<uint64_t> (Ipv6AddressHash () (tuple.sourceAddress)) << 32)
+    ^ Ipv6AddressHash () (tuple.destinationAddress);
+  return FlowHashMix (addresses ^ FlowHashMix (ports));
+}
+
 bool
 Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPayload,
                               uint32_t *out_flowId, uint32_t *out_packetId)
@@ -149,35 +159,44 @@ Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPa
   tuple.destinationPort = dstPort;
 
   // try to insert the tuple, but check if it already exists
-  std::pair<std::map<FiveTuple, FlowId>::iterator, bool> insert
-    = m_flowMap.insert (std::pair<FiveTuple, FlowId> (tuple, 0));
+  bool inserted;
+  FlowId &flowId = m_flowMap.Insert (tuple, &inserted);
 
   // if the insertion succeeded, we need to assign this tuple a new flow identifier
-  if (insert.second)
+  if (inserted)
     {
-      FlowId newFlowId = GetNewFlowId ();
-      insert.first->second = newFlowId;
-      m_flowPktIdMap[newFlowId] = 0;
-      m_flowDscpMap[newFlowId];
+      flowId = GetNewFlowId ();
+      NS_ASSERT (flowId == m_flows.size () + 1);
+      Flow flow;
+      flow.tuple = tuple;
+      flow.lastPacketId = 0;
+      m_flows.push_back (flow);
     }
   else
     {
-      m_flowPktIdMap[insert.first->second] ++;
+      m_flows[flowId - 1].lastPacketId++;
     }
+  Flow &flow = m_flows[flowId - 1];
 
-  // increment the counter of packets with the same DSCP value
+  // increment the counter of packets with the same DSCP value (a flow
+  // usually has a single DSCP value)
   Ipv6Header::DscpType dscp = ipHeader.GetDscp ();
-  std::pair<std::map<Ipv6Header::DscpType, uint32_t>::iterator, bool> dscpInserter
-    = m_flowDscpMap[insert.first->second].insert (std::pair<Ipv6Header::DscpType, uint32_t> (dscp, 1));
-
-  // if the insertion did not succeed, we need to increment the counter
-  if (!dscpInserter.second)
+  std::vector<std::pair<Ipv6Header::DscpType, uint32_t> >::iterator it = flow.dscpCounts.begin ();
+  while (it != flow.dscpCounts.end () && it->first < dscp)
+    {
+      it++;
+    }
+  if (it != flow.dscpCounts.end () && it->first == dscp)
+    {
+      it->second++;
+    }
+  else
     {
-      m_flowDscpMap[insert.first->second][dscp] ++;
+      flow.dscpCounts.insert (it, std::make_pair (dscp, 1));
     }
 
-  *out_flowId = insert.first->second;
-  *out_packetId = m_flowPktIdMap[*out_flowId];
+  *out_flowId = flowId;
+  *out_packetId = flow.lastPacketId;
 
   return true;
 }
@@ -186,13 +205,9 @@ Ipv6FlowClassifier::Classify (const Ipv6Header &ipHeader, Ptr<const Packet> ipPa
 Ipv6FlowClassifier::FiveTuple
 Ipv6FlowClassifier::FindFlow (FlowId flowId) const
 {
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  if (flowId > 0 && flowId <= m_flows.size ())
     {
-      if (iter->second == flowId)
-        {
-          return iter->first;
-        }
+      return m_flows[flowId - 1].tuple;
     }
   NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
   FiveTuple retval = { Ipv6Address::GetZero (), Ipv6Address::GetZero (), 0, 0, 0 };
@@ -209,15 +224,12 @@ Ipv6FlowClassifier::SortByCount::operator() (std::pair<Ipv6Header::DscpType, uin
 std::vector<std::pair<Ipv6Header::DscpType, uint32_t> >
 Ipv6FlowClassifier::GetDscpCounts (FlowId flowId) const
 {
-  std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t> >::const_iterator flow
-    = m_flowDscpMap.find (flowId);
-
-  if (flow == m_flowDscpMap.end ())
+  if (flowId == 0 || flowId > m_flows.size ())
     {
       NS_FATAL_ERROR ("Could not find the flow with ID " << flowId);
     }
 
-  std::vector<std::pair<Ipv6Header::DscpType, uint32_t> > v (flow->second.begin (), flow->second.end ());
+  std::vector<std::pair<Ipv6Header::DscpType, uint32_t> > v = m_flows[flowId - 1].dscpCounts;
   std::sort (v.begin (), v.end (), SortByCount ());
   return v;
 }
@@ -227,30 +239,34 @@ Ipv6FlowClassifier::SerializeToXmlStream (std::ostream &os, uint16_t indent) con
 {
   Indent (os, indent); os << "<Ipv6FlowClassifier>\n";
 
+  // list the flows in the order of their FiveTuple
+  std::vector<std::pair<FiveTuple, FlowId> > flows;
+  for (FlowId flowId = 1; flowId <= m_flows.size (); flowId++)
+    {
+      flows.push_back (std::make_pair (m_flows[flowId - 1].tuple, flowId));
+    }
+  std::sort (flows.begin (), flows.end ());
+
   indent += 2;
-  for (std::map<FiveTuple, FlowId>::const_iterator
-       iter = m_flowMap.begin (); iter != m_flowMap.end (); iter++)
+  for (std::vector<std::pair<FiveTuple, FlowId> >::const_iterator
+       iter = flows.begin (); iter != flows.end (); iter++)
     {
+      const FiveTuple &tuple = iter->first;
       Indent (os, indent);
       os << "<Flow flowId=\"" << iter->second << "\""
-         << " sourceAddress=\"" << iter->first.sourceAddress << "\""
-         << " destinationAddress=\"" << iter->first.destinationAddress << "\""
-         << " protocol=\"" << int(iter->first.protocol) << "\""
-         << " sourcePort=\"" << iter->first.sourcePort << "\""
-         << " destinationPort=\"" << iter->first.destinationPort << "\">\n";
+         << " sourceAddress=\"" << tuple.sourceAddress << "\""
+         << " destinationAddress=\"" << tuple.destinationAddress << "\""
+         << " protocol=\"" << int(tuple.protocol) << "\""
+         << " sourcePort=\"" << tuple.sourcePort << "\""
+         << " destinationPort=\"" << tuple.destinationPort << "\">\n";
 
       indent += 2;
-      std::map<FlowId, std::map<Ipv6Header::DscpType, uint32_t> >::const_iterator flow
-        = m_flowDscpMap.find (iter->second);
-
-      if (flow != m_flowDscpMap.end ())
+      const std::vector<std::pair<Ipv6Header::DscpType, uint32_t> > &dscpCounts = m_flows[iter->second - 1].dscpCounts;
+      for (std::vector<std::pair<Ipv6Header::DscpType, uint32_t> >::const_iterator i = dscpCounts.begin (); i != dscpCounts.end (); i++)
         {
-          for (std::map<Ipv6Header::DscpType, uint32_t>::const_iterator i = flow->second.begin (); i != flow->second.end (); i++)
-            {
-              Indent (os, indent);
-              os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
-                 << " packets=\"" << std::dec << i->second << "\" />\n";
-            }
+          Indent (os, indent);
+          os << "<Dscp value=\"0x" << std::hex << static_cast<uint32_t> (i->first) << "\""
+             << " packets=\"" << std::dec << i->second << "\" />\n";
         }
 
       indent -= 2;
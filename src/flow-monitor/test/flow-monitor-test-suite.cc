@@ -0,0 +1,381 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/flow-monitor.h"
+#include "ns3/flow-probe.h"
+#include "ns3/flow-hash-map.h"
+#include "ns3/flow-stats-exporter.h"
+#include "ns3/boolean.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/nstime.h"
+#include <fstream>
+#include <sstream>
+#include <algorithm>
+#include <map>
+
+using namespace ns3;
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Hash function colliding often, to exercise the probing
+ */
+struct CollidingHash
+{
+  /// \param key the key
+  /// \return the hash of the key
+  uint32_t operator() (uint32_t key) const
+  {
+    return key % 7;
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowHashMap Test, against a std::map
+ */
+class FlowHashMapTestCase : public TestCase
+{
+public:
+  FlowHashMapTestCase ();
+  virtual void DoRun (void);
+};
+
+FlowHashMapTestCase::FlowHashMapTestCase ()
+  : TestCase ("FlowHashMap")
+{
+}
+
+void
+FlowHashMapTestCase::DoRun (void)
+{
+  FlowHashMap<uint32_t, uint32_t, CollidingHash> map;
+  std::map<uint32_t, uint32_t> ref;
+  uint32_t seed = 1;
+  for (uint32_t i = 0; i < 20000; i++)
+    {
+      seed = seed * 1103515245 + 12345;
+      uint32_t key = (seed >> 16) % 300;
+      if ((seed >> 8) % 3 == 0)
+        {
+          bool erased = (ref.erase (key) == 1);
+          NS_TEST_ASSERT_MSG_EQ (map.Erase (key), erased, "wrong erase of key " << key);
+        }
+      else
+        {
+          bool inserted;
+          uint32_t &value = map.Insert (key, &inserted);
+          bool absent = (ref.find (key) == ref.end ());
+          NS_TEST_ASSERT_MSG_EQ (inserted, absent, "wrong insertion of key " << key);
+          value += i;
+          ref[key] += i;
+        }
+      NS_TEST_ASSERT_MSG_EQ (map.GetSize (), ref.size (), "wrong size");
+    }
+  for (uint32_t key = 0; key < 300; key++)
+    {
+      const uint32_t *value = map.Find (key);
+      std::map<uint32_t, uint32_t>::const_iterator it = ref.find (key);
+      bool found = (it != ref.end ());
+      NS_TEST_ASSERT_MSG_EQ ((value != 0), found, "wrong lookup of key " << key);
+      if (value != 0)
+        {
+          NS_TEST_EXPECT_MSG_EQ (*value, it->second, "wrong value of key " << key);
+        }
+    }
+  map.Clear ();
+  NS_TEST_EXPECT_MSG_EQ (map.GetSize (), 0, "map not cleared");
+  NS_TEST_EXPECT_MSG_EQ ((map.Find (1) == 0), true, "map not cleared");
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief Probe reporting the packets of the test
+ */
+class LostPacketsTestProbe : public FlowProbe
+{
+public:
+  /// \param monitor the FlowMonitor
+  LostPacketsTestProbe (Ptr<FlowMonitor> monitor)
+    : FlowProbe (monitor)
+  {
+  }
+};
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor lost packets Test
+ *
+ * Packets not seen for a time longer than the given delay are considered
+ * lost, including the packets whose last seen time has been updated since
+ * they were first transmitted.
+ */
+class FlowMonitorLostPacketsTestCase : public TestCase
+{
+public:
+  FlowMonitorLostPacketsTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /// Report the transmission of packets
+  /// \param first the first packet
+  /// \param last the last packet
+  void Transmit (FlowPacketId first, FlowPacketId last);
+  /// Report the forwarding of packets
+  /// \param first the first packet
+  /// \param last the last packet
+  void Forward (FlowPacketId first, FlowPacketId last);
+  /// Report the reception of packets
+  /// \param first the first packet
+  /// \param last the last packet
+  void Receive (FlowPacketId first, FlowPacketId last);
+  /// Check for lost packets
+  /// \param maxDelay the delay after which a packet is lost
+  /// \param lost the expected number of lost packets
+  void Check (Time maxDelay, uint32_t lost);
+
+  Ptr<FlowMonitor> m_monitor;  //!< the FlowMonitor
+  Ptr<FlowProbe> m_probe;      //!< the probe
+};
+
+FlowMonitorLostPacketsTestCase::FlowMonitorLostPacketsTestCase ()
+  : TestCase ("FlowMonitor lost packets")
+{
+}
+
+void
+FlowMonitorLostPacketsTestCase::Transmit (FlowPacketId first, FlowPacketId last)
+{
+  for (FlowPacketId p = first; p <= last; p++)
+    {
+      m_monitor->ReportFirstTx (m_probe, 1, p, 100);
+    }
+}
+
+void
+FlowMonitorLostPacketsTestCase::Forward (FlowPacketId first, FlowPacketId last)
+{
+  for (FlowPacketId p = first; p <= last; p++)
+    {
+      m_monitor->ReportForwarding (m_probe, 1, p, 100);
+    }
+}
+
+void
+FlowMonitorLostPacketsTestCase::Receive (FlowPacketId first, FlowPacketId last)
+{
+  for (FlowPacketId p = first; p <= last; p++)
+    {
+      m_monitor->ReportLastRx (m_probe, 1, p, 100);
+    }
+}
+
+void
+FlowMonitorLostPacketsTestCase::Check (Time maxDelay, uint32_t lost)
+{
+  m_monitor->CheckForLostPackets (maxDelay);
+  FlowMonitor::FlowStatsContainer stats = m_monitor->GetFlowStats ();
+  NS_TEST_EXPECT_MSG_EQ (stats[1].lostPackets, lost,
+                         "wrong number of lost packets at " << Simulator::Now ().GetSeconds ());
+}
+
+void
+FlowMonitorLostPacketsTestCase::DoRun (void)
+{
+  m_monitor = CreateObject<FlowMonitor> ();
+  m_monitor->SetAttribute ("EnableLogLinearHistograms", BooleanValue (true));
+  m_probe = CreateObject<LostPacketsTestProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+
+  Simulator::Schedule (Seconds (0), &FlowMonitorLostPacketsTestCase::Transmit, this, 0, 9);
+  Simulator::Schedule (Seconds (0.05), &FlowMonitorLostPacketsTestCase::Receive, this, 0, 4);
+  Simulator::Schedule (Seconds (0.25), &FlowMonitorLostPacketsTestCase::Forward, this, 5, 6);
+  // packets 7 to 9 have not been seen since 0 s
+  Simulator::Schedule (Seconds (0.3), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (0.2), 3);
+  // packets 5 and 6 have not been seen since 0.25 s
+  Simulator::Schedule (Seconds (0.4), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (0.2), 3);
+  Simulator::Schedule (Seconds (0.5), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (0.2), 5);
+  // a packet is lost once it has not been seen for exactly the given delay
+  Simulator::Schedule (Seconds (0.7), &FlowMonitorLostPacketsTestCase::Transmit, this, 10, 11);
+  Simulator::Schedule (Seconds (0.8), &FlowMonitorLostPacketsTestCase::Receive, this, 11, 11);
+  Simulator::Schedule (Seconds (0.9), &FlowMonitorLostPacketsTestCase::Check, this, Seconds (0.2), 6);
+  Simulator::Stop (Seconds (1.5));
+  Simulator::Run ();
+
+  FlowMonitor::FlowStatsContainer stats = m_monitor->GetFlowStats ();
+  NS_TEST_EXPECT_MSG_EQ (stats[1].txPackets, 12, "wrong number of transmitted packets");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].rxPackets, 6, "wrong number of received packets");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].lostPackets, 6, "wrong number of lost packets");
+
+  // five packets received after 50 ms and one after 100 ms
+  const LogLinearHistogram &delays = stats[1].delayLogHistogram;
+  uint64_t shortDelay = Seconds (0.05).GetNanoSeconds ();
+  uint64_t longDelay = (Seconds (0.8) - Seconds (0.7)).GetNanoSeconds ();
+  NS_TEST_EXPECT_MSG_EQ (delays.GetCount (), 6, "wrong number of delays");
+  NS_TEST_EXPECT_MSG_EQ (delays.GetMax (), longDelay, "wrong maximum delay");
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (delays.GetPercentile (50), shortDelay, "p50 delay too small");
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (delays.GetPercentile (50), shortDelay + shortDelay / 64, "p50 delay too large");
+  NS_TEST_EXPECT_MSG_EQ (stats[1].packetSizeLogHistogram.GetPercentile (100), 100, "wrong packet size");
+
+  Simulator::Destroy ();
+  m_probe = 0;
+  m_monitor->Dispose ();
+  m_monitor = 0;
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowStatsExporter Test
+ *
+ * The exporter writes the deltas of the statistics of the selected flows
+ * which have been active during each interval.
+ */
+class FlowStatsExporterTestCase : public TestCase
+{
+public:
+  FlowStatsExporterTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /// Report the transmission of packets
+  /// \param flowId the flow
+  /// \param first the first packet
+  /// \param last the last packet
+  void Transmit (FlowId flowId, FlowPacketId first, FlowPacketId last);
+  /// Report the reception of packets
+  /// \param flowId the flow
+  /// \param first the first packet
+  /// \param last the last packet
+  void Receive (FlowId flowId, FlowPacketId first, FlowPacketId last);
+
+  Ptr<FlowMonitor> m_monitor;  //!< the FlowMonitor
+  Ptr<FlowProbe> m_probe;      //!< the probe
+};
+
+FlowStatsExporterTestCase::FlowStatsExporterTestCase ()
+  : TestCase ("FlowStatsExporter")
+{
+}
+
+void
+FlowStatsExporterTestCase::Transmit (FlowId flowId, FlowPacketId first, FlowPacketId last)
+{
+  for (FlowPacketId p = first; p <= last; p++)
+    {
+      m_monitor->ReportFirstTx (m_probe, flowId, p, 100);
+    }
+}
+
+void
+FlowStatsExporterTestCase::Receive (FlowId flowId, FlowPacketId first, FlowPacketId last)
+{
+  for (FlowPacketId p = first; p <= last; p++)
+    {
+      m_monitor->ReportLastRx (m_probe, flowId, p, 100);
+    }
+}
+
+void
+FlowStatsExporterTestCase::DoRun (void)
+{
+  std::string fileName = CreateTempDirFilename ("flow-stats-exporter.csv");
+
+  m_monitor = CreateObject<FlowMonitor> ();
+  m_monitor->SetAttribute ("MaxPerHopDelay", TimeValue (Seconds (0.2)));
+  m_probe = CreateObject<LostPacketsTestProbe> (m_monitor);
+  m_monitor->StartRightNow ();
+
+  Ptr<FlowStatsExporter> exporter = CreateObject<FlowStatsExporter> ();
+  exporter->SetAttribute ("Interval", TimeValue (Seconds (0.1)));
+  exporter->SetMonitor (m_monitor);
+  exporter->Open (fileName);
+  exporter->AddFlow (1);
+  exporter->Stop (Seconds (0.35));
+
+  Simulator::Schedule (Seconds (0.01), &FlowStatsExporterTestCase::Transmit, this, 1, 0, 4);
+  Simulator::Schedule (Seconds (0.01), &FlowStatsExporterTestCase::Transmit, this, 2, 0, 1);
+  Simulator::Schedule (Seconds (0.05), &FlowStatsExporterTestCase::Receive, this, 1, 0, 2);
+  Simulator::Schedule (Seconds (0.05), &FlowStatsExporterTestCase::Receive, this, 2, 0, 1);
+  Simulator::Schedule (Seconds (0.15), &FlowStatsExporterTestCase::Receive, this, 1, 3, 3);
+  // packet 4 of flow 1 is declared lost by the export at 0.3 s
+  Simulator::Stop (Seconds (1));
+  Simulator::Run ();
+  Simulator::Destroy ();
+  exporter->Dispose ();
+
+  // time, flowId, txPackets, rxPackets, lostPackets, txBytes, rxBytes,
+  // throughput, delaySum, jitterSum
+  const double expected[3][10] = {
+    { 0.1, 1, 5, 3, 0, 500, 300, 24000, 0.12, 0 },
+    { 0.2, 1, 0, 1, 0, 0, 100, 8000, 0.14, 0.1 },
+    { 0.3, 1, 0, 0, 1, 0, 0, 0, 0, 0 }
+  };
+  std::ifstream is (fileName.c_str ());
+  std::string line;
+  std::getline (is, line);
+  NS_TEST_EXPECT_MSG_EQ (line.substr (0, 12), "time,flowId,", "wrong header");
+  uint32_t n = 0;
+  while (std::getline (is, line))
+    {
+      NS_TEST_ASSERT_MSG_LT (n, 3, "unexpected record " << line);
+      std::replace (line.begin (), line.end (), ',', ' ');
+      std::istringstream iss (line);
+      for (uint32_t i = 0; i < 10; i++)
+        {
+          double value;
+          iss >> value;
+          NS_TEST_EXPECT_MSG_EQ_TOL (value, expected[n][i], 1e-9, "wrong field " << i << " of record " << n);
+        }
+      n++;
+    }
+  NS_TEST_EXPECT_MSG_EQ (n, 3, "wrong number of records");
+
+  m_probe = 0;
+  m_monitor->Dispose ();
+  m_monitor = 0;
+}
+
+/**
+ * \ingroup flow-monitor-test
+ * \ingroup tests
+ *
+ * \brief FlowMonitor TestSuite
+ */
+class FlowMonitorTestSuite : public TestSuite
+{
+public:
+  FlowMonitorTestSuite ();
+};
+
+FlowMonitorTestSuite::FlowMonitorTestSuite ()
+  : TestSuite ("flow-monitor", UNIT)
+{
+  AddTestCase (new FlowHashMapTestCase, TestCase::QUICK);
+  AddTestCase (new FlowMonitorLostPacketsTestCase, TestCase::QUICK);
+  AddTestCase (new FlowStatsExporterTestCase, TestCase::QUICK);
+}
+
+static FlowMonitorTestSuite g_flowMonitorTestSuite; //!< Static variable for test initialization
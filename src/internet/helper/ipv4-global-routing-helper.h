@@ -84,6 +84,23 @@ public:
    *
    */
   static void RecomputeRoutingTables (void);
+  /**
+   * \brief Update the routes after changes of the topology (e.g., links or
+   * interfaces brought up or down, or metrics changed), yielding the same
+   * routes as RecomputeRoutingTables().
+   *
+   * If the GlobalRoutingKeepSpfTrees global value is set, only the routers
+   * whose shortest path tree may have changed run the SPF computation again;
+   * the routes of the other routers are rebuilt from their previous shortest
+   * path tree, using the updated link state advertisements.  To do so, the
+   * shortest path trees of the routers are kept in memory (one per router)
+   * from the first call to this method, which recomputes all the routes.
+   * Otherwise, this method is the same as RecomputeRoutingTables().
+   *
+   * Users must first call PopulateRoutingTables() and then may subsequently
+   * call UpdateRoutingTables() at any later time in the simulation.
+   */
+  static void UpdateRoutingTables (void);
 private:
   /**
    * \brief Assignment operator declared private and not implemented to disallow
@@ -22,7 +22,8 @@
 #define CANDIDATE_QUEUE_H
 
 #include <stdint.h>
-#include <list>
+#include <unordered_map>
+#include <vector>
 #include "ns3/ipv4-address.h"
 
 namespace ns3 {
@@ -45,8 +46,15 @@ class SPFVertex;
  *
  * Although a STL priority_queue almost does what we want, the requirement
  * for a Find () operation, the dynamic nature of the data and the derived
- * requirement for a Reorder () operation led us to implement this simple 
- * enhanced priority queue.
+ * requirement for an Update () operation led us to implement this indexed
+ * binary heap: the vertices are stored in a heap, each vertex records its
+ * position in the heap and a hash table gives the vertex of each ID, so
+ * that pushing, popping and updating a vertex take a logarithmic time in
+ * the number of candidates, and finding a vertex a constant time.
+ *
+ * The vertices at the same distance are popped networks first, then in the
+ * order in which they were pushed (or updated for the last time), as if
+ * they were kept in a list sorted by distance.
  */
 class CandidateQueue
 {
@@ -148,12 +156,25 @@ public:
  * increasing distance.
  *
  * This method is provided in case the values of m_distanceFromRoot change
- * during the routing calculations.
+ * during the routing calculations.  When the distance of a single vertex
+ * changes, Update () does the same in a logarithmic time.
  *
  * @see SPFVertex
  */
   void Reorder (void);
 
+/**
+ * @brief Moves a Shortest Path First Vertex pointer of the queue according
+ * to its new value of the field m_distanceFromRoot.
+ *
+ * The vertex is ordered as if it were popped and pushed again, i.e., after
+ * the other vertices at the same distance.
+ *
+ * @see SPFVertex
+ * @param v The Shortest Path First Vertex, which must be in the queue.
+ */
+  void Update (SPFVertex *v);
+
 private:
 /**
  * Candidate Queue copy construction is disallowed (not implemented) to 
@@ -184,8 +205,43 @@ private:
  */
   static bool CompareSPFVertex (const SPFVertex* v1, const SPFVertex* v2);
 
-  typedef std::list<SPFVertex*> CandidateList_t; //!< container of SPFVertex pointers
-  CandidateList_t m_candidates;  //!< SPFVertex candidates
+  /// A candidate of the heap
+  struct Candidate
+  {
+    SPFVertex *vertex;  //!< the vertex
+    uint64_t sequence;  //!< order of the last push or update of the vertex
+  };
+
+/**
+ * \brief return true if c1 should be popped before c2
+ *
+ * \param c1 first operand
+ * \param c2 second operand
+ * \return True if c1 should be popped before c2; false otherwise
+ */
+  static bool IsBefore (const Candidate &c1, const Candidate &c2);
+/**
+ * \brief Move a candidate towards the top of the heap until it is in place
+ * \param i the position of the candidate
+ */
+  void SiftUp (uint32_t i);
+/**
+ * \brief Move a candidate towards the bottom of the heap until it is in place
+ * \param i the position of the candidate
+ */
+  void SiftDown (uint32_t i);
+/**
+ * \brief Put a candidate at a position of the heap and index it
+ * \param i the position
+ * \param c the candidate
+ */
+  void Place (uint32_t i, const Candidate &c);
+
+  typedef std::vector<Candidate> CandidateHeap_t; //!< heap of candidates
+  typedef std::unordered_map<Ipv4Address, SPFVertex *, Ipv4AddressHash> CandidateIndex_t; //!< candidates by vertex ID
+  CandidateHeap_t m_candidates;  //!< SPFVertex candidates
+  CandidateIndex_t m_vertices;   //!< candidates by vertex ID
+  uint64_t m_sequence;           //!< sequence number of the next push or update
 
   /**
    * \brief Stream insertion operator.
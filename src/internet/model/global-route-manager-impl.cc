@@ -25,11 +25,17 @@
 #include <utility>
 #include <vector>
 #include <queue>
+#include <map>
+#include <set>
 #include <algorithm>
+#include <functional>
+#include <iterator>
 #include <iostream>
 #include "ns3/assert.h"
 #include "ns3/fatal-error.h"
 #include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
 #include "ns3/node-list.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
@@ -44,6 +50,14 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("GlobalRouteManagerImpl");
 
+/// Whether GlobalRouteManagerImpl::UpdateRoutes () keeps the shortest path trees
+static GlobalValue g_keepSpfTrees = GlobalValue ("GlobalRoutingKeepSpfTrees",
+                                                 "Whether the shortest path tree of each router is kept "
+                                                 "in memory to only recompute the affected routers when "
+                                                 "the global routes are updated",
+                                                 BooleanValue (false),
+                                                 MakeBooleanChecker ());
+
 /**
  * \brief Stream insertion operator.
  *
@@ -90,6 +104,7 @@ SPFVertex::SPFVertex () :
   m_vertexId ("255.255.255.255"), 
   m_lsa (0),
   m_distanceFromRoot (SPF_INFINITY), 
+  m_candidatePosition (0),
   m_rootOif (SPF_INFINITY),
   m_nextHop ("0.0.0.0"),
   m_parents (),
@@ -103,6 +118,7 @@ SPFVertex::SPFVertex (GlobalRoutingLSA* lsa) :
   m_vertexId (lsa->GetLinkStateId ()),
   m_lsa (lsa),
   m_distanceFromRoot (SPF_INFINITY), 
+  m_candidatePosition (0),
   m_rootOif (SPF_INFINITY),
   m_nextHop ("0.0.0.0"),
   m_parents (),
@@ -230,6 +246,20 @@ SPFVertex::GetDistanceFromRoot (void) const
   return m_distanceFromRoot;
 }
 
+uint32_t
+SPFVertex::GetCandidatePosition (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_candidatePosition;
+}
+
+void
+SPFVertex::SetCandidatePosition (uint32_t position)
+{
+  NS_LOG_FUNCTION (this << position);
+  m_candidatePosition = position;
+}
+
 void
 SPFVertex::SetParent (SPFVertex* parent)
 {
@@ -446,6 +476,7 @@ GlobalRouteManagerLSDB::~GlobalRouteManagerLSDB ()
     }
   NS_LOG_LOGIC ("clear map");
   m_database.clear ();
+  m_linkDataIndex.clear ();
 }
 
 void
@@ -470,7 +501,32 @@ GlobalRouteManagerLSDB::Insert (Ipv4Address addr, GlobalRoutingLSA* lsa)
     } 
   else
     {
-      m_database.insert (LSDBPair_t (addr, lsa));
+      if (!m_database.insert (LSDBPair_t (addr, lsa)).second)
+        {
+          return;
+        }
+//
+// Index the transit network link records by their link data, keeping the
+// first LSA of the database (i.e., the one with the lowest address) if
+// several ones hold the same link data.
+//
+      for (uint32_t j = 0; j < lsa->GetNLinkRecords (); j++)
+        {
+          GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+          if (lr->GetLinkType () != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+              continue;
+            }
+          std::map<Ipv4Address, Ipv4Address>::iterator it = m_linkDataIndex.find (lr->GetLinkData ());
+          if (it == m_linkDataIndex.end ())
+            {
+              m_linkDataIndex.insert (std::make_pair (lr->GetLinkData (), addr));
+            }
+          else if (addr < it->second)
+            {
+              it->second = addr;
+            }
+        }
     }
 }
 
@@ -495,13 +551,10 @@ GlobalRouteManagerLSDB::GetLSA (Ipv4Address addr) const
 //
 // Look up an LSA by its address.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  LSDBMap_t::const_iterator i = m_database.find (addr);
+  if (i != m_database.end ())
     {
-      if (i->first == addr)
-        {
-          return i->second;
-        }
+      return i->second;
     }
   return 0;
 }
@@ -511,26 +564,26 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 {
   NS_LOG_FUNCTION (this << addr);
 //
-// Look up an LSA by its address.
+// Look up an LSA by the link data of its transit network link records.
 //
-  LSDBMap_t::const_iterator i;
-  for (i= m_database.begin (); i!= m_database.end (); i++)
+  std::map<Ipv4Address, Ipv4Address>::const_iterator i = m_linkDataIndex.find (addr);
+  if (i != m_linkDataIndex.end ())
     {
-      GlobalRoutingLSA* temp = i->second;
-// Iterate among temp's Link Records
-      for (uint32_t j = 0; j < temp->GetNLinkRecords (); j++)
-        {
-          GlobalRoutingLinkRecord *lr = temp->GetLinkRecord (j);
-          if ( lr->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork &&
-               lr->GetLinkData () == addr)
-            {
-              return temp;
-            }
-        }
+      return GetLSA (i->second);
     }
   return 0;
 }
 
+void
+GlobalRouteManagerLSDB::GetLinkStateIds (std::vector<Ipv4Address> &ids) const
+{
+  NS_LOG_FUNCTION (this);
+  for (LSDBMap_t::const_iterator i = m_database.begin (); i != m_database.end (); i++)
+    {
+      ids.push_back (i->first);
+    }
+}
+
 // ---------------------------------------------------------------------------
 //
 // GlobalRouteManagerImpl Implementation
@@ -539,7 +592,8 @@ GlobalRouteManagerLSDB::GetLSAByLinkData (Ipv4Address addr) const
 
 GlobalRouteManagerImpl::GlobalRouteManagerImpl () 
   :
-    m_spfroot (0)
+    m_spfroot (0),
+    m_keepSpfTrees (false)
 {
   NS_LOG_FUNCTION (this);
   m_lsdb = new GlobalRouteManagerLSDB ();
@@ -592,6 +646,7 @@ GlobalRouteManagerImpl::DeleteGlobalRoutes ()
         }
       NS_LOG_LOGIC ("Deleted " << j << " global routes from node "<< node->GetId ());
     }
+  m_spfTrees.clear ();
   if (m_lsdb)
     {
       NS_LOG_LOGIC ("Deleting LSDB, creating new one");
@@ -617,6 +672,7 @@ GlobalRouteManagerImpl::BuildGlobalRoutingDatabase ()
 // Walk the list of nodes looking for the GlobalRouter Interface.  Nodes with
 // global router interfaces are, not too surprisingly, our routers.
 //
+  m_routerNodes.clear ();
   NodeList::Iterator listEnd = NodeList::End ();
   for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
     {
@@ -638,6 +694,7 @@ GlobalRouteManagerImpl::BuildGlobalRoutingDatabase ()
 // DiscoverLSAs () will get zero as the number since no routes have been 
 // found.
 //
+      m_routerNodes[rtr->GetRouterId ()] = node->GetId ();
       Ptr<Ipv4GlobalRouting> grouting = rtr->GetRoutingProtocol ();
       uint32_t numLSAs = rtr->DiscoverLSAs ();
       NS_LOG_LOGIC ("Found " << numLSAs << " LSAs");
@@ -730,6 +787,107 @@ GlobalRouteManagerImpl::InitializeRoutes ()
   NS_LOG_INFO ("Finished SPF calculation");
 }
 
+//
+// Updating the routes yields the same routes as deleting them, rebuilding the
+// database and initializing them again, as done by RecomputeRoutingTables ().
+// Unless the GlobalRoutingKeepSpfTrees global value is set, this is exactly
+// what is done, since keeping a tree per router costs O(N^2) memory.  Else,
+// the routes of each router are still deleted and added again (in the same
+// order), but the SPF calculation is only run again for the routers whose
+// shortest path tree may have changed.  For the other routers, the vertices,
+// the root exit directions and the order of the second stage of their
+// previous tree are used to add the routes, along with the Link State
+// Advertisements of the new database.
+//
+void
+GlobalRouteManagerImpl::UpdateRoutes ()
+{
+  NS_LOG_FUNCTION (this);
+  BooleanValue keepSpfTrees;
+  g_keepSpfTrees.GetValue (keepSpfTrees);
+  if (!keepSpfTrees.Get ())
+    {
+      NS_LOG_INFO ("SPF trees not kept, recomputing all the routes");
+      m_keepSpfTrees = false;
+      DeleteGlobalRoutes ();
+      BuildGlobalRoutingDatabase ();
+      InitializeRoutes ();
+      return;
+    }
+  if (!m_keepSpfTrees)
+    {
+      NS_LOG_INFO ("First update, computing and keeping all the SPF trees");
+      m_keepSpfTrees = true;
+      DeleteGlobalRoutes ();
+      BuildGlobalRoutingDatabase ();
+      InitializeRoutes ();
+      return;
+    }
+
+  GlobalRouteManagerLSDB* oldLsdb = m_lsdb;
+  m_lsdb = new GlobalRouteManagerLSDB ();
+  BuildGlobalRoutingDatabase ();
+  std::set<Ipv4Address> affected;
+  bool all = FindAffectedRouters (oldLsdb, affected);
+  delete oldLsdb;
+  if (all)
+    {
+      NS_LOG_INFO ("SPF calculation needed for all the routers");
+    }
+  else
+    {
+      NS_LOG_INFO ("SPF calculation needed for " << affected.size () << " routers");
+    }
+
+  uint32_t systemId = MpiInterface::GetSystemId ();
+  NodeList::Iterator listEnd = NodeList::End ();
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<Node> node = *i;
+      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
+      if (rtr == 0)
+        {
+          continue;
+        }
+      Ptr<Ipv4GlobalRouting> gr = rtr->GetRoutingProtocol ();
+      uint32_t nRoutes = gr->GetNRoutes ();
+      NS_LOG_LOGIC ("Deleting " << nRoutes << " routes from node " << node->GetId ());
+      for (uint32_t j = 0; j < nRoutes; j++)
+        {
+          gr->RemoveRoute (0);
+        }
+    }
+  for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
+    {
+      Ptr<Node> node = *i;
+      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
+      // Ignore nodes that are not assigned to our systemId (distributed sim)
+      if (rtr == 0 || node->GetSystemId () != systemId)
+        {
+          continue;
+        }
+      Ipv4Address routerId = rtr->GetRouterId ();
+      if (rtr->GetNumLSAs () == 0)
+        {
+          m_spfTrees.erase (routerId);
+          continue;
+        }
+      std::map<Ipv4Address, SPFTree>::const_iterator tree = m_spfTrees.find (routerId);
+      if (all || tree == m_spfTrees.end () || affected.find (routerId) != affected.end ())
+        {
+          SPFCalculate (routerId);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("Reusing the SPF tree of node " << node->GetId ());
+          SPFSetRootNode (routerId);
+          SPFInstallRoutes (tree->second);
+          m_spfRootNode = 0;
+          m_spfRootRouting = 0;
+        }
+    }
+}
+
 //
 // This method is derived from quagga ospf_spf_next ().  See RFC2328 Section 
 // 16.1 (2) for further details.
@@ -958,9 +1116,9 @@ GlobalRouteManagerImpl::SPFNext (SPFVertex* v, CandidateQueue& candidate)
                 {
 //
 // If we've changed the cost to get to the vertex represented by <w>, we 
-// must reorder the priority queue keyed to that cost.
+// must move it in the priority queue keyed to that cost.
 //
-                  candidate.Reorder ();
+                  candidate.Update (cw);
                 }
             } // new lower cost path found
         } // end W is already on the candidate list
@@ -1122,9 +1280,11 @@ GlobalRouteManagerImpl::SPFNexthopCalculation (
                             " via outgoing interface " << outIf);
             }
         }
-      else 
+      else
         {
-          w->SetRootExitDirection (v->GetRootExitDirection ());
+// The network may be reached through several equal cost paths, the
+// router behind it inherits all of them.
+          w->InheritAllRootExitDirections (v);
         }
     }
   else 
@@ -1337,6 +1497,373 @@ GlobalRouteManagerImpl::CheckForStubNode (Ipv4Address root)
   return false;
 }
 
+//
+// Helpers of FindAffectedRouters ().  The SPF graph of a database has an edge
+// for each transition examined by SPFNext (): from a router to the router or
+// the network of each of its point-to-point or transit network link records
+// (weighted by the metric of the record), and from a network to each of its
+// attached routers (with a zero weight).  The vertices are indexed by the
+// rank of their link state ID in the union of the databases.
+//
+
+/// Edge of the SPF graph: index of the target vertex / weight
+typedef std::pair<uint32_t, uint32_t> SPFEdge_t;
+
+static const uint64_t SPF_GRAPH_INFINITY = ~static_cast<uint64_t> (0); //!< distance to unreachable vertices
+
+//
+// Check whether two LSAs hold the same information for the SPF calculation
+// and the routes (only the SPF status may differ).
+//
+static bool
+IsSameLSA (GlobalRoutingLSA *a, GlobalRoutingLSA *b)
+{
+  if (a->GetLSType () != b->GetLSType ()
+      || a->GetLinkStateId () != b->GetLinkStateId ()
+      || a->GetAdvertisingRouter () != b->GetAdvertisingRouter ()
+      || a->GetNetworkLSANetworkMask () != b->GetNetworkLSANetworkMask ()
+      || a->GetNLinkRecords () != b->GetNLinkRecords ()
+      || a->GetNAttachedRouters () != b->GetNAttachedRouters ())
+    {
+      return false;
+    }
+  for (uint32_t i = 0; i < a->GetNLinkRecords (); i++)
+    {
+      GlobalRoutingLinkRecord *la = a->GetLinkRecord (i);
+      GlobalRoutingLinkRecord *lb = b->GetLinkRecord (i);
+      if (la->GetLinkType () != lb->GetLinkType ()
+          || la->GetLinkId () != lb->GetLinkId ()
+          || la->GetLinkData () != lb->GetLinkData ()
+          || la->GetMetric () != lb->GetMetric ())
+        {
+          return false;
+        }
+    }
+  for (uint32_t i = 0; i < a->GetNAttachedRouters (); i++)
+    {
+      if (a->GetAttachedRouter (i) != b->GetAttachedRouter (i))
+        {
+          return false;
+        }
+    }
+  return true;
+}
+
+//
+// Add the routers whose root exit directions depend on an LSA: the router
+// itself, its point-to-point neighbors and the routers attached to its
+// transit networks, or the routers attached to a network.
+//
+static void
+AddNeighborRouters (GlobalRouteManagerLSDB *lsdb, GlobalRoutingLSA *lsa,
+                    std::set<Ipv4Address>& routers)
+{
+  std::vector<GlobalRoutingLSA*> networks;
+  if (lsa->GetLSType () == GlobalRoutingLSA::RouterLSA)
+    {
+      routers.insert (lsa->GetLinkStateId ());
+      for (uint32_t i = 0; i < lsa->GetNLinkRecords (); i++)
+        {
+          GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (i);
+          if (l->GetLinkType () == GlobalRoutingLinkRecord::PointToPoint)
+            {
+              routers.insert (l->GetLinkId ());
+            }
+          else if (l->GetLinkType () == GlobalRoutingLinkRecord::TransitNetwork)
+            {
+              GlobalRoutingLSA *network = lsdb->GetLSA (l->GetLinkId ());
+              if (network)
+                {
+                  networks.push_back (network);
+                }
+            }
+        }
+    }
+  else if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+    {
+      networks.push_back (lsa);
+    }
+  for (uint32_t i = 0; i < networks.size (); i++)
+    {
+      for (uint32_t j = 0; j < networks[i]->GetNAttachedRouters (); j++)
+        {
+          GlobalRoutingLSA *router = lsdb->GetLSAByLinkData (networks[i]->GetAttachedRouter (j));
+          if (router)
+            {
+              routers.insert (router->GetLinkStateId ());
+            }
+        }
+    }
+}
+
+//
+// Build the edges of the SPF graph leaving the vertex of an LSA, in the
+// order in which SPFNext () examines them.
+//
+static void
+GetSPFEdges (GlobalRouteManagerLSDB *lsdb, GlobalRoutingLSA *lsa,
+             const std::map<Ipv4Address, uint32_t>& indices, std::vector<SPFEdge_t>& edges)
+{
+  if (lsa->GetLSType () == GlobalRoutingLSA::RouterLSA)
+    {
+      for (uint32_t i = 0; i < lsa->GetNLinkRecords (); i++)
+        {
+          GlobalRoutingLinkRecord *l = lsa->GetLinkRecord (i);
+          if (l->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint
+              && l->GetLinkType () != GlobalRoutingLinkRecord::TransitNetwork)
+            {
+              continue;
+            }
+          std::map<Ipv4Address, uint32_t>::const_iterator it = indices.find (l->GetLinkId ());
+          if (it != indices.end () && lsdb->GetLSA (l->GetLinkId ()))
+            {
+              edges.push_back (SPFEdge_t (it->second, l->GetMetric ()));
+            }
+        }
+    }
+  else if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+    {
+      for (uint32_t i = 0; i < lsa->GetNAttachedRouters (); i++)
+        {
+          GlobalRoutingLSA *router = lsdb->GetLSAByLinkData (lsa->GetAttachedRouter (i));
+          if (router)
+            {
+              edges.push_back (SPFEdge_t (indices.find (router->GetLinkStateId ())->second, 0));
+            }
+        }
+    }
+}
+
+//
+// Compute the distances from every vertex to a given vertex, with the
+// Dijkstra algorithm on the reversed edges.
+//
+static void
+GetDistancesTo (uint32_t target, const std::vector<std::vector<SPFEdge_t> >& inEdges,
+                std::vector<uint64_t>& distances)
+{
+  distances.assign (inEdges.size (), SPF_GRAPH_INFINITY);
+  typedef std::pair<uint64_t, uint32_t> Entry_t;
+  std::priority_queue<Entry_t, std::vector<Entry_t>, std::greater<Entry_t> > queue;
+  distances[target] = 0;
+  queue.push (Entry_t (0, target));
+  while (!queue.empty ())
+    {
+      Entry_t entry = queue.top ();
+      queue.pop ();
+      if (entry.first > distances[entry.second])
+        {
+          continue;
+        }
+      const std::vector<SPFEdge_t>& edges = inEdges[entry.second];
+      for (uint32_t i = 0; i < edges.size (); i++)
+        {
+          uint64_t distance = entry.first + edges[i].second;
+          if (distance < distances[edges[i].first])
+            {
+              distances[edges[i].first] = distance;
+              queue.push (Entry_t (distance, edges[i].first));
+            }
+        }
+    }
+}
+
+//
+// The edges of each vertex are compared between the previous and the current
+// database: an SPF tree is unchanged unless an edge removed from (or added
+// to) the graph is on a shortest path from its root in the previous (or the
+// current) graph, i.e., d(root, u) + w == d(root, v) for an edge (u, v) of
+// weight w.  Otherwise, the distances and the candidate vertices popped at
+// each step are the same, in the same order (the order in which the edges of
+// a vertex are examined only matters for the edges on the shortest paths),
+// hence the parents, the root exit directions and the order of the second
+// stage are the same.  The distances to the endpoints of the changed edges
+// are computed on the reversed graph.
+//
+bool
+GlobalRouteManagerImpl::FindAffectedRouters (GlobalRouteManagerLSDB* oldLsdb,
+                                             std::set<Ipv4Address>& affected)
+{
+  NS_LOG_FUNCTION (this << oldLsdb);
+  std::vector<Ipv4Address> ids;
+  oldLsdb->GetLinkStateIds (ids);
+  m_lsdb->GetLinkStateIds (ids);
+  std::sort (ids.begin (), ids.end ());
+  ids.erase (std::unique (ids.begin (), ids.end ()), ids.end ());
+  std::map<Ipv4Address, uint32_t> indices;
+  for (uint32_t i = 0; i < ids.size (); i++)
+    {
+      indices.insert (indices.end (), std::make_pair (ids[i], i));
+    }
+
+  GlobalRouteManagerLSDB* lsdbs[2] = { oldLsdb, m_lsdb };
+  std::vector<std::vector<SPFEdge_t> > inEdges[2];
+  // changed edges (source, target, weight) of each graph
+  std::vector<std::pair<uint32_t, SPFEdge_t> > changed[2];
+  std::vector<uint32_t> routers;
+  inEdges[0].resize (ids.size ());
+  inEdges[1].resize (ids.size ());
+  for (uint32_t u = 0; u < ids.size (); u++)
+    {
+      GlobalRoutingLSA* lsas[2] = { oldLsdb->GetLSA (ids[u]), m_lsdb->GetLSA (ids[u]) };
+      std::vector<SPFEdge_t> edges[2];
+      for (uint32_t g = 0; g < 2; g++)
+        {
+          if (lsas[g] == 0)
+            {
+              continue;
+            }
+          GetSPFEdges (lsdbs[g], lsas[g], indices, edges[g]);
+          for (uint32_t i = 0; i < edges[g].size (); i++)
+            {
+              inEdges[g][edges[g][i].first].push_back (SPFEdge_t (u, edges[g][i].second));
+            }
+        }
+      if (lsas[1] && lsas[1]->GetLSType () == GlobalRoutingLSA::RouterLSA)
+        {
+          routers.push_back (u);
+        }
+//
+// The root exit directions of the routers next to a changed LSA may change,
+// even if the tree does not.
+//
+      if (lsas[0] == 0 || lsas[1] == 0 || !IsSameLSA (lsas[0], lsas[1]))
+        {
+          for (uint32_t g = 0; g < 2; g++)
+            {
+              if (lsas[g])
+                {
+                  AddNeighborRouters (lsdbs[g], lsas[g], affected);
+                }
+            }
+        }
+      if (edges[0] == edges[1])
+        {
+          continue;
+        }
+//
+// Find the edges removed and added, as multisets.  If the remaining edges
+// are not in the same order, all the edges are considered changed.
+//
+      std::vector<SPFEdge_t> sorted[2] = { edges[0], edges[1] };
+      std::sort (sorted[0].begin (), sorted[0].end ());
+      std::sort (sorted[1].begin (), sorted[1].end ());
+      std::vector<SPFEdge_t> diff[2];
+      std::set_difference (sorted[0].begin (), sorted[0].end (), sorted[1].begin (), sorted[1].end (),
+                           std::back_inserter (diff[0]));
+      std::set_difference (sorted[1].begin (), sorted[1].end (), sorted[0].begin (), sorted[0].end (),
+                           std::back_inserter (diff[1]));
+      std::vector<SPFEdge_t> common[2];
+      for (uint32_t g = 0; g < 2; g++)
+        {
+          std::vector<SPFEdge_t> removed = diff[g];
+          for (uint32_t i = 0; i < edges[g].size (); i++)
+            {
+              std::vector<SPFEdge_t>::iterator it = std::find (removed.begin (), removed.end (), edges[g][i]);
+              if (it != removed.end ())
+                {
+                  removed.erase (it);
+                }
+              else
+                {
+                  common[g].push_back (edges[g][i]);
+                }
+            }
+        }
+      if (common[0] != common[1])
+        {
+          diff[0] = edges[0];
+          diff[1] = edges[1];
+        }
+      for (uint32_t g = 0; g < 2; g++)
+        {
+          for (uint32_t i = 0; i < diff[g].size (); i++)
+            {
+              changed[g].push_back (std::make_pair (u, diff[g][i]));
+            }
+        }
+    }
+
+//
+// Running the reversed Dijkstra algorithm from the endpoints of the changed
+// edges is only worth it if it takes fewer runs than there are routers.
+//
+  uint32_t runs = 0;
+  for (uint32_t g = 0; g < 2; g++)
+    {
+      std::sort (changed[g].begin (), changed[g].end ());
+      for (uint32_t i = 0; i < changed[g].size (); i++)
+        {
+          if (i == 0 || changed[g][i].first != changed[g][i - 1].first)
+            {
+              runs++;
+            }
+        }
+      runs += changed[g].size ();
+    }
+  NS_LOG_LOGIC ((changed[0].size () + changed[1].size ()) << " SPF graph edges changed");
+  if (2 * runs >= routers.size ())
+    {
+      return true;
+    }
+  std::vector<uint64_t> du;
+  std::vector<uint64_t> dv;
+  for (uint32_t g = 0; g < 2; g++)
+    {
+      for (uint32_t i = 0; i < changed[g].size (); i++)
+        {
+          uint32_t u = changed[g][i].first;
+          uint32_t v = changed[g][i].second.first;
+          bool newSource = (i == 0 || u != changed[g][i - 1].first);
+          if (newSource)
+            {
+              GetDistancesTo (u, inEdges[g], du);
+            }
+          if (newSource || v != changed[g][i - 1].second.first)
+            {
+              GetDistancesTo (v, inEdges[g], dv);
+            }
+          for (uint32_t j = 0; j < routers.size (); j++)
+            {
+              uint32_t r = routers[j];
+              if (du[r] != SPF_GRAPH_INFINITY && dv[r] != SPF_GRAPH_INFINITY
+                  && du[r] + changed[g][i].second.second == dv[r])
+                {
+                  affected.insert (ids[r]);
+                }
+            }
+        }
+    }
+  return false;
+}
+
+//
+// Append a vertex popped from the candidate queue to the shortest path tree,
+// sharing the sets of root exit directions between the vertices (most of
+// the vertices inherit the exit directions of a neighbor of the root).
+//
+static uint32_t
+AddTreeVertex (SPFVertex* v, std::map<std::vector<SPFVertex::NodeExit_t>, uint32_t>& exitSets,
+               std::vector<Ipv4Address>& vertices, std::vector<uint32_t>& vertexExits,
+               std::vector<uint32_t>& firstExit, std::vector<SPFVertex::NodeExit_t>& exits)
+{
+  std::vector<SPFVertex::NodeExit_t> vExits;
+  for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
+    {
+      vExits.push_back (v->GetRootExitDirection (i));
+    }
+  std::map<std::vector<SPFVertex::NodeExit_t>, uint32_t>::iterator it = exitSets.find (vExits);
+  if (it == exitSets.end ())
+    {
+      it = exitSets.insert (std::make_pair (vExits, firstExit.size () - 1)).first;
+      exits.insert (exits.end (), vExits.begin (), vExits.end ());
+      firstExit.push_back (exits.size ());
+    }
+  vertices.push_back (v->GetVertexId ());
+  vertexExits.push_back (it->second);
+  return vertices.size () - 1;
+}
+
 // quagga ospf_spf_calculate
 void
 GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
@@ -1369,6 +1896,7 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
   v->SetDistanceFromRoot (0);
   v->GetLSA ()->SetStatus (GlobalRoutingLSA::LSA_SPF_IN_SPFTREE);
   NS_LOG_LOGIC ("Starting SPFCalculate for node " << root);
+  SPFSetRootNode (root);
 
 //
 // Optimize SPF calculation, for ns-3.
@@ -1381,9 +1909,25 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
     {
       NS_LOG_LOGIC ("SPFCalculate truncated for stub node " << root);
       delete m_spfroot;
+      m_spfroot = 0;
+      m_spfTrees.erase (root);
+      m_spfRootNode = 0;
+      m_spfRootRouting = 0;
       return;
     }
 
+//
+// The shortest path tree records the vertices in the order in which they are
+// added to the tree, so that the routes can be added (possibly again, by
+// UpdateRoutes ()) once the tree is complete.
+//
+  SPFTree tree;
+  std::map<std::vector<SPFVertex::NodeExit_t>, uint32_t> exitSets;
+  std::map<Ipv4Address, uint32_t> indices;
+  tree.firstExit.push_back (0);
+  indices[root] = AddTreeVertex (v, exitSets, tree.vertices, tree.vertexExits,
+                                 tree.firstExit, tree.exits);
+
   for (;;)
     {
 //
@@ -1444,39 +1988,21 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
 //
 // RFC2328 16.1. (4). 
 //
-// This is the method that actually adds the routes.  It'll walk the list
-// of nodes in the system, looking for the node corresponding to the router
-// ID of the root of the tree -- that is the router we're building the routes
-// for.  It looks for the Ipv4 interface of that node and remembers it.  So
-// we are only actually adding routes to that one node at the root of the SPF 
-// tree.
-//
-// We're going to pop of a pointer to every vertex in the tree except the 
-// root in order of distance from the root.  For each of the vertices, we call
-// SPFIntraAddRouter ().  Down in SPFIntraAddRouter, we look at all of the 
+// The root exit directions of the vertex are final once it is in the tree.
+// The vertex is recorded with them, and SPFInstallRoutes () will add the
+// routes towards it: for a router, SPFIntraAddRouter () looks at all of the 
 // point-to-point Global Router Link Records (the links to nodes adjacent to
-// the node represented by the vertex).  We add a route to the IP address 
+// the node represented by the vertex) and adds a route to the IP address 
 // specified by the m_linkData field of each of those link records.  This will
 // be the *local* IP address associated with the interface attached to the 
-// link.  We use the outbound interface and next hop information present in 
-// the vertex <v> which have possibly been inherited from the root.
+// link.  The outbound interface and next hop information recorded for the
+// vertex <v> have possibly been inherited from the root.
 //
-// To summarize, we're going to look at the node represented by <v> and loop
-// through its point-to-point links, adding a *host* route to the local IP
-// address (at the <v> side) for each of those links.
-//
-      if (v->GetVertexType () == SPFVertex::VertexRouter)
-        {
-          SPFIntraAddRouter (v);
-        }
-      else if (v->GetVertexType () == SPFVertex::VertexNetwork)
-        {
-          SPFIntraAddTransit (v);
-        }
-      else
-        {
-          NS_ASSERT_MSG (0, "illegal SPFVertex type");
-        }
+      NS_ASSERT_MSG (v->GetVertexType () == SPFVertex::VertexRouter ||
+                     v->GetVertexType () == SPFVertex::VertexNetwork,
+                     "illegal SPFVertex type");
+      indices[v->GetVertexId ()] = AddTreeVertex (v, exitSets, tree.vertices, tree.vertexExits,
+                                                  tree.firstExit, tree.exits);
 //
 // RFC2328 16.1. (5). 
 //
@@ -1486,179 +2012,191 @@ GlobalRouteManagerImpl::SPFCalculate (Ipv4Address root)
     }  // end for loop
 
 // Second stage of SPF calculation procedure
-  SPFProcessStubs (m_spfroot);
-  for (uint32_t i = 0; i < m_lsdb->GetNumExtLSAs (); i++)
-    {
-      m_spfroot->ClearVertexProcessed ();
-      GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (i);
-      NS_LOG_LOGIC ("Processing External LSA with id " << extlsa->GetLinkStateId ());
-      ProcessASExternals (m_spfroot, extlsa);
-    }
+  SPFProcessStubs (m_spfroot, indices, tree);
 
 //
-// We're all done setting the routing information for the node at the root of
-// the SPF tree.  Delete all of the vertices and corresponding resources.  Go
-// possibly do it again for the next router.
+// We're all done computing the tree of the node at the root of the SPF
+// calculation.  Delete all of the vertices and corresponding resources,
+// set the routing information and possibly keep the tree for the next
+// update.  Go possibly do it again for the next router.
 //
   delete m_spfroot;
   m_spfroot = 0;
+  SPFInstallRoutes (tree);
+  m_spfRootNode = 0;
+  m_spfRootRouting = 0;
+  if (m_keepSpfTrees)
+    {
+      std::swap (m_spfTrees[root], tree);
+    }
 }
 
 void
-GlobalRouteManagerImpl::ProcessASExternals (SPFVertex* v, GlobalRoutingLSA* extlsa)
+GlobalRouteManagerImpl::SPFSetRootNode (Ipv4Address root)
 {
-  NS_LOG_FUNCTION (this << v << extlsa);
-  NS_LOG_LOGIC ("Processing external for destination " << 
-                extlsa->GetLinkStateId () <<
-                ", for router "  << v->GetVertexId () <<
-                ", advertised by " << extlsa->GetAdvertisingRouter ());
-  if (v->GetVertexType () == SPFVertex::VertexRouter)
+  NS_LOG_FUNCTION (this << root);
+  m_spfRootNode = 0;
+  m_spfRootRouting = 0;
+//
+// We need the node having the router ID of the root vertex, to which we are
+// going to write the routing information.  The routers found when building
+// the database are looked up first; otherwise (e.g., when the database was
+// supplied by DebugUseLsdb ()) walk the list of nodes.
+//
+  std::map<Ipv4Address, uint32_t>::const_iterator it = m_routerNodes.find (root);
+  if (it != m_routerNodes.end () && it->second < NodeList::GetNNodes ())
     {
-      GlobalRoutingLSA *rlsa = v->GetLSA ();
-      NS_LOG_LOGIC ("Processing router LSA with id " << rlsa->GetLinkStateId ());
-      if ((rlsa->GetLinkStateId ()) == (extlsa->GetAdvertisingRouter ()))
+      Ptr<Node> node = NodeList::GetNode (it->second);
+      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
+      if (rtr != 0 && rtr->GetRouterId () == root)
         {
-          NS_LOG_LOGIC ("Found advertising router to destination");
-          SPFAddASExternal (extlsa,v);
+          m_spfRootNode = node;
         }
     }
-  for (uint32_t i = 0; i < v->GetNChildren (); i++)
+  if (m_spfRootNode == 0)
     {
-      if (!v->GetChild (i)->IsVertexProcessed ())
+      NodeList::Iterator listEnd = NodeList::End ();
+      for (NodeList::Iterator i = NodeList::Begin (); i != listEnd; i++)
         {
-          NS_LOG_LOGIC ("Vertex's child " << i << " not yet processed, processing...");
-          ProcessASExternals (v->GetChild (i), extlsa);
-          v->GetChild (i)->SetVertexProcessed (true);
+          Ptr<GlobalRouter> rtr = (*i)->GetObject<GlobalRouter> ();
+          if (rtr != 0 && rtr->GetRouterId () == root)
+            {
+              m_spfRootNode = *i;
+              break;
+            }
         }
     }
-}
-
+  if (m_spfRootNode == 0)
+    {
+      NS_LOG_LOGIC ("Can't find root node " << root);
+      return;
+    }
+  NS_LOG_LOGIC ("Setting routes for node " << m_spfRootNode->GetId ());
 //
-// Adding external routes to routing table - modeled after
-// SPFAddIntraAddStub()
+// Routing information is updated using the Ipv4 interface.  We need to 
+// GetObject for that interface.  If the node is acting as an IP version 4 
+// router, it should absolutely have an Ipv4 interface.
 //
+  NS_ASSERT_MSG (m_spfRootNode->GetObject<Ipv4> (), 
+                 "GlobalRouteManagerImpl::SPFSetRootNode (): "
+                 "GetObject for <Ipv4> interface failed");
+  m_spfRootRouting = m_spfRootNode->GetObject<GlobalRouter> ()->GetRoutingProtocol ();
+  NS_ASSERT (m_spfRootRouting);
+}
 
 void
-GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v)
+GlobalRouteManagerImpl::SPFInstallRoutes (const SPFTree& tree)
 {
-  NS_LOG_FUNCTION (this << extlsa << v);
-
-  NS_ASSERT_MSG (m_spfroot, "GlobalRouteManagerImpl::SPFAddASExternal (): Root pointer not set");
-// Two cases to consider: We are advertising the external ourselves
-// => No need to add anything
-// OR find best path to the advertising router
-  if (v->GetVertexId () == m_spfroot->GetVertexId ())
+  NS_LOG_FUNCTION (this);
+  if (m_spfRootRouting == 0)
     {
-      NS_LOG_LOGIC ("External is on local host: " 
-                    << v->GetVertexId () << "; returning");
       return;
     }
-  NS_LOG_LOGIC ("External is on remote host: " 
-                << extlsa->GetAdvertisingRouter () << "; installing");
-
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
 //
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// Add the routes to the routers (host routes to the local side of their
+// point-to-point links) and to the transit networks, in the order in which
+// they were added to the tree.  The first vertex is the root itself.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  for (uint32_t i = 1; i < tree.vertices.size (); i++)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
+      GlobalRoutingLSA *lsa = m_lsdb->GetLSA (tree.vertices[i]);
+      NS_ASSERT_MSG (lsa, "No LSA for vertex " << tree.vertices[i]);
+      if (lsa->GetLSType () == GlobalRoutingLSA::RouterLSA)
         {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << node->GetId ());
-          continue;
+          SPFIntraAddRouter (lsa, tree, i);
+        }
+      else if (lsa->GetLSType () == GlobalRoutingLSA::NetworkLSA)
+        {
+          SPFIntraAddTransit (lsa, tree, i);
+        }
+      else
+        {
+          NS_ASSERT_MSG (0, "illegal SPFVertex type");
         }
+    }
 //
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
+// Add the routes to the stub networks of the routers (the root excluded,
+// as its stub networks are on the local host).
 //
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
+  for (uint32_t j = 0; j < tree.stubOrder.size (); j++)
+    {
+      uint32_t i = tree.stubOrder[j];
+      GlobalRoutingLSA *rlsa = m_lsdb->GetLSA (tree.vertices[i]);
+      NS_LOG_LOGIC ("Processing router LSA with id " << rlsa->GetLinkStateId ());
+      for (uint32_t k = 0; k < rlsa->GetNLinkRecords (); k++)
         {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
+          GlobalRoutingLinkRecord *l = rlsa->GetLinkRecord (k);
+          if (l->GetLinkType () == GlobalRoutingLinkRecord::StubNetwork)
+            {
+              NS_LOG_LOGIC ("Found a Stub record to " << l->GetLinkId ());
+              SPFIntraAddStub (l, tree, i);
+            }
+        }
+    }
 //
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
+// Add the AS external routes, through the router advertising them (unless
+// it is the root itself).
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
+  for (uint32_t k = 0; k < m_lsdb->GetNumExtLSAs (); k++)
+    {
+      GlobalRoutingLSA *extlsa = m_lsdb->GetExtLSA (k);
+      NS_LOG_LOGIC ("Processing External LSA with id " << extlsa->GetLinkStateId ());
+      for (uint32_t j = 0; j < tree.stubOrder.size (); j++)
+        {
+          uint32_t i = tree.stubOrder[j];
+          if (tree.vertices[i] == extlsa->GetAdvertisingRouter ())
+            {
+              NS_LOG_LOGIC ("Found advertising router to destination");
+              SPFAddASExternal (extlsa, tree, i);
+            }
+        }
+    }
+}
+
 //
-// Get the Global Router Link State Advertisement from the vertex we're
-// adding the routes to.  The LSA will have a number of attached Global Router
-// Link Records corresponding to links off of that vertex / node.  We're going
-// to be interested in the records corresponding to point-to-point links.
+// Adding external routes to routing table - modeled after
+// SPFAddIntraAddStub()
 //
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = extlsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
 
+void
+GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, const SPFTree& tree, uint32_t i)
+{
+  NS_LOG_FUNCTION (this << extlsa << i);
 //
-// Here's why we did all of that work.  We're going to add a host route to the
-// host address found in the m_linkData field of the point-to-point link
-// record.  In the case of a point-to-point link, this is the local IP address
-// of the node connected to the link.  Each of these point-to-point links
-// will correspond to a local interface that has an IP address to which
-// the node at the root of the SPF tree can send packets.  The vertex <v> 
-// (corresponding to the node that has these links and interfaces) has 
-// an m_nextHop address precalculated for us that is the address to which the
-// root node should send packets to be forwarded to these IP addresses.
-// Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-// which the packets should be send for forwarding.
+// The external is advertised by a remote host (the stub order never holds
+// the root, which needs no route for its own externals), so we find the best
+// path to the advertising router.
 //
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add external network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+  NS_ASSERT_MSG (m_spfRootRouting, "GlobalRouteManagerImpl::SPFAddASExternal (): Root routing not set");
+  NS_LOG_LOGIC ("External is on remote host: " 
+                << extlsa->GetAdvertisingRouter () << "; installing");
+  Ipv4Mask tempmask = extlsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = extlsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
+//
+// Walk through all next-hop-IPs and out-going-interfaces for reaching the
+// stub network gateway (the vertex <i>) from the root node.
+//
+  for (uint32_t k = tree.firstExit[tree.vertexExits[i]]; k < tree.firstExit[tree.vertexExits[i] + 1]; k++)
+    {
+      Ipv4Address nextHop = tree.exits[k].first;
+      int32_t outIf = tree.exits[k].second;
+      if (outIf >= 0)
+        {
+          m_spfRootRouting->AddASExternalRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                        " add external network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
+        }
+      else
+        {
+          NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 
@@ -1666,33 +2204,27 @@ GlobalRouteManagerImpl::SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v
 // stub link records will exist for point-to-point interfaces and for
 // broadcast interfaces for which no neighboring router can be found
 void
-GlobalRouteManagerImpl::SPFProcessStubs (SPFVertex* v)
+GlobalRouteManagerImpl::SPFProcessStubs (SPFVertex* v, const std::map<Ipv4Address, uint32_t>& indices,
+                                         SPFTree& tree)
 {
   NS_LOG_FUNCTION (this << v);
   NS_LOG_LOGIC ("Processing stubs for " << v->GetVertexId ());
-  if (v->GetVertexType () == SPFVertex::VertexRouter)
+//
+// The routes to the stub networks (and the AS external routes) are added by
+// SPFInstallRoutes () for the router vertices, in the order of this walk of
+// the tree.  The stub networks of the root are on the local host.
+//
+  if (v->GetVertexType () == SPFVertex::VertexRouter && v != m_spfroot)
     {
-      GlobalRoutingLSA *rlsa = v->GetLSA ();
-      NS_LOG_LOGIC ("Processing router LSA with id " << rlsa->GetLinkStateId ());
-      for (uint32_t i = 0; i < rlsa->GetNLinkRecords (); i++)
-        {
-          NS_LOG_LOGIC ("Examining link " << i << " of " << 
-                        v->GetVertexId () << "'s " <<
-                        v->GetLSA ()->GetNLinkRecords () << " link records");
-          GlobalRoutingLinkRecord *l = v->GetLSA ()->GetLinkRecord (i);
-          if (l->GetLinkType () == GlobalRoutingLinkRecord::StubNetwork)
-            {
-              NS_LOG_LOGIC ("Found a Stub record to " << l->GetLinkId ());
-              SPFIntraAddStub (l, v);
-              continue;
-            }
-        }
+      std::map<Ipv4Address, uint32_t>::const_iterator it = indices.find (v->GetVertexId ());
+      NS_ASSERT (it != indices.end ());
+      tree.stubOrder.push_back (it->second);
     }
   for (uint32_t i = 0; i < v->GetNChildren (); i++)
     {
       if (!v->GetChild (i)->IsVertexProcessed ())
         {
-          SPFProcessStubs (v->GetChild (i));
+          SPFProcessStubs (v->GetChild (i), indices, tree);
           v->GetChild (i)->SetVertexProcessed (true);
         }
     }
@@ -1700,136 +2232,47 @@ GlobalRouteManagerImpl::SPFProcessStubs (SPFVertex* v)
 
 // RFC2328 16.1. second stage. 
 void
-GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex* v)
+GlobalRouteManagerImpl::SPFIntraAddStub (GlobalRoutingLinkRecord *l, const SPFTree& tree, uint32_t i)
 {
-  NS_LOG_FUNCTION (this << l << v);
+  NS_LOG_FUNCTION (this << l << i);
 
-  NS_ASSERT_MSG (m_spfroot, 
-                 "GlobalRouteManagerImpl::SPFIntraAddStub (): Root pointer not set");
+  NS_ASSERT_MSG (m_spfRootRouting, 
+                 "GlobalRouteManagerImpl::SPFIntraAddStub (): Root routing not set");
 
   // XXX simplifed logic for the moment.  There are two cases to consider:
   // 1) the stub network is on this router; do nothing for now
-  //    (already handled above)
+  //    (already handled above, the root is not in the stub order)
   // 2) the stub network is on a remote router, so I should use the
   // same next hop that I use to get to vertex v
-  if (v->GetVertexId () == m_spfroot->GetVertexId ())
-    {
-      NS_LOG_LOGIC ("Stub is on local host: " << v->GetVertexId () << "; returning");
-      return;
-    }
-  NS_LOG_LOGIC ("Stub is on remote host: " << v->GetVertexId () << "; installing");
-//
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
+  NS_LOG_LOGIC ("Stub is on remote host: " << tree.vertices[i] << "; installing");
+  Ipv4Mask tempmask (l->GetLinkData ().Get ());
+  Ipv4Address tempip = l->GetLinkId ();
+  tempip = tempip.CombineMask (tempmask);
 //
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
+// The vertex <i> (corresponding to the node that has the stub network) has 
+// the next hop addresses and the outbound interface indices to which the root
+// node should send packets to be forwarded to the stub network.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  for (uint32_t k = tree.firstExit[tree.vertexExits[i]]; k < tree.firstExit[tree.vertexExits[i] + 1]; k++)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to QI for that interface.  If there's no GlobalRouter interface, the node
-// in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
+      Ipv4Address nextHop = tree.exits[k].first;
+      int32_t outIf = tree.exits[k].second;
+      if (outIf >= 0)
         {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
+          m_spfRootRouting->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
+      else
         {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to QI
-// for that interface.  If the node is acting as an IP version 4 router, it
-// should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "QI for <Ipv4> interface failed");
-//
-// Get the Global Router Link State Advertisement from the vertex we're
-// adding the routes to.  The LSA will have a number of attached Global Router
-// Link Records corresponding to links off of that vertex / node.  We're going
-// to be interested in the records corresponding to point-to-point links.
-//
-          NS_ASSERT_MSG (v->GetLSA (), 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask (l->GetLinkData ().Get ());
-          Ipv4Address tempip = l->GetLinkId ();
-          tempip = tempip.CombineMask (tempmask);
-//
-// Here's why we did all of that work.  We're going to add a host route to the
-// host address found in the m_linkData field of the point-to-point link
-// record.  In the case of a point-to-point link, this is the local IP address
-// of the node connected to the link.  Each of these point-to-point links
-// will correspond to a local interface that has an IP address to which
-// the node at the root of the SPF tree can send packets.  The vertex <v> 
-// (corresponding to the node that has these links and interfaces) has 
-// an m_nextHop address precalculated for us that is the address to which the
-// root node should send packets to be forwarded to these IP addresses.
-// Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-// which the packets should be send for forwarding.
-//
-
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all next-hop-IPs and out-going-interfaces for reaching
-          // the stub network gateway 'v' from the root node
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative");
-                }
-            }
-          return;
-        } // if
-    } // for
+          NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative");
+        }
+    }
 }
 
 //
@@ -1844,70 +2287,31 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId (Ipv4Address a, Ipv4Mask amask)
 {
   NS_LOG_FUNCTION (this << a << amask);
 //
-// We have an IP address <a> and a vertex ID of the root of the SPF tree.
-// The question is what interface index does this address correspond to.
-// The answer is a little complicated since we have to find a pointer to
-// the node corresponding to the vertex ID, find the Ipv4 interface on that
-// node in order to iterate the interfaces and find the one corresponding to
-// the address in question.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-//
-// Walk the list of nodes in the system looking for the one corresponding to
-// the node at the root of the SPF tree.  This is the node for which we are
-// building the routing table.
+// We have an IP address <a> and the node at the root of the SPF tree, found
+// by SPFSetRootNode ().  The question is what interface index does this
+// address correspond to.
 //
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  if (m_spfRootNode == 0)
     {
-      Ptr<Node> node = *i;
-
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-//
-// If the node doesn't have a GlobalRouter interface it can't be the one
-// we're interested in.
-//
-      if (rtr == 0)
-        {
-          continue;
-        }
-
-      if (rtr->GetRouterId () == routerId)
-        {
+      NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node");
+      return -1;
+    }
 //
 // This is the node we're building the routing table for.  We're going to need
 // the Ipv4 interface to look for the ipv4 interface index.  Since this node
 // is participating in routing IP version 4 packets, it certainly must have 
 // an Ipv4 interface.
 //
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
-                         "GetObject for <Ipv4> interface failed");
+  Ptr<Ipv4> ipv4 = m_spfRootNode->GetObject<Ipv4> ();
+  NS_ASSERT_MSG (ipv4, 
+                 "GlobalRouteManagerImpl::FindOutgoingInterfaceId (): "
+                 "GetObject for <Ipv4> interface failed");
 //
 // Look through the interfaces on this node for one that has the IP address
 // we're looking for.  If we find one, return the corresponding interface
 // index, or -1 if not found.
 //
-          int32_t interface = ipv4->GetInterfaceForPrefix (a, amask);
-
-#if 0
-          if (interface < 0)
-            {
-              NS_FATAL_ERROR ("GlobalRouteManagerImpl::FindOutgoingInterfaceId(): "
-                              "Expected an interface associated with address a:" << a);
-            }
-#endif 
-          return interface;
-        }
-    }
-//
-// Couldn't find it.
-//
-  NS_LOG_LOGIC ("FindOutgoingInterfaceId():Can't find root node " << routerId);
-  return -1;
+  return ipv4->GetInterfaceForPrefix (a, amask);
 }
 
 //
@@ -1916,268 +2320,101 @@ GlobalRouteManagerImpl::FindOutgoingInterfaceId (Ipv4Address a, Ipv4Mask amask)
 // This is where we are actually going to add the host routes to the routing
 // tables of the individual nodes.
 //
-// The vertex passed as a parameter has just been added to the SPF tree.
-// This vertex must have a valid m_root_oid, corresponding to the outgoing
+// The vertex <i> is in the SPF tree, with the root exit directions (outgoing
 // interface on the root router of the tree that is the first hop on the path
-// to the vertex.  The vertex must also have a next hop address, corresponding
-// to the next hop on the path to the vertex.  The vertex has an m_lsa field
-// that has some number of link records.  For each point to point link record,
-// the m_linkData is the local IP address of the link.  This corresponds to
-// a destination IP address, reachable from the root, to which we add a host
-// route.
+// to the vertex, and next hop on the path to the vertex).  The vertex has an
+// LSA that has some number of link records.  For each point to point link
+// record, the m_linkData is the local IP address of the link.  This
+// corresponds to a destination IP address, reachable from the root, to which
+// we add a host route.
 //
 void
-GlobalRouteManagerImpl::SPFIntraAddRouter (SPFVertex* v)
+GlobalRouteManagerImpl::SPFIntraAddRouter (GlobalRoutingLSA* lsa, const SPFTree& tree, uint32_t i)
 {
-  NS_LOG_FUNCTION (this << v);
-
-  NS_ASSERT_MSG (m_spfroot, 
-                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root pointer not set");
-//
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
-    {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
+  NS_LOG_FUNCTION (this << lsa << i);
 
-      if (rtr == 0)
-        {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
-        }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
-        {
-          NS_LOG_LOGIC ("Setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "GetObject for <Ipv4> interface failed");
-//
-// Get the Global Router Link State Advertisement from the vertex we're
-// adding the routes to.  The LSA will have a number of attached Global Router
-// Link Records corresponding to links off of that vertex / node.  We're going
-// to be interested in the records corresponding to point-to-point links.
-//
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddRouter (): "
-                         "Expected valid LSA in SPFVertex* v");
-
-          uint32_t nLinkRecords = lsa->GetNLinkRecords ();
+  NS_ASSERT_MSG (m_spfRootRouting, 
+                 "GlobalRouteManagerImpl::SPFIntraAddRouter (): Root routing not set");
+  uint32_t nLinkRecords = lsa->GetNLinkRecords ();
 //
 // Iterate through the link records on the vertex to which we're going to add
 // routes.  To make sure we're being clear, we're going to add routing table
 // entries to the tables on the node corresping to the root of the SPF tree.
 // These entries will have routes to the IP addresses we find from looking at
 // the local side of the point-to-point links found on the node described by
-// the vertex <v>.
+// the vertex <i>.
 //
-          NS_LOG_LOGIC (" Node " << node->GetId () <<
-                        " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
-          for (uint32_t j = 0; j < nLinkRecords; ++j)
-            {
+  NS_LOG_LOGIC (" Node " << m_spfRootNode->GetId () <<
+                " found " << nLinkRecords << " link records in LSA " << lsa << "with LinkStateId "<< lsa->GetLinkStateId ());
+  for (uint32_t j = 0; j < nLinkRecords; ++j)
+    {
 //
 // We are only concerned about point-to-point links
 //
-              GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
-              if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
-                {
-                  continue;
-                }
-//
-// Here's why we did all of that work.  We're going to add a host route to the
-// host address found in the m_linkData field of the point-to-point link
-// record.  In the case of a point-to-point link, this is the local IP address
-// of the node connected to the link.  Each of these point-to-point links
-// will correspond to a local interface that has an IP address to which
-// the node at the root of the SPF tree can send packets.  The vertex <v> 
-// (corresponding to the node that has these links and interfaces) has 
-// an m_nextHop address precalculated for us that is the address to which the
-// root node should send packets to be forwarded to these IP addresses.
-// Similarly, the vertex <v> has an m_rootOif (outbound interface index) to
-// which the packets should be send for forwarding.
-//
-              Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-              if (router == 0)
-                {
-                  continue;
-                }
-              Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-              NS_ASSERT (gr);
-              // walk through all available exit directions due to ECMP,
-              // and add host route for each of the exit direction toward
-              // the vertex 'v'
-              for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-                {
-                  SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-                  Ipv4Address nextHop = exit.first;
-                  int32_t outIf = exit.second;
-                  if (outIf >= 0)
-                    {
-                      gr->AddHostRouteTo (lr->GetLinkData (), nextHop,
-                                          outIf);
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " adding host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " and outgoing interface " << outIf);
-                    }
-                  else
-                    {
-                      NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                    " NOT able to add host route to " << lr->GetLinkData () <<
-                                    " using next hop " << nextHop <<
-                                    " since outgoing interface id is negative " << outIf);
-                    }
-                } // for all routes from the root the vertex 'v'
-            }
-//
-// Done adding the routes for the selected node.
-//
-          return;
+      GlobalRoutingLinkRecord *lr = lsa->GetLinkRecord (j);
+      if (lr->GetLinkType () != GlobalRoutingLinkRecord::PointToPoint)
+        {
+          continue;
         }
+      // walk through all available exit directions due to ECMP,
+      // and add host route for each of the exit direction toward
+      // the vertex 'i'
+      for (uint32_t k = tree.firstExit[tree.vertexExits[i]]; k < tree.firstExit[tree.vertexExits[i] + 1]; k++)
+        {
+          Ipv4Address nextHop = tree.exits[k].first;
+          int32_t outIf = tree.exits[k].second;
+          if (outIf >= 0)
+            {
+              m_spfRootRouting->AddHostRouteTo (lr->GetLinkData (), nextHop, outIf);
+              NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                            " adding host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " and outgoing interface " << outIf);
+            }
+          else
+            {
+              NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                            " NOT able to add host route to " << lr->GetLinkData () <<
+                            " using next hop " << nextHop <<
+                            " since outgoing interface id is negative " << outIf);
+            }
+        } // for all routes from the root the vertex 'i'
     }
 }
+
 void
-GlobalRouteManagerImpl::SPFIntraAddTransit (SPFVertex* v)
+GlobalRouteManagerImpl::SPFIntraAddTransit (GlobalRoutingLSA* lsa, const SPFTree& tree, uint32_t i)
 {
-  NS_LOG_FUNCTION (this << v);
-
-  NS_ASSERT_MSG (m_spfroot, 
-                 "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root pointer not set");
-//
-// The root of the Shortest Path First tree is the router to which we are 
-// going to write the actual routing table entries.  The vertex corresponding
-// to this router has a vertex ID which is the router ID of that node.  We're
-// going to use this ID to discover which node it is that we're actually going
-// to update.
-//
-  Ipv4Address routerId = m_spfroot->GetVertexId ();
-
-  NS_LOG_LOGIC ("Vertex ID = " << routerId);
-//
-// We need to walk the list of nodes looking for the one that has the router
-// ID corresponding to the root vertex.  This is the one we're going to write
-// the routing information to.
-//
-  NodeList::Iterator i = NodeList::Begin (); 
-  NodeList::Iterator listEnd = NodeList::End ();
-  for (; i != listEnd; i++)
+  NS_LOG_FUNCTION (this << lsa << i);
+
+  NS_ASSERT_MSG (m_spfRootRouting, 
+                 "GlobalRouteManagerImpl::SPFIntraAddTransit (): Root routing not set");
+  Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
+  Ipv4Address tempip = lsa->GetLinkStateId ();
+  tempip = tempip.CombineMask (tempmask);
+  // walk through all available exit directions due to ECMP,
+  // and add network route for each of the exit direction toward
+  // the vertex 'i'
+  for (uint32_t k = tree.firstExit[tree.vertexExits[i]]; k < tree.firstExit[tree.vertexExits[i] + 1]; k++)
     {
-      Ptr<Node> node = *i;
-//
-// The router ID is accessible through the GlobalRouter interface, so we need
-// to GetObject for that interface.  If there's no GlobalRouter interface, 
-// the node in question cannot be the router we want, so we continue.
-// 
-      Ptr<GlobalRouter> rtr = 
-        node->GetObject<GlobalRouter> ();
-
-      if (rtr == 0)
+      Ipv4Address nextHop = tree.exits[k].first;
+      int32_t outIf = tree.exits[k].second;
+      if (outIf >= 0)
         {
-          NS_LOG_LOGIC ("No GlobalRouter interface on node " << 
-                        node->GetId ());
-          continue;
+          m_spfRootRouting->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
+          NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                        " add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " via interface " << outIf);
         }
-//
-// If the router ID of the current node is equal to the router ID of the 
-// root of the SPF tree, then this node is the one for which we need to 
-// write the routing tables.
-//
-      NS_LOG_LOGIC ("Considering router " << rtr->GetRouterId ());
-
-      if (rtr->GetRouterId () == routerId)
+      else
         {
-          NS_LOG_LOGIC ("setting routes for node " << node->GetId ());
-//
-// Routing information is updated using the Ipv4 interface.  We need to 
-// GetObject for that interface.  If the node is acting as an IP version 4 
-// router, it should absolutely have an Ipv4 interface.
-//
-          Ptr<Ipv4> ipv4 = node->GetObject<Ipv4> ();
-          NS_ASSERT_MSG (ipv4, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "GetObject for <Ipv4> interface failed");
-//
-// Get the Global Router Link State Advertisement from the vertex we're
-// adding the routes to.  The LSA will have a number of attached Global Router
-// Link Records corresponding to links off of that vertex / node.  We're going
-// to be interested in the records corresponding to point-to-point links.
-//
-          GlobalRoutingLSA *lsa = v->GetLSA ();
-          NS_ASSERT_MSG (lsa, 
-                         "GlobalRouteManagerImpl::SPFIntraAddTransit (): "
-                         "Expected valid LSA in SPFVertex* v");
-          Ipv4Mask tempmask = lsa->GetNetworkLSANetworkMask ();
-          Ipv4Address tempip = lsa->GetLinkStateId ();
-          tempip = tempip.CombineMask (tempmask);
-          Ptr<GlobalRouter> router = node->GetObject<GlobalRouter> ();
-          if (router == 0)
-            {
-              continue;
-            }
-          Ptr<Ipv4GlobalRouting> gr = router->GetRoutingProtocol ();
-          NS_ASSERT (gr);
-          // walk through all available exit directions due to ECMP,
-          // and add host route for each of the exit direction toward
-          // the vertex 'v'
-          for (uint32_t i = 0; i < v->GetNRootExitDirections (); i++)
-            {
-              SPFVertex::NodeExit_t exit = v->GetRootExitDirection (i);
-              Ipv4Address nextHop = exit.first;
-              int32_t outIf = exit.second;
-
-              if (outIf >= 0)
-                {
-                  gr->AddNetworkRouteTo (tempip, tempmask, nextHop, outIf);
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " via interface " << outIf);
-                }
-              else
-                {
-                  NS_LOG_LOGIC ("(Route " << i << ") Node " << node->GetId () <<
-                                " NOT able to add network route to " << tempip <<
-                                " using next hop " << nextHop <<
-                                " since outgoing interface id is negative " << outIf);
-                }
-            }
+          NS_LOG_LOGIC ("Node " << m_spfRootNode->GetId () <<
+                        " NOT able to add network route to " << tempip <<
+                        " using next hop " << nextHop <<
+                        " since outgoing interface id is negative " << outIf);
         }
-    } 
+    }
 }
 
 // Derived from quagga ospf_vertex_add_parents ()
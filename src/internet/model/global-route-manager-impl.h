@@ -26,6 +26,7 @@
 #include <list>
 #include <queue>
 #include <map>
+#include <set>
 #include <vector>
 #include "ns3/object.h"
 #include "ns3/ptr.h"
@@ -38,6 +39,7 @@ const uint32_t SPF_INFINITY = 0xffffffff; //!< "infinite" distance between nodes
 
 class CandidateQueue;
 class Ipv4GlobalRouting;
+class Node;
 
 /**
  * \ingroup globalrouting
@@ -245,6 +247,27 @@ public:
  */
   void SetDistanceFromRoot (uint32_t distance);
 
+/**
+ * @brief Get the position of "this" SPFVertex in the heap of the candidate
+ * queue holding it.
+ *
+ * @see CandidateQueue
+ * @returns The position of "this" SPFVertex in the candidate queue.
+ */
+  uint32_t GetCandidatePosition (void) const;
+
+/**
+ * @brief Set the position of "this" SPFVertex in the heap of the candidate
+ * queue holding it.
+ *
+ * The position is only maintained by the candidate queue, so that it can
+ * move a vertex whose distance changed without searching for it.
+ *
+ * @see CandidateQueue
+ * @param position The position of "this" SPFVertex in the candidate queue.
+ */
+  void SetCandidatePosition (uint32_t position);
+
 /**
  * @brief Set the IP address and outgoing interface index that should be used 
  * to begin forwarding packets from the root SPFVertex to "this" SPFVertex.
@@ -530,6 +553,7 @@ private:
   Ipv4Address m_vertexId; //!< Vertex ID
   GlobalRoutingLSA* m_lsa; //!< Link State Advertisement
   uint32_t m_distanceFromRoot; //!< Distance from root node
+  uint32_t m_candidatePosition; //!< Position in the candidate queue
   int32_t m_rootOif; //!< root Output Interface
   Ipv4Address m_nextHop; //!< next hop
   typedef std::list< NodeExit_t > ListOfNodeExit_t; //!< container of Exit nodes
@@ -641,6 +665,14 @@ public:
  */
   GlobalRoutingLSA* GetLSAByLinkData (Ipv4Address addr) const;
 
+/**
+ * @brief Get the link state IDs of the router and network Link State
+ * Advertisements of the database, in increasing order.
+ *
+ * @param ids The vector to which the link state IDs are appended.
+ */
+  void GetLinkStateIds (std::vector<Ipv4Address> &ids) const;
+
 /**
  * @brief Set all LSA flags to an initialized state, for SPF computation
  *
@@ -681,6 +713,11 @@ private:
 
   LSDBMap_t m_database; //!< database of IPv4 addresses / Link State Advertisements
   std::vector<GlobalRoutingLSA*> m_extdatabase; //!< database of External Link State Advertisements
+  /**
+   * Link data of the TransitNetwork link records / link state ID of the
+   * first Link State Advertisement (in the database order) holding them
+   */
+  std::map<Ipv4Address, Ipv4Address> m_linkDataIndex;
 
 /**
  * @brief GlobalRouteManagerLSDB copy construction is disallowed.  There's no 
@@ -735,6 +772,21 @@ public:
  */
   virtual void InitializeRoutes ();
 
+/**
+ * @brief Rebuild the routing database and update the per-node forwarding
+ * tables, yielding the same routes as DeleteGlobalRoutes (),
+ * BuildGlobalRoutingDatabase () and InitializeRoutes ().
+ *
+ * If the GlobalRoutingKeepSpfTrees global value is set, the shortest path
+ * tree of each router is kept from one call to the next.  The routers whose
+ * tree may be changed by the differences between the previous and the new
+ * database run the SPF calculation again, while the routes of the other
+ * routers are rebuilt from their previous tree and the new Link State
+ * Advertisements.  The first call computes all the trees.  Otherwise, all
+ * the routes are recomputed and no tree is kept.
+ */
+  virtual void UpdateRoutes ();
+
 /**
  * @brief Debugging routine; allow client code to supply a pre-built LSDB
  */
@@ -766,8 +818,31 @@ private:
  */
   GlobalRouteManagerImpl& operator= (GlobalRouteManagerImpl& srmi);
 
+  /**
+   * \brief Shortest path tree of a router, as needed to install its routes.
+   *
+   * The vertices are stored in the order in which they were added to the
+   * tree (the root first), each with the index of its set of root exit
+   * directions.  The stub order lists the router vertices other than the
+   * root in the order in which the second stage of the calculation visits
+   * them.
+   */
+  struct SPFTree
+  {
+    std::vector<Ipv4Address> vertices;  //!< vertex IDs, in the order of their addition
+    std::vector<uint32_t> vertexExits;  //!< index of the exit directions of each vertex
+    std::vector<uint32_t> firstExit;    //!< offset of each set of exit directions, plus the end offset
+    std::vector<SPFVertex::NodeExit_t> exits; //!< distinct sets of exit directions
+    std::vector<uint32_t> stubOrder;    //!< indices of the router vertices, in the second stage order
+  };
+
   SPFVertex* m_spfroot; //!< the root node
   GlobalRouteManagerLSDB* m_lsdb; //!< the Link State DataBase (LSDB) of the Global Route Manager
+  std::map<Ipv4Address, uint32_t> m_routerNodes; //!< router IDs / node IDs of the routers
+  Ptr<Node> m_spfRootNode; //!< node of the root of the SPF calculation
+  Ptr<Ipv4GlobalRouting> m_spfRootRouting; //!< routing protocol of the root of the SPF calculation
+  bool m_keepSpfTrees; //!< whether the shortest path trees are kept for UpdateRoutes ()
+  std::map<Ipv4Address, SPFTree> m_spfTrees; //!< shortest path trees of the routers
 
   /**
    * \brief Test if a node is a stub, from an OSPF sense.
@@ -789,6 +864,26 @@ private:
    */
   void SPFCalculate (Ipv4Address root);
 
+  /**
+   * \brief Find the node and the routing protocol of the root of the SPF
+   * calculation, to which the routes are added.
+   *
+   * \param root the router ID of the root
+   */
+  void SPFSetRootNode (Ipv4Address root);
+
+  /**
+   * \brief Add the routes of the root to the routing tables
+   *
+   * The routes to the vertices of the tree are added in the order of the
+   * vertices, then the routes to the stub networks and the AS external
+   * routes in the stub order, using the Link State Advertisements of the
+   * current database.
+   *
+   * \param tree the shortest path tree of the root
+   */
+  void SPFInstallRoutes (const SPFTree& tree);
+
   /**
    * \brief Process Stub nodes
    *
@@ -796,17 +891,32 @@ private:
    * stub link records will exist for point-to-point interfaces and for
    * broadcast interfaces for which no neighboring router can be found
    *
+   * The routes are not added here: the router vertices are appended to the
+   * stub order of the tree, in the order in which they are processed.
+   *
    * \param v vertex to be processed
+   * \param indices the indices of the vertices in the tree
+   * \param tree the shortest path tree
    */
-  void SPFProcessStubs (SPFVertex* v);
+  void SPFProcessStubs (SPFVertex* v, const std::map<Ipv4Address, uint32_t>& indices,
+                        SPFTree& tree);
 
   /**
-   * \brief Process Autonomous Systems (AS) External LSA
+   * \brief Find the routers whose shortest path tree may differ between
+   * the previous and the current database.
    *
-   * \param v vertex to be processed
-   * \param extlsa external LSA
+   * A tree can only change if a link added or removed (or whose metric
+   * changed) is on a shortest path from the root, in the previous or in the
+   * current database.  The next hops of a root also depend on the Link
+   * State Advertisements of its neighbors, hence the neighbors of the
+   * routers and networks whose advertisement changed are affected too.
+   *
+   * \param oldLsdb the previous database
+   * \param affected the set to which the affected router IDs are added
+   * \returns true if all the routers must be considered affected
    */
-  void ProcessASExternals (SPFVertex* v, GlobalRoutingLSA* extlsa);
+  bool FindAffectedRouters (GlobalRouteManagerLSDB* oldLsdb,
+                            std::set<Ipv4Address>& affected);
 
   /**
    * \brief Examine the links in v's LSA and update the list of candidates with any
@@ -904,33 +1014,39 @@ private:
    * a destination IP address, reachable from the root, to which we add a host
    * route.
    *
-   * \param v the vertex
+   * \param lsa the LSA of the vertex
+   * \param tree the shortest path tree
+   * \param i the index of the vertex in the tree
    *
    */
-  void SPFIntraAddRouter (SPFVertex* v);
+  void SPFIntraAddRouter (GlobalRoutingLSA* lsa, const SPFTree& tree, uint32_t i);
 
   /**
    * \brief Add a transit to the routing tables
    *
-   * \param v the vertex
+   * \param lsa the LSA of the vertex
+   * \param tree the shortest path tree
+   * \param i the index of the vertex in the tree
    */
-  void SPFIntraAddTransit (SPFVertex* v);
+  void SPFIntraAddTransit (GlobalRoutingLSA* lsa, const SPFTree& tree, uint32_t i);
 
   /**
    * \brief Add a stub to the routing tables
    *
    * \param l the global routing link record
-   * \param v the vertex
+   * \param tree the shortest path tree
+   * \param i the index of the vertex in the tree
    */
-  void SPFIntraAddStub (GlobalRoutingLinkRecord *l, SPFVertex* v);
+  void SPFIntraAddStub (GlobalRoutingLinkRecord *l, const SPFTree& tree, uint32_t i);
 
   /**
    * \brief Add an external route to the routing tables
    *
    * \param extlsa the external LSA
-   * \param v the vertex
+   * \param tree the shortest path tree
+   * \param i the index of the vertex in the tree
    */
-  void SPFAddASExternal (GlobalRoutingLSA *extlsa, SPFVertex *v);
+  void SPFAddASExternal (GlobalRoutingLSA *extlsa, const SPFTree& tree, uint32_t i);
 
   /**
    * \brief Return the interface number corresponding to a given IP address and mask
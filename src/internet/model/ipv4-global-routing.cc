@@ -16,6 +16,7 @@
 // Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
 //
 
+#include <algorithm>
 #include <vector>
 #include <iomanip>
 #include "ns3/names.h"
@@ -59,7 +60,8 @@ Ipv4GlobalRouting::GetTypeId (void)
 
 Ipv4GlobalRouting::Ipv4GlobalRouting () 
   : m_randomEcmpRouting (false),
-    m_respondToInterfaceEvents (false)
+    m_respondToInterfaceEvents (false),
+    m_routeIndex (32)
 {
   NS_LOG_FUNCTION (this);
 
@@ -80,6 +82,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, nextHop, interface);
   m_hostRoutes.push_back (route);
+  IndexRoute (&IndexedRoutes::hostRoutes, route);
 }
 
 void 
@@ -90,6 +93,7 @@ Ipv4GlobalRouting::AddHostRouteTo (Ipv4Address dest,
   Ipv4RoutingTableEntry *route = new Ipv4RoutingTableEntry ();
   *route = Ipv4RoutingTableEntry::CreateHostRouteTo (dest, interface);
   m_hostRoutes.push_back (route);
+  IndexRoute (&IndexedRoutes::hostRoutes, route);
 }
 
 void 
@@ -105,6 +109,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_networkRoutes.push_back (route);
+  IndexRoute (&IndexedRoutes::networkRoutes, route);
 }
 
 void 
@@ -118,6 +123,7 @@ Ipv4GlobalRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         interface);
   m_networkRoutes.push_back (route);
+  IndexRoute (&IndexedRoutes::networkRoutes, route);
 }
 
 void 
@@ -133,6 +139,7 @@ Ipv4GlobalRouting::AddASExternalRouteTo (Ipv4Address network,
                                                         nextHop,
                                                         interface);
   m_ASexternalRoutes.push_back (route);
+  IndexRoute (&IndexedRoutes::externalRoutes, route);
 }
 
 
@@ -146,14 +153,24 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
   typedef std::vector<Ipv4RoutingTableEntry*> RouteVec_t;
   RouteVec_t allRoutes;
 
+  uint8_t buf[4];
+  dest.Serialize (buf);
+  // the matching prefixes, from the shortest to the longest
+  std::vector<IndexedRoutes *> matches;
+  m_routeIndex.Lookup (buf, matches);
+
   NS_LOG_LOGIC ("Number of m_hostRoutes = " << m_hostRoutes.size ());
-  for (HostRoutesCI i = m_hostRoutes.begin (); 
-       i != m_hostRoutes.end (); 
-       i++) 
+  NS_LOG_LOGIC ("Number of m_networkRoutes" << m_networkRoutes.size ());
+  for (std::vector<IndexedRoutes *>::reverse_iterator m = matches.rbegin ();
+       m != matches.rend () && allRoutes.size () == 0;
+       m++)
     {
-      NS_ASSERT ((*i)->IsHost ());
-      if ((*i)->GetDest ().IsEqual (dest)) 
+      // the host routes, which are the longest prefixes, are used first
+      for (PrefixRoutes::const_iterator i = (*m)->hostRoutes.begin (); 
+           i != (*m)->hostRoutes.end (); 
+           i++) 
         {
+          NS_ASSERT ((*i)->IsHost ());
           if (oif != 0)
             {
               if (oif != m_ipv4->GetNetDevice ((*i)->GetInterface ()))
@@ -165,53 +182,46 @@ Ipv4GlobalRouting::LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif)
           allRoutes.push_back (*i);
           NS_LOG_LOGIC (allRoutes.size () << "Found global host route" << *i); 
         }
-    }
-  if (allRoutes.size () == 0) // if no host route is found
-    {
-      NS_LOG_LOGIC ("Number of m_networkRoutes" << m_networkRoutes.size ());
-      for (NetworkRoutesI j = m_networkRoutes.begin (); 
-           j != m_networkRoutes.end (); 
+      if (allRoutes.size () > 0)
+        {
+          break;
+        }
+      for (PrefixRoutes::const_iterator j = (*m)->networkRoutes.begin (); 
+           j != (*m)->networkRoutes.end (); 
            j++) 
         {
-          Ipv4Mask mask = (*j)->GetDestNetworkMask ();
-          Ipv4Address entry = (*j)->GetDestNetwork ();
-          if (mask.IsMatch (dest, entry)) 
+          if (oif != 0)
             {
-              if (oif != 0)
+              if (oif != m_ipv4->GetNetDevice ((*j)->GetInterface ()))
                 {
-                  if (oif != m_ipv4->GetNetDevice ((*j)->GetInterface ()))
-                    {
-                      NS_LOG_LOGIC ("Not on requested interface, skipping");
-                      continue;
-                    }
+                  NS_LOG_LOGIC ("Not on requested interface, skipping");
+                  continue;
                 }
-              allRoutes.push_back (*j);
-              NS_LOG_LOGIC (allRoutes.size () << "Found global network route" << *j);
             }
+          allRoutes.push_back (*j);
+          NS_LOG_LOGIC (allRoutes.size () << "Found global network route" << *j);
         }
     }
-  if (allRoutes.size () == 0)  // consider external if no host/network found
+  // consider external if no host/network found
+  for (std::vector<IndexedRoutes *>::reverse_iterator m = matches.rbegin ();
+       m != matches.rend () && allRoutes.size () == 0;
+       m++)
     {
-      for (ASExternalRoutesI k = m_ASexternalRoutes.begin ();
-           k != m_ASexternalRoutes.end ();
+      for (PrefixRoutes::const_iterator k = (*m)->externalRoutes.begin ();
+           k != (*m)->externalRoutes.end ();
            k++)
         {
-          Ipv4Mask mask = (*k)->GetDestNetworkMask ();
-          Ipv4Address entry = (*k)->GetDestNetwork ();
-          if (mask.IsMatch (dest, entry))
+          NS_LOG_LOGIC ("Found external route" << *k);
+          if (oif != 0)
             {
-              NS_LOG_LOGIC ("Found external route" << *k);
-              if (oif != 0)
+              if (oif != m_ipv4->GetNetDevice ((*k)->GetInterface ()))
                 {
-                  if (oif != m_ipv4->GetNetDevice ((*k)->GetInterface ()))
-                    {
-                      NS_LOG_LOGIC ("Not on requested interface, skipping");
-                      continue;
-                    }
+                  NS_LOG_LOGIC ("Not on requested interface, skipping");
+                  continue;
                 }
-              allRoutes.push_back (*k);
-              break;
             }
+          allRoutes.push_back (*k);
+          break;
         }
     }
   if (allRoutes.size () > 0 ) // if route(s) is found
@@ -262,48 +272,16 @@ Ipv4GlobalRouting::GetRoute (uint32_t index) const
   NS_LOG_FUNCTION (this << index);
   if (index < m_hostRoutes.size ())
     {
-      uint32_t tmp = 0;
-      for (HostRoutesCI i = m_hostRoutes.begin (); 
-           i != m_hostRoutes.end (); 
-           i++) 
-        {
-          if (tmp  == index)
-            {
-              return *i;
-            }
-          tmp++;
-        }
+      return m_hostRoutes[index];
     }
   index -= m_hostRoutes.size ();
-  uint32_t tmp = 0;
   if (index < m_networkRoutes.size ())
     {
-      for (NetworkRoutesCI j = m_networkRoutes.begin (); 
-           j != m_networkRoutes.end ();
-           j++)
-        {
-          if (tmp == index)
-            {
-              return *j;
-            }
-          tmp++;
-        }
+      return m_networkRoutes[index];
     }
   index -= m_networkRoutes.size ();
-  tmp = 0;
-  for (ASExternalRoutesCI k = m_ASexternalRoutes.begin (); 
-       k != m_ASexternalRoutes.end (); 
-       k++) 
-    {
-      if (tmp == index)
-        {
-          return *k;
-        }
-      tmp++;
-    }
-  NS_ASSERT (false);
-  // quiet compiler.
-  return 0;
+  NS_ASSERT (index < m_ASexternalRoutes.size ());
+  return m_ASexternalRoutes[index];
 }
 void 
 Ipv4GlobalRouting::RemoveRoute (uint32_t index)
@@ -311,55 +289,57 @@ Ipv4GlobalRouting::RemoveRoute (uint32_t index)
   NS_LOG_FUNCTION (this << index);
   if (index < m_hostRoutes.size ())
     {
-      uint32_t tmp = 0;
-      for (HostRoutesI i = m_hostRoutes.begin (); 
-           i != m_hostRoutes.end (); 
-           i++) 
-        {
-          if (tmp  == index)
-            {
-              NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_hostRoutes.size ());
-              delete *i;
-              m_hostRoutes.erase (i);
-              NS_LOG_LOGIC ("Done removing host route " << index << "; host route remaining size = " << m_hostRoutes.size ());
-              return;
-            }
-          tmp++;
-        }
+      HostRoutesI i = m_hostRoutes.begin () + index;
+      NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_hostRoutes.size ());
+      UnindexRoute (&IndexedRoutes::hostRoutes, *i);
+      delete *i;
+      m_hostRoutes.erase (i);
+      NS_LOG_LOGIC ("Done removing host route " << index << "; host route remaining size = " << m_hostRoutes.size ());
+      return;
     }
   index -= m_hostRoutes.size ();
-  uint32_t tmp = 0;
-  for (NetworkRoutesI j = m_networkRoutes.begin (); 
-       j != m_networkRoutes.end (); 
-       j++) 
+  if (index < m_networkRoutes.size ())
     {
-      if (tmp == index)
-        {
-          NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_networkRoutes.size ());
-          delete *j;
-          m_networkRoutes.erase (j);
-          NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
-          return;
-        }
-      tmp++;
+      NetworkRoutesI j = m_networkRoutes.begin () + index;
+      NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_networkRoutes.size ());
+      UnindexRoute (&IndexedRoutes::networkRoutes, *j);
+      delete *j;
+      m_networkRoutes.erase (j);
+      NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
+      return;
     }
   index -= m_networkRoutes.size ();
-  tmp = 0;
-  for (ASExternalRoutesI k = m_ASexternalRoutes.begin (); 
-       k != m_ASexternalRoutes.end ();
-       k++)
+  NS_ASSERT (index < m_ASexternalRoutes.size ());
+  ASExternalRoutesI k = m_ASexternalRoutes.begin () + index;
+  NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_ASexternalRoutes.size ());
+  UnindexRoute (&IndexedRoutes::externalRoutes, *k);
+  delete *k;
+  m_ASexternalRoutes.erase (k);
+  NS_LOG_LOGIC ("Done removing external route " << index << "; external route remaining size = " << m_ASexternalRoutes.size ());
+}
+
+void
+Ipv4GlobalRouting::IndexRoute (PrefixRoutes IndexedRoutes::*routes, Ipv4RoutingTableEntry *route)
+{
+  uint8_t buf[4];
+  route->GetDestNetwork ().Serialize (buf);
+  (m_routeIndex.Insert (buf, route->GetDestNetworkMask ().GetPrefixLength ()).*routes).push_back (route);
+}
+
+void
+Ipv4GlobalRouting::UnindexRoute (PrefixRoutes IndexedRoutes::*routes, Ipv4RoutingTableEntry *route)
+{
+  uint8_t buf[4];
+  route->GetDestNetwork ().Serialize (buf);
+  uint16_t length = route->GetDestNetworkMask ().GetPrefixLength ();
+  IndexedRoutes *indexed = m_routeIndex.Find (buf, length);
+  NS_ASSERT (indexed != 0);
+  PrefixRoutes &prefixRoutes = indexed->*routes;
+  prefixRoutes.erase (std::find (prefixRoutes.begin (), prefixRoutes.end (), route));
+  if (indexed->hostRoutes.empty () && indexed->networkRoutes.empty () && indexed->externalRoutes.empty ())
     {
-      if (tmp == index)
-        {
-          NS_LOG_LOGIC ("Removing route " << index << "; size = " << m_ASexternalRoutes.size ());
-          delete *k;
-          m_ASexternalRoutes.erase (k);
-          NS_LOG_LOGIC ("Done removing network route " << index << "; network route remaining size = " << m_networkRoutes.size ());
-          return;
-        }
-      tmp++;
+      m_routeIndex.Remove (buf, length);
     }
-  NS_ASSERT (false);
 }
 
 int64_t
@@ -392,6 +372,7 @@ Ipv4GlobalRouting::DoDispose (void)
     {
       delete (*l);
     }
+  m_routeIndex.Clear ();
 
   Ipv4RoutingProtocol::DoDispose ();
 }
@@ -537,9 +518,7 @@ Ipv4GlobalRouting::NotifyInterfaceUp (uint32_t i)
   NS_LOG_FUNCTION (this << i);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
@@ -549,9 +528,7 @@ Ipv4GlobalRouting::NotifyInterfaceDown (uint32_t i)
   NS_LOG_FUNCTION (this << i);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
@@ -561,9 +538,7 @@ Ipv4GlobalRouting::NotifyAddAddress (uint32_t interface, Ipv4InterfaceAddress ad
   NS_LOG_FUNCTION (this << interface << address);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
@@ -573,9 +548,7 @@ Ipv4GlobalRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
   NS_LOG_FUNCTION (this << interface << address);
   if (m_respondToInterfaceEvents && Simulator::Now ().GetSeconds () > 0)  // avoid startup events
     {
-      GlobalRouteManager::DeleteGlobalRoutes ();
-      GlobalRouteManager::BuildGlobalRoutingDatabase ();
-      GlobalRouteManager::InitializeRoutes ();
+      GlobalRouteManager::UpdateRoutes ();
     }
 }
 
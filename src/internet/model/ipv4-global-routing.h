@@ -20,7 +20,8 @@
 #ifndef IPV4_GLOBAL_ROUTING_H
 #define IPV4_GLOBAL_ROUTING_H
 
-#include <list>
+#include <deque>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
@@ -28,6 +29,7 @@
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
 #include "ns3/random-variable-stream.h"
+#include "route-prefix-trie.h"
 
 namespace ns3 {
 
@@ -240,37 +242,70 @@ private:
   Ptr<UniformRandomVariable> m_rand;
 
   /// container of Ipv4RoutingTableEntry (routes to hosts)
-  typedef std::list<Ipv4RoutingTableEntry *> HostRoutes;
+  typedef std::deque<Ipv4RoutingTableEntry *> HostRoutes;
   /// const iterator of container of Ipv4RoutingTableEntry (routes to hosts)
-  typedef std::list<Ipv4RoutingTableEntry *>::const_iterator HostRoutesCI;
+  typedef std::deque<Ipv4RoutingTableEntry *>::const_iterator HostRoutesCI;
   /// iterator of container of Ipv4RoutingTableEntry (routes to hosts)
-  typedef std::list<Ipv4RoutingTableEntry *>::iterator HostRoutesI;
+  typedef std::deque<Ipv4RoutingTableEntry *>::iterator HostRoutesI;
 
   /// container of Ipv4RoutingTableEntry (routes to networks)
-  typedef std::list<Ipv4RoutingTableEntry *> NetworkRoutes;
+  typedef std::deque<Ipv4RoutingTableEntry *> NetworkRoutes;
   /// const iterator of container of Ipv4RoutingTableEntry (routes to networks)
-  typedef std::list<Ipv4RoutingTableEntry *>::const_iterator NetworkRoutesCI;
+  typedef std::deque<Ipv4RoutingTableEntry *>::const_iterator NetworkRoutesCI;
   /// iterator of container of Ipv4RoutingTableEntry (routes to networks)
-  typedef std::list<Ipv4RoutingTableEntry *>::iterator NetworkRoutesI;
+  typedef std::deque<Ipv4RoutingTableEntry *>::iterator NetworkRoutesI;
 
   /// container of Ipv4RoutingTableEntry (routes to external AS)
-  typedef std::list<Ipv4RoutingTableEntry *> ASExternalRoutes;
+  typedef std::deque<Ipv4RoutingTableEntry *> ASExternalRoutes;
   /// const iterator of container of Ipv4RoutingTableEntry (routes to external AS)
-  typedef std::list<Ipv4RoutingTableEntry *>::const_iterator ASExternalRoutesCI;
+  typedef std::deque<Ipv4RoutingTableEntry *>::const_iterator ASExternalRoutesCI;
   /// iterator of container of Ipv4RoutingTableEntry (routes to external AS)
-  typedef std::list<Ipv4RoutingTableEntry *>::iterator ASExternalRoutesI;
+  typedef std::deque<Ipv4RoutingTableEntry *>::iterator ASExternalRoutesI;
+
+  /// routes towards the same prefix, in the order of the routing table
+  typedef std::vector<Ipv4RoutingTableEntry *> PrefixRoutes;
+  /// host, network and external routes towards the same prefix
+  struct IndexedRoutes
+  {
+    PrefixRoutes hostRoutes;      //!< Routes to hosts
+    PrefixRoutes networkRoutes;   //!< Routes to networks
+    PrefixRoutes externalRoutes;  //!< External routes imported
+  };
+  /// routes indexed by destination prefix
+  typedef RoutePrefixTrie<IndexedRoutes> RouteIndex;
 
   /**
    * \brief Lookup in the forwarding table for destination.
+   *
+   * The prefixes matching the destination are found by a single walk of
+   * the route index. The host routes to the destination are used first,
+   * then the network routes with the longest prefix matching the
+   * destination, and finally the first external route with the longest
+   * prefix matching the destination.
+   *
    * \param dest destination address
    * \param oif output interface if any (put 0 otherwise)
    * \return Ipv4Route to route the packet to reach dest address
    */
   Ptr<Ipv4Route> LookupGlobal (Ipv4Address dest, Ptr<NetDevice> oif = 0);
 
+  /**
+   * \brief Add a route to the index of its destination prefix.
+   * \param routes the kind of the route (host, network or external)
+   * \param route the route
+   */
+  void IndexRoute (PrefixRoutes IndexedRoutes::*routes, Ipv4RoutingTableEntry *route);
+  /**
+   * \brief Remove a route from the index of its destination prefix.
+   * \param routes the kind of the route (host, network or external)
+   * \param route the route
+   */
+  void UnindexRoute (PrefixRoutes IndexedRoutes::*routes, Ipv4RoutingTableEntry *route);
+
   HostRoutes m_hostRoutes;             //!< Routes to hosts
   NetworkRoutes m_networkRoutes;       //!< Routes to networks
   ASExternalRoutes m_ASexternalRoutes; //!< External routes imported
+  RouteIndex m_routeIndex;             //!< All the routes, by destination prefix
 
   Ptr<Ipv4> m_ipv4; //!< associated IPv4 instance
 };
@@ -24,6 +24,7 @@
                 << " [node " << m_ipv4->GetObject<Node> ()->GetId () << "] "; }
 
 #include <iomanip>
+#include <algorithm>
 #include "ns3/log.h"
 #include "ns3/names.h"
 #include "ns3/packet.h"
@@ -40,6 +41,18 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Ipv4StaticRouting");
 
+/**
+ * \param mask a network mask
+ * \return true if the ones of the mask are contiguous, i.e., if the mask is
+ * fully described by its prefix length
+ */
+static bool
+IsContiguousMask (Ipv4Mask mask)
+{
+  uint32_t hostBits = ~mask.Get ();
+  return (hostBits & (hostBits + 1)) == 0;
+}
+
 NS_OBJECT_ENSURE_REGISTERED (Ipv4StaticRouting);
 
 TypeId
@@ -54,7 +67,9 @@ Ipv4StaticRouting::GetTypeId (void)
 }
 
 Ipv4StaticRouting::Ipv4StaticRouting () 
-  : m_ipv4 (0)
+  : m_networkRouteIndex (32),
+    m_nonContiguousRoutes (0),
+    m_ipv4 (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -72,7 +87,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
                                                         networkMask,
                                                         nextHop,
                                                         interface);
-  m_networkRoutes.push_back (make_pair (route,metric));
+  AddNetworkRoute (route, metric);
 }
 
 void 
@@ -86,7 +101,7 @@ Ipv4StaticRouting::AddNetworkRouteTo (Ipv4Address network,
   *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo (network,
                                                         networkMask,
                                                         interface);
-  m_networkRoutes.push_back (make_pair (route,metric));
+  AddNetworkRoute (route, metric);
 }
 
 void 
@@ -143,7 +158,7 @@ Ipv4StaticRouting::SetDefaultMulticastRoute (uint32_t outputInterface)
   *route = Ipv4RoutingTableEntry::CreateNetworkRouteTo (network,
                                                         networkMask,
                                                         outputInterface);
-  m_networkRoutes.push_back (make_pair (route,0));
+  AddNetworkRoute (route, 0);
 }
 
 uint32_t 
@@ -224,8 +239,6 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
 {
   NS_LOG_FUNCTION (this << dest << " " << oif);
   Ptr<Ipv4Route> rtentry = 0;
-  uint16_t longest_mask = 0;
-  uint32_t shortest_metric = 0xffffffff;
   /* when sending on local multicast, there have to be interface specified */
   if (dest.IsLocalMulticast ())
     {
@@ -239,13 +252,62 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
       return rtentry;
     }
 
+  Ipv4RoutingTableEntry *route = 0;
+  if (m_nonContiguousRoutes == 0)
+    {
+      // only the routes towards the longest prefix matching the destination
+      // (and having a route on the requested interface) are candidates
+      uint8_t buf[4];
+      dest.Serialize (buf);
+      std::vector<PrefixRoutes *> matches;
+      m_networkRouteIndex.Lookup (buf, matches);
+      for (std::vector<PrefixRoutes *>::reverse_iterator m = matches.rbegin ();
+           m != matches.rend () && route == 0;
+           m++)
+        {
+          route = SelectRoute (**m, dest, oif);
+        }
+    }
+  else
+    {
+      PrefixRoutes routes;
+      for (NetworkRoutesI i = m_networkRoutes.begin (); 
+           i != m_networkRoutes.end (); 
+           i++) 
+        {
+          routes.push_back (i);
+        }
+      route = SelectRoute (routes, dest, oif);
+    }
+  if (route != 0)
+    {
+      uint32_t interfaceIdx = route->GetInterface ();
+      rtentry = Create<Ipv4Route> ();
+      rtentry->SetDestination (route->GetDest ());
+      rtentry->SetSource (m_ipv4->SourceAddressSelection (interfaceIdx, route->GetDest ()));
+      rtentry->SetGateway (route->GetGateway ());
+      rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
+      NS_LOG_LOGIC ("Matching route via " << rtentry->GetGateway () << " at the end");
+    }
+  else
+    {
+      NS_LOG_LOGIC ("No matching route to " << dest << " found");
+    }
+  return rtentry;
+}
 
-  for (NetworkRoutesI i = m_networkRoutes.begin (); 
-       i != m_networkRoutes.end (); 
+Ipv4RoutingTableEntry *
+Ipv4StaticRouting::SelectRoute (const PrefixRoutes &routes, Ipv4Address dest, Ptr<NetDevice> oif) const
+{
+  Ipv4RoutingTableEntry *selected = 0;
+  uint16_t longest_mask = 0;
+  uint32_t shortest_metric = 0xffffffff;
+  for (PrefixRoutes::const_iterator i = routes.begin (); 
+       i != routes.end (); 
        i++) 
     {
-      Ipv4RoutingTableEntry *j=i->first;
-      uint32_t metric =i->second;
+      Ipv4RoutingTableEntry *j=(*i)->first;
+      uint32_t metric =(*i)->second;
       Ipv4Mask mask = (j)->GetDestNetworkMask ();
       uint16_t masklen = mask.GetPrefixLength ();
       Ipv4Address entry = (j)->GetDestNetwork ();
@@ -277,28 +339,14 @@ Ipv4StaticRouting::LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif)
               continue;
             }
           shortest_metric = metric;
-          Ipv4RoutingTableEntry* route = (j);
-          uint32_t interfaceIdx = route->GetInterface ();
-          rtentry = Create<Ipv4Route> ();
-          rtentry->SetDestination (route->GetDest ());
-          rtentry->SetSource (m_ipv4->SourceAddressSelection (interfaceIdx, route->GetDest ()));
-          rtentry->SetGateway (route->GetGateway ());
-          rtentry->SetOutputDevice (m_ipv4->GetNetDevice (interfaceIdx));
+          selected = j;
           if (masklen == 32)
             {
               break;
             }
         }
     }
-  if (rtentry != 0)
-    {
-      NS_LOG_LOGIC ("Matching route via " << rtentry->GetGateway () << " at the end");
-    }
-  else
-    {
-      NS_LOG_LOGIC ("No matching route to " << dest << " found");
-    }
-  return rtentry;
+  return selected;
 }
 
 Ptr<Ipv4MulticastRoute>
@@ -447,8 +495,7 @@ Ipv4StaticRouting::RemoveRoute (uint32_t index)
     {
       if (tmp == index)
         {
-          delete j->first;
-          m_networkRoutes.erase (j);
+          RemoveNetworkRoute (j);
           return;
         }
       tmp++;
@@ -456,6 +503,47 @@ Ipv4StaticRouting::RemoveRoute (uint32_t index)
   NS_ASSERT (false);
 }
 
+void
+Ipv4StaticRouting::AddNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric)
+{
+  NS_LOG_FUNCTION (this << route << metric);
+  NetworkRoutesI it = m_networkRoutes.insert (m_networkRoutes.end (), make_pair (route, metric));
+  Ipv4Mask mask = route->GetDestNetworkMask ();
+  if (!IsContiguousMask (mask))
+    {
+      m_nonContiguousRoutes++;
+      return;
+    }
+  uint8_t buf[4];
+  route->GetDestNetwork ().Serialize (buf);
+  m_networkRouteIndex.Insert (buf, mask.GetPrefixLength ()).push_back (it);
+}
+
+Ipv4StaticRouting::NetworkRoutesI
+Ipv4StaticRouting::RemoveNetworkRoute (NetworkRoutesI route)
+{
+  NS_LOG_FUNCTION (this << route->first);
+  Ipv4Mask mask = route->first->GetDestNetworkMask ();
+  if (IsContiguousMask (mask))
+    {
+      uint8_t buf[4];
+      route->first->GetDestNetwork ().Serialize (buf);
+      PrefixRoutes *routes = m_networkRouteIndex.Find (buf, mask.GetPrefixLength ());
+      NS_ASSERT (routes != 0);
+      routes->erase (std::find (routes->begin (), routes->end (), route));
+      if (routes->empty ())
+        {
+          m_networkRouteIndex.Remove (buf, mask.GetPrefixLength ());
+        }
+    }
+  else
+    {
+      m_nonContiguousRoutes--;
+    }
+  delete route->first;
+  return m_networkRoutes.erase (route);
+}
+
 Ptr<Ipv4Route> 
 Ipv4StaticRouting::RouteOutput (Ptr<Packet> p, const Ipv4Header &header, Ptr<NetDevice> oif, Socket::SocketErrno &sockerr)
 {
@@ -575,6 +663,8 @@ Ipv4StaticRouting::DoDispose (void)
     {
       delete (j->first);
     }
+  m_networkRouteIndex.Clear ();
+  m_nonContiguousRoutes = 0;
   for (MulticastRoutesI i = m_multicastRoutes.begin (); 
        i != m_multicastRoutes.end (); 
        i = m_multicastRoutes.erase (i)) 
@@ -613,8 +703,7 @@ Ipv4StaticRouting::NotifyInterfaceDown (uint32_t i)
     {
       if (it->first->GetInterface () == i)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
@@ -660,8 +749,7 @@ Ipv4StaticRouting::NotifyRemoveAddress (uint32_t interface, Ipv4InterfaceAddress
           && it->first->GetDestNetwork () == networkAddress
           && it->first->GetDestNetworkMask () == networkMask)
         {
-          delete it->first;
-          it = m_networkRoutes.erase (it);
+          it = RemoveNetworkRoute (it);
         }
       else
         {
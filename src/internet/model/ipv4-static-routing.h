@@ -24,6 +24,7 @@
 
 #include <list>
 #include <utility>
+#include <vector>
 #include <stdint.h>
 #include "ns3/ipv4-address.h"
 #include "ns3/ipv4-header.h"
@@ -31,6 +32,7 @@
 #include "ns3/ptr.h"
 #include "ns3/ipv4.h"
 #include "ns3/ipv4-routing-protocol.h"
+#include "ns3/route-prefix-trie.h"
 
 namespace ns3 {
 
@@ -395,14 +397,47 @@ private:
   /// Iterator for container for the multicast routes
   typedef std::list<Ipv4MulticastRoutingTableEntry *>::iterator MulticastRoutesI;
 
+  /// Network routes towards the same prefix, in the order of the routing table
+  typedef std::vector<NetworkRoutesI> PrefixRoutes;
+
   /**
    * \brief Lookup in the forwarding table for destination.
+   *
+   * The route with the longest prefix matching the destination is used.
+   * Among the routes with the same prefix, the one with the lowest metric
+   * is used, the last one added winning ties, except for the host routes
+   * where the first one added is used.
+   *
    * \param dest destination address
    * \param oif output interface if any (put 0 otherwise)
    * \return Ipv4Route to route the packet to reach dest address
    */
   Ptr<Ipv4Route> LookupStatic (Ipv4Address dest, Ptr<NetDevice> oif = 0);
 
+  /**
+   * \brief Select a route among the given network routes, as described in
+   * LookupStatic.
+   * \param routes the routes, in the order of the routing table
+   * \param dest destination address
+   * \param oif output interface if any (put 0 otherwise)
+   * \return the route to use to reach dest address, or 0 if none
+   */
+  Ipv4RoutingTableEntry * SelectRoute (const PrefixRoutes &routes, Ipv4Address dest, Ptr<NetDevice> oif) const;
+
+  /**
+   * \brief Add a network route at the end of the forwarding table.
+   * \param route the route
+   * \param metric metric of the route
+   */
+  void AddNetworkRoute (Ipv4RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove a network route from the forwarding table, and delete it.
+   * \param route the route
+   * \return the route following the removed one
+   */
+  NetworkRoutesI RemoveNetworkRoute (NetworkRoutesI route);
+
   /**
    * \brief Lookup in the multicast forwarding table for destination.
    * \param origin source address
@@ -418,6 +453,19 @@ private:
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the network routes indexed by destination prefix.
+   */
+  RoutePrefixTrie<PrefixRoutes> m_networkRouteIndex;
+
+  /**
+   * \brief the number of network routes whose mask is not contiguous.
+   *
+   * Such routes cannot be indexed by prefix, hence the whole forwarding
+   * table is searched as long as there is one.
+   */
+  uint32_t m_nonContiguousRoutes;
+
   /**
    * \brief the forwarding table for multicast.
    */
@@ -24,12 +24,14 @@
 #include <stdint.h>
 
 #include <list>
+#include <vector>
 
 #include "ns3/ptr.h"
 #include "ns3/ipv6-address.h"
 #include "ns3/ipv6.h"
 #include "ns3/ipv6-header.h"
 #include "ns3/ipv6-routing-protocol.h"
+#include "ns3/route-prefix-trie.h"
 
 namespace ns3 {
 
@@ -264,14 +266,47 @@ private:
   /// Iterator for container for the multicast routes
   typedef std::list<Ipv6MulticastRoutingTableEntry *>::iterator MulticastRoutesI;
 
+  /// Network routes towards the same prefix, in the order of the routing table
+  typedef std::vector<NetworkRoutesI> PrefixRoutes;
+
   /**
    * \brief Lookup in the forwarding table for destination.
+   *
+   * The route with the longest prefix matching the destination is used.
+   * Among the routes with the same prefix, the one with the lowest metric
+   * is used, the last one added winning ties, except for the host routes
+   * where the first one added is used.
+   *
    * \param dest destination address
    * \param interface output interface if any (put 0 otherwise)
    * \return Ipv6Route to route the packet to reach dest address
    */
   Ptr<Ipv6Route> LookupStatic (Ipv6Address dest, Ptr<NetDevice> = 0);
 
+  /**
+   * \brief Select a route among the given network routes, as described in
+   * LookupStatic.
+   * \param routes the routes, in the order of the routing table
+   * \param dest destination address
+   * \param interface output interface if any (put 0 otherwise)
+   * \return the route to use to reach dest address, or 0 if none
+   */
+  Ipv6RoutingTableEntry * SelectRoute (const PrefixRoutes &routes, Ipv6Address dest, Ptr<NetDevice> interface) const;
+
+  /**
+   * \brief Add a network route at the end of the forwarding table.
+   * \param route the route
+   * \param metric metric of the route
+   */
+  void AddNetworkRoute (Ipv6RoutingTableEntry *route, uint32_t metric);
+
+  /**
+   * \brief Remove a network route from the forwarding table, and delete it.
+   * \param route the route
+   * \return the route following the removed one
+   */
+  NetworkRoutesI RemoveNetworkRoute (NetworkRoutesI route);
+
   /**
    * \brief Lookup in the multicast forwarding table for destination.
    * \param origin source address
@@ -286,6 +321,19 @@ private:
    */
   NetworkRoutes m_networkRoutes;
 
+  /**
+   * \brief the network routes indexed by destination prefix.
+   */
+  RoutePrefixTrie<PrefixRoutes> m_networkRouteIndex;
+
+  /**
+   * \brief the number of network routes whose prefix is not contiguous.
+   *
+   * Such routes cannot be indexed by prefix, hence the whole forwarding
+   * table is searched as long as there is one.
+   */
+  uint32_t m_nonContiguousRoutes;
+
   /**
    * \brief the forwarding table for multicast.
    */
@@ -0,0 +1,378 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ROUTE_PREFIX_TRIE_H
+#define ROUTE_PREFIX_TRIE_H
+
+#include <stdint.h>
+#include <string.h>
+#include <vector>
+#include "ns3/assert.h"
+
+namespace ns3 {
+
+/**
+ * \ingroup internet
+ *
+ * \brief Path-compressed binary trie (radix tree) of address prefixes,
+ * used to index the routes of the routing protocols by destination.
+ *
+ * Each prefix of the trie is associated with a value of type T (typically
+ * the list of the routes towards that prefix). The addresses are given as
+ * byte arrays in network order (as written by Ipv4Address::Serialize or
+ * Ipv6Address::GetBytes), of the length given to the constructor, and the
+ * prefixes by their address and their length in bits.
+ *
+ * The nodes of the trie only exist for the prefixes inserted and for the
+ * branching points between them, so that a lookup visits at most one node
+ * per prefix matching the address, whatever the number of prefixes stored.
+ */
+template <typename T>
+class RoutePrefixTrie
+{
+public:
+  /**
+   * \brief Constructor
+   * \param addressBits the length of the addresses in bits (32 for IPv4,
+   * 128 for IPv6)
+   */
+  RoutePrefixTrie (uint8_t addressBits);
+  ~RoutePrefixTrie ();
+
+  /**
+   * \brief Get the value of a prefix, inserting a default-constructed value
+   * if the prefix is not in the trie yet.
+   * \param address the address bytes
+   * \param length the prefix length in bits
+   * \return the value of the prefix
+   */
+  T & Insert (const uint8_t *address, uint8_t length);
+  /**
+   * \brief Get the value of a prefix.
+   * \param address the address bytes
+   * \param length the prefix length in bits
+   * \return the value of the prefix, or 0 if the prefix is not in the trie
+   */
+  T * Find (const uint8_t *address, uint8_t length) const;
+  /**
+   * \brief Remove a prefix and its value.
+   * \param address the address bytes
+   * \param length the prefix length in bits
+   * \return true if the prefix was in the trie
+   */
+  bool Remove (const uint8_t *address, uint8_t length);
+  /**
+   * \brief Get the values of all the prefixes matching an address.
+   *
+   * The values are appended from the shortest to the longest prefix, so that
+   * the value of the longest matching prefix is the last one.
+   *
+   * \param address the address bytes
+   * \param matches the vector to which the values are appended
+   */
+  void Lookup (const uint8_t *address, std::vector<T *> &matches) const;
+  /**
+   * \brief Remove all the prefixes.
+   */
+  void Clear (void);
+  /**
+   * \return the number of prefixes in the trie
+   */
+  uint32_t GetSize (void) const;
+
+private:
+  /// A node of the trie
+  struct Node
+  {
+    /**
+     * \brief Constructor
+     * \param address the address bytes
+     * \param length the prefix length in bits
+     */
+    Node (const uint8_t *address, uint8_t length);
+    uint8_t prefix[16];  //!< prefix bytes, the bits beyond the length being zero
+    uint8_t length;      //!< prefix length in bits
+    bool hasValue;       //!< whether the prefix was inserted (or is only a branching point)
+    T value;             //!< value of the prefix
+    Node *child[2];      //!< children, by the value of the bit following the prefix
+  };
+
+  /// Copy constructor (disabled)
+  RoutePrefixTrie (const RoutePrefixTrie &);
+  /**
+   * \brief Assignment operator (disabled)
+   * \return the trie
+   */
+  RoutePrefixTrie & operator= (const RoutePrefixTrie &);
+
+  /**
+   * \param address the address bytes
+   * \param index the bit index, starting from the most significant bit
+   * \return the value of the bit
+   */
+  static uint8_t GetBit (const uint8_t *address, uint8_t index);
+  /**
+   * \param a the first address bytes
+   * \param b the second address bytes
+   * \param length the number of bits to compare
+   * \return the number of leading bits common to both addresses, at most length
+   */
+  static uint8_t GetCommonLength (const uint8_t *a, const uint8_t *b, uint8_t length);
+  /**
+   * \brief Delete a node and its descendants.
+   * \param node the node
+   */
+  static void Delete (Node *node);
+
+  Node *m_root;          //!< root of the trie
+  uint8_t m_addressBits; //!< address length in bits
+  uint32_t m_size;       //!< number of prefixes
+};
+
+template <typename T>
+RoutePrefixTrie<T>::Node::Node (const uint8_t *address, uint8_t length)
+  : length (length),
+    hasValue (false),
+    value ()
+{
+  memset (prefix, 0, sizeof (prefix));
+  memcpy (prefix, address, (length + 7) / 8);
+  if (length % 8)
+    {
+      prefix[length / 8] &= static_cast<uint8_t> (0xff << (8 - length % 8));
+    }
+  child[0] = 0;
+  child[1] = 0;
+}
+
+template <typename T>
+RoutePrefixTrie<T>::RoutePrefixTrie (uint8_t addressBits)
+  : m_root (0),
+    m_addressBits (addressBits),
+    m_size (0)
+{
+  NS_ASSERT (addressBits > 0 && addressBits <= 128);
+}
+
+template <typename T>
+RoutePrefixTrie<T>::~RoutePrefixTrie ()
+{
+  Clear ();
+}
+
+template <typename T>
+uint8_t
+RoutePrefixTrie<T>::GetBit (const uint8_t *address, uint8_t index)
+{
+  return (address[index / 8] >> (7 - index % 8)) & 1;
+}
+
+template <typename T>
+uint8_t
+RoutePrefixTrie<T>::GetCommonLength (const uint8_t *a, const uint8_t *b, uint8_t length)
+{
+  uint8_t common = 0;
+  while (common < length)
+    {
+      uint8_t diff = a[common / 8] ^ b[common / 8];
+      if (diff == 0)
+        {
+          common += 8 - common % 8;
+          continue;
+        }
+      // common is a multiple of 8 here, count the leading equal bits
+      while (!(diff & 0x80))
+        {
+          diff <<= 1;
+          common++;
+        }
+      break;
+    }
+  return common < length ? common : length;
+}
+
+template <typename T>
+void
+RoutePrefixTrie<T>::Delete (Node *node)
+{
+  if (node)
+    {
+      Delete (node->child[0]);
+      Delete (node->child[1]);
+      delete node;
+    }
+}
+
+template <typename T>
+T &
+RoutePrefixTrie<T>::Insert (const uint8_t *address, uint8_t length)
+{
+  NS_ASSERT (length <= m_addressBits);
+  Node **link = &m_root;
+  Node *found = 0;
+  while (found == 0)
+    {
+      Node *node = *link;
+      if (node == 0)
+        {
+          found = new Node (address, length);
+          *link = found;
+          break;
+        }
+      uint8_t common = GetCommonLength (node->prefix, address,
+                                        node->length < length ? node->length : length);
+      if (common == node->length)
+        {
+          if (node->length == length)
+            {
+              found = node;
+            }
+          else
+            {
+              // the node prefix is a prefix of the inserted one, go down
+              link = &node->child[GetBit (address, node->length)];
+            }
+          continue;
+        }
+      // the inserted prefix diverges from the node prefix, or is shorter:
+      // insert a node above the current one
+      Node *parent = new Node (address, common);
+      parent->child[GetBit (node->prefix, common)] = node;
+      *link = parent;
+      if (common == length)
+        {
+          found = parent;
+        }
+      else
+        {
+          found = new Node (address, length);
+          parent->child[GetBit (address, common)] = found;
+        }
+    }
+  if (!found->hasValue)
+    {
+      found->hasValue = true;
+      m_size++;
+    }
+  return found->value;
+}
+
+template <typename T>
+T *
+RoutePrefixTrie<T>::Find (const uint8_t *address, uint8_t length) const
+{
+  Node *node = m_root;
+  while (node && node->length <= length)
+    {
+      if (GetCommonLength (node->prefix, address, node->length) != node->length)
+        {
+          return 0;
+        }
+      if (node->length == length)
+        {
+          return node->hasValue ? &node->value : 0;
+        }
+      node = node->child[GetBit (address, node->length)];
+    }
+  return 0;
+}
+
+template <typename T>
+bool
+RoutePrefixTrie<T>::Remove (const uint8_t *address, uint8_t length)
+{
+  Node **link = &m_root;
+  Node **parentLink = 0;
+  while (*link && (*link)->length < length)
+    {
+      Node *node = *link;
+      if (GetCommonLength (node->prefix, address, node->length) != node->length)
+        {
+          return false;
+        }
+      parentLink = link;
+      link = &node->child[GetBit (address, node->length)];
+    }
+  Node *node = *link;
+  if (node == 0 || node->length != length || !node->hasValue
+      || GetCommonLength (node->prefix, address, length) != length)
+    {
+      return false;
+    }
+  node->hasValue = false;
+  node->value = T ();
+  m_size--;
+  // remove the nodes which are no longer needed as branching points
+  if (node->child[0] && node->child[1])
+    {
+      return true;
+    }
+  *link = node->child[0] ? node->child[0] : node->child[1];
+  delete node;
+  if (parentLink)
+    {
+      Node *parent = *parentLink;
+      if (!parent->hasValue && !(parent->child[0] && parent->child[1]))
+        {
+          *parentLink = parent->child[0] ? parent->child[0] : parent->child[1];
+          delete parent;
+        }
+    }
+  return true;
+}
+
+template <typename T>
+void
+RoutePrefixTrie<T>::Lookup (const uint8_t *address, std::vector<T *> &matches) const
+{
+  Node *node = m_root;
+  while (node)
+    {
+      if (GetCommonLength (node->prefix, address, node->length) != node->length)
+        {
+          return;
+        }
+      if (node->hasValue)
+        {
+          matches.push_back (&node->value);
+        }
+      if (node->length == m_addressBits)
+        {
+          return;
+        }
+      node = node->child[GetBit (address, node->length)];
+    }
+}
+
+template <typename T>
+void
+RoutePrefixTrie<T>::Clear (void)
+{
+  Delete (m_root);
+  m_root = 0;
+  m_size = 0;
+}
+
+template <typename T>
+uint32_t
+RoutePrefixTrie<T>::GetSize (void) const
+{
+  return m_size;
+}
+
+} // namespace ns3
+
+#endif /* ROUTE_PREFIX_TRIE_H */
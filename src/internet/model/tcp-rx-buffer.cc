@@ -51,7 +51,8 @@ TcpRxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpRxBuffer::TcpRxBuffer (uint32_t n)
-  : m_nextRxSeq (n), m_gotFin (false), m_size (0), m_maxBuffer (32768), m_availBytes (0)
+  : m_nextRxSeq (n), m_gotFin (false), m_size (0), m_maxBuffer (32768), m_availBytes (0),
+    m_inOrderSeq (n)
 {
 }
 
@@ -113,9 +114,9 @@ TcpRxBuffer::MaxRxSequence (void) const
     { // No data allowed beyond FIN
       return m_finSeq;
     }
-  else if (m_data.size () && m_nextRxSeq > m_data.begin ()->first)
+  else if (!m_inOrder.empty ())
     { // No data allowed beyond Rx window allowed
-      return m_data.begin ()->first + SequenceNumber32 (m_maxBuffer);
+      return m_inOrderSeq + SequenceNumber32 (m_maxBuffer);
     }
   return m_nextRxSeq + SequenceNumber32 (m_maxBuffer);
 }
@@ -149,15 +150,23 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
 
   // Trim packet to fit Rx window specification
   if (headSeq < m_nextRxSeq) headSeq = m_nextRxSeq;
-  if (m_data.size ())
+  if (!m_inOrder.empty () || !m_outOfOrder.empty ())
     {
-      SequenceNumber32 maxSeq = m_data.begin ()->first + SequenceNumber32 (m_maxBuffer);
+      SequenceNumber32 firstSeq = m_inOrder.empty () ? m_outOfOrder.begin ()->first : m_inOrderSeq;
+      SequenceNumber32 maxSeq = firstSeq + SequenceNumber32 (m_maxBuffer);
       if (maxSeq < tailSeq) tailSeq = maxSeq;
       if (tailSeq < headSeq) headSeq = tailSeq;
     }
-  // Remove overlapped bytes from packet
-  BufIterator i = m_data.begin ();
-  while (i != m_data.end () && i->first <= tailSeq)
+  // Remove overlapped bytes from packet. The in-order data ends before
+  // m_nextRxSeq, and the out-of-order segments are disjoint: only the last
+  // one starting at or before headSeq, and the following ones, can overlap
+  // with the incoming packet.
+  BufIterator i = m_outOfOrder.upper_bound (headSeq);
+  if (i != m_outOfOrder.begin ())
+    {
+      --i;
+    }
+  while (i != m_outOfOrder.end () && i->first <= tailSeq)
     {
       SequenceNumber32 lastByteSeq = i->first + SequenceNumber32 (i->second->GetSize ());
       if (lastByteSeq > headSeq)
@@ -165,7 +174,7 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
           if (i->first > headSeq && lastByteSeq < tailSeq)
             { // Rare case: Existing packet is embedded fully in the new packet
               m_size -= i->second->GetSize ();
-              m_data.erase (i++);
+              m_outOfOrder.erase (i++);
               continue;
             }
           if (i->first <= headSeq)
@@ -192,32 +201,39 @@ TcpRxBuffer::Add (Ptr<Packet> p, TcpHeader const& tcph)
       p = p->CreateFragment (start, length);
       NS_ASSERT (length == p->GetSize ());
     }
-  // Insert packet into buffer
-  NS_ASSERT (m_data.find (headSeq) == m_data.end ()); // Shouldn't be there yet
-  m_data [ headSeq ] = p;
-
+  NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
+  m_size += p->GetSize ();      // Occupancy
   if (headSeq > m_nextRxSeq)
     {
+      // Insert packet into the out-of-order data
+      NS_ASSERT (m_outOfOrder.find (headSeq) == m_outOfOrder.end ()); // Shouldn't be there yet
+      m_outOfOrder[headSeq] = p;
       // Generate a new SACK block
       UpdateSackList (headSeq, tailSeq);
     }
-
-  NS_LOG_LOGIC ("Buffered packet of seqno=" << headSeq << " len=" << p->GetSize ());
-  // Update variables
-  m_size += p->GetSize ();      // Occupancy
-  for (i = m_data.begin (); i != m_data.end (); ++i)
+  else
     {
-      if (i->first < m_nextRxSeq)
+      // Append the packet, then the out-of-order segments it made
+      // contiguous, to the in-order data
+      NS_ASSERT (headSeq == m_nextRxSeq);
+      if (m_inOrder.empty ())
         {
-          continue;
+          m_inOrderSeq = headSeq;
         }
-      else if (i->first > m_nextRxSeq)
+      while (p != 0)
         {
-          break;
-        };
-      m_nextRxSeq = i->first + SequenceNumber32 (i->second->GetSize ());
-      m_availBytes += i->second->GetSize ();
-      ClearSackList (m_nextRxSeq);
+          m_inOrder.push_back (p);
+          m_nextRxSeq = m_nextRxSeq + SequenceNumber32 (p->GetSize ());
+          m_availBytes += p->GetSize ();
+          ClearSackList (m_nextRxSeq);
+          p = 0;
+          i = m_outOfOrder.begin ();
+          if (i != m_outOfOrder.end () && i->first == m_nextRxSeq)
+            {
+              p = i->second;
+              m_outOfOrder.erase (i);
+            }
+        }
     }
   NS_LOG_LOGIC ("Updated buffer occupancy=" << m_size << " nextRxSeq=" << m_nextRxSeq);
   if (m_gotFin && m_nextRxSeq == m_finSeq)
@@ -368,40 +384,57 @@ TcpRxBuffer::Extract (uint32_t maxSize)
   uint32_t extractSize = std::min (maxSize, m_availBytes);
   NS_LOG_LOGIC ("Requested to extract " << extractSize << " bytes from TcpRxBuffer of size=" << m_size);
   if (extractSize == 0) return nullptr;  // No contiguous block to return
-  NS_ASSERT (m_data.size ()); // At least we have something to extract
-  Ptr<Packet> outPkt = Create<Packet> (); // The packet that contains all the data to return
-  BufIterator i;
+  NS_ASSERT (!m_inOrder.empty ()); // At least we have something to extract
+  Ptr<Packet> outPkt = nullptr; // The packet that contains all the data to return
   while (extractSize)
     { // Check the buffered data for delivery
-      i = m_data.begin ();
-      NS_ASSERT (i->first <= m_nextRxSeq); // in-sequence data expected
+      Ptr<Packet> head = m_inOrder.front ();
       // Check if we send the whole pkt or just a partial
-      uint32_t pktSize = i->second->GetSize ();
+      uint32_t pktSize = head->GetSize ();
       if (pktSize <= extractSize)
         { // Whole packet is extracted
-          outPkt->AddAtEnd (i->second);
-          m_data.erase (i);
+          if (outPkt == nullptr && pktSize == extractSize)
+            {
+              // The buffer owns the stored packets: hand the only one
+              // extracted over, without copying it into an empty packet
+              outPkt = head;
+              outPkt->RemoveAllPacketTags ();
+            }
+          else
+            {
+              if (outPkt == nullptr)
+                {
+                  outPkt = Create<Packet> ();
+                }
+              outPkt->AddAtEnd (head);
+            }
+          m_inOrder.pop_front ();
+          m_inOrderSeq = m_inOrderSeq + SequenceNumber32 (pktSize);
           m_size -= pktSize;
           m_availBytes -= pktSize;
           extractSize -= pktSize;
         }
       else
         { // Partial is extracted and done
-          outPkt->AddAtEnd (i->second->CreateFragment (0, extractSize));
-          m_data[i->first + SequenceNumber32 (extractSize)] = i->second->CreateFragment (extractSize, pktSize - extractSize);
-          m_data.erase (i);
+          if (outPkt == nullptr)
+            {
+              outPkt = Create<Packet> ();
+            }
+          outPkt->AddAtEnd (head->CreateFragment (0, extractSize));
+          m_inOrder.front () = head->CreateFragment (extractSize, pktSize - extractSize);
+          m_inOrderSeq = m_inOrderSeq + SequenceNumber32 (extractSize);
           m_size -= extractSize;
           m_availBytes -= extractSize;
           extractSize = 0;
         }
     }
-  if (outPkt->GetSize () == 0)
+  if (outPkt == nullptr || outPkt->GetSize () == 0)
     {
       NS_LOG_LOGIC ("Nothing extracted.");
       return nullptr;
     }
   NS_LOG_LOGIC ("Extracted " << outPkt->GetSize ( ) << " bytes, bufsize=" << m_size
-                             << ", num pkts in buffer=" << m_data.size ());
+                             << ", num pkts in buffer=" << m_inOrder.size () + m_outOfOrder.size ());
   return outPkt;
 }
 
@@ -21,6 +21,7 @@
 #ifndef TCP_RX_BUFFER_H
 #define TCP_RX_BUFFER_H
 
+#include <deque>
 #include <map>
 #include "ns3/traced-value.h"
 #include "ns3/trace-source-accessor.h"
@@ -53,6 +54,13 @@ class Packet;
  * To store data, use Add; for retrieving a certain amount of ordered data, use
  * the method Extract.
  *
+ * The in-order data (i.e., the data that can be extracted) is kept as a FIFO
+ * of the received segments, while the out-of-order data is kept as a set of
+ * disjoint segments indexed by their first sequence number, so that both
+ * Add and Extract only look at the segments they modify. The segments are
+ * stored as packets (possibly fragments of the received ones), hence their
+ * byte tags are delivered to the application along with the data.
+ *
  * SACK list
  * ---------
  *
@@ -153,6 +161,14 @@ public:
    * Extract data from the head of the buffer as indicated by nextRxSeq.
    * The extracted data is going to be forwarded to the application.
    *
+   * If the extracted data is exactly one stored segment, that segment is
+   * returned as is: the packet keeps the uid and the metadata of the
+   * received packet it was stored from. Otherwise, the extracted segments
+   * are appended to a new packet, which takes the uid of the first segment
+   * if the packet metadata is enabled (see Packet::AddAtEnd). In both
+   * cases, the byte tags of the segments are kept and the packet tags are
+   * removed.
+   *
    * \param maxSize maximum number of bytes to extract
    * \returns a packet
    */
@@ -217,7 +233,7 @@ private:
 
   TcpOptionSack::SackList m_sackList; //!< Sack list (updated constantly)
 
-  /// container for data stored in the buffer
+  /// container for the out-of-order data stored in the buffer
   typedef std::map<SequenceNumber32, Ptr<Packet> >::iterator BufIterator;
   TracedValue<SequenceNumber32> m_nextRxSeq; //!< Seqnum of the first missing byte in data (RCV.NXT)
   SequenceNumber32 m_finSeq;                 //!< Seqnum of the FIN packet
@@ -225,7 +241,9 @@ private:
   uint32_t m_size;                           //!< Number of total data bytes in the buffer, not necessarily contiguous
   uint32_t m_maxBuffer;                      //!< Upper bound of the number of data bytes in buffer (RCV.WND)
   uint32_t m_availBytes;                     //!< Number of bytes available to read, i.e. contiguous block at head
-  std::map<SequenceNumber32, Ptr<Packet> > m_data; //!< Corresponding data (may be null)
+  SequenceNumber32 m_inOrderSeq;             //!< Seqnum of the first byte of the in-order data
+  std::deque<Ptr<Packet> > m_inOrder;        //!< In-order segments, holding m_availBytes bytes
+  std::map<SequenceNumber32, Ptr<Packet> > m_outOfOrder; //!< Disjoint out-of-order segments, indexed by their first seqnum
 };
 
 } //namespace ns3
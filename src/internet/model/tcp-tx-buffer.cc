@@ -58,7 +58,8 @@ TcpTxBuffer::GetTypeId (void)
  * initialized below is insignificant.
  */
 TcpTxBuffer::TcpTxBuffer (uint32_t n)
-  : m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n)
+  : m_lostBoundary (n), m_lostEnd (n), m_nextSegHint (n),
+    m_maxBuffer (32768), m_size (0), m_sentSize (0), m_firstByteSeq (n)
 {
 }
 
@@ -161,6 +162,8 @@ TcpTxBuffer::SetHeadSequence (const SequenceNumber32& seq)
   // if you change the head with data already sent, something bad will happen
   NS_ASSERT (m_sentList.size () == 0);
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_lostEnd = seq;
+  ResetScoreboardHints ();
 }
 
 bool
@@ -283,9 +286,15 @@ TcpTxBuffer::GetNewSegment (uint32_t numBytes)
   NS_ASSERT (it != m_appList.end ());
 
   m_appList.erase (it);
-  m_sentList.insert (m_sentList.end (), item);
+  IndexSentItem (m_sentList.insert (m_sentList.end (), item));
   m_sentSize += item->m_packet->GetSize ();
 
+  if (item->m_lost && m_lostEnd < startOfAppList + m_sentSize)
+    {
+      // Sent again after ResetLastSegmentSent
+      m_lostEnd = startOfAppList + m_sentSize;
+    }
+
   return item;
 }
 
@@ -297,36 +306,33 @@ TcpTxBuffer::GetTransmittedSegment (uint32_t numBytes, const SequenceNumber32 &s
   NS_ASSERT (numBytes <= m_sentSize);
   NS_ASSERT (m_sentList.size () >= 1);
 
-  auto it = m_sentList.begin ();
   bool listEdited = false;
   uint32_t s = numBytes;
 
   // Avoid to merge different packet for this retransmission if flags are
   // different.
-  for (; it != m_sentList.end(); ++it)
+  SentIndex::const_iterator entry = m_sentIndex.find (seq);
+  if (entry != m_sentIndex.end ())
     {
-      if ((*it)->m_startSeq == seq)
+      PacketList::iterator it = entry->second;
+      auto next = it;
+      next++;
+      if (next != m_sentList.end ())
         {
-          auto next = it;
-          next++;
-          if (next != m_sentList.end ())
+          // Next is not sacked... there is the possibility to merge
+          if (! (*next)->m_sacked)
             {
-              // Next is not sacked... there is the possibility to merge
-              if (! (*next)->m_sacked)
-                {
-                  s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
-                }
-              else
-                {
-                  // Next is sacked... better to retransmit only the first segment
-                  s = std::min(s, (*it)->m_packet->GetSize ());
-                }
+              s = std::min(s, (*it)->m_packet->GetSize () + (*next)->m_packet->GetSize ());
             }
           else
             {
+              // Next is sacked... better to retransmit only the first segment
               s = std::min(s, (*it)->m_packet->GetSize ());
             }
-          break;
+        }
+      else
+        {
+          s = std::min(s, (*it)->m_packet->GetSize ());
         }
     }
 
@@ -363,6 +369,89 @@ TcpTxBuffer::FindHighestSacked () const
   return ret;
 }
 
+TcpTxBuffer::SentIndex::const_iterator
+TcpTxBuffer::FindSentItem (const SequenceNumber32 &seq) const
+{
+  SentIndex::const_iterator entry = m_sentIndex.upper_bound (seq);
+  if (entry != m_sentIndex.begin ())
+    {
+      --entry;
+    }
+  return entry;
+}
+
+void
+TcpTxBuffer::IndexSentItem (PacketList::iterator it)
+{
+  m_sentIndex[(*it)->m_startSeq] = it;
+}
+
+void
+TcpTxBuffer::AddSackedRange (const TcpTxItem *item)
+{
+  SequenceNumber32 start = item->m_startSeq;
+  SequenceNumber32 end = start + item->m_packet->GetSize ();
+
+  // Merge with the ranges which touch the new one
+  SackedRanges::iterator it = m_sackedRanges.upper_bound (start);
+  if (it != m_sackedRanges.begin ())
+    {
+      --it;
+    }
+  while (it != m_sackedRanges.end () && it->first <= end)
+    {
+      if (it->second < start)
+        {
+          ++it;
+          continue;
+        }
+      start = std::min (start, it->first);
+      end = std::max (end, it->second);
+      it = m_sackedRanges.erase (it);
+    }
+  m_sackedRanges[start] = end;
+}
+
+void
+TcpTxBuffer::RemoveSackedRange (const TcpTxItem *item)
+{
+  SequenceNumber32 start = item->m_startSeq;
+  SequenceNumber32 end = start + item->m_packet->GetSize ();
+
+  SackedRanges::iterator it = m_sackedRanges.upper_bound (start);
+  if (it != m_sackedRanges.begin ())
+    {
+      --it;
+    }
+  while (it != m_sackedRanges.end () && it->first < end)
+    {
+      SequenceNumber32 rangeStart = it->first;
+      SequenceNumber32 rangeEnd = it->second;
+      if (rangeEnd <= start)
+        {
+          ++it;
+          continue;
+        }
+      it = m_sackedRanges.erase (it);
+      if (rangeStart < start)
+        {
+          m_sackedRanges[rangeStart] = start;
+        }
+      if (end < rangeEnd)
+        {
+          m_sackedRanges[end] = rangeEnd;
+          break;
+        }
+    }
+}
+
+void
+TcpTxBuffer::ResetScoreboardHints ()
+{
+  m_lostBoundary = m_firstByteSeq;
+  m_nextSegHint = m_firstByteSeq;
+}
+
 
 void
 TcpTxBuffer::SplitItems (TcpTxItem *t1, TcpTxItem *t2, uint32_t size) const
@@ -424,11 +513,25 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
   PacketList::iterator it = list.begin ();
   SequenceNumber32 beginOfCurrentPacket = listStartFrom;
 
+  // The items of the SentList are indexed: start from the one containing seq,
+  // and keep the index in sync with the fragments and merges below.
+  TcpTxBuffer *self = nullptr;
+  if (&list == &m_sentList)
+    {
+      self = const_cast<TcpTxBuffer*> (this);
+      SentIndex::const_iterator entry = FindSentItem (seq);
+      if (entry != m_sentIndex.end () && entry->first <= seq)
+        {
+          it = entry->second;
+          beginOfCurrentPacket = entry->first;
+        }
+    }
+
   while (it != list.end ())
     {
       currentItem = *it;
       currentPacket = currentItem->m_packet;
-      NS_ASSERT_MSG (list != m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
+      NS_ASSERT_MSG (&list != &m_sentList || currentItem->m_startSeq >= m_firstByteSeq,
                      "start: " << m_firstByteSeq << " currentItem start: " <<
                      currentItem->m_startSeq);
 
@@ -458,7 +561,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, seq - beginOfCurrentPacket);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstPartIt = list.insert (it, firstPart);
+              if (self != nullptr)
+                {
+                  self->IndexSentItem (firstPartIt);
+                  self->IndexSentItem (it);
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -505,6 +613,11 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
                   TcpTxItem *previous = *(--it);
 
                   list.erase (it);
+                  if (self != nullptr)
+                    {
+                      self->m_sentIndex.erase (currentItem->m_startSeq);
+                      self->m_nextSegHint = std::min (m_nextSegHint, previous->m_startSeq);
+                    }
 
                   MergeItems (previous, currentItem);
                   delete currentItem;
@@ -524,7 +637,12 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
               SplitItems (firstPart, currentItem, numBytes);
 
               // insert firstPart before currentItem
-              list.insert (it, firstPart);
+              PacketList::iterator firstPartIt = list.insert (it, firstPart);
+              if (self != nullptr)
+                {
+                  self->IndexSentItem (firstPartIt);
+                  self->IndexSentItem (it);
+                }
               if (listEdited)
                 {
                   *listEdited = true;
@@ -554,6 +672,11 @@ TcpTxBuffer::GetPacketFromList (PacketList &list, const SequenceNumber32 &listSt
 
           MergeItems (currentItem, next);
           list.erase (it);
+          if (self != nullptr)
+            {
+              self->m_sentIndex.erase (next->m_startSeq);
+              self->m_nextSegHint = std::min (m_nextSegHint, currentItem->m_startSeq);
+            }
 
           delete next;
 
@@ -683,6 +806,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
 
           RemoveFromCounts (item, pktSize);
 
+          m_sentIndex.erase (item->m_startSeq);
           i = m_sentList.erase (i);
           NS_LOG_INFO ("Removed " << *item << " lost: " << m_lostOut <<
                        " retrans: " << m_retrans << " sacked: " << m_sackedOut <<
@@ -702,7 +826,9 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           NS_LOG_INFO (*item);
           // PacketTags are preserved when fragmenting
           item->m_packet = item->m_packet->CreateFragment (offset, pktSize);
+          m_sentIndex.erase (item->m_startSeq);
           item->m_startSeq += offset;
+          IndexSentItem (i);
           m_size -= offset;
           m_sentSize -= offset;
           m_firstByteSeq += offset;
@@ -721,6 +847,18 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
       m_firstByteSeq = seq;
     }
 
+  // Forget the sacked ranges which have been acknowledged
+  while (!m_sackedRanges.empty () && m_sackedRanges.begin ()->first < m_firstByteSeq)
+    {
+      SequenceNumber32 end = m_sackedRanges.begin ()->second;
+      m_sackedRanges.erase (m_sackedRanges.begin ());
+      if (end > m_firstByteSeq)
+        {
+          m_sackedRanges[m_firstByteSeq] = end;
+          break;
+        }
+    }
+
   if (!m_sentList.empty ())
     {
       TcpTxItem *head = m_sentList.front ();
@@ -732,6 +870,7 @@ TcpTxBuffer::DiscardUpTo (const SequenceNumber32& seq,
           // when adding Reno dupacks in the count.
           head->m_sacked = false;
           m_sackedOut -= head->m_packet->GetSize ();
+          RemoveSackedRange (head);
           NS_LOG_INFO ("Moving the SACK flag from the HEAD to another segment");
           AddRenoSack ();
           MarkHeadAsLost ();
@@ -766,19 +905,52 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
 
   for (auto option_it = list.begin (); option_it != list.end (); ++option_it)
     {
-      PacketList::iterator item_it = m_sentList.begin ();
-      SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-
       if (m_firstByteSeq + m_sentSize < (*option_it).first)
         {
           NS_LOG_INFO ("Not updating scoreboard, the option block is outside the sent list");
           return bytesSacked;
         }
 
+      // Start from the first item beginning inside the block: the items
+      // before it cannot be sacked by the block
+      SentIndex::const_iterator entry = m_sentIndex.lower_bound ((*option_it).first);
+      if (entry == m_sentIndex.end ())
+        {
+          continue;
+        }
+      PacketList::iterator item_it = entry->second;
+      SequenceNumber32 beginOfCurrentPacket = entry->first;
+
       while (item_it != m_sentList.end ())
         {
           uint32_t pktSize = (*item_it)->m_packet->GetSize ();
 
+          if ((*item_it)->m_sacked
+              && beginOfCurrentPacket >= (*option_it).first
+              && beginOfCurrentPacket + pktSize <= (*option_it).second)
+            {
+              // Skip the sacked range containing this item, whose items are
+              // not modified by the block
+              SackedRanges::const_iterator range = m_sackedRanges.upper_bound (beginOfCurrentPacket);
+              NS_ASSERT (range != m_sackedRanges.begin ());
+              --range;
+              NS_ASSERT (range->first <= beginOfCurrentPacket && range->second >= beginOfCurrentPacket + pktSize);
+              if (range->second > beginOfCurrentPacket + pktSize)
+                {
+                  entry = m_sentIndex.lower_bound (range->second);
+                  if (entry == m_sentIndex.end ())
+                    {
+                      break;
+                    }
+                  NS_LOG_INFO ("Received block " << *option_it <<
+                               ", skipping the sacked range [" << range->first <<
+                               ";" << range->second << ")");
+                  item_it = entry->second;
+                  beginOfCurrentPacket = entry->first;
+                  continue;
+                }
+            }
+
           // Check the boundary of this packet ... only mark as sacked if
           // it is precisely mapped over the option. It means that if the receiver
           // is reporting as sacked single range bytes that are not mapped 1:1
@@ -804,6 +976,7 @@ TcpTxBuffer::Update (const TcpOptionSack::SackList &list,
 
                   (*item_it)->m_sacked = true;
                   m_sackedOut += (*item_it)->m_packet->GetSize ();
+                  AddSackedRange (*item_it);
                   bytesSacked += (*item_it)->m_packet->GetSize ();
 
                   if (m_highestSack.first == m_sentList.end()
@@ -868,9 +1041,18 @@ TcpTxBuffer::UpdateLostCount ()
                    ", will start from item " << *(*m_highestSack.first));
     }
 
+  TcpTxItem *head = *m_sentList.begin ();
+  SequenceNumber32 lostBoundary = m_lostBoundary;
+  bool thresholdReached = false;
   for (auto it = m_highestSack.first; it != m_sentList.begin(); --it)
     {
       TcpTxItem *item = *it;
+      if (item->m_startSeq < lostBoundary && (sacked >= m_dupAckThresh || head->m_lost))
+        {
+          // The items from here down to the head are already lost or sacked
+          break;
+        }
+
       if (item->m_sacked)
         {
           sacked++;
@@ -878,6 +1060,14 @@ TcpTxBuffer::UpdateLostCount ()
 
       if (sacked >= m_dupAckThresh)
         {
+          if (!thresholdReached)
+            {
+              // The items below this one are going to be lost, if not sacked
+              thresholdReached = true;
+              m_lostBoundary = std::max (m_lostBoundary, item->m_startSeq);
+              m_lostEnd = std::max (m_lostEnd, item->m_startSeq + item->m_packet->GetSize ());
+            }
+
           if (!item->m_sacked && !item->m_lost)
             {
               item->m_lost = true;
@@ -889,11 +1079,11 @@ TcpTxBuffer::UpdateLostCount ()
 
   if (sacked >= m_dupAckThresh)
     {
-      TcpTxItem *item = *m_sentList.begin ();
-      if (!item->m_lost)
+      if (!head->m_lost)
         {
-          item->m_lost = true;
-          m_lostOut += item->m_packet->GetSize ();
+          head->m_lost = true;
+          m_lostOut += head->m_packet->GetSize ();
+          m_lostEnd = std::max (m_lostEnd, head->m_startSeq + head->m_packet->GetSize ());
         }
     }
   NS_LOG_INFO ("Status after the update: " << *this);
@@ -905,35 +1095,31 @@ TcpTxBuffer::IsLost (const SequenceNumber32 &seq) const
 {
   NS_LOG_FUNCTION (this << seq);
 
-  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
-  PacketList::const_iterator it;
-
   if (seq >= m_highestSack.second)
     {
       return false;
     }
 
-  // In theory, using a map and hints when inserting elements can improve
-  // performance
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Start from the first item which begins at or after seq
+  SentIndex::const_iterator entry = m_sentIndex.lower_bound (seq);
+  if (entry == m_sentIndex.end ())
     {
-      // Search for the right iterator before calling IsLost()
-      if (beginOfCurrentPacket >= seq)
-        {
-          if ((*it)->m_lost == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
-              return true;
-            }
+      return false;
+    }
 
-          if ((*it)->m_sacked == true)
-            {
-              NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
-              return false;
-            }
+  for (PacketList::const_iterator it = entry->second; it != m_sentList.end (); ++it)
+    {
+      if ((*it)->m_lost == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is lost because of lost flag");
+          return true;
         }
 
-      beginOfCurrentPacket += (*it)->m_packet->GetSize ();
+      if ((*it)->m_sacked == true)
+        {
+          NS_LOG_INFO ("seq=" << seq << " is not lost because of sacked flag");
+          return false;
+        }
     }
 
   return false;
@@ -957,35 +1143,54 @@ TcpTxBuffer::NextSeg (SequenceNumber32 *seq, bool isRecovery) const
    *
    *     (1.c) IsLost (S2) returns true.
    */
-  PacketList::const_iterator it;
+  PacketList::const_iterator it = m_sentList.begin ();
   TcpTxItem *item;
   SequenceNumber32 seqPerRule3;
   bool isSeqPerRule3Valid = false;
-  SequenceNumber32 beginOfCurrentPkt = m_firstByteSeq;
 
-  for (it = m_sentList.begin (); it != m_sentList.end (); ++it)
+  // Find the first item neither retransmitted nor sacked: the head, or the
+  // first one after m_nextSegHint.
+  if (it != m_sentList.end () && ((*it)->m_retrans || (*it)->m_sacked))
+    {
+      SentIndex::const_iterator entry =
+        m_sentIndex.lower_bound (std::max (m_nextSegHint, m_firstByteSeq.Get () + (*it)->m_packet->GetSize ()));
+      it = (entry == m_sentIndex.end ()) ? m_sentList.end () : PacketList::const_iterator (entry->second);
+      while (it != m_sentList.end () && ((*it)->m_retrans || (*it)->m_sacked))
+        {
+          ++it;
+        }
+      m_nextSegHint = (it == m_sentList.end ()) ? m_firstByteSeq.Get () + m_sentSize : (*it)->m_startSeq;
+    }
+
+  if (it != m_sentList.end ())
     {
       item = *it;
 
       // Condition 1.a , 1.b , and 1.c
-      if (item->m_retrans == false && item->m_sacked == false)
+      if (item->m_lost)
         {
-          if (item->m_lost)
+          NS_LOG_INFO("IsLost, returning" << item->m_startSeq);
+          *seq = item->m_startSeq;
+          return true;
+        }
+      else if (isRecovery)
+        {
+          NS_LOG_INFO ("Saving for rule 3 the seq " << item->m_startSeq);
+          isSeqPerRule3Valid = true;
+          seqPerRule3 = item->m_startSeq;
+        }
+
+      // The lost items all start before m_lostEnd
+      for (++it; it != m_sentList.end () && (*it)->m_startSeq < m_lostEnd; ++it)
+        {
+          item = *it;
+          if (item->m_retrans == false && item->m_sacked == false && item->m_lost)
             {
-              NS_LOG_INFO("IsLost, returning" << beginOfCurrentPkt);
-              *seq = beginOfCurrentPkt;
+              NS_LOG_INFO("IsLost, returning" << item->m_startSeq);
+              *seq = item->m_startSeq;
               return true;
             }
-          else if (seqPerRule3.GetValue () == 0 && isRecovery)
-            {
-              NS_LOG_INFO ("Saving for rule 3 the seq " << beginOfCurrentPkt);
-              isSeqPerRule3Valid = true;
-              seqPerRule3 = beginOfCurrentPkt;
-            }
         }
-
-      // Nothing found, iterate
-      beginOfCurrentPkt += item->m_packet->GetSize ();
     }
 
   /* (2) If no sequence number 'S2' per rule (1) exists but there
@@ -1188,7 +1393,9 @@ TcpTxBuffer::ResetRenoSack ()
       (*it)->m_sacked = false;
     }
 
+  m_sackedRanges.clear ();
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  ResetScoreboardHints ();
 }
 
 void
@@ -1211,6 +1418,10 @@ TcpTxBuffer::ResetSentList ()
   m_retrans = 0;
   m_sackedOut = 0;
   m_highestSack = std::make_pair (m_sentList.end (), SequenceNumber32 (0));
+  m_sentIndex.clear ();
+  m_sackedRanges.clear ();
+  m_lostEnd = m_firstByteSeq;
+  ResetScoreboardHints ();
 }
 
 void
@@ -1222,12 +1433,18 @@ TcpTxBuffer::ResetLastSegmentSent ()
       TcpTxItem *item = m_sentList.back ();
 
       m_sentList.pop_back ();
+      m_sentIndex.erase (item->m_startSeq);
       m_sentSize -= item->m_packet->GetSize ();
       if (item->m_retrans)
         {
           m_retrans -= item->m_packet->GetSize ();
         }
       m_appList.insert (m_appList.begin (), item);
+
+      // The item is sent again as new data: it must not be skipped by
+      // UpdateLostCount and NextSeg
+      m_lostBoundary = std::min (m_lostBoundary, m_firstByteSeq.Get () + m_sentSize);
+      m_nextSegHint = std::min (m_nextSegHint, m_firstByteSeq.Get () + m_sentSize);
     }
   ConsistencyCheck ();
 }
@@ -1274,6 +1491,14 @@ TcpTxBuffer::SetSentListLost (bool resetSack)
       (*it)->m_retrans = false;
     }
 
+  if (resetSack)
+    {
+      m_sackedRanges.clear ();
+    }
+  ResetScoreboardHints ();
+  m_lostBoundary = m_firstByteSeq.Get () + m_sentSize;
+  m_lostEnd = std::max (m_lostEnd, m_firstByteSeq.Get () + m_sentSize);
+
   NS_LOG_INFO ("Set sent list lost, status: " << *this);
   NS_ASSERT_MSG (m_sentSize >= m_sackedOut + m_lostOut, *this);
   ConsistencyCheck ();
@@ -1322,6 +1547,7 @@ TcpTxBuffer::MarkHeadAsLost ()
         {
           m_sentList.front ()->m_sacked = false;
           m_sackedOut -= m_sentList.front ()->m_packet->GetSize ();
+          RemoveSackedRange (m_sentList.front ());
         }
 
       if (m_sentList.front ()->m_retrans)
@@ -1334,6 +1560,7 @@ TcpTxBuffer::MarkHeadAsLost ()
         {
           m_sentList.front()->m_lost = true;
           m_lostOut += m_sentList.front ()->m_packet->GetSize ();
+          m_lostEnd = std::max (m_lostEnd, m_firstByteSeq.Get () + m_sentList.front ()->m_packet->GetSize ());
         }
     }
   ConsistencyCheck ();
@@ -1350,7 +1577,17 @@ TcpTxBuffer::AddRenoSack (void)
   // We can _never_ SACK the head, so start from the second segment sent
   auto it = ++m_sentList.begin ();
 
-  // Find the "highest sacked" point, that is SND.UNA + m_sackedOut
+  // Find the "highest sacked" point, that is SND.UNA + m_sackedOut, skipping
+  // the range of the segments already sacked
+  if (it != m_sentList.end () && (*it)->m_sacked)
+    {
+      SackedRanges::const_iterator range = m_sackedRanges.find ((*it)->m_startSeq);
+      if (range != m_sackedRanges.end ())
+        {
+          SentIndex::const_iterator entry = m_sentIndex.lower_bound (range->second);
+          it = (entry == m_sentIndex.end ()) ? m_sentList.end () : entry->second;
+        }
+    }
   while (it != m_sentList.end () && (*it)->m_sacked)
     {
       ++it;
@@ -1361,6 +1598,7 @@ TcpTxBuffer::AddRenoSack (void)
     {
       (*it)->m_sacked = true;
       m_sackedOut += (*it)->m_packet->GetSize ();
+      AddSackedRange (*it);
       m_highestSack = std::make_pair (it, (*it)->m_startSeq);
       NS_LOG_INFO ("Added a Reno SACK, status: " << *this);
     }
@@ -1386,9 +1624,37 @@ TcpTxBuffer::ConsistencyCheck () const
   uint32_t sacked = 0;
   uint32_t lost = 0;
   uint32_t retrans = 0;
+  SequenceNumber32 beginOfCurrentPacket = m_firstByteSeq;
 
+  NS_ASSERT_MSG (m_sentIndex.size () == m_sentList.size (), "Index of " <<
+                 m_sentIndex.size () << " items for " << m_sentList.size ());
   for (auto it = m_sentList.begin (); it != m_sentList.end (); ++it)
     {
+      NS_ASSERT_MSG ((*it)->m_startSeq == beginOfCurrentPacket, "Item " << *(*it) <<
+                     " should start at " << beginOfCurrentPacket);
+      auto entry = m_sentIndex.find (beginOfCurrentPacket);
+      NS_ASSERT_MSG (entry != m_sentIndex.end () && entry->second == it,
+                     "Item " << *(*it) << " not indexed");
+      SackedRanges::const_iterator range = m_sackedRanges.upper_bound (beginOfCurrentPacket);
+      bool inSackedRange = false;
+      if (range != m_sackedRanges.begin ())
+        {
+          --range;
+          inSackedRange = range->second > beginOfCurrentPacket;
+        }
+      NS_ASSERT_MSG (inSackedRange == (*it)->m_sacked, "Item " << *(*it) <<
+                     " is not in sync with the sacked ranges");
+      if (it != m_sentList.begin ())
+        {
+          NS_ASSERT_MSG ((*it)->m_startSeq >= m_lostBoundary || (*it)->m_lost || (*it)->m_sacked,
+                         "Item " << *(*it) << " is below the lost boundary " << m_lostBoundary);
+          NS_ASSERT_MSG ((*it)->m_startSeq >= m_nextSegHint || (*it)->m_retrans || (*it)->m_sacked,
+                         "Item " << *(*it) << " is below the NextSeg hint " << m_nextSegHint);
+        }
+      NS_ASSERT_MSG ((*it)->m_startSeq < m_lostEnd || !(*it)->m_lost,
+                     "Item " << *(*it) << " is lost after " << m_lostEnd);
+      beginOfCurrentPacket += (*it)->m_packet->GetSize ();
+
       if ((*it)->m_sacked)
         {
           sacked += (*it)->m_packet->GetSize ();
@@ -22,6 +22,8 @@
 #ifndef TCP_TX_BUFFER_H
 #define TCP_TX_BUFFER_H
 
+#include <map>
+
 #include "ns3/object.h"
 #include "ns3/traced-value.h"
 #include "ns3/sequence-number.h"
@@ -114,6 +116,25 @@ class Packet;
  * connection, the TcpSocketImplementation should provide hints through
  * the MarkHeadAsLost and AddRenoSack methods.
  *
+ * Scoreboard index
+ * ----------------
+ *
+ * With a large bandwidth-delay product, thousands of segments are in the
+ * SentList, and walking it from the head at each ACK (or at each segment
+ * sent) is too expensive. Therefore, the items of the SentList are also
+ * indexed by their first sequence number in a balanced tree, so that the
+ * item containing a sequence number is found in O(log n), and the sacked
+ * sequence ranges are kept as a set of disjoint intervals, so that the
+ * processing of a SACK block skips the segments already sacked. Moreover,
+ * the buffer keeps two sequence numbers that bound the part of the SentList
+ * which can change at each update: below m_lostBoundary, every item is
+ * either lost or sacked (so UpdateLostCount stops there), and between the
+ * head and m_nextSegHint, every item is either retransmitted or sacked (so
+ * NextSeg starts from there). With these, and the byte counters of the sacked,
+ * lost and retransmitted items, the cost of processing an ACK depends on the
+ * number of items whose state changes, and not on the number of items in
+ * flight.
+ *
  * \see BytesInFlight
  * \see Size
  * \see SizeFromSequence
@@ -401,8 +422,9 @@ private:
    * The {New}Reno cases, for now, are managed in TcpSocketBase through the
    * call to MarkHeadAsLost.
    * This function is, therefore, called after a SACK option has been received,
-   * and updates the lost count. It can be probably optimized by not walking
-   * the entire list, but a subset.
+   * and updates the lost count. It walks the list from the highest sacked
+   * item down to m_lostBoundary, below which every item is already lost or
+   * sacked.
    *
    */
   void UpdateLostCount ();
@@ -574,8 +596,59 @@ private:
   std::pair <TcpTxBuffer::PacketList::const_iterator, SequenceNumber32>
   FindHighestSacked () const;
 
+  /**
+   * \brief Index of the items of the SentList by their first sequence number
+   */
+  typedef std::map<SequenceNumber32, PacketList::iterator> SentIndex;
+
+  /**
+   * \brief Sacked sequence ranges, as disjoint [start, end) intervals indexed
+   * by their start
+   */
+  typedef std::map<SequenceNumber32, SequenceNumber32> SackedRanges;
+
+  /**
+   * \brief Find the last item of the SentList which starts at or before seq
+   * \param seq the sequence number
+   * \return the index entry of the item containing seq, of the first item if
+   * seq is before the SentList, of the last item if seq is after it, or the
+   * end of the index if the SentList is empty
+   */
+  SentIndex::const_iterator FindSentItem (const SequenceNumber32 &seq) const;
+
+  /**
+   * \brief Add (or update) the index entry of an item of the SentList
+   * \param it the item in the SentList
+   */
+  void IndexSentItem (PacketList::iterator it);
+
+  /**
+   * \brief Add the range of an item to the sacked ranges
+   * \param item the item which has been sacked
+   */
+  void AddSackedRange (const TcpTxItem *item);
+
+  /**
+   * \brief Remove the range of an item from the sacked ranges
+   * \param item the item which is not sacked anymore
+   */
+  void RemoveSackedRange (const TcpTxItem *item);
+
+  /**
+   * \brief Forget the state derived from the flags of the SentList items
+   *
+   * To be called when the sacked, lost or retransmitted flags are reset
+   * outside the head of the SentList.
+   */
+  void ResetScoreboardHints ();
+
   PacketList m_appList;  //!< Buffer for application data
   PacketList m_sentList; //!< Buffer for sent (but not acked) data
+  SentIndex m_sentIndex; //!< Index of the SentList by sequence number
+  SackedRanges m_sackedRanges; //!< Sequence ranges of the sacked items
+  SequenceNumber32 m_lostBoundary;         //!< Every item of the SentList starting below it is lost or sacked
+  SequenceNumber32 m_lostEnd;              //!< No item of the SentList starting at or after it is lost
+  mutable SequenceNumber32 m_nextSegHint;  //!< Every item between the head (excluded) and it is retransmitted or sacked
   uint32_t m_maxBuffer;  //!< Max number of data bytes in buffer (SND.WND)
   uint32_t m_size;       //!< Size of all data in this buffer
   uint32_t m_sentSize;   //!< Size of sent (and not discarded) segments
@@ -226,6 +226,75 @@ GlobalRouteManagerImplTestCase::DoRun (void)
 }
 
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief Candidate queue order test
+ */
+class CandidateQueueTestCase : public TestCase
+{
+public:
+  CandidateQueueTestCase ();
+  virtual void DoRun (void);
+private:
+  /**
+   * \brief Create a vertex
+   * \param id the vertex ID
+   * \param type the vertex type
+   * \param distance the distance from the root
+   * \return the vertex
+   */
+  SPFVertex* CreateVertex (Ipv4Address id, SPFVertex::VertexType type, uint32_t distance);
+};
+
+CandidateQueueTestCase::CandidateQueueTestCase ()
+  : TestCase ("CandidateQueue order of the vertices")
+{
+}
+
+SPFVertex*
+CandidateQueueTestCase::CreateVertex (Ipv4Address id, SPFVertex::VertexType type, uint32_t distance)
+{
+  SPFVertex *v = new SPFVertex;
+  v->SetVertexId (id);
+  v->SetVertexType (type);
+  v->SetDistanceFromRoot (distance);
+  return v;
+}
+
+void
+CandidateQueueTestCase::DoRun (void)
+{
+  CandidateQueue candidate;
+  // the vertices at the same distance are popped networks first, then in
+  // the order in which they got their distance
+  SPFVertex *r4 = CreateVertex ("0.0.0.4", SPFVertex::VertexRouter, 7);
+  SPFVertex *r3 = CreateVertex ("0.0.0.3", SPFVertex::VertexRouter, 5);
+  candidate.Push (CreateVertex ("0.0.0.1", SPFVertex::VertexRouter, 5));
+  candidate.Push (CreateVertex ("10.0.0.1", SPFVertex::VertexNetwork, 5));
+  candidate.Push (r4);
+  candidate.Push (CreateVertex ("0.0.0.2", SPFVertex::VertexRouter, 3));
+  candidate.Push (r3);
+  r4->SetDistanceFromRoot (5);
+  candidate.Update (r4);
+  r3->SetDistanceFromRoot (2);
+  candidate.Update (r3);
+  NS_TEST_ASSERT_MSG_EQ (candidate.Size (), 5, "wrong number of candidates");
+  NS_TEST_ASSERT_MSG_EQ (candidate.Top (), r3, "wrong top candidate");
+  NS_TEST_ASSERT_MSG_EQ (candidate.Find ("0.0.0.4"), r4, "candidate not found");
+  NS_TEST_ASSERT_MSG_EQ (candidate.Find ("0.0.0.5"), 0, "unexpected candidate");
+
+  const char *order[] = { "0.0.0.3", "0.0.0.2", "10.0.0.1", "0.0.0.1", "0.0.0.4" };
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      SPFVertex *v = candidate.Pop ();
+      NS_TEST_ASSERT_MSG_EQ (v->GetVertexId (), Ipv4Address (order[i]), "wrong candidate " << i);
+      delete v;
+    }
+  NS_TEST_ASSERT_MSG_EQ (candidate.Empty (), true, "queue not empty");
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -243,6 +312,7 @@ GlobalRouteManagerImplTestSuite::GlobalRouteManagerImplTestSuite ()
   : TestSuite ("global-route-manager-impl", UNIT)
 {
   AddTestCase (new GlobalRouteManagerImplTestCase (), TestCase::QUICK);
+  AddTestCase (new CandidateQueueTestCase (), TestCase::QUICK);
 }
 
 static GlobalRouteManagerImplTestSuite g_globalRoutingManagerImplTestSuite; //!< Static variable for test initialization
@@ -14,9 +14,11 @@
  * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
  */
 
+#include <sstream>
 #include <vector>
 #include "ns3/boolean.h"
 #include "ns3/config.h"
+#include "ns3/global-value.h"
 #include "ns3/inet-socket-address.h"
 #include "ns3/internet-stack-helper.h"
 #include "ns3/ipv4-address-helper.h"
@@ -1244,6 +1246,250 @@ Ipv4GlobalRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting longest prefix match test
+ */
+class Ipv4GlobalRoutingLongestPrefixTestCase : public TestCase
+{
+public:
+  Ipv4GlobalRoutingLongestPrefixTestCase ();
+  virtual ~Ipv4GlobalRoutingLongestPrefixTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Look up the route to a destination
+   * \param routing the routing protocol
+   * \param dest the destination
+   * \return the gateway of the route, or 255.255.255.255 if there is none
+   */
+  Ipv4Address GetGateway (Ptr<Ipv4GlobalRouting> routing, Ipv4Address dest);
+};
+
+Ipv4GlobalRoutingLongestPrefixTestCase::Ipv4GlobalRoutingLongestPrefixTestCase ()
+  : TestCase ("Global routing longest prefix match")
+{
+}
+
+Ipv4GlobalRoutingLongestPrefixTestCase::~Ipv4GlobalRoutingLongestPrefixTestCase ()
+{
+}
+
+Ipv4Address
+Ipv4GlobalRoutingLongestPrefixTestCase::GetGateway (Ptr<Ipv4GlobalRouting> routing, Ipv4Address dest)
+{
+  Ipv4Header header;
+  header.SetDestination (dest);
+  Socket::SocketErrno sockerr;
+  Ptr<Ipv4Route> route = routing->RouteOutput (Create<Packet> (), header, 0, sockerr);
+  if (route == 0)
+    {
+      return Ipv4Address::GetBroadcast ();
+    }
+  return route->GetGateway ();
+}
+
+void
+Ipv4GlobalRoutingLongestPrefixTestCase::DoRun (void)
+{
+  NodeContainer nodes;
+  nodes.Create (2);
+  SimpleNetDeviceHelper devHelper;
+  NetDeviceContainer devices = devHelper.Install (nodes);
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (nodes);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.0.0.0", "255.255.255.0");
+  ipv4.Assign (devices);
+
+  Ptr<Ipv4GlobalRouting> routing = nodes.Get (0)->GetObject<Ipv4L3Protocol> ()->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+  NS_TEST_ASSERT_MSG_NE (routing, 0, "Error-- no Ipv4GlobalRouting object");
+
+  // overlapping network routes, not added in the prefix length order
+  routing->AddNetworkRouteTo (Ipv4Address ("10.1.0.0"), Ipv4Mask ("255.255.0.0"), Ipv4Address ("10.0.0.16"), 1);
+  routing->AddNetworkRouteTo (Ipv4Address ("10.1.2.0"), Ipv4Mask ("255.255.255.0"), Ipv4Address ("10.0.0.24"), 1);
+  routing->AddNetworkRouteTo (Ipv4Address ("10.0.0.0"), Ipv4Mask ("255.0.0.0"), Ipv4Address ("10.0.0.8"), 1);
+  routing->AddNetworkRouteTo (Ipv4Address ("10.1.2.0"), Ipv4Mask ("255.255.255.0"), Ipv4Address ("10.0.0.25"), 1);
+  routing->AddHostRouteTo (Ipv4Address ("10.1.2.3"), Ipv4Address ("10.0.0.32"), 1);
+  routing->AddASExternalRouteTo (Ipv4Address ("192.168.0.0"), Ipv4Mask ("255.255.0.0"), Ipv4Address ("10.0.0.40"), 1);
+
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.2.3"), Ipv4Address ("10.0.0.32"), "host route not preferred");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.2.4"), Ipv4Address ("10.0.0.24"), "/24 route not preferred");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.3.4"), Ipv4Address ("10.0.0.16"), "/16 route not preferred");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.2.3.4"), Ipv4Address ("10.0.0.8"), "/8 route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "192.168.1.1"), Ipv4Address ("10.0.0.40"), "external route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "172.16.1.1"), Ipv4Address::GetBroadcast (), "unexpected route");
+
+  // removing routes updates the lookups: the first /24 route, then the host route
+  for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+    {
+      Ipv4RoutingTableEntry* route = routing->GetRoute (i);
+      if (route->GetGateway () == Ipv4Address ("10.0.0.24") || route->GetGateway () == Ipv4Address ("10.0.0.32"))
+        {
+          routing->RemoveRoute (i);
+          i--;
+        }
+    }
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.2.3"), Ipv4Address ("10.0.0.25"), "wrong route after removal");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway (routing, "10.1.3.4"), Ipv4Address ("10.0.0.16"), "wrong route after removal");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 GlobalRouting incremental update test
+ *
+ * Checks that the routes updated by UpdateRoutingTables () after topology
+ * changes are the ones computed from scratch by RecomputeRoutingTables ().
+ */
+class Ipv4GlobalRoutingUpdateTestCase : public TestCase
+{
+public:
+  Ipv4GlobalRoutingUpdateTestCase ();
+  virtual ~Ipv4GlobalRoutingUpdateTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Get the routes of all the nodes
+   * \param nodes the nodes
+   * \return the routes, as text
+   */
+  std::string GetRoutes (NodeContainer nodes);
+  /**
+   * \brief Update the routes and check them against the recomputed ones
+   * \param nodes the nodes
+   * \param step the description of the topology change
+   * \return the routes
+   */
+  std::string CheckUpdate (NodeContainer nodes, std::string step);
+};
+
+Ipv4GlobalRoutingUpdateTestCase::Ipv4GlobalRoutingUpdateTestCase ()
+  : TestCase ("Global routing incremental updates match the recomputed routes")
+{
+}
+
+Ipv4GlobalRoutingUpdateTestCase::~Ipv4GlobalRoutingUpdateTestCase ()
+{
+}
+
+std::string
+Ipv4GlobalRoutingUpdateTestCase::GetRoutes (NodeContainer nodes)
+{
+  std::ostringstream oss;
+  for (uint32_t n = 0; n < nodes.GetN (); n++)
+    {
+      Ptr<Ipv4GlobalRouting> routing = nodes.Get (n)->GetObject<Ipv4L3Protocol> ()->GetRoutingProtocol ()->GetObject<Ipv4GlobalRouting> ();
+      oss << "node " << n << "\n";
+      for (uint32_t i = 0; i < routing->GetNRoutes (); i++)
+        {
+          oss << *routing->GetRoute (i) << "\n";
+        }
+    }
+  return oss.str ();
+}
+
+std::string
+Ipv4GlobalRoutingUpdateTestCase::CheckUpdate (NodeContainer nodes, std::string step)
+{
+  Ipv4GlobalRoutingHelper::UpdateRoutingTables ();
+  std::string updated = GetRoutes (nodes);
+  Ipv4GlobalRoutingHelper::RecomputeRoutingTables ();
+  std::string recomputed = GetRoutes (nodes);
+  NS_TEST_EXPECT_MSG_EQ (updated, recomputed, "Updated routes differ from the recomputed ones " << step);
+  return updated;
+}
+
+//
+// Network topology: a ring of six routers with a chord (point-to-point
+// links), plus a shared segment between n0, n2 and n4, and hosts n6 and n7
+// on stub links of n1 and n4.
+//
+//        n6
+//        |
+//   n0 - n1 - n2
+//   |  \      |  (chord n1-n4, segment n0-n2-n4)
+//   n5 - n4 - n3
+//        |
+//        n7
+//
+void
+Ipv4GlobalRoutingUpdateTestCase::DoRun (void)
+{
+  // the routes are only updated by the test, reusing the kept SPF trees
+  Config::SetDefault ("ns3::Ipv4GlobalRouting::RespondToInterfaceEvents", BooleanValue (false));
+  GlobalValue::Bind ("GlobalRoutingKeepSpfTrees", BooleanValue (true));
+
+  NodeContainer c;
+  c.Create (8);
+  InternetStackHelper internet;
+  Ipv4GlobalRoutingHelper ipv4RoutingHelper;
+  internet.SetRoutingHelper (ipv4RoutingHelper);
+  internet.Install (c);
+
+  SimpleNetDeviceHelper devHelper;
+  devHelper.SetNetDevicePointToPointMode (true);
+  Ipv4AddressHelper ipv4;
+  ipv4.SetBase ("10.1.1.0", "255.255.255.0");
+  const uint32_t links[][2] = { { 0, 1 }, { 1, 2 }, { 2, 3 }, { 3, 4 }, { 4, 5 }, { 5, 0 },
+                                { 1, 4 }, { 1, 6 }, { 4, 7 } };
+  for (uint32_t i = 0; i < sizeof (links) / sizeof (links[0]); i++)
+    {
+      ipv4.Assign (devHelper.Install (NodeContainer (c.Get (links[i][0]), c.Get (links[i][1]))));
+      ipv4.NewNetwork ();
+    }
+  devHelper.SetNetDevicePointToPointMode (false);
+  ipv4.SetBase ("10.250.1.0", "255.255.255.0");
+  ipv4.Assign (devHelper.Install (NodeContainer (c.Get (0), c.Get (2), c.Get (4))));
+
+  Ipv4GlobalRoutingHelper::PopulateRoutingTables ();
+  std::string initial = CheckUpdate (c, "at start");
+
+  Ptr<Ipv4> ipv41 = c.Get (1)->GetObject<Ipv4> ();
+  Ptr<Ipv4> ipv44 = c.Get (4)->GetObject<Ipv4> ();
+  Ptr<Ipv4> ipv45 = c.Get (5)->GetObject<Ipv4> ();
+
+  // bring the chord n1-n4 down, then the link n4-n5
+  ipv41->SetDown (3);
+  std::string routes = CheckUpdate (c, "after n1-n4 down");
+  NS_TEST_EXPECT_MSG_NE (routes, initial, "Routes not updated after n1-n4 down");
+  ipv45->SetDown (1);
+  CheckUpdate (c, "after n4-n5 down");
+
+  // increase the metric of the link n0-n1, then bring everything back up
+  Ptr<Ipv4> ipv40 = c.Get (0)->GetObject<Ipv4> ();
+  ipv40->SetMetric (1, 5);
+  ipv41->SetMetric (1, 5);
+  CheckUpdate (c, "after n0-n1 metric change");
+  ipv45->SetUp (1);
+  CheckUpdate (c, "after n4-n5 up");
+  ipv41->SetUp (3);
+  CheckUpdate (c, "after n1-n4 up");
+
+  // the segment goes down on n4, and an address is added on n7
+  ipv44->SetDown (ipv44->GetNInterfaces () - 1);
+  CheckUpdate (c, "after the segment down on n4");
+  Ptr<Ipv4> ipv47 = c.Get (7)->GetObject<Ipv4> ();
+  ipv47->AddAddress (1, Ipv4InterfaceAddress ("10.1.9.2", "255.255.255.0"));
+  CheckUpdate (c, "after an address added on n7");
+
+  // without the kept trees, the routes are recomputed
+  GlobalValue::Bind ("GlobalRoutingKeepSpfTrees", BooleanValue (false));
+  ipv44->SetUp (ipv44->GetNInterfaces () - 1);
+  CheckUpdate (c, "after the segment up on n4, without the kept trees");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -1267,6 +1513,8 @@ Ipv4GlobalRoutingTestSuite::Ipv4GlobalRoutingTestSuite ()
     AddTestCase (new TwoBridgeTest, TestCase::QUICK);
     AddTestCase (new Ipv4DynamicGlobalRoutingTestCase, TestCase::QUICK);
     AddTestCase (new Ipv4GlobalRoutingSlash32TestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingLongestPrefixTestCase, TestCase::QUICK);
+    AddTestCase (new Ipv4GlobalRoutingUpdateTestCase, TestCase::QUICK);
   }
 
 static Ipv4GlobalRoutingTestSuite g_globalRoutingTestSuite; //!< Static variable for test initialization
@@ -16,6 +16,8 @@
 
 // End-to-end tests for Ipv4 static routing
 
+#include <sstream>
+
 #include "ns3/boolean.h"
 #include "ns3/config.h"
 #include "ns3/inet-socket-address.h"
@@ -35,6 +37,8 @@
 #include "ns3/simple-net-device-helper.h"
 #include "ns3/socket-factory.h"
 #include "ns3/udp-socket-factory.h"
+#include "ns3/ipv4-routing-table-entry.h"
+#include "ns3/ipv4-header.h"
 
 using namespace ns3;
 
@@ -201,6 +205,179 @@ Ipv4StaticRoutingSlash32TestCase::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv4 StaticRouting longest prefix match Test
+ *
+ * Checks the route selected among overlapping prefixes, metrics and output
+ * interfaces, and compares the lookups with a linear search of the routing
+ * table while routes are added and removed.
+ */
+class Ipv4StaticRoutingLongestPrefixTestCase : public TestCase
+{
+public:
+  Ipv4StaticRoutingLongestPrefixTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Get the gateway of the route towards a destination.
+   * \param dest the destination
+   * \param oif the output device, if any
+   * \return the gateway, or 255.255.255.255 if there is no route
+   */
+  Ipv4Address GetGateway (Ipv4Address dest, Ptr<NetDevice> oif = 0);
+  /**
+   * \brief Get the gateway of the route towards a destination by searching
+   * the whole routing table.
+   * \param dest the destination
+   * \param oif the output device, if any
+   * \return the gateway, or 255.255.255.255 if there is no route
+   */
+  Ipv4Address GetExpectedGateway (Ipv4Address dest, Ptr<NetDevice> oif = 0);
+
+  Ptr<Ipv4> m_ipv4;                   //!< the IPv4 stack of the node
+  Ptr<Ipv4StaticRouting> m_routing;   //!< the static routing of the node
+};
+
+Ipv4StaticRoutingLongestPrefixTestCase::Ipv4StaticRoutingLongestPrefixTestCase ()
+  : TestCase ("Longest prefix match of the static routes")
+{
+}
+
+Ipv4Address
+Ipv4StaticRoutingLongestPrefixTestCase::GetGateway (Ipv4Address dest, Ptr<NetDevice> oif)
+{
+  Ipv4Header header;
+  header.SetDestination (dest);
+  Socket::SocketErrno sockerr;
+  Ptr<Ipv4Route> route = m_routing->RouteOutput (Create<Packet> (), header, oif, sockerr);
+  return route ? route->GetGateway () : Ipv4Address::GetBroadcast ();
+}
+
+Ipv4Address
+Ipv4StaticRoutingLongestPrefixTestCase::GetExpectedGateway (Ipv4Address dest, Ptr<NetDevice> oif)
+{
+  // longest prefix, then lowest metric with the last route winning ties,
+  // except for the host routes where the first route wins
+  int32_t best = -1;
+  uint16_t longest = 0;
+  uint32_t lowest = 0xffffffff;
+  for (uint32_t i = 0; i < m_routing->GetNRoutes (); i++)
+    {
+      Ipv4RoutingTableEntry route = m_routing->GetRoute (i);
+      Ipv4Mask mask = route.GetDestNetworkMask ();
+      if (!mask.IsMatch (dest, route.GetDestNetwork ())
+          || (oif != 0 && oif != m_ipv4->GetNetDevice (route.GetInterface ())))
+        {
+          continue;
+        }
+      uint16_t length = mask.GetPrefixLength ();
+      uint32_t metric = m_routing->GetMetric (i);
+      if (length < longest)
+        {
+          continue;
+        }
+      if (length > longest)
+        {
+          lowest = 0xffffffff;
+        }
+      longest = length;
+      if (metric > lowest)
+        {
+          continue;
+        }
+      lowest = metric;
+      best = i;
+      if (length == 32)
+        {
+          break;
+        }
+    }
+  return best < 0 ? Ipv4Address::GetBroadcast () : m_routing->GetRoute (best).GetGateway ();
+}
+
+void
+Ipv4StaticRoutingLongestPrefixTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.Install (node);
+  m_ipv4 = node->GetObject<Ipv4> ();
+
+  Ptr<NetDevice> devices[4];
+  for (uint32_t i = 1; i <= 3; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      node->AddDevice (device);
+      devices[i] = device;
+      int32_t ifIndex = m_ipv4->AddInterface (device);
+      std::ostringstream address;
+      address << "10.0." << i << ".1";
+      m_ipv4->AddAddress (ifIndex, Ipv4InterfaceAddress (Ipv4Address (address.str ().c_str ()),
+                                                         Ipv4Mask ("/24")));
+      m_ipv4->SetUp (ifIndex);
+    }
+
+  Ipv4StaticRoutingHelper helper;
+  m_routing = helper.GetStaticRouting (m_ipv4);
+  m_routing->AddNetworkRouteTo ("172.16.0.0", "/16", "10.0.1.2", 1);
+  m_routing->AddNetworkRouteTo ("172.16.5.0", "/24", "10.0.2.2", 2, 5);
+  m_routing->AddNetworkRouteTo ("172.16.5.0", "/24", "10.0.3.2", 3, 5);
+  m_routing->AddNetworkRouteTo ("172.16.5.0", "/24", "10.0.1.3", 1, 7);
+  m_routing->AddHostRouteTo ("172.16.5.9", "10.0.2.3", 2, 9);
+  m_routing->AddHostRouteTo ("172.16.5.9", "10.0.3.3", 3, 1);
+  m_routing->SetDefaultRoute ("10.0.1.254", 1);
+
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("172.16.5.9"), Ipv4Address ("10.0.2.3"), "first host route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("172.16.5.10"), Ipv4Address ("10.0.3.2"), "last route with the lowest metric not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("172.16.6.1"), Ipv4Address ("10.0.1.2"), "shorter prefix not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("8.8.8.8"), Ipv4Address ("10.0.1.254"), "default route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("172.16.5.10", devices[1]), Ipv4Address ("10.0.1.3"), "route on the output device not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("172.16.6.1", devices[2]), Ipv4Address::GetBroadcast (), "route on another device used");
+
+  // a route with a non-contiguous mask is also matched
+  m_routing->AddNetworkRouteTo ("192.168.0.5", Ipv4Mask (0xffff00ff), "10.0.3.9", 3);
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("192.168.77.5"), Ipv4Address ("10.0.3.9"), "non-contiguous mask not matched");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("172.16.5.10"), Ipv4Address ("10.0.3.2"), "wrong route with a non-contiguous mask");
+  m_routing->RemoveRoute (m_routing->GetNRoutes () - 1);
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("192.168.77.5"), Ipv4Address ("10.0.1.254"), "non-contiguous mask not removed");
+
+  // random routes added and removed
+  uint32_t seed = 1;
+  for (uint32_t step = 0; step < 1000; step++)
+    {
+      seed = seed * 1103515245 + 12345;
+      uint32_t r = seed >> 8;
+      if (r % 5 < 2 && m_routing->GetNRoutes () > 0)
+        {
+          m_routing->RemoveRoute ((r >> 3) % m_routing->GetNRoutes ());
+        }
+      else
+        {
+          uint32_t length = 8 + (r >> 3) % 25;
+          Ipv4Address network (0xac100000 | ((r >> 8) & 0x3ff) << 6);
+          std::ostringstream gateway;
+          gateway << "10.0." << 1 + (r >> 4) % 3 << "." << 2 + step % 250;
+          Ipv4Address nextHop (gateway.str ().c_str ());
+          m_routing->AddNetworkRouteTo (network, Ipv4Mask (0xffffffff << (32 - length)), nextHop,
+                                        1 + (r >> 4) % 3, (r >> 20) % 3);
+        }
+      seed = seed * 1103515245 + 12345;
+      Ipv4Address dest (0xac100000 | ((seed >> 8) & 0xffff));
+      Ptr<NetDevice> oif = (seed >> 24) % 4 ? 0 : devices[1 + (seed >> 26) % 3];
+      NS_TEST_ASSERT_MSG_EQ (GetGateway (dest, oif), GetExpectedGateway (dest, oif),
+                             "wrong route to " << dest << " at step " << step);
+    }
+
+  Simulator::Destroy ();
+  m_routing = 0;
+  m_ipv4 = 0;
+}
+
 /**
  * \ingroup internet-test
  * \ingroup tests
@@ -217,6 +394,7 @@ Ipv4StaticRoutingTestSuite::Ipv4StaticRoutingTestSuite ()
   : TestSuite ("ipv4-static-routing", UNIT)
 {
   AddTestCase (new Ipv4StaticRoutingSlash32TestCase, TestCase::QUICK);
+  AddTestCase (new Ipv4StaticRoutingLongestPrefixTestCase, TestCase::QUICK);
 }
 
 static Ipv4StaticRoutingTestSuite ipv4StaticRoutingTestSuite; //!< Static variable for test initialization
@@ -0,0 +1,235 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+// Unit tests for Ipv6 static routing
+
+#include <sstream>
+
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv6-static-routing-helper.h"
+#include "ns3/ipv6-static-routing.h"
+#include "ns3/ipv6-routing-table-entry.h"
+#include "ns3/ipv6-header.h"
+#include "ns3/ipv6-route.h"
+#include "ns3/ipv6.h"
+#include "ns3/node.h"
+#include "ns3/packet.h"
+#include "ns3/simulator.h"
+#include "ns3/test.h"
+#include "ns3/simple-net-device.h"
+
+using namespace ns3;
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv6 StaticRouting longest prefix match Test
+ *
+ * Checks the route selected among overlapping prefixes, metrics and output
+ * interfaces, and compares the lookups with a linear search of the routing
+ * table while routes are added and removed.
+ */
+class Ipv6StaticRoutingLongestPrefixTestCase : public TestCase
+{
+public:
+  Ipv6StaticRoutingLongestPrefixTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * \brief Get the gateway of the route towards a destination.
+   * \param dest the destination
+   * \param oif the output device, if any
+   * \return the gateway, or ffff:...:ffff if there is no route
+   */
+  Ipv6Address GetGateway (Ipv6Address dest, Ptr<NetDevice> oif = 0);
+  /**
+   * \brief Get the gateway of the route towards a destination by searching
+   * the whole routing table.
+   * \param dest the destination
+   * \param oif the output device, if any
+   * \return the gateway, or ffff:...:ffff if there is no route
+   */
+  Ipv6Address GetExpectedGateway (Ipv6Address dest, Ptr<NetDevice> oif = 0);
+
+  Ptr<Ipv6> m_ipv6;                   //!< the IPv6 stack of the node
+  Ptr<Ipv6StaticRouting> m_routing;   //!< the static routing of the node
+};
+
+Ipv6StaticRoutingLongestPrefixTestCase::Ipv6StaticRoutingLongestPrefixTestCase ()
+  : TestCase ("Longest prefix match of the IPv6 static routes")
+{
+}
+
+Ipv6Address
+Ipv6StaticRoutingLongestPrefixTestCase::GetGateway (Ipv6Address dest, Ptr<NetDevice> oif)
+{
+  Ipv6Header header;
+  header.SetDestinationAddress (dest);
+  Socket::SocketErrno sockerr;
+  Ptr<Ipv6Route> route = m_routing->RouteOutput (Create<Packet> (), header, oif, sockerr);
+  return route ? route->GetGateway () : Ipv6Address::GetOnes ();
+}
+
+Ipv6Address
+Ipv6StaticRoutingLongestPrefixTestCase::GetExpectedGateway (Ipv6Address dest, Ptr<NetDevice> oif)
+{
+  // longest prefix, then lowest metric with the last route winning ties,
+  // except for the /128 routes where the first route wins
+  int32_t best = -1;
+  uint16_t longest = 0;
+  uint32_t lowest = 0xffffffff;
+  for (uint32_t i = 0; i < m_routing->GetNRoutes (); i++)
+    {
+      Ipv6RoutingTableEntry route = m_routing->GetRoute (i);
+      Ipv6Prefix prefix = route.GetDestNetworkPrefix ();
+      if (!prefix.IsMatch (dest, route.GetDestNetwork ())
+          || (oif != 0 && oif != m_ipv6->GetNetDevice (route.GetInterface ())))
+        {
+          continue;
+        }
+      uint16_t length = prefix.GetPrefixLength ();
+      uint32_t metric = m_routing->GetMetric (i);
+      if (length < longest)
+        {
+          continue;
+        }
+      if (length > longest)
+        {
+          lowest = 0xffffffff;
+        }
+      longest = length;
+      if (metric > lowest)
+        {
+          continue;
+        }
+      lowest = metric;
+      best = i;
+      if (length == 128)
+        {
+          break;
+        }
+    }
+  return best < 0 ? Ipv6Address::GetOnes () : m_routing->GetRoute (best).GetGateway ();
+}
+
+void
+Ipv6StaticRoutingLongestPrefixTestCase::DoRun (void)
+{
+  Ptr<Node> node = CreateObject<Node> ();
+  InternetStackHelper internet;
+  internet.SetIpv4StackInstall (false);
+  internet.Install (node);
+  m_ipv6 = node->GetObject<Ipv6> ();
+
+  Ptr<NetDevice> devices[4];
+  for (uint32_t i = 1; i <= 3; i++)
+    {
+      Ptr<SimpleNetDevice> device = CreateObject<SimpleNetDevice> ();
+      device->SetAddress (Mac48Address::Allocate ());
+      node->AddDevice (device);
+      devices[i] = device;
+      int32_t ifIndex = m_ipv6->AddInterface (device);
+      std::ostringstream address;
+      address << "2001:" << i << "::1";
+      m_ipv6->AddAddress (ifIndex, Ipv6InterfaceAddress (Ipv6Address (address.str ().c_str ()),
+                                                         Ipv6Prefix (64)));
+      m_ipv6->SetUp (ifIndex);
+    }
+
+  Ipv6StaticRoutingHelper helper;
+  m_routing = helper.GetStaticRouting (m_ipv6);
+  m_routing->AddNetworkRouteTo ("2001:db8::", Ipv6Prefix (32), "2001:1::2", 1);
+  m_routing->AddNetworkRouteTo ("2001:db8:5::", Ipv6Prefix (48), "2001:2::2", 2, 5);
+  m_routing->AddNetworkRouteTo ("2001:db8:5::", Ipv6Prefix (48), "2001:3::2", 3, 5);
+  m_routing->AddNetworkRouteTo ("2001:db8:5::", Ipv6Prefix (48), "2001:1::3", 1, 7);
+  m_routing->AddHostRouteTo ("2001:db8:5::9", "2001:2::3", 2, "::", 9);
+  m_routing->AddHostRouteTo ("2001:db8:5::9", "2001:3::3", 3, "::", 1);
+  m_routing->SetDefaultRoute ("2001:1::fe", 1);
+
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db8:5::9"), Ipv6Address ("2001:2::3"), "first host route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db8:5::10"), Ipv6Address ("2001:3::2"), "last route with the lowest metric not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db8:6::1"), Ipv6Address ("2001:1::2"), "shorter prefix not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2a00::1"), Ipv6Address ("2001:1::fe"), "default route not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db8:5::10", devices[1]), Ipv6Address ("2001:1::3"), "route on the output device not used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db8:6::1", devices[2]), Ipv6Address::GetOnes (), "route on another device used");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:2::7"), Ipv6Address::GetAny (), "on-link prefix not used");
+
+  // a route with a non-contiguous prefix is also matched
+  uint8_t nonContiguous[16] = {0xff, 0xff, 0xff, 0xff, 0, 0, 0, 0xff};
+  m_routing->AddNetworkRouteTo ("2001:db9:0:5::", Ipv6Prefix (nonContiguous), "2001:3::9", 3);
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db9:77:5::1"), Ipv6Address ("2001:3::9"), "non-contiguous prefix not matched");
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db8:5::10"), Ipv6Address ("2001:3::2"), "wrong route with a non-contiguous prefix");
+  m_routing->RemoveRoute (m_routing->GetNRoutes () - 1);
+  NS_TEST_EXPECT_MSG_EQ (GetGateway ("2001:db9:77:5::1"), Ipv6Address ("2001:1::fe"), "non-contiguous prefix not removed");
+
+  // random routes added and removed
+  uint32_t seed = 1;
+  for (uint32_t step = 0; step < 1000; step++)
+    {
+      seed = seed * 1103515245 + 12345;
+      uint32_t r = seed >> 8;
+      if (r % 5 < 2 && m_routing->GetNRoutes () > 0)
+        {
+          m_routing->RemoveRoute ((r >> 3) % m_routing->GetNRoutes ());
+        }
+      else
+        {
+          // prefixes from /24 to /64 within 2001:d00::/24
+          uint8_t length = 24 + (r >> 3) % 41;
+          uint8_t network[16] = {0x20, 0x01, 0x0d, 0, 0, 0, 0, 0};
+          network[3] = (r >> 8) & 0xff;
+          network[4] = (r >> 16) & 0x03;
+          std::ostringstream gateway;
+          gateway << "2001:" << 1 + (r >> 4) % 3 << "::" << std::hex << 2 + step;
+          m_routing->AddNetworkRouteTo (Ipv6Address (network).CombinePrefix (Ipv6Prefix (length)),
+                                        Ipv6Prefix (length), Ipv6Address (gateway.str ().c_str ()),
+                                        1 + (r >> 4) % 3, (r >> 20) % 3);
+        }
+      seed = seed * 1103515245 + 12345;
+      uint8_t dest[16] = {0x20, 0x01, 0x0d, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1};
+      dest[3] = (seed >> 8) & 0xff;
+      dest[4] = (seed >> 16) & 0x03;
+      Ptr<NetDevice> oif = (seed >> 24) % 4 ? 0 : devices[1 + (seed >> 26) % 3];
+      NS_TEST_ASSERT_MSG_EQ (GetGateway (Ipv6Address (dest), oif), GetExpectedGateway (Ipv6Address (dest), oif),
+                             "wrong route to " << Ipv6Address (dest) << " at step " << step);
+    }
+
+  Simulator::Destroy ();
+  m_routing = 0;
+  m_ipv6 = 0;
+}
+
+/**
+ * \ingroup internet-test
+ * \ingroup tests
+ *
+ * \brief IPv6 StaticRouting TestSuite
+ */
+class Ipv6StaticRoutingTestSuite : public TestSuite
+{
+public:
+  Ipv6StaticRoutingTestSuite ();
+};
+
+Ipv6StaticRoutingTestSuite::Ipv6StaticRoutingTestSuite ()
+  : TestSuite ("ipv6-static-routing", UNIT)
+{
+  AddTestCase (new Ipv6StaticRoutingLongestPrefixTestCase, TestCase::QUICK);
+}
+
+static Ipv6StaticRoutingTestSuite ipv6StaticRoutingTestSuite; //!< Static variable for test initialization
@@ -15,8 +15,11 @@
  *
  */
 
+#include <vector>
+
 #include "ns3/test.h"
 #include "ns3/packet.h"
+#include "ns3/flow-id-tag.h"
 #include "ns3/log.h"
 
 #include "ns3/tcp-rx-buffer.h"
@@ -44,6 +47,26 @@ private:
    * \brief Test the SACK list update.
    */
   void TestUpdateSACKList ();
+
+  /**
+   * \brief Test the reassembly of reordered and overlapping segments.
+   */
+  void TestReordering ();
+
+  /**
+   * \brief Test the uid and the tags of the extracted packets.
+   */
+  void TestUidAndTags ();
+
+  /**
+   * \brief Check the byte tags of a packet.
+   * \param p the packet
+   * \param flowIds the expected flow id of each byte tag, in order
+   * \param starts the expected start of each byte tag
+   * \param ends the expected end of each byte tag
+   */
+  void CheckByteTags (Ptr<const Packet> p, std::vector<uint32_t> flowIds,
+                      std::vector<uint32_t> starts, std::vector<uint32_t> ends);
 };
 
 TcpRxBufferTestCase::TcpRxBufferTestCase ()
@@ -55,6 +78,8 @@ void
 TcpRxBufferTestCase::DoRun ()
 {
   TestUpdateSACKList ();
+  TestReordering ();
+  TestUidAndTags ();
 }
 
 void
@@ -338,6 +363,131 @@ TcpRxBufferTestCase::TestUpdateSACKList ()
                          "SACK list should contain no element");
 }
 
+void
+TcpRxBufferTestCase::TestReordering ()
+{
+  TcpRxBuffer rxBuf;
+  rxBuf.SetNextRxSequence (SequenceNumber32 (1));
+  rxBuf.SetMaxBufferSize (100000);
+
+  // The content of each byte is given by its sequence number
+  const uint32_t totalSize = 20000;
+  std::vector<uint8_t> data (totalSize);
+  for (uint32_t i = 0; i < totalSize; ++i)
+    {
+      data[i] = static_cast<uint8_t> (i % 251);
+    }
+  TcpHeader h;
+
+  // Odd segments first, then even segments in reverse order, each 100 bytes
+  // long but overlapping with the next one by 50 bytes
+  for (uint32_t i = 1; i < 200; i += 2)
+    {
+      h.SetSequenceNumber (SequenceNumber32 (1 + i * 100));
+      rxBuf.Add (Create<Packet> (&data[i * 100], 100), h);
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 0, "No data should be available");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 10000, "Wrong buffer occupancy");
+  for (uint32_t i = 198; i > 0; i -= 2)
+    {
+      h.SetSequenceNumber (SequenceNumber32 (1 + i * 100));
+      rxBuf.Add (Create<Packet> (&data[i * 100], 150), h);
+      NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), SequenceNumber32 (1),
+                             "Sequence number differs from expected");
+    }
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), totalSize - 100, "Wrong buffer occupancy");
+
+  h.SetSequenceNumber (SequenceNumber32 (1));
+  rxBuf.Add (Create<Packet> (&data[0], 100), h);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.NextRxSequence (), SequenceNumber32 (1 + totalSize),
+                         "Sequence number differs from expected");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), totalSize, "Wrong available data");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.GetSackListSize (), 0, "SACK list should be empty");
+
+  // Extract a part of a segment, then everything else
+  std::vector<uint8_t> out (totalSize);
+  Ptr<Packet> p = rxBuf.Extract (150);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 150, "Wrong extracted size");
+  p->CopyData (&out[0], 150);
+  p = rxBuf.Extract (totalSize);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), totalSize - 150, "Wrong extracted size");
+  p->CopyData (&out[150], totalSize - 150);
+  NS_TEST_ASSERT_MSG_EQ ((out == data), true, "Data reassembled in the wrong order");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 0, "The buffer should be empty");
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 0, "No data should be available");
+}
+
+void
+TcpRxBufferTestCase::CheckByteTags (Ptr<const Packet> p, std::vector<uint32_t> flowIds,
+                                    std::vector<uint32_t> starts, std::vector<uint32_t> ends)
+{
+  ByteTagIterator it = p->GetByteTagIterator ();
+  for (uint32_t i = 0; i < flowIds.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (it.HasNext (), true, "Missing byte tag " << i);
+      ByteTagIterator::Item item = it.Next ();
+      FlowIdTag tag;
+      item.GetTag (tag);
+      NS_TEST_EXPECT_MSG_EQ (tag.GetFlowId (), flowIds[i], "Wrong byte tag " << i);
+      NS_TEST_EXPECT_MSG_EQ (item.GetStart (), starts[i], "Wrong start of byte tag " << i);
+      NS_TEST_EXPECT_MSG_EQ (item.GetEnd (), ends[i], "Wrong end of byte tag " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (it.HasNext (), false, "Unexpected byte tag");
+}
+
+void
+TcpRxBufferTestCase::TestUidAndTags ()
+{
+  TcpRxBuffer rxBuf;
+  rxBuf.SetNextRxSequence (SequenceNumber32 (1));
+  rxBuf.SetMaxBufferSize (100000);
+  TcpHeader h;
+  std::vector<Ptr<Packet> > segments;
+  for (uint32_t i = 0; i < 4; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (100);
+      p->AddByteTag (FlowIdTag (i));
+      p->AddPacketTag (FlowIdTag (i));
+      segments.push_back (p);
+    }
+
+  // A segment extracted as a whole is delivered as is, hence with the uid
+  // of the received packet, its byte tags and without its packet tags
+  h.SetSequenceNumber (SequenceNumber32 (1));
+  rxBuf.Add (segments[0], h);
+  Ptr<Packet> p = rxBuf.Extract (100);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 100, "Wrong extracted size");
+  NS_TEST_EXPECT_MSG_EQ (p->GetUid (), segments[0]->GetUid (), "The uid of the received packet should be kept");
+  FlowIdTag tag;
+  NS_TEST_EXPECT_MSG_EQ (p->PeekPacketTag (tag), false, "Packet tags should be removed");
+  CheckByteTags (p, {0}, {0}, {100});
+
+  // Segments received out of order and extracted together are appended to
+  // a new packet, with the byte tags of every segment
+  h.SetSequenceNumber (SequenceNumber32 (201));
+  rxBuf.Add (segments[2], h);
+  h.SetSequenceNumber (SequenceNumber32 (101));
+  rxBuf.Add (segments[1], h);
+  p = rxBuf.Extract (200);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 200, "Wrong extracted size");
+  NS_TEST_EXPECT_MSG_NE (p->GetUid (), segments[2]->GetUid (), "The uid of the last segment should not be kept");
+  NS_TEST_EXPECT_MSG_EQ (p->PeekPacketTag (tag), false, "Packet tags should be removed");
+  CheckByteTags (p, {1, 2}, {0, 100}, {100, 200});
+
+  // A segment overlapping with the buffered data and extracted in two parts
+  // keeps its byte tag on the bytes that were stored
+  h.SetSequenceNumber (SequenceNumber32 (251));
+  rxBuf.Add (segments[3], h);
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Available (), 50, "Wrong available data");
+  p = rxBuf.Extract (20);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 20, "Wrong extracted size");
+  CheckByteTags (p, {3}, {0}, {20});
+  p = rxBuf.Extract (100);
+  NS_TEST_ASSERT_MSG_EQ (p->GetSize (), 30, "Wrong extracted size");
+  CheckByteTags (p, {3}, {0}, {30});
+  NS_TEST_ASSERT_MSG_EQ (rxBuf.Size (), 0, "The buffer should be empty");
+}
+
 void
 TcpRxBufferTestCase::DoTeardown ()
 {
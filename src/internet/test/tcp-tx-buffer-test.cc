@@ -49,6 +49,8 @@ private:
   void TestTransmittedBlock ();
   /** \brief Test the generation of the "next" block */
   void TestNextSeg ();
+  /** \brief Test the scoreboard with many segments in flight */
+  void TestLargeScoreboard ();
 };
 
 TcpTxBufferTestCase::TcpTxBufferTestCase ()
@@ -81,6 +83,8 @@ TcpTxBufferTestCase::DoRun ()
                        &TcpTxBufferTestCase::TestTransmittedBlock, this);
   Simulator::Schedule (Seconds (0.0),
                        &TcpTxBufferTestCase::TestNextSeg, this);
+  Simulator::Schedule (Seconds (0.0),
+                       &TcpTxBufferTestCase::TestLargeScoreboard, this);
 
   Simulator::Run ();
   Simulator::Destroy ();
@@ -342,6 +346,75 @@ TcpTxBufferTestCase::TestTransmittedBlock ()
 {
 }
 
+void
+TcpTxBufferTestCase::TestLargeScoreboard ()
+{
+  TcpTxBuffer txBuf;
+  SequenceNumber32 head (1);
+  txBuf.SetHeadSequence (head);
+  txBuf.SetMaxBufferSize (1000000);
+  txBuf.SetSegmentSize (1000);
+  txBuf.SetDupAckThresh (3);
+  SequenceNumber32 ret;
+
+  // 1000 segments in flight
+  txBuf.Add (Create<Packet> (1000000));
+  for (uint32_t i = 0; i < 1000; ++i)
+    {
+      txBuf.CopyFromSequence (1000, head + i * 1000);
+    }
+
+  // In the first half, one segment every ten is lost, and the following
+  // nine are sacked
+  for (uint32_t i = 0; i < 500; i += 10)
+    {
+      TcpOptionSack::SackList sackList;
+      sackList.push_back (TcpOptionSack::SackBlock (head + (i + 1) * 1000, head + (i + 10) * 1000));
+      uint32_t bytesSacked = txBuf.Update (sackList);
+      NS_TEST_ASSERT_MSG_EQ (bytesSacked, 9000, "Wrong number of bytes sacked by block " << i);
+      // A SACK block already received does not change anything
+      bytesSacked = txBuf.Update (sackList);
+      NS_TEST_ASSERT_MSG_EQ (bytesSacked, 0, "A block already received sacked again " << i);
+    }
+
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetSacked (), 450000, "Wrong sacked bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetLost (), 50000, "Wrong lost bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.BytesInFlight (), 500000, "Wrong bytes in flight");
+  for (uint32_t i = 0; i < 500; i += 10)
+    {
+      NS_TEST_ASSERT_MSG_EQ (txBuf.IsLost (head + i * 1000), true, "Hole " << i << " is not lost");
+      NS_TEST_ASSERT_MSG_EQ (txBuf.IsLost (head + (i + 1) * 1000), false, "Segment " << i + 1 << " is lost");
+    }
+  NS_TEST_ASSERT_MSG_EQ (txBuf.IsLost (head + 500000), false, "Segment above the SACK blocks is lost");
+
+  // The holes are retransmitted in order
+  for (uint32_t i = 0; i < 500; i += 10)
+    {
+      NS_TEST_ASSERT_MSG_EQ (txBuf.NextSeg (&ret, true), true, "No NextSeg for hole " << i);
+      NS_TEST_ASSERT_MSG_EQ (ret, head + i * 1000, "Wrong NextSeg for hole " << i);
+      txBuf.CopyFromSequence (1000, ret);
+    }
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetRetransmitsCount (), 50000, "Wrong retransmitted bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.BytesInFlight (), 550000, "Wrong bytes in flight");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.NextSeg (&ret, false), false, "Nothing should be sent out of recovery");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.NextSeg (&ret, true), true, "No NextSeg per rule 3");
+  NS_TEST_ASSERT_MSG_EQ (ret, head + 500000, "Wrong NextSeg per rule 3");
+
+  // The retransmissions (but the head) are received
+  TcpOptionSack::SackList sackList;
+  sackList.push_back (TcpOptionSack::SackBlock (head + 1000, head + 500000));
+  uint32_t bytesSacked = txBuf.Update (sackList);
+  NS_TEST_ASSERT_MSG_EQ (bytesSacked, 49000, "Wrong number of bytes sacked by the merged block");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetSacked (), 499000, "Wrong sacked bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetLost (), 1000, "Wrong lost bytes");
+
+  txBuf.DiscardUpTo (head + 500000);
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetSacked (), 0, "Wrong sacked bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetLost (), 0, "Wrong lost bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.GetRetransmitsCount (), 0, "Wrong retransmitted bytes");
+  NS_TEST_ASSERT_MSG_EQ (txBuf.BytesInFlight (), 500000, "Wrong bytes in flight");
+}
+
 void
 TcpTxBufferTestCase::DoTeardown ()
 {
@@ -36,7 +36,11 @@
 #include <ns3/simulator.h>
 #include <ns3/node.h>
 #include <ns3/buildings-helper.h>
+#include <ns3/building-list.h>
 #include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-spectrum-signal-parameters.h>
+#include <ns3/analytical-rem-generator.h>
+#include <ns3/antenna-model.h>
 
 #include <fstream>
 #include <limits>
@@ -62,6 +66,7 @@ void
 RadioEnvironmentMapHelper::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
+  m_transmissions.clear ();
 }
 
 TypeId
@@ -144,6 +149,21 @@ RadioEnvironmentMapHelper::GetTypeId (void)
                    IntegerValue (-1),
                    MakeIntegerAccessor (&RadioEnvironmentMapHelper::m_rbId),
                    MakeIntegerChecker<int32_t> ())
+    .AddAttribute ("Analytical",
+                   "If true, the REM is generated at once by evaluating analytically "
+                   "the frames transmitted on the channel during the subframe preceding "
+                   "the generation, rather than by attaching a receiver per point to the channel",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&RadioEnvironmentMapHelper::m_analytical),
+                   MakeBooleanChecker ())
+    .AddAttribute ("Threads",
+                   "Number of threads over which the points are spread when the REM is "
+                   "generated analytically. Only one thread is used if there are buildings, "
+                   "and the propagation loss models must not keep any state per link "
+                   "(e.g., shadowing or fading) when several threads are used.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&RadioEnvironmentMapHelper::m_threads),
+                   MakeUintegerChecker<uint32_t> (1, std::numeric_limits<uint32_t>::max ()))
   ;
   return tid;
 }
@@ -208,6 +228,12 @@ RadioEnvironmentMapHelper::Install ()
       startDelay = 0.5001;
     }
 
+  if (m_analytical)
+    {
+      Simulator::Schedule (Seconds (startDelay - 0.001),
+                           &RadioEnvironmentMapHelper::StartRecording,
+                           this);
+    }
   Simulator::Schedule (Seconds (startDelay),
                        &RadioEnvironmentMapHelper::DelayedInstall,
                        this);
@@ -218,6 +244,11 @@ void
 RadioEnvironmentMapHelper::DelayedInstall ()
 {
   NS_LOG_FUNCTION (this);
+  if (m_analytical)
+    {
+      GenerateAnalytically ();
+      return;
+    }
   m_xStep = (m_xMax - m_xMin)/(m_xRes-1);
   m_yStep = (m_yMax - m_yMin)/(m_yRes-1);
   
@@ -351,5 +382,100 @@ RadioEnvironmentMapHelper::Finalize ()
     }
 }
 
+void
+RadioEnvironmentMapHelper::StartRecording ()
+{
+  NS_LOG_FUNCTION (this);
+  m_channel->TraceConnectWithoutContext ("TxSigParams",
+                                         MakeCallback (&RadioEnvironmentMapHelper::RecordTransmission, this));
+}
+
+void
+RadioEnvironmentMapHelper::RecordTransmission (Ptr<SpectrumSignalParameters> params)
+{
+  NS_LOG_FUNCTION (this << params);
+  bool recorded;
+  if (m_useDataChannel)
+    {
+      recorded = DynamicCast<LteSpectrumSignalParametersDataFrame> (params) != 0;
+    }
+  else
+    {
+      recorded = DynamicCast<LteSpectrumSignalParametersDlCtrlFrame> (params) != 0;
+    }
+  if (recorded)
+    {
+      m_transmissions[params->txPhy] = params;
+    }
+}
+
+void
+RadioEnvironmentMapHelper::GenerateAnalytically ()
+{
+  NS_LOG_FUNCTION (this);
+  m_channel->TraceDisconnectWithoutContext ("TxSigParams",
+                                            MakeCallback (&RadioEnvironmentMapHelper::RecordTransmission, this));
+
+  AnalyticalRemGenerator generator;
+  generator.SetChannel (m_channel);
+  generator.SetRxSpectrumModel (LteSpectrumValueHelper::GetSpectrumModel (m_earfcn, m_bandwidth));
+  generator.SetPositionCallback (MakeCallback (&RadioEnvironmentMapHelper::MakeConsistent));
+  generator.SetGrid (m_xMin, m_xMax, m_xRes, m_yMin, m_yMax, m_yRes, m_z);
+  uint32_t threads = m_threads;
+  if (threads > 1 && BuildingList::GetNBuildings () > 0)
+    {
+      // the building information of the mobility models refers to the
+      // buildings, whose reference counts cannot be shared between threads
+      NS_LOG_WARN ("the REM is generated by a single thread as there are buildings");
+      threads = 1;
+    }
+  generator.SetThreads (threads);
+  for (std::map<Ptr<SpectrumPhy>, Ptr<SpectrumSignalParameters> >::const_iterator it = m_transmissions.begin ();
+       it != m_transmissions.end ();
+       ++it)
+    {
+      generator.AddTransmitter (it->first->GetMobility (), it->second->psd, it->second->txAntenna);
+    }
+  m_transmissions.clear ();
+  NS_LOG_LOGIC ("generating the REM for " << generator.GetNTransmitters () << " transmitters");
+  generator.Generate (MakeCallback (&RadioEnvironmentMapHelper::EvaluatePoint, this), m_outFile);
+  Finalize ();
+}
+
+void
+RadioEnvironmentMapHelper::EvaluatePoint (const std::vector<SpectrumValue> &rxPsds, std::vector<double> &values) const
+{
+  double sumPower = 0;
+  double referenceSignalPower = 0;
+  for (std::vector<SpectrumValue>::const_iterator it = rxPsds.begin (); it != rxPsds.end (); ++it)
+    {
+      double power = 0;
+      if (m_rbId >= 0)
+        {
+          power = (*it)[m_rbId] * 180000;
+        }
+      else
+        {
+          power = Integral (*it);
+        }
+      sumPower += power;
+      if (power > referenceSignalPower)
+        {
+          referenceSignalPower = power;
+        }
+    }
+  values.assign (1, referenceSignalPower / (sumPower - referenceSignalPower + m_noisePower));
+}
+
+void
+RadioEnvironmentMapHelper::MakeConsistent (Ptr<MobilityModel> mm)
+{
+  if (mm->GetObject<MobilityBuildingInfo> () == 0)
+    {
+      mm->AggregateObject (CreateObject<MobilityBuildingInfo> ());
+    }
+  BuildingsHelper::MakeConsistent (mm);
+}
+
 
 } // namespace ns3
@@ -25,6 +25,8 @@
 
 #include <ns3/object.h>
 #include <fstream>
+#include <map>
+#include <vector>
 
 
 namespace ns3 {
@@ -35,13 +37,17 @@ class NetDevice;
 class SpectrumChannel;
 //class BuildingsMobilityModel;
 class MobilityModel;
+class SpectrumPhy;
+class SpectrumSignalParameters;
+class SpectrumValue;
 
 /** 
  * \ingroup lte
  *
  * Generates a 2D map of the SINR from the strongest transmitter in the
- * downlink of an LTE FDD system. For instructions on usage, please refer to
- * the User Documentation.
+ * downlink of an LTE FDD system, either through the channel or analytically
+ * (see the `Analytical` attribute). For instructions on usage, please refer
+ * to the User Documentation.
  */
 class RadioEnvironmentMapHelper : public Object
 {
@@ -108,6 +114,45 @@ private:
   /// Called when the map generation procedure has been completed.
   void Finalize ();
 
+  /**
+   * Scheduled by Install() one millisecond before DelayedInstall() when the
+   * `Analytical` attribute is true, to start recording the signals
+   * transmitted on the channel.
+   */
+  void StartRecording ();
+
+  /**
+   * Record the last control (or data) frame transmitted by each
+   * transmitter on the channel.
+   *
+   * \param params the parameters of the signal transmitted
+   */
+  void RecordTransmission (Ptr<SpectrumSignalParameters> params);
+
+  /**
+   * Generate the whole map at once, with an AnalyticalRemGenerator
+   * evaluating the frames recorded. Called by DelayedInstall() when the
+   * `Analytical` attribute is true.
+   */
+  void GenerateAnalytically ();
+
+  /**
+   * Compute the SINR of a point of the map generated analytically, in the
+   * same way as RemSpectrumPhy.
+   *
+   * \param rxPsds the PSDs received from each transmitter
+   * \param values the SINR
+   */
+  void EvaluatePoint (const std::vector<SpectrumValue> &rxPsds, std::vector<double> &values) const;
+
+  /**
+   * Update the building information of a mobility model used by the
+   * AnalyticalRemGenerator, aggregating it if needed.
+   *
+   * \param mm the mobility model
+   */
+  static void MakeConsistent (Ptr<MobilityModel> mm);
+
   /// A complete Radio Environment Map is composed of many of this structure.
   struct RemPoint 
   {
@@ -152,6 +197,12 @@ private:
   bool m_useDataChannel;  ///< The `UseDataChannel` attribute.
   int32_t m_rbId;         ///< The `RbId` attribute.
 
+  bool m_analytical;   ///< The `Analytical` attribute.
+  uint32_t m_threads;  ///< The `Threads` attribute.
+
+  /// The last frame transmitted by each transmitter, recorded when the map is generated analytically.
+  std::map<Ptr<SpectrumPhy>, Ptr<SpectrumSignalParameters> > m_transmissions;
+
 }; // end of `class RadioEnvironmentMapHelper`
 
 
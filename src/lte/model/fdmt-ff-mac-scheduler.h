@@ -32,6 +32,7 @@
 #include <ns3/nstime.h>
 #include <ns3/lte-amc.h>
 #include <ns3/lte-ffr-sap.h>
+#include <ns3/ff-mac-rbg-allocator.h>
 
 /**
  * value for SINR outside the range defined by FF-API, used to indicate that there
@@ -284,6 +285,8 @@ private:
 
   Ptr<LteAmc> m_amc; ///< amc
 
+  FfMacRbgAllocator m_rbgAllocator; ///< the allocation of the RBGs to the UEs with the highest metric
+
   /**
    * Vectors of UE's LC info
   */
@@ -0,0 +1,130 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <ns3/log.h>
+#include <ns3/lte-amc.h>
+#include <ns3/ff-mac-rbg-allocator.h>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("FfMacRbgAllocator");
+
+FfMacRbgAllocator::FfMacRbgAllocator ()
+  : m_rbgNum (0),
+    m_rbgSize (0),
+    m_lowestMcsRate (0.0)
+{
+  for (int cqi = 0; cqi < 16; cqi++)
+    {
+      m_cqiRate[cqi] = 0.0;
+    }
+}
+
+void
+FfMacRbgAllocator::Reset (int rbgNum, int rbgSize, Ptr<LteAmc> amc)
+{
+  NS_LOG_FUNCTION (this << rbgNum << rbgSize);
+  m_rbgNum = rbgNum;
+  m_rntis.clear ();
+  m_metrics.clear ();
+  if (amc != m_amc || rbgSize != m_rbgSize)
+    {
+      m_amc = amc;
+      m_rbgSize = rbgSize;
+      for (int cqi = 0; cqi < 16; cqi++)
+        {
+          m_cqiRate[cqi] = ((m_amc->GetDlTbSizeFromMcs (m_amc->GetMcsFromCqi (cqi), rbgSize) / 8) / 0.001); // = TB size / TTI
+        }
+      m_lowestMcsRate = ((m_amc->GetDlTbSizeFromMcs (0, rbgSize) / 8) / 0.001);
+    }
+}
+
+double*
+FfMacRbgAllocator::AddUe (uint16_t rnti)
+{
+  m_rntis.push_back (rnti);
+  m_metrics.resize (m_rntis.size () * m_rbgNum, 0.0);
+  return &m_metrics[(m_rntis.size () - 1) * m_rbgNum];
+}
+
+uint32_t
+FfMacRbgAllocator::GetNUes (void) const
+{
+  return m_rntis.size ();
+}
+
+double
+FfMacRbgAllocator::GetRbgRate (const std::vector<uint8_t> &sbCqi, int nLayer) const
+{
+  double achievableRate = 0.0;
+  for (int k = 0; k < nLayer; k++)
+    {
+      if (sbCqi.size () > (uint32_t) k)
+        {
+          NS_ASSERT_MSG (sbCqi[k] < 16, "CQI must be in [0..15] = " << (uint16_t) sbCqi[k]);
+          achievableRate += m_cqiRate[sbCqi[k]];
+        }
+      else
+        {
+          // no info on this subband -> worst MCS
+          achievableRate += m_lowestMcsRate;
+        }
+    }
+  return achievableRate;
+}
+
+void
+FfMacRbgAllocator::Allocate (std::vector<bool> &rbgMap, std::map<uint16_t, std::vector<uint16_t> > &allocationMap)
+{
+  NS_LOG_FUNCTION (this << m_rntis.size ());
+  m_bestMetric.assign (m_rbgNum, 0.0);
+  m_bestUe.assign (m_rbgNum, -1);
+  double *bestMetric = m_bestMetric.data ();
+  int32_t *bestUe = m_bestUe.data ();
+  for (uint32_t ue = 0; ue < m_rntis.size (); ue++)
+    {
+      const double *metrics = &m_metrics[ue * m_rbgNum];
+      for (int i = 0; i < m_rbgNum; i++)
+        {
+          if (metrics[i] > bestMetric[i])
+            {
+              bestMetric[i] = metrics[i];
+              bestUe[i] = ue;
+            }
+        }
+    }
+
+  for (int i = 0; i < m_rbgNum; i++)
+    {
+      if (rbgMap.at (i) == true)
+        {
+          continue;
+        }
+      if (bestUe[i] < 0)
+        {
+          // no UE available for this RB
+          NS_LOG_INFO (this << " any UE found for RBG " << i);
+        }
+      else
+        {
+          rbgMap.at (i) = true;
+          allocationMap[m_rntis[bestUe[i]]].push_back (i);
+          NS_LOG_INFO (this << " RBG " << i << " assigned to UE " << m_rntis[bestUe[i]]);
+        }
+    }
+}
+
+} // namespace ns3
@@ -50,7 +50,6 @@ void
 LteChunkProcessor::Start ()
 {
   NS_LOG_FUNCTION (this);
-  m_sumValues = 0;
   m_totDuration = MicroSeconds (0);
 }
 
@@ -59,11 +58,31 @@ void
 LteChunkProcessor::EvaluateChunk (const SpectrumValue& sinr, Time duration)
 {
   NS_LOG_FUNCTION (this << sinr << duration);
-  if (m_sumValues == 0)
+  if (m_sumValues == 0 || m_sumValues->GetSpectrumModelUid () != sinr.GetSpectrumModelUid ())
     {
+      NS_ASSERT (m_totDuration.IsZero ());
       m_sumValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
+      m_meanValues = Create<SpectrumValue> (sinr.GetSpectrumModel ());
+    }
+  double seconds = duration.GetSeconds ();
+  uint32_t nValues = sinr.GetSpectrumModel ()->GetNumBands ();
+  const double *value = &(*sinr.ConstValuesBegin ());
+  double *sum = &(*m_sumValues->ValuesBegin ());
+  if (m_totDuration.IsZero ())
+    {
+      // first chunk since Start (): overwrite the values of the previous reception
+      for (uint32_t i = 0; i < nValues; ++i)
+        {
+          sum[i] = value[i] * seconds;
+        }
+    }
+  else
+    {
+      for (uint32_t i = 0; i < nValues; ++i)
+        {
+          sum[i] += value[i] * seconds;
+        }
     }
-  (*m_sumValues) += sinr * duration.GetSeconds ();
   m_totDuration += duration;
 }
 
@@ -73,10 +92,18 @@ LteChunkProcessor::End ()
   NS_LOG_FUNCTION (this);
   if (m_totDuration.GetSeconds () > 0)
     {
+      double seconds = m_totDuration.GetSeconds ();
+      uint32_t nValues = m_sumValues->GetSpectrumModel ()->GetNumBands ();
+      const double *sum = &(*m_sumValues->ConstValuesBegin ());
+      double *mean = &(*m_meanValues->ValuesBegin ());
+      for (uint32_t i = 0; i < nValues; ++i)
+        {
+          mean[i] = sum[i] / seconds;
+        }
       std::vector<LteChunkProcessorCallback>::iterator it;
       for (it = m_lteChunkProcessorCallbacks.begin (); it != m_lteChunkProcessorCallbacks.end (); it++)
         {
-          (*it)((*m_sumValues) / m_totDuration.GetSeconds ());
+          (*it)(*m_meanValues);
         }
     }
   else
@@ -72,6 +72,8 @@ public:
     * \brief Collect SpectrumValue and duration of signal
     *
     * Passed values are collected in m_sumValues and m_totDuration variables.
+    * The values are accumulated in place, without allocating a new
+    * SpectrumValue per chunk.
     *
     * \param sinr the SINR
     * \param duration the duration
@@ -88,7 +90,8 @@ public:
   virtual void End ();
 
 private:
-  Ptr<SpectrumValue> m_sumValues; ///< sum values
+  Ptr<SpectrumValue> m_sumValues; ///< sum values, reused across receptions
+  Ptr<SpectrumValue> m_meanValues; ///< mean values reported at the end, reused across receptions
   Time m_totDuration; ///< total duration
 
   std::vector<LteChunkProcessorCallback> m_lteChunkProcessorCallbacks; ///< chunk processor callback
@@ -47,10 +47,13 @@ void
 LteInterference::DoDispose ()
 {
   NS_LOG_FUNCTION (this);
-  m_rsPowerChunkProcessorList.clear ();
-  m_sinrChunkProcessorList.clear ();
-  m_interfChunkProcessorList.clear ();
+  for (uint32_t t = 0; t < N_CHUNK_SINK_TYPES; ++t)
+    {
+      m_chunkSinks[t].clear ();
+    }
   m_rxSignal = 0;
+  m_interf = 0;
+  m_sinr = 0;
   m_allSignals = 0;
   m_noise = 0;
   Object::DoDispose ();
@@ -78,17 +81,12 @@ LteInterference::StartRx (Ptr<const SpectrumValue> rxPsd)
       m_rxSignal = rxPsd->Copy ();
       m_lastChangeTime = Now ();
       m_receiving = true;
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
-        {
-          (*it)->Start ();
-        }
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_interfChunkProcessorList.begin (); it != m_interfChunkProcessorList.end (); ++it)
+      for (uint32_t t = 0; t < N_CHUNK_SINK_TYPES; ++t)
         {
-          (*it)->Start ();
-        }
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
-        {
-          (*it)->Start (); 
+          for (std::vector<Ptr<LteChunkProcessor> >::const_iterator it = m_chunkSinks[t].begin (); it != m_chunkSinks[t].end (); ++it)
+            {
+              (*it)->Start ();
+            }
         }
     }
   else
@@ -115,17 +113,12 @@ LteInterference::EndRx ()
     {
       ConditionallyEvaluateChunk ();
       m_receiving = false;
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
+      for (uint32_t t = 0; t < N_CHUNK_SINK_TYPES; ++t)
         {
-          (*it)->End ();
-        }
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_interfChunkProcessorList.begin (); it != m_interfChunkProcessorList.end (); ++it)
-        {
-          (*it)->End ();
-        }
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
-        {
-          (*it)->End (); 
+          for (std::vector<Ptr<LteChunkProcessor> >::const_iterator it = m_chunkSinks[t].begin (); it != m_chunkSinks[t].end (); ++it)
+            {
+              (*it)->End ();
+            }
         }
     }
 }
@@ -188,19 +181,36 @@ LteInterference::ConditionallyEvaluateChunk ()
     {
       NS_LOG_LOGIC (this << " signal = " << *m_rxSignal << " allSignals = " << *m_allSignals << " noise = " << *m_noise);
 
-      SpectrumValue interf =  (*m_allSignals) - (*m_rxSignal) + (*m_noise);
-
-      SpectrumValue sinr = (*m_rxSignal) / interf;
       Time duration = Now () - m_lastChangeTime;
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_sinrChunkProcessorList.begin (); it != m_sinrChunkProcessorList.end (); ++it)
+      const std::vector<Ptr<LteChunkProcessor> > &sinrSinks = m_chunkSinks[SINR_SINK];
+      const std::vector<Ptr<LteChunkProcessor> > &interfSinks = m_chunkSinks[INTERFERENCE_SINK];
+      const std::vector<Ptr<LteChunkProcessor> > &rsPowerSinks = m_chunkSinks[RS_POWER_SINK];
+      if (!sinrSinks.empty () || !interfSinks.empty ())
+        {
+          // interference plus noise and SINR evaluated in a single pass
+          // over the resource blocks, in buffers reused across chunks
+          uint32_t nRbs = m_noise->GetSpectrumModel ()->GetNumBands ();
+          NS_ASSERT (m_rxSignal->GetSpectrumModelUid () == m_noise->GetSpectrumModelUid ());
+          const double *allSignals = &(*m_allSignals->ConstValuesBegin ());
+          const double *rxSignal = &(*m_rxSignal->ConstValuesBegin ());
+          const double *noise = &(*m_noise->ConstValuesBegin ());
+          double *interf = &(*m_interf->ValuesBegin ());
+          double *sinr = &(*m_sinr->ValuesBegin ());
+          for (uint32_t i = 0; i < nRbs; ++i)
+            {
+              interf[i] = allSignals[i] - rxSignal[i] + noise[i];
+              sinr[i] = rxSignal[i] / interf[i];
+            }
+        }
+      for (std::vector<Ptr<LteChunkProcessor> >::const_iterator it = sinrSinks.begin (); it != sinrSinks.end (); ++it)
         {
-          (*it)->EvaluateChunk (sinr, duration);
+          (*it)->EvaluateChunk (*m_sinr, duration);
         }
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_interfChunkProcessorList.begin (); it != m_interfChunkProcessorList.end (); ++it)
+      for (std::vector<Ptr<LteChunkProcessor> >::const_iterator it = interfSinks.begin (); it != interfSinks.end (); ++it)
         {
-          (*it)->EvaluateChunk (interf, duration);
+          (*it)->EvaluateChunk (*m_interf, duration);
         }
-      for (std::list<Ptr<LteChunkProcessor> >::const_iterator it = m_rsPowerChunkProcessorList.begin (); it != m_rsPowerChunkProcessorList.end (); ++it)
+      for (std::vector<Ptr<LteChunkProcessor> >::const_iterator it = rsPowerSinks.begin (); it != rsPowerSinks.end (); ++it)
         {
           (*it)->EvaluateChunk (*m_rxSignal, duration);
         }
@@ -217,6 +227,8 @@ LteInterference::SetNoisePowerSpectralDensity (Ptr<const SpectrumValue> noisePsd
   // reset m_allSignals (will reset if already set previously)
   // this is needed since this method can potentially change the SpectrumModel
   m_allSignals = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_interf = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
+  m_sinr = Create<SpectrumValue> (noisePsd->GetSpectrumModel ());
   if (m_receiving == true)
     {
       // abort rx
@@ -231,21 +243,21 @@ void
 LteInterference::AddRsPowerChunkProcessor (Ptr<LteChunkProcessor> p)
 {
   NS_LOG_FUNCTION (this << p);
-  m_rsPowerChunkProcessorList.push_back (p);
+  m_chunkSinks[RS_POWER_SINK].push_back (p);
 }
 
 void
 LteInterference::AddSinrChunkProcessor (Ptr<LteChunkProcessor> p)
 {
   NS_LOG_FUNCTION (this << p);
-  m_sinrChunkProcessorList.push_back (p);
+  m_chunkSinks[SINR_SINK].push_back (p);
 }
 
 void
 LteInterference::AddInterferenceChunkProcessor (Ptr<LteChunkProcessor> p)
 {
   NS_LOG_FUNCTION (this << p);
-  m_interfChunkProcessorList.push_back (p);
+  m_chunkSinks[INTERFERENCE_SINK].push_back (p);
 }
 
 
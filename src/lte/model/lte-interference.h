@@ -27,7 +27,7 @@
 #include <ns3/nstime.h>
 #include <ns3/spectrum-value.h>
 
-#include <list>
+#include <vector>
 
 namespace ns3 {
 
@@ -136,6 +136,19 @@ private:
    */
   void DoSubtractSignal  (Ptr<const SpectrumValue> spd, uint32_t signalId);
 
+  /**
+   * The kinds of chunks to which a LteChunkProcessor may be registered.
+   * The processors are started and ended in this order, so that the power
+   * and interference are reported before the SINR (the PHYs rely on it).
+   */
+  enum ChunkSinkType
+  {
+    RS_POWER_SINK = 0,  ///< power of the signal being received
+    INTERFERENCE_SINK,  ///< interference plus noise power
+    SINR_SINK,          ///< SINR of the signal being received
+    N_CHUNK_SINK_TYPES  ///< number of kinds of chunks
+  };
+
 
 
   bool m_receiving; ///< are we receiving?
@@ -159,16 +172,11 @@ private:
   uint32_t m_lastSignalIdBeforeReset; ///< the last signal ID before reset
 
   /** all the processor instances that need to be notified whenever
-  a new interference chunk is calculated */
-  std::list<Ptr<LteChunkProcessor> > m_rsPowerChunkProcessorList;
+      a new chunk is calculated, per kind of chunk */
+  std::vector<Ptr<LteChunkProcessor> > m_chunkSinks[N_CHUNK_SINK_TYPES];
 
-  /** all the processor instances that need to be notified whenever
-      a new SINR chunk is calculated */
-  std::list<Ptr<LteChunkProcessor> > m_sinrChunkProcessorList;
-
-  /** all the processor instances that need to be notified whenever
-      a new interference chunk is calculated */
-  std::list<Ptr<LteChunkProcessor> > m_interfChunkProcessorList;
+  Ptr<SpectrumValue> m_interf; ///< the interference plus noise of the last chunk, reused across chunks
+  Ptr<SpectrumValue> m_sinr;   ///< the SINR of the last chunk, reused across chunks
 
 
 };
@@ -29,6 +29,7 @@
 *      Marco Miozzo <marco.miozzo@cttc.es>
 */ 
 
+#include <algorithm>
 #include <list>
 #include <vector>
 #include <ns3/log.h>
@@ -331,83 +332,144 @@ static const double cEcrTable [9][38] = {
 };
 
 
-double 
-LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+/**
+ * Lookup tables derived once, at startup, from the tables above, so that the
+ * evaluation of a TB only indexes arrays: the MI maps with their uniformly
+ * spaced SINR axes, the BLER curve parameters of each CB size with the missing
+ * ones already replaced, and the PCFICH+PDCCH error rate of each effective SINR
+ * of the QPSK MI map.
+ */
+struct LteMiErrorModelTables
 {
-  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
-  
-  double MI;
-  double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  
-  for (uint32_t i = 0; i < map.size (); i++)
+  LteMiErrorModelTables ();
+
+  /// MI map of a modulation over a uniformly spaced SINR axis
+  struct MiMap
+  {
+    const double *mi; ///< the MI values
+    double sinrMin; ///< the first SINR of the axis (linear)
+    double sinrMax; ///< the last SINR of the axis (linear)
+    double scalingCoeff; ///< the number of values per linear SINR unit
+    uint16_t size; ///< the number of values
+  };
+
+  MiMap miMaps[3]; ///< the MI maps of QPSK, 16QAM and 64QAM
+  double b[9][38]; ///< the b parameter of the BLER curve of each CB size and ECR
+  double sqrt2c[9][38]; ///< the c parameter of the BLER curve of each CB size and ECR, times sqrt(2)
+  double pdcchErrorRate[MI_MAP_QPSK_SIZE]; ///< the PCFICH+PDCCH error rate for each value of the QPSK SINR axis
+};
+
+LteMiErrorModelTables::LteMiErrorModelTables ()
+{
+  static const double *mi[3] = {MI_map_qpsk, MI_map_16qam, MI_map_64qam};
+  static const double *axis[3] = {MI_map_qpsk_axis, MI_map_16qam_axis, MI_map_64qam_axis};
+  static const uint16_t size[3] = {MI_MAP_QPSK_SIZE, MI_MAP_16QAM_SIZE, MI_MAP_64QAM_SIZE};
+  for (int m = 0; m < 3; m++)
     {
-      double sinrLin = sinrCopy[map.at (i)];
-      if (mcs <= MI_QPSK_MAX_ID) // QPSK
-        {
+      miMaps[m].mi = mi[m];
+      miMaps[m].sinrMin = axis[m][0];
+      miMaps[m].sinrMax = axis[m][size[m] - 1];
+      // since the values of the axis are uniformly spaced, we have
+      // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
+      miMaps[m].scalingCoeff = (size[m] - 1) / (axis[m][size[m] - 1] - axis[m][0]);
+      miMaps[m].size = size[m];
+    }
 
-          if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
+  for (int cbIndex = 0; cbIndex < 9; cbIndex++)
+    {
+      for (int ecrId = 0; ecrId < 38; ecrId++)
+        {
+          // take the lowest CB size including this CB for removing CB size
+          // quatization errors when the curve is missing
+          double bValue = bEcrTable[cbIndex][ecrId];
+          int i = cbIndex;
+          while ((i < 9) && (bValue < 0))
             {
-              MI = 1;
+              bValue = bEcrTable[i++][ecrId];
             }
-          else 
-            { 
-              // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-              // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-              static const double scalingCoeffQpsk = 
-                (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-              double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-              uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-              NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-              MI = MI_map_qpsk[sinrIndex];
+          double cValue = cEcrTable[cbIndex][ecrId];
+          i = cbIndex;
+          while ((i < 9) && (cValue < 0))
+            {
+              cValue = cEcrTable[i++][ecrId];
             }
+          b[cbIndex][ecrId] = bValue;
+          sqrt2c[cbIndex][ecrId] = sqrt (2) * cValue;
+        }
+    }
+
+  for (uint16_t j = 0; j < MI_MAP_QPSK_SIZE; j++)
+    {
+      double esirnDb = 10 * log10 (MI_map_qpsk_axis[j]);
+      uint16_t i = 0;
+      while ((i < PDCCH_PCFICH_CURVE_SIZE) && (PdcchPcfichBlerCurveXaxis[i] < esirnDb))
+        {
+          i++;
+        }
+      if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE - 1])
+        {
+          pdcchErrorRate[j] = 0.0;
         }
       else
         {
-          if (mcs > MI_QPSK_MAX_ID && mcs <= MI_16QAM_MAX_ID )	// 16-QAM
-            {
-              if (sinrLin > MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else 
-                {
-                  // since the values in MI_map_16QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff16qam = 
-                    (MI_MAP_16QAM_SIZE - 1) / (MI_map_16qam_axis[MI_MAP_16QAM_SIZE-1] - MI_map_16qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_16qam_axis[0]) * scalingCoeff16qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_16QAM_SIZE, "MI map out of data");
-                  MI = MI_map_16qam[sinrIndex];
-                }
-            }
-          else // 64-QAM
-            {
-              if (sinrLin > MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1])
-                {
-                  MI = 1;
-                }
-              else
-                {
-                  // since the values in MI_map_64QAM_axis are uniformly spaced, we have
-                  // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-                  // the scaling coefficient is always the same, so we use a static const
-                  // to speed up the calculation
-                  static const double scalingCoeff64qam = 
-                    (MI_MAP_64QAM_SIZE - 1) / (MI_map_64qam_axis[MI_MAP_64QAM_SIZE-1] - MI_map_64qam_axis[0]);
-                  double sinrIndexDouble = (sinrLin -  MI_map_64qam_axis[0]) * scalingCoeff64qam + 1;
-                  uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-                  NS_ASSERT_MSG (sinrIndex < MI_MAP_64QAM_SIZE, "MI map out of data");
-                  MI = MI_map_64qam[sinrIndex];
-                }
-            }
+          NS_ASSERT_MSG (i < PDCCH_PCFICH_CURVE_SIZE, "PDCCH-PCFICH map out of data");
+          pdcchErrorRate[j] = PdcchPcfichBlerCurveYaxis[i];
         }
-      NS_LOG_LOGIC (" RB " << map.at (i) << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
+    }
+}
+
+/// the lookup tables, built at startup
+static const LteMiErrorModelTables g_miErrorModelTables;
+
+/**
+ * \param mcs the MCS
+ * \return the index of the MI map of the modulation of the MCS
+ */
+static inline int
+MiMapIndex (uint8_t mcs)
+{
+  if (mcs <= MI_QPSK_MAX_ID)
+    {
+      return 0; // QPSK
+    }
+  else if (mcs <= MI_16QAM_MAX_ID)
+    {
+      return 1; // 16-QAM
+    }
+  return 2; // 64-QAM
+}
+
+
+double
+LteMiErrorModel::RbMi (double sinrLin, uint8_t mcs)
+{
+  const LteMiErrorModelTables::MiMap &miMap = g_miErrorModelTables.miMaps[MiMapIndex (mcs)];
+  if (sinrLin > miMap.sinrMax)
+    {
+      return 1;
+    }
+  double sinrIndexDouble = (sinrLin - miMap.sinrMin) * miMap.scalingCoeff + 1;
+  uint32_t sinrIndex = std::max (0.0, std::floor (sinrIndexDouble));
+  NS_ASSERT_MSG (sinrIndex < miMap.size, "MI map out of data");
+  return miMap.mi[sinrIndex];
+}
+
+
+double 
+LteMiErrorModel::Mib (const SpectrumValue& sinr, const std::vector<int>& map, uint8_t mcs)
+{
+  NS_LOG_FUNCTION (sinr << &map << (uint32_t) mcs);
+  
+  double MI;
+  double MIsum = 0.0;
+  const double *sinrValues = &(*sinr.ConstValuesBegin ());
+  NS_ASSERT (map.empty () || *std::max_element (map.begin (), map.end ()) < (int) sinr.GetSpectrumModel ()->GetNumBands ());
+  
+  for (uint32_t i = 0; i < map.size (); i++)
+    {
+      double sinrLin = sinrValues[map[i]];
+      MI = RbMi (sinrLin, mcs);
+      NS_LOG_LOGIC (" RB " << map[i] << "Minimum SNR = " << 10 * std::log10 (sinrLin) << " dB, " << sinrLin << " V, MCS = " << (uint16_t)mcs << ", MI = " << MI);
       MIsum += MI;
     }
   MI = MIsum / map.size ();
@@ -420,8 +482,6 @@ double
 LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
 {
   NS_LOG_FUNCTION (mib << (uint32_t) ecrId << (uint32_t) cbSize);
-  double b = 0;
-  double c = 0;
 
   NS_ASSERT_MSG (ecrId <= MI_64QAM_BLER_MAX_ID, "ECR out of range [0..37]: " << (uint16_t) ecrId);
   int cbIndex = 1;
@@ -432,31 +492,11 @@ LteMiErrorModel::MappingMiBler (double mib, uint8_t ecrId, uint16_t cbSize)
   cbIndex--;
   NS_LOG_LOGIC (" ECRid " << (uint16_t)ecrId << " ECR " << BlerCurvesEcrMap[ecrId] << " CB size " << cbSize << " CB size curve " << cbMiSizeTable[cbIndex]);
 
-  b = bEcrTable[cbIndex][ecrId];
-  if (b<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(b<0))
-        {
-          b = bEcrTable[i++][ecrId];
-        }
-    }
-  c = cEcrTable[cbIndex][ecrId];
-  if (c<0.0)
-    {
-      //take the lowest CB size including this CB for removing CB size
-      //quatization errors
-      int i = cbIndex;
-      while ((i<9)&&(c<0))
-        {
-          c = cEcrTable[i++][ecrId];
-        }
-    }
+  double b = g_miErrorModelTables.b[cbIndex][ecrId];
+  double sqrt2c = g_miErrorModelTables.sqrt2c[cbIndex][ecrId];
   // see IEEE802.16m EMD formula 55 of section 4.3.2.1
-  double bler = 0.5*( 1 - erf((mib-b)/(sqrt(2)*c)) );
-  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << c);
+  double bler = 0.5*( 1 - erf((mib-b)/sqrt2c) );
+  NS_LOG_LOGIC ("MIB: " << mib << " BLER:" << bler << " b:" << b << " c:" << sqrt2c / sqrt (2));
   return bler;
 }
 
@@ -468,97 +508,88 @@ LteMiErrorModel::GetPcfichPdcchError (const SpectrumValue& sinr)
   NS_LOG_FUNCTION (sinr);
   double MI;
   double MIsum = 0.0;
-  SpectrumValue sinrCopy = sinr;
-  Values::iterator sinrIt = sinrCopy.ValuesBegin ();
-  uint16_t rb = 0;
-  NS_ASSERT (sinrIt!=sinrCopy.ValuesEnd ());
-  while (sinrIt!=sinrCopy.ValuesEnd ())
+  const double *sinrValues = &(*sinr.ConstValuesBegin ());
+  uint32_t nRbs = sinr.GetSpectrumModel ()->GetNumBands ();
+  NS_ASSERT (nRbs > 0);
+  for (uint32_t rb = 0; rb < nRbs; rb++)
     {
-      double sinrLin = *sinrIt;
-      if (sinrLin > MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1])
-        {
-          MI = 1;
-        }
-      else 
-        { 
-          // since the values in MI_map_qpsk_axis are uniformly spaced, we have
-          // index = ((sinrLin - value[0]) / (value[SIZE-1] - value[0])) * (SIZE-1)
-              // the scaling coefficient is always the same, so we use a static const
-              // to speed up the calculation
-          static const double scalingCoeffQpsk = 
-            (MI_MAP_QPSK_SIZE - 1) / (MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1] - MI_map_qpsk_axis[0]);
-          double sinrIndexDouble = (sinrLin -  MI_map_qpsk_axis[0]) * scalingCoeffQpsk + 1;
-          uint32_t sinrIndex = std::max(0.0, std::floor (sinrIndexDouble));
-          NS_ASSERT_MSG (sinrIndex < MI_MAP_QPSK_SIZE, "MI map out of data");
-          MI = MI_map_qpsk[sinrIndex];
-        }
-      MIsum += MI;
-      sinrIt++;
-      rb++;
-    }
-  MI = MIsum / rb;
-  // return to the effective SINR value
-  int j = 0;
-  double esinr = 0.0;
-  while ((j<MI_MAP_QPSK_SIZE)&&(MI_map_qpsk[j] < MI))
-    {
-      j++;
+      MIsum += RbMi (sinrValues[rb], 0);
     }
+  MI = MIsum / nRbs;
+  // return to the effective SINR value, i.e., the closest value (when
+  // possible) of the QPSK axis, whose PCFICH+PDCCH error rate is tabulated
+  uint16_t j = std::lower_bound (MI_map_qpsk, MI_map_qpsk + MI_MAP_QPSK_SIZE, MI) - MI_map_qpsk;
+  uint16_t esinrIndex = 0;
   if (MI > MI_map_qpsk[MI_MAP_QPSK_SIZE-1])
     {
-      esinr = MI_map_qpsk_axis[MI_MAP_QPSK_SIZE-1];
+      esinrIndex = MI_MAP_QPSK_SIZE - 1;
     }
-  else 
+  else if (j > 0)
     {
       NS_ASSERT_MSG (j<MI_MAP_QPSK_SIZE, "MI map out of data");
-      // take the closest value (when possible)  
-      if (j>0)
+      if ((MI_map_qpsk[j]-MI)<(MI-MI_map_qpsk[j-1]))
         {
-          if ((MI_map_qpsk[j]-MI)<(MI-MI_map_qpsk[j-1]))
-            {
-              esinr = MI_map_qpsk_axis[j];
-            }
-          else
-            {
-              esinr = MI_map_qpsk_axis[j-1];
-            }
+          esinrIndex = j;
         }
       else
         {
-          esinr = MI_map_qpsk_axis[0];
+          esinrIndex = j - 1;
         }
     }
-
-  double esirnDb = 10*log10 (esinr); 
-//   NS_LOG_DEBUG ("Effective SINR " << esirnDb << " max " << 10*log10 (MI_map_qpsk [MI_MAP_QPSK_SIZE-1]));
-  uint16_t i = 0;
-  double errorRate = 0.0;
-  while ((i<PDCCH_PCFICH_CURVE_SIZE)&&(PdcchPcfichBlerCurveXaxis[i] < esirnDb))
-    {
-      i++;
-    }
-  if (esirnDb > PdcchPcfichBlerCurveXaxis[PDCCH_PCFICH_CURVE_SIZE-1])
-    {
-      errorRate = 0.0;
-    }
-  else 
-    {
-      NS_ASSERT_MSG (i<PDCCH_PCFICH_CURVE_SIZE, "PDCCH-PCFICH map out of data");
-      errorRate = PdcchPcfichBlerCurveYaxis[i];
-    }  
-  
-  return (errorRate);
+  return g_miErrorModelTables.pdcchErrorRate[esinrIndex];
 }
 
 
 
 
 TbStats_t
-LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory)
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
 {
   NS_LOG_FUNCTION (sinr << &map << (uint32_t) size << (uint32_t) mcs);
 
-  double tbMi = Mib(sinr, map, mcs);
+  return GetTbStatsFromMib (Mib (sinr, map, mcs), size, mcs, miHistory);
+}
+
+
+void
+LteMiErrorModel::GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<TbErrorInfo_t>& tbs, std::vector<TbStats_t>& stats)
+{
+  NS_LOG_FUNCTION (sinr << tbs.size ());
+
+  const double *sinrValues = &(*sinr.ConstValuesBegin ());
+  uint32_t nRbs = sinr.GetSpectrumModel ()->GetNumBands ();
+  // MI of each RB for QPSK, 16QAM and 64QAM, looked up when first needed
+  // (the MI values are positive)
+  std::vector<double> rbMi[3];
+  stats.resize (tbs.size ());
+  for (uint32_t t = 0; t < tbs.size (); t++)
+    {
+      const TbErrorInfo_t &tb = tbs[t];
+      std::vector<double> &mi = rbMi[MiMapIndex (tb.mcs)];
+      if (mi.empty ())
+        {
+          mi.assign (nRbs, -1.0);
+        }
+      double MIsum = 0.0;
+      for (std::vector<int>::const_iterator it = tb.map->begin (); it != tb.map->end (); ++it)
+        {
+          NS_ASSERT (*it < (int) nRbs);
+          if (mi[*it] < 0)
+            {
+              mi[*it] = RbMi (sinrValues[*it], tb.mcs);
+            }
+          MIsum += mi[*it];
+        }
+      stats[t] = GetTbStatsFromMib (MIsum / tb.map->size (), tb.size, tb.mcs, tb.miHistory);
+    }
+}
+
+
+TbStats_t
+LteMiErrorModel::GetTbStatsFromMib (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory)
+{
+  NS_LOG_FUNCTION (tbMi << (uint32_t) size << (uint32_t) mcs);
+
   double MI = 0.0;
   double Reff = 0.0;
   NS_ASSERT (mcs < 29);
@@ -72,6 +72,15 @@ struct TbStats_t
   double tbler; ///< Transport block BLER
   double mi; ///< Mutual information
 };
+
+/// TbErrorInfo_t structure: a TB evaluated by the batched LteMiErrorModel::GetTbDecodificationStats
+struct TbErrorInfo_t
+{
+  const std::vector<int> *map; ///< the active RBs for the TB
+  uint16_t size; ///< the size in bytes of the TB
+  uint8_t mcs; ///< the MCS of the TB
+  HarqProcessInfoList_t miHistory; ///< MI of past transmissions (in case of retx)
+};
   
 
 
@@ -109,7 +118,21 @@ public:
    * \param miHistory MI of past transmissions (in case of retx)
    * \return the TB error rate and MI
    */
-  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, HarqProcessInfoList_t miHistory);
+  static TbStats_t GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<int>& map, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
+
+  /**
+   * \brief run the error-model algorithm for all the TBs received together
+   *
+   * The MI of each RB is looked up once per modulation and shared by all the
+   * TBs, e.g., by the TBs of the different UEs or layers of a TTI, or by the
+   * same RBs evaluated with different MCSs. The results are the same as those
+   * of GetTbDecodificationStats called for each TB.
+   *
+   * \param sinr the perceived sinr values in the whole bandwidth in Watt
+   * \param tbs the TBs
+   * \param stats the TB error rate and MI of each TB, in the same order
+   */
+  static void GetTbDecodificationStats (const SpectrumValue& sinr, const std::vector<TbErrorInfo_t>& tbs, std::vector<TbStats_t>& stats);
   
   /** 
   * \brief run the error-model algorithm for the specified PCFICH+PDCCH channels
@@ -119,10 +142,23 @@ public:
   static double GetPcfichPdcchError (const SpectrumValue& sinr);
 
 
-//private:
-
-
-
+private:
+  /**
+   * \brief find the MI of a RB
+   * \param sinrLin the perceived sinr of the RB in Watt
+   * \param mcs the MCS of the TB
+   * \return the MI
+   */
+  static double RbMi (double sinrLin, uint8_t mcs);
+  /**
+   * \brief run the error-model algorithm for a TB whose mmib is known
+   * \param tbMi the mmib of the TB
+   * \param size the size in bytes of the TB
+   * \param mcs the MCS of the TB
+   * \param miHistory MI of past transmissions (in case of retx)
+   * \return the TB error rate and MI
+   */
+  static TbStats_t GetTbStatsFromMib (double tbMi, uint16_t size, uint8_t mcs, const HarqProcessInfoList_t& miHistory);
 };
 
 
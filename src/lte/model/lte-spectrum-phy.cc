@@ -992,26 +992,40 @@ LteSpectrumPhy::EndRxData ()
   NS_ASSERT (m_transmissionMode < m_txModeGain.size ());
   m_sinrPerceived *= m_txModeGain.at (m_transmissionMode);
   
-  while (itTb!=m_expectedTbs.end ())
+  if ((m_dataErrorModelEnabled)&&(m_rxPacketBurstList.size ()>0)) // avoid to check for errors when there is no actual data transmitted
     {
-      if ((m_dataErrorModelEnabled)&&(m_rxPacketBurstList.size ()>0)) // avoid to check for errors when there is no actual data transmitted
+      // evaluate all the TBs of the TTI at once, as they share the same SINR
+      std::vector<TbErrorInfo_t> tbs (m_expectedTbs.size ());
+      std::vector<TbErrorInfo_t>::iterator itInfo = tbs.begin ();
+      for (itTb = m_expectedTbs.begin (); itTb != m_expectedTbs.end (); ++itTb, ++itInfo)
         {
+          (*itInfo).map = &(*itTb).second.rbBitmap;
+          (*itInfo).size = (*itTb).second.size;
+          (*itInfo).mcs = (*itTb).second.mcs;
           // retrieve HARQ info
-          HarqProcessInfoList_t harqInfoList;
           if ((*itTb).second.ndi == 0)
             {
               // TB retxed: retrieve HARQ history
               uint16_t ulHarqId = 0;
               if ((*itTb).second.downlink)
                 {
-                  harqInfoList = m_harqPhyModule->GetHarqProcessInfoDl ((*itTb).second.harqProcessId, (*itTb).first.m_layer);
+                  (*itInfo).miHistory = m_harqPhyModule->GetHarqProcessInfoDl ((*itTb).second.harqProcessId, (*itTb).first.m_layer);
                 }
               else
                 {
-                  harqInfoList = m_harqPhyModule->GetHarqProcessInfoUl ((*itTb).first.m_rnti, ulHarqId);
+                  (*itInfo).miHistory = m_harqPhyModule->GetHarqProcessInfoUl ((*itTb).first.m_rnti, ulHarqId);
                 }
             }
-          TbStats_t tbStats = LteMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, (*itTb).second.rbBitmap, (*itTb).second.size, (*itTb).second.mcs, harqInfoList);
+        }
+      std::vector<TbStats_t> stats;
+      LteMiErrorModel::GetTbDecodificationStats (m_sinrPerceived, tbs, stats);
+
+      std::vector<TbStats_t>::const_iterator itStats = stats.begin ();
+      itInfo = tbs.begin ();
+      for (itTb = m_expectedTbs.begin (); itTb != m_expectedTbs.end (); ++itTb, ++itStats, ++itInfo)
+        {
+          const HarqProcessInfoList_t &harqInfoList = (*itInfo).miHistory;
+          const TbStats_t &tbStats = *itStats;
           (*itTb).second.mi = tbStats.mi;
           (*itTb).second.corrupt = m_random->GetValue () > tbStats.tbler ? false : true;
           NS_LOG_DEBUG (this << "RNTI " << (*itTb).first.m_rnti << " size " << (*itTb).second.size << " mcs " << (uint32_t)(*itTb).second.mcs << " bitmap " << (*itTb).second.rbBitmap.size () << " layer " << (uint16_t)(*itTb).first.m_layer << " TBLER " << tbStats.tbler << " corrupted " << (*itTb).second.corrupt);
@@ -1040,9 +1054,7 @@ LteSpectrumPhy::EndRxData ()
               params.m_rv = harqInfoList.size ();
               m_ulPhyReception (params);
             }
-       }
-      
-      itTb++;
+        }
     }
     std::map <uint16_t, DlInfoListElement_s> harqDlInfoMap;
     for (std::list<Ptr<PacketBurst> >::const_iterator i = m_rxPacketBurstList.begin (); 
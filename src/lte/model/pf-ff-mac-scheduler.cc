@@ -920,119 +920,68 @@ PfFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sched
 
 
 
-  for (int i = 0; i < rbgNum; i++)
+  // evaluate the metric of each UE for each free RBG, looking up the state
+  // of each UE once
+  m_rbgAllocator.Reset (rbgNum, rbgSize, m_amc);
+  std::map <uint16_t, pfsFlowPerf_t>::iterator it;
+  for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
     {
-      NS_LOG_INFO (this << " ALLOCATION for RBG " << i << " of " << rbgNum);
-      if (rbgMap.at (i) == false)
+      std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
+      bool available = true;
+      if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
         {
-          std::map <uint16_t, pfsFlowPerf_t>::iterator it;
-          std::map <uint16_t, pfsFlowPerf_t>::iterator itMax = m_flowStatsDl.end ();
-          double rcqiMax = 0.0;
-          for (it = m_flowStatsDl.begin (); it != m_flowStatsDl.end (); it++)
+          // UE already allocated for HARQ or without HARQ process available -> drop it
+          if (itRnti != rntiAllocated.end ())
             {
-              if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
-                continue;
-
-              std::set <uint16_t>::iterator itRnti = rntiAllocated.find ((*it).first);
-              if ((itRnti != rntiAllocated.end ())||(!HarqProcessAvailability ((*it).first)))
-                {
-                  // UE already allocated for HARQ or without HARQ process available -> drop it
-                  if (itRnti != rntiAllocated.end ())
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
-                    }
-                  if (!HarqProcessAvailability ((*it).first))
-                    {
-                      NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
-                    }
-                  continue;
-                }
-              std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-              itCqi = m_a30CqiRxed.find ((*it).first);
-              std::map <uint16_t,uint8_t>::iterator itTxMode;
-              itTxMode = m_uesTxMode.find ((*it).first);
-              if (itTxMode == m_uesTxMode.end ())
-                {
-                  NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                }
-              int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-              std::vector <uint8_t> sbCqi;
-              if (itCqi == m_a30CqiRxed.end ())
-                {
-                  for (uint8_t k = 0; k < nLayer; k++)
-                    {
-                      sbCqi.push_back (1);  // start with lowest value
-                    }
-                }
-              else
-                {
-                  sbCqi = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                }
-              uint8_t cqi1 = sbCqi.at (0);
-              uint8_t cqi2 = 0;
-              if (sbCqi.size () > 1)
-                {
-                  cqi2 = sbCqi.at (1);
-                }
-
-              if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                {
-                  if (LcActivePerFlow ((*it).first) > 0)
-                    {
-                      // this UE has data to transmit
-                      double achievableRate = 0.0;
-                      uint8_t mcs = 0;
-                      for (uint8_t k = 0; k < nLayer; k++)
-                        {
-                          if (sbCqi.size () > k)
-                            {
-                              mcs = m_amc->GetMcsFromCqi (sbCqi.at (k));
-                            }
-                          else
-                            {
-                              // no info on this subband -> worst MCS
-                              mcs = 0;
-                            }
-                          achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001);   // = TB size / TTI
-                        }
-
-                      double rcqi = achievableRate / (*it).second.lastAveragedThroughput;
-                      NS_LOG_INFO (this << " RNTI " << (*it).first << " MCS " << (uint32_t)mcs << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << rcqi);
-
-                      if (rcqi > rcqiMax)
-                        {
-                          rcqiMax = rcqi;
-                          itMax = it;
-                        }
-                    }
-                }   // end if cqi
-            } // end for m_rlcBufferReq
-
-          if (itMax == m_flowStatsDl.end ())
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ tx" << (uint16_t)(*it).first);
+            }
+          if (!HarqProcessAvailability ((*it).first))
             {
-              // no UE available for this RB
-              NS_LOG_INFO (this << " any UE found");
+              NS_LOG_DEBUG (this << " RNTI discared for HARQ id" << (uint16_t)(*it).first);
             }
-          else
+          available = false;
+        }
+      std::map <uint16_t,SbMeasResult_s>::iterator itCqi = m_a30CqiRxed.end ();
+      int nLayer = 0;
+      if (available)
+        {
+          itCqi = m_a30CqiRxed.find ((*it).first);
+          std::map <uint16_t,uint8_t>::iterator itTxMode;
+          itTxMode = m_uesTxMode.find ((*it).first);
+          if (itTxMode == m_uesTxMode.end ())
             {
-              rbgMap.at (i) = true;
-              std::map <uint16_t, std::vector <uint16_t> >::iterator itMap;
-              itMap = allocationMap.find ((*itMax).first);
-              if (itMap == allocationMap.end ())
-                {
-                  // insert new element
-                  std::vector <uint16_t> tempMap;
-                  tempMap.push_back (i);
-                  allocationMap.insert (std::pair <uint16_t, std::vector <uint16_t> > ((*itMax).first, tempMap));
-                }
-              else
-                {
-                  (*itMap).second.push_back (i);
-                }
-              NS_LOG_INFO (this << " UE assigned " << (*itMax).first);
+              NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
             }
-        } // end for RBG free
-    } // end for RBGs
+          nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+          // only the UEs with data to transmit are candidates
+          available = (LcActivePerFlow ((*it).first) > 0);
+        }
+      double *metrics = available ? m_rbgAllocator.AddUe ((*it).first) : 0;
+      std::vector <uint8_t> noCqi (nLayer, 1);  // start with lowest value
+      for (int i = 0; i < rbgNum; i++)
+        {
+          // the FFR algorithm is asked about all the UEs, as it learns the UEs from it
+          if ((rbgMap.at (i) == true)||(m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first) == false)||(!available))
+            {
+              continue;
+            }
+          const std::vector <uint8_t> &sbCqi = (itCqi == m_a30CqiRxed.end ()) ? noCqi : (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
+          uint8_t cqi1 = sbCqi.at (0);
+          uint8_t cqi2 = 0;
+          if (sbCqi.size () > 1)
+            {
+              cqi2 = sbCqi.at (1);
+            }
+
+          if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+            {
+              double achievableRate = m_rbgAllocator.GetRbgRate (sbCqi, nLayer);
+              metrics[i] = achievableRate / (*it).second.lastAveragedThroughput;
+              NS_LOG_INFO (this << " RNTI " << (*it).first << " RBG " << i << " achievableRate " << achievableRate << " avgThr " << (*it).second.lastAveragedThroughput << " RCQI " << metrics[i]);
+            }   // end if cqi
+        } // end for RBGs
+    } // end for m_flowStatsDl
+  m_rbgAllocator.Allocate (rbgMap, allocationMap);
 
   // reset TTI stats of users
   std::map <uint16_t, pfsFlowPerf_t>::iterator itStats;
@@ -1105,253 +1105,100 @@ PssFfMacScheduler::DoSchedDlTriggerReq (const struct FfMacSchedSapProvider::Sche
            } // end of m_flowStatsDl
         
         
-          if ( m_fdSchedulerType.compare("CoItA") == 0)
+          // FD scheduler: evaluate the metric of each UE of the TD set for each
+          // free RBG, looking up the state of each UE once
+          bool coita = (m_fdSchedulerType.compare ("CoItA") == 0);
+          if (coita || (m_fdSchedulerType.compare ("PFsch") == 0))
             {
-              // FD scheduler: Carrier over Interference to Average (CoItA)
-              std::map < uint16_t, uint8_t > sbCqiSum;
+              m_rbgAllocator.Reset (rbgNum, rbgSize, m_amc);
               for (it = tdUeSet.begin (); it != tdUeSet.end (); it++)
                 {
-                  uint8_t sum = 0;
-                  for (int i = 0; i < rbgNum; i++)
+                  // calculate PF weight 
+                  double weight = (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
+                  if (weight < 1.0)
+                    weight = 1.0;
+
+                  std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
+                  itCqi = m_a30CqiRxed.find ((*it).first);
+                  std::map <uint16_t,uint8_t>::iterator itTxMode;
+                  itTxMode = m_uesTxMode.find ((*it).first);
+                  if (itTxMode == m_uesTxMode.end ())
                     {
-                      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-                      itCqi = m_a30CqiRxed.find ((*it).first);
-                      std::map <uint16_t,uint8_t>::iterator itTxMode;
-                      itTxMode = m_uesTxMode.find ((*it).first);
-                      if (itTxMode == m_uesTxMode.end ())
-                        {
-                          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                        }
-                      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-                      std::vector <uint8_t> sbCqis;
-                      if (itCqi == m_a30CqiRxed.end ())
-                        {
-                          for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                              sbCqis.push_back (1);  // start with lowest value
-                            }
-                        }
-                      else
-                        {
-                          sbCqis = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                        }
-        
-                      uint8_t cqi1 = sbCqis.at (0);
-                      uint8_t cqi2 = 0;
-                      if (sbCqis.size () > 1)
-                        {
-                          cqi2 = sbCqis.at (1);
-                        }
-            
-                      uint8_t sbCqi = 0;
-                      if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                        {
-                          for (uint8_t k = 0; k < nLayer; k++) 
-                            {
-                              if (sbCqis.size () > k)
-                                {                       
-           	                  sbCqi = sbCqis.at(k);
-                                }
-                              else
-                                {
-                                  // no info on this subband 
-                                  sbCqi = 0;
-                                }
-                              sum += sbCqi;
-                            }
-                        }   // end if cqi
-                    }// end of rbgNum
-              
-                  sbCqiSum.insert (std::pair<uint16_t, uint8_t> ((*it).first, sum));
-                }// end tdUeSet
-        
-              for (int i = 0; i < rbgNum; i++)
-                {
-                  if (rbgMap.at (i) == true)
-                    continue;
+                      NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
+                    }
+                  int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
+                  std::vector <uint8_t> noCqi (nLayer, 1);  // start with lowest value
 
-                  std::map <uint16_t, pssFlowPerf_t>::iterator itMax = tdUeSet.end ();
-                  double metricMax = 0.0;
-                  for (it = tdUeSet.begin (); it != tdUeSet.end (); it++)
+                  uint8_t sbCqiSum = 0;
+                  if (coita)
                     {
-                      if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
-                        continue;
-
-                      // calculate PF weight 
-                      double weight = (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
-                      if (weight < 1.0)
-                        weight = 1.0;
-        
-                      std::map < uint16_t, uint8_t>::iterator itSbCqiSum;
-                      itSbCqiSum = sbCqiSum.find((*it).first);
-        
-                      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-                      itCqi = m_a30CqiRxed.find ((*it).first);
-                      std::map <uint16_t,uint8_t>::iterator itTxMode;
-                      itTxMode = m_uesTxMode.find ((*it).first);
-                      if (itTxMode == m_uesTxMode.end())
-                        {
-                          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
-                        }
-                      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-                      std::vector <uint8_t> sbCqis;
-                      if (itCqi == m_a30CqiRxed.end ())
+                      // FD scheduler: Carrier over Interference to Average (CoItA)
+                      for (int i = 0; i < rbgNum; i++)
                         {
-                          for (uint8_t k = 0; k < nLayer; k++)
+                          const std::vector <uint8_t> &sbCqis = (itCqi == m_a30CqiRxed.end ()) ? noCqi : (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
+                          uint8_t cqi1 = sbCqis.at (0);
+                          uint8_t cqi2 = 0;
+                          if (sbCqis.size () > 1)
                             {
-                              sbCqis.push_back (1);  // start with lowest value
+                              cqi2 = sbCqis.at (1);
                             }
-                        }
-                      else
-                        {
-                          sbCqis = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                        }
-        
-                      uint8_t cqi1 = sbCqis.at( 0);
-                      uint8_t cqi2 = 0;
-                      if (sbCqis.size () > 1)
-                        {
-                          cqi2 = sbCqis.at(1);
-                        }
-            
-                      uint8_t sbCqi = 0;
-                      double colMetric = 0.0;
-                      if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
-                        {
-                          for (uint8_t k = 0; k < nLayer; k++) 
+                          if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                             {
-                              if (sbCqis.size () > k)
-                                {                       
-                                  sbCqi = sbCqis.at(k);
-                                }
-                              else
+                              for (uint8_t k = 0; k < nLayer; k++)
                                 {
-                                  // no info on this subband 
-                                  sbCqi = 0;
+                                  // no info on this subband -> 0
+                                  sbCqiSum += (sbCqis.size () > k) ? sbCqis.at (k) : 0;
                                 }
-                              colMetric += (double)sbCqi / (double)(*itSbCqiSum).second;
-           	                } 
-                        }   // end if cqi
-        
-                      double metric = 0.0;
-                      if (colMetric != 0)
-                        metric= weight * colMetric;
-                      else
-                        metric = 1;
-        
-                      if (metric > metricMax )
-                        {
-                          metricMax = metric;
-                          itMax = it;
-                        }
-                    } // end of tdUeSet
-
-                  if (itMax == tdUeSet.end ())
-                    {
-                      // no UE available for downlink
+                            }   // end if cqi
+                        } // end of rbgNum
                     }
-                  else
-                    {
-                      allocationMap[(*itMax).first].push_back (i);
-                      rbgMap.at (i) = true;
-                    }
-                }// end of rbgNum
-        
-            }// end of CoIta
-        
-        
-          if ( m_fdSchedulerType.compare("PFsch") == 0)
-            {
-              // FD scheduler: Proportional Fair scheduled (PFsch)
-              for (int i = 0; i < rbgNum; i++)
-                {
-                  if (rbgMap.at (i) == true)
-                    continue;
 
-                  std::map <uint16_t, pssFlowPerf_t>::iterator itMax = tdUeSet.end ();
-                  double metricMax = 0.0;
-                  for (it = tdUeSet.begin (); it != tdUeSet.end (); it++)
+                  double *metrics = m_rbgAllocator.AddUe ((*it).first);
+                  for (int i = 0; i < rbgNum; i++)
                     {
-                      if ((m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first)) == false)
-                        continue;
-                      // calculate PF weight 
-                      double weight = (*it).second.targetThroughput / (*it).second.lastAveragedThroughput;
-                      if (weight < 1.0)
-                        weight = 1.0;
-        
-                      std::map <uint16_t,SbMeasResult_s>::iterator itCqi;
-                      itCqi = m_a30CqiRxed.find ((*it).first);
-                      std::map <uint16_t,uint8_t>::iterator itTxMode;
-                      itTxMode = m_uesTxMode.find ((*it).first);
-                      if (itTxMode == m_uesTxMode.end())
+                      if ((rbgMap.at (i) == true)||(m_ffrSapProvider->IsDlRbgAvailableForUe (i, (*it).first) == false))
                         {
-                          NS_FATAL_ERROR ("No Transmission Mode info on user " << (*it).first);
+                          continue;
                         }
-                      int nLayer = TransmissionModesLayers::TxMode2LayerNum ((*itTxMode).second);
-                      std::vector <uint8_t> sbCqis;
-                      if (itCqi == m_a30CqiRxed.end ())
-                        {
-                          for (uint8_t k = 0; k < nLayer; k++)
-                            {
-                              sbCqis.push_back (1);  // start with lowest value
-                            }
-                        }
-                      else
-                        {
-                          sbCqis = (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
-                        }
-        
-                      uint8_t cqi1 = sbCqis.at(0);
+                      const std::vector <uint8_t> &sbCqis = (itCqi == m_a30CqiRxed.end ()) ? noCqi : (*itCqi).second.m_higherLayerSelected.at (i).m_sbCqi;
+                      uint8_t cqi1 = sbCqis.at (0);
                       uint8_t cqi2 = 0;
                       if (sbCqis.size () > 1)
                         {
-                          cqi2 = sbCqis.at(1);
+                          cqi2 = sbCqis.at (1);
                         }
-                
-                      double schMetric = 0.0;
-                      if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+
+                      if (coita)
                         {
-                          double achievableRate = 0.0;
-                          for (uint8_t k = 0; k < nLayer; k++) 
+                          double colMetric = 0.0;
+                          if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
                             {
-                              uint8_t mcs = 0;
-                              if (sbCqis.size () > k)
-                                {                       
-                                  mcs = m_amc->GetMcsFromCqi (sbCqis.at (k));
-                                }
-                              else
+                              for (uint8_t k = 0; k < nLayer; k++)
                                 {
-                                  // no info on this subband  -> worst MCS
-                                  mcs = 0;
+                                  // no info on this subband -> 0
+                                  uint8_t sbCqi = (sbCqis.size () > k) ? sbCqis.at (k) : 0;
+                                  colMetric += (double)sbCqi / (double)sbCqiSum;
                                 }
-                              achievableRate += ((m_amc->GetDlTbSizeFromMcs (mcs, rbgSize) / 8) / 0.001); // = TB size / TTI
-            	  	    }
-                          schMetric = achievableRate / (*it).second.secondLastAveragedThroughput;
-                        }   // end if cqi
-         
-                      double metric = 0.0;
-                      metric= weight * schMetric;
-         
-                      if (metric > metricMax )
+                            }   // end if cqi
+                          if (colMetric != 0)
+                            metrics[i] = weight * colMetric;
+                          else
+                            metrics[i] = 1;
+                        }
+                      else
                         {
-                          metricMax = metric;
-                          itMax = it;
+                          // FD scheduler: Proportional Fair scheduled (PFsch)
+                          double schMetric = 0.0;
+                          if ((cqi1 > 0)||(cqi2 > 0)) // CQI == 0 means "out of range" (see table 7.2.3-1 of 36.213)
+                            {
+                              schMetric = m_rbgAllocator.GetRbgRate (sbCqis, nLayer) / (*it).second.secondLastAveragedThroughput;
+                            }   // end if cqi
+                          metrics[i] = weight * schMetric;
                         }
-                    } // end of tdUeSet
-
-                  if (itMax == tdUeSet.end ())
-                    {
-                      // no UE available for downlink 
-                    }
-                  else
-                    {
-                      allocationMap[(*itMax).first].push_back (i);
-                      rbgMap.at (i) = true;
-                    }
-         
-                }// end of rbgNum
-        
-            } // end of PFsch
+                    } // end of rbgNum
+                } // end of tdUeSet
+              m_rbgAllocator.Allocate (rbgMap, allocationMap);
+            } // end of CoItA || PFsch
 
         } // end if ueSet1 || ueSet2
     
@@ -0,0 +1,127 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <map>
+#include <vector>
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/lte-amc.h>
+#include <ns3/ff-mac-rbg-allocator.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteFfMacRbgAllocatorTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Checks the allocation of the RBGs to the UEs with the highest
+ * metric: the RBGs already allocated are kept, a metric must be positive to
+ * get a RBG, and the ties are broken in favor of the UE added first.
+ */
+class LteFfMacRbgAllocatorTestCase : public TestCase
+{
+public:
+  LteFfMacRbgAllocatorTestCase ();
+  virtual ~LteFfMacRbgAllocatorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteFfMacRbgAllocatorTestCase::LteFfMacRbgAllocatorTestCase ()
+  : TestCase ("Allocation of the RBGs to the UEs with the highest metric")
+{
+}
+
+LteFfMacRbgAllocatorTestCase::~LteFfMacRbgAllocatorTestCase ()
+{
+}
+
+void
+LteFfMacRbgAllocatorTestCase::DoRun (void)
+{
+  Ptr<LteAmc> amc = CreateObject<LteAmc> ();
+  FfMacRbgAllocator allocator;
+  int rbgNum = 5;
+  allocator.Reset (rbgNum, 2, amc);
+
+  // RBG 0: UE 2 is the best
+  // RBG 1: tie between UEs 1 and 2 -> UE 1, added first
+  // RBG 2: already allocated
+  // RBG 3: no positive metric
+  // RBG 4: UE 3 is the best
+  double metrics1[] = {1.0, 3.0, 5.0, 0.0, 1.0};
+  double metrics2[] = {2.0, 3.0, 5.0, -1.0, 1.0};
+  double metrics3[] = {0.5, 2.0, 5.0, 0.0, 4.0};
+  double *ueMetrics = allocator.AddUe (1);
+  std::copy (metrics1, metrics1 + rbgNum, ueMetrics);
+  ueMetrics = allocator.AddUe (2);
+  std::copy (metrics2, metrics2 + rbgNum, ueMetrics);
+  ueMetrics = allocator.AddUe (3);
+  std::copy (metrics3, metrics3 + rbgNum, ueMetrics);
+  NS_TEST_ASSERT_MSG_EQ (allocator.GetNUes (), 3, "Wrong number of UEs");
+
+  std::vector<bool> rbgMap (rbgNum, false);
+  rbgMap.at (2) = true;
+  std::map<uint16_t, std::vector<uint16_t> > allocationMap;
+  allocator.Allocate (rbgMap, allocationMap);
+
+  NS_TEST_ASSERT_MSG_EQ (allocationMap.size (), 3, "Wrong number of allocated UEs");
+  NS_TEST_ASSERT_MSG_EQ (allocationMap[1].size (), 1, "Wrong number of RBGs of UE 1");
+  NS_TEST_ASSERT_MSG_EQ (allocationMap[1].at (0), 1, "Wrong RBG of UE 1");
+  NS_TEST_ASSERT_MSG_EQ (allocationMap[2].size (), 1, "Wrong number of RBGs of UE 2");
+  NS_TEST_ASSERT_MSG_EQ (allocationMap[2].at (0), 0, "Wrong RBG of UE 2");
+  NS_TEST_ASSERT_MSG_EQ (allocationMap[3].size (), 1, "Wrong number of RBGs of UE 3");
+  NS_TEST_ASSERT_MSG_EQ (allocationMap[3].at (0), 4, "Wrong RBG of UE 3");
+  bool rbg3 = rbgMap.at (3);
+  NS_TEST_ASSERT_MSG_EQ (rbg3, false, "RBG 3 should not be allocated");
+
+  // the rate of a RBG is the sum of the rates of the layers
+  std::vector<uint8_t> sbCqi (1, 10);
+  double rate = allocator.GetRbgRate (sbCqi, 2);
+  double expectedRate = (amc->GetDlTbSizeFromMcs (amc->GetMcsFromCqi (10), 2) / 8) / 0.001
+    + (amc->GetDlTbSizeFromMcs (0, 2) / 8) / 0.001;
+  NS_TEST_ASSERT_MSG_EQ (rate, expectedRate, "Wrong rate of a RBG");
+
+  // a new TTI starts without UEs
+  allocator.Reset (rbgNum, 2, amc);
+  NS_TEST_ASSERT_MSG_EQ (allocator.GetNUes (), 0, "The UEs should be removed at each TTI");
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief FfMacRbgAllocator test suite
+ */
+class LteFfMacRbgAllocatorTestSuite : public TestSuite
+{
+public:
+  LteFfMacRbgAllocatorTestSuite ();
+};
+
+LteFfMacRbgAllocatorTestSuite::LteFfMacRbgAllocatorTestSuite ()
+  : TestSuite ("lte-ff-mac-rbg-allocator", UNIT)
+{
+  AddTestCase (new LteFfMacRbgAllocatorTestCase, TestCase::QUICK);
+}
+
+static LteFfMacRbgAllocatorTestSuite g_lteFfMacRbgAllocatorTestSuite; ///< the test suite
@@ -0,0 +1,235 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <ctime>
+#include <limits>
+#include <iostream>
+#include <vector>
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/simulator.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/lte-interference.h>
+#include <ns3/lte-chunk-processor.h>
+#include <ns3/lte-spectrum-value-helper.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteInterferenceBenchmark");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Measures the time spent by LteInterference and its chunk
+ * processors evaluating the SINR, interference and power chunks of
+ * receptions overlapping with many interferers, as in a multi-cell
+ * scenario with many UEs.
+ *
+ * Each subframe, one signal is received over half of the resource blocks
+ * while interferers, each over a quarter of the resource blocks, start at
+ * staggered times during the subframe, so that each reception is made of
+ * one chunk per interferer.
+ */
+class LteInterferenceBenchmarkTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param nRbs the number of resource blocks
+   * \param nInterferers the number of interferers per subframe
+   * \param nSubframes the number of subframes
+   */
+  LteInterferenceBenchmarkTestCase (uint8_t nRbs, uint32_t nInterferers, uint32_t nSubframes);
+  virtual ~LteInterferenceBenchmarkTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Start a subframe
+   * \param interference the interference model
+   */
+  void StartSubframe (Ptr<LteInterference> interference);
+  /**
+   * Report the SINR of a reception
+   * \param sinr the SINR
+   */
+  void ReportSinr (const SpectrumValue &sinr);
+  /**
+   * Report the interference of a reception
+   * \param interf the interference plus noise
+   */
+  void ReportInterference (const SpectrumValue &interf);
+  /**
+   * Report the power of a reception
+   * \param power the power
+   */
+  void ReportPower (const SpectrumValue &power);
+
+  uint8_t m_nRbs;            ///< the number of resource blocks
+  uint32_t m_nInterferers;   ///< the number of interferers per subframe
+  uint32_t m_nSubframes;     ///< the number of subframes
+  uint32_t m_nStartedSubframes; ///< the number of subframes started
+  Ptr<SpectrumValue> m_rxPsd;                   ///< the PSD of the received signal
+  std::vector<Ptr<SpectrumValue> > m_interfererPsds; ///< the PSDs of the interferers
+  uint32_t m_nSinrReports;   ///< the number of SINR reports
+  uint32_t m_nInterfReports; ///< the number of interference reports
+  uint32_t m_nPowerReports;  ///< the number of power reports
+  double m_minSinr;          ///< the lowest SINR reported on a received resource block
+};
+
+LteInterferenceBenchmarkTestCase::LteInterferenceBenchmarkTestCase (uint8_t nRbs, uint32_t nInterferers, uint32_t nSubframes)
+  : TestCase ("LTE interference chunks"),
+    m_nRbs (nRbs),
+    m_nInterferers (nInterferers),
+    m_nSubframes (nSubframes),
+    m_nStartedSubframes (0),
+    m_nSinrReports (0),
+    m_nInterfReports (0),
+    m_nPowerReports (0),
+    m_minSinr (std::numeric_limits<double>::max ())
+{
+}
+
+LteInterferenceBenchmarkTestCase::~LteInterferenceBenchmarkTestCase ()
+{
+}
+
+void
+LteInterferenceBenchmarkTestCase::StartSubframe (Ptr<LteInterference> interference)
+{
+  Time subframe = MilliSeconds (1);
+  for (uint32_t i = 0; i < m_nInterferers; ++i)
+    {
+      Time start = (subframe * i) / m_nInterferers;
+      Simulator::Schedule (start, &LteInterference::AddSignal, interference,
+                           m_interfererPsds[i % m_interfererPsds.size ()], subframe);
+    }
+  interference->AddSignal (m_rxPsd, subframe);
+  interference->StartRx (m_rxPsd);
+  Simulator::Schedule (subframe, &LteInterference::EndRx, interference);
+  if (++m_nStartedSubframes < m_nSubframes)
+    {
+      // scheduled after EndRx, so that the receptions do not overlap
+      Simulator::Schedule (subframe, &LteInterferenceBenchmarkTestCase::StartSubframe, this, interference);
+    }
+}
+
+void
+LteInterferenceBenchmarkTestCase::ReportSinr (const SpectrumValue &sinr)
+{
+  ++m_nSinrReports;
+  for (uint32_t i = 0; i < m_nRbs / 2u; ++i)
+    {
+      m_minSinr = std::min (m_minSinr, sinr[i]);
+    }
+}
+
+void
+LteInterferenceBenchmarkTestCase::ReportInterference (const SpectrumValue &interf)
+{
+  ++m_nInterfReports;
+}
+
+void
+LteInterferenceBenchmarkTestCase::ReportPower (const SpectrumValue &power)
+{
+  ++m_nPowerReports;
+}
+
+void
+LteInterferenceBenchmarkTestCase::DoRun (void)
+{
+  uint32_t earfcn = 500;
+  Ptr<LteInterference> interference = CreateObject<LteInterference> ();
+  interference->SetNoisePowerSpectralDensity (LteSpectrumValueHelper::CreateNoisePowerSpectralDensity (earfcn, m_nRbs, 9.0));
+
+  std::vector<int> rxRbs;
+  for (int i = 0; i < m_nRbs / 2; ++i)
+    {
+      rxRbs.push_back (i);
+    }
+  m_rxPsd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (earfcn, m_nRbs, 30.0, rxRbs);
+  (*m_rxPsd) *= 1e-8;
+  for (int q = 0; q < 4; ++q)
+    {
+      std::vector<int> rbs;
+      for (int i = q * m_nRbs / 4; i < (q + 1) * m_nRbs / 4; ++i)
+        {
+          rbs.push_back (i);
+        }
+      Ptr<SpectrumValue> psd = LteSpectrumValueHelper::CreateTxPowerSpectralDensity (earfcn, m_nRbs, 30.0, rbs);
+      (*psd) *= 1e-10;
+      m_interfererPsds.push_back (psd);
+    }
+
+  // two SINR processors, as for the control and data channels
+  for (uint32_t i = 0; i < 2; ++i)
+    {
+      Ptr<LteChunkProcessor> sinr = Create<LteChunkProcessor> ();
+      sinr->AddCallback (MakeCallback (&LteInterferenceBenchmarkTestCase::ReportSinr, this));
+      interference->AddSinrChunkProcessor (sinr);
+    }
+  Ptr<LteChunkProcessor> interf = Create<LteChunkProcessor> ();
+  interf->AddCallback (MakeCallback (&LteInterferenceBenchmarkTestCase::ReportInterference, this));
+  interference->AddInterferenceChunkProcessor (interf);
+  Ptr<LteChunkProcessor> power = Create<LteChunkProcessor> ();
+  power->AddCallback (MakeCallback (&LteInterferenceBenchmarkTestCase::ReportPower, this));
+  interference->AddRsPowerChunkProcessor (power);
+
+  Simulator::ScheduleNow (&LteInterferenceBenchmarkTestCase::StartSubframe, this, interference);
+
+  clock_t start = clock ();
+  Simulator::Run ();
+  clock_t stop = clock ();
+  double perChunk = 1e6 * double (stop - start) / (double (m_nSubframes) * m_nInterferers * CLOCKS_PER_SEC);
+  std::cout << "LteInterference: " << (int) m_nRbs << " RBs, "
+            << m_nInterferers << " interferers per subframe, "
+            << m_nSubframes << " subframes: "
+            << double (stop - start) / CLOCKS_PER_SEC << " s, "
+            << perChunk << " microsec/chunk" << std::endl;
+
+  NS_TEST_ASSERT_MSG_EQ (m_nSinrReports, 2 * m_nSubframes, "Wrong number of SINR reports");
+  NS_TEST_ASSERT_MSG_EQ (m_nInterfReports, m_nSubframes, "Wrong number of interference reports");
+  NS_TEST_ASSERT_MSG_EQ (m_nPowerReports, m_nSubframes, "Wrong number of power reports");
+  NS_TEST_ASSERT_MSG_GT (m_minSinr, 0.0, "The received resource blocks should have a positive SINR");
+
+  Simulator::Destroy ();
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief LteInterference performance test suite
+ */
+class LteInterferenceBenchmarkTestSuite : public TestSuite
+{
+public:
+  LteInterferenceBenchmarkTestSuite ();
+};
+
+LteInterferenceBenchmarkTestSuite::LteInterferenceBenchmarkTestSuite ()
+  : TestSuite ("lte-interference-perf", PERFORMANCE)
+{
+  AddTestCase (new LteInterferenceBenchmarkTestCase (100, 20, 10000), TestCase::QUICK);
+}
+
+static LteInterferenceBenchmarkTestSuite g_lteInterferenceBenchmarkTestSuite; ///< the test suite
@@ -0,0 +1,188 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <vector>
+
+#include <ns3/log.h>
+#include <ns3/test.h>
+#include <ns3/random-variable-stream.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/lte-spectrum-value-helper.h>
+#include <ns3/lte-mi-error-model.h>
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("LteMiErrorModelTest");
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Checks that the TBs evaluated together by the batched
+ * LteMiErrorModel::GetTbDecodificationStats get exactly the same error rate
+ * and MI as when evaluated one at a time, for random SINRs, RB allocations,
+ * MCSs, sizes and HARQ histories.
+ */
+class LteMiErrorModelBatchTestCase : public TestCase
+{
+public:
+  LteMiErrorModelBatchTestCase ();
+  virtual ~LteMiErrorModelBatchTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LteMiErrorModelBatchTestCase::LteMiErrorModelBatchTestCase ()
+  : TestCase ("Batched evaluation of the TBs of a TTI")
+{
+}
+
+LteMiErrorModelBatchTestCase::~LteMiErrorModelBatchTestCase ()
+{
+}
+
+void
+LteMiErrorModelBatchTestCase::DoRun (void)
+{
+  Ptr<UniformRandomVariable> rng = CreateObject<UniformRandomVariable> ();
+  rng->SetStream (1);
+  Ptr<SpectrumModel> sm = LteSpectrumValueHelper::GetSpectrumModel (100, 50);
+
+  for (uint32_t trial = 0; trial < 200; ++trial)
+    {
+      SpectrumValue sinr (sm);
+      double meanSinrDb = rng->GetValue (-15.0, 30.0);
+      for (uint32_t i = 0; i < 50; ++i)
+        {
+          sinr[i] = std::pow (10.0, (meanSinrDb + rng->GetValue (-5.0, 5.0)) / 10.0);
+        }
+
+      // overlapping allocations, as those of the layers of a UE or of
+      // different MCSs evaluated on the same RBs
+      std::vector<std::vector<int> > maps (4);
+      std::vector<TbErrorInfo_t> tbs (4);
+      for (uint32_t k = 0; k < tbs.size (); ++k)
+        {
+          uint32_t first = rng->GetInteger (0, 40);
+          uint32_t last = rng->GetInteger (first, 49);
+          for (uint32_t i = first; i <= last; ++i)
+            {
+              maps[k].push_back (i);
+            }
+          tbs[k].map = &maps[k];
+          tbs[k].mcs = rng->GetInteger (0, 28);
+          tbs[k].size = rng->GetInteger (2, 1000);
+          uint32_t nRetx = rng->GetInteger (0, 3);
+          for (uint32_t j = 0; j < nRetx; ++j)
+            {
+              HarqProcessInfoElement_t el;
+              el.m_mi = rng->GetValue (0.0, 1.0);
+              el.m_rv = j;
+              el.m_infoBits = tbs[k].size * 8;
+              el.m_codeBits = rng->GetInteger (tbs[k].size * 8, tbs[k].size * 24);
+              tbs[k].miHistory.push_back (el);
+            }
+        }
+
+      std::vector<TbStats_t> stats;
+      LteMiErrorModel::GetTbDecodificationStats (sinr, tbs, stats);
+      NS_TEST_ASSERT_MSG_EQ (stats.size (), tbs.size (), "Wrong number of TB stats");
+      for (uint32_t k = 0; k < tbs.size (); ++k)
+        {
+          TbStats_t single = LteMiErrorModel::GetTbDecodificationStats (sinr, maps[k], tbs[k].size, tbs[k].mcs, tbs[k].miHistory);
+          double batchTbler = stats[k].tbler;
+          double batchMi = stats[k].mi;
+          NS_TEST_ASSERT_MSG_EQ (batchTbler, single.tbler, "Different TBLER for MCS " << (uint16_t) tbs[k].mcs);
+          NS_TEST_ASSERT_MSG_EQ (batchMi, single.mi, "Different MI for MCS " << (uint16_t) tbs[k].mcs);
+        }
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief Checks the PCFICH+PDCCH error rate of flat SINRs against the
+ * limits of the curve of 3GPP R4-081920.
+ */
+class LtePcfichPdcchErrorTestCase : public TestCase
+{
+public:
+  LtePcfichPdcchErrorTestCase ();
+  virtual ~LtePcfichPdcchErrorTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LtePcfichPdcchErrorTestCase::LtePcfichPdcchErrorTestCase ()
+  : TestCase ("PCFICH+PDCCH error rate")
+{
+}
+
+LtePcfichPdcchErrorTestCase::~LtePcfichPdcchErrorTestCase ()
+{
+}
+
+void
+LtePcfichPdcchErrorTestCase::DoRun (void)
+{
+  Ptr<SpectrumModel> sm = LteSpectrumValueHelper::GetSpectrumModel (100, 25);
+  double previous = 1.0;
+  for (double sinrDb = -20.0; sinrDb <= 10.0; sinrDb += 0.1)
+    {
+      SpectrumValue sinr (sm);
+      sinr = std::pow (10.0, sinrDb / 10.0);
+      double errorRate = LteMiErrorModel::GetPcfichPdcchError (sinr);
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (errorRate, previous, "The error rate should not increase with the SINR (" << sinrDb << " dB)");
+      previous = errorRate;
+      if (sinrDb < -10.5)
+        {
+          // below the curve
+          NS_TEST_ASSERT_MSG_EQ_TOL (errorRate, 0.922602, 1e-9, "Wrong error rate at " << sinrDb << " dB");
+        }
+      else if (sinrDb > -0.5)
+        {
+          // above the curve
+          NS_TEST_ASSERT_MSG_EQ (errorRate, 0.0, "Wrong error rate at " << sinrDb << " dB");
+        }
+    }
+}
+
+
+/**
+ * \ingroup lte-test
+ * \ingroup tests
+ *
+ * \brief LteMiErrorModel test suite
+ */
+class LteMiErrorModelTestSuite : public TestSuite
+{
+public:
+  LteMiErrorModelTestSuite ();
+};
+
+LteMiErrorModelTestSuite::LteMiErrorModelTestSuite ()
+  : TestSuite ("lte-mi-error-model", UNIT)
+{
+  AddTestCase (new LteMiErrorModelBatchTestCase, TestCase::QUICK);
+  AddTestCase (new LtePcfichPdcchErrorTestCase, TestCase::QUICK);
+}
+
+static LteMiErrorModelTestSuite g_lteMiErrorModelTestSuite; ///< the test suite
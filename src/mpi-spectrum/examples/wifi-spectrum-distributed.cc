@@ -0,0 +1,175 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/applications-module.h"
+#include "ns3/mobility-module.h"
+#include "ns3/internet-module.h"
+#include "ns3/spectrum-module.h"
+#include "ns3/mpi-interface.h"
+#include "ns3/remote-spectrum-channel.h"
+#include "ns3/remote-spectrum-wifi-helper.h"
+#include "ns3/spectrum-wifi-helper.h"
+#include "ns3/wifi-helper.h"
+#include "ns3/wifi-mac-helper.h"
+#include "ns3/ssid.h"
+
+#ifdef NS3_MPI
+#include <mpi.h>
+#endif
+
+// Default Network Topology
+//
+// A row of BSSs (one AP and nStas stations each) sharing a RemoteSpectrumChannel.
+// BSS i is simulated by rank (i % number of ranks); the BSSs interfere with
+// each other across ranks.
+//
+//   BSS 0          BSS 1          BSS 2
+//  *  *  *        *  *  *        *  *  *
+//  |  |  |        |  |  |        |  |  |
+//  sta sta AP     sta sta AP     sta sta AP
+//
+//  <-- distance -->
+//
+// Each station sends UDP traffic to its AP and the throughput of each BSS
+// is printed by the rank simulating it. The results do not depend on the
+// number of ranks.
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("WifiSpectrumDistributed");
+
+int
+main (int argc, char *argv[])
+{
+  uint32_t nBss = 2;
+  uint32_t nStas = 2;
+  double distance = 30.0;
+  double simulationTime = 2.0;
+
+  CommandLine cmd;
+  cmd.AddValue ("nBss", "Number of BSSs", nBss);
+  cmd.AddValue ("nStas", "Number of stations per BSS", nStas);
+  cmd.AddValue ("distance", "Distance in meters between the APs of adjacent BSSs", distance);
+  cmd.AddValue ("simulationTime", "Simulation time in seconds", simulationTime);
+  cmd.Parse (argc, argv);
+
+  uint32_t systemId = 0;
+  uint32_t systemCount = 1;
+
+#ifdef NS3_MPI
+  GlobalValue::Bind ("SimulatorImplementationType",
+                     StringValue ("ns3::DistributedSimulatorImpl"));
+
+  MpiInterface::Enable (&argc, &argv);
+
+  systemId = MpiInterface::GetSystemId ();
+  systemCount = MpiInterface::GetSize ();
+#endif // NS3_MPI
+
+  Ptr<RemoteSpectrumChannel> channel = CreateObject<RemoteSpectrumChannel> ();
+  channel->AddPropagationLossModel (CreateObject<LogDistancePropagationLossModel> ());
+  channel->SetPropagationDelayModel (CreateObject<ConstantSpeedPropagationDelayModel> ());
+  RemoteSpectrumWifiHelper::Configure (channel);
+
+  SpectrumWifiPhyHelper phy = SpectrumWifiPhyHelper::Default ();
+  phy.SetChannel (channel);
+  phy.Set ("ChannelNumber", UintegerValue (36));
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211ac);
+  wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                "DataMode", StringValue ("VhtMcs5"),
+                                "ControlMode", StringValue ("VhtMcs0"));
+  WifiMacHelper mac;
+
+  MobilityHelper mobility;
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  InternetStackHelper stack;
+  Ipv4AddressHelper address;
+  address.SetBase ("10.1.0.0", "255.255.255.0");
+
+  std::vector<Ptr<UdpServer> > servers (nBss);
+
+  for (uint32_t bss = 0; bss < nBss; bss++)
+    {
+      uint32_t owner = bss % systemCount;
+      NodeContainer apNode;
+      apNode.Create (1, owner);
+      NodeContainer staNodes;
+      staNodes.Create (nStas, owner);
+
+      Ssid ssid = Ssid ("bss-" + std::to_string (bss));
+      mac.SetType ("ns3::StaWifiMac",
+                   "Ssid", SsidValue (ssid));
+      NetDeviceContainer staDevices = wifi.Install (phy, mac, staNodes);
+      mac.SetType ("ns3::ApWifiMac",
+                   "Ssid", SsidValue (ssid));
+      NetDeviceContainer apDevice = wifi.Install (phy, mac, apNode);
+
+      Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+      positionAlloc->Add (Vector (bss * distance, 0.0, 0.0));
+      for (uint32_t sta = 0; sta < nStas; sta++)
+        {
+          positionAlloc->Add (Vector (bss * distance, 5.0 * (sta + 1), 0.0));
+        }
+      mobility.SetPositionAllocator (positionAlloc);
+      mobility.Install (apNode);
+      mobility.Install (staNodes);
+
+      stack.Install (apNode);
+      stack.Install (staNodes);
+      Ipv4InterfaceContainer apInterface = address.Assign (apDevice);
+      address.Assign (staDevices);
+      address.NewNetwork ();
+
+      if (owner == systemId)
+        {
+          UdpServerHelper server (9);
+          ApplicationContainer serverApp = server.Install (apNode);
+          serverApp.Start (Seconds (0.0));
+          servers[bss] = DynamicCast<UdpServer> (serverApp.Get (0));
+
+          UdpClientHelper client (apInterface.GetAddress (0), 9);
+          client.SetAttribute ("MaxPackets", UintegerValue (4294967295u));
+          client.SetAttribute ("Interval", TimeValue (MilliSeconds (1)));
+          client.SetAttribute ("PacketSize", UintegerValue (1400));
+          ApplicationContainer clientApps = client.Install (staNodes);
+          clientApps.Start (Seconds (0.5));
+        }
+    }
+
+  Simulator::Stop (Seconds (simulationTime + 0.5));
+  Simulator::Run ();
+
+  for (uint32_t bss = 0; bss < nBss; bss++)
+    {
+      if (servers[bss] != 0)
+        {
+          double throughput = servers[bss]->GetReceived () * 1400 * 8 / (simulationTime * 1000000.0);
+          std::cout << "BSS " << bss << " (rank " << systemId << "): " << throughput << " Mbit/s" << std::endl;
+        }
+    }
+
+  Simulator::Destroy ();
+
+#ifdef NS3_MPI
+  MpiInterface::Disable ();
+#endif
+
+  return 0;
+}
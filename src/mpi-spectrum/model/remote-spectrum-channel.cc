@@ -0,0 +1,397 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cstring>
+#include <ns3/simulator.h>
+#include <ns3/log.h>
+#include <ns3/net-device.h>
+#include <ns3/node.h>
+#include <ns3/node-list.h>
+#include <ns3/mobility-model.h>
+#include <ns3/spectrum-value.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/propagation-delay-model.h>
+#include <ns3/antenna-model.h>
+#include <ns3/angles.h>
+#include <ns3/mpi-interface.h>
+#include <ns3/mpi-receiver.h>
+#include "remote-spectrum-channel.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("RemoteSpectrumChannel");
+
+NS_OBJECT_ENSURE_REGISTERED (RemoteSpectrumChannel);
+
+/**
+ * \param value the double value
+ * \return the bit pattern of the given value
+ */
+static uint64_t
+DoubleToBits (double value)
+{
+  uint64_t bits;
+  std::memcpy (&bits, &value, sizeof (bits));
+  return bits;
+}
+
+/**
+ * \param bits the bit pattern of a double value
+ * \return the double value
+ */
+static double
+BitsToDouble (uint64_t bits)
+{
+  double value;
+  std::memcpy (&value, &bits, sizeof (value));
+  return value;
+}
+
+RemoteSpectrumChannel::RemoteSpectrumChannel ()
+  : m_remoteLookAhead (Seconds (-1))
+{
+  NS_LOG_FUNCTION (this);
+  AddSignalParametersType<SpectrumSignalParameters> ();
+}
+
+void
+RemoteSpectrumChannel::DoDispose ()
+{
+  NS_LOG_FUNCTION (this);
+  m_signalTypeFactories.clear ();
+  m_phys.clear ();
+  m_localPhys.clear ();
+  m_remotePhys.clear ();
+  m_spectrumModels.clear ();
+  MultiModelSpectrumChannel::DoDispose ();
+}
+
+TypeId
+RemoteSpectrumChannel::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::RemoteSpectrumChannel")
+    .SetParent<MultiModelSpectrumChannel> ()
+    .SetGroupName ("Spectrum")
+    .AddConstructor<RemoteSpectrumChannel> ()
+    .AddAttribute ("RemoteLookAhead",
+                   "The minimum propagation delay between a SpectrumPhy owned by "
+                   "this system and a SpectrumPhy owned by another system.",
+                   TypeId::ATTR_GET,
+                   TimeValue (Time::Max ()),
+                   MakeTimeAccessor (&RemoteSpectrumChannel::GetRemoteLookAhead),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+uint32_t
+RemoteSpectrumChannel::GetSystemId (Ptr<const SpectrumPhy> phy)
+{
+  Ptr<NetDevice> device = phy->GetDevice ();
+  if (device == 0 || device->GetNode () == 0)
+    {
+      return MpiInterface::GetSystemId ();
+    }
+  return device->GetNode ()->GetSystemId ();
+}
+
+void
+RemoteSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
+{
+  NS_LOG_FUNCTION (this << phy);
+
+  Ptr<const SpectrumModel> model = phy->GetRxSpectrumModel ();
+  if (std::find (m_spectrumModels.begin (), m_spectrumModels.end (), model) == m_spectrumModels.end ())
+    {
+      m_spectrumModels.push_back (model);
+    }
+
+  Ptr<NetDevice> device = phy->GetDevice ();
+  if (device != 0 && device->GetNode () != 0)
+    {
+      m_phys[std::make_pair (device->GetNode ()->GetId (), device->GetIfIndex ())] = phy;
+    }
+
+  uint32_t systemId = GetSystemId (phy);
+  if (systemId == MpiInterface::GetSystemId ())
+    {
+      MultiModelSpectrumChannel::AddRx (phy);
+      if (std::find (m_localPhys.begin (), m_localPhys.end (), phy) != m_localPhys.end ())
+        {
+          // spectrum model change
+          return;
+        }
+      m_localPhys.push_back (phy);
+      if (device != 0 && device->GetNode () != 0)
+        {
+          // receive the signals sent by the other systems to this device
+          Ptr<MpiReceiver> mpiRec = device->GetObject<MpiReceiver> ();
+          if (mpiRec == 0)
+            {
+              mpiRec = CreateObject<MpiReceiver> ();
+              device->AggregateObject (mpiRec);
+            }
+          mpiRec->SetReceiveCallback (MakeCallback (&RemoteSpectrumChannel::ReceiveFromRemote, this));
+        }
+    }
+  else
+    {
+      std::vector<Ptr<SpectrumPhy> > &phys = m_remotePhys[systemId];
+      if (std::find (phys.begin (), phys.end (), phy) == phys.end ())
+        {
+          phys.push_back (phy);
+        }
+    }
+}
+
+Time
+RemoteSpectrumChannel::GetRemoteLookAhead (void) const
+{
+  NS_LOG_FUNCTION (this);
+  if (!m_remoteLookAhead.IsNegative ())
+    {
+      return m_remoteLookAhead;
+    }
+  // The SpectrumPhy instances may not be attached yet when the simulator
+  // queries the lookahead (e.g., they attach when their device is
+  // initialized), hence look for the devices attached to this channel
+  std::vector<Ptr<MobilityModel> > localMobilities;
+  std::vector<Ptr<MobilityModel> > remoteMobilities;
+  Ptr<const Channel> channel = this;
+  for (NodeList::Iterator node = NodeList::Begin (); node != NodeList::End (); ++node)
+    {
+      for (uint32_t i = 0; i < (*node)->GetNDevices (); i++)
+        {
+          if ((*node)->GetDevice (i)->GetChannel () != channel)
+            {
+              continue;
+            }
+          Ptr<MobilityModel> mobility = (*node)->GetObject<MobilityModel> ();
+          NS_ABORT_MSG_IF (mobility == 0, "A mobility model is required to distribute a spectrum channel across systems");
+          if ((*node)->GetSystemId () == MpiInterface::GetSystemId ())
+            {
+              localMobilities.push_back (mobility);
+            }
+          else
+            {
+              remoteMobilities.push_back (mobility);
+            }
+          break;
+        }
+    }
+  Time lookAhead = Time::Max ();
+  if (!localMobilities.empty () && !remoteMobilities.empty ())
+    {
+      NS_ABORT_MSG_IF (m_propagationDelay == 0,
+                       "A propagation delay model is required to distribute a spectrum channel across systems");
+      for (std::vector<Ptr<MobilityModel> >::const_iterator remote = remoteMobilities.begin ();
+           remote != remoteMobilities.end (); ++remote)
+        {
+          for (std::vector<Ptr<MobilityModel> >::const_iterator local = localMobilities.begin ();
+               local != localMobilities.end (); ++local)
+            {
+              lookAhead = std::min (lookAhead, m_propagationDelay->GetDelay (*local, *remote));
+            }
+        }
+    }
+  NS_ABORT_MSG_IF (lookAhead.IsZero (), "Null propagation delay between SpectrumPhy instances owned by different systems");
+  m_remoteLookAhead = lookAhead;
+  return lookAhead;
+}
+
+Ptr<Packet>
+RemoteSpectrumChannel::SerializeSignal (Ptr<const SpectrumSignalParameters> txParams) const
+{
+  NS_LOG_FUNCTION (this << txParams);
+
+  std::string name = typeid (*txParams).name ();
+  std::vector<std::string>::const_iterator typeIt = std::find (m_signalTypeNames.begin (), m_signalTypeNames.end (), name);
+  NS_ABORT_MSG_IF (typeIt == m_signalTypeNames.end (), "Signal parameters of type " << name << " cannot be sent to other systems");
+
+  Ptr<NetDevice> txDevice = txParams->txPhy->GetDevice ();
+  Ptr<const SpectrumModel> model = txParams->psd->GetSpectrumModel ();
+  NS_ASSERT (model->GetNumBands () > 0);
+
+  // transmission start, transmitter, type, spectrum model and parameters
+  uint32_t size = 8 + 4 + 4 + 1 + 4 + 8 + 8 + txParams->GetSerializedSize ();
+  Buffer buffer;
+  buffer.AddAtStart (size);
+  Buffer::Iterator i = buffer.Begin ();
+  i.WriteHtonU64 (Simulator::Now ().GetTimeStep ());
+  i.WriteHtonU32 (txDevice->GetNode ()->GetId ());
+  i.WriteHtonU32 (txDevice->GetIfIndex ());
+  i.WriteU8 (static_cast<uint8_t> (typeIt - m_signalTypeNames.begin ()));
+  i.WriteHtonU32 (model->GetNumBands ());
+  i.WriteHtonU64 (DoubleToBits (model->Begin ()->fl));
+  i.WriteHtonU64 (DoubleToBits ((model->End () - 1)->fh));
+  txParams->Serialize (i);
+
+  return Create<Packet> (buffer.PeekData (), size);
+}
+
+void
+RemoteSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
+{
+  NS_LOG_FUNCTION (this << txParams);
+
+  if (GetSystemId (txParams->txPhy) != MpiInterface::GetSystemId ())
+    {
+      // the transmission is also started by the system owning the
+      // transmitter, which takes care of sending it to this system
+      NS_LOG_LOGIC ("Ignoring transmission of the replica of a remote SpectrumPhy");
+      return;
+    }
+
+  MultiModelSpectrumChannel::StartTx (txParams);
+
+  Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
+  if (m_remotePhys.empty () || txMobility == 0 || txParams->txPhy->GetDevice () == 0)
+    {
+      return;
+    }
+
+  NS_ABORT_MSG_IF (m_propagationDelay == 0,
+                   "A propagation delay model is required to distribute a spectrum channel across systems");
+  Ptr<Packet> packet;
+  for (std::map<uint32_t, std::vector<Ptr<SpectrumPhy> > >::const_iterator it = m_remotePhys.begin ();
+       it != m_remotePhys.end (); ++it)
+    {
+      // the signal is sent to the closest receiver within range
+      Ptr<SpectrumPhy> receiver;
+      Time minDelay = Time::Max ();
+      for (std::vector<Ptr<SpectrumPhy> >::const_iterator rxPhy = it->second.begin (); rxPhy != it->second.end (); ++rxPhy)
+        {
+          Ptr<MobilityModel> receiverMobility = (*rxPhy)->GetMobility ();
+          if (receiverMobility == 0 || (*rxPhy)->GetDevice () == 0)
+            {
+              continue;
+            }
+          double pathLossDb = 0;
+          if (txParams->txAntenna != 0)
+            {
+              Angles txAngles (receiverMobility->GetPosition (), txMobility->GetPosition ());
+              pathLossDb -= txParams->txAntenna->GetGainDb (txAngles);
+            }
+          Ptr<AntennaModel> rxAntenna = (*rxPhy)->GetRxAntenna ();
+          if (rxAntenna != 0)
+            {
+              Angles rxAngles (txMobility->GetPosition (), receiverMobility->GetPosition ());
+              pathLossDb -= rxAntenna->GetGainDb (rxAngles);
+            }
+          if (m_propagationLoss)
+            {
+              pathLossDb -= m_propagationLoss->CalcRxPower (0, txMobility, receiverMobility);
+            }
+          if (pathLossDb > m_maxLossDb)
+            {
+              // beyond range
+              continue;
+            }
+          Time delay = m_propagationDelay->GetDelay (txMobility, receiverMobility);
+          if (delay < minDelay)
+            {
+              minDelay = delay;
+              receiver = *rxPhy;
+            }
+        }
+
+      if (receiver == 0)
+        {
+          NS_LOG_LOGIC ("No receiver within range in system " << it->first);
+          continue;
+        }
+      NS_ABORT_MSG_IF (minDelay < GetRemoteLookAhead (),
+                       "Propagation delay to system " << it->first << " (" << minDelay
+                       << ") is less than the lookahead (" << GetRemoteLookAhead () << ")");
+
+      if (packet == 0)
+        {
+          packet = SerializeSignal (txParams);
+        }
+      Ptr<NetDevice> rxDevice = receiver->GetDevice ();
+      NS_LOG_LOGIC ("Sending signal to node " << rxDevice->GetNode ()->GetId () << " in system " << it->first);
+      MpiInterface::SendPacket (packet, Simulator::Now () + minDelay,
+                                rxDevice->GetNode ()->GetId (), rxDevice->GetIfIndex ());
+    }
+}
+
+Ptr<const SpectrumModel>
+RemoteSpectrumChannel::FindSpectrumModel (uint32_t nBands, double fl, double fh)
+{
+  NS_LOG_FUNCTION (this << nBands << fl << fh);
+  for (std::vector<Ptr<const SpectrumModel> >::const_iterator it = m_spectrumModels.begin ();
+       it != m_spectrumModels.end (); ++it)
+    {
+      if ((*it)->GetNumBands () == nBands && (*it)->Begin ()->fl == fl && ((*it)->End () - 1)->fh == fh)
+        {
+          return *it;
+        }
+    }
+
+  NS_LOG_DEBUG ("Creating a SpectrumModel with " << nBands << " bands between " << fl << " and " << fh);
+  Bands bands;
+  double bandWidth = (fh - fl) / nBands;
+  for (uint32_t b = 0; b < nBands; b++)
+    {
+      BandInfo info;
+      info.fl = fl + b * bandWidth;
+      info.fc = info.fl + bandWidth / 2;
+      info.fh = info.fl + bandWidth;
+      bands.push_back (info);
+    }
+  Ptr<const SpectrumModel> model = Create<SpectrumModel> (bands);
+  m_spectrumModels.push_back (model);
+  return model;
+}
+
+void
+RemoteSpectrumChannel::ReceiveFromRemote (Ptr<Packet> packet)
+{
+  NS_LOG_FUNCTION (this << packet);
+
+  uint32_t size = packet->GetSize ();
+  std::vector<uint8_t> data (size);
+  packet->CopyData (data.data (), size);
+  Buffer buffer;
+  buffer.AddAtStart (size);
+  Buffer::Iterator i = buffer.Begin ();
+  i.Write (data.data (), size);
+  i = buffer.Begin ();
+
+  Time txStart = TimeStep (i.ReadNtohU64 ());
+  uint32_t txNodeId = i.ReadNtohU32 ();
+  uint32_t txIfIndex = i.ReadNtohU32 ();
+  uint8_t type = i.ReadU8 ();
+  uint32_t nBands = i.ReadNtohU32 ();
+  double fl = BitsToDouble (i.ReadNtohU64 ());
+  double fh = BitsToDouble (i.ReadNtohU64 ());
+
+  std::map<std::pair<uint32_t, uint32_t>, Ptr<SpectrumPhy> >::const_iterator txIt = m_phys.find (std::make_pair (txNodeId, txIfIndex));
+  NS_ABORT_MSG_IF (txIt == m_phys.end (), "Unknown transmitter (node " << txNodeId << ", device " << txIfIndex << ")");
+  NS_ABORT_MSG_IF (type >= m_signalTypeFactories.size (), "Unknown signal parameters type " << +type);
+
+  Ptr<SpectrumSignalParameters> txParams = m_signalTypeFactories[type] ();
+  txParams->psd = Create<SpectrumValue> (FindSpectrumModel (nBands, fl, fh));
+  txParams->Deserialize (i);
+  // the local replica of the transmitter is used to compute the propagation
+  txParams->txPhy = txIt->second;
+  txParams->txAntenna = txIt->second->GetRxAntenna ();
+
+  Propagate (txParams, Simulator::Now () - txStart);
+}
+
+} // namespace ns3
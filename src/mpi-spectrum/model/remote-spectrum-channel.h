@@ -0,0 +1,191 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef REMOTE_SPECTRUM_CHANNEL_H
+#define REMOTE_SPECTRUM_CHANNEL_H
+
+#include <ns3/multi-model-spectrum-channel.h>
+#include <ns3/callback.h>
+#include <ns3/abort.h>
+#include <ns3/packet.h>
+#include <map>
+#include <string>
+#include <typeinfo>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \defgroup mpi-spectrum Distributed spectrum channels
+ * \ingroup mpi
+ *
+ * SpectrumChannel models whose receivers can be spread across the
+ * systems of a distributed simulation. This module is only built when
+ * MPI support is enabled.
+ */
+
+/**
+ * \ingroup mpi-spectrum
+ *
+ * A MultiModelSpectrumChannel whose SpectrumPhy instances can be spread
+ * across the systems (MPI ranks) of a distributed simulation.
+ *
+ * As usual for distributed simulations, every system builds the whole
+ * topology, but only executes the events of the nodes it owns (i.e., whose
+ * system id matches the system id of the MPI rank). Transmissions started
+ * by the local replicas of nodes owned by other systems are ignored. When
+ * a local SpectrumPhy transmits, the signal is propagated to the local
+ * receivers as done by MultiModelSpectrumChannel and the signal parameters
+ * are sent, by means of the MpiInterface, to every other system owning at
+ * least one receiver within range (i.e., whose path loss does not exceed
+ * the MaxLossDb attribute). The remote system then propagates the signal
+ * to its local receivers, so that each signal is sent once per system and
+ * not once per receiver.
+ *
+ * Signal parameters are exchanged in a compact serialized form (see
+ * SpectrumSignalParameters::Serialize). In order for a type of signal
+ * parameters to be exchanged, it must be registered by means of the
+ * AddSignalParametersType method, in the same order on all the systems.
+ *
+ * The lookahead of the channel, i.e., the minimum propagation delay
+ * between a local and a remote SpectrumPhy, is available through the
+ * RemoteLookAhead attribute and is used by the DistributedSimulatorImpl to
+ * determine the lookahead of the simulation. Hence, a deterministic
+ * propagation delay model (e.g., ConstantSpeedPropagationDelayModel) must
+ * be set and nodes must not move closer to nodes owned by other systems
+ * than they were at the start of the simulation. Also, since the remote
+ * systems use their replica of the transmitter to compute the propagation
+ * loss, the position of every node must be the same on all the systems.
+ */
+class RemoteSpectrumChannel : public MultiModelSpectrumChannel
+{
+public:
+  RemoteSpectrumChannel ();
+
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+
+  // inherited from SpectrumChannel
+  virtual void AddRx (Ptr<SpectrumPhy> phy);
+  virtual void StartTx (Ptr<SpectrumSignalParameters> params);
+
+  /**
+   * Register a type of signal parameters, so that the signals of this
+   * type can be exchanged with the other systems. Registering the same
+   * type multiple times has no effect.
+   *
+   * \tparam T the type of signal parameters (derived from SpectrumSignalParameters)
+   */
+  template <typename T>
+  void AddSignalParametersType (void);
+
+  /**
+   * The lookahead is computed from the nodes having a device attached to
+   * this channel, so that it is available before the SpectrumPhy instances
+   * are attached to the channel (e.g., when the simulation starts).
+   *
+   * \return the minimum propagation delay between a node owned by this
+   *         system and a node owned by another system, or Time::Max () if
+   *         no node owned by another system is attached to this channel
+   */
+  Time GetRemoteLookAhead (void) const;
+
+protected:
+  void DoDispose ();
+
+private:
+  /**
+   * \param phy the SpectrumPhy
+   * \return the system id of the node the given SpectrumPhy is attached to
+   *         (the local system id if the SpectrumPhy has no NetDevice)
+   */
+  static uint32_t GetSystemId (Ptr<const SpectrumPhy> phy);
+  /**
+   * Create signal parameters of the given type.
+   *
+   * \tparam T the type of signal parameters
+   * \return the created signal parameters
+   */
+  template <typename T>
+  static Ptr<SpectrumSignalParameters> CreateSignalParameters (void);
+  /**
+   * Serialize the given signal parameters of a local transmitter.
+   *
+   * \param txParams the signal parameters
+   * \return a packet containing the serialized signal parameters
+   */
+  Ptr<Packet> SerializeSignal (Ptr<const SpectrumSignalParameters> txParams) const;
+  /**
+   * Find the SpectrumModel with the given characteristics among those
+   * of the SpectrumPhy instances attached to this channel, or create a
+   * SpectrumModel made of equally spaced bands if none is found.
+   *
+   * \param nBands the number of bands
+   * \param fl the lower limit of the first band
+   * \param fh the upper limit of the last band
+   * \return the SpectrumModel
+   */
+  Ptr<const SpectrumModel> FindSpectrumModel (uint32_t nBands, double fl, double fh);
+  /**
+   * Propagate a signal received from another system to the local receivers.
+   *
+   * \param packet the packet containing the serialized signal parameters
+   */
+  void ReceiveFromRemote (Ptr<Packet> packet);
+
+  /// Signal parameters factory
+  typedef Callback<Ptr<SpectrumSignalParameters> > SignalParametersFactory;
+
+  std::vector<std::string> m_signalTypeNames;                  //!< names of the registered signal parameter types
+  std::vector<SignalParametersFactory> m_signalTypeFactories;  //!< factories of the registered signal parameter types
+  std::map<std::pair<uint32_t, uint32_t>, Ptr<SpectrumPhy> > m_phys;  //!< all the SpectrumPhy instances indexed by node id and device index
+  std::vector<Ptr<SpectrumPhy> > m_localPhys;                  //!< the SpectrumPhy instances owned by this system
+  std::map<uint32_t, std::vector<Ptr<SpectrumPhy> > > m_remotePhys;  //!< the SpectrumPhy instances owned by other systems, indexed by system id
+  std::vector<Ptr<const SpectrumModel> > m_spectrumModels;     //!< the known SpectrumModels
+  mutable Time m_remoteLookAhead;                              //!< the lookahead (negative if not computed yet)
+};
+
+
+template <typename T>
+Ptr<SpectrumSignalParameters>
+RemoteSpectrumChannel::CreateSignalParameters (void)
+{
+  return Create<T> ();
+}
+
+template <typename T>
+void
+RemoteSpectrumChannel::AddSignalParametersType (void)
+{
+  std::string name = typeid (T).name ();
+  for (std::vector<std::string>::const_iterator it = m_signalTypeNames.begin (); it != m_signalTypeNames.end (); ++it)
+    {
+      if (*it == name)
+        {
+          return;
+        }
+    }
+  NS_ABORT_MSG_IF (m_signalTypeNames.size () > 0xff, "Too many signal parameter types");
+  m_signalTypeNames.push_back (name);
+  m_signalTypeFactories.push_back (MakeCallback (&RemoteSpectrumChannel::CreateSignalParameters<T>));
+}
+
+} // namespace ns3
+
+#endif /* REMOTE_SPECTRUM_CHANNEL_H */
@@ -190,14 +190,21 @@ DistributedSimulatorImpl::CalculateLookAhead (void)
           for (uint32_t i = 0; i < (*iter)->GetNDevices (); ++i)
             {
               Ptr<NetDevice> localNetDevice = (*iter)->GetDevice (i);
-              // only works for p2p links currently
-              if (!localNetDevice->IsPointToPoint ())
+              Ptr<Channel> channel = localNetDevice->GetChannel ();
+              if (channel == 0)
                 {
                   continue;
                 }
-              Ptr<Channel> channel = localNetDevice->GetChannel ();
-              if (channel == 0)
+              // channels shared by devices of several systems (e.g.,
+              // RemoteSpectrumChannel) report their own lookahead
+              if (!localNetDevice->IsPointToPoint ())
                 {
+                  TimeValue remoteLookAhead;
+                  if (channel->GetAttributeFailSafe ("RemoteLookAhead", remoteLookAhead)
+                      && remoteLookAhead.Get () < m_lookAhead)
+                    {
+                      m_lookAhead = remoteLookAhead.Get ();
+                    }
                   continue;
                 }
 
@@ -388,7 +395,9 @@ DistributedSimulatorImpl::Run (void)
       if (nextTime > m_grantedTime || IsLocalFinished () )
         {
           // Can't process next event, calculate a new LBTS
-          // First receive any pending messages
+          // First send the packets coalesced during the window
+          GrantedTimeWindowMpiInterface::FlushSendBuffers ();
+          // Then receive any pending messages
           GrantedTimeWindowMpiInterface::ReceiveMessages ();
           // reset next time
           nextTime = Next ();
@@ -22,7 +22,8 @@
 
 #include <iostream>
 #include <iomanip>
-#include <list>
+#include <cstring>
+#include <vector>
 
 #include "granted-time-window-mpi-interface.h"
 #include "mpi-receiver.h"
@@ -35,6 +36,8 @@
 #include "ns3/simulator-impl.h"
 #include "ns3/nstime.h"
 #include "ns3/log.h"
+#include "ns3/global-value.h"
+#include "ns3/boolean.h"
 
 #ifdef NS3_MPI
 #include <mpi.h>
@@ -44,29 +47,41 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("GrantedTimeWindowMpiInterface");
 
+/**
+ * \ingroup mpi
+ * \brief Whether the packets sent to the same system are coalesced into a
+ * single MPI message until the next synchronization
+ */
+static GlobalValue g_batchMessages = GlobalValue
+  ("MpiBatchMessages",
+  "Whether the packets sent to the same system within a granted time "
+  "window are coalesced into a single MPI message",
+  BooleanValue (true),
+  MakeBooleanChecker ());
+
+/**
+ * Size of the header preceding each packet in a message: the receive
+ * time, the destination node, the destination device and the size of
+ * the serialized packet
+ */
+static const uint32_t PACKET_HEADER_SIZE = sizeof (uint64_t) + 3 * sizeof (uint32_t);
+
 SentBuffer::SentBuffer ()
+  : m_inUse (false)
 {
-  m_buffer = 0;
+#ifdef NS3_MPI
+  m_request = MPI_REQUEST_NULL;
+#else
   m_request = 0;
+#endif
 }
 
-SentBuffer::~SentBuffer ()
-{
-  delete [] m_buffer;
-}
-
-uint8_t*
+std::vector<uint8_t>&
 SentBuffer::GetBuffer ()
 {
   return m_buffer;
 }
 
-void
-SentBuffer::SetBuffer (uint8_t* buffer)
-{
-  m_buffer = buffer;
-}
-
 #ifdef NS3_MPI
 MPI_Request*
 SentBuffer::GetRequest ()
@@ -75,13 +90,29 @@ SentBuffer::GetRequest ()
 }
 #endif
 
+bool
+SentBuffer::IsInUse (void) const
+{
+  return m_inUse;
+}
+
+void
+SentBuffer::SetInUse (bool inUse)
+{
+  m_inUse = inUse;
+}
+
 uint32_t              GrantedTimeWindowMpiInterface::m_sid = 0;
 uint32_t              GrantedTimeWindowMpiInterface::m_size = 1;
 bool                  GrantedTimeWindowMpiInterface::m_initialized = false;
 bool                  GrantedTimeWindowMpiInterface::m_enabled = false;
 uint32_t              GrantedTimeWindowMpiInterface::m_rxCount = 0;
 uint32_t              GrantedTimeWindowMpiInterface::m_txCount = 0;
-std::list<SentBuffer> GrantedTimeWindowMpiInterface::m_pendingTx;
+uint32_t              GrantedTimeWindowMpiInterface::m_txMessageCount = 0;
+bool                  GrantedTimeWindowMpiInterface::m_batching = true;
+std::vector<SentBuffer> GrantedTimeWindowMpiInterface::m_txPool;
+uint32_t              GrantedTimeWindowMpiInterface::m_txPoolNext = 0;
+std::vector<int32_t>  GrantedTimeWindowMpiInterface::m_txBatches;
 
 #ifdef NS3_MPI
 MPI_Request* GrantedTimeWindowMpiInterface::m_requests;
@@ -104,14 +135,21 @@ GrantedTimeWindowMpiInterface::Destroy ()
   NS_LOG_FUNCTION (this);
 
 #ifdef NS3_MPI
+  NS_LOG_INFO ("Sent " << m_txCount << " packets in " << m_txMessageCount << " messages");
+
   for (uint32_t i = 0; i < GetSize (); ++i)
     {
+      MPI_Cancel (&m_requests[i]);
+      MPI_Wait (&m_requests[i], MPI_STATUS_IGNORE);
+      MPI_Request_free (&m_requests[i]);
       delete [] m_pRxBuffers[i];
     }
   delete [] m_pRxBuffers;
   delete [] m_requests;
 
-  m_pendingTx.clear ();
+  m_txPool.clear ();
+  m_txPoolNext = 0;
+  m_txBatches.clear ();
 #endif
 }
 
@@ -173,15 +211,20 @@ GrantedTimeWindowMpiInterface::Enable (int* pargc, char*** pargv)
   MPI_Comm_size (MPI_COMM_WORLD, reinterpret_cast <int *> (&m_size));
   m_enabled = true;
   m_initialized = true;
-  // Post a non-blocking receive for all peers
+  BooleanValue batching;
+  g_batchMessages.GetValue (batching);
+  m_batching = batching.Get ();
+  m_txBatches.assign (m_size, -1);
+  // Post a persistent non-blocking receive for all peers
   m_pRxBuffers = new char*[m_size];
   m_requests = new MPI_Request[m_size];
   for (uint32_t i = 0; i < GetSize (); ++i)
     {
-      m_pRxBuffers[i] = new char[MAX_MPI_MSG_SIZE];
-      MPI_Irecv (m_pRxBuffers[i], MAX_MPI_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
-                 MPI_COMM_WORLD, &m_requests[i]);
+      m_pRxBuffers[i] = new char[MAX_MPI_BATCH_SIZE];
+      MPI_Recv_init (m_pRxBuffers[i], MAX_MPI_BATCH_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
+                     MPI_COMM_WORLD, &m_requests[i]);
     }
+  MPI_Startall (m_size, m_requests);
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
@@ -193,30 +236,126 @@ GrantedTimeWindowMpiInterface::SendPacket (Ptr<Packet> p, const Time& rxTime, ui
   NS_LOG_FUNCTION (this << p << rxTime.GetTimeStep () << node << dev);
 
 #ifdef NS3_MPI
-  SentBuffer sendBuf;
-  m_pendingTx.push_back (sendBuf);
-  std::list<SentBuffer>::reverse_iterator i = m_pendingTx.rbegin (); // Points to the last element
-
   uint32_t serializedSize = p->GetSerializedSize ();
-  uint8_t* buffer =  new uint8_t[serializedSize + 16];
-  i->SetBuffer (buffer);
-  // Add the time, dest node and dest device
-  uint64_t t = rxTime.GetInteger ();
-  uint64_t* pTime = reinterpret_cast <uint64_t *> (buffer);
-  *pTime++ = t;
-  uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
-  *pData++ = node;
-  *pData++ = dev;
-  // Serialize the packet
-  p->Serialize (reinterpret_cast<uint8_t *> (pData), serializedSize);
+  uint32_t size = PACKET_HEADER_SIZE + serializedSize;
 
   // Find the system id for the destination node
   Ptr<Node> destNode = NodeList::GetNode (node);
   uint32_t nodeSysId = destNode->GetSystemId ();
 
-  MPI_Isend (reinterpret_cast<void *> (i->GetBuffer ()), serializedSize + 16, MPI_CHAR, nodeSysId,
-             0, MPI_COMM_WORLD, (i->GetRequest ()));
+  // Append the packet to the message coalescing the packets sent to
+  // the destination system, unless it does not fit in it
+  int32_t batch = m_txBatches[nodeSysId];
+  if (batch >= 0 && m_txPool[batch].GetBuffer ().size () + size > MAX_MPI_BATCH_SIZE)
+    {
+      PostSend (batch, nodeSysId, 0);
+      batch = -1;
+    }
+  uint32_t index = (batch >= 0) ? batch : AcquireSendBuffer ();
+  std::vector<uint8_t>& buffer = m_txPool[index].GetBuffer ();
+  std::size_t offset = buffer.size ();
+  buffer.resize (offset + size);
+  uint8_t* pData = &buffer[offset];
+
+  // Add the time, dest node, dest device and packet size
+  uint64_t t = rxTime.GetInteger ();
+  std::memcpy (pData, &t, sizeof (t));
+  pData += sizeof (t);
+  std::memcpy (pData, &node, sizeof (node));
+  pData += sizeof (node);
+  std::memcpy (pData, &dev, sizeof (dev));
+  pData += sizeof (dev);
+  std::memcpy (pData, &serializedSize, sizeof (serializedSize));
+  pData += sizeof (serializedSize);
+  // Serialize the packet
+  p->Serialize (pData, serializedSize);
   m_txCount++;
+
+  if (size > MAX_MPI_BATCH_SIZE)
+    {
+      // Messages that do not fit the posted receive buffers are sent with
+      // their own tag and received after probing their size
+      PostSend (index, nodeSysId, 1);
+      m_txBatches[nodeSysId] = -1;
+    }
+  else if (m_batching)
+    {
+      // Sent upon the next synchronization
+      m_txBatches[nodeSysId] = index;
+    }
+  else
+    {
+      PostSend (index, nodeSysId, 0);
+      m_txBatches[nodeSysId] = -1;
+    }
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+uint32_t
+GrantedTimeWindowMpiInterface::AcquireSendBuffer ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+#ifdef NS3_MPI
+  if (!m_txPool.empty ())
+    {
+      SentBuffer& next = m_txPool[m_txPoolNext];
+      if (next.IsInUse () && *next.GetRequest () != MPI_REQUEST_NULL)
+        {
+          int flag = 0;
+          MPI_Test (next.GetRequest (), &flag, MPI_STATUS_IGNORE);
+          next.SetInUse (!flag);
+        }
+      if (!next.IsInUse ())
+        {
+          uint32_t index = m_txPoolNext;
+          m_txPoolNext = (m_txPoolNext + 1) % m_txPool.size ();
+          next.GetBuffer ().clear ();
+          next.SetInUse (true);
+          return index;
+        }
+    }
+  // No buffer available, grow the pool
+  m_txPool.push_back (SentBuffer ());
+  m_txPool.back ().SetInUse (true);
+  return m_txPool.size () - 1;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+  return 0;
+#endif
+}
+
+void
+GrantedTimeWindowMpiInterface::PostSend (uint32_t index, uint32_t rank, int tag)
+{
+  NS_LOG_FUNCTION (index << rank << tag);
+
+#ifdef NS3_MPI
+  SentBuffer& sent = m_txPool[index];
+  MPI_Isend (sent.GetBuffer ().data (), sent.GetBuffer ().size (), MPI_CHAR, rank,
+             tag, MPI_COMM_WORLD, sent.GetRequest ());
+  m_txMessageCount++;
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+void
+GrantedTimeWindowMpiInterface::FlushSendBuffers ()
+{
+  NS_LOG_FUNCTION_NOARGS ();
+
+#ifdef NS3_MPI
+  for (uint32_t rank = 0; rank < m_txBatches.size (); ++rank)
+    {
+      if (m_txBatches[rank] >= 0)
+        {
+          PostSend (m_txBatches[rank], rank, 0);
+          m_txBatches[rank] = -1;
+        }
+    }
 #else
   NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
@@ -242,20 +381,64 @@ GrantedTimeWindowMpiInterface::ReceiveMessages ()
         }
       int count;
       MPI_Get_count (&status, MPI_CHAR, &count);
+      HandleMessage (m_pRxBuffers[index], count);
+
+      // Re-queue the next read
+      MPI_Start (&m_requests[index]);
+    }
+
+  // Receive the messages exceeding MAX_MPI_BATCH_SIZE
+  while (true)
+    {
+      int flag = 0;
+      MPI_Status status;
+
+      MPI_Iprobe (MPI_ANY_SOURCE, 1, MPI_COMM_WORLD, &flag, &status);
+      if (!flag)
+        {
+          break;        // No more messages
+        }
+      int count;
+      MPI_Get_count (&status, MPI_CHAR, &count);
+      std::vector<char> buffer (count);
+      MPI_Recv (buffer.data (), count, MPI_CHAR, status.MPI_SOURCE, 1,
+                MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      HandleMessage (buffer.data (), count);
+    }
+#else
+  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
+#endif
+}
+
+void
+GrantedTimeWindowMpiInterface::HandleMessage (char* buffer, int count)
+{
+  NS_LOG_FUNCTION (static_cast<void *> (buffer) << count);
+
+#ifdef NS3_MPI
+  while (count > 0)
+    {
       m_rxCount++; // Count this receive
 
       // Get the meta data first
-      uint64_t* pTime = reinterpret_cast<uint64_t *> (m_pRxBuffers[index]);
-      uint64_t time = *pTime++;
-      uint32_t* pData = reinterpret_cast<uint32_t *> (pTime);
-      uint32_t node = *pData++;
-      uint32_t dev  = *pData++;
+      uint64_t time;
+      uint32_t node;
+      uint32_t dev;
+      uint32_t size;
+      std::memcpy (&time, buffer, sizeof (time));
+      buffer += sizeof (time);
+      std::memcpy (&node, buffer, sizeof (node));
+      buffer += sizeof (node);
+      std::memcpy (&dev, buffer, sizeof (dev));
+      buffer += sizeof (dev);
+      std::memcpy (&size, buffer, sizeof (size));
+      buffer += sizeof (size);
 
       Time rxTime (time);
 
-      count -= sizeof (time) + sizeof (node) + sizeof (dev);
-
-      Ptr<Packet> p = Create<Packet> (reinterpret_cast<uint8_t *> (pData), count, true);
+      Ptr<Packet> p = Create<Packet> (reinterpret_cast<uint8_t *> (buffer), size, true);
+      buffer += size;
+      count -= PACKET_HEADER_SIZE + size;
 
       // Find the correct node/device to schedule receive event
       Ptr<Node> pNode = NodeList::GetNode (node);
@@ -276,13 +459,7 @@ GrantedTimeWindowMpiInterface::ReceiveMessages ()
       // Schedule the rx event
       Simulator::ScheduleWithContext (pNode->GetId (), rxTime - Simulator::Now (),
                                       &MpiReceiver::Receive, pMpiRec, p);
-
-      // Re-queue the next read
-      MPI_Irecv (m_pRxBuffers[index], MAX_MPI_MSG_SIZE, MPI_CHAR, MPI_ANY_SOURCE, 0,
-                 MPI_COMM_WORLD, &m_requests[index]);
     }
-#else
-  NS_FATAL_ERROR ("Can't use distributed simulator without MPI compiled in");
 #endif
 }
 
@@ -292,17 +469,17 @@ GrantedTimeWindowMpiInterface::TestSendComplete ()
   NS_LOG_FUNCTION_NOARGS ();
 
 #ifdef NS3_MPI
-  std::list<SentBuffer>::iterator i = m_pendingTx.begin ();
-  while (i != m_pendingTx.end ())
+  for (std::vector<SentBuffer>::iterator i = m_txPool.begin (); i != m_txPool.end (); ++i)
     {
-      MPI_Status status;
-      int flag = 0;
-      MPI_Test (i->GetRequest (), &flag, &status);
-      std::list<SentBuffer>::iterator current = i; // Save current for erasing
-      i++;                                    // Advance to next
-      if (flag)
-        { // This message is complete
-          m_pendingTx.erase (current);
+      // Buffers in use with a null request are being filled
+      if (i->IsInUse () && *i->GetRequest () != MPI_REQUEST_NULL)
+        {
+          int flag = 0;
+          MPI_Test (i->GetRequest (), &flag, MPI_STATUS_IGNORE);
+          if (flag)
+            { // This message is complete
+              i->SetInUse (false);
+            }
         }
     }
 #else
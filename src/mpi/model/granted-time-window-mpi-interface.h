@@ -24,7 +24,7 @@
 #define NS3_GRANTED_TIME_WINDOW_MPI_INTERFACE_H
 
 #include <stdint.h>
-#include <list>
+#include <vector>
 
 #include "ns3/nstime.h"
 #include "ns3/buffer.h"
@@ -45,36 +45,48 @@ namespace ns3 {
  */
 const uint32_t MAX_MPI_MSG_SIZE = 2000;
 
+/**
+ * maximum size of the MPI messages coalescing the packets sent to
+ * the same system (larger packets are sent in a message of their own)
+ */
+const uint32_t MAX_MPI_BATCH_SIZE = 65536;
+
 /**
  * \ingroup mpi
  *
  * \brief Tracks non-blocking sends
  *
  * This class is used to keep track of the asynchronous non-blocking
- * sends that have been posted.
+ * sends that have been posted. Buffers are pooled: once its send has
+ * completed, a buffer is reused (along with its storage) to send a
+ * later message.
  */
 class SentBuffer
 {
 public:
   SentBuffer ();
-  ~SentBuffer ();
 
   /**
-   * \return pointer to sent buffer
+   * \return the sent buffer
    */
-  uint8_t* GetBuffer ();
-  /**
-   * \param buffer pointer to sent buffer
-   */
-  void SetBuffer (uint8_t* buffer);
+  std::vector<uint8_t>& GetBuffer ();
   /**
    * \return MPI request
    */
   MPI_Request* GetRequest ();
+  /**
+   * \return true if the buffer is being filled or sent
+   */
+  bool IsInUse (void) const;
+  /**
+   * \param inUse whether the buffer is being filled or sent
+   */
+  void SetInUse (bool inUse);
 
 private:
-  uint8_t* m_buffer;
+  std::vector<uint8_t> m_buffer;
   MPI_Request m_request;
+  bool m_inUse;
 };
 
 class Packet;
@@ -131,6 +143,11 @@ public:
    * Serialize and send a packet to the specified node and net device
    */
   virtual void SendPacket (Ptr<Packet> p, const Time &rxTime, uint32_t node, uint32_t dev);
+  /**
+   * Send the messages coalescing the packets sent since the last call.
+   * Must be called before synchronizing with the other systems.
+   */
+  static void FlushSendBuffers ();
   /**
    * Check for received messages complete
    */
@@ -149,6 +166,27 @@ public:
   static uint32_t GetTxCount ();
 
 private:
+  /**
+   * \param buffer the received message
+   * \param count the size of the received message
+   *
+   * Deserialize the packets of a received message and schedule their
+   * reception
+   */
+  static void HandleMessage (char* buffer, int count);
+  /**
+   * \return the index of a buffer of the pool available to send a message
+   */
+  static uint32_t AcquireSendBuffer ();
+  /**
+   * \param index the index of the buffer of the pool to send
+   * \param rank the destination system
+   * \param tag the MPI tag of the message
+   *
+   * Post the non-blocking send of a buffer of the pool
+   */
+  static void PostSend (uint32_t index, uint32_t rank, int tag);
+
   static uint32_t m_sid;
   static uint32_t m_size;
 
@@ -160,14 +198,28 @@ private:
   static bool     m_initialized;
   static bool     m_enabled;
 
-  // Pending non-blocking receives
+  // Persistent non-blocking receives
   static MPI_Request* m_requests;
 
   // Data buffers for non-blocking reads
   static char**   m_pRxBuffers;
 
-  // List of pending non-blocking sends
-  static std::list<SentBuffer> m_pendingTx;
+  // Total messages sent
+  static uint32_t m_txMessageCount;
+
+  // Whether the packets sent to a system are coalesced until the next
+  // synchronization
+  static bool m_batching;
+
+  // Pool of buffers for non-blocking sends, reused in a round robin fashion
+  static std::vector<SentBuffer> m_txPool;
+
+  // Next buffer of the pool to reuse
+  static uint32_t m_txPoolNext;
+
+  // Index in the pool of the buffer coalescing the packets sent to each
+  // system (-1 if none)
+  static std::vector<int32_t> m_txBatches;
 };
 
 } // namespace ns3
@@ -23,9 +23,9 @@
 #include <stdint.h>
 #include <vector>
 #include <ostream>
+#include <atomic>
 #include "ns3/assert.h"
-
-#define BUFFER_FREE_LIST 1
+#include "ns3/atomic-ref-count.h"
 
 namespace ns3 {
 
@@ -55,7 +55,9 @@ namespace ns3 {
  * there exist only one instance of Buffer which references the 
  * BufferData instance so, it is safe to modify it. It is also
  * safe to modify the content of a BufferData if the modification
- * falls outside of the "dirty area" defined by the BufferData.
+ * falls outside of the "dirty area" defined by the BufferData,
+ * unless AtomicRefCount is enabled, in which case the Buffer
+ * instances may be owned by different threads.
  * In every other case, the BufferData must be copied before
  * being modified.
  *
@@ -662,8 +664,9 @@ private:
     /**
      * The reference count of an instance of this data structure.
      * Each buffer which references an instance holds a count.
+     * It is only updated by means of AtomicRefCount.
      */
-    uint32_t m_count;
+    std::atomic<uint32_t> m_count;
     /**
      * the size of the m_data field below.
      */
@@ -748,6 +751,10 @@ private:
    * \param data the buffer data storage
    */
   static void Deallocate (struct Buffer::Data *data);
+  /**
+   * \brief Update g_recommendedStart with m_maxZeroAreaStart
+   */
+  void UpdateRecommendedStart (void) const;
 
   struct Data *m_data; //!< the buffer data storage
 
@@ -767,7 +774,7 @@ private:
    * writing data. i.e., m_start should be initialized to this 
    * value.
    */
-  static uint32_t g_recommendedStart;
+  static std::atomic<uint32_t> g_recommendedStart;
 
   /**
    * offset to the start of the virtual zero area from the start
@@ -789,19 +796,6 @@ private:
    * instance from the start of m_data->m_data
    */
   uint32_t m_end;
-
-#ifdef BUFFER_FREE_LIST
-  /// Container for buffer data
-  typedef std::vector<struct Buffer::Data*> FreeList;
-  /// Local static destructor structure
-  struct LocalStaticDestructor 
-  {
-    ~LocalStaticDestructor ();
-  };
-  static uint32_t g_maxSize; //!< Max observed data size
-  static FreeList *g_freeList; //!< Buffer data container
-  static struct LocalStaticDestructor g_localStaticDestructor; //!< Local static destructor
-#endif
 };
 
 } // namespace ns3
@@ -1055,7 +1049,7 @@ Buffer::Buffer (Buffer const&o)
     m_start (o.m_start),
     m_end (o.m_end)
 {
-  m_data->m_count++;
+  AtomicRefCount::Increment (m_data->m_count);
   NS_ASSERT (CheckInternalState ());
 }
 
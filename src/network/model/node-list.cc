@@ -26,6 +26,7 @@
 #include "ns3/assert.h"
 #include "node-list.h"
 #include "node.h"
+#include "packet-arena.h"
 
 namespace ns3 {
 
@@ -145,6 +146,9 @@ NodeListPriv::Delete (void)
   NS_LOG_FUNCTION_NOARGS ();
   Config::UnregisterRootNamespaceObject (Get ());
   (*DoGet ()) = 0;
+  // the nodes, and the packets they held, are gone: return the free slabs
+  // of the packet arena to the system
+  PacketArena::Release ();
 }
 
 
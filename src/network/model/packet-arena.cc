@@ -0,0 +1,531 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "packet-arena.h"
+#include "ns3/assert.h"
+#include <atomic>
+#include <mutex>
+#include <new>
+#include <vector>
+#include <algorithm>
+
+namespace ns3 {
+
+namespace {
+
+/// Header preceding each block
+struct BlockHeader
+{
+  BlockHeader *next;   //!< next block in the free list
+  uint32_t cls;        //!< the size class of the block
+  uint32_t capacity;   //!< the number of bytes following the header
+};
+
+/// The size of the header, which keeps the blocks 16-byte aligned
+const uint32_t HEADER_SIZE = 16;
+/// The capacity of the smallest size class
+const uint32_t MIN_CLASS_SIZE = 64;
+/// The number of size classes (64 bytes to 64 KiB)
+const uint32_t N_CLASSES = 11;
+/// The size class of the blocks allocated from the heap
+const uint32_t LARGE_CLASS = N_CLASSES;
+/// The minimum size of a slab
+const uint32_t MIN_SLAB_SIZE = 65536;
+/// The number of free blocks of a size class above which a thread hands blocks over
+const uint32_t MAX_LOCAL_FREE = 1024;
+/// The number of blocks moved at once between a thread and the depot
+const uint32_t TRANSFER_SIZE = 64;
+
+/// Statistics of a thread, only written by the owner thread
+struct ThreadStats
+{
+  std::atomic<uint64_t> allocatedBytes;   //!< number of bytes allocated
+  std::atomic<uint64_t> allocatedBlocks;  //!< number of blocks allocated
+  std::atomic<uint64_t> releasedBytes;    //!< number of bytes released
+  std::atomic<uint64_t> releasedBlocks;   //!< number of blocks released
+  std::atomic<uint64_t> copies;           //!< number of packet copies
+};
+
+/// A slab carved into blocks of the same size class
+struct Slab
+{
+  uint8_t *start;      //!< the first byte of the slab
+  uint32_t blockSize;  //!< the size of the blocks, header included
+  uint32_t nBlocks;    //!< the number of blocks
+  uint32_t nFree;      //!< the number of free blocks, only valid in Release
+};
+
+/**
+ * \param slab a slab
+ * \param block a block
+ * \return true if the slab starts after the block
+ */
+bool
+operator< (const BlockHeader *block, const Slab &slab)
+{
+  return reinterpret_cast<const uint8_t *> (block) < slab.start;
+}
+
+/// A free list
+struct FreeList
+{
+  BlockHeader *head;  //!< the first free block
+  uint32_t count;     //!< the number of free blocks
+};
+
+/// The blocks and statistics of a thread
+struct ThreadCache
+{
+  FreeList free[N_CLASSES];  //!< the free blocks, per size class
+  ThreadStats stats;         //!< the statistics of the thread
+};
+
+/// The blocks and statistics shared by the threads
+struct Depot
+{
+  std::mutex mutex;                    //!< the mutex protecting the depot
+  FreeList free[N_CLASSES];            //!< the free blocks, per size class
+  std::vector<ThreadCache *> caches;   //!< the caches of the running threads
+  std::vector<Slab> slabs;             //!< the slabs, sorted by address
+  uint64_t allocatedBytes;             //!< number of bytes allocated by the exited threads
+  uint64_t allocatedBlocks;            //!< number of blocks allocated by the exited threads
+  uint64_t releasedBytes;              //!< number of bytes released by the exited threads
+  uint64_t releasedBlocks;             //!< number of blocks released by the exited threads
+  uint64_t copies;                     //!< number of copies made by the exited threads
+};
+
+/**
+ * The depot is never destroyed, so that packets can be released at any
+ * time, including by the static destructors.
+ *
+ * \return the depot
+ */
+Depot *
+GetDepot (void)
+{
+  static Depot *depot = new Depot ();
+  return depot;
+}
+
+/// Marker of a thread whose cache has been destroyed
+ThreadCache * const DESTROYED = reinterpret_cast<ThreadCache *> (1);
+
+/// The cache of the current thread
+thread_local ThreadCache *t_cache = 0;
+
+/**
+ * \param stats the statistics of a thread
+ * \param bytes the number of bytes allocated
+ */
+void
+AddAllocated (ThreadStats &stats, uint32_t bytes)
+{
+  stats.allocatedBytes.store (stats.allocatedBytes.load (std::memory_order_relaxed) + bytes,
+                              std::memory_order_relaxed);
+  stats.allocatedBlocks.store (stats.allocatedBlocks.load (std::memory_order_relaxed) + 1,
+                               std::memory_order_relaxed);
+}
+
+/**
+ * \param stats the statistics of a thread
+ * \param bytes the number of bytes released
+ */
+void
+AddReleased (ThreadStats &stats, uint32_t bytes)
+{
+  stats.releasedBytes.store (stats.releasedBytes.load (std::memory_order_relaxed) + bytes,
+                             std::memory_order_relaxed);
+  stats.releasedBlocks.store (stats.releasedBlocks.load (std::memory_order_relaxed) + 1,
+                              std::memory_order_relaxed);
+}
+
+/**
+ * Move up to the given number of blocks from a free list to another one.
+ *
+ * \param from the source free list
+ * \param to the destination free list
+ * \param n the number of blocks
+ */
+void
+Transfer (FreeList &from, FreeList &to, uint32_t n)
+{
+  while (n > 0 && from.head != 0)
+    {
+      BlockHeader *block = from.head;
+      from.head = block->next;
+      from.count--;
+      block->next = to.head;
+      to.head = block;
+      to.count++;
+      n--;
+    }
+}
+
+/**
+ * Carve a new slab into blocks of the given size class. Must be called
+ * with the depot mutex held.
+ *
+ * \param depot the depot
+ * \param cls the size class
+ * \param list the free list the blocks are added to
+ */
+void
+CarveSlab (Depot *depot, uint32_t cls, FreeList &list)
+{
+  uint32_t blockSize = HEADER_SIZE + (MIN_CLASS_SIZE << cls);
+  uint32_t nBlocks = std::max<uint32_t> (4, MIN_SLAB_SIZE / blockSize);
+  uint8_t *slab = static_cast<uint8_t *> (::operator new (static_cast<size_t> (nBlocks) * blockSize));
+  Slab info;
+  info.start = slab;
+  info.blockSize = blockSize;
+  info.nBlocks = nBlocks;
+  info.nFree = 0;
+  depot->slabs.insert (std::upper_bound (depot->slabs.begin (), depot->slabs.end (),
+                                         reinterpret_cast<BlockHeader *> (slab)),
+                       info);
+  for (uint32_t i = 0; i < nBlocks; i++)
+    {
+      BlockHeader *block = reinterpret_cast<BlockHeader *> (slab + i * blockSize);
+      block->cls = cls;
+      block->capacity = MIN_CLASS_SIZE << cls;
+      block->next = list.head;
+      list.head = block;
+      list.count++;
+    }
+}
+
+/**
+ * Hands the blocks and the statistics of a thread over to the depot when
+ * the thread exits.
+ */
+struct CacheGuard
+{
+  ThreadCache *cache;  //!< the cache of the thread
+
+  ~CacheGuard ()
+  {
+    if (cache == 0)
+      {
+        return;
+      }
+    Depot *depot = GetDepot ();
+    std::lock_guard<std::mutex> lock (depot->mutex);
+    for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+      {
+        Transfer (cache->free[cls], depot->free[cls], cache->free[cls].count);
+      }
+    depot->allocatedBytes += cache->stats.allocatedBytes.load (std::memory_order_relaxed);
+    depot->allocatedBlocks += cache->stats.allocatedBlocks.load (std::memory_order_relaxed);
+    depot->releasedBytes += cache->stats.releasedBytes.load (std::memory_order_relaxed);
+    depot->releasedBlocks += cache->stats.releasedBlocks.load (std::memory_order_relaxed);
+    depot->copies += cache->stats.copies.load (std::memory_order_relaxed);
+    depot->caches.erase (std::find (depot->caches.begin (), depot->caches.end (), cache));
+    delete cache;
+    t_cache = DESTROYED;
+  }
+};
+
+/// The guard of the cache of the current thread
+thread_local CacheGuard t_guard;
+
+/**
+ * \return the cache of the current thread, or DESTROYED if the thread is exiting
+ */
+ThreadCache *
+GetCache (void)
+{
+  ThreadCache *cache = t_cache;
+  if (cache == 0)
+    {
+      cache = new ThreadCache ();
+      for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+        {
+          cache->free[cls].head = 0;
+          cache->free[cls].count = 0;
+        }
+      cache->stats.allocatedBytes.store (0);
+      cache->stats.allocatedBlocks.store (0);
+      cache->stats.releasedBytes.store (0);
+      cache->stats.releasedBlocks.store (0);
+      cache->stats.copies.store (0);
+      Depot *depot = GetDepot ();
+      {
+        std::lock_guard<std::mutex> lock (depot->mutex);
+        depot->caches.push_back (cache);
+      }
+      t_guard.cache = cache;
+      t_cache = cache;
+    }
+  return cache;
+}
+
+/**
+ * \param size the requested size
+ * \return the size class serving the requested size, or LARGE_CLASS
+ */
+uint32_t
+GetClass (uint32_t size)
+{
+  uint32_t cls = 0;
+  while (cls < N_CLASSES && (MIN_CLASS_SIZE << cls) < size)
+    {
+      cls++;
+    }
+  return cls;
+}
+
+} // anonymous namespace
+
+void *
+PacketArena::Allocate (uint32_t size, bool pooled)
+{
+  uint32_t cls = (pooled ? GetClass (size) : LARGE_CLASS);
+  ThreadCache *cache = GetCache ();
+  BlockHeader *block;
+  if (cls == LARGE_CLASS)
+    {
+      block = static_cast<BlockHeader *> (::operator new (HEADER_SIZE + static_cast<size_t> (size)));
+      block->cls = LARGE_CLASS;
+      block->capacity = size;
+    }
+  else if (cache != DESTROYED)
+    {
+      FreeList &list = cache->free[cls];
+      if (list.head == 0)
+        {
+          Depot *depot = GetDepot ();
+          std::lock_guard<std::mutex> lock (depot->mutex);
+          Transfer (depot->free[cls], list, TRANSFER_SIZE);
+          if (list.head == 0)
+            {
+              CarveSlab (depot, cls, list);
+            }
+        }
+      block = list.head;
+      list.head = block->next;
+      list.count--;
+    }
+  else
+    {
+      Depot *depot = GetDepot ();
+      std::lock_guard<std::mutex> lock (depot->mutex);
+      FreeList &list = depot->free[cls];
+      if (list.head == 0)
+        {
+          CarveSlab (depot, cls, list);
+        }
+      block = list.head;
+      list.head = block->next;
+      list.count--;
+    }
+  block->next = 0;
+
+  if (cache != DESTROYED)
+    {
+      AddAllocated (cache->stats, block->capacity);
+    }
+  else
+    {
+      Depot *depot = GetDepot ();
+      std::lock_guard<std::mutex> lock (depot->mutex);
+      depot->allocatedBytes += block->capacity;
+      depot->allocatedBlocks++;
+    }
+  return reinterpret_cast<uint8_t *> (block) + HEADER_SIZE;
+}
+
+void
+PacketArena::Deallocate (void *ptr)
+{
+  if (ptr == 0)
+    {
+      return;
+    }
+  BlockHeader *block = reinterpret_cast<BlockHeader *> (static_cast<uint8_t *> (ptr) - HEADER_SIZE);
+  NS_ASSERT (block->next == 0);
+  uint32_t cls = block->cls;
+  uint32_t capacity = block->capacity;
+  ThreadCache *cache = GetCache ();
+  if (cache != DESTROYED)
+    {
+      AddReleased (cache->stats, capacity);
+      if (cls == LARGE_CLASS)
+        {
+          ::operator delete (block);
+          return;
+        }
+      FreeList &list = cache->free[cls];
+      block->next = list.head;
+      list.head = block;
+      list.count++;
+      if (list.count > MAX_LOCAL_FREE)
+        {
+          Depot *depot = GetDepot ();
+          std::lock_guard<std::mutex> lock (depot->mutex);
+          Transfer (list, depot->free[cls], MAX_LOCAL_FREE / 2);
+        }
+      return;
+    }
+
+  Depot *depot = GetDepot ();
+  std::lock_guard<std::mutex> lock (depot->mutex);
+  depot->releasedBytes += capacity;
+  depot->releasedBlocks++;
+  if (cls == LARGE_CLASS)
+    {
+      ::operator delete (block);
+      return;
+    }
+  FreeList &list = depot->free[cls];
+  block->next = list.head;
+  list.head = block;
+  list.count++;
+}
+
+uint32_t
+PacketArena::GetCapacity (const void *ptr)
+{
+  const BlockHeader *block = reinterpret_cast<const BlockHeader *> (static_cast<const uint8_t *> (ptr) - HEADER_SIZE);
+  return block->capacity;
+}
+
+void
+PacketArena::NotifyCopy (void)
+{
+  ThreadCache *cache = GetCache ();
+  if (cache != DESTROYED)
+    {
+      cache->stats.copies.store (cache->stats.copies.load (std::memory_order_relaxed) + 1,
+                                 std::memory_order_relaxed);
+      return;
+    }
+  Depot *depot = GetDepot ();
+  std::lock_guard<std::mutex> lock (depot->mutex);
+  depot->copies++;
+}
+
+PacketArena::Stats
+PacketArena::GetStats (void)
+{
+  Depot *depot = GetDepot ();
+  std::lock_guard<std::mutex> lock (depot->mutex);
+  Stats stats;
+  stats.allocatedBytes = depot->allocatedBytes;
+  stats.allocatedBlocks = depot->allocatedBlocks;
+  stats.releasedBytes = depot->releasedBytes;
+  stats.releasedBlocks = depot->releasedBlocks;
+  stats.copies = depot->copies;
+  stats.slabBytes = 0;
+  for (std::vector<Slab>::const_iterator it = depot->slabs.begin (); it != depot->slabs.end (); ++it)
+    {
+      stats.slabBytes += static_cast<uint64_t> (it->blockSize) * it->nBlocks;
+    }
+  for (std::vector<ThreadCache *>::const_iterator it = depot->caches.begin (); it != depot->caches.end (); ++it)
+    {
+      const ThreadStats &s = (*it)->stats;
+      stats.allocatedBytes += s.allocatedBytes.load (std::memory_order_relaxed);
+      stats.allocatedBlocks += s.allocatedBlocks.load (std::memory_order_relaxed);
+      stats.releasedBytes += s.releasedBytes.load (std::memory_order_relaxed);
+      stats.releasedBlocks += s.releasedBlocks.load (std::memory_order_relaxed);
+      stats.copies += s.copies.load (std::memory_order_relaxed);
+    }
+  return stats;
+}
+
+void
+PacketArena::Release (void)
+{
+  // do not create a cache, since this may be called while the program exits
+  ThreadCache *cache = t_cache;
+  Depot *depot = GetDepot ();
+  std::lock_guard<std::mutex> lock (depot->mutex);
+  if (cache != 0 && cache != DESTROYED)
+    {
+      for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+        {
+          Transfer (cache->free[cls], depot->free[cls], cache->free[cls].count);
+        }
+    }
+
+  // count the free blocks of every slab
+  for (std::vector<Slab>::iterator it = depot->slabs.begin (); it != depot->slabs.end (); ++it)
+    {
+      it->nFree = 0;
+    }
+  for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+    {
+      for (BlockHeader *block = depot->free[cls].head; block != 0; block = block->next)
+        {
+          std::vector<Slab>::iterator it = std::upper_bound (depot->slabs.begin (), depot->slabs.end (), block);
+          NS_ASSERT (it != depot->slabs.begin ());
+          (--it)->nFree++;
+        }
+    }
+
+  // remove the blocks of the slabs to release from the free lists
+  for (uint32_t cls = 0; cls < N_CLASSES; cls++)
+    {
+      FreeList kept;
+      kept.head = 0;
+      kept.count = 0;
+      BlockHeader *block = depot->free[cls].head;
+      while (block != 0)
+        {
+          BlockHeader *next = block->next;
+          std::vector<Slab>::iterator it = std::upper_bound (depot->slabs.begin (), depot->slabs.end (), block);
+          --it;
+          if (it->nFree < it->nBlocks)
+            {
+              block->next = kept.head;
+              kept.head = block;
+              kept.count++;
+            }
+          block = next;
+        }
+      depot->free[cls] = kept;
+    }
+
+  std::vector<Slab> slabs;
+  for (std::vector<Slab>::iterator it = depot->slabs.begin (); it != depot->slabs.end (); ++it)
+    {
+      if (it->nFree == it->nBlocks)
+        {
+          ::operator delete (it->start);
+        }
+      else
+        {
+          slabs.push_back (*it);
+        }
+    }
+  depot->slabs.swap (slabs);
+}
+
+namespace {
+
+/**
+ * Returns the free slabs to the system when the program exits.
+ */
+struct ReleaseGuard
+{
+  ~ReleaseGuard ()
+  {
+    PacketArena::Release ();
+  }
+} g_releaseGuard; //!< the guard releasing the free slabs at exit
+
+} // anonymous namespace
+
+} // namespace ns3
@@ -24,6 +24,7 @@
 #include "ns3/log.h"
 #include "packet-metadata.h"
 #include "buffer.h"
+#include "packet-arena.h"
 #include "header.h"
 #include "trailer.h"
 
@@ -34,19 +35,8 @@ NS_LOG_COMPONENT_DEFINE ("PacketMetadata");
 bool PacketMetadata::m_enable = false;
 bool PacketMetadata::m_enableChecking = false;
 bool PacketMetadata::m_metadataSkipped = false;
-uint32_t PacketMetadata::m_maxSize = 0;
+std::atomic<uint32_t> PacketMetadata::m_maxSize (0);
 uint16_t PacketMetadata::m_chunkUid = 0;
-PacketMetadata::DataFreeList PacketMetadata::m_freeList;
-
-PacketMetadata::DataFreeList::~DataFreeList ()
-{
-  NS_LOG_FUNCTION (this);
-  for (iterator i = begin (); i != end (); i++)
-    {
-      PacketMetadata::Deallocate (*i);
-    }
-  PacketMetadata::m_enable = false;
-}
 
 void 
 PacketMetadata::Enable (void)
@@ -77,8 +67,7 @@ PacketMetadata::ReserveCopy (uint32_t size)
   struct PacketMetadata::Data *newData = PacketMetadata::Create (m_used + size);
   memcpy (newData->m_data, m_data->m_data, m_used);
   newData->m_dirtyEnd = m_used;
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  if (AtomicRefCount::Decrement (m_data->m_count))
     {
       PacketMetadata::Recycle (m_data);
     }
@@ -100,10 +89,13 @@ PacketMetadata::Reserve (uint32_t size)
 {
   NS_LOG_FUNCTION (this << size);
   NS_ASSERT (m_data != 0);
+  // the other copies referencing the data may be owned by other threads
+  // while AtomicRefCount is enabled
   if (m_data->m_size >= m_used + size &&
-      (m_head == 0xffff ||
-       m_data->m_count == 1 ||
-       m_data->m_dirtyEnd == m_used))
+      (AtomicRefCount::Get (m_data->m_count) == 1 ||
+       (!AtomicRefCount::IsEnabled () &&
+        (m_head == 0xffff ||
+         m_data->m_dirtyEnd == m_used))))
     {
       /* enough room, not dirty. */
     }
@@ -380,9 +372,10 @@ PacketMetadata::AddSmall (const struct PacketMetadata::SmallItem *item)
   uint32_t sizeSize = GetUleb128Size (item->size);
   uint32_t n =  2 + 2 + typeUidSize + sizeSize + 2;
   if (m_used + n > m_data->m_size ||
-      (m_head != 0xffff &&
-       m_data->m_count != 1 &&
-       m_used != m_data->m_dirtyEnd))
+      (AtomicRefCount::Get (m_data->m_count) != 1 &&
+       (AtomicRefCount::IsEnabled () ||
+        (m_head != 0xffff &&
+         m_used != m_data->m_dirtyEnd))))
     {
       ReserveCopy (n);
     }
@@ -418,9 +411,10 @@ PacketMetadata::AddBig (uint32_t next, uint32_t prev,
   uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
   if (m_used + n > m_data->m_size ||
-      (m_head != 0xffff &&
-       m_data->m_count != 1 &&
-       m_used != m_data->m_dirtyEnd))
+      (AtomicRefCount::Get (m_data->m_count) != 1 &&
+       (AtomicRefCount::IsEnabled () ||
+        (m_head != 0xffff &&
+         m_used != m_data->m_dirtyEnd))))
     {
       ReserveCopy (n);
     }
@@ -476,7 +470,7 @@ PacketMetadata::ReplaceTail (PacketMetadata::SmallItem *item,
   uint32_t n = 2 + 2 + typeUidSize + sizeSize + 2 + fragStartSize + fragEndSize + 4;
 
   if (available >= n &&
-      m_data->m_count == 1)
+      AtomicRefCount::Get (m_data->m_count) == 1)
     {
       uint8_t *buffer = &m_data->m_data[m_tail];
       Append16 (item->next, buffer);
@@ -570,48 +564,26 @@ struct PacketMetadata::Data *
 PacketMetadata::Create (uint32_t size)
 {
   NS_LOG_FUNCTION (size);
-  NS_LOG_LOGIC ("create size="<<size<<", max="<<m_maxSize);
-  if (size > m_maxSize)
-    {
-      m_maxSize = size;
-    }
-  while (!m_freeList.empty ()) 
+  uint32_t maxSize = m_maxSize.load (std::memory_order_relaxed);
+  NS_LOG_LOGIC ("create size="<<size<<", max="<<maxSize);
+  if (size > maxSize)
     {
-      struct PacketMetadata::Data *data = m_freeList.back ();
-      m_freeList.pop_back ();
-      if (data->m_size >= size) 
-        {
-          NS_LOG_LOGIC ("create found size="<<data->m_size);
-          data->m_count = 1;
-          return data;
-        }
-      NS_LOG_LOGIC ("create dealloc size="<<data->m_size);
-      PacketMetadata::Deallocate (data);
+      maxSize = size;
+      m_maxSize.store (maxSize, std::memory_order_relaxed);
     }
-  NS_LOG_LOGIC ("create alloc size="<<m_maxSize);
-  return PacketMetadata::Allocate (m_maxSize);
+  NS_LOG_LOGIC ("create alloc size="<<maxSize);
+  return PacketMetadata::Allocate (maxSize);
 }
 
 void
 PacketMetadata::Recycle (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  if (!m_enable)
-    {
-      PacketMetadata::Deallocate (data);
-      return;
-    } 
-  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", list="<<m_freeList.size ());
-  NS_ASSERT (data->m_count == 0);
-  if (m_freeList.size () > 1000 ||
-      data->m_size < m_maxSize) 
-    {
-      PacketMetadata::Deallocate (data);
-    } 
-  else 
-    {
-      m_freeList.push_back (data);
-    }
+  NS_ASSERT (AtomicRefCount::Get (data->m_count) == 0);
+  // the data returns to the arena if allocated while the metadata is
+  // enabled, and to the heap otherwise (see PacketMetadata::Allocate)
+  NS_LOG_LOGIC ("recycle size="<<data->m_size<<", pooled="<<m_enable);
+  PacketMetadata::Deallocate (data);
 }
 
 struct PacketMetadata::Data *
@@ -624,10 +596,14 @@ PacketMetadata::Allocate (uint32_t n)
       n = PACKET_METADATA_DATA_M_DATA_SIZE;
     }
   size += n - PACKET_METADATA_DATA_M_DATA_SIZE;
-  uint8_t *buf = new uint8_t [size];
+  // the metadata of the packets is only pooled if enabled; otherwise, the
+  // (small) data of each packet is taken from and returned to the heap
+  uint8_t *buf = static_cast<uint8_t *> (PacketArena::Allocate (size, m_enable));
   struct PacketMetadata::Data *data = (struct PacketMetadata::Data *)buf;
-  data->m_size = n;
-  data->m_count = 1;
+  // make use of the whole block of the arena, within the range of the 16 bit offsets
+  uint32_t available = PacketArena::GetCapacity (buf) - sizeof (struct Data) + PACKET_METADATA_DATA_M_DATA_SIZE;
+  data->m_size = std::min<uint32_t> (available, 0xfffe);
+  AtomicRefCount::Set (data->m_count, 1);
   data->m_dirtyEnd = 0;
   return data;
 }
@@ -635,11 +611,9 @@ void
 PacketMetadata::Deallocate (struct PacketMetadata::Data *data)
 {
   NS_LOG_FUNCTION (data);
-  uint8_t *buf = (uint8_t *)data;
-  delete [] buf;
+  PacketArena::Deallocate (data);
 }
 
-
 PacketMetadata 
 PacketMetadata::CreateFragment (uint32_t start, uint32_t end) const
 {
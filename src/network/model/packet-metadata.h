@@ -23,8 +23,10 @@
 #include <stdint.h>
 #include <vector>
 #include <limits>
+#include <atomic>
 #include "ns3/callback.h"
 #include "ns3/assert.h"
+#include "ns3/atomic-ref-count.h"
 #include "ns3/type-id.h"
 #include "buffer.h"
 
@@ -412,8 +414,8 @@ private:
    * Data structure
    */
   struct Data {
-    /** number of references to this struct Data instance. */
-    uint32_t m_count;
+    /** number of references to this struct Data instance, only updated by means of AtomicRefCount. */
+    std::atomic<uint32_t> m_count;
     /** size (in bytes) of m_data buffer below */
     uint16_t m_size;
     /** max of the m_used field over all objects which
@@ -494,16 +496,6 @@ private:
     uint64_t packetUid;
   };
 
-  /**
-   * \brief Class to hold all the metadata
-   */
-  class DataFreeList : public std::vector<struct Data *>
-  {
-public:
-    ~DataFreeList ();
-  };
-
-  friend DataFreeList::~DataFreeList ();
   /// Friend class
   friend class ItemIterator;
 
@@ -661,7 +653,6 @@ public:
    */
   static void Deallocate (struct PacketMetadata::Data *data);
 
-  static DataFreeList m_freeList; //!< the metadata data storage
   static bool m_enable; //!< Enable the packet metadata
   static bool m_enableChecking; //!< Enable the packet metadata checking
 
@@ -672,7 +663,7 @@ public:
    */
   static bool m_metadataSkipped;
 
-  static uint32_t m_maxSize; //!< maximum metadata size
+  static std::atomic<uint32_t> m_maxSize; //!< maximum metadata size
   static uint16_t m_chunkUid; //!< Chunk Uid
 
   struct Data *m_data; //!< Metadata storage
@@ -712,8 +703,8 @@ PacketMetadata::PacketMetadata (PacketMetadata const &o)
     m_packetUid (o.m_packetUid)
 {
   NS_ASSERT (m_data != 0);
-  NS_ASSERT (m_data->m_count < std::numeric_limits<uint32_t>::max());
-  m_data->m_count++;
+  NS_ASSERT (AtomicRefCount::Get (m_data->m_count) < std::numeric_limits<uint32_t>::max());
+  AtomicRefCount::Increment (m_data->m_count);
 }
 PacketMetadata &
 PacketMetadata::operator = (PacketMetadata const& o)
@@ -722,14 +713,13 @@ PacketMetadata::operator = (PacketMetadata const& o)
     {
       // not self assignment
       NS_ASSERT (m_data != 0);
-      m_data->m_count--;
-      if (m_data->m_count == 0) 
+      if (AtomicRefCount::Decrement (m_data->m_count))
         {
           PacketMetadata::Recycle (m_data);
         }
       m_data = o.m_data;
       NS_ASSERT (m_data != 0);
-      m_data->m_count++;
+      AtomicRefCount::Increment (m_data->m_count);
     }
   m_head = o.m_head;
   m_tail = o.m_tail;
@@ -740,8 +730,7 @@ PacketMetadata::operator = (PacketMetadata const& o)
 PacketMetadata::~PacketMetadata ()
 {
   NS_ASSERT (m_data != 0);
-  m_data->m_count--;
-  if (m_data->m_count == 0) 
+  if (AtomicRefCount::Decrement (m_data->m_count))
     {
       PacketMetadata::Recycle (m_data);
     }
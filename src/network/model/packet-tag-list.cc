@@ -34,6 +34,9 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("PacketTagList");
 
+const uint8_t PacketTagList::INLINE_TAGS;
+const uint8_t PacketTagList::INLINE_TAG_SIZE;
+
 PacketTagList::TagData *
 PacketTagList::CreateTagData (size_t dataSize)
 {
@@ -43,7 +46,7 @@ PacketTagList::CreateTagData (size_t dataSize)
                  << " exceeds maximum "
                  << std::numeric_limits<decltype(TagData::size)>::max () );
 
-  void * p = std::malloc (sizeof (TagData) + dataSize - 1);
+  void * p = PacketArena::Allocate (sizeof (TagData) + dataSize - 1);
   // The matching frees are in RemoveAll and RemoveWriter
 
   TagData * tag = new (p) TagData;
@@ -73,7 +76,7 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
   // Search from the head of the list until we find tid or a merge
   while (cur != 0)
     {
-      if (cur->count > 1)
+      if (AtomicRefCount::Get (cur->count) > 1)
         {
           // found merge
           NS_LOG_INFO ("found initial merge before tid");
@@ -118,9 +121,11 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
       return found;
     }
 
-  // At this point cur is a merge, but untested for tid
+  // At this point cur is a merge, but untested for tid. The nodes after
+  // the first merge may be released concurrently by other lists, hence
+  // each node is copied before its incoming link is released.
   NS_ASSERT (cur != 0);
-  NS_ASSERT (cur->count > 1);
+  NS_ASSERT (AtomicRefCount::IsEnabled () || AtomicRefCount::Get (cur->count) > 1);
 
   /*
      Walk the remainder of the list, copying, until we find tid
@@ -148,15 +153,15 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
   while ( /* cur && */ cur->tid != tid)
     {
       NS_ASSERT (cur != 0);
-      NS_ASSERT (cur->count > 1);
-      cur->count--;                       // unmerge cur
+      NS_ASSERT (AtomicRefCount::IsEnabled () || AtomicRefCount::Get (cur->count) > 1);
       struct TagData * copy = CreateTagData (cur->size);
       copy->tid = cur->tid;
-      copy->count = 1;
+      AtomicRefCount::Set (copy->count, 1);
       copy->size = cur->size;
       memcpy (copy->data, cur->data, copy->size);
       copy->next = cur->next;             // merge into tail
-      copy->next->count++;                // mark new merge
+      AtomicRefCount::Increment (copy->next->count); // mark new merge
+      ReleaseTagData (cur);               // unmerge cur
       *prevNext = copy;                   // point prior list at copy
       prevNext = &copy->next;             // advance
       cur      =  copy->next;
@@ -164,7 +169,7 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
   // Sanity check:
   NS_ASSERT (cur != 0);                 // cur should be non-zero
   NS_ASSERT (cur->tid == tid);          // cur->tid should be tid
-  NS_ASSERT (cur->count > 1);           // cur should be a merge
+  NS_ASSERT (AtomicRefCount::IsEnabled () || AtomicRefCount::Get (cur->count) > 1); // cur should be a merge
 
   // link around tid, removing it from our list
   found = (this->*Writer)(tag, false, cur, prevNext);
@@ -172,9 +177,27 @@ PacketTagList::COWTraverse (Tag & tag, PacketTagList::COWWriter Writer)
 
 }
 
+void
+PacketTagList::RemoveInline (uint8_t i)
+{
+  NS_ASSERT (i < m_nInline);
+  m_nInline--;
+  if (i != m_nInline)
+    {
+      m_inline[i] = m_inline[m_nInline];
+    }
+}
+
 bool
 PacketTagList::Remove (Tag & tag)
 {
+  uint8_t i = FindInline (tag.GetInstanceTypeId ());
+  if (i < m_nInline)
+    {
+      tag.Deserialize (TagBuffer (m_inline[i].data, m_inline[i].data + m_inline[i].size));
+      RemoveInline (i);
+      return true;
+    }
   return COWTraverse (tag, &PacketTagList::RemoveWriter);
 }
 
@@ -195,18 +218,18 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
     {
       // found tid before first merge, so delete cur
       cur->~TagData ();
-      std::free (cur);
+      PacketArena::Deallocate (cur);
     }
   else
     {
       // cur is always a merge at this point
-      // unmerge cur, since we linked around it already
-      cur->count--;
       if (cur->next != 0)
         {
           // there's a next, so make it a merge
-          cur->next->count++;
+          AtomicRefCount::Increment (cur->next->count);
         }
+      // unmerge cur, since we linked around it already
+      ReleaseTagData (cur);
     }
   return found;
 }
@@ -214,6 +237,23 @@ PacketTagList::RemoveWriter (Tag & tag, bool preMerge,
 bool
 PacketTagList::Replace (Tag & tag)
 {
+  uint8_t i = FindInline (tag.GetInstanceTypeId ());
+  if (i < m_nInline)
+    {
+      uint32_t size = tag.GetSerializedSize ();
+      if (size <= INLINE_TAG_SIZE)
+        {
+          m_inline[i].size = static_cast<uint8_t> (size);
+          tag.Serialize (TagBuffer (m_inline[i].data, m_inline[i].data + size));
+        }
+      else
+        {
+          // the new value does not fit anymore
+          RemoveInline (i);
+          Add (tag);
+        }
+      return true;
+    }
   bool found = COWTraverse (tag, &PacketTagList::ReplaceWriter);
   if (!found)
     {
@@ -241,16 +281,16 @@ PacketTagList::ReplaceWriter (Tag & tag, bool preMerge,
     {
       // cur is always a merge at this point
       // need to copy, replace, and link past cur
-      cur->count--;                     // unmerge cur
       struct TagData * copy = CreateTagData (tag.GetSerializedSize ());
       copy->tid = tag.GetInstanceTypeId ();
-      copy->count = 1;
+      AtomicRefCount::Set (copy->count, 1);
       tag.Serialize (TagBuffer (copy->data, copy->data + copy->size));
       copy->next = cur->next;           // merge into tail
       if (copy->next != 0)
         {
-          copy->next->count++;          // mark new merge
+          AtomicRefCount::Increment (copy->next->count); // mark new merge
         }
+      ReleaseTagData (cur);             // unmerge cur
       *prevNext = copy;                 // point prior list at copy
     }
   return found;
@@ -261,13 +301,26 @@ PacketTagList::Add (const Tag &tag) const
 {
   NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
   // ensure this id was not yet added
+  NS_ASSERT_MSG (FindInline (tag.GetInstanceTypeId ()) == INLINE_TAGS,
+                 "Error: cannot add the same kind of tag twice.");
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
     {
       NS_ASSERT_MSG (cur->tid != tag.GetInstanceTypeId (),
                      "Error: cannot add the same kind of tag twice.");
     }
-  struct TagData * head = CreateTagData (tag.GetSerializedSize ());
-  head->count = 1;
+  uint32_t size = tag.GetSerializedSize ();
+  if (m_nInline < INLINE_TAGS && size <= INLINE_TAG_SIZE)
+    {
+      PacketTagList *self = const_cast<PacketTagList *> (this);
+      struct InlineTag &slot = self->m_inline[m_nInline];
+      slot.tid = tag.GetInstanceTypeId ();
+      slot.size = static_cast<uint8_t> (size);
+      tag.Serialize (TagBuffer (slot.data, slot.data + size));
+      self->m_nInline++;
+      return;
+    }
+  struct TagData * head = CreateTagData (size);
+  AtomicRefCount::Set (head->count, 1);
   head->next = 0;
   head->tid = tag.GetInstanceTypeId ();
   head->next = m_next;
@@ -281,6 +334,13 @@ PacketTagList::Peek (Tag &tag) const
 {
   NS_LOG_FUNCTION (this << tag.GetInstanceTypeId ());
   TypeId tid = tag.GetInstanceTypeId ();
+  uint8_t i = FindInline (tid);
+  if (i < m_nInline)
+    {
+      uint8_t *data = const_cast<uint8_t *> (m_inline[i].data);
+      tag.Deserialize (TagBuffer (data, data + m_inline[i].size));
+      return true;
+    }
   for (struct TagData *cur = m_next; cur != 0; cur = cur->next) 
     {
       if (cur->tid == tid) 
@@ -28,6 +28,9 @@
 #include <stdint.h>
 #include <ostream>
 #include "ns3/type-id.h"
+#include "ns3/assert.h"
+#include "ns3/atomic-ref-count.h"
+#include "packet-arena.h"
 
 namespace ns3 {
 
@@ -119,6 +122,19 @@ class Tag;
  *       The portion of the list between the first branch and the target is
  *       shared. This portion is copied before the #Remove or #Replace is
  *       performed.
+ *
+ * \par <b> Inline tags </b>
+ *
+ *   - Up to #INLINE_TAGS tags whose serialized size does not exceed
+ *     #INLINE_TAG_SIZE bytes (e.g., the SnrTag, AmpduTag, WifiPhyTag and
+ *     FlowIdTag added to every Wi-Fi frame) are stored by value in the
+ *     PacketTagList itself, so that adding, peeking and removing them
+ *     does not allocate nor walk the tree. They are looked up by TypeId
+ *     before the tree. Larger tags, and the tags added once the inline
+ *     slots are full, are stored in the tree as described above.
+ *
+ *   - The inline tags are copied along with the PacketTagList, hence
+ *     #Remove and #Replace handle them in place.
  */
 class PacketTagList 
 {
@@ -141,12 +157,30 @@ public:
   struct TagData
   {
     struct TagData * next;      /**< Pointer to next in list */
-    uint32_t count;             /**< Number of incoming links */
+    std::atomic<uint32_t> count; /**< Number of incoming links, only updated by means of AtomicRefCount */
     TypeId tid;                 /**< Type of the tag serialized into #data */
     uint32_t size;              /**< Size of the \c data buffer */
     uint8_t data[1];            /**< Serialization buffer */
   };  /* struct TagData */
 
+  /// Maximum number of tags stored inline
+  static const uint8_t INLINE_TAGS = 4;
+  /// Maximum serialized size of a tag stored inline
+  static const uint8_t INLINE_TAG_SIZE = 16;
+
+  /**
+   * A tag stored by value in the PacketTagList.
+   *
+   * \internal
+   * This has to be public for the same reason as TagData.
+   */
+  struct InlineTag
+  {
+    TypeId tid;                        /**< Type of the tag serialized into #data */
+    uint8_t size;                      /**< Number of bytes used in #data */
+    uint8_t data[INLINE_TAG_SIZE];     /**< Serialization buffer */
+  };  /* struct InlineTag */
+
   /**
    * Create a new PacketTagList.
    */
@@ -217,6 +251,15 @@ public:
    * \returns pointer to head of tag list
    */
   const struct PacketTagList::TagData *Head (void) const;
+  /**
+   * \returns the number of tags stored inline
+   */
+  inline uint8_t GetNInlineTags (void) const;
+  /**
+   * \param [in] i the index of the inline tag
+   * \returns the i-th tag stored inline
+   */
+  inline const struct PacketTagList::InlineTag &GetInlineTag (uint8_t i) const;
 
 private:
   /**
@@ -228,6 +271,26 @@ private:
    */
   static
   TagData * CreateTagData (size_t dataSize);
+  /**
+   * Release an incoming link of a TagData struct. If it was the last
+   * one, the TagData is destroyed and the link to the next TagData is
+   * released as well.
+   *
+   * \param [in] cur The TagData struct.
+   */
+  static inline void ReleaseTagData (struct TagData *cur);
+  /**
+   * \param [in] tid The tag type to look for.
+   * \returns The index of the inline tag of the given type, or
+   *          #INLINE_TAGS if no such tag is stored inline.
+   */
+  inline uint8_t FindInline (TypeId tid) const;
+  /**
+   * Remove an inline tag, moving the last inline tag in its place.
+   *
+   * \param [in] i The index of the inline tag to remove.
+   */
+  void RemoveInline (uint8_t i);
   
   /**
    * Typedef of method function pointer for copy-on-write operations
@@ -282,6 +345,8 @@ private:
    * Pointer to first \ref TagData on the list
    */
   struct TagData *m_next;
+  uint8_t m_nInline;                        //!< Number of tags stored inline
+  struct InlineTag m_inline[INLINE_TAGS];   //!< Tags stored inline
 };
 
 } // namespace ns3
@@ -293,16 +358,22 @@ private:
 namespace ns3 {
 
 PacketTagList::PacketTagList ()
-  : m_next ()
+  : m_next (),
+    m_nInline (0)
 {
 }
 
 PacketTagList::PacketTagList (PacketTagList const &o)
-  : m_next (o.m_next)
+  : m_next (o.m_next),
+    m_nInline (o.m_nInline)
 {
+  for (uint8_t i = 0; i < m_nInline; i++)
+    {
+      m_inline[i] = o.m_inline[i];
+    }
   if (m_next != 0)
     {
-      m_next->count++;
+      AtomicRefCount::Increment (m_next->count);
     }
 }
 
@@ -310,15 +381,23 @@ PacketTagList &
 PacketTagList::operator = (PacketTagList const &o)
 {
   // self assignment
-  if (m_next == o.m_next) 
+  if (this == &o)
     {
       return *this;
     }
-  RemoveAll ();
-  m_next = o.m_next;
-  if (m_next != 0) 
+  if (m_next != o.m_next)
     {
-      m_next->count++;
+      RemoveAll ();
+      m_next = o.m_next;
+      if (m_next != 0)
+        {
+          AtomicRefCount::Increment (m_next->count);
+        }
+    }
+  m_nInline = o.m_nInline;
+  for (uint8_t i = 0; i < m_nInline; i++)
+    {
+      m_inline[i] = o.m_inline[i];
     }
   return *this;
 }
@@ -328,30 +407,50 @@ PacketTagList::~PacketTagList ()
   RemoveAll ();
 }
 
+void
+PacketTagList::ReleaseTagData (struct TagData *cur)
+{
+  while (cur != 0 && AtomicRefCount::Decrement (cur->count))
+    {
+      struct TagData *next = cur->next;
+      cur->~TagData ();
+      PacketArena::Deallocate (cur);
+      cur = next;
+    }
+}
+
 void
 PacketTagList::RemoveAll (void)
 {
-  struct TagData *prev = 0;
-  for (struct TagData *cur = m_next; cur != 0; cur = cur->next)
+  ReleaseTagData (m_next);
+  m_next = 0;
+  m_nInline = 0;
+}
+
+uint8_t
+PacketTagList::GetNInlineTags (void) const
+{
+  return m_nInline;
+}
+
+const struct PacketTagList::InlineTag &
+PacketTagList::GetInlineTag (uint8_t i) const
+{
+  NS_ASSERT (i < m_nInline);
+  return m_inline[i];
+}
+
+uint8_t
+PacketTagList::FindInline (TypeId tid) const
+{
+  for (uint8_t i = 0; i < m_nInline; i++)
     {
-      cur->count--;
-      if (cur->count > 0) 
-        {
-          break;
-        }
-      if (prev != 0) 
+      if (m_inline[i].tid == tid)
         {
-          prev->~TagData ();
-          std::free (prev);
+          return i;
         }
-      prev = cur;
     }
-  if (prev != 0) 
-    {
-      prev->~TagData ();
-      std::free (prev);
-    }
-  m_next = 0;
+  return INLINE_TAGS;
 }
 
 } // namespace ns3
@@ -18,17 +18,34 @@
  * Author: Mathieu Lacage <mathieu.lacage@sophia.inria.fr>
  */
 #include "packet.h"
+#include "packet-arena.h"
 #include "ns3/assert.h"
 #include "ns3/log.h"
 #include "ns3/simulator.h"
+#include "ns3/atomic-ref-count.h"
 #include <string>
 #include <cstdarg>
+#include <chrono>
 
 namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("Packet");
 
-uint32_t Packet::m_globalUid = 0;
+std::atomic<uint32_t> Packet::m_globalUid (0);
+
+uint32_t
+Packet::AllocateUid (void)
+{
+  // the packets may be created by several threads, in which case the
+  // counter is updated atomically, like the reference counts
+  if (AtomicRefCount::IsEnabled ())
+    {
+      return m_globalUid.fetch_add (1, std::memory_order_relaxed);
+    }
+  uint32_t uid = m_globalUid.load (std::memory_order_relaxed);
+  m_globalUid.store (uid + 1, std::memory_order_relaxed);
+  return uid;
+}
 
 TypeId 
 ByteTagIterator::Item::GetTypeId (void) const
@@ -90,45 +107,55 @@ ByteTagIterator::ByteTagIterator (ByteTagList::Iterator i)
 }
 
 
-PacketTagIterator::PacketTagIterator (const struct PacketTagList::TagData *head)
-  : m_current (head)
+PacketTagIterator::PacketTagIterator (const PacketTagList *list)
+  : m_list (list),
+    m_inline (0),
+    m_current (list->Head ())
 {
 }
 bool
 PacketTagIterator::HasNext (void) const
 {
-  return m_current != 0;
+  return m_inline < m_list->GetNInlineTags () || m_current != 0;
 }
 PacketTagIterator::Item
 PacketTagIterator::Next (void)
 {
   NS_ASSERT (HasNext ());
+  if (m_inline < m_list->GetNInlineTags ())
+    {
+      const struct PacketTagList::InlineTag &tag = m_list->GetInlineTag (m_inline++);
+      return PacketTagIterator::Item (tag.tid, tag.data, tag.size);
+    }
   const struct PacketTagList::TagData *prev = m_current;
   m_current = m_current->next;
-  return PacketTagIterator::Item (prev);
+  return PacketTagIterator::Item (prev->tid, prev->data, prev->size);
 }
 
-PacketTagIterator::Item::Item (const struct PacketTagList::TagData *data)
-  : m_data (data)
+PacketTagIterator::Item::Item (TypeId tid, const uint8_t *data, uint32_t size)
+  : m_tid (tid),
+    m_data (data),
+    m_size (size)
 {
 }
 TypeId
 PacketTagIterator::Item::GetTypeId (void) const
 {
-  return m_data->tid;
+  return m_tid;
 }
 void
 PacketTagIterator::Item::GetTag (Tag &tag) const
 {
-  NS_ASSERT (tag.GetInstanceTypeId () == m_data->tid);
-  tag.Deserialize (TagBuffer ((uint8_t*)m_data->data,
-                              (uint8_t*)m_data->data + m_data->size));
+  NS_ASSERT (tag.GetInstanceTypeId () == m_tid);
+  tag.Deserialize (TagBuffer ((uint8_t*)m_data,
+                              (uint8_t*)m_data + m_size));
 }
 
 
 Ptr<Packet> 
 Packet::Copy (void) const
 {
+  PacketArena::NotifyCopy ();
   // we need to invoke the copy constructor directly
   // rather than calling Create because the copy constructor
   // is private.
@@ -145,10 +172,9 @@ Packet::Packet ()
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, 0),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), 0),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 
 Packet::Packet (const Packet &o)
@@ -187,10 +213,9 @@ Packet::Packet (uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
 }
 Packet::Packet (uint8_t const *buffer, uint32_t size, bool magic)
   : m_buffer (0, false),
@@ -213,10 +238,9 @@ Packet::Packet (uint8_t const*buffer, uint32_t size)
      * zero.  The lower 32 bits are for the 
      * global UID
      */
-    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | m_globalUid, size),
+    m_metadata (static_cast<uint64_t> (Simulator::GetSystemId ()) << 32 | AllocateUid (), size),
     m_nixVector (0)
 {
-  m_globalUid++;
   m_buffer.AddAtStart (size);
   Buffer::Iterator i = m_buffer.Begin ();
   i.Write (buffer, size);
@@ -591,6 +615,37 @@ Packet::EnableChecking (void)
   PacketMetadata::EnableChecking ();
 }
 
+Packet::AllocationStats
+Packet::GetAllocationStats (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  PacketArena::Stats arena = PacketArena::GetStats ();
+  AllocationStats stats;
+  stats.bytes = arena.allocatedBytes;
+  stats.blocks = arena.allocatedBlocks;
+  stats.liveBytes = arena.allocatedBytes - arena.releasedBytes;
+  stats.liveBlocks = arena.allocatedBlocks - arena.releasedBlocks;
+  stats.copies = arena.copies;
+  stats.seconds = std::chrono::duration<double> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+  return stats;
+}
+
+void
+Packet::PrintAllocationRates (std::ostream &os, const AllocationStats &from,
+                              const AllocationStats &to)
+{
+  NS_LOG_FUNCTION (&os);
+  double elapsed = to.seconds - from.seconds;
+  if (elapsed <= 0)
+    {
+      elapsed = 1e-9;
+    }
+  os << (to.bytes - from.bytes) / elapsed << " bytes/s, "
+     << (to.blocks - from.blocks) / elapsed << " blocks/s, "
+     << (to.copies - from.copies) / elapsed << " copies/s ("
+     << to.liveBytes << " bytes in " << to.liveBlocks << " blocks in use)";
+}
+
 uint32_t Packet::GetSerializedSize (void) const
 {
   uint32_t size = 0;
@@ -929,7 +984,7 @@ Packet::PrintPacketTags (std::ostream &os) const
 PacketTagIterator 
 Packet::GetPacketTagIterator (void) const
 {
-  return PacketTagIterator (m_packetTagList.Head ());
+  return PacketTagIterator (&m_packetTagList);
 }
 
 std::ostream& operator<< (std::ostream& os, const Packet &packet)
@@ -21,6 +21,7 @@
 #define PACKET_H
 
 #include <stdint.h>
+#include <atomic>
 #include "buffer.h"
 #include "header.h"
 #include "trailer.h"
@@ -164,10 +165,14 @@ private:
     friend class PacketTagIterator;
     /**
      * Constructor
-     * \param data the data to copy.
+     * \param tid the type of the tag
+     * \param data the serialized tag
+     * \param size the size of the serialized tag
      */
-    Item (const struct PacketTagList::TagData *data);
-    const struct PacketTagList::TagData *m_data; //!< the tag data
+    Item (TypeId tid, const uint8_t *data, uint32_t size);
+    TypeId m_tid;          //!< the type of the tag
+    const uint8_t *m_data; //!< the serialized tag
+    uint32_t m_size;       //!< the size of the serialized tag
   };
   /**
    * \returns true if calling Next is safe, false otherwise.
@@ -182,9 +187,11 @@ private:
   friend class Packet;
   /**
    * Constructor
-   * \param head head of the items
+   * \param list the list of the tags of the packet
    */
-  PacketTagIterator (const struct PacketTagList::TagData *head);
+  PacketTagIterator (const PacketTagList *list);
+  const PacketTagList *m_list;                     //!< the list of the tags of the packet
+  uint8_t m_inline;                                //!< index of the next tag stored inline
   const struct PacketTagList::TagData *m_current;  //!< actual position over the set of tags in a packet
 };
 
@@ -478,6 +485,10 @@ public:
    * sequence numbers, or other packet or frame counters at other
    * protocol layers.
    *
+   * Note: The uids of the packets created while the partitions of a
+   * MultithreadedSimulatorImpl are executed in parallel depend on the
+   * order in which the threads create them.
+   *
    * \returns an integer identifier which uniquely
    *          identifies this packet.
    */
@@ -540,6 +551,47 @@ public:
    */
   static void EnableChecking (void);
 
+  /**
+   * \brief Memory allocated for the packets, cumulated over the
+   * simulation (see PacketArena).
+   */
+  struct AllocationStats
+  {
+    uint64_t bytes;       //!< number of bytes allocated
+    uint64_t blocks;      //!< number of blocks allocated
+    uint64_t liveBytes;   //!< number of bytes allocated and not released yet
+    uint64_t liveBlocks;  //!< number of blocks allocated and not released yet
+    uint64_t copies;      //!< number of packet copies
+    double seconds;       //!< wall clock time at which the statistics were taken, in seconds
+  };
+  /**
+   * \brief Get the allocation statistics of the packets.
+   *
+   * The statistics include the buffers, the metadata and the tags of
+   * the packets created by all the threads.
+   *
+   * \returns the allocation statistics
+   */
+  static AllocationStats GetAllocationStats (void);
+  /**
+   * \brief Print the allocation rates between two sets of statistics.
+   *
+   * The number of bytes, blocks and copies per second of wall clock
+   * time are printed, e.g., to compare the cost of two configurations
+   * of a simulation:
+   * \code
+   *   Packet::AllocationStats start = Packet::GetAllocationStats ();
+   *   Simulator::Run ();
+   *   Packet::PrintAllocationRates (std::cout, start, Packet::GetAllocationStats ());
+   * \endcode
+   *
+   * \param os the output stream
+   * \param from the statistics at the beginning of the interval
+   * \param to the statistics at the end of the interval
+   */
+  static void PrintAllocationRates (std::ostream &os, const AllocationStats &from,
+                                    const AllocationStats &to);
+
   /**
    * \brief Returns number of bytes required for packet
    * serialization.
@@ -796,7 +848,13 @@ private:
   /* Please see comments above about nix-vector */
   Ptr<NixVector> m_nixVector; //!< the packet's Nix vector
 
-  static uint32_t m_globalUid; //!< Global counter of packets Uid
+  /**
+   * \brief Allocate the uid of a new packet
+   * \returns the uid
+   */
+  static uint32_t AllocateUid (void);
+
+  static std::atomic<uint32_t> m_globalUid; //!< Global counter of packets Uid
 };
 
 /**
@@ -19,12 +19,15 @@
  */
 #include "ns3/packet.h"
 #include "ns3/packet-tag-list.h"
+#include "ns3/packet-arena.h"
 #include "ns3/test.h"
 #include "ns3/unused.h"
 #include <limits>     // std:numeric_limits
 #include <string>
 #include <cstdarg>
+#include <cstring>
 #include <iostream>
+#include <sstream>
 #include <iomanip>
 #include <ctime>
 
@@ -994,6 +997,45 @@ PacketTagListTest::DoRun (void)
     ReplaceCheck (7);
   }
   
+  { // Inline tags
+    std::cout << GetName () << "check tags stored inline and in the tree"
+              << std::endl;
+    // the small tags fill the inline slots first, the others go to the tree
+    NS_TEST_EXPECT_MSG_EQ ((uint32_t)ref.GetNInlineTags (), PacketTagList::INLINE_TAGS,
+                           "inline slots not used");
+    PacketTagList ptl = ref;
+    ptl.Remove (t2);
+    ALargeTestTag large;
+    ptl.Add (large);                 // too large for the free inline slot
+    ATestTag<8> t8 (1);
+    ptl.Add (t8);                    // takes the free inline slot
+    NS_TEST_EXPECT_MSG_EQ ((uint32_t)ptl.GetNInlineTags (), PacketTagList::INLINE_TAGS,
+                           "free inline slot not reused");
+    CheckRef (ptl, t8, "inline, after add");
+    CheckRef (ptl, t2, "inline, after remove", true);
+    CheckRefList (ref, "inline, orig");
+
+    // the packet tag iterator visits the tags stored inline and in the tree
+    Ptr<Packet> p = Create<Packet> (10);
+    p->AddPacketTag (t1);
+    p->AddPacketTag (t2);
+    p->AddPacketTag (t3);
+    p->AddPacketTag (t4);
+    p->AddPacketTag (t5);
+    p->AddPacketTag (t6);
+    p->AddPacketTag (t7);
+    uint32_t n = 0;
+    PacketTagIterator i = p->GetPacketTagIterator ();
+    while (i.HasNext ())
+      {
+        PacketTagIterator::Item item = i.Next ();
+        NS_TEST_EXPECT_MSG_EQ (item.GetTypeId ().GetParent (), ATestTagBase::GetTypeId (),
+                               "unexpected tag");
+        n++;
+      }
+    NS_TEST_EXPECT_MSG_EQ (n, 7u, "wrong number of tags");
+  }
+
   { // Timing
     std::cout << GetName () << "add+remove timing" << std::endl;
     int flm = std::numeric_limits<int>::max ();
@@ -1035,6 +1077,93 @@ PacketTagListTest::DoRun (void)
     
 }
 
+/**
+ * \ingroup network-test
+ * \ingroup tests
+ *
+ * Packet arena and allocation statistics unit tests.
+ */
+class PacketArenaTest : public TestCase
+{
+public:
+  PacketArenaTest ();
+private:
+  void DoRun (void);
+};
+
+PacketArenaTest::PacketArenaTest ()
+  : TestCase ("PacketArena")
+{
+}
+
+void
+PacketArenaTest::DoRun (void)
+{
+  // blocks are at least as large as requested and are reused once released
+  void *small = PacketArena::Allocate (1);
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (PacketArena::GetCapacity (small), 1, "block too small");
+  void *medium = PacketArena::Allocate (1000);
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (PacketArena::GetCapacity (medium), 1000, "block too small");
+  void *large = PacketArena::Allocate (100000);
+  NS_TEST_EXPECT_MSG_EQ (PacketArena::GetCapacity (large), 100000, "wrong capacity of a large block");
+  std::memset (medium, 0xab, PacketArena::GetCapacity (medium));
+  std::memset (large, 0xcd, 100000);
+  PacketArena::Deallocate (medium);
+  void *reused = PacketArena::Allocate (900);
+  NS_TEST_EXPECT_MSG_EQ (reused, medium, "released block not reused");
+  PacketArena::Deallocate (reused);
+  PacketArena::Deallocate (large);
+  PacketArena::Deallocate (small);
+
+  // blocks not pooled are taken from the heap
+  void *unpooled = PacketArena::Allocate (100, false);
+  NS_TEST_EXPECT_MSG_EQ (PacketArena::GetCapacity (unpooled), 100, "wrong capacity of a block not pooled");
+  PacketArena::Deallocate (unpooled);
+
+  // the slabs whose blocks are all free are returned to the system
+  std::vector<void *> blocks;
+  uint64_t slabBytes = PacketArena::GetStats ().slabBytes;
+  for (uint32_t i = 0; i < 4096; i++)
+    {
+      blocks.push_back (PacketArena::Allocate (1000));
+    }
+  NS_TEST_EXPECT_MSG_GT (PacketArena::GetStats ().slabBytes, slabBytes, "no slab carved");
+  void *kept = blocks.back ();
+  blocks.pop_back ();
+  for (std::vector<void *>::iterator it = blocks.begin (); it != blocks.end (); ++it)
+    {
+      PacketArena::Deallocate (*it);
+    }
+  PacketArena::Release ();
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (PacketArena::GetStats ().slabBytes, slabBytes + 65536, "free slabs not released");
+  NS_TEST_EXPECT_MSG_GT (PacketArena::GetStats ().slabBytes, 0, "the slab of the block in use was released");
+  std::memset (kept, 0xef, 1000);
+  PacketArena::Deallocate (kept);
+
+  // the statistics account for the packets and their copies
+  Packet::AllocationStats before = Packet::GetAllocationStats ();
+  {
+    uint8_t payload[1500] = {0};
+    Ptr<Packet> p = Create<Packet> (payload, 1500);
+    ATestTag<1> tag (1);
+    p->AddPacketTag (tag);
+    p->AddByteTag (tag);
+    Ptr<Packet> copy = p->Copy ();
+    copy->AddHeader (ATestHeader<10> ());
+    Packet::AllocationStats during = Packet::GetAllocationStats ();
+    NS_TEST_EXPECT_MSG_EQ (during.copies, before.copies + 1, "copy not accounted for");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ (during.blocks, before.blocks + 4, "blocks not accounted for");
+    NS_TEST_EXPECT_MSG_GT_OR_EQ (during.bytes, before.bytes + 1500, "bytes not accounted for");
+    NS_TEST_EXPECT_MSG_GT (during.liveBlocks, before.liveBlocks, "live blocks not accounted for");
+  }
+  Packet::AllocationStats after = Packet::GetAllocationStats ();
+  NS_TEST_EXPECT_MSG_EQ (after.liveBlocks, before.liveBlocks, "blocks not released");
+  NS_TEST_EXPECT_MSG_EQ (after.liveBytes, before.liveBytes, "bytes not released");
+  std::ostringstream oss;
+  Packet::PrintAllocationRates (oss, before, after);
+  NS_TEST_EXPECT_MSG_NE (oss.str ().find ("copies/s"), std::string::npos, "rates not printed");
+}
+
 /**
  * \ingroup network-test
  * \ingroup tests
@@ -1052,6 +1181,7 @@ PacketTestSuite::PacketTestSuite ()
 {
   AddTestCase (new PacketTest, TestCase::QUICK);
   AddTestCase (new PacketTagListTest, TestCase::QUICK);
+  AddTestCase (new PacketArenaTest, TestCase::QUICK);
 }
 
 static PacketTestSuite g_packetTestSuite; //!< Static variable for test initialization
@@ -32,6 +32,7 @@ NS_LOG_COMPONENT_DEFINE ("NetDeviceQueueInterface");
 NetDeviceQueue::NetDeviceQueue ()
   : m_stoppedByDevice (false),
     m_stoppedByQueueLimits (false),
+    m_bytesReportedByDevice (false),
     NS_LOG_TEMPLATE_DEFINE ("NetDeviceQueueInterface")
 {
   NS_LOG_FUNCTION (this);
@@ -135,6 +136,13 @@ NetDeviceQueue::NotifyTransmittedBytes (uint32_t bytes)
     }
 }
 
+void
+NetDeviceQueue::SetBytesReportedByDevice (bool byDevice)
+{
+  NS_LOG_FUNCTION (this << byDevice);
+  m_bytesReportedByDevice = byDevice;
+}
+
 void
 NetDeviceQueue::ResetQueueLimits ()
 {
@@ -124,6 +124,20 @@ public:
    */
   void NotifyTransmittedBytes (uint32_t bytes);
 
+  /**
+   * \brief Set whether the netdevice reports the queued and transmitted bytes
+   * \param byDevice true if the netdevice calls NotifyQueuedBytes and
+   *        NotifyTransmittedBytes itself
+   *
+   * By default, the bytes of the packets enqueued in (dequeued from) the device
+   * queue connected through ConnectQueueTraces are reported as queued
+   * (transmitted). Netdevices that keep the packets after dequeuing them from
+   * the device queue (e.g., until they are acknowledged) report the bytes
+   * themselves, so that the queue limits account for the packets being
+   * transmitted too.
+   */
+  void SetBytesReportedByDevice (bool byDevice);
+
   /**
    * \brief Reset queue limits state
    */
@@ -199,6 +213,7 @@ public:
 private:
   bool m_stoppedByDevice;         //!< True if the queue has been stopped by the device
   bool m_stoppedByQueueLimits;    //!< True if the queue has been stopped by a queue limits object
+  bool m_bytesReportedByDevice;   //!< True if the device reports the queued and transmitted bytes
   Ptr<QueueLimits> m_queueLimits; //!< Queue limits object
   WakeCallback m_wakeCallback;    //!< Wake callback
   Ptr<NetDevice> m_device;        //!< the netdevice aggregated to the NetDeviceQueueInterface
@@ -326,7 +341,10 @@ NetDeviceQueue::PacketEnqueued (QueueType* queue, Ptr<const typename QueueType::
   NS_LOG_FUNCTION (this << queue << item);
 
   // Inform BQL
-  NotifyQueuedBytes (item->GetSize ());
+  if (!m_bytesReportedByDevice)
+    {
+      NotifyQueuedBytes (item->GetSize ());
+    }
 
   NS_ASSERT_MSG (m_device, "Aggregated NetDevice not set");
   Ptr<Packet> p = Create<Packet> (m_device->GetMtu ());
@@ -349,7 +367,10 @@ NetDeviceQueue::PacketDequeued (QueueType* queue, Ptr<const typename QueueType::
   NS_LOG_FUNCTION (this << queue << item);
 
   // Inform BQL
-  NotifyTransmittedBytes (item->GetSize ());
+  if (!m_bytesReportedByDevice)
+    {
+      NotifyTransmittedBytes (item->GetSize ());
+    }
 
   NS_ASSERT_MSG (m_device, "Aggregated NetDevice not set");
   Ptr<Packet> p = Create<Packet> (m_device->GetMtu ());
@@ -24,6 +24,13 @@
 #include "ns3/point-to-point-net-device.h"
 #include "ns3/point-to-point-channel.h"
 #include "ns3/net-device-queue-interface.h"
+#include "ns3/config.h"
+#include "ns3/string.h"
+#include "ns3/uinteger.h"
+#include "ns3/data-rate.h"
+#include "ns3/multithreaded-simulator-impl.h"
+
+#include <vector>
 
 using namespace ns3;
 
@@ -94,6 +101,172 @@ PointToPointTest::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \brief Test class for PointToPoint model with the MultithreadedSimulatorImpl
+ *
+ * Two nodes, whose contexts belong to different partitions of the
+ * MultithreadedSimulatorImpl, send packets of various sizes to each other
+ * over a PointToPointChannel whose delay is the lookahead of the simulator.
+ * The time and the size of the packets received by each device must be the
+ * same as with the DefaultSimulatorImpl.
+ */
+class PointToPointMultithreadedTest : public TestCase
+{
+public:
+  /**
+   * \brief Create the test
+   */
+  PointToPointMultithreadedTest ();
+
+  /**
+   * \brief Run the test
+   */
+  virtual void DoRun (void);
+
+private:
+  /**
+   * \brief Run the scenario with the given simulator implementation
+   *
+   * \param simulatorType the simulator implementation type
+   */
+  void RunScenario (const std::string &simulatorType);
+
+  /**
+   * \brief Send a burst of packets from the device specified
+   *
+   * \param device NetDevice to send from
+   * \param count the number of packets
+   */
+  void SendPackets (Ptr<PointToPointNetDevice> device, uint32_t count);
+
+  /**
+   * \brief Record a packet received by a device
+   *
+   * \param device the receiving NetDevice
+   * \param packet the received packet
+   * \param protocol the protocol number
+   * \param from the address of the sender
+   * \return true
+   */
+  bool Receive (Ptr<NetDevice> device, Ptr<const Packet> packet, uint16_t protocol, const Address &from);
+
+  /// A received packet
+  struct Reception
+  {
+    Time time;      //!< the reception time
+    uint32_t size;  //!< the packet size
+  };
+
+  std::vector<Reception> m_received[2];    //!< the packets received by each device
+  Ptr<PointToPointNetDevice> m_devices[2]; //!< the devices
+};
+
+PointToPointMultithreadedTest::PointToPointMultithreadedTest ()
+  : TestCase ("PointToPoint across the partitions of the MultithreadedSimulatorImpl")
+{
+}
+
+void
+PointToPointMultithreadedTest::SendPackets (Ptr<PointToPointNetDevice> device, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; i++)
+    {
+      Ptr<Packet> p = Create<Packet> (100 + 37 * i + (device == m_devices[1] ? 1 : 0));
+      device->Send (p, device->GetBroadcast (), 0x800);
+    }
+}
+
+bool
+PointToPointMultithreadedTest::Receive (Ptr<NetDevice> device, Ptr<const Packet> packet,
+                                        uint16_t protocol, const Address &from)
+{
+  // each vector is only written by the partition of the receiving device
+  uint32_t receiver = (device == m_devices[0] ? 0 : 1);
+  Reception reception;
+  reception.time = Simulator::Now ();
+  reception.size = packet->GetSize ();
+  m_received[receiver].push_back (reception);
+  return true;
+}
+
+void
+PointToPointMultithreadedTest::RunScenario (const std::string &simulatorType)
+{
+  Config::SetGlobal ("SimulatorImplementationType", StringValue (simulatorType));
+
+  Ptr<Node> nodes[2];
+  Ptr<PointToPointChannel> channel = CreateObject<PointToPointChannel> ();
+  channel->SetAttribute ("Delay", TimeValue (MicroSeconds (10)));
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      nodes[i] = CreateObject<Node> ();
+      m_devices[i] = CreateObject<PointToPointNetDevice> ();
+      m_devices[i]->SetAttribute ("DataRate", DataRateValue (DataRate ("100Mbps")));
+      m_devices[i]->Attach (channel);
+      m_devices[i]->SetAddress (Mac48Address::Allocate ());
+      m_devices[i]->SetQueue (CreateObject<DropTailQueue<Packet> > ());
+      nodes[i]->AddDevice (m_devices[i]);
+      // after AddDevice, which installs the receive callback of the node
+      m_devices[i]->SetReceiveCallback (MakeCallback (&PointToPointMultithreadedTest::Receive, this));
+      m_received[i].clear ();
+    }
+  NS_TEST_ASSERT_MSG_NE (nodes[0]->GetId () % 2, nodes[1]->GetId () % 2,
+                         "The nodes must belong to different partitions");
+
+  for (uint32_t burst = 0; burst < 10; burst++)
+    {
+      for (uint32_t i = 0; i < 2; i++)
+        {
+          Simulator::ScheduleWithContext (nodes[i]->GetId (), MicroSeconds (500 * burst + 3 * i),
+                                          &PointToPointMultithreadedTest::SendPackets, this,
+                                          m_devices[i], 5);
+        }
+    }
+
+  Simulator::Run ();
+
+  if (simulatorType == "ns3::MultithreadedSimulatorImpl")
+    {
+      Ptr<MultithreadedSimulatorImpl> impl = DynamicCast<MultithreadedSimulatorImpl> (Simulator::GetImplementation ());
+      NS_TEST_ASSERT_MSG_NE (impl, 0, "Unexpected simulator implementation");
+      NS_TEST_EXPECT_MSG_GT (impl->GetRoundCount (), 0, "No parallel round was performed");
+    }
+
+  Simulator::Destroy ();
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      m_devices[i] = 0;
+    }
+}
+
+void
+PointToPointMultithreadedTest::DoRun (void)
+{
+  RunScenario ("ns3::DefaultSimulatorImpl");
+  std::vector<Reception> expected[2] = {m_received[0], m_received[1]};
+
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (2));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (10)));
+  RunScenario ("ns3::MultithreadedSimulatorImpl");
+  Config::SetGlobal ("SimulatorImplementationType", StringValue ("ns3::DefaultSimulatorImpl"));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::ThreadCount", UintegerValue (0));
+  Config::SetDefault ("ns3::MultithreadedSimulatorImpl::Lookahead", TimeValue (MicroSeconds (1)));
+
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (expected[i].size (), 50, "Unexpected number of packets received by device " << i);
+      NS_TEST_ASSERT_MSG_EQ (m_received[i].size (), expected[i].size (),
+                             "Unexpected number of packets received by device " << i);
+      for (uint32_t j = 0; j < expected[i].size (); j++)
+        {
+          NS_TEST_EXPECT_MSG_EQ (m_received[i][j].time, expected[i][j].time,
+                                 "Unexpected reception time of packet " << j << " by device " << i);
+          NS_TEST_EXPECT_MSG_EQ (m_received[i][j].size, expected[i][j].size,
+                                 "Unexpected size of packet " << j << " received by device " << i);
+        }
+    }
+}
+
 /**
  * \brief TestSuite for PointToPoint module
  */
@@ -110,6 +283,7 @@ PointToPointTestSuite::PointToPointTestSuite ()
   : TestSuite ("devices-point-to-point", UNIT)
 {
   AddTestCase (new PointToPointTest, TestCase::QUICK);
+  AddTestCase (new PointToPointMultithreadedTest, TestCase::QUICK);
 }
 
 static PointToPointTestSuite g_pointToPointTestSuite; //!< The testsuite
@@ -0,0 +1,319 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "analytical-rem-generator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <ns3/core-config.h>
+#include <ns3/log.h>
+#include <ns3/abort.h>
+#include <ns3/double.h>
+#include <ns3/pointer.h>
+#include <ns3/angles.h>
+#include <ns3/antenna-model.h>
+#include <ns3/mobility-model.h>
+#include <ns3/constant-position-mobility-model.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-channel.h>
+#include <ns3/spectrum-converter.h>
+#include <ns3/spectrum-model.h>
+#include <ns3/spectrum-propagation-loss-model.h>
+#ifdef HAVE_PTHREAD_H
+#include <ns3/system-thread.h>
+#endif /* HAVE_PTHREAD_H */
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AnalyticalRemGenerator");
+
+AnalyticalRemGenerator::AnalyticalRemGenerator ()
+  : m_maxLossDb (1.0e9),
+    m_xMin (0.0),
+    m_xMax (1.0),
+    m_xRes (100),
+    m_yMin (0.0),
+    m_yMax (1.0),
+    m_yRes (100),
+    m_z (0.0),
+    m_threads (1)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+AnalyticalRemGenerator::~AnalyticalRemGenerator ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+AnalyticalRemGenerator::SetChannel (Ptr<SpectrumChannel> channel)
+{
+  NS_LOG_FUNCTION (this << channel);
+  m_channel = channel;
+  PointerValue propagationLoss;
+  channel->GetAttribute ("PropagationLossModel", propagationLoss);
+  m_propagationLoss = propagationLoss.Get<PropagationLossModel> ();
+  m_spectrumLoss = channel->GetSpectrumPropagationLossModel ();
+  DoubleValue maxLossDb;
+  channel->GetAttribute ("MaxLossDb", maxLossDb);
+  m_maxLossDb = maxLossDb.Get ();
+}
+
+void
+AnalyticalRemGenerator::SetRxSpectrumModel (Ptr<const SpectrumModel> model)
+{
+  NS_LOG_FUNCTION (this << model);
+  NS_ABORT_MSG_IF (!m_transmitters.empty (), "the receiver spectrum model must be set before adding transmitters");
+  m_rxSpectrumModel = model;
+}
+
+void
+AnalyticalRemGenerator::SetRxAntenna (Ptr<AntennaModel> antenna)
+{
+  NS_LOG_FUNCTION (this << antenna);
+  m_rxAntenna = antenna;
+}
+
+void
+AnalyticalRemGenerator::SetPositionCallback (PositionCallback cb)
+{
+  NS_LOG_FUNCTION (this);
+  m_positionCallback = cb;
+}
+
+void
+AnalyticalRemGenerator::SetGrid (double xMin, double xMax, uint16_t xRes,
+                                 double yMin, double yMax, uint16_t yRes, double z)
+{
+  NS_LOG_FUNCTION (this << xMin << xMax << xRes << yMin << yMax << yRes << z);
+  NS_ABORT_MSG_IF (xRes < 2 || yRes < 2, "the grid must have at least two points along each axis");
+  m_xMin = xMin;
+  m_xMax = xMax;
+  m_xRes = xRes;
+  m_yMin = yMin;
+  m_yMax = yMax;
+  m_yRes = yRes;
+  m_z = z;
+}
+
+void
+AnalyticalRemGenerator::SetThreads (uint32_t threads)
+{
+  NS_LOG_FUNCTION (this << threads);
+  NS_ABORT_MSG_IF (threads == 0, "at least one thread is needed");
+#ifndef HAVE_PTHREAD_H
+  if (threads > 1)
+    {
+      NS_LOG_WARN ("threading is not available, the map will be generated by a single thread");
+      threads = 1;
+    }
+#endif /* HAVE_PTHREAD_H */
+  m_threads = threads;
+}
+
+void
+AnalyticalRemGenerator::AddTransmitter (Ptr<const MobilityModel> mobility, Ptr<const SpectrumValue> txPsd,
+                                        Ptr<AntennaModel> txAntenna)
+{
+  NS_LOG_FUNCTION (this << mobility << txPsd << txAntenna);
+  NS_ABORT_MSG_UNLESS (m_rxSpectrumModel, "the receiver spectrum model must be set before adding transmitters");
+  Transmitter transmitter;
+  transmitter.position = mobility->GetPosition ();
+  transmitter.antenna = txAntenna;
+  // convert the PSD once for all the points, as the channel does for each signal
+  if (txPsd->GetSpectrumModelUid () == m_rxSpectrumModel->GetUid ())
+    {
+      transmitter.rxPsd = txPsd->Copy ();
+    }
+  else if (!txPsd->GetSpectrumModel ()->IsOrthogonal (*m_rxSpectrumModel))
+    {
+      SpectrumConverter converter (txPsd->GetSpectrumModel (), m_rxSpectrumModel);
+      transmitter.rxPsd = converter.Convert (txPsd);
+    }
+  else
+    {
+      NS_LOG_LOGIC ("transmitter spectrum model orthogonal to the receiver one");
+    }
+  m_transmitters.push_back (transmitter);
+}
+
+uint32_t
+AnalyticalRemGenerator::GetNTransmitters (void) const
+{
+  return m_transmitters.size ();
+}
+
+void
+AnalyticalRemGenerator::Generate (PointEvaluator evaluator, std::vector<Point> &points) const
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_UNLESS (m_channel, "no channel set");
+  NS_ABORT_MSG_UNLESS (m_rxSpectrumModel, "no receiver spectrum model set");
+
+  double xStep = (m_xMax - m_xMin) / (m_xRes - 1);
+  double yStep = (m_yMax - m_yMin) / (m_yRes - 1);
+  points.resize (static_cast<uint32_t> (m_xRes) * m_yRes);
+  for (uint32_t i = 0; i < m_xRes; ++i)
+    {
+      for (uint32_t j = 0; j < m_yRes; ++j)
+        {
+          points[i * m_yRes + j].position = Vector (m_xMin + i * xStep, m_yMin + j * yStep, m_z);
+        }
+    }
+
+  // the reference counted objects used by a worker (mobility models, spectrum
+  // values and their spectrum model) are its own, and created here
+  uint32_t nWorkers = std::min<uint32_t> (m_threads, points.size ());
+  std::vector<Worker> workers (nWorkers);
+  for (uint32_t w = 0; w < nWorkers; ++w)
+    {
+      Worker &worker = workers[w];
+      worker.generator = this;
+      worker.first = w;
+      worker.stride = nWorkers;
+      worker.evaluator = evaluator;
+      worker.points = &points;
+      Ptr<SpectrumModel> model = Create<SpectrumModel> (Bands (m_rxSpectrumModel->Begin (), m_rxSpectrumModel->End ()));
+      worker.rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+      worker.rxMobility->SetPosition (points[w].position);
+      if (!m_positionCallback.IsNull ())
+        {
+          m_positionCallback (worker.rxMobility);
+        }
+      for (std::vector<Transmitter>::const_iterator it = m_transmitters.begin (); it != m_transmitters.end (); ++it)
+        {
+          Ptr<MobilityModel> txMobility = CreateObject<ConstantPositionMobilityModel> ();
+          txMobility->SetPosition (it->position);
+          if (!m_positionCallback.IsNull ())
+            {
+              m_positionCallback (txMobility);
+            }
+          worker.txMobility.push_back (txMobility);
+          SpectrumValue txPsd (model);
+          if (it->rxPsd)
+            {
+              std::copy (it->rxPsd->ConstValuesBegin (), it->rxPsd->ConstValuesEnd (), txPsd.ValuesBegin ());
+            }
+          worker.txPsd.push_back (txPsd);
+        }
+      worker.rxPsd = worker.txPsd;
+    }
+
+  NS_LOG_LOGIC ("evaluating " << points.size () << " points with " << nWorkers << " threads");
+#ifdef HAVE_PTHREAD_H
+  if (nWorkers > 1)
+    {
+      std::vector<Ptr<SystemThread> > threads;
+      for (uint32_t w = 1; w < nWorkers; ++w)
+        {
+          Ptr<SystemThread> thread = Create<SystemThread> (MakeBoundCallback (&AnalyticalRemGenerator::RunWorker,
+                                                                              &workers[w]));
+          thread->Start ();
+          threads.push_back (thread);
+        }
+      RunWorker (&workers[0]);
+      for (std::vector<Ptr<SystemThread> >::iterator it = threads.begin (); it != threads.end (); ++it)
+        {
+          (*it)->Join ();
+        }
+      return;
+    }
+#endif /* HAVE_PTHREAD_H */
+  for (uint32_t w = 0; w < nWorkers; ++w)
+    {
+      RunWorker (&workers[w]);
+    }
+}
+
+void
+AnalyticalRemGenerator::Generate (PointEvaluator evaluator, std::ostream &os) const
+{
+  NS_LOG_FUNCTION (this);
+  std::vector<Point> points;
+  Generate (evaluator, points);
+  for (std::vector<Point>::const_iterator it = points.begin (); it != points.end (); ++it)
+    {
+      os << it->position.x << "\t"
+         << it->position.y << "\t"
+         << it->position.z;
+      for (std::vector<double>::const_iterator v = it->values.begin (); v != it->values.end (); ++v)
+        {
+          os << "\t" << *v;
+        }
+      os << std::endl;
+    }
+}
+
+void
+AnalyticalRemGenerator::RunWorker (Worker *worker)
+{
+  // no logging here, as this may run outside of the main thread
+  std::vector<Point> &points = *worker->points;
+  for (uint32_t i = worker->first; i < points.size (); i += worker->stride)
+    {
+      worker->rxMobility->SetPosition (points[i].position);
+      if (!worker->generator->m_positionCallback.IsNull ())
+        {
+          worker->generator->m_positionCallback (worker->rxMobility);
+        }
+      worker->generator->ComputeRxPsds (worker);
+      worker->evaluator (worker->rxPsd, points[i].values);
+    }
+}
+
+void
+AnalyticalRemGenerator::ComputeRxPsds (Worker *worker) const
+{
+  Vector rxPosition = worker->rxMobility->GetPosition ();
+  for (uint32_t i = 0; i < m_transmitters.size (); ++i)
+    {
+      const Transmitter &transmitter = m_transmitters[i];
+      SpectrumValue &rxPsd = worker->rxPsd[i];
+      if (!transmitter.rxPsd)
+        {
+          continue; // orthogonal, left null
+        }
+      // same computation as MultiModelSpectrumChannel::Propagate
+      double pathLossDb = 0;
+      if (transmitter.antenna)
+        {
+          pathLossDb -= transmitter.antenna->GetGainDb (Angles (rxPosition, transmitter.position));
+        }
+      if (m_rxAntenna)
+        {
+          pathLossDb -= m_rxAntenna->GetGainDb (Angles (transmitter.position, rxPosition));
+        }
+      if (m_propagationLoss)
+        {
+          pathLossDb -= m_propagationLoss->CalcRxPower (0, worker->txMobility[i], worker->rxMobility);
+        }
+      if (pathLossDb > m_maxLossDb)
+        {
+          rxPsd = 0.0;
+          continue;
+        }
+      rxPsd = worker->txPsd[i];
+      rxPsd *= std::pow (10.0, (-pathLossDb) / 10.0);
+      if (m_spectrumLoss)
+        {
+          Ptr<SpectrumValue> psd = Create<SpectrumValue> (rxPsd);
+          rxPsd = *m_spectrumLoss->CalcRxPowerSpectralDensity (psd, worker->txMobility[i], worker->rxMobility);
+        }
+    }
+}
+
+} // namespace ns3
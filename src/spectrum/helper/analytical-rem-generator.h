@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef ANALYTICAL_REM_GENERATOR_H
+#define ANALYTICAL_REM_GENERATOR_H
+
+#include <ostream>
+#include <vector>
+#include <ns3/ptr.h>
+#include <ns3/callback.h>
+#include <ns3/vector.h>
+#include <ns3/spectrum-value.h>
+
+namespace ns3 {
+
+class SpectrumChannel;
+class SpectrumModel;
+class MobilityModel;
+class AntennaModel;
+class PropagationLossModel;
+class SpectrumPropagationLossModel;
+
+/**
+ * \ingroup spectrum
+ *
+ * \brief Generator of Radio Environment Maps evaluating the received power
+ * spectral densities analytically, on a grid of points.
+ *
+ * Rather than attaching a receiving SpectrumPhy per point to the channel and
+ * running the simulation until the transmitters have transmitted, the
+ * generator applies the antenna models and the propagation loss models of
+ * the channel to the power spectral densities of the transmitters registered
+ * with AddTransmitter (), in the same way as MultiModelSpectrumChannel does
+ * when propagating a signal. The received power spectral densities of a point
+ * (one per transmitter, in the receiver spectrum model) are then passed to an
+ * evaluator, which computes the values written for the point (e.g., the SINR
+ * of the strongest transmitter).
+ *
+ * The points are spread over the given number of threads. Each thread uses
+ * its own copies of the mobility models and of the spectrum model, but the
+ * loss models of the channel, the antenna models and the evaluator are
+ * shared: with more than one thread, they must not modify any state when
+ * evaluated (as it is the case for deterministic models, but not for models
+ * caching per-link values such as shadowing or fading models). The models
+ * are evaluated at the current simulation time.
+ */
+class AnalyticalRemGenerator
+{
+public:
+  /// A point of the map
+  struct Point
+  {
+    Vector position;            //!< the position of the point
+    std::vector<double> values; //!< the values computed by the evaluator
+  };
+
+  /**
+   * Evaluator of a point: computes the values of the point from the power
+   * spectral densities received from each transmitter (in the order in which
+   * the transmitters were added). Signals beyond the MaxLossDb attribute of
+   * the channel are received with a null power spectral density.
+   */
+  typedef Callback<void, const std::vector<SpectrumValue> &, std::vector<double> &> PointEvaluator;
+
+  /**
+   * Callback invoked whenever the position of a mobility model used by the
+   * generator has been set, e.g., to update the building information of the
+   * model. It is first invoked from the main thread for each model when it is
+   * created, then possibly from the worker threads.
+   */
+  typedef Callback<void, Ptr<MobilityModel> > PositionCallback;
+
+  AnalyticalRemGenerator ();
+  ~AnalyticalRemGenerator ();
+
+  /**
+   * \param channel the channel whose loss models are to be used
+   */
+  void SetChannel (Ptr<SpectrumChannel> channel);
+  /**
+   * \param model the spectrum model of the receivers
+   */
+  void SetRxSpectrumModel (Ptr<const SpectrumModel> model);
+  /**
+   * \param antenna the antenna model of the receivers (none by default)
+   */
+  void SetRxAntenna (Ptr<AntennaModel> antenna);
+  /**
+   * \param cb the callback invoked when the position of a mobility model is set
+   */
+  void SetPositionCallback (PositionCallback cb);
+  /**
+   * Set the grid of points: xRes points from xMin to xMax, and yRes points
+   * from yMin to yMax, at height z.
+   *
+   * \param xMin the min x coordinate
+   * \param xMax the max x coordinate
+   * \param xRes the number of points along the x axis
+   * \param yMin the min y coordinate
+   * \param yMax the max y coordinate
+   * \param yRes the number of points along the y axis
+   * \param z the z coordinate
+   */
+  void SetGrid (double xMin, double xMax, uint16_t xRes,
+                double yMin, double yMax, uint16_t yRes, double z);
+  /**
+   * \param threads the number of threads over which the points are spread
+   */
+  void SetThreads (uint32_t threads);
+
+  /**
+   * Register a transmitter. Only the position of its mobility model, at the
+   * time of the call, is used.
+   *
+   * \param mobility the mobility model of the transmitter
+   * \param txPsd the power spectral density transmitted
+   * \param txAntenna the antenna model of the transmitter, if any
+   */
+  void AddTransmitter (Ptr<const MobilityModel> mobility, Ptr<const SpectrumValue> txPsd,
+                       Ptr<AntennaModel> txAntenna = 0);
+  /**
+   * \return the number of transmitters registered
+   */
+  uint32_t GetNTransmitters (void) const;
+
+  /**
+   * Evaluate the points of the grid, ordered by x and then by y coordinate.
+   *
+   * \param evaluator the evaluator of the points
+   * \param points the points evaluated
+   */
+  void Generate (PointEvaluator evaluator, std::vector<Point> &points) const;
+  /**
+   * Evaluate the points of the grid and write them, one per line: the x, y
+   * and z coordinates followed by the values of the point, separated by tabs.
+   *
+   * \param evaluator the evaluator of the points
+   * \param os the output stream
+   */
+  void Generate (PointEvaluator evaluator, std::ostream &os) const;
+
+private:
+  /// A transmitter
+  struct Transmitter
+  {
+    Vector position;             //!< the position of the transmitter
+    Ptr<SpectrumValue> rxPsd;    //!< the transmitted PSD, converted to the receiver spectrum model, or 0 if orthogonal
+    Ptr<AntennaModel> antenna;   //!< the antenna of the transmitter
+  };
+
+  /// The state of a worker thread
+  struct Worker
+  {
+    const AnalyticalRemGenerator *generator;      //!< the generator
+    uint32_t first;                               //!< the index of the first point evaluated by the worker
+    uint32_t stride;                              //!< the distance between the points evaluated by the worker
+    PointEvaluator evaluator;                     //!< the evaluator
+    std::vector<Point> *points;                   //!< the points
+    Ptr<MobilityModel> rxMobility;                //!< the mobility model of the receiver
+    std::vector<Ptr<MobilityModel> > txMobility;  //!< the mobility models of the transmitters
+    std::vector<SpectrumValue> txPsd;             //!< the PSDs of the transmitters, in the worker spectrum model
+    std::vector<SpectrumValue> rxPsd;             //!< the PSDs received at the current point
+  };
+
+  /**
+   * Evaluate the points of a worker.
+   * \param worker the worker
+   */
+  static void RunWorker (Worker *worker);
+  /**
+   * Compute the PSDs received by a worker at its current position.
+   * \param worker the worker
+   */
+  void ComputeRxPsds (Worker *worker) const;
+
+  Ptr<SpectrumChannel> m_channel;                           //!< the channel
+  Ptr<PropagationLossModel> m_propagationLoss;              //!< the propagation loss model of the channel
+  Ptr<SpectrumPropagationLossModel> m_spectrumLoss;         //!< the spectrum propagation loss model of the channel
+  double m_maxLossDb;                                       //!< the MaxLossDb attribute of the channel
+  Ptr<const SpectrumModel> m_rxSpectrumModel;               //!< the spectrum model of the receivers
+  Ptr<AntennaModel> m_rxAntenna;                            //!< the antenna of the receivers
+  PositionCallback m_positionCallback;                      //!< the position callback
+  std::vector<Transmitter> m_transmitters;                  //!< the transmitters
+
+  double m_xMin;      //!< the min x coordinate
+  double m_xMax;      //!< the max x coordinate
+  uint16_t m_xRes;    //!< the number of points along the x axis
+  double m_yMin;      //!< the min y coordinate
+  double m_yMax;      //!< the max y coordinate
+  uint16_t m_yRes;    //!< the number of points along the y axis
+  double m_z;         //!< the z coordinate
+  uint32_t m_threads; //!< the number of threads
+};
+
+} // namespace ns3
+
+#endif /* ANALYTICAL_REM_GENERATOR_H */
@@ -23,6 +23,7 @@
 #include <utility>
 #include <ns3/object.h>
 #include <ns3/simulator.h>
+#include <ns3/atomic-ref-count.h>
 #include <ns3/log.h>
 #include <ns3/packet.h>
 #include <ns3/packet-burst.h>
@@ -110,6 +111,12 @@ MultiModelSpectrumChannel::AddRx (Ptr<SpectrumPhy> phy)
 {
   NS_LOG_FUNCTION (this << phy);
 
+  std::unique_lock<std::mutex> lock (m_mutex, std::defer_lock);
+  if (AtomicRefCount::IsEnabled ())
+    {
+      lock.lock ();
+    }
+
   Ptr<const SpectrumModel> rxSpectrumModel = phy->GetRxSpectrumModel ();
 
   NS_ASSERT_MSG ((0 != rxSpectrumModel), "phy->GetRxSpectrumModel () returned 0. Please check that the RxSpectrumModel is already set for the phy before calling MultiModelSpectrumChannel::AddRx (phy)");
@@ -223,6 +230,22 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
   Ptr<SpectrumSignalParameters> txParamsTrace = txParams->Copy (); // copy it since traced value cannot be const (because of potential underlying DynamicCasts)
   m_txSigParamsTrace (txParamsTrace);
 
+  Propagate (txParams, Seconds (0));
+}
+
+void
+MultiModelSpectrumChannel::Propagate (Ptr<SpectrumSignalParameters> txParams, Time elapsed)
+{
+  NS_LOG_FUNCTION (this << txParams << elapsed);
+
+  // the transmitters may belong to different partitions of the simulator;
+  // each receiver gets its own copy of the signal parameters
+  std::unique_lock<std::mutex> lock (m_mutex, std::defer_lock);
+  if (AtomicRefCount::IsEnabled ())
+    {
+      lock.lock ();
+    }
+
   Ptr<MobilityModel> txMobility = txParams->txPhy->GetMobility ();
   SpectrumModelUid_t txSpectrumModelUid = txParams->psd->GetSpectrumModelUid ();
   NS_LOG_LOGIC ("txSpectrumModelUid " << txSpectrumModelUid);
@@ -327,6 +350,13 @@ MultiModelSpectrumChannel::StartTx (Ptr<SpectrumSignalParameters> txParams)
                     }
                 }
 
+              delay -= elapsed;
+              if (delay.IsStrictlyNegative ())
+                {
+                  NS_LOG_WARN ("Signal propagated " << -delay << " after its arrival at the receiver");
+                  delay = Seconds (0);
+                }
+
               Ptr<NetDevice> netDev = (*rxPhyIterator)->GetDevice ();
               if (netDev)
                 {
@@ -29,6 +29,7 @@
 #include <ns3/propagation-delay-model.h>
 #include <map>
 #include <set>
+#include <mutex>
 
 namespace ns3 {
 
@@ -128,6 +129,17 @@ public:
 protected:
   void DoDispose ();
 
+  /**
+   * Propagate the given signal to all the receivers attached to this
+   * channel, except the transmitter. The propagation delay of every
+   * receiver is reduced by the given amount of time, which allows a
+   * signal to be propagated some time after the start of its transmission.
+   *
+   * \param txParams the signal parameters of the transmitter
+   * \param elapsed the time elapsed since the start of the transmission
+   */
+  void Propagate (Ptr<SpectrumSignalParameters> txParams, Time elapsed);
+
 private:
   /**
    * This method checks if m_rxSpectrumModelInfoMap contains an entry
@@ -169,6 +181,13 @@ private:
    */
   std::size_t m_numDevices;
 
+  /**
+   * Mutex serializing the transmissions and the changes of the receivers,
+   * which update the maps above, while the partitions of a
+   * MultithreadedSimulatorImpl are executed in parallel (see AtomicRefCount).
+   */
+  std::mutex m_mutex;
+
 };
 
 
@@ -25,6 +25,9 @@
 #include <ns3/log.h>
 #include <ns3/antenna-model.h>
 
+#include <algorithm>
+#include <cstring>
+
 
 namespace ns3 {
 
@@ -56,6 +59,90 @@ SpectrumSignalParameters::Copy ()
   return Create<SpectrumSignalParameters> (*this);
 }
 
+/**
+ * Get the number of consecutive values equal to the first one, up to the
+ * largest run length that can be serialized.
+ *
+ * \param it an iterator pointing to the first value of the run
+ * \param end an iterator pointing past the last value
+ * \return the length of the run
+ */
+static uint16_t
+GetRunLength (Values::const_iterator it, Values::const_iterator end)
+{
+  uint16_t length = 1;
+  for (Values::const_iterator next = it + 1;
+       next != end && *next == *it && length < 0xffff;
+       ++next)
+    {
+      length++;
+    }
+  return length;
+}
+
+uint32_t
+SpectrumSignalParameters::GetSerializedSize (void) const
+{
+  // duration and number of runs
+  uint32_t size = 8 + 4;
+  for (Values::const_iterator it = psd->ConstValuesBegin (); it != psd->ConstValuesEnd (); )
+    {
+      it += GetRunLength (it, psd->ConstValuesEnd ());
+      // run length and value
+      size += 2 + 8;
+    }
+  return size;
+}
+
+void
+SpectrumSignalParameters::Serialize (Buffer::Iterator start) const
+{
+  NS_LOG_FUNCTION (this);
+  start.WriteHtonU64 (duration.GetTimeStep ());
+
+  uint32_t nRuns = 0;
+  for (Values::const_iterator it = psd->ConstValuesBegin (); it != psd->ConstValuesEnd (); )
+    {
+      it += GetRunLength (it, psd->ConstValuesEnd ());
+      nRuns++;
+    }
+  start.WriteHtonU32 (nRuns);
+
+  for (Values::const_iterator it = psd->ConstValuesBegin (); it != psd->ConstValuesEnd (); )
+    {
+      uint16_t length = GetRunLength (it, psd->ConstValuesEnd ());
+      uint64_t value;
+      std::memcpy (&value, &(*it), sizeof (value));
+      start.WriteHtonU16 (length);
+      start.WriteHtonU64 (value);
+      it += length;
+    }
+}
+
+uint32_t
+SpectrumSignalParameters::Deserialize (Buffer::Iterator start)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ASSERT (psd);
+  Buffer::Iterator i = start;
+  duration = TimeStep (i.ReadNtohU64 ());
+
+  uint32_t nRuns = i.ReadNtohU32 ();
+  Values::iterator it = psd->ValuesBegin ();
+  for (uint32_t run = 0; run < nRuns; run++)
+    {
+      uint16_t length = i.ReadNtohU16 ();
+      uint64_t bits = i.ReadNtohU64 ();
+      double value;
+      std::memcpy (&value, &bits, sizeof (value));
+      NS_ASSERT_MSG (psd->ValuesEnd () - it >= length, "Serialized PSD does not match the SpectrumModel");
+      std::fill (it, it + length, value);
+      it += length;
+    }
+  NS_ASSERT_MSG (it == psd->ValuesEnd (), "Serialized PSD does not match the SpectrumModel");
+  return i.GetDistanceFrom (start);
+}
+
 
 
 } // namespace ns3
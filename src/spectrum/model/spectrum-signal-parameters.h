@@ -26,6 +26,7 @@
 #include <ns3/simple-ref-count.h>
 #include <ns3/ptr.h>
 #include <ns3/nstime.h>
+#include <ns3/buffer.h>
 
 
 namespace ns3 {
@@ -51,6 +52,13 @@ class AntennaModel;
  * cast) if a signal being received belongs to a given technology or not.
  *
  * \note when inheriting from this class, make sure that the assignment operator and the copy constructor work properly, making deep copies if needed.
+ *
+ * The channels give each receiver its own copy of the parameters, whose
+ * PSD is a deep copy, while the other members (e.g., the transmitting
+ * SpectrumPhy, or the PPDU of a Wi-Fi signal) are shared by the receivers.
+ * Such members must not be modified once the signal is transmitted, since
+ * the receivers may be executed by different threads (see
+ * MultithreadedSimulatorImpl).
  */
 struct SpectrumSignalParameters : public SimpleRefCount<SpectrumSignalParameters>
 {
@@ -82,6 +90,35 @@ struct SpectrumSignalParameters : public SimpleRefCount<SpectrumSignalParameters
    */
   virtual Ptr<SpectrumSignalParameters> Copy ();
 
+  /**
+   * Get the size of the serialized representation of these parameters,
+   * which is used to replicate a signal to the other systems of a
+   * distributed simulation. Each class inheriting from
+   * SpectrumSignalParameters and carrying additional data that needs
+   * to reach remote receivers should override this method, as well as
+   * Serialize and Deserialize.
+   *
+   * \return the serialized size in bytes
+   */
+  virtual uint32_t GetSerializedSize (void) const;
+  /**
+   * Serialize these parameters. The transmitting SpectrumPhy and antenna
+   * are not serialized, as they are identified by the SpectrumChannel.
+   * The PSD values are run-length encoded, hence PSDs that are constant
+   * over many bands are serialized compactly.
+   *
+   * \param start the buffer iterator to write to
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+  /**
+   * Deserialize these parameters. The psd member must have been set to a
+   * SpectrumValue defined over the SpectrumModel of the serialized PSD.
+   *
+   * \param start the buffer iterator to read from
+   * \return the number of bytes read
+   */
+  virtual uint32_t Deserialize (Buffer::Iterator start);
+
   /**
    * The Power Spectral Density of the
    * waveform, in linear units. The exact unit will depend on the
@@ -213,9 +213,10 @@ WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (uint32_t centerFreque
 
 Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
-                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr,
+                                                             uint8_t puncturedSubchannels)
 {
-  NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
+  NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr << +puncturedSubchannels);
   uint32_t bandBandwidth = 312500;
   Ptr<SpectrumValue> c = Create<SpectrumValue> (GetSpectrumModel (centerFrequency, channelWidth, bandBandwidth, guardBandwidth));
   uint32_t nGuardBands = static_cast<uint32_t> (((2 * guardBandwidth * 1e6) / bandBandwidth) + 0.5);
@@ -320,6 +321,7 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (uint32_t centerFreq
                              txPowerPerBandW, nGuardBands,
                              innerSlopeWidth, minInnerBandDbr,
                              minOuterBandDbr, lowestPointDbr);
+  PunctureSpectrumMask (c, channelWidth, bandBandwidth, nGuardBands, puncturedSubchannels);
   NormalizeSpectrumMask (c, txPowerW);
   NS_ASSERT_MSG (std::abs (txPowerW - Integral (*c)) < 1e-6, "Power allocation failed");
   return c;
@@ -327,9 +329,10 @@ WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (uint32_t centerFreq
 
 Ptr<SpectrumValue>
 WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
-                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr)
+                                                             double minInnerBandDbr, double minOuterBandDbr, double lowestPointDbr,
+                                                             uint8_t puncturedSubchannels)
 {
-  NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr);
+  NS_LOG_FUNCTION (centerFrequency << channelWidth << txPowerW << guardBandwidth << minInnerBandDbr << minOuterBandDbr << lowestPointDbr << +puncturedSubchannels);
   uint32_t bandBandwidth = 78125;
   Ptr<SpectrumValue> c = Create<SpectrumValue> (GetSpectrumModel (centerFrequency, channelWidth, bandBandwidth, guardBandwidth));
   uint32_t nGuardBands = static_cast<uint32_t> (((2 * guardBandwidth * 1e6) / bandBandwidth) + 0.5);
@@ -416,6 +419,7 @@ WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (uint32_t centerFreq
                              txPowerPerBandW, nGuardBands,
                              innerSlopeWidth, minInnerBandDbr,
                              minOuterBandDbr, lowestPointDbr);
+  PunctureSpectrumMask (c, channelWidth, bandBandwidth, nGuardBands, puncturedSubchannels);
   NormalizeSpectrumMask (c, txPowerW);
   NS_ASSERT_MSG (std::abs (txPowerW - Integral (*c)) < 1e-6, "Power allocation failed");
   return c;
@@ -634,6 +638,40 @@ WifiSpectrumValueHelper::NormalizeSpectrumMask (Ptr<SpectrumValue> c, double txP
     }
 }
 
+void
+WifiSpectrumValueHelper::PunctureSpectrumMask (Ptr<SpectrumValue> c, uint16_t channelWidth, uint32_t bandBandwidth,
+                                               uint32_t nGuardBands, uint8_t puncturedSubchannels)
+{
+  NS_LOG_FUNCTION (c << channelWidth << bandBandwidth << nGuardBands << +puncturedSubchannels);
+  if (puncturedSubchannels == 0)
+    {
+      return;
+    }
+  NS_ASSERT_MSG ((puncturedSubchannels >> (channelWidth / 20)) == 0, "Punctured subchannel out of the channel");
+  uint32_t numBands = c->GetSpectrumModel ()->GetNumBands ();
+  uint32_t numBandsPerSubchannel = static_cast<uint32_t> ((20e6 / bandBandwidth) + 0.5);
+  for (uint8_t i = 0; i < channelWidth / 20; i++)
+    {
+      if (((puncturedSubchannels >> i) & 0x01) == 0)
+        {
+          continue;
+        }
+      //same layout as the 20 MHz bands used at the receiver side
+      uint32_t start = (nGuardBands / 2) + (i * numBandsPerSubchannel);
+      if (start >= numBands / 2)
+        {
+          //step past DC
+          start += 1;
+        }
+      uint32_t stop = start + numBandsPerSubchannel - 1;
+      NS_LOG_LOGIC ("Puncture bands [" << start << ";" << stop << "]");
+      for (uint32_t j = start; j <= stop; j++)
+        {
+          (*c)[j] = 0.0;
+        }
+    }
+}
+
 double
 WifiSpectrumValueHelper::DbmToW (double dBm)
 {
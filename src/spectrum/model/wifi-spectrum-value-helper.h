@@ -112,10 +112,12 @@ public:
    * \param minInnerBandDbr the minimum relative power in the inner band (in dBr)
    * \param minOuterbandDbr the minimum relative power in the outer band (in dBr)
    * \param lowestPointDbr maximum relative power of the outermost subcarriers of the guard band (in dBr)
+   * \param puncturedSubchannels the bitmap of punctured 20 MHz subchannels (lowest frequency first)
    * \return a pointer to a newly allocated SpectrumValue representing the HT OFDM Transmit Power Spectral Density in W/Hz for each Band
    */
   static Ptr<SpectrumValue> CreateHtOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
-                                                                double minInnerBandDbr = -20, double minOuterbandDbr = -28, double lowestPointDbr = -40);
+                                                                double minInnerBandDbr = -20, double minOuterbandDbr = -28, double lowestPointDbr = -40,
+                                                                uint8_t puncturedSubchannels = 0);
 
   /**
    * Create a transmit power spectral density corresponding to OFDM
@@ -129,10 +131,12 @@ public:
    * \param minInnerBandDbr the minimum relative power in the inner band (in dBr)
    * \param minOuterbandDbr the minimum relative power in the outer band (in dBr)
    * \param lowestPointDbr maximum relative power of the outermost subcarriers of the guard band (in dBr)
+   * \param puncturedSubchannels the bitmap of punctured 20 MHz subchannels (lowest frequency first)
    * \return a pointer to a newly allocated SpectrumValue representing the HE OFDM Transmit Power Spectral Density in W/Hz for each Band
    */
   static Ptr<SpectrumValue> CreateHeOfdmTxPowerSpectralDensity (uint32_t centerFrequency, uint16_t channelWidth, double txPowerW, uint16_t guardBandwidth,
-                                                                double minInnerBandDbr = -20, double minOuterbandDbr = -28, double lowestPointDbr = -40);
+                                                                double minInnerBandDbr = -20, double minOuterbandDbr = -28, double lowestPointDbr = -40,
+                                                                uint8_t puncturedSubchannels = 0);
 
   /**
    * Create a transmit power spectral density corresponding to the OFDMA part
@@ -234,6 +238,20 @@ public:
    */
   static void NormalizeSpectrumMask (Ptr<SpectrumValue> c, double txPowerW);
 
+  /**
+   * Zero the transmit spectrum mask over the punctured 20 MHz subchannels.
+   * This should be called before NormalizeSpectrumMask so that the total
+   * transmitted power is spread over the remaining subchannels.
+   *
+   * \param c spectrumValue to puncture (in W/Hz for each band)
+   * \param channelWidth channel width (MHz)
+   * \param bandBandwidth width of each band (Hz)
+   * \param nGuardBands the number of bands in the guard band
+   * \param puncturedSubchannels the bitmap of punctured 20 MHz subchannels (lowest frequency first)
+   */
+  static void PunctureSpectrumMask (Ptr<SpectrumValue> c, uint16_t channelWidth, uint32_t bandBandwidth,
+                                    uint32_t nGuardBands, uint8_t puncturedSubchannels);
+
   /**
    * Convert from dBm to Watts.
    * Taken from wifi-utils since the original method couldn't be called from here
@@ -0,0 +1,166 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <cmath>
+#include <ns3/core-module.h>
+#include <ns3/test.h>
+#include <ns3/mobility-module.h>
+#include <ns3/propagation-loss-model.h>
+#include <ns3/spectrum-module.h>
+#include <ns3/analytical-rem-generator.h>
+
+NS_LOG_COMPONENT_DEFINE ("AnalyticalRemGeneratorTest");
+
+using namespace ns3;
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Checks the power received from each transmitter on the points of the map,
+ * with one and several threads, against the propagation loss model.
+ */
+class AnalyticalRemGeneratorTestCase : public TestCase
+{
+public:
+  AnalyticalRemGeneratorTestCase ();
+  virtual ~AnalyticalRemGeneratorTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Evaluate a point as the received power from each transmitter.
+   * \param rxPsds the received PSDs
+   * \param values the values of the point
+   */
+  static void EvaluatePoint (const std::vector<SpectrumValue> &rxPsds, std::vector<double> &values);
+};
+
+AnalyticalRemGeneratorTestCase::AnalyticalRemGeneratorTestCase ()
+  : TestCase ("Analytical REM received powers")
+{
+}
+
+AnalyticalRemGeneratorTestCase::~AnalyticalRemGeneratorTestCase ()
+{
+}
+
+void
+AnalyticalRemGeneratorTestCase::EvaluatePoint (const std::vector<SpectrumValue> &rxPsds, std::vector<double> &values)
+{
+  values.clear ();
+  for (std::vector<SpectrumValue>::const_iterator it = rxPsds.begin (); it != rxPsds.end (); ++it)
+    {
+      values.push_back (Integral (*it));
+    }
+}
+
+void
+AnalyticalRemGeneratorTestCase::DoRun (void)
+{
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+  Ptr<FriisPropagationLossModel> loss = CreateObject<FriisPropagationLossModel> ();
+  loss->SetFrequency (2.4e9);
+  channel->AddPropagationLossModel (loss);
+  // signals weaker than about 80 dB below the transmitted power are not received
+  channel->SetAttribute ("MaxLossDb", DoubleValue (80));
+
+  // transmitters of 0.1 W, the second one on the upper half of the band only
+  std::vector<double> frequencies;
+  for (uint32_t f = 0; f < 80; f++)
+    {
+      frequencies.push_back (2400.5e6 + f * 1e6);
+    }
+  Ptr<const SpectrumModel> model = Create<SpectrumModel> (frequencies);
+  double txPowerW = 0.1;
+  std::vector<Ptr<MobilityModel> > txMobility;
+  std::vector<Ptr<SpectrumValue> > txPsd;
+  for (uint32_t i = 0; i < 2; i++)
+    {
+      Ptr<MobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+      mobility->SetPosition (Vector (i * 100.0, 20.0, 1.5));
+      txMobility.push_back (mobility);
+      Ptr<SpectrumValue> psd = Create<SpectrumValue> (model);
+      uint32_t first = i * model->GetNumBands () / 2;
+      for (uint32_t b = first; b < model->GetNumBands (); b++)
+        {
+          (*psd)[b] = txPowerW / ((model->GetNumBands () - first) * 1e6);
+        }
+      txPsd.push_back (psd);
+    }
+
+  std::vector<AnalyticalRemGenerator::Point> points[2];
+  for (uint32_t t = 0; t < 2; t++)
+    {
+      AnalyticalRemGenerator generator;
+      generator.SetChannel (channel);
+      generator.SetRxSpectrumModel (model);
+      generator.SetGrid (-50.0, 150.0, 21, 0.0, 100.0, 11, 1.5);
+      generator.SetThreads (t == 0 ? 1 : 4);
+      for (uint32_t i = 0; i < 2; i++)
+        {
+          generator.AddTransmitter (txMobility[i], txPsd[i]);
+        }
+      NS_TEST_ASSERT_MSG_EQ (generator.GetNTransmitters (), 2, "Wrong number of transmitters");
+      generator.Generate (MakeCallback (&AnalyticalRemGeneratorTestCase::EvaluatePoint), points[t]);
+      NS_TEST_ASSERT_MSG_EQ (points[t].size (), 21 * 11, "Wrong number of points");
+    }
+
+  Ptr<MobilityModel> rxMobility = CreateObject<ConstantPositionMobilityModel> ();
+  uint32_t nReceived = 0;
+  uint32_t nLost = 0;
+  for (uint32_t p = 0; p < points[0].size (); p++)
+    {
+      Vector position = points[0][p].position;
+      NS_TEST_ASSERT_MSG_EQ_TOL (position.x, -50.0 + (p / 11) * 10.0, 1e-9, "Wrong x coordinate");
+      NS_TEST_ASSERT_MSG_EQ_TOL (position.y, (p % 11) * 10.0, 1e-9, "Wrong y coordinate");
+      rxMobility->SetPosition (position);
+      for (uint32_t i = 0; i < 2; i++)
+        {
+          double gainDb = loss->CalcRxPower (0, txMobility[i], rxMobility);
+          double expected = gainDb < -80 ? 0 : txPowerW * std::pow (10.0, gainDb / 10.0);
+          nReceived += expected > 0 ? 1 : 0;
+          nLost += expected > 0 ? 0 : 1;
+          NS_TEST_ASSERT_MSG_EQ_TOL (points[0][p].values[i], expected, expected * 1e-9,
+                                     "Wrong power received from transmitter " << i << " at " << position);
+          NS_TEST_ASSERT_MSG_EQ (points[1][p].values[i], points[0][p].values[i],
+                                 "Different power received with several threads at " << position);
+        }
+    }
+  // the MaxLossDb attribute applies to some but not all of the points
+  NS_TEST_ASSERT_MSG_GT (nReceived, 0, "No point received any transmitter");
+  NS_TEST_ASSERT_MSG_GT (nLost, 0, "No point beyond the MaxLossDb");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup spectrum-tests
+ *
+ * Analytical REM generator test suite
+ */
+class AnalyticalRemGeneratorTestSuite : public TestSuite
+{
+public:
+  AnalyticalRemGeneratorTestSuite ();
+};
+
+AnalyticalRemGeneratorTestSuite::AnalyticalRemGeneratorTestSuite ()
+  : TestSuite ("analytical-rem-generator", UNIT)
+{
+  AddTestCase (new AnalyticalRemGeneratorTestCase, TestCase::QUICK);
+}
+
+static AnalyticalRemGeneratorTestSuite g_analyticalRemGeneratorTestSuite; ///< the test suite
@@ -0,0 +1,258 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+
+#include "log-linear-histogram.h"
+#include "ns3/abort.h"
+#include "ns3/assert.h"
+#include "ns3/log.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("LogLinearHistogram");
+
+LogLinearHistogram::LogLinearHistogram (uint8_t precisionBits)
+  : m_precisionBits (precisionBits),
+    m_count (0),
+    m_min (0),
+    m_max (0),
+    m_sum (0)
+{
+  NS_ABORT_MSG_IF (precisionBits < 2 || precisionBits > 16,
+                   "Invalid number of precision bits: " << +precisionBits);
+}
+
+uint32_t
+LogLinearHistogram::GetBucketIndex (uint64_t value) const
+{
+  uint64_t linear = static_cast<uint64_t> (1) << m_precisionBits;
+  if (value < linear)
+    {
+      return static_cast<uint32_t> (value);
+    }
+  // position of the most significant bit
+  uint32_t msb = 0;
+  for (uint32_t step = 32; step > 0; step >>= 1)
+    {
+      if (value >> (msb + step))
+        {
+          msb += step;
+        }
+    }
+  // the buckets of [2^msb, 2^(msb+1)) are 2^shift wide
+  uint32_t shift = msb - m_precisionBits + 1;
+  uint32_t half = 1 << (m_precisionBits - 1);
+  return static_cast<uint32_t> (linear) + (shift - 1) * half
+         + static_cast<uint32_t> ((value >> shift) - half);
+}
+
+uint64_t
+LogLinearHistogram::GetBucketStart (uint32_t index) const
+{
+  uint32_t linear = 1 << m_precisionBits;
+  if (index < linear)
+    {
+      return index;
+    }
+  uint32_t half = linear >> 1;
+  uint32_t shift = (index - linear) / half + 1;
+  return static_cast<uint64_t> (half + (index - linear) % half) << shift;
+}
+
+uint64_t
+LogLinearHistogram::GetBucketWidth (uint32_t index) const
+{
+  uint32_t linear = 1 << m_precisionBits;
+  if (index < linear)
+    {
+      return 1;
+    }
+  uint32_t half = linear >> 1;
+  return static_cast<uint64_t> (1) << ((index - linear) / half + 1);
+}
+
+void
+LogLinearHistogram::AddValue (uint64_t value)
+{
+  AddValue (value, 1);
+}
+
+void
+LogLinearHistogram::AddValue (uint64_t value, uint64_t count)
+{
+  if (count == 0)
+    {
+      return;
+    }
+  uint32_t index = GetBucketIndex (value);
+  if (index >= m_counts.size ())
+    {
+      m_counts.resize (index + 1, 0);
+    }
+  m_counts[index] += count;
+  if (m_count == 0 || value < m_min)
+    {
+      m_min = value;
+    }
+  if (m_count == 0 || value > m_max)
+    {
+      m_max = value;
+    }
+  m_count += count;
+  m_sum += static_cast<double> (value) * count;
+}
+
+void
+LogLinearHistogram::Merge (const LogLinearHistogram &other)
+{
+  NS_ABORT_MSG_IF (other.m_precisionBits != m_precisionBits,
+                   "Cannot merge histograms with different precisions");
+  if (other.m_count == 0)
+    {
+      return;
+    }
+  if (other.m_counts.size () > m_counts.size ())
+    {
+      m_counts.resize (other.m_counts.size (), 0);
+    }
+  for (uint32_t i = 0; i < other.m_counts.size (); i++)
+    {
+      m_counts[i] += other.m_counts[i];
+    }
+  if (m_count == 0 || other.m_min < m_min)
+    {
+      m_min = other.m_min;
+    }
+  if (m_count == 0 || other.m_max > m_max)
+    {
+      m_max = other.m_max;
+    }
+  m_count += other.m_count;
+  m_sum += other.m_sum;
+}
+
+void
+LogLinearHistogram::Reset (void)
+{
+  m_counts.clear ();
+  m_count = 0;
+  m_min = 0;
+  m_max = 0;
+  m_sum = 0;
+}
+
+uint8_t
+LogLinearHistogram::GetPrecisionBits (void) const
+{
+  return m_precisionBits;
+}
+
+uint64_t
+LogLinearHistogram::GetCount (void) const
+{
+  return m_count;
+}
+
+uint64_t
+LogLinearHistogram::GetMin (void) const
+{
+  return m_min;
+}
+
+uint64_t
+LogLinearHistogram::GetMax (void) const
+{
+  return m_max;
+}
+
+double
+LogLinearHistogram::GetMean (void) const
+{
+  return m_count > 0 ? m_sum / m_count : 0;
+}
+
+uint64_t
+LogLinearHistogram::GetPercentile (double percentile) const
+{
+  NS_ASSERT (percentile >= 0 && percentile <= 100);
+  if (m_count == 0)
+    {
+      return 0;
+    }
+  // rank of the value at the given percentile, starting from 1
+  uint64_t rank = static_cast<uint64_t> (std::ceil (percentile / 100 * m_count));
+  rank = std::min (std::max (rank, static_cast<uint64_t> (1)), m_count);
+  uint64_t cumulated = 0;
+  for (uint32_t index = 0; index < m_counts.size (); index++)
+    {
+      cumulated += m_counts[index];
+      if (cumulated >= rank)
+        {
+          uint64_t last = GetBucketStart (index) + (GetBucketWidth (index) - 1);
+          return std::max (std::min (last, m_max), m_min);
+        }
+    }
+  return m_max;
+}
+
+uint32_t
+LogLinearHistogram::GetNBuckets (void) const
+{
+  return m_counts.size ();
+}
+
+uint64_t
+LogLinearHistogram::GetBucketCount (uint32_t index) const
+{
+  NS_ASSERT (index < m_counts.size ());
+  return m_counts[index];
+}
+
+void
+LogLinearHistogram::SerializeToXmlStream (std::ostream &os, uint16_t indent, std::string elementName) const
+{
+  os << std::string (indent, ' ') << "<" << elementName
+     << " nBins=\"" << m_counts.size () << "\""
+     << " count=\"" << m_count << "\""
+     << " min=\"" << m_min << "\""
+     << " max=\"" << m_max << "\""
+     << " mean=\"" << GetMean () << "\""
+     << " p50=\"" << GetPercentile (50) << "\""
+     << " p90=\"" << GetPercentile (90) << "\""
+     << " p99=\"" << GetPercentile (99) << "\""
+     << " p999=\"" << GetPercentile (99.9) << "\""
+     << " >\n";
+  indent += 2;
+  for (uint32_t index = 0; index < m_counts.size (); index++)
+    {
+      if (m_counts[index])
+        {
+          os << std::string (indent, ' ');
+          os << "<bin"
+             << " index=\"" << index << "\""
+             << " start=\"" << GetBucketStart (index) << "\""
+             << " width=\"" << GetBucketWidth (index) << "\""
+             << " count=\"" << m_counts[index] << "\""
+             << " />\n";
+        }
+    }
+  indent -= 2;
+  os << std::string (indent, ' ') << "</" << elementName << ">\n";
+}
+
+} // namespace ns3
@@ -0,0 +1,168 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef LOG_LINEAR_HISTOGRAM_H
+#define LOG_LINEAR_HISTOGRAM_H
+
+#include <stdint.h>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace ns3 {
+
+/**
+ * \ingroup stats
+ *
+ * \brief Histogram of unsigned integer values with log-linear buckets, in
+ * the style of the HDR histograms.
+ *
+ * The values smaller than 2^p, where p is the number of precision bits, are
+ * counted exactly. Above, each power of two interval [2^e, 2^(e+1)) is
+ * divided into 2^(p-1) buckets of equal width, hence the relative error on
+ * any value (and on the percentiles) is bounded by 2^(1-p), e.g., 1.6% with
+ * the default 7 precision bits, whatever the magnitude of the values.
+ *
+ * Adding a value takes a constant time and never moves the counts already
+ * stored. The buckets are allocated up to the largest value added, and the
+ * memory used is bounded by the number of buckets needed to represent 2^64,
+ * i.e., (66 - p) * 2^(p-1) counts, whatever the number and the range of the
+ * values (a single outlier does not make the histogram grow linearly with
+ * its value).
+ *
+ * Histograms with the same precision can be merged, e.g., to aggregate the
+ * histograms filled by different threads (each thread filling its own
+ * histogram, without synchronization) or by the replications of a
+ * simulation.
+ *
+ * Durations are typically added in nanoseconds, e.g.
+ * \code
+ *   LogLinearHistogram delays;
+ *   delays.AddValue (delay.GetNanoSeconds ());
+ *   ...
+ *   Time p99 = NanoSeconds (delays.GetPercentile (99));
+ * \endcode
+ */
+class LogLinearHistogram
+{
+public:
+  /**
+   * \brief Constructor
+   * \param precisionBits the number of bits of precision, between 2 and 16
+   */
+  LogLinearHistogram (uint8_t precisionBits = 7);
+
+  /**
+   * \brief Add a value to the histogram
+   * \param value the value to add
+   */
+  void AddValue (uint64_t value);
+  /**
+   * \brief Add several occurrences of a value to the histogram
+   * \param value the value to add
+   * \param count the number of occurrences
+   */
+  void AddValue (uint64_t value, uint64_t count);
+  /**
+   * \brief Add the values of another histogram to this histogram.
+   * \param other the histogram, which must have the same precision
+   */
+  void Merge (const LogLinearHistogram &other);
+  /**
+   * \brief Remove all the values.
+   */
+  void Reset (void);
+
+  /**
+   * \return the number of bits of precision
+   */
+  uint8_t GetPrecisionBits (void) const;
+  /**
+   * \return the number of values added
+   */
+  uint64_t GetCount (void) const;
+  /**
+   * \return the smallest value added, or 0 if none
+   */
+  uint64_t GetMin (void) const;
+  /**
+   * \return the largest value added, or 0 if none
+   */
+  uint64_t GetMax (void) const;
+  /**
+   * \return the mean of the values added, or 0 if none
+   */
+  double GetMean (void) const;
+  /**
+   * \brief Get a percentile of the values.
+   *
+   * The returned value is the largest value of the bucket holding the
+   * percentile (bounded by the largest value added), hence it is not
+   * smaller than the exact percentile and exceeds it by at most the
+   * relative error of the histogram.
+   *
+   * \param percentile the percentile, between 0 and 100
+   * \return the value at the given percentile, or 0 if no value was added
+   */
+  uint64_t GetPercentile (double percentile) const;
+
+  /**
+   * \return the number of buckets allocated
+   */
+  uint32_t GetNBuckets (void) const;
+  /**
+   * \param index the bucket index
+   * \return the smallest value counted in the bucket
+   */
+  uint64_t GetBucketStart (uint32_t index) const;
+  /**
+   * \param index the bucket index
+   * \return the width of the bucket
+   */
+  uint64_t GetBucketWidth (uint32_t index) const;
+  /**
+   * \param index the bucket index
+   * \return the number of values counted in the bucket
+   */
+  uint64_t GetBucketCount (uint32_t index) const;
+
+  /**
+   * \brief Serializes the results to an std::ostream in XML format,
+   * with the same bin elements as Histogram::SerializeToXmlStream.
+   * \param os the output stream
+   * \param indent number of spaces to use as base indentation level
+   * \param elementName name of the element to serialize.
+   */
+  void SerializeToXmlStream (std::ostream &os, uint16_t indent, std::string elementName) const;
+
+private:
+  /**
+   * \param value the value
+   * \return the index of the bucket counting the value
+   */
+  uint32_t GetBucketIndex (uint64_t value) const;
+
+  std::vector<uint64_t> m_counts; //!< Counts of the buckets
+  uint8_t m_precisionBits;        //!< Number of bits of precision
+  uint64_t m_count;               //!< Number of values
+  uint64_t m_min;                 //!< Smallest value
+  uint64_t m_max;                 //!< Largest value
+  double m_sum;                   //!< Sum of the values
+};
+
+} // namespace ns3
+
+#endif /* LOG_LINEAR_HISTOGRAM_H */
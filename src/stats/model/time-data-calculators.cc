@@ -20,6 +20,8 @@
 
 #include "ns3/log.h"
 #include "ns3/nstime.h"
+#include "ns3/boolean.h"
+#include "ns3/abort.h"
 
 #include "time-data-calculators.h"
 
@@ -34,6 +36,7 @@ TimeMinMaxAvgTotalCalculator::TimeMinMaxAvgTotalCalculator()
   NS_LOG_FUNCTION (this);
 
   m_count = 0;
+  m_enablePercentiles = false;
 }
 TimeMinMaxAvgTotalCalculator::~TimeMinMaxAvgTotalCalculator()
 {
@@ -46,7 +49,13 @@ TimeMinMaxAvgTotalCalculator::GetTypeId (void)
   static TypeId tid = TypeId ("ns3::TimeMinMaxAvgTotalCalculator")
     .SetParent<DataCalculator> ()
     .SetGroupName ("Stats")
-    .AddConstructor<TimeMinMaxAvgTotalCalculator> ();
+    .AddConstructor<TimeMinMaxAvgTotalCalculator> ()
+    .AddAttribute ("EnablePercentiles",
+                   "Whether a log-linear histogram of the values is kept to compute "
+                   "their percentiles, which are then also output.",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&TimeMinMaxAvgTotalCalculator::m_enablePercentiles),
+                   MakeBooleanChecker ());
   return tid;
 }
   
@@ -81,9 +90,19 @@ TimeMinMaxAvgTotalCalculator::Update (const Time i)
         }
       m_count++;
 
+      if (m_enablePercentiles && !i.IsNegative ()) {
+          m_histogram.AddValue (i.GetNanoSeconds ());
+        }
     }
   // end TimeMinMaxAvgTotalCalculator::Update
 }
+Time
+TimeMinMaxAvgTotalCalculator::GetPercentile (double percentile) const
+{
+  NS_LOG_FUNCTION (this << percentile);
+  NS_ABORT_MSG_UNLESS (m_enablePercentiles, "Percentiles are not enabled");
+  return NanoSeconds (m_histogram.GetPercentile (percentile));
+}
 void
 TimeMinMaxAvgTotalCalculator::Output (DataOutputCallback &callback) const
 {
@@ -95,6 +114,11 @@ TimeMinMaxAvgTotalCalculator::Output (DataOutputCallback &callback) const
       callback.OutputSingleton (m_context, m_key + "-average", Time (m_total / m_count));
       callback.OutputSingleton (m_context, m_key + "-max", m_max);
       callback.OutputSingleton (m_context, m_key + "-min", m_min);
+      if (m_enablePercentiles) {
+          callback.OutputSingleton (m_context, m_key + "-p50", GetPercentile (50));
+          callback.OutputSingleton (m_context, m_key + "-p90", GetPercentile (90));
+          callback.OutputSingleton (m_context, m_key + "-p99", GetPercentile (99));
+        }
     }
   // end TimeMinMaxAvgTotalCalculator::Output
 }
@@ -25,6 +25,7 @@
 
 #include "data-calculator.h"
 #include "data-output-interface.h"
+#include "log-linear-histogram.h"
 
 namespace ns3 {
 
@@ -56,6 +57,14 @@ public:
    */
   void Update (const Time i);
 
+  /**
+   * Get a percentile of the values, with a relative error bounded by 1.6%
+   * (see LogLinearHistogram). The EnablePercentiles attribute must be set.
+   * \param percentile the percentile, between 0 and 100
+   * \return the value at the given percentile
+   */
+  Time GetPercentile (double percentile) const;
+
   /**
    * Outputs data based on the provided callback
    * \param callback
@@ -69,6 +78,8 @@ protected:
   Time m_total;     //!< Total value of TimeMinMaxAvgTotalCalculator
   Time m_min;       //!< Minimum value of TimeMinMaxAvgTotalCalculator
   Time m_max;       //!< Maximum value of TimeMinMaxAvgTotalCalculator
+  bool m_enablePercentiles;        //!< Whether the percentiles are computed
+  LogLinearHistogram m_histogram;  //!< Histogram of the values, in nanoseconds
 
   // end class TimeMinMaxAvgTotalCalculator
 };
@@ -0,0 +1,219 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "ns3/test.h"
+#include "ns3/log-linear-histogram.h"
+#include "ns3/time-data-calculators.h"
+#include "ns3/nstime.h"
+#include "ns3/boolean.h"
+
+using namespace ns3;
+
+// ===========================================================================
+// Test case for the buckets and the percentiles of the histogram.
+// ===========================================================================
+
+class LogLinearHistogramTestCase : public TestCase
+{
+public:
+  LogLinearHistogramTestCase ();
+  virtual ~LogLinearHistogramTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LogLinearHistogramTestCase::LogLinearHistogramTestCase ()
+  : TestCase ("Log-linear histogram buckets and percentiles")
+{
+}
+
+LogLinearHistogramTestCase::~LogLinearHistogramTestCase ()
+{
+}
+
+void
+LogLinearHistogramTestCase::DoRun (void)
+{
+  LogLinearHistogram histogram (7);
+
+  // the buckets are contiguous, each value falls in a single bucket
+  histogram.AddValue (~static_cast<uint64_t> (0));
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetNBuckets (), (66 - 7) << 6, "wrong number of buckets");
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetBucketStart (0), 0, "wrong first bucket");
+  for (uint32_t i = 1; i < histogram.GetNBuckets (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (histogram.GetBucketStart (i),
+                             histogram.GetBucketStart (i - 1) + histogram.GetBucketWidth (i - 1),
+                             "buckets " << i - 1 << " and " << i << " are not contiguous");
+      // the width of a bucket is bounded by the relative precision
+      NS_TEST_ASSERT_MSG_LT_OR_EQ (histogram.GetBucketWidth (i) * 64,
+                                   std::max<uint64_t> (histogram.GetBucketStart (i), 64),
+                                   "bucket " << i << " too wide");
+    }
+  histogram.Reset ();
+  NS_TEST_ASSERT_MSG_EQ (histogram.GetNBuckets (), 0, "histogram not reset");
+
+  // the small values are counted exactly
+  for (uint64_t v = 1; v <= 100; v++)
+    {
+      histogram.AddValue (v);
+    }
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetCount (), 100, "wrong count");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetMin (), 1, "wrong min");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetMax (), 100, "wrong max");
+  NS_TEST_EXPECT_MSG_EQ_TOL (histogram.GetMean (), 50.5, 1e-12, "wrong mean");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (0), 1, "wrong p0");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (50), 50, "wrong p50");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (99), 99, "wrong p99");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (100), 100, "wrong p100");
+
+  // the percentiles of large values are within the relative precision
+  histogram.Reset ();
+  std::vector<uint64_t> values;
+  uint64_t seed = 1;
+  for (uint32_t i = 0; i < 10000; i++)
+    {
+      seed = seed * 6364136223846793005ULL + 1442695040888963407ULL;
+      // spread the values over several orders of magnitude
+      uint64_t v = (seed >> 40) << ((seed >> 8) % 24);
+      values.push_back (v);
+      histogram.AddValue (v);
+    }
+  std::sort (values.begin (), values.end ());
+  const double percentiles[] = { 1, 10, 50, 90, 99, 99.9 };
+  for (uint32_t i = 0; i < sizeof (percentiles) / sizeof (percentiles[0]); i++)
+    {
+      uint64_t exact = values[static_cast<uint32_t> (std::ceil (percentiles[i] / 100 * values.size ())) - 1];
+      uint64_t value = histogram.GetPercentile (percentiles[i]);
+      NS_TEST_EXPECT_MSG_GT_OR_EQ (value, exact, "p" << percentiles[i] << " too small");
+      NS_TEST_EXPECT_MSG_LT_OR_EQ (value - exact, exact / 64, "p" << percentiles[i] << " too large");
+    }
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetMax (), values.back (), "wrong max");
+  NS_TEST_EXPECT_MSG_EQ (histogram.GetPercentile (100), values.back (), "wrong p100");
+}
+
+// ===========================================================================
+// Test case for merging histograms.
+// ===========================================================================
+
+class LogLinearHistogramMergeTestCase : public TestCase
+{
+public:
+  LogLinearHistogramMergeTestCase ();
+  virtual ~LogLinearHistogramMergeTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+LogLinearHistogramMergeTestCase::LogLinearHistogramMergeTestCase ()
+  : TestCase ("Merge of log-linear histograms")
+{
+}
+
+LogLinearHistogramMergeTestCase::~LogLinearHistogramMergeTestCase ()
+{
+}
+
+void
+LogLinearHistogramMergeTestCase::DoRun (void)
+{
+  LogLinearHistogram all (5);
+  LogLinearHistogram first (5);
+  LogLinearHistogram second (5);
+  for (uint64_t v = 0; v < 5000; v++)
+    {
+      uint64_t value = v * v * 37;
+      all.AddValue (value);
+      (v % 3 ? first : second).AddValue (value);
+    }
+  first.Merge (second);
+  NS_TEST_ASSERT_MSG_EQ (first.GetNBuckets (), all.GetNBuckets (), "wrong number of buckets");
+  for (uint32_t i = 0; i < all.GetNBuckets (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (first.GetBucketCount (i), all.GetBucketCount (i), "wrong count of bucket " << i);
+    }
+  NS_TEST_EXPECT_MSG_EQ (first.GetCount (), all.GetCount (), "wrong count");
+  NS_TEST_EXPECT_MSG_EQ (first.GetMin (), all.GetMin (), "wrong min");
+  NS_TEST_EXPECT_MSG_EQ (first.GetMax (), all.GetMax (), "wrong max");
+  NS_TEST_EXPECT_MSG_EQ_TOL (first.GetMean (), all.GetMean (), all.GetMean () * 1e-12, "wrong mean");
+  NS_TEST_EXPECT_MSG_EQ (first.GetPercentile (99), all.GetPercentile (99), "wrong p99");
+
+  // merging into an empty histogram copies the values
+  LogLinearHistogram empty (5);
+  empty.Merge (all);
+  NS_TEST_EXPECT_MSG_EQ (empty.GetMin (), all.GetMin (), "wrong min after merge into empty histogram");
+  NS_TEST_EXPECT_MSG_EQ (empty.GetPercentile (50), all.GetPercentile (50), "wrong p50 after merge into empty histogram");
+}
+
+// ===========================================================================
+// Test case for the percentiles of the time calculator.
+// ===========================================================================
+
+class TimePercentilesTestCase : public TestCase
+{
+public:
+  TimePercentilesTestCase ();
+  virtual ~TimePercentilesTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+TimePercentilesTestCase::TimePercentilesTestCase ()
+  : TestCase ("Percentiles of the TimeMinMaxAvgTotalCalculator")
+{
+}
+
+TimePercentilesTestCase::~TimePercentilesTestCase ()
+{
+}
+
+void
+TimePercentilesTestCase::DoRun (void)
+{
+  Ptr<TimeMinMaxAvgTotalCalculator> calculator = CreateObject<TimeMinMaxAvgTotalCalculator> ();
+  calculator->SetAttribute ("EnablePercentiles", BooleanValue (true));
+  for (uint32_t i = 1; i <= 1000; i++)
+    {
+      calculator->Update (MicroSeconds (i));
+    }
+  Time p99 = calculator->GetPercentile (99);
+  NS_TEST_EXPECT_MSG_GT_OR_EQ (p99, MicroSeconds (990), "p99 too small");
+  NS_TEST_EXPECT_MSG_LT_OR_EQ (p99, NanoSeconds (999900), "p99 too large");
+  NS_TEST_EXPECT_MSG_EQ (calculator->GetPercentile (100), MicroSeconds (1000), "wrong p100");
+}
+
+class LogLinearHistogramTestSuite : public TestSuite
+{
+public:
+  LogLinearHistogramTestSuite ();
+};
+
+LogLinearHistogramTestSuite::LogLinearHistogramTestSuite ()
+  : TestSuite ("log-linear-histogram", UNIT)
+{
+  AddTestCase (new LogLinearHistogramTestCase, TestCase::QUICK);
+  AddTestCase (new LogLinearHistogramMergeTestCase, TestCase::QUICK);
+  AddTestCase (new TimePercentilesTestCase, TestCase::QUICK);
+}
+
+static LogLinearHistogramTestSuite logLinearHistogramTestSuite;
@@ -0,0 +1,241 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/double.h"
+#include "ns3/boolean.h"
+#include "ns3/config.h"
+#include "ns3/rng-seed-manager.h"
+#include "ns3/ssid.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/wifi-phy.h"
+#include "ns3/wifi-psdu.h"
+#include "ns3/yans-wifi-helper.h"
+#include "ns3/mobility-helper.h"
+#include "ns3/internet-stack-helper.h"
+#include "ns3/ipv4-address-helper.h"
+#include "ns3/packet-sink-helper.h"
+#include "ns3/on-off-helper.h"
+#include "ns3/traffic-control-helper.h"
+#include "ns3/traffic-control-layer.h"
+#include "ns3/airtime-drr-queue-disc.h"
+
+using namespace ns3;
+
+NS_LOG_COMPONENT_DEFINE ("AirtimeDrrQueueDiscWifiTest");
+
+/**
+ * \brief AirtimeDrr queue disc on a Wi-Fi access point
+ *
+ * An access point saturates a fast station, next to it, and a slow station,
+ * far from it, with downlink UDP traffic. The airtime used to transmit data
+ * frames to each station is measured at the PHY of the access point. With a
+ * FIFO queue disc, the slow station takes most of the airtime, while with an
+ * AirtimeDrr queue disc, either as root queue disc or as children of an mq
+ * queue disc, both stations get the same airtime. The data frames are
+ * aggregated in A-MPDUs addressed to a single station.
+ */
+class AirtimeDrrQueueDiscWifiTestCase : public TestCase
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param qdType the type of the queue disc installed on the access point
+   * \param mq whether the queue disc is a child of an mq queue disc
+   */
+  AirtimeDrrQueueDiscWifiTestCase (std::string qdType, bool mq);
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Callback invoked when the PHY of the access point starts transmitting a PPDU
+   *
+   * \param psdus the PSDUs of the PPDU
+   * \param txVector the TXVECTOR of the PPDU
+   * \param duration the duration of the PPDU
+   */
+  void PhyTxPsduBegin (WifiPsduMap psdus, WifiTxVector txVector, Time duration);
+
+  std::string m_qdType;                   //!< the type of the queue disc
+  bool m_mq;                              //!< whether the queue disc is a child of mq
+  Mac48Address m_stations[2];             //!< the addresses of the fast and slow stations
+  Time m_airtime[2];                      //!< the airtime used to transmit data to each station
+  uint32_t m_nPsdus[2];                   //!< the number of data PSDUs sent to each station
+  uint32_t m_nMpdus[2];                   //!< the number of data MPDUs sent to each station
+  Time m_start;                           //!< the start of the measurement
+};
+
+AirtimeDrrQueueDiscWifiTestCase::AirtimeDrrQueueDiscWifiTestCase (std::string qdType, bool mq)
+  : TestCase ("Airtime shared by a slow and a fast station with " + qdType + (mq ? " children of mq" : "")),
+    m_qdType (qdType),
+    m_mq (mq),
+    m_start (Seconds (1.5))
+{
+  for (uint8_t i = 0; i < 2; i++)
+    {
+      m_airtime[i] = Seconds (0);
+      m_nPsdus[i] = 0;
+      m_nMpdus[i] = 0;
+    }
+}
+
+void
+AirtimeDrrQueueDiscWifiTestCase::PhyTxPsduBegin (WifiPsduMap psdus, WifiTxVector txVector, Time duration)
+{
+  Ptr<const WifiPsdu> psdu = psdus.begin ()->second;
+  if (Simulator::Now () < m_start || !psdu->GetHeader (0).IsQosData ())
+    {
+      return;
+    }
+  for (uint8_t i = 0; i < 2; i++)
+    {
+      if (psdu->GetAddr1 () == m_stations[i])
+        {
+          m_airtime[i] += duration;
+          m_nPsdus[i]++;
+          m_nMpdus[i] += psdu->GetNMpdus ();
+        }
+    }
+}
+
+void
+AirtimeDrrQueueDiscWifiTestCase::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+
+  // a short device queue, so that the packets wait in the queue disc
+  Config::SetDefault ("ns3::WifiMacQueue::MaxQueueSize", QueueSizeValue (QueueSize ("30p")));
+  // the slow station must detect the preambles of the access point
+  Config::SetDefault ("ns3::ThresholdPreambleDetectionModel::Threshold", DoubleValue (4));
+
+  NodeContainer ap;
+  ap.Create (1);
+  NodeContainer stas;
+  stas.Create (2);
+
+  WifiHelper wifi;
+  wifi.SetStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+  wifi.SetRemoteStationManager ("ns3::IdealWifiManager");
+  YansWifiPhyHelper wifiPhy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper wifiChannel = YansWifiChannelHelper::Default ();
+  wifiPhy.SetChannel (wifiChannel.Create ());
+
+  WifiMacHelper wifiMac;
+  Ssid ssid = Ssid ("airtime-drr");
+  wifiMac.SetType ("ns3::ApWifiMac",
+                   "Ssid", SsidValue (ssid));
+  NetDeviceContainer apDev = wifi.Install (wifiPhy, wifiMac, ap);
+  wifiMac.SetType ("ns3::StaWifiMac",
+                   "Ssid", SsidValue (ssid));
+  NetDeviceContainer staDevs = wifi.Install (wifiPhy, wifiMac, stas);
+
+  // the fast station is next to the access point, the slow one far from it
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (40.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (ap);
+  mobility.Install (stas);
+
+  InternetStackHelper stack;
+  stack.Install (ap);
+  stack.Install (stas);
+
+  TrafficControlHelper tch;
+  if (m_mq)
+    {
+      uint16_t handle = tch.SetRootQueueDisc ("ns3::MqQueueDisc");
+      TrafficControlHelper::ClassIdList cls = tch.AddQueueDiscClasses (handle, 4, "ns3::QueueDiscClass");
+      tch.AddChildQueueDiscs (handle, cls, m_qdType);
+    }
+  else
+    {
+      tch.SetRootQueueDisc (m_qdType);
+    }
+  tch.Install (apDev);
+
+  Ipv4AddressHelper address;
+  address.SetBase ("192.168.0.0", "255.255.255.0");
+  Ipv4InterfaceContainer apInterface = address.Assign (apDev);
+  Ipv4InterfaceContainer staInterfaces = address.Assign (staDevs);
+
+  uint16_t port = 50000;
+  PacketSinkHelper sink ("ns3::UdpSocketFactory", InetSocketAddress (Ipv4Address::GetAny (), port));
+  sink.Install (stas);
+
+  for (uint8_t i = 0; i < 2; i++)
+    {
+      m_stations[i] = Mac48Address::ConvertFrom (staDevs.Get (i)->GetAddress ());
+      OnOffHelper onoff ("ns3::UdpSocketFactory", InetSocketAddress (staInterfaces.GetAddress (i), port));
+      onoff.SetConstantRate (DataRate ("100Mbps"), 1000);
+      ApplicationContainer source = onoff.Install (ap);
+      source.Start (Seconds (1.0));
+      source.Stop (Seconds (2.5));
+    }
+
+  Ptr<WifiNetDevice> apWifiDev = DynamicCast<WifiNetDevice> (apDev.Get (0));
+  apWifiDev->GetPhy ()->TraceConnectWithoutContext ("PhyTxPsduBegin",
+                                                    MakeCallback (&AirtimeDrrQueueDiscWifiTestCase::PhyTxPsduBegin, this));
+
+  Simulator::Stop (Seconds (2.5));
+  Simulator::Run ();
+
+  NS_LOG_DEBUG (m_qdType << (m_mq ? " children of mq" : "")
+                << ": fast station " << m_airtime[0].GetMicroSeconds () << "us, "
+                << m_nMpdus[0] << " MPDUs in " << m_nPsdus[0] << " PSDUs; "
+                << "slow station " << m_airtime[1].GetMicroSeconds () << "us, "
+                << m_nMpdus[1] << " MPDUs in " << m_nPsdus[1] << " PSDUs");
+
+  NS_TEST_ASSERT_MSG_GT (m_nPsdus[0], 0, "No data sent to the fast station");
+  NS_TEST_ASSERT_MSG_GT (m_nPsdus[1], 0, "No data sent to the slow station");
+  // the packets are held in the queue disc but still aggregated in A-MPDUs
+  NS_TEST_EXPECT_MSG_GT (m_nMpdus[0], 2 * m_nPsdus[0], "The MPDUs to the fast station should be aggregated");
+
+  double ratio = m_airtime[1].GetSeconds () / m_airtime[0].GetSeconds ();
+  if (m_qdType == "ns3::AirtimeDrrQueueDisc")
+    {
+      NS_TEST_EXPECT_MSG_EQ_TOL (ratio, 1, 0.2, "The stations should get the same airtime");
+      NS_TEST_EXPECT_MSG_GT (m_nMpdus[0], 2 * m_nMpdus[1], "The fast station should get more packets");
+    }
+  else
+    {
+      NS_TEST_EXPECT_MSG_GT (ratio, 2, "The slow station should get most of the airtime");
+    }
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \brief AirtimeDrr queue disc on a Wi-Fi access point Test Suite
+ */
+static class AirtimeDrrQueueDiscWifiTestSuite : public TestSuite
+{
+public:
+  AirtimeDrrQueueDiscWifiTestSuite ()
+    : TestSuite ("airtime-drr-queue-disc-wifi", SYSTEM)
+  {
+    AddTestCase (new AirtimeDrrQueueDiscWifiTestCase ("ns3::FifoQueueDisc", false), TestCase::QUICK);
+    AddTestCase (new AirtimeDrrQueueDiscWifiTestCase ("ns3::AirtimeDrrQueueDisc", false), TestCase::QUICK);
+    AddTestCase (new AirtimeDrrQueueDiscWifiTestCase ("ns3::AirtimeDrrQueueDisc", true), TestCase::QUICK);
+  }
+} g_airtimeDrrQueueDiscWifiTestSuite; ///< the test suite
@@ -33,6 +33,10 @@
 #include "ns3/udp-header.h"
 #include "ns3/string.h"
 #include "ns3/pointer.h"
+#include "ns3/boolean.h"
+#include "ns3/uinteger.h"
+#include "ns3/random-variable-stream.h"
+#include <vector>
 
 using namespace ns3;
 
@@ -513,6 +517,130 @@ FqCoDelQueueDiscUDPFlowsSeparation::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * This class tests that the lightweight mode dequeues and drops the same
+ * packets as the flow queues with child CoDel queue discs
+ */
+class FqCoDelQueueDiscLightweight : public TestCase
+{
+public:
+  FqCoDelQueueDiscLightweight ();
+  virtual ~FqCoDelQueueDiscLightweight ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Enqueue a burst of packets of random flows and sizes into both queue discs
+   */
+  void Enqueue (void);
+  /**
+   * Dequeue a packet from both queue discs and record the packets
+   */
+  void Dequeue (void);
+
+  Ptr<FqCoDelQueueDisc> m_classes;       //!< queue disc with a class per flow
+  Ptr<FqCoDelQueueDisc> m_lightweight;   //!< queue disc in the lightweight mode
+  Ptr<UniformRandomVariable> m_rng;      //!< random variable
+  std::vector<uint64_t> m_classesUids;   //!< packets dequeued by the queue disc with classes
+  std::vector<uint64_t> m_lightweightUids; //!< packets dequeued by the queue disc in the lightweight mode
+};
+
+FqCoDelQueueDiscLightweight::FqCoDelQueueDiscLightweight ()
+  : TestCase ("Test the lightweight mode against the flow queue classes")
+{
+}
+
+FqCoDelQueueDiscLightweight::~FqCoDelQueueDiscLightweight ()
+{
+}
+
+void
+FqCoDelQueueDiscLightweight::Enqueue (void)
+{
+  uint32_t burst = m_rng->GetInteger (0, 4);
+  for (uint32_t i = 0; i < burst; i++)
+    {
+      Ipv4Header hdr;
+      hdr.SetSource (Ipv4Address ("10.10.1.1"));
+      hdr.SetDestination (Ipv4Address (0x0a0a0200 + m_rng->GetInteger (1, 12)));
+      hdr.SetProtocol (7);
+      uint32_t size = m_rng->GetInteger (50, 1500);
+      hdr.SetPayloadSize (size);
+      Ptr<Packet> p = Create<Packet> (size);
+      Address dest;
+      m_classes->Enqueue (Create<Ipv4QueueDiscItem> (p, dest, 0, hdr));
+      m_lightweight->Enqueue (Create<Ipv4QueueDiscItem> (p, dest, 0, hdr));
+    }
+}
+
+void
+FqCoDelQueueDiscLightweight::Dequeue (void)
+{
+  Ptr<QueueDiscItem> item = m_classes->Dequeue ();
+  m_classesUids.push_back (item ? item->GetPacket ()->GetUid () : 0);
+  item = m_lightweight->Dequeue ();
+  m_lightweightUids.push_back (item ? item->GetPacket ()->GetUid () : 0);
+}
+
+void
+FqCoDelQueueDiscLightweight::DoRun (void)
+{
+  m_classes = CreateObjectWithAttributes<FqCoDelQueueDisc> ("MaxSize", StringValue ("200p"),
+                                                            "Flows", UintegerValue (8),
+                                                            "DropBatchSize", UintegerValue (4));
+  m_lightweight = CreateObjectWithAttributes<FqCoDelQueueDisc> ("MaxSize", StringValue ("200p"),
+                                                                "Flows", UintegerValue (8),
+                                                                "DropBatchSize", UintegerValue (4),
+                                                                "Lightweight", BooleanValue (true));
+  m_classes->SetQuantum (1500);
+  m_lightweight->SetQuantum (1500);
+  m_classes->Initialize ();
+  m_lightweight->Initialize ();
+  m_rng = CreateObject<UniformRandomVariable> ();
+  m_rng->SetStream (1);
+
+  // the packets arrive faster than they are dequeued for the first 3 seconds,
+  // so that CoDel drops packets and the queue discs overflow, then the
+  // arrival rate decreases
+  for (uint32_t i = 0; i < 5000; i++)
+    {
+      Simulator::Schedule (MilliSeconds (i), &FqCoDelQueueDiscLightweight::Enqueue, this);
+      if (i >= 3000)
+        {
+          Simulator::Schedule (MilliSeconds (i) + MicroSeconds (300), &FqCoDelQueueDiscLightweight::Dequeue, this);
+        }
+      Simulator::Schedule (MilliSeconds (i) + MicroSeconds (500), &FqCoDelQueueDiscLightweight::Dequeue, this);
+    }
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_lightweightUids.size (), m_classesUids.size (), "unexpected number of dequeue operations");
+  for (uint32_t i = 0; i < m_classesUids.size (); i++)
+    {
+      NS_TEST_ASSERT_MSG_EQ (m_lightweightUids[i], m_classesUids[i], "different packet at dequeue operation " << i);
+    }
+
+  QueueDisc::Stats classesStats = m_classes->GetStats ();
+  QueueDisc::Stats lightweightStats = m_lightweight->GetStats ();
+  NS_TEST_ASSERT_MSG_GT (classesStats.GetNDroppedPackets (FqCoDelQueueDisc::OVERLIMIT_DROP), 0,
+                         "the queue disc should have overflowed");
+  NS_TEST_ASSERT_MSG_EQ (lightweightStats.GetNDroppedPackets (FqCoDelQueueDisc::OVERLIMIT_DROP),
+                         classesStats.GetNDroppedPackets (FqCoDelQueueDisc::OVERLIMIT_DROP),
+                         "different number of packets dropped from the fat flow");
+  std::string targetExceeded = std::string (QueueDisc::CHILD_QUEUE_DISC_DROP) + "Target exceeded drop";
+  NS_TEST_ASSERT_MSG_GT (classesStats.GetNDroppedPackets (targetExceeded), 0,
+                         "CoDel should have dropped packets");
+  NS_TEST_ASSERT_MSG_EQ (lightweightStats.GetNDroppedPackets (targetExceeded),
+                         classesStats.GetNDroppedPackets (targetExceeded),
+                         "different number of packets dropped by CoDel");
+  NS_TEST_ASSERT_MSG_EQ (lightweightStats.nTotalDroppedPackets, classesStats.nTotalDroppedPackets,
+                         "different number of dropped packets");
+  NS_TEST_ASSERT_MSG_EQ (m_lightweight->GetNPackets (), m_classes->GetNPackets (),
+                         "different number of packets in the queue discs");
+  NS_TEST_ASSERT_MSG_EQ (m_lightweight->GetNQueueDiscClasses (), 0, "no class should have been created");
+
+  Simulator::Destroy ();
+}
+
 class FqCoDelQueueDiscTestSuite : public TestSuite
 {
 public:
@@ -527,6 +655,7 @@ FqCoDelQueueDiscTestSuite::FqCoDelQueueDiscTestSuite ()
   AddTestCase (new FqCoDelQueueDiscDeficit, TestCase::QUICK);
   AddTestCase (new FqCoDelQueueDiscTCPFlowsSeparation, TestCase::QUICK);
   AddTestCase (new FqCoDelQueueDiscUDPFlowsSeparation, TestCase::QUICK);
+  AddTestCase (new FqCoDelQueueDiscLightweight, TestCase::QUICK);
 }
 
 static FqCoDelQueueDiscTestSuite fqCoDelQueueDiscTestSuite;
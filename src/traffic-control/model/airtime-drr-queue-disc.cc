@@ -0,0 +1,401 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/string.h"
+#include "ns3/net-device.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/queue.h"
+#include "airtime-drr-queue-disc.h"
+#include <algorithm>
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("AirtimeDrrQueueDisc");
+
+NS_OBJECT_ENSURE_REGISTERED (AirtimeDrrStation);
+
+TypeId AirtimeDrrStation::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AirtimeDrrStation")
+    .SetParent<QueueDiscClass> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<AirtimeDrrStation> ()
+  ;
+  return tid;
+}
+
+AirtimeDrrStation::AirtimeDrrStation ()
+  : m_deficit (Seconds (0)),
+    m_active (false),
+    m_pendingBytes (0),
+    m_pendingAirtime (Seconds (0)),
+    m_lastTxBytes (0),
+    m_lastTxAirtime (Seconds (0))
+{
+  NS_LOG_FUNCTION (this);
+}
+
+AirtimeDrrStation::~AirtimeDrrStation ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+AirtimeDrrStation::SetDeficit (Time deficit)
+{
+  NS_LOG_FUNCTION (this << deficit);
+  m_deficit = deficit;
+}
+
+Time
+AirtimeDrrStation::GetDeficit (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_deficit;
+}
+
+void
+AirtimeDrrStation::IncreaseDeficit (Time deficit)
+{
+  NS_LOG_FUNCTION (this << deficit);
+  m_deficit += deficit;
+}
+
+Time
+AirtimeDrrStation::EstimateAirtime (uint32_t size) const
+{
+  NS_LOG_FUNCTION (this << size);
+  if (m_lastTxBytes == 0)
+    {
+      return Seconds (0);
+    }
+  return m_lastTxAirtime * static_cast<int64_t> (size) / static_cast<int64_t> (m_lastTxBytes);
+}
+
+void
+AirtimeDrrStation::ChargeEstimate (uint32_t size, Time airtime)
+{
+  NS_LOG_FUNCTION (this << size << airtime);
+  m_deficit -= airtime;
+  m_pendingBytes += size;
+  m_pendingAirtime += airtime;
+}
+
+void
+AirtimeDrrStation::ChargeAirtime (uint32_t size, Time airtime)
+{
+  NS_LOG_FUNCTION (this << size << airtime);
+  // refund the estimate charged for the transmitted bytes. Retransmitted
+  // bytes were already reconciled, hence they are charged in full
+  uint32_t reconciled = std::min (size, m_pendingBytes);
+  if (reconciled > 0)
+    {
+      Time estimate = m_pendingAirtime * static_cast<int64_t> (reconciled)
+                      / static_cast<int64_t> (m_pendingBytes);
+      m_deficit += estimate;
+      m_pendingAirtime -= estimate;
+      m_pendingBytes -= reconciled;
+    }
+  m_deficit -= airtime;
+  if (size > 0)
+    {
+      m_lastTxBytes = size;
+      m_lastTxAirtime = airtime;
+    }
+}
+
+void
+AirtimeDrrStation::SetActive (bool active)
+{
+  NS_LOG_FUNCTION (this << active);
+  m_active = active;
+}
+
+bool
+AirtimeDrrStation::IsActive (void) const
+{
+  NS_LOG_FUNCTION (this);
+  return m_active;
+}
+
+
+NS_OBJECT_ENSURE_REGISTERED (AirtimeDrrQueueDisc);
+
+TypeId AirtimeDrrQueueDisc::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::AirtimeDrrQueueDisc")
+    .SetParent<QueueDisc> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<AirtimeDrrQueueDisc> ()
+    .AddAttribute ("Interval",
+                   "The CoDel algorithm interval for each station queue",
+                   StringValue ("100ms"),
+                   MakeStringAccessor (&AirtimeDrrQueueDisc::m_interval),
+                   MakeStringChecker ())
+    .AddAttribute ("Target",
+                   "The CoDel algorithm target queue delay for each station queue",
+                   StringValue ("5ms"),
+                   MakeStringAccessor (&AirtimeDrrQueueDisc::m_target),
+                   MakeStringChecker ())
+    .AddAttribute ("MaxSize",
+                   "The maximum number of packets accepted by this queue disc",
+                   QueueSizeValue (QueueSize ("1000p")),
+                   MakeQueueSizeAccessor (&QueueDisc::SetMaxSize,
+                                          &QueueDisc::GetMaxSize),
+                   MakeQueueSizeChecker ())
+    .AddAttribute ("Quantum",
+                   "The airtime deficit given to a station at each round",
+                   TimeValue (MicroSeconds (300)),
+                   MakeTimeAccessor (&AirtimeDrrQueueDisc::m_quantum),
+                   MakeTimeChecker ())
+  ;
+  return tid;
+}
+
+AirtimeDrrQueueDisc::AirtimeDrrQueueDisc ()
+  : QueueDisc (QueueDiscSizePolicy::MULTIPLE_QUEUES, QueueSizeUnit::PACKETS)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+AirtimeDrrQueueDisc::~AirtimeDrrQueueDisc ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+AirtimeDrrQueueDisc::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (m_device)
+    {
+      m_device->TraceDisconnectWithoutContext ("TxAirtime", MakeCallback (&AirtimeDrrQueueDisc::NotifyTxAirtime, this));
+      m_device = 0;
+    }
+  m_activeStations.clear ();
+  m_txQueues.clear ();
+  QueueDisc::DoDispose ();
+}
+
+void
+AirtimeDrrQueueDisc::NotifyTxAirtime (Mac48Address station, uint8_t txQueue, uint32_t size, Time airtime)
+{
+  NS_LOG_FUNCTION (this << station << +txQueue << size << airtime);
+
+  // the children of an mq queue disc are only charged the airtime used by
+  // their own transmission queue
+  if (m_txQueues.find (txQueue) == m_txQueues.end ())
+    {
+      NS_LOG_DEBUG ("Transmission queue " << +txQueue << " not served by this queue disc");
+      return;
+    }
+  ReportAirtime (station, size, airtime);
+}
+
+void
+AirtimeDrrQueueDisc::ReportAirtime (Mac48Address station, uint32_t size, Time airtime)
+{
+  NS_LOG_FUNCTION (this << station << size << airtime);
+
+  std::map<Mac48Address, uint32_t>::const_iterator it = m_stationsIndices.find (station);
+  if (it == m_stationsIndices.end ())
+    {
+      NS_LOG_DEBUG ("No queue for station " << station);
+      return;
+    }
+  Ptr<AirtimeDrrStation> qdClass = StaticCast<AirtimeDrrStation> (GetQueueDiscClass (it->second));
+  qdClass->ChargeAirtime (size, airtime);
+}
+
+bool
+AirtimeDrrQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
+{
+  NS_LOG_FUNCTION (this << item);
+
+  m_txQueues.insert (item->GetTxQueueIndex ());
+
+  Ptr<AirtimeDrrStation> station;
+  // the addresses resolved by ARP have no type, hence the stations are
+  // identified by their MAC address to match the airtime reports
+  Mac48Address address = Mac48Address::ConvertFrom (item->GetAddress ());
+  std::map<Mac48Address, uint32_t>::const_iterator it = m_stationsIndices.find (address);
+  if (it == m_stationsIndices.end ())
+    {
+      NS_LOG_DEBUG ("Creating a new station queue for " << address);
+      station = m_stationFactory.Create<AirtimeDrrStation> ();
+      Ptr<QueueDisc> qd = m_queueDiscFactory.Create<QueueDisc> ();
+      qd->Initialize ();
+      station->SetQueueDisc (qd);
+      station->SetDeficit (m_quantum);
+      AddQueueDiscClass (station);
+
+      m_stationsIndices[address] = GetNQueueDiscClasses () - 1;
+    }
+  else
+    {
+      station = StaticCast<AirtimeDrrStation> (GetQueueDiscClass (it->second));
+    }
+
+  // a station keeps its deficit while inactive, so that the airtime reported
+  // after its last packet is dequeued is reconciled too
+  if (!station->IsActive ())
+    {
+      station->SetActive (true);
+      m_activeStations.push_back (station);
+    }
+
+  bool retval = station->GetQueueDisc ()->Enqueue (item);
+
+  // the slow stations would otherwise fill the queue disc and starve the
+  // fast ones
+  if (GetCurrentSize () > GetMaxSize ())
+    {
+      AirtimeDrrDrop ();
+    }
+
+  return retval;
+}
+
+void
+AirtimeDrrQueueDisc::AirtimeDrrDrop (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t maxBacklog = 0, index = 0;
+  for (uint32_t i = 0; i < GetNQueueDiscClasses (); i++)
+    {
+      uint32_t bytes = GetQueueDiscClass (i)->GetQueueDisc ()->GetNBytes ();
+      if (bytes > maxBacklog)
+        {
+          maxBacklog = bytes;
+          index = i;
+        }
+    }
+
+  NS_LOG_LOGIC ("Queue disc limit exceeded -- dropping a packet of the station with the largest backlog");
+  Ptr<QueueDiscItem> item = GetQueueDiscClass (index)->GetQueueDisc ()->GetInternalQueue (0)->Dequeue ();
+  DropAfterDequeue (item, LIMIT_EXCEEDED_DROP);
+}
+
+Ptr<QueueDiscItem>
+AirtimeDrrQueueDisc::DoDequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<AirtimeDrrStation> station;
+  Ptr<QueueDiscItem> item;
+
+  do
+    {
+      bool found = false;
+
+      while (!found && !m_activeStations.empty ())
+        {
+          station = m_activeStations.front ();
+
+          if (!station->GetDeficit ().IsStrictlyPositive ())
+            {
+              station->IncreaseDeficit (m_quantum);
+              m_activeStations.push_back (station);
+              m_activeStations.pop_front ();
+            }
+          else
+            {
+              NS_LOG_DEBUG ("Found a station with positive deficit");
+              found = true;
+            }
+        }
+
+      if (!found)
+        {
+          NS_LOG_DEBUG ("No station found to dequeue a packet");
+          return 0;
+        }
+
+      item = station->GetQueueDisc ()->Dequeue ();
+
+      if (!item)
+        {
+          NS_LOG_DEBUG ("Could not get a packet from the selected station queue");
+          station->SetActive (false);
+          m_activeStations.pop_front ();
+        }
+    } while (item == 0);
+
+  station->ChargeEstimate (item->GetSize (), station->EstimateAirtime (item->GetSize ()));
+
+  return item;
+}
+
+bool
+AirtimeDrrQueueDisc::CheckConfig (void)
+{
+  NS_LOG_FUNCTION (this);
+  if (GetNQueueDiscClasses () > 0)
+    {
+      NS_LOG_ERROR ("AirtimeDrrQueueDisc cannot have classes");
+      return false;
+    }
+
+  if (GetNInternalQueues () > 0)
+    {
+      NS_LOG_ERROR ("AirtimeDrrQueueDisc cannot have internal queues");
+      return false;
+    }
+
+  if (!m_quantum.IsStrictlyPositive ())
+    {
+      NS_LOG_ERROR ("The quantum must be positive");
+      return false;
+    }
+
+  // we are at initialization time. Connect to the device reporting the
+  // airtime used to transmit to each station. The children of an mq queue
+  // disc are attached to the device too
+  Ptr<NetDeviceQueueInterface> ndqi = GetNetDeviceQueueInterface ();
+  if (ndqi)
+    {
+      Ptr<NetDevice> dev = ndqi->GetObject<NetDevice> ();
+      if (!dev || !dev->TraceConnectWithoutContext ("TxAirtime", MakeCallback (&AirtimeDrrQueueDisc::NotifyTxAirtime, this)))
+        {
+          NS_LOG_ERROR ("The device does not report the airtime of the stations");
+          return false;
+        }
+      m_device = dev;
+    }
+  else
+    {
+      NS_LOG_WARN ("No device attached: the airtime must be reported through ReportAirtime");
+    }
+
+  return true;
+}
+
+void
+AirtimeDrrQueueDisc::InitializeParams (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  m_stationFactory.SetTypeId ("ns3::AirtimeDrrStation");
+
+  m_queueDiscFactory.SetTypeId ("ns3::CoDelQueueDisc");
+  m_queueDiscFactory.Set ("MaxSize", QueueSizeValue (GetMaxSize ()));
+  m_queueDiscFactory.Set ("Interval", StringValue (m_interval));
+  m_queueDiscFactory.Set ("Target", StringValue (m_target));
+}
+
+} // namespace ns3
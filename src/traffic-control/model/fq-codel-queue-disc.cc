@@ -21,6 +21,7 @@
 
 #include "ns3/log.h"
 #include "ns3/string.h"
+#include "ns3/boolean.h"
 #include "ns3/queue.h"
 #include "fq-codel-queue-disc.h"
 #include "codel-queue-disc.h"
@@ -30,6 +31,52 @@ namespace ns3 {
 
 NS_LOG_COMPONENT_DEFINE ("FqCoDelQueueDisc");
 
+/**
+ * Returns the current time translated in CoDel time representation
+ * \return the current time
+ */
+static uint32_t CoDelGetTime (void)
+{
+  return static_cast<uint32_t> (Simulator::Now ().GetNanoSeconds () >> CODEL_SHIFT);
+}
+
+/**
+ * Check if CoDel time a is successive to b
+ * \param a left operand
+ * \param b right operand
+ * \return true if a is greater than b
+ */
+static inline bool CoDelTimeAfter (uint32_t a, uint32_t b)
+{
+  return ((int)(a) - (int)(b) > 0);
+}
+
+/**
+ * Check if CoDel time a is successive or equal to b
+ * \param a left operand
+ * \param b right operand
+ * \return true if a is greater than or equal to b
+ */
+static inline bool CoDelTimeAfterEq (uint32_t a, uint32_t b)
+{
+  return ((int)(a) - (int)(b) >= 0);
+}
+
+/**
+ * Check if CoDel time a is preceding b
+ * \param a left operand
+ * \param b right operand
+ * \return true if a is less than to b
+ */
+static inline bool CoDelTimeBefore (uint32_t a, uint32_t b)
+{
+  return ((int)(a) - (int)(b) < 0);
+}
+
+/// Minimum bytes in a flow queue to allow a CoDel drop in the lightweight
+/// mode, as the default MinBytes of CoDelQueueDisc
+static const uint32_t CODEL_MIN_BYTES = 1500;
+
 NS_OBJECT_ENSURE_REGISTERED (FqCoDelFlow);
 
 TypeId FqCoDelFlow::GetTypeId (void)
@@ -129,15 +176,30 @@ TypeId FqCoDelQueueDisc::GetTypeId (void)
                    UintegerValue (0),
                    MakeUintegerAccessor (&FqCoDelQueueDisc::m_perturbation),
                    MakeUintegerChecker<uint32_t> ())
+    .AddAttribute ("Lightweight",
+                   "Whether to keep the flow queues in an array pre-allocated at initialization "
+                   "time, with inline CoDel state, instead of creating a class with a child "
+                   "CoDel queue disc for each flow",
+                   BooleanValue (false),
+                   MakeBooleanAccessor (&FqCoDelQueueDisc::m_lightweight),
+                   MakeBooleanChecker ())
   ;
   return tid;
 }
 
 FqCoDelQueueDisc::FqCoDelQueueDisc ()
   : QueueDisc (QueueDiscSizePolicy::MULTIPLE_QUEUES, QueueSizeUnit::PACKETS),
-    m_quantum (0)
+    m_quantum (0),
+    m_freeSlot (NO_INDEX),
+    m_nUsedFlows (0),
+    m_codelInterval (0),
+    m_codelTarget (0),
+    m_targetExceededDropMsg (std::string (CHILD_QUEUE_DISC_DROP) + CoDelQueueDisc::TARGET_EXCEEDED_DROP),
+    m_overlimitDropMsg (std::string (CHILD_QUEUE_DISC_DROP) + CoDelQueueDisc::OVERLIMIT_DROP)
 {
   NS_LOG_FUNCTION (this);
+  m_newFlowList.head = m_newFlowList.tail = NO_INDEX;
+  m_oldFlowList.head = m_oldFlowList.tail = NO_INDEX;
 }
 
 FqCoDelQueueDisc::~FqCoDelQueueDisc ()
@@ -145,6 +207,18 @@ FqCoDelQueueDisc::~FqCoDelQueueDisc ()
   NS_LOG_FUNCTION (this);
 }
 
+void
+FqCoDelQueueDisc::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_flowStates.clear ();
+  m_packetSlots.clear ();
+  m_freeSlot = NO_INDEX;
+  m_newFlowList.head = m_newFlowList.tail = NO_INDEX;
+  m_oldFlowList.head = m_oldFlowList.tail = NO_INDEX;
+  QueueDisc::DoDispose ();
+}
+
 void
 FqCoDelQueueDisc::SetQuantum (uint32_t quantum)
 {
@@ -185,6 +259,18 @@ FqCoDelQueueDisc::DoEnqueue (Ptr<QueueDiscItem> item)
         }
     }
 
+  if (m_lightweight)
+    {
+      bool retval = FlowArrayEnqueue (h, item);
+
+      if (GetCurrentSize () > GetMaxSize ())
+        {
+          FlowArrayDrop ();
+        }
+
+      return retval;
+    }
+
   Ptr<FqCoDelFlow> flow;
   if (m_flowsIndices.find (h) == m_flowsIndices.end ())
     {
@@ -226,6 +312,11 @@ FqCoDelQueueDisc::DoDequeue (void)
 {
   NS_LOG_FUNCTION (this);
 
+  if (m_lightweight)
+    {
+      return FlowArrayDequeue ();
+    }
+
   Ptr<FqCoDelFlow> flow;
   Ptr<QueueDiscItem> item;
 
@@ -353,6 +444,35 @@ FqCoDelQueueDisc::InitializeParams (void)
   m_queueDiscFactory.Set ("MaxSize", QueueSizeValue (GetMaxSize ()));
   m_queueDiscFactory.Set ("Interval", StringValue (m_interval));
   m_queueDiscFactory.Set ("Target", StringValue (m_target));
+
+  if (m_lightweight)
+    {
+      m_codelInterval = static_cast<uint32_t> (Time (m_interval).GetNanoSeconds () >> CODEL_SHIFT);
+      m_codelTarget = static_cast<uint32_t> (Time (m_target).GetNanoSeconds () >> CODEL_SHIFT);
+
+      FlowState flow;
+      flow.head = flow.tail = NO_INDEX;
+      flow.nPackets = flow.nBytes = 0;
+      flow.deficit = 0;
+      flow.status = FqCoDelFlow::INACTIVE;
+      flow.next = NO_INDEX;
+      flow.order = NO_INDEX;
+      flow.count = flow.lastCount = 0;
+      flow.dropping = false;
+      flow.recInvSqrt = ~0U >> REC_INV_SQRT_SHIFT;
+      flow.firstAboveTime = flow.dropNext = 0;
+      m_flowStates.assign (m_flows, flow);
+
+      // the queue disc may exceed its limit by one packet before dropping
+      // from the fat flow. More slots are added if the limit is raised later
+      uint32_t nSlots = GetMaxSize ().GetValue () + 1;
+      m_packetSlots.resize (nSlots);
+      for (uint32_t i = 0; i < nSlots; i++)
+        {
+          m_packetSlots[i].next = (i + 1 < nSlots ? i + 1 : NO_INDEX);
+        }
+      m_freeSlot = 0;
+    }
 }
 
 uint32_t
@@ -390,4 +510,391 @@ FqCoDelQueueDisc::FqCoDelDrop (void)
   return index;
 }
 
+bool
+FqCoDelQueueDisc::FlowArrayEnqueue (uint32_t h, Ptr<QueueDiscItem> item)
+{
+  NS_LOG_FUNCTION (this << h << item);
+
+  FlowState &flow = m_flowStates[h];
+  if (flow.order == NO_INDEX)
+    {
+      NS_LOG_DEBUG ("First packet of the flow queue with index " << h);
+      flow.order = m_nUsedFlows++;
+    }
+
+  if (flow.status == FqCoDelFlow::INACTIVE)
+    {
+      flow.status = FqCoDelFlow::NEW_FLOW;
+      flow.deficit = m_quantum;
+      PushFlow (m_newFlowList, h);
+    }
+
+  // the flow queue has the same limit as the queue disc, as the child
+  // CoDel queue discs of the classes
+  if (flow.nPackets + 1 > GetMaxSize ().GetValue ())
+    {
+      NS_LOG_LOGIC ("Flow queue full -- dropping pkt");
+      DropBeforeEnqueue (item, m_overlimitDropMsg.c_str ());
+      return false;
+    }
+
+  uint32_t slot = m_freeSlot;
+  if (slot == NO_INDEX)
+    {
+      slot = m_packetSlots.size ();
+      m_packetSlots.push_back (PacketSlot ());
+    }
+  else
+    {
+      m_freeSlot = m_packetSlots[slot].next;
+    }
+  m_packetSlots[slot].item = item;
+  m_packetSlots[slot].next = NO_INDEX;
+
+  if (flow.tail == NO_INDEX)
+    {
+      flow.head = slot;
+    }
+  else
+    {
+      m_packetSlots[flow.tail].next = slot;
+    }
+  flow.tail = slot;
+  flow.nPackets++;
+  flow.nBytes += item->GetSize ();
+
+  // the packet is timestamped here, as done by the child queue discs, because
+  // it may be dropped from the fat flow before this queue disc returns
+  item->SetTimeStamp (Simulator::Now ());
+  PacketEnqueued (item);
+
+  NS_LOG_DEBUG ("Packet enqueued into flow " << h);
+  return true;
+}
+
+Ptr<QueueDiscItem>
+FqCoDelQueueDisc::FlowArrayDequeue (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t index = NO_INDEX;
+  Ptr<QueueDiscItem> item;
+
+  do
+    {
+      bool found = false;
+
+      while (!found && m_newFlowList.head != NO_INDEX)
+        {
+          index = m_newFlowList.head;
+          FlowState &flow = m_flowStates[index];
+
+          if (flow.deficit <= 0)
+            {
+              flow.deficit += m_quantum;
+              flow.status = FqCoDelFlow::OLD_FLOW;
+              PopFlow (m_newFlowList);
+              PushFlow (m_oldFlowList, index);
+            }
+          else
+            {
+              NS_LOG_DEBUG ("Found a new flow with positive deficit");
+              found = true;
+            }
+        }
+
+      while (!found && m_oldFlowList.head != NO_INDEX)
+        {
+          index = m_oldFlowList.head;
+          FlowState &flow = m_flowStates[index];
+
+          if (flow.deficit <= 0)
+            {
+              flow.deficit += m_quantum;
+              PopFlow (m_oldFlowList);
+              PushFlow (m_oldFlowList, index);
+            }
+          else
+            {
+              NS_LOG_DEBUG ("Found an old flow with positive deficit");
+              found = true;
+            }
+        }
+
+      if (!found)
+        {
+          NS_LOG_DEBUG ("No flow found to dequeue a packet");
+          return 0;
+        }
+
+      FlowState &flow = m_flowStates[index];
+      item = CoDelDequeue (flow);
+
+      if (!item)
+        {
+          NS_LOG_DEBUG ("Could not get a packet from the selected flow queue");
+          if (m_newFlowList.head != NO_INDEX)
+            {
+              flow.status = FqCoDelFlow::OLD_FLOW;
+              PopFlow (m_newFlowList);
+              PushFlow (m_oldFlowList, index);
+            }
+          else
+            {
+              flow.status = FqCoDelFlow::INACTIVE;
+              PopFlow (m_oldFlowList);
+            }
+        }
+      else
+        {
+          NS_LOG_DEBUG ("Dequeued packet " << item->GetPacket ());
+        }
+    } while (item == 0);
+
+  m_flowStates[index].deficit -= item->GetSize ();
+
+  return item;
+}
+
+uint32_t
+FqCoDelQueueDisc::FlowArrayDrop (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  uint32_t maxBacklog = 0, index = NO_INDEX;
+
+  /* Queue is full! Find the fat flow and drop packet(s) from it. Only the
+   * active flows may have a backlog. Ties are broken in favor of the flow
+   * which received its first packet first, as done with the classes */
+  for (const FlowList *list : {&m_newFlowList, &m_oldFlowList})
+    {
+      for (uint32_t i = list->head; i != NO_INDEX; i = m_flowStates[i].next)
+        {
+          const FlowState &flow = m_flowStates[i];
+          if (flow.nBytes > maxBacklog
+              || (flow.nBytes == maxBacklog && index != NO_INDEX
+                  && flow.order < m_flowStates[index].order))
+            {
+              maxBacklog = flow.nBytes;
+              index = i;
+            }
+        }
+    }
+
+  if (index == NO_INDEX)
+    {
+      return 0;
+    }
+
+  /* Our goal is to drop half of this fat flow backlog */
+  uint32_t len = 0, count = 0, threshold = maxBacklog >> 1;
+  FlowState &flow = m_flowStates[index];
+  Ptr<QueueDiscItem> item;
+
+  do
+    {
+      item = PopPacket (flow);
+      DropAfterDequeue (item, OVERLIMIT_DROP);
+      len += item->GetSize ();
+    } while (++count < m_dropBatchSize && len < threshold && flow.head != NO_INDEX);
+
+  return index;
+}
+
+Ptr<QueueDiscItem>
+FqCoDelQueueDisc::PopPacket (FlowState &flow)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (flow.head == NO_INDEX)
+    {
+      return 0;
+    }
+
+  uint32_t slot = flow.head;
+  Ptr<QueueDiscItem> item = m_packetSlots[slot].item;
+  m_packetSlots[slot].item = 0;
+  flow.head = m_packetSlots[slot].next;
+  if (flow.head == NO_INDEX)
+    {
+      flow.tail = NO_INDEX;
+    }
+  m_packetSlots[slot].next = m_freeSlot;
+  m_freeSlot = slot;
+
+  flow.nPackets--;
+  flow.nBytes -= item->GetSize ();
+  PacketDequeued (item);
+  return item;
+}
+
+Ptr<QueueDiscItem>
+FqCoDelQueueDisc::CoDelDequeue (FlowState &flow)
+{
+  NS_LOG_FUNCTION (this);
+
+  Ptr<QueueDiscItem> item = PopPacket (flow);
+  if (!item)
+    {
+      // Leave dropping state when queue is empty
+      flow.dropping = false;
+      NS_LOG_LOGIC ("Queue empty");
+      return 0;
+    }
+  uint32_t now = CoDelGetTime ();
+
+  // Determine if item should be dropped
+  bool okToDrop = CoDelOkToDrop (flow, item, now);
+
+  if (flow.dropping)
+    {
+      if (!okToDrop)
+        {
+          /* sojourn time fell below target - leave dropping state */
+          flow.dropping = false;
+        }
+      else if (CoDelTimeAfterEq (now, flow.dropNext))
+        {
+          while (flow.dropping && CoDelTimeAfterEq (now, flow.dropNext))
+            {
+              // It's time for the next drop. Drop the current packet and
+              // dequeue the next. The dequeue might take us out of dropping
+              // state. If not, schedule the next drop.
+              NS_LOG_LOGIC ("Sojourn time is still above target and it's time for next drop; dropping " << item);
+              DropAfterDequeue (item, m_targetExceededDropMsg.c_str ());
+
+              ++flow.count;
+              CoDelNewtonStep (flow);
+              item = PopPacket (flow);
+
+              if (!CoDelOkToDrop (flow, item, now))
+                {
+                  /* leave dropping state */
+                  flow.dropping = false;
+                }
+              else
+                {
+                  /* schedule the next drop */
+                  flow.dropNext = CoDelControlLaw (flow, flow.dropNext);
+                }
+            }
+        }
+    }
+  else if (okToDrop)
+    {
+      // Drop the first packet and enter dropping state unless the queue is empty
+      NS_LOG_LOGIC ("Sojourn time goes above target, dropping the first packet " << item << " and entering the dropping state");
+      DropAfterDequeue (item, m_targetExceededDropMsg.c_str ());
+
+      item = PopPacket (flow);
+
+      CoDelOkToDrop (flow, item, now);
+      flow.dropping = true;
+      /*
+       * if min went above target close to when we last went below it
+       * assume that the drop rate that controlled the queue on the
+       * last cycle is a good starting point to control it now.
+       */
+      int delta = flow.count - flow.lastCount;
+      if (delta > 1 && CoDelTimeBefore (now - flow.dropNext, 16 * m_codelInterval))
+        {
+          flow.count = delta;
+          CoDelNewtonStep (flow);
+        }
+      else
+        {
+          flow.count = 1;
+          flow.recInvSqrt = ~0U >> REC_INV_SQRT_SHIFT;
+        }
+      flow.lastCount = flow.count;
+      flow.dropNext = CoDelControlLaw (flow, now);
+    }
+  return item;
+}
+
+bool
+FqCoDelQueueDisc::CoDelOkToDrop (FlowState &flow, Ptr<QueueDiscItem> item, uint32_t now)
+{
+  NS_LOG_FUNCTION (this);
+
+  if (!item)
+    {
+      flow.firstAboveTime = 0;
+      return false;
+    }
+
+  Time delta = Simulator::Now () - item->GetTimeStamp ();
+  NS_LOG_INFO ("Sojourn time " << delta.ToDouble (Time::MS) << "ms");
+  uint32_t sojournTime = static_cast<uint32_t> (delta.GetNanoSeconds () >> CODEL_SHIFT);
+
+  if (CoDelTimeBefore (sojournTime, m_codelTarget) || flow.nBytes < CODEL_MIN_BYTES)
+    {
+      // went below so we'll stay below for at least interval
+      flow.firstAboveTime = 0;
+      return false;
+    }
+  bool okToDrop = false;
+  if (flow.firstAboveTime == 0)
+    {
+      /* just went above from below. If we stay above
+       * for at least interval we'll say it's ok to drop
+       */
+      flow.firstAboveTime = now + m_codelInterval;
+    }
+  else if (CoDelTimeAfter (now, flow.firstAboveTime))
+    {
+      okToDrop = true;
+    }
+  return okToDrop;
+}
+
+void
+FqCoDelQueueDisc::CoDelNewtonStep (FlowState &flow)
+{
+  NS_LOG_FUNCTION (this);
+  uint32_t invsqrt = ((uint32_t) flow.recInvSqrt) << REC_INV_SQRT_SHIFT;
+  uint32_t invsqrt2 = ((uint64_t) invsqrt * invsqrt) >> 32;
+  uint64_t val = (3ll << 32) - ((uint64_t) flow.count * invsqrt2);
+
+  val >>= 2; /* avoid overflow */
+  val = (val * invsqrt) >> (32 - 2 + 1);
+  flow.recInvSqrt = static_cast<uint16_t> (val >> REC_INV_SQRT_SHIFT);
+}
+
+uint32_t
+FqCoDelQueueDisc::CoDelControlLaw (const FlowState &flow, uint32_t t) const
+{
+  NS_LOG_FUNCTION (this);
+  // t + interval / sqrt (count), with a reciprocal divide
+  return t + static_cast<uint32_t> (((uint64_t) m_codelInterval * ((uint32_t) flow.recInvSqrt << REC_INV_SQRT_SHIFT)) >> 32);
+}
+
+void
+FqCoDelQueueDisc::PushFlow (FlowList &list, uint32_t index)
+{
+  m_flowStates[index].next = NO_INDEX;
+  if (list.tail == NO_INDEX)
+    {
+      list.head = index;
+    }
+  else
+    {
+      m_flowStates[list.tail].next = index;
+    }
+  list.tail = index;
+}
+
+void
+FqCoDelQueueDisc::PopFlow (FlowList &list)
+{
+  NS_ASSERT (list.head != NO_INDEX);
+  uint32_t index = list.head;
+  list.head = m_flowStates[index].next;
+  if (list.head == NO_INDEX)
+    {
+      list.tail = NO_INDEX;
+    }
+  m_flowStates[index].next = NO_INDEX;
+}
+
 } // namespace ns3
@@ -102,7 +102,8 @@ PieQueueDisc::PieQueueDisc ()
 {
   NS_LOG_FUNCTION (this);
   m_uv = CreateObject<UniformRandomVariable> ();
-  m_rtrsEvent = Simulator::Schedule (m_sUpdate, &PieQueueDisc::CalculateP, this);
+  m_timerQueue = QueueDiscTimerQueue::Get ();
+  m_rtrsTimer = m_timerQueue->Schedule (m_sUpdate, MakeCallback (&PieQueueDisc::CalculateP, this));
 }
 
 PieQueueDisc::~PieQueueDisc ()
@@ -115,7 +116,8 @@ PieQueueDisc::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
   m_uv = 0;
-  Simulator::Remove (m_rtrsEvent);
+  m_timerQueue->Cancel (m_rtrsTimer);
+  m_timerQueue = 0;
   QueueDisc::DoDispose ();
 }
 
@@ -337,7 +339,7 @@ void PieQueueDisc::CalculateP ()
     }
 
   m_qDelayOld = qDelay;
-  m_rtrsEvent = Simulator::Schedule (m_tUpdate, &PieQueueDisc::CalculateP, this);
+  m_rtrsTimer = m_timerQueue->Schedule (m_tUpdate, MakeCallback (&PieQueueDisc::CalculateP, this));
 }
 
 Ptr<QueueDiscItem>
@@ -0,0 +1,200 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "queue-disc-timer-queue.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("QueueDiscTimerQueue");
+
+NS_OBJECT_ENSURE_REGISTERED (QueueDiscTimerQueue);
+
+TypeId QueueDiscTimerQueue::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::QueueDiscTimerQueue")
+    .SetParent<Object> ()
+    .SetGroupName ("TrafficControl")
+    .AddConstructor<QueueDiscTimerQueue> ()
+  ;
+  return tid;
+}
+
+QueueDiscTimerQueue::QueueDiscTimerQueue ()
+  : m_lastId (0),
+    m_expiring (false)
+{
+  NS_LOG_FUNCTION (this);
+  m_thread = std::this_thread::get_id ();
+}
+
+QueueDiscTimerQueue::~QueueDiscTimerQueue ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+QueueDiscTimerQueue::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  Simulator::Cancel (m_event);
+  m_slots.clear ();
+  m_timers.clear ();
+  Object::DoDispose ();
+}
+
+Ptr<QueueDiscTimerQueue>
+QueueDiscTimerQueue::Get (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  return *DoGet ();
+}
+
+Ptr<QueueDiscTimerQueue> *
+QueueDiscTimerQueue::DoGet (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  static Ptr<QueueDiscTimerQueue> ptr = 0;
+  if (ptr == 0)
+    {
+      ptr = CreateObject<QueueDiscTimerQueue> ();
+      Simulator::ScheduleDestroy (&QueueDiscTimerQueue::Delete);
+    }
+  return &ptr;
+}
+
+void
+QueueDiscTimerQueue::Delete (void)
+{
+  NS_LOG_FUNCTION_NOARGS ();
+  // the queue discs may hold the timer queue beyond the end of the
+  // simulation, hence it is disposed (and its timers removed) here
+  (*DoGet ())->Dispose ();
+  *DoGet () = 0;
+}
+
+uint64_t
+QueueDiscTimerQueue::Schedule (Time delay, Callback<void> cb)
+{
+  NS_LOG_FUNCTION (this << delay);
+  NS_ASSERT_MSG (!delay.IsStrictlyNegative (), "The delay of a timer cannot be negative");
+  NS_ASSERT_MSG (std::this_thread::get_id () == m_thread,
+                 "The timer queue can only be used by the thread that created it");
+
+  Time expiration = Simulator::Now () + delay;
+  uint64_t id = ++m_lastId;
+  m_slots[expiration].push_back (std::make_pair (id, cb));
+  m_timers[id] = expiration;
+
+  // the expiration event is scheduled at the end of Expire, if expiring
+  if (!m_expiring && (!m_event.IsRunning () || Simulator::GetDelayLeft (m_event) > delay))
+    {
+      Simulator::Cancel (m_event);
+      m_event = Simulator::Schedule (delay, &QueueDiscTimerQueue::Expire, this);
+    }
+  return id;
+}
+
+void
+QueueDiscTimerQueue::Cancel (uint64_t id)
+{
+  NS_LOG_FUNCTION (this << id);
+  NS_ASSERT_MSG (std::this_thread::get_id () == m_thread,
+                 "The timer queue can only be used by the thread that created it");
+
+  std::map<uint64_t, Time>::iterator timerIt = m_timers.find (id);
+  if (timerIt == m_timers.end ())
+    {
+      return;
+    }
+
+  std::map<Time, Slot>::iterator slotIt = m_slots.find (timerIt->second);
+  NS_ASSERT (slotIt != m_slots.end ());
+  bool earliest = (slotIt == m_slots.begin ());
+  for (Slot::iterator it = slotIt->second.begin (); it != slotIt->second.end (); it++)
+    {
+      if (it->first == id)
+        {
+          slotIt->second.erase (it);
+          break;
+        }
+    }
+  m_timers.erase (timerIt);
+
+  if (!slotIt->second.empty ())
+    {
+      return;
+    }
+  m_slots.erase (slotIt);
+
+  // move the expiration event to the next slot, if the earliest one is gone
+  if (earliest && !m_expiring && m_event.IsRunning ())
+    {
+      Simulator::Cancel (m_event);
+      if (!m_slots.empty ())
+        {
+          m_event = Simulator::Schedule (m_slots.begin ()->first - Simulator::Now (),
+                                         &QueueDiscTimerQueue::Expire, this);
+        }
+    }
+}
+
+bool
+QueueDiscTimerQueue::IsPending (uint64_t id) const
+{
+  return m_timers.find (id) != m_timers.end ();
+}
+
+uint32_t
+QueueDiscTimerQueue::GetNTimers (void) const
+{
+  return m_timers.size ();
+}
+
+void
+QueueDiscTimerQueue::Expire (void)
+{
+  NS_LOG_FUNCTION (this);
+
+  Time now = Simulator::Now ();
+  std::map<Time, Slot>::iterator slotIt;
+  m_expiring = true;
+
+  // the timers are taken one at a time, because a callback may add a timer
+  // expiring now or cancel a timer of this slot
+  while ((slotIt = m_slots.begin ()) != m_slots.end () && slotIt->first <= now)
+    {
+      if (slotIt->second.empty ())
+        {
+          m_slots.erase (slotIt);
+          continue;
+        }
+      Timer timer = slotIt->second.front ();
+      slotIt->second.pop_front ();
+      m_timers.erase (timer.first);
+      NS_LOG_DEBUG ("Timer " << timer.first << " expired");
+      timer.second ();
+    }
+  m_expiring = false;
+
+  if (!m_slots.empty ())
+    {
+      m_event = Simulator::Schedule (m_slots.begin ()->first - now, &QueueDiscTimerQueue::Expire, this);
+    }
+}
+
+} // namespace ns3
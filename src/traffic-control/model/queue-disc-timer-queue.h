@@ -0,0 +1,135 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#ifndef QUEUE_DISC_TIMER_QUEUE_H
+#define QUEUE_DISC_TIMER_QUEUE_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/callback.h"
+#include <list>
+#include <map>
+#include <thread>
+
+namespace ns3 {
+
+/**
+ * \ingroup traffic-control
+ *
+ * \brief Timer queue shared by the queue discs for their periodic updates
+ *
+ * Queue discs such as PIE update their state periodically. Rather than
+ * scheduling an event per queue disc and per update, they add a timer to
+ * the timer queue shared by all the queue discs of the simulation. The
+ * timers are gathered in slots by expiration time and only the earliest
+ * slot has an event in the simulator: when it expires, all the timers of the
+ * slot are run in the order they were added, so that the queue discs
+ * updating at the same time take one event instead of one each.
+ *
+ * This is not a timing wheel: the slots are indexed by the exact expiration
+ * time, with no rounding to a tick, so that the timers expire exactly when
+ * requested. Hence, only the queue discs whose updates are in phase (e.g.,
+ * those created at the same time with the same update interval) share the
+ * events; queue discs created at different times do not.
+ *
+ * The timer queue is created when first requested and cleared when the
+ * simulator is destroyed. There is one timer queue per process, not per
+ * simulator implementation: it must only be used by the thread that created
+ * it, which is checked. With the MultithreadedSimulatorImpl, the queue discs
+ * must then be created before the simulation runs, so that the expiration
+ * events belong to the global partition and the timers are run by the main
+ * thread while the other partitions are paused.
+ */
+class QueueDiscTimerQueue : public Object
+{
+public:
+  /**
+   * \brief Get the type ID.
+   * \return the object TypeId
+   */
+  static TypeId GetTypeId (void);
+  /**
+   * \brief QueueDiscTimerQueue constructor
+   */
+  QueueDiscTimerQueue ();
+
+  virtual ~QueueDiscTimerQueue ();
+
+  /**
+   * \brief Get the timer queue shared by the queue discs
+   * \return the timer queue shared by the queue discs
+   */
+  static Ptr<QueueDiscTimerQueue> Get (void);
+
+  /**
+   * \brief Add a timer to the timer queue
+   * \param delay the delay after which the timer expires
+   * \param cb the callback to invoke when the timer expires
+   * \return the identifier of the timer, which is never zero
+   */
+  uint64_t Schedule (Time delay, Callback<void> cb);
+  /**
+   * \brief Remove a timer from the timer queue, if it has not expired yet
+   * \param id the identifier of the timer
+   */
+  void Cancel (uint64_t id);
+  /**
+   * \brief Check whether a timer has not expired yet
+   * \param id the identifier of the timer
+   * \return true if the timer has not expired nor has been cancelled
+   */
+  bool IsPending (uint64_t id) const;
+  /**
+   * \brief Get the number of timers that have not expired yet
+   * \return the number of timers that have not expired yet
+   */
+  uint32_t GetNTimers (void) const;
+
+protected:
+  virtual void DoDispose (void);
+
+private:
+  /**
+   * \brief Get the timer queue shared by the queue discs
+   * \return a pointer to the timer queue shared by the queue discs
+   */
+  static Ptr<QueueDiscTimerQueue> *DoGet (void);
+  /**
+   * \brief Clear the timer queue shared by the queue discs
+   */
+  static void Delete (void);
+  /**
+   * \brief Run the timers of the earliest slot and schedule the next slot
+   */
+  void Expire (void);
+
+  /// A timer: the identifier and the callback
+  typedef std::pair<uint64_t, Callback<void> > Timer;
+  /// A slot: the timers expiring at the same time
+  typedef std::list<Timer> Slot;
+
+  std::map<Time, Slot> m_slots;       //!< Slots indexed by expiration time
+  std::map<uint64_t, Time> m_timers;  //!< Expiration time of the pending timers
+  uint64_t m_lastId;                  //!< Identifier of the last timer added
+  EventId m_event;                    //!< Expiration event of the earliest slot
+  bool m_expiring;                    //!< Whether the timers of a slot are being run
+  std::thread::id m_thread;           //!< The thread that created the timer queue
+};
+
+} // namespace ns3
+
+#endif /* QUEUE_DISC_TIMER_QUEUE_H */
@@ -0,0 +1,214 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/airtime-drr-queue-disc.h"
+#include "ns3/packet.h"
+#include "ns3/string.h"
+#include "ns3/simulator.h"
+#include <cmath>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief AirtimeDrr Queue Disc Test Item
+ */
+class AirtimeDrrQueueDiscTestItem : public QueueDiscItem
+{
+public:
+  /**
+   * Constructor
+   *
+   * \param p the packet
+   * \param addr the address of the destination station
+   */
+  AirtimeDrrQueueDiscTestItem (Ptr<Packet> p, const Address & addr);
+  virtual ~AirtimeDrrQueueDiscTestItem ();
+  virtual void AddHeader (void);
+  virtual bool Mark (void);
+};
+
+AirtimeDrrQueueDiscTestItem::AirtimeDrrQueueDiscTestItem (Ptr<Packet> p, const Address & addr)
+  : QueueDiscItem (p, addr, 0)
+{
+}
+
+AirtimeDrrQueueDiscTestItem::~AirtimeDrrQueueDiscTestItem ()
+{
+}
+
+void
+AirtimeDrrQueueDiscTestItem::AddHeader (void)
+{
+}
+
+bool
+AirtimeDrrQueueDiscTestItem::Mark (void)
+{
+  return false;
+}
+
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief AirtimeDrr Queue Disc Test Case
+ *
+ * A slow station uses ten times more airtime per packet than a fast one. The
+ * airtime of each dequeued packet is first reported immediately, then not
+ * reported at all, so that the stations are only charged the airtime
+ * estimated from their last transmission: in both cases, both stations must
+ * get the same airtime, within a quantum and the airtime of a packet.
+ */
+class AirtimeDrrQueueDiscTestCase : public TestCase
+{
+public:
+  AirtimeDrrQueueDiscTestCase ();
+  virtual ~AirtimeDrrQueueDiscTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+AirtimeDrrQueueDiscTestCase::AirtimeDrrQueueDiscTestCase ()
+  : TestCase ("Sanity check on the airtime deficit round robin queue disc")
+{
+}
+
+AirtimeDrrQueueDiscTestCase::~AirtimeDrrQueueDiscTestCase ()
+{
+}
+
+void
+AirtimeDrrQueueDiscTestCase::DoRun (void)
+{
+  Ptr<AirtimeDrrQueueDisc> qd = CreateObjectWithAttributes<AirtimeDrrQueueDisc> ("MaxSize", StringValue ("1000p"),
+                                                                                 "Quantum", StringValue ("300us"));
+  qd->Initialize ();
+
+  Mac48Address slow ("00:00:00:00:00:01");
+  Mac48Address fast ("00:00:00:00:00:02");
+  Time slowAirtime = MicroSeconds (1000);
+  Time fastAirtime = MicroSeconds (100);
+
+  for (uint32_t i = 0; i < 500; i++)
+    {
+      qd->Enqueue (Create<AirtimeDrrQueueDiscTestItem> (Create<Packet> (1000), slow));
+      qd->Enqueue (Create<AirtimeDrrQueueDiscTestItem> (Create<Packet> (1000), fast));
+    }
+  NS_TEST_ASSERT_MSG_EQ (qd->GetNPackets (), 1000, "unexpected number of packets in the queue disc");
+  NS_TEST_ASSERT_MSG_EQ (qd->GetNQueueDiscClasses (), 2, "there should be a queue per station");
+
+  // the queue disc is full
+  qd->Enqueue (Create<AirtimeDrrQueueDiscTestItem> (Create<Packet> (1000), fast));
+  NS_TEST_ASSERT_MSG_EQ (qd->GetStats ().GetNDroppedPackets (AirtimeDrrQueueDisc::LIMIT_EXCEEDED_DROP), 1,
+                         "a packet should have been dropped from the largest station queue");
+  NS_TEST_ASSERT_MSG_EQ (qd->GetNPackets (), 1000, "unexpected number of packets in the queue disc");
+
+  Time slowTotal = Seconds (0);
+  Time fastTotal = Seconds (0);
+  uint32_t nSlow = 0;
+  uint32_t nFast = 0;
+  for (uint32_t i = 0; i < 150; i++)
+    {
+      Ptr<QueueDiscItem> item = qd->Dequeue ();
+      NS_TEST_ASSERT_MSG_NE (item, 0, "a packet should have been dequeued");
+      if (item->GetAddress () == Address (slow))
+        {
+          qd->ReportAirtime (slow, 1000, slowAirtime);
+          slowTotal += slowAirtime;
+          nSlow++;
+        }
+      else
+        {
+          qd->ReportAirtime (fast, 1000, fastAirtime);
+          fastTotal += fastAirtime;
+          nFast++;
+        }
+      // airtime reported for a station without queue is ignored
+      qd->ReportAirtime (Mac48Address ("00:00:00:00:00:03"), 1000, slowAirtime);
+    }
+
+  double difference = std::abs ((slowTotal - fastTotal).GetMicroSeconds ());
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (difference, 1300, "the stations should get the same airtime");
+  NS_TEST_ASSERT_MSG_GT (nFast, 8 * nSlow, "the fast station should send many more packets");
+
+  // the airtime is no longer reported: the estimate charged at dequeue time
+  // keeps the stations fair
+  slowTotal = Seconds (0);
+  fastTotal = Seconds (0);
+  nSlow = 0;
+  nFast = 0;
+  for (uint32_t i = 0; i < 150; i++)
+    {
+      Ptr<QueueDiscItem> item = qd->Dequeue ();
+      NS_TEST_ASSERT_MSG_NE (item, 0, "a packet should have been dequeued");
+      if (item->GetAddress () == Address (slow))
+        {
+          slowTotal += slowAirtime;
+          nSlow++;
+        }
+      else
+        {
+          fastTotal += fastAirtime;
+          nFast++;
+        }
+    }
+
+  difference = std::abs ((slowTotal - fastTotal).GetMicroSeconds ());
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (difference, 1300, "the stations should get the same estimated airtime");
+  NS_TEST_ASSERT_MSG_GT (nFast, 8 * nSlow, "the fast station should send many more packets");
+
+  // the actual airtime reported later replaces the estimates: the slow
+  // station took twice the estimated airtime, hence it is not served until
+  // the fast station used as much airtime
+  qd->ReportAirtime (slow, nSlow * 1000, slowAirtime * 2 * nSlow);
+  qd->ReportAirtime (fast, nFast * 1000, fastTotal);
+  for (uint32_t i = 0; i < 80; i++)
+    {
+      Ptr<QueueDiscItem> item = qd->Dequeue ();
+      NS_TEST_ASSERT_MSG_NE (item, 0, "a packet should have been dequeued");
+      NS_TEST_ASSERT_MSG_EQ (item->GetAddress (), Address (fast), "the slow station should not be served");
+    }
+
+  // the stations are served until empty
+  while (qd->Dequeue ())
+    {
+    }
+  NS_TEST_ASSERT_MSG_EQ (qd->GetNPackets (), 0, "the queue disc should be empty");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief AirtimeDrr Queue Disc Test Suite
+ */
+static class AirtimeDrrQueueDiscTestSuite : public TestSuite
+{
+public:
+  AirtimeDrrQueueDiscTestSuite ()
+    : TestSuite ("airtime-drr-queue-disc", UNIT)
+  {
+    AddTestCase (new AirtimeDrrQueueDiscTestCase (), TestCase::QUICK);
+  }
+} g_airtimeDrrQueueDiscTestSuite; ///< the test suite
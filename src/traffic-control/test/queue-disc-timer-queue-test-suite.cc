@@ -0,0 +1,213 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "ns3/test.h"
+#include "ns3/queue-disc-timer-queue.h"
+#include "ns3/pie-queue-disc.h"
+#include "ns3/simulator.h"
+#include "ns3/nstime.h"
+#include <vector>
+
+using namespace ns3;
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Queue Disc Timer Queue Test Case
+ *
+ * Timers expiring at the same time must be run in the order they were added,
+ * by a single event, and cancelled timers must not be run.
+ */
+class QueueDiscTimerQueueTestCase : public TestCase
+{
+public:
+  QueueDiscTimerQueueTestCase ();
+  virtual ~QueueDiscTimerQueueTestCase ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Record the expiration of a timer
+   * \param index the index of the timer
+   */
+  void Expired (uint32_t index);
+  /**
+   * Record the expiration of a periodic timer and add it again
+   * \param timerQueue the timer queue
+   * \param period the period of the timer
+   */
+  void PeriodicExpired (Ptr<QueueDiscTimerQueue> timerQueue, Time period);
+
+  std::vector<uint32_t> m_expired;          //!< indices of the expired timers
+  std::vector<Time> m_expirationTimes;      //!< expiration times of the timers
+  uint32_t m_nPeriodic;                     //!< number of expirations of the periodic timer
+};
+
+QueueDiscTimerQueueTestCase::QueueDiscTimerQueueTestCase ()
+  : TestCase ("Sanity check on the queue disc timer queue"),
+    m_nPeriodic (0)
+{
+}
+
+QueueDiscTimerQueueTestCase::~QueueDiscTimerQueueTestCase ()
+{
+}
+
+void
+QueueDiscTimerQueueTestCase::Expired (uint32_t index)
+{
+  m_expired.push_back (index);
+  m_expirationTimes.push_back (Simulator::Now ());
+}
+
+void
+QueueDiscTimerQueueTestCase::PeriodicExpired (Ptr<QueueDiscTimerQueue> timerQueue, Time period)
+{
+  m_nPeriodic++;
+  timerQueue->Schedule (period, MakeCallback (&QueueDiscTimerQueueTestCase::PeriodicExpired, this).TwoBind (timerQueue, period));
+}
+
+void
+QueueDiscTimerQueueTestCase::DoRun (void)
+{
+  Ptr<QueueDiscTimerQueue> timerQueue = CreateObject<QueueDiscTimerQueue> ();
+
+  // timers 0 to 99 expire after 10 ms, timers 100 to 199 after 20 ms
+  std::vector<uint64_t> ids;
+  for (uint32_t i = 0; i < 200; i++)
+    {
+      Time delay = (i < 100 ? MilliSeconds (10) : MilliSeconds (20));
+      ids.push_back (timerQueue->Schedule (delay, MakeCallback (&QueueDiscTimerQueueTestCase::Expired, this).Bind (i)));
+    }
+  NS_TEST_ASSERT_MSG_EQ (timerQueue->GetNTimers (), 200, "unexpected number of timers");
+
+  timerQueue->Cancel (ids[50]);
+  timerQueue->Cancel (ids[150]);
+  NS_TEST_ASSERT_MSG_EQ (timerQueue->IsPending (ids[50]), false, "the timer should have been cancelled");
+  NS_TEST_ASSERT_MSG_EQ (timerQueue->IsPending (ids[51]), true, "the timer should be pending");
+  NS_TEST_ASSERT_MSG_EQ (timerQueue->GetNTimers (), 198, "unexpected number of timers");
+
+  Simulator::Stop (MilliSeconds (30));
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_expired.size (), 198, "unexpected number of expired timers");
+  NS_TEST_ASSERT_MSG_EQ (timerQueue->GetNTimers (), 0, "all the timers should have expired");
+  for (uint32_t i = 0; i < m_expired.size (); i++)
+    {
+      // the timers are run in order, skipping the cancelled ones
+      uint32_t expected = i + (i >= 50) + (i >= 149);
+      NS_TEST_ASSERT_MSG_EQ (m_expired[i], expected, "unexpected order of expiration");
+      NS_TEST_ASSERT_MSG_EQ (m_expirationTimes[i], (i < 99 ? MilliSeconds (10) : MilliSeconds (20)),
+                             "unexpected expiration time");
+    }
+  // an event per slot, plus the stop event
+  NS_TEST_ASSERT_MSG_EQ (Simulator::GetEventCount (), 3, "timers expiring together should take one event");
+
+  // a timer alone in the earliest slot, cancelled before it expires
+  uint64_t id = timerQueue->Schedule (MilliSeconds (5), MakeCallback (&QueueDiscTimerQueueTestCase::Expired, this).Bind (1000));
+  timerQueue->Cancel (id);
+
+  // periodic timers, added again when they expire
+  timerQueue->Schedule (MilliSeconds (0), MakeCallback (&QueueDiscTimerQueueTestCase::PeriodicExpired, this).TwoBind (timerQueue, MilliSeconds (10)));
+  Simulator::Stop (MilliSeconds (95));
+  Simulator::Run ();
+  NS_TEST_ASSERT_MSG_EQ (m_nPeriodic, 10, "unexpected number of expirations of the periodic timer");
+  NS_TEST_ASSERT_MSG_EQ (m_expired.size (), 198, "the cancelled timer should not have expired");
+  NS_TEST_ASSERT_MSG_EQ (timerQueue->GetNTimers (), 1, "the periodic timer should be pending");
+
+  timerQueue->Dispose ();
+  NS_TEST_ASSERT_MSG_EQ (timerQueue->GetNTimers (), 0, "the timers should have been removed");
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Queue Disc Timer Queue PIE Test Case
+ *
+ * The periodic updates of many PIE queue discs created at the same time must
+ * take one event per update interval.
+ */
+class QueueDiscTimerQueuePieTestCase : public TestCase
+{
+public:
+  QueueDiscTimerQueuePieTestCase ();
+  virtual ~QueueDiscTimerQueuePieTestCase ();
+
+private:
+  virtual void DoRun (void);
+};
+
+QueueDiscTimerQueuePieTestCase::QueueDiscTimerQueuePieTestCase ()
+  : TestCase ("Check that the updates of PIE queue discs share the events of the timer queue")
+{
+}
+
+QueueDiscTimerQueuePieTestCase::~QueueDiscTimerQueuePieTestCase ()
+{
+}
+
+void
+QueueDiscTimerQueuePieTestCase::DoRun (void)
+{
+  std::vector<Ptr<PieQueueDisc> > queueDiscs;
+  for (uint32_t i = 0; i < 100; i++)
+    {
+      Ptr<PieQueueDisc> qd = CreateObject<PieQueueDisc> ();
+      qd->Initialize ();
+      queueDiscs.push_back (qd);
+    }
+  NS_TEST_ASSERT_MSG_EQ (QueueDiscTimerQueue::Get ()->GetNTimers (), 100, "there should be a timer per queue disc");
+
+  TimeValue tUpdate;
+  queueDiscs[0]->GetAttribute ("Tupdate", tUpdate);
+  Time stop = Seconds (1);
+
+  Simulator::Stop (stop);
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (QueueDiscTimerQueue::Get ()->GetNTimers (), 100, "there should be a timer per queue disc");
+  // an event per update interval (plus the first update and the stop event)
+  NS_TEST_ASSERT_MSG_LT_OR_EQ (Simulator::GetEventCount (), static_cast<uint64_t> (stop.GetInteger () / tUpdate.Get ().GetInteger () + 2),
+                               "the updates of the queue discs should take one event per update interval");
+
+  for (uint32_t i = 0; i < queueDiscs.size (); i++)
+    {
+      queueDiscs[i]->Dispose ();
+    }
+  NS_TEST_ASSERT_MSG_EQ (QueueDiscTimerQueue::Get ()->GetNTimers (), 0, "the timers should have been cancelled");
+
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup traffic-control-test
+ * \ingroup tests
+ *
+ * \brief Queue Disc Timer Queue Test Suite
+ */
+static class QueueDiscTimerQueueTestSuite : public TestSuite
+{
+public:
+  QueueDiscTimerQueueTestSuite ()
+    : TestSuite ("queue-disc-timer-queue", UNIT)
+  {
+    AddTestCase (new QueueDiscTimerQueueTestCase (), TestCase::QUICK);
+    AddTestCase (new QueueDiscTimerQueuePieTestCase (), TestCase::QUICK);
+  }
+} g_queueDiscTimerQueueTestSuite; ///< the test suite
@@ -839,6 +839,7 @@ WifiHelper::Install (const WifiPhyHelper &phyHelper,
               ptr.Get<QosTxop> ()->SetAckPolicySelector (ackSelector);
               wmq = ptr.Get<QosTxop> ()->GetWifiMacQueue ();
               ndqi->GetTxQueue (0)->ConnectQueueTraces (wmq);
+              ptr.Get<QosTxop> ()->SetNetDeviceQueue (ndqi->GetTxQueue (0));
 
               rmac->GetAttributeFailSafe ("BK_Txop", ptr);
               ackSelector = m_ackPolicySelector[AC_BK].Create<WifiAckPolicySelector> ();
@@ -846,6 +847,7 @@ WifiHelper::Install (const WifiPhyHelper &phyHelper,
               ptr.Get<QosTxop> ()->SetAckPolicySelector (ackSelector);
               wmq = ptr.Get<QosTxop> ()->GetWifiMacQueue ();
               ndqi->GetTxQueue (1)->ConnectQueueTraces (wmq);
+              ptr.Get<QosTxop> ()->SetNetDeviceQueue (ndqi->GetTxQueue (1));
 
               rmac->GetAttributeFailSafe ("VI_Txop", ptr);
               ackSelector = m_ackPolicySelector[AC_VI].Create<WifiAckPolicySelector> ();
@@ -853,6 +855,7 @@ WifiHelper::Install (const WifiPhyHelper &phyHelper,
               ptr.Get<QosTxop> ()->SetAckPolicySelector (ackSelector);
               wmq = ptr.Get<QosTxop> ()->GetWifiMacQueue ();
               ndqi->GetTxQueue (2)->ConnectQueueTraces (wmq);
+              ptr.Get<QosTxop> ()->SetNetDeviceQueue (ndqi->GetTxQueue (2));
 
               rmac->GetAttributeFailSafe ("VO_Txop", ptr);
               ackSelector = m_ackPolicySelector[AC_VO].Create<WifiAckPolicySelector> ();
@@ -860,6 +863,7 @@ WifiHelper::Install (const WifiPhyHelper &phyHelper,
               ptr.Get<QosTxop> ()->SetAckPolicySelector (ackSelector);
               wmq = ptr.Get<QosTxop> ()->GetWifiMacQueue ();
               ndqi->GetTxQueue (3)->ConnectQueueTraces (wmq);
+              ptr.Get<QosTxop> ()->SetNetDeviceQueue (ndqi->GetTxQueue (3));
               ndqi->SetSelectQueueCallback (m_selectQueueCallback);
             }
           else
@@ -869,6 +873,7 @@ WifiHelper::Install (const WifiPhyHelper &phyHelper,
               rmac->GetAttributeFailSafe ("Txop", ptr);
               wmq = ptr.Get<Txop> ()->GetWifiMacQueue ();
               ndqi->GetTxQueue (0)->ConnectQueueTraces (wmq);
+              ptr.Get<Txop> ()->SetNetDeviceQueue (ndqi->GetTxQueue (0));
             }
           device->AggregateObject (ndqi);
         }
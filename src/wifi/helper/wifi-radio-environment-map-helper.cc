@@ -0,0 +1,321 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ */
+
+#include "wifi-radio-environment-map-helper.h"
+#include <algorithm>
+#include <fstream>
+#include <limits>
+#include "ns3/log.h"
+#include "ns3/abort.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/string.h"
+#include "ns3/node.h"
+#include "ns3/mobility-model.h"
+#include "ns3/antenna-model.h"
+#include "ns3/spectrum-channel.h"
+#include "ns3/spectrum-model.h"
+#include "ns3/wifi-spectrum-value-helper.h"
+#include "ns3/wifi-net-device.h"
+#include "ns3/spectrum-wifi-phy.h"
+#include "ns3/wifi-utils.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("WifiRadioEnvironmentMapHelper");
+
+NS_OBJECT_ENSURE_REGISTERED (WifiRadioEnvironmentMapHelper);
+
+TypeId
+WifiRadioEnvironmentMapHelper::GetTypeId (void)
+{
+  static TypeId tid = TypeId ("ns3::WifiRadioEnvironmentMapHelper")
+    .SetParent<Object> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<WifiRadioEnvironmentMapHelper> ()
+    .AddAttribute ("OutputFile", "The filename to which the map is saved",
+                   StringValue ("wifi-rem.out"),
+                   MakeStringAccessor (&WifiRadioEnvironmentMapHelper::m_outputFile),
+                   MakeStringChecker ())
+    .AddAttribute ("XMin", "The min x coordinate of the map.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&WifiRadioEnvironmentMapHelper::m_xMin),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("YMin", "The min y coordinate of the map.",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&WifiRadioEnvironmentMapHelper::m_yMin),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("XMax", "The max x coordinate of the map.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&WifiRadioEnvironmentMapHelper::m_xMax),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("YMax", "The max y coordinate of the map.",
+                   DoubleValue (1.0),
+                   MakeDoubleAccessor (&WifiRadioEnvironmentMapHelper::m_yMax),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("XRes", "The resolution (number of points) of the map along the x axis.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&WifiRadioEnvironmentMapHelper::m_xRes),
+                   MakeUintegerChecker<uint16_t> (2, std::numeric_limits<uint16_t>::max ()))
+    .AddAttribute ("YRes", "The resolution (number of points) of the map along the y axis.",
+                   UintegerValue (100),
+                   MakeUintegerAccessor (&WifiRadioEnvironmentMapHelper::m_yRes),
+                   MakeUintegerChecker<uint16_t> (2, std::numeric_limits<uint16_t>::max ()))
+    .AddAttribute ("Z", "The value of the z coordinate for which the map is to be generated",
+                   DoubleValue (0.0),
+                   MakeDoubleAccessor (&WifiRadioEnvironmentMapHelper::m_z),
+                   MakeDoubleChecker<double> ())
+    .AddAttribute ("Threads",
+                   "Number of threads over which the points are spread. The propagation "
+                   "loss models must not keep any state per link (e.g., shadowing or fading) "
+                   "when several threads are used.",
+                   UintegerValue (1),
+                   MakeUintegerAccessor (&WifiRadioEnvironmentMapHelper::m_threads),
+                   MakeUintegerChecker<uint32_t> (1, std::numeric_limits<uint32_t>::max ()))
+  ;
+  return tid;
+}
+
+WifiRadioEnvironmentMapHelper::WifiRadioEnvironmentMapHelper ()
+  : m_primary (0),
+    m_rxGain (1.0),
+    m_noisePowerW (0.0),
+    m_rxSensitivityW (0.0),
+    m_ccaEdThresholdW (0.0),
+    m_ccaEdThresholdSecondaryW (0.0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+WifiRadioEnvironmentMapHelper::~WifiRadioEnvironmentMapHelper ()
+{
+  NS_LOG_FUNCTION (this);
+}
+
+void
+WifiRadioEnvironmentMapHelper::DoDispose (void)
+{
+  NS_LOG_FUNCTION (this);
+  m_receiver = 0;
+}
+
+Ptr<SpectrumWifiPhy>
+WifiRadioEnvironmentMapHelper::GetSpectrumWifiPhy (Ptr<NetDevice> device)
+{
+  Ptr<WifiNetDevice> wifiDevice = DynamicCast<WifiNetDevice> (device);
+  NS_ABORT_MSG_UNLESS (wifiDevice, "device " << device << " is not a WifiNetDevice");
+  Ptr<SpectrumWifiPhy> phy = DynamicCast<SpectrumWifiPhy> (wifiDevice->GetPhy ());
+  NS_ABORT_MSG_UNLESS (phy, "device " << device << " does not have a SpectrumWifiPhy");
+  return phy;
+}
+
+void
+WifiRadioEnvironmentMapHelper::SetReceiver (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  NS_ABORT_MSG_IF (m_receiver, "only one map supported per instance of WifiRadioEnvironmentMapHelper");
+  m_receiver = GetSpectrumWifiPhy (device);
+  Ptr<SpectrumChannel> channel = DynamicCast<SpectrumChannel> (m_receiver->GetChannel ());
+  NS_ABORT_MSG_UNLESS (channel, "the receiver is not attached to a SpectrumChannel");
+  Ptr<const SpectrumModel> model = m_receiver->GetRxSpectrumModel ();
+  m_generator.SetChannel (channel);
+  m_generator.SetRxSpectrumModel (model);
+  m_generator.SetRxAntenna (m_receiver->GetRxAntenna ());
+
+  // bands of the receiver spectrum model in each 20 MHz subchannel
+  uint16_t channelWidth = m_receiver->GetChannelWidth ();
+  uint16_t subchannelWidth = std::min<uint16_t> (channelWidth, 20);
+  uint32_t nSubchannels = std::max<uint32_t> (channelWidth / 20, 1);
+  double start = m_receiver->GetFrequency () * 1e6 - channelWidth * 0.5e6;
+  m_subchannels.clear ();
+  for (uint32_t i = 0; i < nSubchannels; i++)
+    {
+      double low = start + i * subchannelWidth * 1e6;
+      double high = low + subchannelWidth * 1e6;
+      uint32_t first = std::numeric_limits<uint32_t>::max ();
+      uint32_t last = 0;
+      uint32_t index = 0;
+      for (Bands::const_iterator it = model->Begin (); it != model->End (); ++it, ++index)
+        {
+          if (it->fc >= low && it->fc < high)
+            {
+              first = std::min (first, index);
+              last = std::max (last, index);
+            }
+        }
+      NS_ABORT_MSG_IF (first > last, "no band of the receiver spectrum model in subchannel " << i);
+      m_subchannels.push_back (std::make_pair (first, last));
+    }
+  m_primary = channelWidth >= 40 ? m_receiver->GetPrimaryBandIndex (20) : 0;
+
+  // thermal noise at 290K in J/s = W
+  static const double BOLTZMANN = 1.3803e-23;
+  m_noisePowerW = BOLTZMANN * 290 * subchannelWidth * 1e6 * DbToRatio (m_receiver->GetRxNoiseFigure ());
+  m_rxGain = DbToRatio (m_receiver->GetRxGain ());
+  m_rxSensitivityW = DbmToW (m_receiver->GetRxSensitivity ());
+  m_ccaEdThresholdW = DbmToW (m_receiver->GetCcaEdThreshold ());
+  m_ccaEdThresholdSecondaryW = m_receiver->GetDefaultCcaEdThresholdSecondary ();
+}
+
+void
+WifiRadioEnvironmentMapHelper::AddTransmitter (Ptr<NetDevice> device)
+{
+  NS_LOG_FUNCTION (this << device);
+  NS_ABORT_MSG_UNLESS (m_receiver, "the receiver must be set before adding transmitters");
+  Ptr<SpectrumWifiPhy> phy = GetSpectrumWifiPhy (device);
+  Ptr<MobilityModel> mobility = device->GetNode ()->GetObject<MobilityModel> ();
+  NS_ABORT_MSG_UNLESS (mobility, "the node of device " << device << " has no mobility model");
+
+  uint16_t channelWidth = phy->GetChannelWidth ();
+  uint16_t centerFrequency = phy->GetFrequency ();
+  double txPowerW = DbmToW (phy->GetTxPowerEnd () + phy->GetTxGain ());
+  DoubleValue innerBand;
+  DoubleValue outerBand;
+  DoubleValue lowestPoint;
+  phy->GetAttribute ("TxMaskInnerBandMinimumRejection", innerBand);
+  phy->GetAttribute ("TxMaskOuterBandMinimumRejection", outerBand);
+  phy->GetAttribute ("TxMaskOuterBandMaximumRejection", lowestPoint);
+  // same PSDs as SpectrumWifiPhy, for the modulation class of the standard
+  Ptr<SpectrumValue> psd;
+  switch (phy->GetStandard ())
+    {
+    case WIFI_PHY_STANDARD_80211b:
+      psd = WifiSpectrumValueHelper::CreateDsssTxPowerSpectralDensity (centerFrequency, txPowerW,
+                                                                         phy->GetGuardBandwidth (channelWidth));
+      break;
+    case WIFI_PHY_STANDARD_80211n_2_4GHZ:
+    case WIFI_PHY_STANDARD_80211n_5GHZ:
+    case WIFI_PHY_STANDARD_80211ac:
+      psd = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW,
+                                                                           phy->GetGuardBandwidth (channelWidth),
+                                                                           innerBand.Get (), outerBand.Get (), lowestPoint.Get ());
+      break;
+    case WIFI_PHY_STANDARD_80211ax_2_4GHZ:
+    case WIFI_PHY_STANDARD_80211ax_5GHZ:
+      psd = WifiSpectrumValueHelper::CreateHeOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW,
+                                                                           phy->GetGuardBandwidth (channelWidth),
+                                                                           innerBand.Get (), outerBand.Get (), lowestPoint.Get ());
+      break;
+    default:
+      if (channelWidth >= 40)
+        {
+          // non-HT duplicate
+          psd = WifiSpectrumValueHelper::CreateHtOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW,
+                                                                               phy->GetGuardBandwidth (channelWidth),
+                                                                               innerBand.Get (), outerBand.Get (), lowestPoint.Get ());
+        }
+      else
+        {
+          psd = WifiSpectrumValueHelper::CreateOfdmTxPowerSpectralDensity (centerFrequency, channelWidth, txPowerW,
+                                                                             phy->GetGuardBandwidth (channelWidth),
+                                                                             innerBand.Get (), outerBand.Get (), lowestPoint.Get ());
+        }
+      break;
+    }
+  m_generator.AddTransmitter (mobility, psd, phy->GetRxAntenna ());
+}
+
+void
+WifiRadioEnvironmentMapHelper::AddTransmitters (NetDeviceContainer devices)
+{
+  NS_LOG_FUNCTION (this);
+  for (NetDeviceContainer::Iterator it = devices.Begin (); it != devices.End (); ++it)
+    {
+      AddTransmitter (*it);
+    }
+}
+
+void
+WifiRadioEnvironmentMapHelper::Generate (void)
+{
+  NS_LOG_FUNCTION (this);
+  NS_ABORT_MSG_UNLESS (m_receiver, "no receiver set");
+  std::ofstream outFile (m_outputFile.c_str ());
+  if (!outFile.is_open ())
+    {
+      NS_FATAL_ERROR ("Can't open file " << m_outputFile);
+    }
+  m_generator.SetGrid (m_xMin, m_xMax, m_xRes, m_yMin, m_yMax, m_yRes, m_z);
+  m_generator.SetThreads (m_threads);
+  NS_LOG_LOGIC ("generating the map for " << m_generator.GetNTransmitters () << " transmitters");
+  m_generator.Generate (MakeCallback (&WifiRadioEnvironmentMapHelper::EvaluatePoint, this), outFile);
+  outFile.close ();
+}
+
+double
+WifiRadioEnvironmentMapHelper::GetSubchannelPower (const SpectrumValue &psd, uint32_t subchannel) const
+{
+  double power = 0;
+  Bands::const_iterator band = psd.GetSpectrumModel ()->Begin () + m_subchannels[subchannel].first;
+  for (uint32_t i = m_subchannels[subchannel].first; i <= m_subchannels[subchannel].second; ++i, ++band)
+    {
+      power += psd[i] * (band->fh - band->fl);
+    }
+  return power * m_rxGain;
+}
+
+void
+WifiRadioEnvironmentMapHelper::EvaluatePoint (const std::vector<SpectrumValue> &rxPsds, std::vector<double> &values) const
+{
+  uint32_t nSubchannels = m_subchannels.size ();
+  std::vector<double> subchannelPower (nSubchannels, 0.0);
+  double strongest = 0;
+  for (std::vector<SpectrumValue>::const_iterator it = rxPsds.begin (); it != rxPsds.end (); ++it)
+    {
+      for (uint32_t i = 0; i < nSubchannels; ++i)
+        {
+          double power = GetSubchannelPower (*it, i);
+          subchannelPower[i] += power;
+          if (i == m_primary && power > strongest)
+            {
+              strongest = power;
+            }
+        }
+    }
+
+  // widest channel, made of the primary channel and of the secondary channels
+  // of increasing width, all of whose 20 MHz subchannels are idle
+  uint32_t idleWidth = 0;
+  if (strongest < m_rxSensitivityW && subchannelPower[m_primary] < m_ccaEdThresholdW)
+    {
+      idleWidth = 1;
+      while (idleWidth < nSubchannels)
+        {
+          // the secondary channel is the other half of the channel twice as wide
+          uint32_t first = ((m_primary / idleWidth) ^ 1) * idleWidth;
+          bool idle = true;
+          for (uint32_t i = first; i < first + idleWidth; ++i)
+            {
+              idle = idle && subchannelPower[i] < m_ccaEdThresholdSecondaryW;
+            }
+          if (!idle)
+            {
+              break;
+            }
+          idleWidth *= 2;
+        }
+    }
+
+  values.clear ();
+  values.push_back (idleWidth * std::min<uint16_t> (m_receiver->GetChannelWidth (), 20));
+  values.push_back (strongest / (subchannelPower[m_primary] - strongest + m_noisePowerW));
+  for (uint32_t i = 0; i < nSubchannels; ++i)
+    {
+      values.push_back (WToDbm (subchannelPower[i]));
+    }
+}
+
+} //namespace ns3
@@ -172,6 +172,13 @@ ApWifiMac::GetCfpMaxDuration (void) const
   return m_low->GetCfpMaxDuration ();
 }
 
+void
+ApWifiMac::SwitchPrimaryChannel (uint8_t channelNumber)
+{
+  NS_LOG_FUNCTION (this << +channelNumber);
+  m_phy->SwitchPrimaryChannel (channelNumber);
+}
+
 void
 ApWifiMac::SetWifiRemoteStationManager (const Ptr<WifiRemoteStationManager> stationManager)
 {
@@ -570,7 +577,7 @@ ApWifiMac::GetHtOperation (void) const
   if (GetHtSupported ())
     {
       operation.SetHtSupported (1);
-      operation.SetPrimaryChannel (m_phy->GetChannelNumber ());
+      operation.SetPrimaryChannel (m_phy->GetPrimaryChannelNumber ());
       operation.SetRifsMode (GetRifsMode ());
       operation.SetNonGfHtStasPresent (IsNonGfHtStasPresent ());
       if (m_phy->GetChannelWidth () > 20)
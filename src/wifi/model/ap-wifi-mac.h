@@ -111,6 +111,14 @@ public:
    * \return the maximum duration for the CF period.
    */
   Time GetCfpMaxDuration (void) const;
+  /**
+   * Relocate the primary 20 MHz channel of the BSS inside the current operating
+   * channel. The new primary channel is advertised in the HT Operation element
+   * of the following beacons, so that associated stations follow at the next TBTT.
+   *
+   * \param channelNumber the new primary 20 MHz channel number
+   */
+  void SwitchPrimaryChannel (uint8_t channelNumber);
   /**
    * Determine whether short slot time should be enabled or not in the BSS.
    * Typically, true is returned only when there is no non-erp stations associated
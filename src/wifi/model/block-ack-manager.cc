@@ -262,25 +262,28 @@ BlockAckManager::StorePacket (Ptr<WifiMacQueueItem> mpdu)
     }
 
   // store the packet and keep the list sorted in increasing order of sequence number
-  // with respect to the starting sequence number
-  PacketQueueI it = agreementIt->second.second.begin ();
-  while (it != agreementIt->second.second.end ())
+  // with respect to the starting sequence number. MPDUs are mostly transmitted in
+  // increasing order of sequence number, hence the list is scanned backwards
+  PacketQueueI it = agreementIt->second.second.end ();
+  while (it != agreementIt->second.second.begin ())
     {
-      if (mpdu->GetHeader ().GetSequenceControl () == (*it)->GetHeader ().GetSequenceControl ())
+      PacketQueueI prev = std::prev (it);
+
+      if (mpdu->GetHeader ().GetSequenceControl () == (*prev)->GetHeader ().GetSequenceControl ())
         {
           NS_LOG_DEBUG ("Packet already in the queue of the BA agreement");
           return;
         }
 
-      uint16_t dist = agreementIt->second.first.GetDistance ((*it)->GetHeader ().GetSequenceNumber ());
+      uint16_t dist = agreementIt->second.first.GetDistance ((*prev)->GetHeader ().GetSequenceNumber ());
 
-      if (mpduDist < dist ||
-          (mpduDist == dist && mpdu->GetHeader ().GetFragmentNumber () < (*it)->GetHeader ().GetFragmentNumber ()))
+      if (dist < mpduDist ||
+          (dist == mpduDist && (*prev)->GetHeader ().GetFragmentNumber () < mpdu->GetHeader ().GetFragmentNumber ()))
         {
           break;
         }
 
-      it++;
+      it = prev;
     }
   agreementIt->second.second.insert (it, mpdu);
   agreementIt->second.first.NotifyTransmittedMpdu (mpdu);
@@ -475,7 +478,7 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
                   currentSeq = (*queueIt)->GetHeader ().GetSequenceNumber ();
                   if (blockAck->IsPacketReceived (currentSeq))
                     {
-                      it->second.first.NotifyAckedMpdu (*queueIt);
+                      it->second.first.MarkAckedMpdu (*queueIt);
                       nSuccessfulMpdus++;
                       if (!m_txOkCallback.IsNull ())
                         {
@@ -494,6 +497,8 @@ BlockAckManager::NotifyGotBlockAck (const CtrlBAckResponseHeader *blockAck, Mac4
                   // in any case, this packet is no longer outstanding
                   queueIt = it->second.second.erase (queueIt);
                 }
+              // advance the transmit window past all the acknowledged MPDUs at once
+              it->second.first.AdvanceTxWindow ();
             }
           m_stationManager->ReportAmpduTxStatus (recipient, tid, nSuccessfulMpdus, nFailedMpdus, rxSnr, dataSnr);
         }
@@ -18,6 +18,7 @@
  * Author: Stefano Avallone <stavallo@unina.it>
  */
 
+#include <algorithm>
 #include "ns3/log.h"
 #include "block-ack-window.h"
 #include "wifi-utils.h"
@@ -28,7 +29,8 @@ NS_LOG_COMPONENT_DEFINE ("BlockAckWindow");
 
 BlockAckWindow::BlockAckWindow ()
   : m_winStart (0),
-    m_head (0)
+    m_winSize (0),
+    m_bitmap (1, 0)
 {
 }
 
@@ -36,15 +38,25 @@ void
 BlockAckWindow::Init (uint16_t winStart, uint16_t winSize)
 {
   NS_LOG_FUNCTION (this << winStart << winSize);
+  NS_ASSERT (winSize <= SEQNO_SPACE_HALF_SIZE);
   m_winStart = winStart;
-  m_window.assign (winSize, false);
-  m_head = 0;
+  m_winSize = winSize;
+  // the capacity must be a power of two (not less than 64), so that it divides
+  // the size of the sequence number space
+  std::size_t capacity = 64;
+  while (capacity < m_winSize)
+    {
+      capacity <<= 1;
+    }
+  m_bitmap.assign (capacity / 64, 0);
 }
 
 void
 BlockAckWindow::Reset (uint16_t winStart)
 {
-  Init (winStart, m_window.size ());
+  NS_LOG_FUNCTION (this << winStart);
+  m_winStart = winStart;
+  std::fill (m_bitmap.begin (), m_bitmap.end (), 0);
 }
 
 uint16_t
@@ -56,21 +68,89 @@ BlockAckWindow::GetWinStart (void) const
 uint16_t
 BlockAckWindow::GetWinEnd (void) const
 {
-  return (m_winStart + m_window.size () - 1) % SEQNO_SPACE_SIZE;
+  return (m_winStart + m_winSize - 1) % SEQNO_SPACE_SIZE;
 }
 
 std::size_t
 BlockAckWindow::GetWinSize (void) const
 {
-  return m_window.size ();
+  return m_winSize;
+}
+
+std::size_t
+BlockAckWindow::GetPosition (std::size_t distance) const
+{
+  return (m_winStart + distance) & (m_bitmap.size () * 64 - 1);
+}
+
+bool
+BlockAckWindow::At (std::size_t distance) const
+{
+  NS_ASSERT (distance < m_winSize);
+
+  std::size_t pos = GetPosition (distance);
+  return (m_bitmap[pos / 64] >> (pos % 64)) & 1;
+}
+
+void
+BlockAckWindow::Set (std::size_t distance)
+{
+  NS_ASSERT (distance < m_winSize);
+
+  std::size_t pos = GetPosition (distance);
+  m_bitmap[pos / 64] |= (uint64_t (1) << (pos % 64));
 }
 
-std::vector<bool>::reference
-BlockAckWindow::At (std::size_t distance)
+std::size_t
+BlockAckWindow::GetNContiguousSet (void) const
 {
-  NS_ASSERT (distance < m_window.size ());
+  std::size_t count = 0;
+  std::size_t pos = GetPosition (0);
+
+  while (count < m_winSize)
+    {
+      std::size_t offset = pos % 64;
+      std::size_t nBits = 64 - offset;
+      uint64_t word = m_bitmap[pos / 64] >> offset;
+
+      if (offset == 0 && word == ~uint64_t (0))
+        {
+          // all the elements in this word are set
+          count += 64;
+        }
+      else
+        {
+          std::size_t run = 0;
+          while (run < nBits && (word & 1))
+            {
+              word >>= 1;
+              run++;
+            }
+          count += run;
+          if (run < nBits)
+            {
+              break;
+            }
+        }
+      pos = (pos + nBits) & (m_bitmap.size () * 64 - 1);
+    }
+  // elements outside the window are always clear, but the window may take up
+  // the whole bitmap
+  return std::min (count, m_winSize);
+}
 
-  return m_window.at ((m_head + distance) % m_window.size ());
+void
+BlockAckWindow::Clear (std::size_t pos, std::size_t count)
+{
+  while (count > 0)
+    {
+      std::size_t offset = pos % 64;
+      std::size_t nBits = std::min<std::size_t> (64 - offset, count);
+      uint64_t mask = (nBits == 64 ? ~uint64_t (0) : ((uint64_t (1) << nBits) - 1) << offset);
+      m_bitmap[pos / 64] &= ~mask;
+      pos = (pos + nBits) & (m_bitmap.size () * 64 - 1);
+      count -= nBits;
+    }
 }
 
 void
@@ -78,17 +158,13 @@ BlockAckWindow::Advance (std::size_t count)
 {
   NS_LOG_FUNCTION (this << count);
 
-  if (count >= m_window.size ())
+  if (count >= m_winSize)
     {
       Reset ((m_winStart + count) % SEQNO_SPACE_SIZE);
       return;
     }
 
-  for (std::size_t i = 0; i < count; i++)
-    {
-      m_window[m_head] = false;
-      m_head = (m_head + 1) % m_window.size ();
-    }
+  Clear (GetPosition (0), count);
   m_winStart = (m_winStart + count) % SEQNO_SPACE_SIZE;
 }
 
@@ -22,6 +22,7 @@
 #define BLOCK_ACK_WINDOW_H
 
 #include <vector>
+#include <stdint.h>
 
 namespace ns3 {
 
@@ -34,10 +35,16 @@ namespace ns3 {
  * a given number of positions. This class can be used to implement both
  * an originator's window and a recipient's window.
  *
- * The window is implemented as a vector of bool and managed as a circular
- * queue. The window is moved forward by advancing the head of the queue and
- * clearing the elements that become part of the tail of the queue. Hence,
- * no element is required to be shifted when the window moves forward.
+ * The window is implemented as a bitmap stored in 64-bit words and managed as
+ * a circular queue. The element corresponding to sequence number SN is stored
+ * at position (SN mod capacity), where the capacity is the smallest power of
+ * two (and multiple of 64) not less than the window size. Since the capacity
+ * divides the size of the sequence number space, the position of an element
+ * does not change while the window moves forward. The window is moved forward
+ * by advancing winstart and clearing the elements that leave the window, which
+ * is done a word at a time. Hence, no element is required to be shifted when
+ * the window moves forward and the elements outside the window are always
+ * clear.
  *
  * Example:
  *
@@ -93,15 +100,28 @@ public:
    */
   std::size_t GetWinSize (void) const;
   /**
-   * Get a reference to the element in the window having the given distance from
-   * the current winstart. Note that the given distance must be less than the
-   * window size.
+   * Get the element in the window having the given distance from the current
+   * winstart. Note that the given distance must be less than the window size.
    *
    * \param distance the given distance
-   * \return a reference to the element in the window having the given distance
+   * \return the value of the element in the window having the given distance
    *         from the current winstart
    */
-  std::vector<bool>::reference At (std::size_t distance);
+  bool At (std::size_t distance) const;
+  /**
+   * Set the element in the window having the given distance from the current
+   * winstart. Note that the given distance must be less than the window size.
+   *
+   * \param distance the given distance
+   */
+  void Set (std::size_t distance);
+  /**
+   * Get the number of consecutive elements that are set, starting from the
+   * current winstart. The bitmap is scanned a word at a time.
+   *
+   * \return the number of consecutive set elements starting from winstart
+   */
+  std::size_t GetNContiguousSet (void) const;
   /**
    * Advance the current winstart by the given number of positions.
    *
@@ -110,9 +130,22 @@ public:
   void Advance (std::size_t count);
 
 private:
-  uint16_t m_winStart;         ///< window start (sequence number)
-  std::vector<bool> m_window;  ///< window
-  std::size_t m_head;          ///< index of winstart in the vector
+  /**
+   * \param distance the distance from the current winstart
+   * \return the position in the bitmap of the element having the given distance
+   */
+  std::size_t GetPosition (std::size_t distance) const;
+  /**
+   * Clear the given number of elements, starting from the given position.
+   *
+   * \param pos the position of the first element to clear
+   * \param count the number of elements to clear
+   */
+  void Clear (std::size_t pos, std::size_t count);
+
+  uint16_t m_winStart;            ///< window start (sequence number)
+  std::size_t m_winSize;          ///< window size
+  std::vector<uint64_t> m_bitmap; ///< bitmap storing the elements of the window
 };
 
 } //namespace ns3
@@ -117,7 +117,13 @@ ChannelAccessManager::ChannelAccessManager ()
     m_off (false),
     m_slot (Seconds (0.0)),
     m_sifs (Seconds (0.0)),
-    m_phyListener (0)
+    m_phyListener (0),
+    m_mediumVersion (1),
+    m_accessGrantStartVersion (0),
+    m_accessGrantStartExpiry (Seconds (0.0)),
+    m_nAccessGrantStartComputations (0),
+    m_nAccessTimeoutEvents (0),
+    m_nBackoffEndComputations (0)
 {
   NS_LOG_FUNCTION (this);
 }
@@ -176,6 +182,7 @@ ChannelAccessManager::SetSlot (Time slotTime)
 {
   NS_LOG_FUNCTION (this << slotTime);
   m_slot = slotTime;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -183,6 +190,7 @@ ChannelAccessManager::SetSifs (Time sifs)
 {
   NS_LOG_FUNCTION (this << sifs);
   m_sifs = sifs;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -190,6 +198,7 @@ ChannelAccessManager::SetEifsNoDifs (Time eifsNoDifs)
 {
   NS_LOG_FUNCTION (this << eifsNoDifs);
   m_eifsNoDifs = eifsNoDifs;
+  InvalidateAccessGrantStart ();
 }
 
 Time
@@ -204,6 +213,8 @@ ChannelAccessManager::Add (Ptr<Txop> dcf)
 {
   NS_LOG_FUNCTION (this << dcf);
   m_states.push_back (dcf);
+  BackoffEnd backoffEnd = {0, 0, Seconds (0.0)};
+  m_backoffEnds.push_back (backoffEnd);
 }
 
 Time
@@ -242,11 +253,29 @@ ChannelAccessManager::IsBusy (void) const
   return false;
 }
 
+uint64_t
+ChannelAccessManager::GetNAccessGrantStartComputations (void) const
+{
+  return m_nAccessGrantStartComputations;
+}
+
+uint64_t
+ChannelAccessManager::GetNAccessTimeoutEvents (void) const
+{
+  return m_nAccessTimeoutEvents;
+}
+
+uint64_t
+ChannelAccessManager::GetNBackoffEndComputations (void) const
+{
+  return m_nBackoffEndComputations;
+}
+
 bool
 ChannelAccessManager::IsWithinAifs (Ptr<Txop> state) const
 {
   NS_LOG_FUNCTION (this << state);
-  Time ifsEnd = GetAccessGrantStart () + (state->GetAifsn () * m_slot);
+  Time ifsEnd = GetCachedAccessGrantStart () + (state->GetAifsn () * m_slot);
   if (ifsEnd > Simulator::Now ())
     {
       NS_LOG_DEBUG ("IsWithinAifs () true; ifsEnd is at " << ifsEnd.GetSeconds ());
@@ -331,7 +360,7 @@ ChannelAccessManager::DoGrantDcfAccess (void)
     {
       Ptr<Txop> state = *i;
       if (state->IsAccessRequested ()
-          && GetBackoffEndFor (state) <= Simulator::Now () )
+          && GetBackoffEndFor (k) <= Simulator::Now () )
         {
           /**
            * This is the first dcf we find with an expired backoff and which
@@ -345,7 +374,7 @@ ChannelAccessManager::DoGrantDcfAccess (void)
             {
               Ptr<Txop> otherState = *j;
               if (otherState->IsAccessRequested ()
-                  && GetBackoffEndFor (otherState) <= Simulator::Now ())
+                  && GetBackoffEndFor (k) <= Simulator::Now ())
                 {
                   NS_LOG_DEBUG ("dcf " << k << " needs access. backoff expired. internal collision. slots=" <<
                                 otherState->GetBackoffSlots ());
@@ -390,6 +419,7 @@ Time
 ChannelAccessManager::GetAccessGrantStart (bool ignoreNav) const
 {
   NS_LOG_FUNCTION (this);
+  m_nAccessGrantStartComputations++;
   Time rxAccessStart;
   if (m_lastRxEnd <= Simulator::Now ())
     {
@@ -440,34 +470,73 @@ ChannelAccessManager::GetAccessGrantStart (bool ignoreNav) const
 }
 
 Time
-ChannelAccessManager::GetBackoffStartFor (Ptr<Txop> state)
+ChannelAccessManager::GetCachedAccessGrantStart (void) const
 {
-  NS_LOG_FUNCTION (this << state);
+  NS_LOG_FUNCTION (this);
+  if (Simulator::Now () >= m_accessGrantStartExpiry)
+    {
+      m_mediumVersion++;
+    }
+  if (m_accessGrantStartVersion != m_mediumVersion)
+    {
+      m_accessGrantStart = GetAccessGrantStart ();
+      m_accessGrantStartVersion = m_mediumVersion;
+      // during a reception, the EIFS that follows an erroneous reception
+      // is not accounted for yet, so the access grant start is only valid
+      // until the end of the reception
+      m_accessGrantStartExpiry = (m_lastRxEnd > Simulator::Now ()) ? m_lastRxEnd : Time::Max ();
+    }
+  return m_accessGrantStart;
+}
+
+void
+ChannelAccessManager::InvalidateAccessGrantStart (void)
+{
+  m_mediumVersion++;
+}
+
+Time
+ChannelAccessManager::GetBackoffStartFor (Ptr<Txop> state, Time accessGrantStart) const
+{
+  NS_LOG_FUNCTION (this << state << accessGrantStart);
   Time mostRecentEvent = MostRecent ({state->GetBackoffStart (),
-                                     GetAccessGrantStart () + (state->GetAifsn () * m_slot)});
+                                     accessGrantStart + (state->GetAifsn () * m_slot)});
 
   return mostRecentEvent;
 }
 
 Time
-ChannelAccessManager::GetBackoffEndFor (Ptr<Txop> state)
+ChannelAccessManager::GetBackoffEndFor (uint32_t i) const
 {
-  NS_LOG_FUNCTION (this << state);
-  NS_LOG_DEBUG ("Backoff start: " << GetBackoffStartFor (state).As (Time::US) <<
-                " end: " << (GetBackoffStartFor (state) + state->GetBackoffSlots () * m_slot).As (Time::US));
-  return GetBackoffStartFor (state) + (state->GetBackoffSlots () * m_slot);
+  NS_LOG_FUNCTION (this << i);
+  Time accessGrantStart = GetCachedAccessGrantStart ();
+  Ptr<Txop> state = m_states[i];
+  BackoffEnd &cached = m_backoffEnds[i];
+  if (cached.mediumVersion != m_mediumVersion || cached.backoffVersion != state->m_backoffVersion)
+    {
+      m_nBackoffEndComputations++;
+      Time backoffStart = GetBackoffStartFor (state, accessGrantStart);
+      cached.end = backoffStart + (state->GetBackoffSlots () * m_slot);
+      cached.mediumVersion = m_mediumVersion;
+      cached.backoffVersion = state->m_backoffVersion;
+      NS_LOG_DEBUG ("Backoff start: " << backoffStart.As (Time::US) <<
+                    " end: " << cached.end.As (Time::US));
+    }
+  return cached.end;
 }
 
 void
 ChannelAccessManager::UpdateBackoff (void)
 {
   NS_LOG_FUNCTION (this);
+  // updating the backoff of a Txop does not change the access grant start
+  Time accessGrantStart = GetCachedAccessGrantStart ();
   uint32_t k = 0;
   for (States::iterator i = m_states.begin (); i != m_states.end (); i++, k++)
     {
       Ptr<Txop> state = *i;
 
-      Time backoffStart = GetBackoffStartFor (state);
+      Time backoffStart = GetBackoffStartFor (state, accessGrantStart);
       if (backoffStart <= Simulator::Now ())
         {
           uint32_t nIntSlots = ((Simulator::Now () - backoffStart) / m_slot).GetHigh ();
@@ -504,12 +573,13 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
    */
   bool accessTimeoutNeeded = false;
   Time expectedBackoffEnd = Simulator::GetMaximumSimulationTime ();
-  for (States::iterator i = m_states.begin (); i != m_states.end (); i++)
+  uint32_t k = 0;
+  for (States::iterator i = m_states.begin (); i != m_states.end (); i++, k++)
     {
       Ptr<Txop> state = *i;
       if (state->IsAccessRequested ())
         {
-          Time tmp = GetBackoffEndFor (state);
+          Time tmp = GetBackoffEndFor (k);
           if (tmp > Simulator::Now ())
             {
               accessTimeoutNeeded = true;
@@ -522,6 +592,8 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
     {
       NS_LOG_DEBUG ("expected backoff end=" << expectedBackoffEnd);
       Time expectedBackoffDelay = expectedBackoffEnd - Simulator::Now ();
+      // the access timeout is only rescheduled if the earliest backoff end
+      // moved before the time the access timeout is scheduled at
       if (m_accessTimeout.IsRunning ()
           && Simulator::GetDelayLeft (m_accessTimeout) > expectedBackoffDelay)
         {
@@ -531,6 +603,7 @@ ChannelAccessManager::DoRestartAccessTimeoutIfNeeded (void)
         {
           m_accessTimeout = Simulator::Schedule (expectedBackoffDelay,
                                                  &ChannelAccessManager::AccessTimeout, this);
+          m_nAccessTimeoutEvents++;
         }
     }
 }
@@ -544,6 +617,7 @@ ChannelAccessManager::NotifyRxStartNow (Time duration)
   m_lastRxStart = Simulator::Now ();
   m_lastRxDuration = duration;
   m_lastRxEnd = m_lastRxStart + m_lastRxDuration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -554,6 +628,7 @@ ChannelAccessManager::NotifyRxEndOkNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxDuration = m_lastRxEnd - m_lastRxStart;
   m_lastRxReceivedOk = true;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -564,6 +639,7 @@ ChannelAccessManager::NotifyRxEndErrorNow (void)
   m_lastRxEnd = Simulator::Now ();
   m_lastRxDuration = m_lastRxEnd - m_lastRxStart;
   m_lastRxReceivedOk = false;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -578,11 +654,13 @@ ChannelAccessManager::NotifyTxStartNow (Time duration)
       m_lastRxEnd = Simulator::Now ();
       m_lastRxDuration = m_lastRxEnd - m_lastRxStart;
       m_lastRxReceivedOk = true;
+      InvalidateAccessGrantStart ();
     }
   NS_LOG_DEBUG ("tx start for " << duration);
   UpdateBackoff ();
   m_lastTxStart = Simulator::Now ();
   m_lastTxDuration = duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -591,8 +669,15 @@ ChannelAccessManager::NotifyMaybeCcaBusyStartNow (Time duration)
   NS_LOG_FUNCTION (this << duration);
   NS_LOG_DEBUG ("busy start for " << duration);
   UpdateBackoff ();
+  Time lastBusyEnd = m_lastBusyStart + m_lastBusyDuration;
   m_lastBusyStart = Simulator::Now ();
   m_lastBusyDuration = duration;
+  // with channel bonding, the same busy period is usually notified for
+  // several sub-bands, which leaves the access grant start unchanged
+  if (m_lastBusyStart + m_lastBusyDuration != lastBusyEnd)
+    {
+      InvalidateAccessGrantStart ();
+    }
 }
 
 void
@@ -651,6 +736,7 @@ ChannelAccessManager::NotifySwitchingStartNow (Time duration)
   NS_LOG_DEBUG ("switching start for " << duration);
   m_lastSwitchingStart = Simulator::Now ();
   m_lastSwitchingDuration = duration;
+  InvalidateAccessGrantStart ();
 
 }
 
@@ -740,6 +826,7 @@ ChannelAccessManager::NotifyNavResetNow (Time duration)
   UpdateBackoff ();
   m_lastNavStart = Simulator::Now ();
   m_lastNavDuration = duration;
+  InvalidateAccessGrantStart ();
   /**
    * If the nav reset indicates an end-of-nav which is earlier
    * than the previous end-of-nav, the expected end of backoff
@@ -762,6 +849,7 @@ ChannelAccessManager::NotifyNavStartNow (Time duration)
     {
       m_lastNavStart = Simulator::Now ();
       m_lastNavDuration = duration;
+      InvalidateAccessGrantStart ();
     }
 }
 
@@ -771,6 +859,7 @@ ChannelAccessManager::NotifyAckTimeoutStartNow (Time duration)
   NS_LOG_FUNCTION (this << duration);
   NS_ASSERT (m_lastAckTimeoutEnd < Simulator::Now ());
   m_lastAckTimeoutEnd = Simulator::Now () + duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -778,6 +867,7 @@ ChannelAccessManager::NotifyAckTimeoutResetNow (void)
 {
   NS_LOG_FUNCTION (this);
   m_lastAckTimeoutEnd = Simulator::Now ();
+  InvalidateAccessGrantStart ();
   DoRestartAccessTimeoutIfNeeded ();
 }
 
@@ -786,6 +876,7 @@ ChannelAccessManager::NotifyCtsTimeoutStartNow (Time duration)
 {
   NS_LOG_FUNCTION (this << duration);
   m_lastCtsTimeoutEnd = Simulator::Now () + duration;
+  InvalidateAccessGrantStart ();
 }
 
 void
@@ -793,6 +884,7 @@ ChannelAccessManager::NotifyCtsTimeoutResetNow (void)
 {
   NS_LOG_FUNCTION (this);
   m_lastCtsTimeoutEnd = Simulator::Now ();
+  InvalidateAccessGrantStart ();
   DoRestartAccessTimeoutIfNeeded ();
 }
 
@@ -220,6 +220,28 @@ public:
    */
   bool IsBusy (void) const;
 
+  /**
+   * Get the number of times the time at which access can start to be granted
+   * has been computed. This counter is meant to measure the cost of the
+   * backoff bookkeeping, which is performed upon every PHY or MAC notification.
+   *
+   * \return the number of computations of the access grant start
+   */
+  uint64_t GetNAccessGrantStartComputations (void) const;
+  /**
+   * Get the number of access timeout events scheduled so far.
+   *
+   * \return the number of access timeout events scheduled so far
+   */
+  uint64_t GetNAccessTimeoutEvents (void) const;
+  /**
+   * Get the number of times the backoff end of a Txop has been computed
+   * (rather than read from the per-Txop cache).
+   *
+   * \return the number of computations of a backoff end
+   */
+  uint64_t GetNBackoffEndComputations (void) const;
+
 
 protected:
   // Inherited from ns3::Object
@@ -248,24 +270,41 @@ private:
    * \returns the absolute time at which access could start to be granted
    */
   Time GetAccessGrantStart (bool ignoreNav = false) const;
+  /**
+   * Return the time returned by GetAccessGrantStart (NAV included), which
+   * is only computed again after the medium state changed.
+   *
+   * \returns the absolute time at which access could start to be granted
+   */
+  Time GetCachedAccessGrantStart (void) const;
+  /**
+   * Mark the cached access grant start, and hence the cached backoff ends
+   * of all the Txops, as stale. This is called whenever one of the times
+   * the access grant start depends on changes.
+   */
+  void InvalidateAccessGrantStart (void);
   /**
    * Return the time when the backoff procedure
    * started for the given Txop.
    *
    * \param state
+   * \param accessGrantStart the time returned by GetAccessGrantStart, which
+   *        is the same for all the Txops and hence computed once by the caller
    *
    * \return the time when the backoff procedure started
    */
-  Time GetBackoffStartFor (Ptr<Txop> state);
+  Time GetBackoffStartFor (Ptr<Txop> state, Time accessGrantStart) const;
   /**
    * Return the time when the backoff procedure
-   * ended (or will ended) for the given Txop.
+   * ended (or will ended) for the i-th Txop. The backoff end is cached and
+   * only computed again after the medium state or the backoff of the Txop
+   * changed.
    *
-   * \param state
+   * \param i the index of the Txop in the order it was added
    *
    * \return the time when the backoff procedure ended (or will ended)
    */
-  Time GetBackoffEndFor (Ptr<Txop> state);
+  Time GetBackoffEndFor (uint32_t i) const;
 
   void DoRestartAccessTimeoutIfNeeded (void);
 
@@ -319,6 +358,24 @@ private:
   Time m_sifs;                  //!< the SIFS time
   PhyListener* m_phyListener;   //!< the phy listener
   Ptr<WifiPhy> m_phy;           //!< Ptr to the PHY
+
+  /// Backoff end of a Txop, with the versions it was computed for
+  struct BackoffEnd
+  {
+    uint64_t mediumVersion;  //!< the version of the medium state
+    uint64_t backoffVersion; //!< the version of the backoff of the Txop
+    Time end;                //!< the backoff end
+  };
+
+  mutable uint64_t m_mediumVersion;            //!< incremented whenever the access grant start may change
+  mutable uint64_t m_accessGrantStartVersion;  //!< the medium version of the cached access grant start
+  mutable Time m_accessGrantStart;             //!< the cached access grant start
+  mutable Time m_accessGrantStartExpiry;       //!< the time from which the cached access grant start is stale
+  mutable std::vector<BackoffEnd> m_backoffEnds;  //!< the cached backoff ends, in the order of m_states
+
+  mutable uint64_t m_nAccessGrantStartComputations; //!< number of computations of the access grant start
+  uint64_t m_nAccessTimeoutEvents;                  //!< number of access timeout events scheduled
+  mutable uint64_t m_nBackoffEndComputations;       //!< number of computations of a backoff end
 };
 
 } //namespace ns3
@@ -44,6 +44,12 @@ ChannelBondingManager::SetPhy (const Ptr<WifiPhy> phy)
   m_phy = phy;
 }
 
+uint8_t
+ChannelBondingManager::GetPuncturedSubchannels (uint16_t channelWidth) const
+{
+  return 0;
+}
+
 void
 ChannelBondingManager::DoDispose (void)
 {
@@ -57,6 +57,18 @@ public:
    */
   virtual uint16_t GetUsableChannelWidth (WifiMode mode) = 0;
 
+  /**
+   * Returns the 20 MHz subchannels to puncture for a transmission over the
+   * channel width returned by the last call to GetUsableChannelWidth.
+   * Bit i corresponds to the i-th 20 MHz subchannel of the transmission,
+   * starting from the lowest frequency. No subchannel is punctured by default.
+   *
+   * \param channelWidth the channel width (in MHz) of the transmission
+   *
+   * \return the bitmap of punctured 20 MHz subchannels
+   */
+  virtual uint8_t GetPuncturedSubchannels (uint16_t channelWidth) const;
+
 
 protected:
   virtual void DoDispose (void);
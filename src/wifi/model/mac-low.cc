@@ -609,9 +609,9 @@ MacLow::StartTransmission (Ptr<WifiMacQueueItem> mpdu,
 
       if (mpduList.size () > 1)
         {
+          NS_LOG_DEBUG ("tx unicast A-MPDU containing " << mpduList.size () << " MPDUs");
           m_currentPacket = Create<WifiPsdu> (mpduList);
 
-          NS_LOG_DEBUG ("tx unicast A-MPDU containing " << mpduList.size () << " MPDUs");
           qosTxop->SetAmpduExist (hdr.GetAddr1 (), true);
         }
       else if (m_currentTxVector.GetMode ().GetModulationClass () == WIFI_MOD_CLASS_VHT
@@ -900,6 +900,11 @@ MacLow::ReceiveOk (Ptr<WifiMacQueueItem> mpdu, RxSignalInfo rxSignalInfo, WifiTx
         }
       if (gotAck)
         {
+          if (!m_txParams.HasNextPacket ())
+            {
+              // report the bytes of the acknowledged MSDUs (BQL)
+              m_currentTxop->NotifyCompletedMpdus ({m_currentPacket->begin (), m_currentPacket->end ()});
+            }
           m_currentTxop->GotAck ();
         }
       if (m_txParams.HasNextPacket ())
@@ -941,6 +946,20 @@ MacLow::ReceiveOk (Ptr<WifiMacQueueItem> mpdu, RxSignalInfo rxSignalInfo, WifiTx
       packet->RemoveHeader (blockAck);
       m_blockAckTimeoutEvent.Cancel ();
       NotifyAckTimeoutResetNow ();
+      // report the bytes of the acknowledged MSDUs (BQL)
+      std::vector<Ptr<const WifiMacQueueItem>> ackedMpdus;
+      for (const auto& mpdu : *PeekPointer (m_currentPacket))
+        {
+          const WifiMacHeader& mpduHdr = mpdu->GetHeader ();
+          if (mpduHdr.IsQosData ()
+              && (blockAck.IsBasic ()
+                  ? blockAck.IsFragmentReceived (mpduHdr.GetSequenceNumber (), mpduHdr.GetFragmentNumber ())
+                  : blockAck.IsPacketReceived (mpduHdr.GetSequenceNumber ())))
+            {
+              ackedMpdus.push_back (mpdu);
+            }
+        }
+      m_currentTxop->NotifyCompletedMpdus (ackedMpdus);
       m_currentTxop->GotBlockAck (&blockAck, hdr.GetAddr2 (), rxSnr, txVector.GetMode (), tag.Get ());
       // start next packet if TXOP remains, otherwise contend for accessing the channel again
       if (m_currentTxop->IsQosTxop () && m_currentTxop->GetTxopLimit ().IsStrictlyPositive ()
@@ -2199,6 +2218,18 @@ MacLow::EndTxNoAck (void)
   if (!m_cfAckInfo.expectCfAck)
     {
       Ptr<Txop> txop = m_currentTxop;
+      // report the bytes of the MSDUs that are not going to be acknowledged (BQL)
+      std::vector<Ptr<const WifiMacQueueItem>> mpdus;
+      for (const auto& mpdu : *PeekPointer (m_currentPacket))
+        {
+          const WifiMacHeader& mpduHdr = mpdu->GetHeader ();
+          if (mpduHdr.GetAddr1 ().IsGroup ()
+              || (mpduHdr.IsQosData () && mpduHdr.GetQosAckPolicy () == WifiMacHeader::NO_ACK))
+            {
+              mpdus.push_back (mpdu);
+            }
+        }
+      txop->NotifyCompletedMpdus (mpdus);
       txop->EndTxNoAck ();
     }
   if (!IsCfPeriod ())
@@ -2213,6 +2244,8 @@ MacLow::SendAckAfterData (Mac48Address source, Time duration, WifiTxVector txVec
   NS_LOG_FUNCTION (this << source << duration << txVector << dataSnr);
   // send an ACK, after SIFS, when you receive a packet
   WifiTxVector ackTxVector = GetAckTxVector (source, txVector.GetMode (), txVector.GetChannelWidth ());
+  //do not respond on the 20 MHz subchannels that were punctured in the soliciting PPDU
+  ackTxVector.SetPuncturedSubchannels (txVector.GetPuncturedSubchannels ());
   WifiMacHeader ack;
   ack.SetType (WIFI_MAC_CTL_ACK);
   ack.SetDsNotFrom ();
@@ -2479,6 +2512,7 @@ MacLow::SendBlockAckResponse (const CtrlBAckResponseHeader* blockAck, Mac48Addre
   hdr.SetNoMoreFragments ();
 
   WifiTxVector blockAckReqTxVector = GetBlockAckTxVector (originator, txVector.GetMode (), txVector.GetChannelWidth ());
+  blockAckReqTxVector.SetPuncturedSubchannels (txVector.GetPuncturedSubchannels ());
 
   if (immediate)
     {
@@ -2539,6 +2573,7 @@ MacLow::SendBlockAckAfterAmpdu (uint8_t tid, Mac48Address originator, Time durat
       (*i).second.FillBlockAckBitmap (&blockAck);
 
       WifiTxVector blockAckTxVector = GetBlockAckTxVector (originator, blockAckReqTxVector.GetMode (), blockAckReqTxVector.GetChannelWidth ());
+      blockAckTxVector.SetPuncturedSubchannels (blockAckReqTxVector.GetPuncturedSubchannels ());
 
       SendBlockAckResponse (&blockAck, originator, immediate, duration, blockAckTxVector, rxSnr);
     }
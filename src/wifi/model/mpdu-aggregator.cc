@@ -37,6 +37,7 @@
 #include "wifi-mac.h"
 #include "ctrl-headers.h"
 #include "wifi-mac-trailer.h"
+#include "regular-wifi-mac.h"
 
 NS_LOG_COMPONENT_DEFINE ("MpduAggregator");
 
@@ -106,7 +107,7 @@ MpduAggregator::GetSizeIfAggregated (uint32_t mpduSize, uint32_t ampduSize)
 {
   NS_LOG_FUNCTION (mpduSize << ampduSize);
 
-  return ampduSize + CalculatePadding (ampduSize) + 4 + mpduSize;
+  return ampduSize + CalculatePadding (ampduSize) + AMPDU_SUBFRAME_HEADER_SIZE + mpduSize;
 }
 
 uint32_t
@@ -123,28 +124,9 @@ MpduAggregator::GetMaxAmpduSize (Mac48Address recipient, uint8_t tid,
   NS_ASSERT (stationManager);
 
   // Find the A-MPDU max size configured on this device
-  UintegerValue size;
-
-  switch (ac)
-    {
-      case AC_BE:
-        device->GetMac ()->GetAttribute ("BE_MaxAmpduSize", size);
-        break;
-      case AC_BK:
-        device->GetMac ()->GetAttribute ("BK_MaxAmpduSize", size);
-        break;
-      case AC_VI:
-        device->GetMac ()->GetAttribute ("VI_MaxAmpduSize", size);
-        break;
-      case AC_VO:
-        device->GetMac ()->GetAttribute ("VO_MaxAmpduSize", size);
-        break;
-      default:
-        NS_ABORT_MSG ("Unknown AC " << ac);
-        return 0;
-    }
-
-  uint32_t maxAmpduSize = size.Get ();
+  Ptr<RegularWifiMac> mac = DynamicCast<RegularWifiMac> (device->GetMac ());
+  NS_ASSERT (mac);
+  uint32_t maxAmpduSize = mac->GetMaxAmpduSize (ac);
 
   if (maxAmpduSize == 0)
     {
@@ -210,7 +192,7 @@ MpduAggregator::GetNextAmpdu (Ptr<const WifiMacQueueItem> mpdu, WifiTxVector txV
                               Time ppduDurationLimit) const
 {
   NS_LOG_FUNCTION (this << *mpdu << ppduDurationLimit);
-  std::vector<Ptr<WifiMacQueueItem>> mpduList;
+  AmpduBuilder ampdu;
   Mac48Address recipient = mpdu->GetHeader ().GetAddr1 ();
 
   NS_ASSERT (mpdu->GetHeader ().IsQosData () && !recipient.IsBroadcast ());
@@ -225,7 +207,7 @@ MpduAggregator::GetNextAmpdu (Ptr<const WifiMacQueueItem> mpdu, WifiTxVector txV
   if (maxAmpduSize == 0)
     {
       NS_LOG_DEBUG ("A-MPDU aggregation disabled");
-      return mpduList;
+      return ampdu.TakeMpduList ();
     }
 
   //Have to make sure that the block ACK agreement is established before sending an A-MPDU
@@ -235,7 +217,7 @@ MpduAggregator::GetNextAmpdu (Ptr<const WifiMacQueueItem> mpdu, WifiTxVector txV
       uint16_t startingSequenceNumber = edcaIt->second->GetBaStartingSequence (recipient, tid);
       Ptr<WifiMacQueueItem> nextMpdu;
       uint16_t maxMpdus = edcaIt->second->GetBaBufferSize (recipient, tid);
-      uint32_t currentAmpduSize = 0;
+      ampdu.Reserve (maxMpdus);
 
       // check if the received MPDU meets the size and duration constraints
       if (edcaIt->second->GetLow ()->IsWithinSizeAndTimeLimits (mpdu, txVector, 0, ppduDurationLimit))
@@ -256,43 +238,99 @@ MpduAggregator::GetNextAmpdu (Ptr<const WifiMacQueueItem> mpdu, WifiTxVector txV
            *     transmitted (e.g., because the RTS/CTS exchange failed)
            */
 
-          currentAmpduSize = GetSizeIfAggregated (nextMpdu->GetSize (), currentAmpduSize);
-
-          NS_LOG_DEBUG ("Adding packet with sequence number " << nextMpdu->GetHeader ().GetSequenceNumber ()
-                        << " to A-MPDU, packet size = " << nextMpdu->GetSize ()
-                        << ", A-MPDU size = " << currentAmpduSize);
-
           // Always use the Normal Ack policy (Implicit Block Ack), for now
           nextMpdu->GetHeader ().SetQosAckPolicy (WifiMacHeader::NORMAL_ACK);
 
-          mpduList.push_back (nextMpdu);
+          ampdu.Add (nextMpdu);
+
+          NS_LOG_DEBUG ("Adding packet with sequence number " << nextMpdu->GetHeader ().GetSequenceNumber ()
+                        << " to A-MPDU, packet size = " << nextMpdu->GetSize ()
+                        << ", A-MPDU size = " << ampdu.GetSize ());
 
           // If allowed by the BA agreement, get the next MPDU
           nextMpdu = 0;
 
+          if (ampdu.GetNMpdus () >= maxMpdus)
+            {
+              // no sequence number can be in the transmit window anymore
+              break;
+            }
+
           Ptr<const WifiMacQueueItem> peekedMpdu;
           peekedMpdu = edcaIt->second->PeekNextFrame (tid, recipient);
           if (peekedMpdu != 0)
             {
               uint16_t currentSequenceNumber = peekedMpdu->GetHeader ().GetSequenceNumber ();
 
-              if (IsInWindow (currentSequenceNumber, startingSequenceNumber, maxMpdus))
+              if (IsInWindow (currentSequenceNumber, startingSequenceNumber, maxMpdus)
+                  && ampdu.GetSizeIfAdded (peekedMpdu->GetSize ()) <= maxAmpduSize)
                 {
                   // dequeue the frame if constraints on size and duration limit are met.
                   // Note that the dequeued MPDU differs from the peeked MPDU if A-MSDU
                   // aggregation is performed during the dequeue
                   NS_LOG_DEBUG ("Trying to aggregate another MPDU");
                   nextMpdu = edcaIt->second->DequeuePeekedFrame (peekedMpdu, txVector, true,
-                                                                 currentAmpduSize, ppduDurationLimit);
+                                                                 ampdu.GetSize (), ppduDurationLimit);
                 }
             }
         }
-      if (mpduList.size () == 1)
+      if (ampdu.GetNMpdus () == 1)
         {
           // return an empty vector if it was not possible to aggregate at least two MPDUs
-          mpduList.clear ();
+          ampdu.Clear ();
         }
     }
+  return ampdu.TakeMpduList ();
+}
+
+AmpduBuilder::AmpduBuilder ()
+  : m_size (0)
+{
+}
+
+void
+AmpduBuilder::Reserve (std::size_t nMpdus)
+{
+  m_mpduList.reserve (nMpdus);
+}
+
+uint32_t
+AmpduBuilder::GetSizeIfAdded (uint32_t mpduSize) const
+{
+  return MpduAggregator::GetSizeIfAggregated (mpduSize, m_size);
+}
+
+void
+AmpduBuilder::Add (Ptr<WifiMacQueueItem> mpdu)
+{
+  m_size = GetSizeIfAdded (mpdu->GetSize ());
+  m_mpduList.push_back (mpdu);
+}
+
+uint32_t
+AmpduBuilder::GetSize (void) const
+{
+  return m_size;
+}
+
+std::size_t
+AmpduBuilder::GetNMpdus (void) const
+{
+  return m_mpduList.size ();
+}
+
+void
+AmpduBuilder::Clear (void)
+{
+  m_mpduList.clear ();
+  m_size = 0;
+}
+
+std::vector<Ptr<WifiMacQueueItem>>
+AmpduBuilder::TakeMpduList (void)
+{
+  std::vector<Ptr<WifiMacQueueItem>> mpduList (std::move (m_mpduList));
+  Clear ();
   return mpduList;
 }
 
@@ -144,10 +144,76 @@ public:
    */
   static AmpduSubframeHeader GetAmpduSubframeHeader (uint16_t mpduSize, bool isSingle);
 
+  /// Size in bytes of an A-MPDU subframe header
+  static const uint8_t AMPDU_SUBFRAME_HEADER_SIZE = 4;
+
 private:
   EdcaQueues m_edca;   //!< the map of EDCA queues
 };
 
+
+/**
+ * \brief Incremental builder of A-MPDUs
+ * \ingroup wifi
+ *
+ * MPDUs are appended one at a time while the size of the resulting A-MPDU
+ * (A-MPDU subframe headers and padding included) is kept up to date, so that
+ * checking whether another MPDU fits takes constant time and does not require
+ * any packet to be serialized. The list of MPDUs is then moved out of the
+ * builder (e.g., to a WifiPsdu) without copying the packets.
+ */
+class AmpduBuilder
+{
+public:
+  AmpduBuilder ();
+
+  /**
+   * Reserve room for the given number of MPDUs.
+   *
+   * \param nMpdus the maximum number of MPDUs expected in the A-MPDU
+   */
+  void Reserve (std::size_t nMpdus);
+
+  /**
+   * \param mpduSize the size of a candidate MPDU
+   * \return the size of the A-MPDU if the candidate MPDU was appended
+   */
+  uint32_t GetSizeIfAdded (uint32_t mpduSize) const;
+
+  /**
+   * Append an MPDU to the A-MPDU.
+   *
+   * \param mpdu the MPDU to append
+   */
+  void Add (Ptr<WifiMacQueueItem> mpdu);
+
+  /**
+   * \return the current size of the A-MPDU
+   */
+  uint32_t GetSize (void) const;
+
+  /**
+   * \return the number of MPDUs in the A-MPDU
+   */
+  std::size_t GetNMpdus (void) const;
+
+  /**
+   * Remove all the MPDUs from the A-MPDU.
+   */
+  void Clear (void);
+
+  /**
+   * Move the list of MPDUs out of this builder, which is left empty.
+   *
+   * \return the list of MPDUs
+   */
+  std::vector<Ptr<WifiMacQueueItem>> TakeMpduList (void);
+
+private:
+  std::vector<Ptr<WifiMacQueueItem>> m_mpduList; //!< the MPDUs of the A-MPDU
+  uint32_t m_size;                               //!< the size of the A-MPDU
+};
+
 }  //namespace ns3
 
 #endif /* MPDU_AGGREGATOR_H */
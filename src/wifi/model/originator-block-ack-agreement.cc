@@ -101,10 +101,8 @@ OriginatorBlockAckAgreement::InitTxWindow (void)
 void
 OriginatorBlockAckAgreement::AdvanceTxWindow (void)
 {
-  while (m_txWindow.At (0))
-    {
-      m_txWindow.Advance (1); // reset the current head -- ensures loop termination
-    }
+  // move winstart to the nearest unacknowledged MPDU in a single step
+  m_txWindow.Advance (m_txWindow.GetNContiguousSet ());
 }
 
 void
@@ -134,6 +132,17 @@ OriginatorBlockAckAgreement::NotifyTransmittedMpdu (Ptr<const WifiMacQueueItem>
 
 void
 OriginatorBlockAckAgreement::NotifyAckedMpdu (Ptr<const WifiMacQueueItem> mpdu)
+{
+  MarkAckedMpdu (mpdu);
+
+  // the starting sequence number can be advanced to the sequence number of
+  // the nearest unacknowledged MPDU
+  AdvanceTxWindow ();
+  NS_LOG_DEBUG ("Starting sequence number: " << m_txWindow.GetWinStart ());
+}
+
+void
+OriginatorBlockAckAgreement::MarkAckedMpdu (Ptr<const WifiMacQueueItem> mpdu)
 {
   uint16_t mpduSeqNumber = mpdu->GetHeader ().GetSequenceNumber ();
   uint16_t distance = GetDistance (mpduSeqNumber);
@@ -147,12 +156,7 @@ OriginatorBlockAckAgreement::NotifyAckedMpdu (Ptr<const WifiMacQueueItem> mpdu)
   // when an MPDU is transmitted, the transmit window is updated such that the
   // transmitted MPDU is in the window, hence we cannot be notified of the
   // acknowledgment of an MPDU which is beyond the transmit window
-  m_txWindow.At (distance) = true;
-
-  // the starting sequence number can be advanced to the sequence number of
-  // the nearest unacknowledged MPDU
-  AdvanceTxWindow ();
-  NS_LOG_DEBUG ("Starting sequence number: " << m_txWindow.GetWinStart ());
+  m_txWindow.Set (distance);
 }
 
 void
@@ -185,6 +185,14 @@ public:
    * \param mpdu the acknowledged MPDU
    */
   void NotifyAckedMpdu (Ptr<const WifiMacQueueItem> mpdu);
+  /**
+   * Record that the given MPDU has been acknowledged, without advancing the
+   * transmit window. When processing a Block Ack, all the acknowledged MPDUs
+   * are marked first and the transmit window is then advanced just once.
+   *
+   * \param mpdu the acknowledged MPDU
+   */
+  void MarkAckedMpdu (Ptr<const WifiMacQueueItem> mpdu);
   /**
    * Advance the transmit window beyond the MPDU that has been reported to
    * be discarded.
@@ -0,0 +1,165 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2019 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Sébastien Deronne <sebastien.deronne@gmail.com>
+ */
+
+#include "ns3/log.h"
+#include "ns3/double.h"
+#include "puncturing-channel-bonding-manager.h"
+#include "wifi-phy.h"
+
+namespace ns3 {
+
+NS_LOG_COMPONENT_DEFINE ("PuncturingChannelBondingManager");
+NS_OBJECT_ENSURE_REGISTERED (PuncturingChannelBondingManager);
+
+PuncturingChannelBondingManager::PuncturingChannelBondingManager ()
+  : ChannelBondingManager (),
+    m_usableChannelWidth (0),
+    m_primaryIndex (0),
+    m_busySubchannels (0)
+{
+  NS_LOG_FUNCTION (this);
+}
+
+TypeId
+PuncturingChannelBondingManager::GetTypeId (void)
+{
+  static ns3::TypeId tid = ns3::TypeId ("ns3::PuncturingChannelBondingManager")
+    .SetParent<ChannelBondingManager> ()
+    .SetGroupName ("Wifi")
+    .AddConstructor<PuncturingChannelBondingManager> ()
+    .AddAttribute ("CcaEdThresholdSecondary",
+                   "The energy of a non Wi-Fi received signal should be higher than "
+                   "this threshold (dbm) to allow the PHY layer to declare CCA BUSY state. "
+                   "This check is performed on the secondary channel(s) only.",
+                   DoubleValue (-72.0),
+                   MakeDoubleAccessor (&PuncturingChannelBondingManager::SetCcaEdThresholdSecondary),
+                   MakeDoubleChecker<double> ())
+  ;
+  return tid;
+}
+
+void
+PuncturingChannelBondingManager::SetCcaEdThresholdSecondary (double threshold)
+{
+  NS_LOG_FUNCTION (this << threshold);
+  m_ccaEdThresholdSecondaryDbm = threshold;
+  if (m_phy)
+    {
+      m_phy->AddCcaEdThresholdSecondary (threshold);
+    }
+}
+
+void
+PuncturingChannelBondingManager::SetPhy (const Ptr<WifiPhy> phy)
+{
+  phy->AddCcaEdThresholdSecondary (m_ccaEdThresholdSecondaryDbm);
+  ChannelBondingManager::SetPhy (phy);
+}
+
+bool
+PuncturingChannelBondingManager::IsPuncturingPatternAllowed (uint16_t channelWidth, uint8_t primaryIndex, uint8_t punctured)
+{
+  uint8_t nSubchannels = channelWidth / 20;
+  if (punctured == 0 || (punctured >> nSubchannels) != 0 || (punctured & (1 << primaryIndex)))
+    {
+      return false;
+    }
+  if (channelWidth == 80)
+    {
+      //a single 20 MHz subchannel other than the primary one
+      return ((punctured & (punctured - 1)) == 0);
+    }
+  if (channelWidth == 160)
+    {
+      uint8_t primary80Mask = (primaryIndex < 4) ? 0x0f : 0xf0;
+      uint8_t secondary20Mask = 1 << (primaryIndex ^ 0x01);
+      if ((punctured & primary80Mask) & ~secondary20Mask)
+        {
+          //only the secondary 20 MHz subchannel of the primary 80 MHz can be punctured
+          return false;
+        }
+      if ((punctured & ~primary80Mask) == static_cast<uint8_t> (~primary80Mask))
+        {
+          //the whole secondary 80 MHz is busy: use the 80 MHz channel instead
+          return false;
+        }
+      return true;
+    }
+  return false;
+}
+
+uint16_t
+PuncturingChannelBondingManager::GetUsableChannelWidth (WifiMode mode)
+{
+  m_usableChannelWidth = m_phy->GetChannelWidth ();
+  m_busySubchannels = 0;
+  if (m_phy->GetChannelWidth () < 40)
+    {
+      return m_usableChannelWidth;
+    }
+  m_primaryIndex = m_phy->GetPrimaryBandIndex (20);
+  for (uint8_t i = 0; i < m_phy->GetChannelWidth () / 20; i++)
+    {
+      if ((i != m_primaryIndex)
+          && (m_phy->GetDelaySinceSubchannelIsIdle (i, m_ccaEdThresholdSecondaryDbm) < m_phy->GetPifs ()))
+        {
+          m_busySubchannels |= (1 << i);
+        }
+    }
+  NS_LOG_DEBUG ("Busy 20 MHz subchannels: " << +m_busySubchannels);
+  m_usableChannelWidth = 20;
+  for (uint16_t width = m_phy->GetChannelWidth (); width > 20; )
+    {
+      uint8_t punctured = GetBusySubchannels (width);
+      if ((punctured == 0)
+          || IsPuncturingPatternAllowed (width, m_primaryIndex % (width / 20), punctured))
+        {
+          m_usableChannelWidth = width;
+          break;
+        }
+      width /= 2;
+    }
+  return m_usableChannelWidth;
+}
+
+uint8_t
+PuncturingChannelBondingManager::GetBusySubchannels (uint16_t channelWidth) const
+{
+  uint8_t nSubchannels = channelWidth / 20;
+  uint8_t startIndex = (m_primaryIndex / nSubchannels) * nSubchannels;
+  return (m_busySubchannels >> startIndex) & ((1 << nSubchannels) - 1);
+}
+
+uint8_t
+PuncturingChannelBondingManager::GetPuncturedSubchannels (uint16_t channelWidth) const
+{
+  if (channelWidth < 80 || channelWidth > m_usableChannelWidth)
+    {
+      return 0;
+    }
+  uint8_t punctured = GetBusySubchannels (channelWidth);
+  if (punctured != 0)
+    {
+      NS_LOG_DEBUG ("Puncture subchannels " << +punctured << " of the " << channelWidth << " MHz channel");
+    }
+  return punctured;
+}
+
+} //namespace ns3
@@ -0,0 +1,112 @@
+/* -*-  Mode: C++; c-file-style: "gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2019 University of Washington
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation;
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program; if not, write to the Free Software
+ * Foundation, Inc., 59 Temple Place, Suite 330, Boston, MA  02111-1307  USA
+ *
+ * Author: Sébastien Deronne <sebastien.deronne@gmail.com>
+ */
+
+#ifndef PUNCTURING_CHANNEL_BONDING_MANAGER_H
+#define PUNCTURING_CHANNEL_BONDING_MANAGER_H
+
+#include "channel-bonding-manager.h"
+
+namespace ns3 {
+
+/**
+ * \brief Puncturing Channel Bonding Manager
+ * \ingroup wifi
+ *
+ * This object provides an implementation for dynamically selecting the channel width
+ * where busy secondary 20 MHz subchannels of an 80 MHz or 160 MHz channel can be
+ * punctured instead of falling back to a narrower contiguous channel.
+ *
+ * In an 80 MHz channel, a single 20 MHz subchannel other than the primary one can be
+ * punctured. In a 160 MHz channel, the secondary 20 MHz subchannel may be punctured
+ * provided the secondary 40 MHz subchannel is idle, and any 20 MHz subchannels of the
+ * secondary 80 MHz subchannel may be punctured as long as at least one remains idle.
+ */
+class PuncturingChannelBondingManager : public ChannelBondingManager
+{
+public:
+  PuncturingChannelBondingManager ();
+
+  static TypeId GetTypeId (void);
+
+  /**
+   * Sets the WifiPhy this manager is associated with.
+   *
+   * \param phy the WifiPhy this manager is associated with
+   */
+  void SetPhy (const Ptr<WifiPhy> phy) override;
+
+  /**
+   * Sets the CCA threshold (dBm) for the secondary channels. The energy of a received signal
+   * should be higher than this threshold to allow the PHY layer to declare CCA BUSY state.
+   *
+   * \param threshold the CCA threshold in dBm for the secondary channels
+   */
+  void SetCcaEdThresholdSecondary (double threshold);
+
+  /**
+   * Returns the selected channel width (in MHz).
+   *
+   * \param mode the WifiMode that will be used for the transmission
+   *
+   * \return the selected channel width in MHz
+   */
+  uint16_t GetUsableChannelWidth (WifiMode mode) override;
+
+  /**
+   * Returns the 20 MHz subchannels that were found busy by the last call to
+   * GetUsableChannelWidth within the channel of the given width that contains
+   * the primary 20 MHz channel.
+   *
+   * \param channelWidth the channel width (in MHz) of the transmission
+   *
+   * \return the bitmap of punctured 20 MHz subchannels
+   */
+  uint8_t GetPuncturedSubchannels (uint16_t channelWidth) const override;
+
+  /**
+   * Check whether a puncturing pattern is allowed.
+   *
+   * \param channelWidth the channel width (in MHz) of the transmission
+   * \param primaryIndex the index of the primary 20 MHz subchannel within the channel
+   * \param punctured the bitmap of punctured 20 MHz subchannels
+   *
+   * \return true if the puncturing pattern is allowed
+   */
+  static bool IsPuncturingPatternAllowed (uint16_t channelWidth, uint8_t primaryIndex, uint8_t punctured);
+
+
+private:
+  /**
+   * \param channelWidth the channel width (in MHz)
+   *
+   * \return the bitmap of busy 20 MHz subchannels within the channel of the given width
+   *         that contains the primary 20 MHz channel
+   */
+  uint8_t GetBusySubchannels (uint16_t channelWidth) const;
+
+  double m_ccaEdThresholdSecondaryDbm; //!< Clear channel assessment (CCA) threshold for secondary channel(s) in dBm
+  uint16_t m_usableChannelWidth;       //!< Channel width (in MHz) selected by the last call to GetUsableChannelWidth
+  uint8_t m_primaryIndex;              //!< Index of the primary 20 MHz subchannel within the operating channel
+  uint8_t m_busySubchannels;           //!< Bitmap of the busy 20 MHz subchannels within the operating channel
+};
+
+} //namespace ns3
+
+#endif /* PUNCTURING_CHANNEL_BONDING_MANAGER_H */
@@ -25,6 +25,7 @@
 #include "ns3/pointer.h"
 #include "ns3/simulator.h"
 #include "ns3/random-variable-stream.h"
+#include "ns3/net-device-queue-interface.h"
 #include "qos-txop.h"
 #include "channel-access-manager.h"
 #include "mac-tx-middle.h"
@@ -228,6 +229,16 @@ QosTxop::SetWifiRemoteStationManager (const Ptr<WifiRemoteStationManager> remote
   m_baManager->SetWifiRemoteStationManager (m_stationManager);
 }
 
+void
+QosTxop::SetNetDeviceQueue (Ptr<NetDeviceQueue> queue)
+{
+  NS_LOG_FUNCTION (this << queue);
+  Txop::SetNetDeviceQueue (queue);
+  // MSDUs whose lifetime expires in the retransmission queue or that are no
+  // longer to be retransmitted are discarded
+  m_baManager->GetRetransmitQueue ()->TraceConnectWithoutContext ("Drop", MakeCallback (&QosTxop::NotifyCompletedMpdu, this));
+}
+
 void
 QosTxop::SetAckPolicySelector (Ptr<WifiAckPolicySelector> ackSelector)
 {
@@ -766,6 +777,7 @@ void QosTxop::NotifyInternalCollision (void)
           if (m_currentPacket)
             {
               NS_LOG_DEBUG ("Discarding m_currentPacket");
+              NotifyCompletedMpdu (Create<const WifiMacQueueItem> (m_currentPacket, m_currentHdr));
               m_currentPacket = 0;
             }
           else
@@ -810,10 +822,13 @@ QosTxop::NotifyMissedCts (std::list<Ptr<WifiMacQueueItem>> mpduList)
         {
           m_txFailedCallback (m_currentHdr);
         }
+      std::vector<Ptr<const WifiMacQueueItem>> discarded;
       for (auto& mpdu : mpduList)
         {
           m_baManager->NotifyDiscardedMpdu (mpdu);
+          discarded.push_back (mpdu);
         }
+      NotifyCompletedMpdus (discarded);
       //to reset the dcf.
       m_currentPacket = 0;
       ResetCw ();
@@ -937,6 +952,7 @@ QosTxop::MissedAck (void)
         {
           m_baManager->NotifyDiscardedMpdu (Create<const WifiMacQueueItem> (m_currentPacket, m_currentHdr));
         }
+      NotifyCompletedMpdu (Create<const WifiMacQueueItem> (m_currentPacket, m_currentHdr));
       m_currentPacket = 0;
       ResetCw ();
       m_cwTrace = GetCw ();
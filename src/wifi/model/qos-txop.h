@@ -122,6 +122,13 @@ public:
    * \param remoteManager WifiRemoteStationManager.
    */
   void SetWifiRemoteStationManager (const Ptr<WifiRemoteStationManager> remoteManager);
+  /**
+   * Set the device transmission queue to which the bytes of the MSDUs handled
+   * by this QosTxop are reported, in order to support byte queue limits.
+   *
+   * \param queue the device transmission queue.
+   */
+  void SetNetDeviceQueue (Ptr<NetDeviceQueue> queue);
   /**
    * Set the ack policy selector.
    *
@@ -479,6 +479,25 @@ RegularWifiMac::GetBKQueue () const
   return m_edca.find (AC_BK)->second;
 }
 
+uint32_t
+RegularWifiMac::GetMaxAmpduSize (AcIndex ac) const
+{
+  switch (ac)
+    {
+      case AC_BE:
+        return m_beMaxAmpduSize;
+      case AC_BK:
+        return m_bkMaxAmpduSize;
+      case AC_VI:
+        return m_viMaxAmpduSize;
+      case AC_VO:
+        return m_voMaxAmpduSize;
+      default:
+        NS_ABORT_MSG ("Unknown AC " << ac);
+        return 0;
+    }
+}
+
 void
 RegularWifiMac::SetWifiPhy (const Ptr<WifiPhy> phy)
 {
@@ -282,6 +282,14 @@ public:
   void SetCompressedBlockAckTimeout (Time blockAckTimeout);
   Time GetCompressedBlockAckTimeout (void) const;
 
+  /**
+   * Get the maximum A-MPDU size configured for the given Access Category.
+   *
+   * \param ac the Access Category
+   * \return the maximum A-MPDU size (0 if A-MPDU aggregation is disabled)
+   */
+  uint32_t GetMaxAmpduSize (AcIndex ac) const;
+
 
 protected:
   virtual void DoInitialize ();
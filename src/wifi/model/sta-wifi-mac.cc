@@ -826,6 +826,13 @@ StaWifiMac::UpdateApInfoFromBeacon (MgtBeaconHeader beacon, Mac48Address apAddr,
             {
               m_stationManager->SetRifsPermitted (false);
             }
+          uint8_t primaryChannelNumber = htOperation.GetPrimaryChannel ();
+          if ((primaryChannelNumber != m_phy->GetPrimaryChannelNumber ()) && m_phy->IsValidPrimaryChannelNumber (primaryChannelNumber))
+            {
+              //the AP has relocated the primary 20 MHz channel of the BSS
+              NS_LOG_DEBUG ("Follow primary channel relocation to channel " << +primaryChannelNumber);
+              m_phy->SwitchPrimaryChannel (primaryChannelNumber);
+            }
         }
     }
   if (GetVhtSupported ())
@@ -23,6 +23,8 @@
 #include "ns3/simulator.h"
 #include "ns3/random-variable-stream.h"
 #include "ns3/socket.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/queue-limits.h"
 #include "txop.h"
 #include "channel-access-manager.h"
 #include "wifi-mac-queue.h"
@@ -91,6 +93,7 @@ Txop::Txop ()
     m_accessRequested (false),
     m_backoffSlots (0),
     m_backoffStart (Seconds (0.0)),
+    m_backoffVersion (0),
     m_currentPacket (0)
 {
   NS_LOG_FUNCTION (this);
@@ -107,6 +110,9 @@ void
 Txop::DoDispose (void)
 {
   NS_LOG_FUNCTION (this);
+  m_completeExpiredEvent.Cancel ();
+  m_queuedMsdus.clear ();
+  m_netDeviceQueue = 0;
   m_queue = 0;
   m_low = 0;
   m_stationManager = 0;
@@ -174,6 +180,140 @@ Txop::TxDroppedPacket (Ptr<const WifiMacQueueItem> item)
     }
 }
 
+void
+Txop::SetNetDeviceQueue (Ptr<NetDeviceQueue> queue)
+{
+  NS_LOG_FUNCTION (this << queue);
+  NS_ASSERT (!m_netDeviceQueue);
+  m_netDeviceQueue = queue;
+  // the bytes are reported by this Txop, not when MSDUs are enqueued in or
+  // dequeued from the wifi MAC queue
+  m_netDeviceQueue->SetBytesReportedByDevice (true);
+  m_queue->TraceConnectWithoutContext ("Enqueue", MakeCallback (&Txop::NotifyQueuedMpdu, this));
+  m_queue->TraceConnectWithoutContext ("Drop", MakeCallback (&Txop::NotifyCompletedMpdu, this));
+}
+
+void
+Txop::NotifyQueuedMpdu (Ptr<const WifiMacQueueItem> mpdu)
+{
+  NS_LOG_FUNCTION (this << *mpdu);
+  if (!m_netDeviceQueue->GetQueueLimits ())
+    {
+      return;
+    }
+  // an MSDU put back in the queue (e.g., after the transmission was reset)
+  // has been already reported
+  if (!m_queuedMsdus.insert ({mpdu->GetPacket ()->GetUid (),
+                              {mpdu->GetSize (), mpdu->GetTimeStamp ()}}).second)
+    {
+      return;
+    }
+  m_netDeviceQueue->NotifyQueuedBytes (mpdu->GetSize ());
+
+  if (!m_completeExpiredEvent.IsRunning ())
+    {
+      m_completeExpiredEvent = Simulator::Schedule (mpdu->GetTimeStamp () + m_queue->GetMaxDelay ()
+                                                    - Simulator::Now (),
+                                                    &Txop::CompleteExpiredMsdus, this);
+    }
+}
+
+void
+Txop::NotifyCompletedMpdu (Ptr<const WifiMacQueueItem> mpdu)
+{
+  NS_LOG_FUNCTION (this << *mpdu);
+  uint32_t bytes = CompleteMpdu (mpdu);
+  if (bytes > 0)
+    {
+      m_netDeviceQueue->NotifyTransmittedBytes (bytes);
+    }
+}
+
+void
+Txop::NotifyCompletedMpdus (const std::vector<Ptr<const WifiMacQueueItem>>& mpdus)
+{
+  NS_LOG_FUNCTION (this << mpdus.size ());
+  // the queue limits are notified once, as the driver of a Linux device does
+  // when a transmission completes, so that they can detect that the device
+  // queue is starved
+  uint32_t bytes = 0;
+  for (const auto& mpdu : mpdus)
+    {
+      bytes += CompleteMpdu (mpdu);
+    }
+  if (bytes > 0)
+    {
+      m_netDeviceQueue->NotifyTransmittedBytes (bytes);
+    }
+}
+
+uint32_t
+Txop::CompleteMpdu (Ptr<const WifiMacQueueItem> mpdu)
+{
+  NS_LOG_FUNCTION (this << *mpdu);
+  if (m_queuedMsdus.empty ())
+    {
+      return 0;
+    }
+
+  uint32_t bytes = 0;
+  auto complete = [this, &bytes] (uint64_t uid)
+    {
+      auto it = m_queuedMsdus.find (uid);
+      if (it != m_queuedMsdus.end ())
+        {
+          bytes += it->second.first;
+          m_queuedMsdus.erase (it);
+        }
+    };
+
+  if (mpdu->GetHeader ().IsQosData () && mpdu->GetHeader ().IsQosAmsdu ())
+    {
+      for (const auto& msdu : *PeekPointer (mpdu))
+        {
+          complete (msdu.first->GetUid ());
+        }
+    }
+  else
+    {
+      complete (mpdu->GetPacket ()->GetUid ());
+    }
+  return bytes;
+}
+
+void
+Txop::CompleteExpiredMsdus (void)
+{
+  NS_LOG_FUNCTION (this);
+  Time maxDelay = m_queue->GetMaxDelay ();
+  Time now = Simulator::Now ();
+  Time next = Time::Max ();
+  uint32_t bytes = 0;
+
+  for (auto it = m_queuedMsdus.begin (); it != m_queuedMsdus.end (); )
+    {
+      if (it->second.second + maxDelay <= now)
+        {
+          NS_LOG_DEBUG ("Lifetime of MSDU " << it->first << " expired");
+          bytes += it->second.first;
+          it = m_queuedMsdus.erase (it);
+        }
+      else
+        {
+          next = std::min (next, it->second.second + maxDelay);
+          it++;
+        }
+    }
+  if (bytes > 0)
+    {
+      m_netDeviceQueue->NotifyTransmittedBytes (bytes);
+    }
+  if (!m_queuedMsdus.empty ())
+    {
+      m_completeExpiredEvent = Simulator::Schedule (next - now, &Txop::CompleteExpiredMsdus, this);
+    }
+}
+
 Ptr<WifiMacQueue >
 Txop::GetWifiMacQueue () const
 {
@@ -246,6 +386,7 @@ Txop::UpdateBackoffSlotsNow (uint32_t nSlots, Time backoffUpdateBound)
   NS_LOG_FUNCTION (this << nSlots << backoffUpdateBound);
   m_backoffSlots -= nSlots;
   m_backoffStart = backoffUpdateBound;
+  m_backoffVersion++;
   NS_LOG_DEBUG ("update slots=" << nSlots << " slots, backoff=" << m_backoffSlots);
 }
 
@@ -263,6 +404,7 @@ Txop::StartBackoffNow (uint32_t nSlots)
     }
   m_backoffSlots = nSlots;
   m_backoffStart = Simulator::Now ();
+  m_backoffVersion++;
 }
 
 void
@@ -270,6 +412,7 @@ Txop::SetAifsn (uint8_t aifsn)
 {
   NS_LOG_FUNCTION (this << +aifsn);
   m_aifsn = aifsn;
+  m_backoffVersion++;
 }
 
 void
@@ -629,6 +772,7 @@ Txop::MissedCts (void)
         {
           m_txFailedCallback (m_currentHdr);
         }
+      NotifyCompletedMpdu (Create<const WifiMacQueueItem> (m_currentPacket, m_currentHdr));
       //to reset the dcf.
       m_currentPacket = 0;
       ResetCw ();
@@ -689,6 +833,7 @@ Txop::MissedAck (void)
         {
           m_txFailedCallback (m_currentHdr);
         }
+      NotifyCompletedMpdu (Create<const WifiMacQueueItem> (m_currentPacket, m_currentHdr));
       //to reset the dcf.
       m_currentPacket = 0;
       ResetCw ();
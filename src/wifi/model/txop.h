@@ -22,8 +22,11 @@
 #define TXOP_H
 
 #include "ns3/traced-value.h"
+#include "ns3/event-id.h"
 #include "mac-low-transmission-parameters.h"
 #include "wifi-mac-header.h"
+#include <map>
+#include <vector>
 
 namespace ns3 {
 
@@ -37,6 +40,7 @@ class WifiMacQueueItem;
 class UniformRandomVariable;
 class CtrlBAckResponseHeader;
 class WifiRemoteStationManager;
+class NetDeviceQueue;
 
 /**
  * \brief Handle packet fragmentation and retransmissions
@@ -143,6 +147,36 @@ public:
    */
   void SetTxDroppedCallback (TxDropped callback);
 
+  /**
+   * Set the device transmission queue to which the bytes of the MSDUs handled
+   * by this Txop are reported, in order to support byte queue limits (BQL).
+   * The bytes of an MSDU are reported as queued when the MSDU is enqueued in
+   * the wifi MAC queue and as transmitted when the MSDU is acknowledged or
+   * discarded, so that the queue limits account for the MSDUs being
+   * transmitted and not only for the MSDUs waiting in the wifi MAC queue.
+   *
+   * \param queue the device transmission queue.
+   */
+  virtual void SetNetDeviceQueue (Ptr<NetDeviceQueue> queue);
+  /**
+   * Report the bytes of the MSDUs included in the given MPDU as transmitted to
+   * the device transmission queue (if any), because the MPDU has been
+   * acknowledged or discarded. MSDUs already reported as transmitted are
+   * ignored.
+   *
+   * \param mpdu the MPDU.
+   */
+  void NotifyCompletedMpdu (Ptr<const WifiMacQueueItem> mpdu);
+  /**
+   * Report the bytes of the MSDUs included in the given MPDUs as transmitted to
+   * the device transmission queue (if any) at once, because the MPDUs have been
+   * acknowledged or discarded together (e.g., by a Block Ack). MSDUs already
+   * reported as transmitted are ignored.
+   *
+   * \param mpdus the MPDUs.
+   */
+  void NotifyCompletedMpdus (const std::vector<Ptr<const WifiMacQueueItem>>& mpdus);
+
   /**
    * Return the MacLow associated with this Txop.
    *
@@ -496,6 +530,28 @@ protected:
    * \param item the wifi MAC queue item.
    */
   void TxDroppedPacket (Ptr<const WifiMacQueueItem> item);
+  /**
+   * Report the bytes of the MSDU included in the given MPDU, just enqueued in
+   * the wifi MAC queue, as queued to the device transmission queue.
+   *
+   * \param mpdu the MPDU.
+   */
+  void NotifyQueuedMpdu (Ptr<const WifiMacQueueItem> mpdu);
+  /**
+   * Remove the MSDUs included in the given MPDU from the MSDUs reported as
+   * queued and not yet as transmitted.
+   *
+   * \param mpdu the MPDU.
+   * \return the bytes of the removed MSDUs.
+   */
+  uint32_t CompleteMpdu (Ptr<const WifiMacQueueItem> mpdu);
+  /**
+   * Report the bytes of the MSDUs whose lifetime expired as transmitted to the
+   * device transmission queue. The MAC discards such MSDUs, hence this ensures
+   * that the bytes of an MSDU are reported even if it is discarded on a path
+   * that does not report them.
+   */
+  void CompleteExpiredMsdus (void);
 
   Ptr<ChannelAccessManager> m_channelAccessManager; //!< the channel access manager
   TxOk m_txOkCallback; //!< the transmit OK callback
@@ -519,6 +575,12 @@ protected:
    * the backoff counter was last updated.
    */
   Time m_backoffStart;
+  /**
+   * incremented whenever the backoff slots, the backoff start or the AIFSN
+   * change, so that the ChannelAccessManager knows when the backoff end it
+   * cached for this Txop is stale
+   */
+  uint64_t m_backoffVersion;
 
   uint8_t m_aifsn;        //!< the AIFSN
   Time m_txopLimit;       //!< the txop limit time
@@ -529,6 +591,11 @@ protected:
   uint8_t m_fragmentNumber; //!< the fragment number
   TracedCallback<uint32_t> m_backoffTrace; //!< backoff trace value
   TracedValue<uint32_t> m_cwTrace;         //!< CW trace value
+
+  Ptr<NetDeviceQueue> m_netDeviceQueue;    //!< the device transmission queue for BQL
+  /// bytes and enqueue time of the MSDUs reported as queued, indexed by packet UID
+  std::map<uint64_t, std::pair<uint32_t, Time> > m_queuedMsdus;
+  EventId m_completeExpiredEvent;          //!< event to report the bytes of the expired MSDUs
 };
 
 } //namespace ns3
@@ -56,10 +56,16 @@ enum
 };
 
 WifiMacHeader::WifiMacHeader ()
-  : m_ctrlMoreData (0),
+  : m_ctrlToDs (0),
+    m_ctrlFromDs (0),
+    m_ctrlMoreData (0),
     m_ctrlWep (0),
     m_ctrlOrder (0),
-    m_amsduPresent (0)
+    m_qosTid (0),
+    m_qosEosp (0),
+    m_qosAckPolicy (0),
+    m_amsduPresent (0),
+    m_qosStuff (0)
 {
 }
 
@@ -186,13 +186,13 @@ WifiMacQueueItem::DoAggregate (Ptr<const WifiMacQueueItem> msdu)
 
 
 MsduAggregator::DeaggregatedMsdusCI
-WifiMacQueueItem::begin (void)
+WifiMacQueueItem::begin (void) const
 {
   return m_msduList.begin ();
 }
 
 MsduAggregator::DeaggregatedMsdusCI
-WifiMacQueueItem::end (void)
+WifiMacQueueItem::end (void) const
 {
   return m_msduList.end ();
 }
@@ -119,13 +119,13 @@ public:
    *
    * \return an iterator pointing to the first MSDU in the list of aggregated MSDUs
    */
-  MsduAggregator::DeaggregatedMsdusCI begin (void);
+  MsduAggregator::DeaggregatedMsdusCI begin (void) const;
   /**
    * \brief Get an iterator indicating past-the-last MSDU in the list of aggregated MSDUs.
    *
    * \return an iterator indicating past-the-last MSDU in the list of aggregated MSDUs
    */
-  MsduAggregator::DeaggregatedMsdusCI end (void);
+  MsduAggregator::DeaggregatedMsdusCI end (void) const;
 
   /**
    * \brief Print the item contents.
@@ -157,7 +157,20 @@ WifiMode::GetDataRate (WifiTxVector txVector, uint16_t staId) const
     {
       bw = HeRu::GetBandwidth (txVector.GetRu (staId).ruType);
     }
-  return GetDataRate (bw, txVector.GetGuardInterval (), nss);
+  uint64_t dataRate = GetDataRate (bw, txVector.GetGuardInterval (), nss);
+  uint8_t punctured = txVector.GetPuncturedSubchannels ();
+  if (punctured != 0 && !txVector.IsMu () && GetModulationClass () >= WIFI_MOD_CLASS_HT)
+    {
+      //only the data subcarriers of the non-punctured 20 MHz subchannels carry data
+      uint8_t nSubchannels = bw / 20;
+      uint8_t nPunctured = 0;
+      for (; punctured != 0; punctured &= (punctured - 1))
+        {
+          nPunctured++;
+        }
+      dataRate = dataRate * (nSubchannels - nPunctured) / nSubchannels;
+    }
+  return dataRate;
 }
 
 uint64_t
@@ -27,6 +27,8 @@
 #include "wifi-net-device.h"
 #include "wifi-phy.h"
 #include "wifi-mac.h"
+#include "wifi-psdu.h"
+#include "qos-utils.h"
 #include "ht-configuration.h"
 #include "vht-configuration.h"
 #include "he-configuration.h"
@@ -83,6 +85,13 @@ WifiNetDevice::GetTypeId (void)
                    PointerValue (),
                    MakePointerAccessor (&WifiNetDevice::GetHeConfiguration),
                    MakePointerChecker<HeConfiguration> ())
+    .AddTraceSource ("TxAirtime",
+                     "The airtime used to transmit a PSDU to a receiver, i.e., "
+                     "the duration of the PPDU shared among its PSDUs, along with "
+                     "the transmission queue and the size of the MSDUs of the PSDU. "
+                     "Control responses (CTS, Ack, BlockAck) are not reported.",
+                     MakeTraceSourceAccessor (&WifiNetDevice::m_txAirtimeTrace),
+                     "ns3::WifiNetDevice::TxAirtimeCallback")
   ;
   return tid;
 }
@@ -173,9 +182,36 @@ WifiNetDevice::CompleteConfig (void)
   m_mac->SetLinkDownCallback (MakeCallback (&WifiNetDevice::LinkDown, this));
   m_stationManager->SetupPhy (m_phy);
   m_stationManager->SetupMac (m_mac);
+  m_phy->TraceConnectWithoutContext ("PhyTxPsduBegin", MakeCallback (&WifiNetDevice::NotifyTxPsduBegin, this));
   m_configComplete = true;
 }
 
+void
+WifiNetDevice::NotifyTxPsduBegin (WifiPsduMap psdus, WifiTxVector txVector, Time duration)
+{
+  NS_LOG_FUNCTION (this << txVector << duration);
+  // the PSDUs of a multi-user PPDU share its duration
+  Time airtime = duration / static_cast<int64_t> (psdus.size ());
+  for (auto const& psdu : psdus)
+    {
+      const WifiMacHeader& hdr = psdu.second->GetHeader (0);
+      // control responses are transmitted on behalf of the frames received
+      // from the other station, hence they are not charged to it
+      if (hdr.IsCts () || hdr.IsAck () || hdr.IsBlockAck ())
+        {
+          continue;
+        }
+      // the transmission queues of a QoS device are indexed by access category
+      uint8_t txQueue = (hdr.IsQosData () ? QosUtilsMapTidToAc (hdr.GetQosTid ()) : AC_BE);
+      uint32_t size = 0;
+      for (std::size_t i = 0; i < psdu.second->GetNMpdus (); i++)
+        {
+          size += psdu.second->GetPayload (i)->GetSize ();
+        }
+      m_txAirtimeTrace (psdu.second->GetAddr1 (), txQueue, size, airtime);
+    }
+}
+
 void
 WifiNetDevice::SetMac (const Ptr<WifiMac> mac)
 {
@@ -23,6 +23,8 @@
 
 #include "ns3/net-device.h"
 #include "ns3/traced-callback.h"
+#include "ns3/mac48-address.h"
+#include "wifi-ppdu.h"
 
 namespace ns3 {
 
@@ -59,6 +61,18 @@ public:
    */
   static TypeId GetTypeId (void);
 
+  /**
+   * TracedCallback signature for the airtime used to transmit to a receiver.
+   *
+   * \param receiver the receiver of the PSDU
+   * \param txQueue the index of the transmission queue (i.e., the access
+   *        category of a QoS data frame, or AC_BE otherwise)
+   * \param size the size in bytes of the MSDUs of the PSDU
+   * \param airtime the airtime of the PSDU, i.e., the duration of the PPDU
+   *        shared among its PSDUs
+   */
+  typedef void (* TxAirtimeCallback)(Mac48Address receiver, uint8_t txQueue, uint32_t size, Time airtime);
+
   WifiNetDevice ();
   virtual ~WifiNetDevice ();
 
@@ -185,6 +199,15 @@ private:
    * connecting all lower components (e.g. MAC, WifiRemoteStation) together.
    */
   void CompleteConfig (void);
+  /**
+   * Fire the TxAirtime trace source for each PSDU of a PPDU being transmitted,
+   * except for control responses.
+   *
+   * \param psdus the PSDUs of the PPDU
+   * \param txVector the TXVECTOR of the PPDU
+   * \param duration the duration of the PPDU
+   */
+  void NotifyTxPsduBegin (WifiPsduMap psdus, WifiTxVector txVector, Time duration);
 
   Ptr<Node> m_node; //!< the node
   Ptr<WifiPhy> m_phy; //!< the phy
@@ -202,6 +225,7 @@ private:
   uint32_t m_ifIndex; //!< IF index
   bool m_linkUp; //!< link up
   TracedCallback<> m_linkChanges; //!< link change callback
+  TracedCallback<Mac48Address, uint8_t, uint32_t, Time> m_txAirtimeTrace; //!< airtime used to transmit to each receiver
   mutable uint16_t m_mtu; //!< MTU
   bool m_configComplete; //!< configuration complete
 };
@@ -54,7 +54,7 @@ NS_LOG_COMPONENT_DEFINE ("WifiPhy");
 
 NS_OBJECT_ENSURE_REGISTERED (WifiPhy);
 
-uint64_t WifiPhy::m_globalPpduUid = 0;
+std::atomic<uint64_t> WifiPhy::m_globalPpduUid (0);
 
 /**
  * This table maintains the mapping of valid ChannelNumber to
@@ -255,7 +255,8 @@ WifiPhy::GetTypeId (void)
                    " ideal receiver with the same overall gain and bandwidth when the receivers "
                    " are connected to sources at the standard noise temperature T0 (usually 290 K)\".",
                    DoubleValue (7),
-                   MakeDoubleAccessor (&WifiPhy::SetRxNoiseFigure),
+                   MakeDoubleAccessor (&WifiPhy::SetRxNoiseFigure,
+                                       &WifiPhy::GetRxNoiseFigure),
                    MakeDoubleChecker<double> ())
     .AddAttribute ("State",
                    "The state of the PHY layer.",
@@ -347,6 +348,12 @@ WifiPhy::GetTypeId (void)
                      "has begun transmitting over the channel medium",
                      MakeTraceSourceAccessor (&WifiPhy::m_phyTxBeginTrace),
                      "ns3::Packet::TracedCallback")
+    .AddTraceSource ("PhyTxPsduBegin",
+                     "Trace source indicating the PSDUs of a PPDU "
+                     "have begun being transmitted over the channel medium, "
+                     "with the TXVECTOR and the duration of the PPDU",
+                     MakeTraceSourceAccessor (&WifiPhy::m_phyTxPsduBeginTrace),
+                     "ns3::WifiPhy::PhyTxPsduBeginTracedCallback")
     .AddTraceSource ("PhyTxEnd",
                      "Trace source indicating a packet "
                      "has been completely transmitted over the channel. "
@@ -418,6 +425,7 @@ WifiPhy::WifiPhy ()
     m_rxSpatialStreams (0),
     m_channelNumber (0),
     m_initialChannelNumber (0),
+    m_primaryBandIndicesKey (UINT32_MAX),
     m_wifiRadioEnergyModel (0),
     m_timeLastPreambleDetected (Seconds (0)),
     m_ofdmaStarted (false)
@@ -601,10 +609,17 @@ void
 WifiPhy::SetRxNoiseFigure (double noiseFigureDb)
 {
   NS_LOG_FUNCTION (this << noiseFigureDb);
+  m_rxNoiseFigureDb = noiseFigureDb;
   m_interference.SetNoiseFigure (DbToRatio (noiseFigureDb));
   m_interference.SetNumberOfReceiveAntennas (GetNumberOfAntennas ());
 }
 
+double
+WifiPhy::GetRxNoiseFigure (void) const
+{
+  return m_rxNoiseFigureDb;
+}
+
 void
 WifiPhy::SetTxPowerStart (double start)
 {
@@ -1488,6 +1503,16 @@ WifiPhy::GetUsableChannelWidth (WifiMode mode)
   return GetChannelWidth ();
 }
 
+uint8_t
+WifiPhy::GetPuncturedSubchannels (uint16_t channelWidth) const
+{
+  if (channelWidth >= 80 && m_channelBondingManager)
+    {
+      return m_channelBondingManager->GetPuncturedSubchannels (channelWidth);
+    }
+  return 0;
+}
+
 void
 WifiPhy::SetNumberOfAntennas (uint8_t antennas)
 {
@@ -1664,6 +1689,81 @@ WifiPhy::GetPrimaryChannelNumber (void) const
   return m_primaryChannelNumber;
 }
 
+bool
+WifiPhy::IsValidPrimaryChannelNumber (uint8_t nch) const
+{
+  auto it = m_channelToFrequencyWidth.find (std::make_pair (nch, WIFI_PHY_STANDARD_UNSPECIFIED));
+  if ((it == m_channelToFrequencyWidth.end ()) || (it->second.second != 20))
+    {
+      return false;
+    }
+  uint16_t primaryFrequency = it->second.first;
+  uint16_t channelWidth = GetChannelWidth ();
+  uint16_t frequency = GetFrequency ();
+  if (channelWidth < 20)
+    {
+      return false;
+    }
+  return ((primaryFrequency + 10 <= frequency + (channelWidth / 2))
+          && (primaryFrequency >= frequency + 10 - (channelWidth / 2)));
+}
+
+void
+WifiPhy::SwitchPrimaryChannel (uint8_t nch)
+{
+  NS_LOG_FUNCTION (this << +nch);
+  if (!IsInitialized ())
+    {
+      SetPrimaryChannelNumber (nch);
+      return;
+    }
+  if (nch == GetPrimaryChannelNumber ())
+    {
+      NS_LOG_DEBUG ("No primary channel change requested");
+      return;
+    }
+  if (!IsValidPrimaryChannelNumber (nch))
+    {
+      NS_FATAL_ERROR ("Channel " << +nch << " is not a 20 MHz channel of operating channel " << +GetChannelNumber ());
+    }
+  switch (GetPhyState ())
+    {
+    case WifiPhyState::TX:
+    case WifiPhyState::RX:
+    case WifiPhyState::SWITCHING:
+      NS_LOG_DEBUG ("primary channel relocation postponed until PHY is no longer busy");
+      Simulator::Schedule (GetDelayUntilIdle (), &WifiPhy::SwitchPrimaryChannel, this, nch);
+      return;
+    case WifiPhyState::SLEEP:
+    case WifiPhyState::OFF:
+      //CCA state is reevaluated from the new primary channel when resuming
+      m_primaryChannelNumber = nch;
+      return;
+    case WifiPhyState::CCA_BUSY:
+    case WifiPhyState::IDLE:
+      break;
+    default:
+      NS_ASSERT (false);
+      break;
+    }
+  NS_LOG_DEBUG ("relocating primary channel " << +GetPrimaryChannelNumber () << " -> " << +nch);
+  //preambles being detected have been detected over the previous primary channel
+  for (auto & endPreambleDetectionEvent : m_endPreambleDetectionEvents)
+    {
+      endPreambleDetectionEvent.Cancel ();
+    }
+  m_endPreambleDetectionEvents.clear ();
+  m_currentPreambleEvents.clear ();
+  m_currentEvent = 0;
+  m_primaryChannelNumber = nch;
+  /*
+   * Bands and interference events do not depend on the position of the
+   * primary channel, so only the CCA state per band has to be reevaluated
+   * with the thresholds that now apply to each band.
+   */
+  MaybeCcaBusy ();
+}
+
 uint16_t
 WifiPhy::GetCenterFrequencyForChannelWidth (uint16_t currentWidth) const
 {
@@ -2943,6 +3043,7 @@ WifiPhy::Send (WifiPsduMap psdus, WifiTxVector txVector)
     }
 
   NotifyTxBegin (psdus, DbmToW (GetTxPowerForTransmission (txVector) + GetTxGain ()));
+  m_phyTxPsduBeginTrace (psdus, txVector, txDuration);
   NotifyMonitorSniffTx (psdus.begin ()->second, GetFrequency (), txVector); //TODO: fix for MU
   uint16_t primaryChannelWidth = GetChannelWidth () >= 40 ? 20 : GetChannelWidth ();
   auto primaryBand = GetBand (primaryChannelWidth, GetPrimaryBandIndex (primaryChannelWidth));
@@ -2963,7 +3064,7 @@ WifiPhy::Send (WifiPsduMap psdus, WifiTxVector txVector)
     }
   else
     {
-      uid = m_globalPpduUid++;
+      uid = m_globalPpduUid.fetch_add (1, std::memory_order_relaxed);
     }
   m_previouslyRxPpduUid = UINT64_MAX; //reset to use it only once
   Ptr<WifiPpdu> ppdu = Create<WifiPpdu> (psdus, txVector, txDuration, GetCenterFrequencyForChannelWidth (txVector.GetChannelWidth ()), uid);
@@ -3334,6 +3435,17 @@ WifiPhy::GetDelayUntilCcaEnd (double ccaThreshold, WifiSpectrumBand band)
   return m_interference.GetEnergyDuration (ccaThreshold, band);
 }
 
+void
+WifiPhy::ReservePpduUids (uint32_t systemId)
+{
+  NS_LOG_FUNCTION (systemId);
+  uint64_t firstUid = static_cast<uint64_t> (systemId) << 48;
+  if (m_globalPpduUid.load (std::memory_order_relaxed) < firstUid)
+    {
+      m_globalPpduUid.store (firstUid, std::memory_order_relaxed);
+    }
+}
+
 void
 WifiPhy::MaybeCcaBusy ()
 {
@@ -3547,6 +3659,11 @@ WifiPhy::StartReceivePayload (Ptr<Event> event)
                 {
                   for (uint8_t i = 0; i < (channelWidth / 20); i++)
                     {
+                      if (txVector.IsSubchannelPunctured (i))
+                        {
+                          //nothing is transmitted over punctured subchannels
+                          continue;
+                        }
                       band = GetBand (20, i);
                       bands.push_back (band);
                     }
@@ -3639,6 +3756,11 @@ WifiPhy::EndOfMpdu (Ptr<Event> event, Ptr<const WifiPsdu> psdu, size_t mpduIndex
         {
           for (uint8_t i = 0; i < (channelWidth / 20); i++)
             {
+              if (txVector.IsSubchannelPunctured (i))
+                {
+                  //nothing is transmitted over punctured subchannels
+                  continue;
+                }
               band = GetBand (20, i);
               bands.push_back (band);
             }
@@ -3702,6 +3824,11 @@ WifiPhy::EndReceive (Ptr<Event> event)
         {
           for (uint8_t i = 0; i < (channelWidth / 20); i++)
             {
+              if (txVector.IsSubchannelPunctured (i))
+                {
+                  //nothing is transmitted over punctured subchannels
+                  continue;
+                }
               band = GetBand (20, i);
               bands.push_back (band);
             }
@@ -3811,6 +3938,11 @@ WifiPhy::GetReceptionStatus (Ptr<const WifiPsdu> psdu, Ptr<Event> event, uint16_
         {
           for (uint8_t i = 0; i < (channelWidth / 20); i++)
             {
+              if (txVector.IsSubchannelPunctured (i))
+                {
+                  //nothing is transmitted over punctured subchannels
+                  continue;
+                }
               band = GetBand (20, i);
               bands.push_back (band);
             }
@@ -5136,6 +5268,14 @@ WifiPhy::GetDelaySinceChannelIsIdle (uint16_t channelWidth, double ccaThreshold)
   return delaySinceIdle;
 }
 
+Time
+WifiPhy::GetDelaySinceSubchannelIsIdle (uint8_t index, double ccaThreshold)
+{
+  NS_ASSERT ((index * 20) < GetChannelWidth ());
+  auto band = GetBand (((GetChannelWidth () >= 40) ? 20 : GetChannelWidth ()), index);
+  return m_state->GetDelaySinceIdle (band, ccaThreshold);
+}
+
 bool
 WifiPhy::IsStateIdle (uint16_t channelWidth, double ccaThreshold)
 {
@@ -5321,6 +5461,42 @@ WifiPhy::GetBand (uint16_t /*bandWidth*/, uint8_t /*bandIndex*/)
 
 uint8_t
 WifiPhy::GetPrimaryBandIndex (uint16_t currentWidth) const
+{
+  uint8_t widthIndex;
+  switch (currentWidth)
+    {
+    case 20:
+      widthIndex = 0;
+      break;
+    case 40:
+      widthIndex = 1;
+      break;
+    case 80:
+      widthIndex = 2;
+      break;
+    case 160:
+      widthIndex = 3;
+      break;
+    default:
+      return DoGetPrimaryBandIndex (currentWidth);
+    }
+  uint32_t key = (static_cast<uint32_t> (GetChannelNumber ()) << 24)
+    | (static_cast<uint32_t> (GetPrimaryChannelNumber ()) << 16)
+    | GetChannelWidth ();
+  if (key != m_primaryBandIndicesKey)
+    {
+      std::fill (std::begin (m_primaryBandIndices), std::end (m_primaryBandIndices), 0xff);
+      m_primaryBandIndicesKey = key;
+    }
+  if (m_primaryBandIndices[widthIndex] == 0xff)
+    {
+      m_primaryBandIndices[widthIndex] = DoGetPrimaryBandIndex (currentWidth);
+    }
+  return m_primaryBandIndices[widthIndex];
+}
+
+uint8_t
+WifiPhy::DoGetPrimaryBandIndex (uint16_t currentWidth) const
 {
   uint8_t index = 0;
   uint16_t supportedWidth = GetChannelWidth ();
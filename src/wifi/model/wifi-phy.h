@@ -30,6 +30,7 @@
 #include "interference-helper.h"
 #include "wifi-phy-state-helper.h"
 #include "wifi-ppdu.h"
+#include <atomic>
 
 namespace ns3 {
 
@@ -304,6 +305,24 @@ public:
    */
   Time GetDelaySinceChannelIsIdle (uint16_t channelWidth, double threshold);
 
+  /**
+   * \param index the index of the 20 MHz subchannel within the operating channel (lowest frequency first)
+   * \param threshold the threshold used to decide whether the subchannel is WifiPhy::CCA_BUSY or WifiPhy::IDLE
+   *
+   * \return the delay since the 20 MHz subchannel is in WifiPhy::IDLE.
+   */
+  Time GetDelaySinceSubchannelIsIdle (uint8_t index, double threshold);
+
+  /**
+   * Get the index of the band of a given width that contains the primary 20 MHz channel.
+   * The index is cached per width and only recomputed when the operating channel
+   * number, the operating channel width or the primary channel number changes.
+   *
+   * \param currentWidth the width of the band (MHz)
+   * \return the index of the band of the given width that contains the primary 20 MHz channel
+   */
+  uint8_t GetPrimaryBandIndex (uint16_t currentWidth) const;
+
   /**
    * Return the start time of the last received packet.
    *
@@ -662,6 +681,26 @@ public:
    * \return the primary channel number
    */
   uint8_t GetPrimaryChannelNumber (void) const;
+  /**
+   * \brief Relocate the primary 20 MHz channel at runtime.
+   *
+   * Only the position of the primary 20 MHz channel inside the current
+   * operating channel changes: the operating channel number and width are kept,
+   * hence the spectrum model and the interference helper bands are reused as is.
+   * If the PHY is transmitting, receiving or switching channel, the relocation
+   * is postponed until the PHY is no longer busy. Otherwise, any ongoing preamble
+   * detection is dropped and the CCA state of the new primary channel is
+   * reevaluated from the signals already tracked by the interference helper.
+   *
+   * \param id the new primary 20 MHz channel number
+   */
+  void SwitchPrimaryChannel (uint8_t id);
+  /**
+   * \param id a channel number
+   * \return true if the given channel number identifies a 20 MHz channel
+   *         that lies inside the current operating channel, false otherwise
+   */
+  bool IsValidPrimaryChannelNumber (uint8_t id) const;
 
   /**
    * \return the required time for channel switch operation of this WifiPhy
@@ -1402,6 +1441,15 @@ public:
    */
   typedef void (* PhyRxPayloadBeginTracedCallback)(WifiTxVector txVector, Time psduDuration);
 
+  /**
+   * TracedCallback signature for start of PPDU transmission events.
+   *
+   * \param psdus the PSDUs of the PPDU, indexed by STA-ID
+   * \param txVector the TXVECTOR of the PPDU
+   * \param duration the duration of the PPDU
+   */
+  typedef void (* PhyTxPsduBeginTracedCallback)(WifiPsduMap psdus, WifiTxVector txVector, Time duration);
+
   /**
    * Assign a fixed random variable stream number to the random variables
    * used by this model. Return the number of streams (possibly zero) that
@@ -1476,6 +1524,12 @@ public:
    * \param noiseFigureDb noise figure in dB
    */
   void SetRxNoiseFigure (double noiseFigureDb);
+  /**
+   * Return the RX loss (dB) in the Signal-to-Noise-Ratio due to non-idealities in the receiver.
+   *
+   * \return the noise figure in dB
+   */
+  double GetRxNoiseFigure (void) const;
   /**
    * Sets the minimum available transmission power level (dBm).
    *
@@ -1726,6 +1780,12 @@ public:
    * \return the usable channel width for the transmission
    */
   uint16_t GetUsableChannelWidth (WifiMode mode);
+  /**
+   * \param channelWidth the channel width (MHz) selected for the transmission
+   *
+   * \return the bitmap of the 20 MHz subchannels to puncture for the transmission
+   */
+  uint8_t GetPuncturedSubchannels (uint16_t channelWidth) const;
   /**
    * \param channelwidth channel width
    */
@@ -1773,6 +1833,15 @@ public:
    */
   void NotifyChannelAccessRequested (void);
 
+  /**
+   * Reserve a range of PPDU UIDs to the given system of a distributed
+   * simulation, so that the PPDUs transmitted by different systems (and
+   * exchanged by means of a RemoteSpectrumChannel) have distinct UIDs.
+   *
+   * \param systemId the id of the local system
+   */
+  static void ReservePpduUids (uint32_t systemId);
+
 
 protected:
   // Inherited
@@ -1832,9 +1901,6 @@ protected:
    */
   virtual uint16_t GetStaId (const Ptr<const WifiPpdu> ppdu) const;
 
-  //TODO
-  uint8_t GetPrimaryBandIndex (uint16_t currentWidth) const;
-
   /**
    * Get the start band index and the stop band index for a given band
    *
@@ -1884,7 +1950,7 @@ protected:
   uint64_t m_currentHeTbPpduUid;   //!< UID of the HE TB PPDU being received
   uint64_t m_previouslyRxPpduUid;  //!< UID of the previously received PPDU (reused by HE TB PPDUs), reset to UINT64_MAX upon transmission
 
-  static uint64_t m_globalPpduUid;     //!< Global counter of the PPDU UID
+  static std::atomic<uint64_t> m_globalPpduUid; //!< Global counter of the PPDU UID, shared by the threads of a MultithreadedSimulatorImpl
 
 
 private:
@@ -1899,6 +1965,14 @@ private:
    * DoInitialize () is called.
    */
   void InitializeFrequencyChannelNumber (void);
+  /**
+   * Compute the index of the band of a given width that contains the primary 20 MHz channel
+   * from the channel to frequency width map.
+   *
+   * \param currentWidth the width of the band (MHz)
+   * \return the index of the band of the given width that contains the primary 20 MHz channel
+   */
+  uint8_t DoGetPrimaryBandIndex (uint16_t currentWidth) const;
   /**
    * Configure WifiPhy with appropriate channel frequency and
    * supported rates for 802.11a standard.
@@ -2094,6 +2168,15 @@ private:
    */
   TracedCallback<WifiTxVector, Time> m_phyRxPayloadBeginTrace;
 
+  /**
+   * The trace source fired when the transmission of a PPDU starts, with
+   * the duration of the PPDU, e.g., to account for the airtime used by
+   * each receiver
+   *
+   * \see class CallBackTraceSource
+   */
+  TracedCallback<WifiPsduMap, WifiTxVector, Time> m_phyTxPsduBeginTrace;
+
   /**
    * The trace source fired when a packet ends the reception process from
    * the medium.
@@ -2196,6 +2279,7 @@ private:
 
   double   m_rxSensitivityW;           //!< Receive sensitivity threshold in watts
   double   m_ccaEdThresholdW;          //!< Clear channel assessment (CCA) threshold for primary channel in watts
+  double   m_rxNoiseFigureDb;          //!< Receive noise figure in dB
 
   std::vector<double> m_ccaEdThresholdsSecondaryW; //!< Clear channel assessment (CCA) thresholds for secondary channel(s) in watts
 
@@ -2228,6 +2312,9 @@ private:
   uint8_t               m_primaryChannelNumber;     //!< Primary 20 MHz channel number
   uint8_t               m_initialChannelNumber;     //!< Initial channel number
 
+  mutable uint32_t m_primaryBandIndicesKey;     //!< Operating channel number, primary channel number and channel width the cached primary band indices belong to
+  mutable uint8_t  m_primaryBandIndices[4];     //!< Cached primary band indices for 20, 40, 80 and 160 MHz (0xff if not computed yet)
+
   Time m_channelSwitchDelay;     //!< Time required to switch between channel
 
   Ptr<NetDevice>     m_device;   //!< Pointer to the device
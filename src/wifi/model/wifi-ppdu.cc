@@ -36,6 +36,7 @@ WifiPpdu::WifiPpdu (Ptr<const WifiPsdu> psdu, WifiTxVector txVector, Time ppduDu
     m_truncatedTx (false),
     m_frequency (frequency),
     m_channelWidth (txVector.GetChannelWidth ()),
+    m_puncturedSubchannels (txVector.GetPuncturedSubchannels ()),
     m_uid (uid)
 {
   NS_LOG_FUNCTION (this << *psdu << txVector << ppduDuration << frequency << uid);
@@ -51,6 +52,7 @@ WifiPpdu::WifiPpdu (const WifiPsduMap & psdus, WifiTxVector txVector, Time ppduD
     m_truncatedTx (false),
     m_frequency (frequency),
     m_channelWidth (txVector.GetChannelWidth ()),
+    m_puncturedSubchannels (txVector.GetPuncturedSubchannels ()),
     m_uid (uid)
 {
   NS_LOG_FUNCTION (this << psdus << txVector << ppduDuration << frequency << uid);
@@ -285,6 +287,7 @@ WifiPpdu::GetTxVector (void) const
             }
           txVector.SetMode (mode);
           txVector.SetChannelWidth (m_channelWidth);
+          txVector.SetPuncturedSubchannels (m_puncturedSubchannels);
           break;
         }
       case WIFI_MOD_CLASS_ERP_OFDM:
@@ -338,6 +341,7 @@ WifiPpdu::GetTxVector (void) const
           txVector.SetChannelWidth (m_vhtSig.GetChannelWidth ());
           txVector.SetNss (m_vhtSig.GetNStreams ());
           txVector.SetGuardInterval (m_vhtSig.GetShortGuardInterval () ? 400 : 800);
+          txVector.SetPuncturedSubchannels (m_puncturedSubchannels);
           break;
         }
       case WIFI_MOD_CLASS_HE:
@@ -347,6 +351,7 @@ WifiPpdu::GetTxVector (void) const
           txVector.SetNss (m_heSig.GetNStreams ());
           txVector.SetGuardInterval (m_heSig.GetGuardInterval ());
           txVector.SetBssColor (m_heSig.GetBssColor ());
+          txVector.SetPuncturedSubchannels (m_puncturedSubchannels);
           break;
         }
       default:
@@ -398,6 +403,12 @@ WifiPpdu::GetStaId (void) const
   return m_psdus.begin ()->first;
 }
 
+const WifiPsduMap &
+WifiPpdu::GetPsduMap (void) const
+{
+  return m_psdus;
+}
+
 bool
 WifiPpdu::IsTruncatedTx (void) const
 {
@@ -408,6 +419,8 @@ void
 WifiPpdu::SetTruncatedTx (void)
 {
   NS_LOG_FUNCTION (this);
+  // the receivers share the PPDU, possibly from different threads
+  NS_ASSERT_MSG (GetReferenceCount () == 1, "The PPDU must not be modified once transmitted");
   m_truncatedTx = true;
 }
 
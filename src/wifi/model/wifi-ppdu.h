@@ -80,6 +80,11 @@ public:
    * \return the PSDU
    */
   Ptr<const WifiPsdu> GetPsdu (uint8_t bssColor = 0, uint16_t staId = SU_STA_ID) const;
+  /**
+   * Get all the payloads of the PPDU.
+   * \return the PSDUs indexed by STA-ID
+   */
+  const WifiPsduMap & GetPsduMap (void) const;
 
   /**
    * Return true if the PPDU's transmission was aborted due to transmitter switch off
@@ -88,6 +93,8 @@ public:
   bool IsTruncatedTx (void) const;
   /**
    * Indicate that the PPDU's transmission was aborted due to transmitter switch off.
+   * This must be done before the PPDU is transmitted, i.e., while it is not
+   * shared with the receivers yet.
    */
   void SetTruncatedTx (void);
 
@@ -166,6 +173,7 @@ private:
   uint16_t m_frequency;                        //!< the frequency used to transmit that PPDU
   uint16_t m_channelWidth;                     //!< the channel width used to transmit that PPDU
   WifiTxVector::HeMuUserInfoMap m_muUserInfos; //!< the HE MU specific per-user information (to be removed once HE-SIG-B headers are implemented)
+  uint8_t m_puncturedSubchannels;              //!< the bitmap of punctured 20 MHz subchannels (signaled in the SIG fields)
   uint64_t m_uid;                              //!< the unique ID of this PPDU or of the triggering PPDU if this is an HE TB PPDU
 };
 
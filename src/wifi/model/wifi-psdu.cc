@@ -45,7 +45,7 @@ WifiPsdu::WifiPsdu (Ptr<WifiMacQueueItem> mpdu, bool isSingle)
 
   if (isSingle)
     {
-      m_size += 4;    // A-MPDU Subframe header size
+      m_size += MpduAggregator::AMPDU_SUBFRAME_HEADER_SIZE;
     }
 }
 
@@ -56,9 +56,9 @@ WifiPsdu::WifiPsdu (Ptr<const WifiMacQueueItem> mpdu, bool isSingle)
 
 WifiPsdu::WifiPsdu (std::vector<Ptr<WifiMacQueueItem>> mpduList)
   : m_isSingle (mpduList.size () == 1),
-    m_mpduList (mpduList)
+    m_mpduList (std::move (mpduList))
 {
-  NS_ABORT_MSG_IF (mpduList.empty (), "Cannot initialize a WifiPsdu with an empty MPDU list");
+  NS_ABORT_MSG_IF (m_mpduList.empty (), "Cannot initialize a WifiPsdu with an empty MPDU list");
 
   m_size = 0;
   for (auto& mpdu : m_mpduList)
@@ -606,6 +606,10 @@ WifiRemoteStationManager::GetDataTxVector (Mac48Address address, const WifiMacHe
   else
     {
       txVector = DoGetDataTxVector (Lookup (address, header));
+      if (txVector.GetMode ().GetModulationClass () >= WIFI_MOD_CLASS_VHT)
+        {
+          txVector.SetPuncturedSubchannels (m_wifiPhy->GetPuncturedSubchannels (txVector.GetChannelWidth ()));
+        }
     }
   Ptr<WifiNetDevice> device = DynamicCast<WifiNetDevice> (m_wifiPhy->GetDevice ());
   Ptr<HeConfiguration> heConfiguration = device->GetHeConfiguration ();
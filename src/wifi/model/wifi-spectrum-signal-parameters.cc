@@ -20,8 +20,12 @@
  */
 
 #include "ns3/log.h"
+#include "ns3/packet.h"
 #include "wifi-ppdu.h"
+#include "wifi-psdu.h"
+#include "wifi-mac-queue-item.h"
 #include "wifi-spectrum-signal-parameters.h"
+#include <sstream>
 
 namespace ns3 {
 
@@ -53,5 +57,269 @@ WifiSpectrumSignalParameters::Copy ()
   return wssp;
 }
 
+/**
+ * \param mode the WifiMode
+ * \return the size of the serialized WifiMode
+ */
+static uint32_t
+GetSerializedSize (WifiMode mode)
+{
+  return 1 + mode.GetUniqueName ().size ();
+}
+
+/**
+ * Serialize a WifiMode by means of its unique name.
+ *
+ * \param i the buffer iterator to write to
+ * \param mode the WifiMode
+ */
+static void
+Serialize (Buffer::Iterator &i, WifiMode mode)
+{
+  std::string name = mode.GetUniqueName ();
+  i.WriteU8 (static_cast<uint8_t> (name.size ()));
+  i.Write (reinterpret_cast<const uint8_t *> (name.data ()), name.size ());
+}
+
+/**
+ * \param i the buffer iterator to read from
+ * \return the deserialized WifiMode
+ */
+static WifiMode
+DeserializeMode (Buffer::Iterator &i)
+{
+  std::string name (i.ReadU8 (), ' ');
+  i.Read (reinterpret_cast<uint8_t *> (&name[0]), name.size ());
+  std::istringstream is (name);
+  WifiMode mode;
+  is >> mode;
+  return mode;
+}
+
+/**
+ * \param txVector the TXVECTOR
+ * \return the size of the serialized TXVECTOR
+ */
+static uint32_t
+GetSerializedSize (const WifiTxVector &txVector)
+{
+  // preamble, width, guard interval, nTx, nEss, aggregation, STBC, BSS color,
+  // length, punctured subchannels, power level and mode initialized flag
+  uint32_t size = 1 + 2 + 2 + 1 + 1 + 1 + 1 + 1 + 2 + 1 + 1 + 1;
+  if (!txVector.GetModeInitialized ())
+    {
+      return size;
+    }
+  if (txVector.IsMu ())
+    {
+      size += 2;
+      WifiTxVector::HeMuUserInfoMap userInfos = txVector.GetHeMuUserInfoMap ();
+      for (auto& userInfo : userInfos)
+        {
+          // STA-ID, RU and number of spatial streams
+          size += 2 + 1 + 1 + 2 + 1 + GetSerializedSize (userInfo.second.mcs);
+        }
+    }
+  else
+    {
+      // number of spatial streams
+      size += 1 + GetSerializedSize (txVector.GetMode ());
+    }
+  return size;
+}
+
+/**
+ * Serialize a TXVECTOR.
+ *
+ * \param i the buffer iterator to write to
+ * \param txVector the TXVECTOR
+ */
+static void
+Serialize (Buffer::Iterator &i, const WifiTxVector &txVector)
+{
+  i.WriteU8 (static_cast<uint8_t> (txVector.GetPreambleType ()));
+  i.WriteHtonU16 (txVector.GetChannelWidth ());
+  i.WriteHtonU16 (txVector.GetGuardInterval ());
+  i.WriteU8 (txVector.GetNTx ());
+  i.WriteU8 (txVector.GetNess ());
+  i.WriteU8 (txVector.IsAggregation () ? 1 : 0);
+  i.WriteU8 (txVector.IsStbc () ? 1 : 0);
+  i.WriteU8 (txVector.GetBssColor ());
+  i.WriteHtonU16 (txVector.GetLength ());
+  i.WriteU8 (txVector.GetPuncturedSubchannels ());
+  i.WriteU8 (txVector.GetTxPowerLevel ());
+  i.WriteU8 (txVector.GetModeInitialized () ? 1 : 0);
+  if (!txVector.GetModeInitialized ())
+    {
+      return;
+    }
+  if (txVector.IsMu ())
+    {
+      WifiTxVector::HeMuUserInfoMap userInfos = txVector.GetHeMuUserInfoMap ();
+      i.WriteHtonU16 (static_cast<uint16_t> (userInfos.size ()));
+      for (auto& userInfo : userInfos)
+        {
+          i.WriteHtonU16 (userInfo.first);
+          i.WriteU8 (userInfo.second.ru.primary80MHz ? 1 : 0);
+          i.WriteU8 (static_cast<uint8_t> (userInfo.second.ru.ruType));
+          i.WriteHtonU16 (static_cast<uint16_t> (userInfo.second.ru.index));
+          i.WriteU8 (userInfo.second.nss);
+          Serialize (i, userInfo.second.mcs);
+        }
+    }
+  else
+    {
+      i.WriteU8 (txVector.GetNss ());
+      Serialize (i, txVector.GetMode ());
+    }
+}
+
+/**
+ * \param i the buffer iterator to read from
+ * \return the deserialized TXVECTOR
+ */
+static WifiTxVector
+DeserializeTxVector (Buffer::Iterator &i)
+{
+  WifiTxVector txVector;
+  txVector.SetPreambleType (static_cast<WifiPreamble> (i.ReadU8 ()));
+  txVector.SetChannelWidth (i.ReadNtohU16 ());
+  txVector.SetGuardInterval (i.ReadNtohU16 ());
+  txVector.SetNTx (i.ReadU8 ());
+  txVector.SetNess (i.ReadU8 ());
+  txVector.SetAggregation (i.ReadU8 () == 1);
+  txVector.SetStbc (i.ReadU8 () == 1);
+  txVector.SetBssColor (i.ReadU8 ());
+  txVector.SetLength (i.ReadNtohU16 ());
+  txVector.SetPuncturedSubchannels (i.ReadU8 ());
+  txVector.SetTxPowerLevel (i.ReadU8 ());
+  if (i.ReadU8 () == 0)
+    {
+      return txVector;
+    }
+  if (txVector.IsMu ())
+    {
+      uint16_t nUsers = i.ReadNtohU16 ();
+      for (uint16_t user = 0; user < nUsers; user++)
+        {
+          uint16_t staId = i.ReadNtohU16 ();
+          HeMuUserInfo userInfo;
+          userInfo.ru.primary80MHz = (i.ReadU8 () == 1);
+          userInfo.ru.ruType = static_cast<HeRu::RuType> (i.ReadU8 ());
+          userInfo.ru.index = i.ReadNtohU16 ();
+          userInfo.nss = i.ReadU8 ();
+          userInfo.mcs = DeserializeMode (i);
+          txVector.SetHeMuUserInfo (staId, userInfo);
+        }
+    }
+  else
+    {
+      txVector.SetNss (i.ReadU8 ());
+      txVector.SetMode (DeserializeMode (i));
+    }
+  return txVector;
+}
+
+uint32_t
+WifiSpectrumSignalParameters::GetSerializedSize (void) const
+{
+  // UID, frequency, duration, truncated flag and number of PSDUs
+  uint32_t size = SpectrumSignalParameters::GetSerializedSize () + 8 + 2 + 8 + 1 + 2;
+  size += ns3::GetSerializedSize (ppdu->GetTxVector ());
+  for (auto& psdu : ppdu->GetPsduMap ())
+    {
+      // STA-ID, aggregate flag and number of MPDUs
+      size += 2 + 1 + 2;
+      for (auto& mpdu : *PeekPointer (psdu.second))
+        {
+          size += mpdu->GetHeader ().GetSerializedSize () + 4 + mpdu->GetPacket ()->GetSerializedSize ();
+        }
+    }
+  return size;
+}
+
+void
+WifiSpectrumSignalParameters::Serialize (Buffer::Iterator start) const
+{
+  NS_LOG_FUNCTION (this);
+  SpectrumSignalParameters::Serialize (start);
+  Buffer::Iterator i = start;
+  i.Next (SpectrumSignalParameters::GetSerializedSize ());
+
+  i.WriteHtonU64 (ppdu->GetUid ());
+  i.WriteHtonU16 (ppdu->GetFrequency ());
+  i.WriteHtonU64 (ppdu->GetTxDuration ().GetTimeStep ());
+  i.WriteU8 (ppdu->IsTruncatedTx () ? 1 : 0);
+  ns3::Serialize (i, ppdu->GetTxVector ());
+
+  const WifiPsduMap &psdus = ppdu->GetPsduMap ();
+  i.WriteHtonU16 (static_cast<uint16_t> (psdus.size ()));
+  for (auto& psdu : psdus)
+    {
+      i.WriteHtonU16 (psdu.first);
+      i.WriteU8 (psdu.second->IsAggregate () ? 1 : 0);
+      i.WriteHtonU16 (static_cast<uint16_t> (psdu.second->GetNMpdus ()));
+      for (auto& mpdu : *PeekPointer (psdu.second))
+        {
+          mpdu->GetHeader ().Serialize (i);
+          i.Next (mpdu->GetHeader ().GetSerializedSize ());
+          uint32_t size = mpdu->GetPacket ()->GetSerializedSize ();
+          std::vector<uint8_t> data (size);
+          mpdu->GetPacket ()->Serialize (data.data (), size);
+          i.WriteHtonU32 (size);
+          i.Write (data.data (), size);
+        }
+    }
+}
+
+uint32_t
+WifiSpectrumSignalParameters::Deserialize (Buffer::Iterator start)
+{
+  NS_LOG_FUNCTION (this);
+  Buffer::Iterator i = start;
+  i.Next (SpectrumSignalParameters::Deserialize (start));
+
+  uint64_t uid = i.ReadNtohU64 ();
+  uint16_t frequency = i.ReadNtohU16 ();
+  Time txDuration = TimeStep (i.ReadNtohU64 ());
+  bool truncated = (i.ReadU8 () == 1);
+  WifiTxVector txVector = DeserializeTxVector (i);
+
+  WifiPsduMap psdus;
+  uint16_t nPsdus = i.ReadNtohU16 ();
+  for (uint16_t n = 0; n < nPsdus; n++)
+    {
+      uint16_t staId = i.ReadNtohU16 ();
+      bool isAggregate = (i.ReadU8 () == 1);
+      uint16_t nMpdus = i.ReadNtohU16 ();
+      std::vector<Ptr<WifiMacQueueItem>> mpduList;
+      for (uint16_t m = 0; m < nMpdus; m++)
+        {
+          WifiMacHeader header;
+          i.Next (header.Deserialize (i));
+          uint32_t size = i.ReadNtohU32 ();
+          std::vector<uint8_t> data (size);
+          i.Read (data.data (), size);
+          mpduList.push_back (Create<WifiMacQueueItem> (Create<Packet> (data.data (), size, true), header));
+        }
+      NS_ASSERT (!mpduList.empty ());
+      if (isAggregate)
+        {
+          psdus[staId] = Create<WifiPsdu> (mpduList);
+        }
+      else
+        {
+          psdus[staId] = Create<WifiPsdu> (mpduList.front ()->GetPacket (), mpduList.front ()->GetHeader ());
+        }
+    }
+
+  ppdu = Create<WifiPpdu> (psdus, txVector, txDuration, frequency, uid);
+  if (truncated)
+    {
+      ppdu->SetTruncatedTx ();
+    }
+  return i.GetDistanceFrom (start);
+}
+
 
 } // namespace ns3
@@ -38,6 +38,17 @@ struct WifiSpectrumSignalParameters : public SpectrumSignalParameters
 
   // inherited from SpectrumSignalParameters
   virtual Ptr<SpectrumSignalParameters> Copy ();
+  virtual uint32_t GetSerializedSize (void) const;
+  /**
+   * Serialize these parameters. The PPDU is serialized by means of its
+   * TXVECTOR, duration, frequency and UID, which are enough to rebuild its
+   * PHY headers, and of the MAC header and payload of every MPDU of its
+   * PSDUs.
+   *
+   * \param start the buffer iterator to write to
+   */
+  virtual void Serialize (Buffer::Iterator start) const;
+  virtual uint32_t Deserialize (Buffer::Iterator start);
 
   /**
    * default constructor
@@ -35,6 +35,7 @@ WifiTxVector::WifiTxVector ()
     m_stbc (false),
     m_bssColor (0),
     m_length (0),
+    m_puncturedSubchannels (0),
     m_modeInitialized (false)
 {
 }
@@ -63,6 +64,7 @@ WifiTxVector::WifiTxVector (WifiMode mode,
     m_stbc (stbc),
     m_bssColor (bssColor),
     m_length (length),
+    m_puncturedSubchannels (0),
     m_modeInitialized (true)
 {
 }
@@ -80,6 +82,7 @@ WifiTxVector::WifiTxVector (const WifiTxVector& txVector)
     m_stbc (txVector.m_stbc),
     m_bssColor (txVector.m_bssColor),
     m_length (txVector.m_length),
+    m_puncturedSubchannels (txVector.m_puncturedSubchannels),
     m_modeInitialized (txVector.m_modeInitialized)
 {
   m_muUserInfos.clear ();
@@ -299,6 +302,24 @@ WifiTxVector::GetLength (void) const
   return m_length;
 }
 
+void
+WifiTxVector::SetPuncturedSubchannels (uint8_t punctured)
+{
+  m_puncturedSubchannels = punctured;
+}
+
+uint8_t
+WifiTxVector::GetPuncturedSubchannels (void) const
+{
+  return m_puncturedSubchannels;
+}
+
+bool
+WifiTxVector::IsSubchannelPunctured (uint8_t index) const
+{
+  return ((m_puncturedSubchannels >> index) & 0x01);
+}
+
 bool
 WifiTxVector::IsValid (void) const
 {
@@ -306,6 +327,12 @@ WifiTxVector::IsValid (void) const
     {
       return false;
     }
+  if (m_puncturedSubchannels != 0
+      && (m_channelWidth < 80 || (m_puncturedSubchannels >> (m_channelWidth / 20)) != 0))
+    {
+      //puncturing only applies to 80 MHz and 160 MHz PPDUs
+      return false;
+    }
   std::string modeName = m_mode.GetUniqueName ();
   if (m_channelWidth == 20)
     {
@@ -456,8 +483,12 @@ std::ostream & operator << ( std::ostream &os, const WifiTxVector &v)
     }
   os << "txpwrlvl: " << +v.GetTxPowerLevel ()
      << " preamble: " << v.GetPreambleType ()
-     << " channel width: " << v.GetChannelWidth ()
-     << " GI: " << v.GetGuardInterval ()
+     << " channel width: " << v.GetChannelWidth ();
+  if (v.GetPuncturedSubchannels () != 0)
+    {
+      os << " punctured: " << +v.GetPuncturedSubchannels ();
+    }
+  os << " GI: " << v.GetGuardInterval ()
      << " NTx: " << +v.GetNTx ()
      << " Ness: " << +v.GetNess ()
      << " MPDU aggregation: " << v.IsAggregation ()
@@ -269,6 +269,24 @@ public:
    * \return the LENGTH field of the L-SIG
    */
   uint16_t GetLength (void) const;
+  /**
+   * Set the bitmap of punctured 20 MHz subchannels. Bit i corresponds to the
+   * i-th 20 MHz subchannel of the PPDU bandwidth, starting from the lowest frequency.
+   *
+   * \param punctured the bitmap of punctured 20 MHz subchannels
+   */
+  void SetPuncturedSubchannels (uint8_t punctured);
+  /**
+   * Get the bitmap of punctured 20 MHz subchannels.
+   *
+   * \return the bitmap of punctured 20 MHz subchannels
+   */
+  uint8_t GetPuncturedSubchannels (void) const;
+  /**
+   * \param index the index of the 20 MHz subchannel within the PPDU bandwidth
+   * \return true if the 20 MHz subchannel is punctured
+   */
+  bool IsSubchannelPunctured (uint8_t index) const;
   /**
    * The standard disallows certain combinations of WifiMode, number of
    * spatial streams, and channel widths.  This method can be used to
@@ -351,6 +369,7 @@ private:
 
   uint8_t  m_bssColor;           /**< BSS color */
   uint16_t m_length;             /**< LENGTH field of the L-SIG */
+  uint8_t  m_puncturedSubchannels; /**< bitmap of punctured 20 MHz subchannels */
 
   bool     m_modeInitialized;         /**< Internal initialization flag */
 
@@ -541,6 +541,57 @@ OriginatorBlockAckWindowTest::DoRun (void)
     {
       NS_TEST_EXPECT_MSG_EQ (agreement.m_txWindow.At (i), false, "Incorrect flag after acknowledging the first MPDU");
     }
+
+  // Check a window spanning several words of the bitmap, as it happens with
+  // a buffer size of 256 MPDUs. All the MPDUs but two are acknowledged by
+  // a (simulated) Block Ack, hence the window does not move
+  winSize = 256;
+  startingSeq = 4000;
+  OriginatorBlockAckAgreement heAgreement (Mac48Address ("00:00:00:00:00:02"), 0);
+  heAgreement.SetBufferSize (winSize);
+  heAgreement.SetStartingSequence (startingSeq);
+  heAgreement.InitTxWindow ();
+
+  for (uint16_t i = 1; i < winSize; i++)
+    {
+      if (i != 100)
+        {
+          mpdu->GetHeader ().SetSequenceNumber ((startingSeq + i) % SEQNO_SPACE_SIZE);
+          heAgreement.MarkAckedMpdu (mpdu);
+        }
+    }
+  heAgreement.AdvanceTxWindow ();
+
+  NS_TEST_EXPECT_MSG_EQ (heAgreement.GetStartingSequence (), startingSeq,
+                         "Incorrect starting sequence with the first MPDU unacknowledged");
+  for (uint16_t i = 0; i < winSize; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (heAgreement.m_txWindow.At (i), (i != 0 && i != 100),
+                             "Incorrect flag with two unacknowledged MPDUs");
+    }
+
+  // acknowledge the first MPDU: the window moves up to the other unacknowledged MPDU
+  mpdu->GetHeader ().SetSequenceNumber (startingSeq);
+  heAgreement.NotifyAckedMpdu (mpdu);
+
+  startingSeq = (startingSeq + 100) % SEQNO_SPACE_SIZE;
+  NS_TEST_EXPECT_MSG_EQ (heAgreement.GetStartingSequence (), startingSeq,
+                         "Incorrect starting sequence after acknowledging the first MPDU");
+  for (uint16_t i = 0; i < winSize; i++)
+    {
+      NS_TEST_EXPECT_MSG_EQ (heAgreement.m_txWindow.At (i), (i != 0 && i < winSize - 100),
+                             "Incorrect flag after acknowledging the first MPDU");
+    }
+
+  // acknowledge the last unacknowledged MPDU: the window moves past all the MPDUs
+  mpdu->GetHeader ().SetSequenceNumber (startingSeq);
+  heAgreement.NotifyAckedMpdu (mpdu);
+
+  startingSeq = (startingSeq + winSize - 100) % SEQNO_SPACE_SIZE;
+  NS_TEST_EXPECT_MSG_EQ (heAgreement.GetStartingSequence (), startingSeq,
+                         "Incorrect starting sequence after acknowledging all the MPDUs");
+  NS_TEST_EXPECT_MSG_EQ (heAgreement.m_txWindow.GetNContiguousSet (), 0,
+                         "Incorrect number of acknowledged MPDUs at the head of the window");
 }
 
 
@@ -922,6 +922,37 @@ ChannelAccessManagerTest::DoRun (void)
   AddAccessRequest (101, 2, 110, 0);
   ExpectCollision (101, 0, 0); //backoff: 0 slots
   EndTest ();
+
+  // Check that the access grant start and the backoff ends are only
+  // computed again when the medium state changes. The same CCA busy period
+  // is notified several times (e.g., once per sub-band of a bonded channel),
+  // which leaves the access grant start unchanged.
+  //
+  //  20      60     66      70                  80    84     90      94           126
+  //   | busy  | sifs | aifsn | bslot0 | bslot1 |  | busy | sifs | aifsn | bslot2-9 | tx |
+  //       |
+  //      30 request access. backoff slots: 10
+  //
+  StartTest (4, 6, 10);
+  AddDcfState (1);
+  for (uint32_t i = 0; i < 10; i++)
+    {
+      AddCcaBusyEvt (20, 40);
+    }
+  for (uint32_t i = 0; i < 5; i++)
+    {
+      AddCcaBusyEvt (80, 4);
+    }
+  AddAccessRequest (30, 2, 126, 0);
+  ExpectCollision (30, 10, 0); // backoff: 10 slots
+  Ptr<ChannelAccessManager> manager = m_ChannelAccessManager;
+  EndTest ();
+  // computed by the first notification (initial state) and by the second
+  // notification of each busy period, once the first one changed the busy
+  // end; the access request and the access timeouts reuse the cached value
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNAccessGrantStartComputations (), 3, "Unexpected number of access grant start computations");
+  // scheduled at 30 us (for 110 us) and 110 us (for 126 us)
+  NS_TEST_EXPECT_MSG_EQ (manager->GetNAccessTimeoutEvents (), 2, "Unexpected number of access timeout events");
 }
 
 
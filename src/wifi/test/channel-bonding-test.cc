@@ -37,6 +37,7 @@
 #include "ns3/constant-position-mobility-model.h"
 #include "ns3/constant-threshold-channel-bonding-manager.h"
 #include "ns3/dynamic-threshold-channel-bonding-manager.h"
+#include "ns3/puncturing-channel-bonding-manager.h"
 #include "ns3/waveform-generator.h"
 #include "ns3/non-communicating-net-device.h"
 #include "ns3/mobility-helper.h"
@@ -2967,6 +2968,416 @@ TestStaticChannelBondingChannelAccess::DoRun (void)
   Simulator::Destroy ();
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Primary channel relocation test
+ *
+ * In this test, an 802.11ac PHY operates on channel 42 (80 MHz) with channel 36
+ * as primary 20 MHz channel, and a 20 MHz 802.11ac transmitter operates on channel 44.
+ * The primary channel of the 80 MHz PHY is relocated at runtime while the 20 MHz
+ * transmitter is active, and we verify that the primary band indices and the CCA
+ * state follow the new primary channel while the spectrum model is kept.
+ */
+class TestPrimaryChannelRelocation : public TestCase
+{
+public:
+  TestPrimaryChannelRelocation ();
+  virtual ~TestPrimaryChannelRelocation ();
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+
+  /**
+   * Create a PHY
+   * \param channel the Spectrum channel
+   * \param channelWidth the channel width
+   * \param channelNumber the operating channel number
+   * \param frequency the operating frequency
+   * \param primaryChannelNumber the channel number of the primary 20 MHz
+   * \param position the position of the PHY
+   * \return the created PHY
+   */
+  Ptr<BondingTestSpectrumWifiPhy> CreatePhy (const Ptr<MultiModelSpectrumChannel> channel,
+                                             uint16_t channelWidth, uint8_t channelNumber,
+                                             uint16_t frequency, uint8_t primaryChannelNumber,
+                                             Vector position);
+
+  /**
+   * Send a packet from the 20 MHz transmitter
+   */
+  void SendPacket (void);
+
+  /**
+   * Relocate the primary channel of the 80 MHz PHY
+   * \param primaryChannelNumber the new primary 20 MHz channel number
+   */
+  void SwitchPrimaryChannel (uint8_t primaryChannelNumber);
+
+  /**
+   * Check the primary channel of the 80 MHz PHY
+   * \param expectedPrimaryChannelNumber the expected primary 20 MHz channel number
+   * \param expectedIndex20 the expected index of the primary 20 MHz band
+   * \param expectedIndex40 the expected index of the primary 40 MHz band
+   */
+  void CheckPrimaryChannel (uint8_t expectedPrimaryChannelNumber, uint8_t expectedIndex20, uint8_t expectedIndex40);
+
+  /**
+   * Check the PHY state of the 80 MHz PHY
+   * \param expectedState the expected PHY state
+   */
+  void CheckPhyState (WifiPhyState expectedState);
+
+  Ptr<BondingTestSpectrumWifiPhy> m_phy;      ///< 80 MHz PHY whose primary channel is relocated
+  Ptr<BondingTestSpectrumWifiPhy> m_txPhy;    ///< 20 MHz transmitter on channel 44
+  Ptr<const SpectrumModel> m_spectrumModel;   ///< RX spectrum model of the 80 MHz PHY before relocation
+};
+
+TestPrimaryChannelRelocation::TestPrimaryChannelRelocation ()
+  : TestCase ("Primary channel relocation test")
+{
+}
+
+TestPrimaryChannelRelocation::~TestPrimaryChannelRelocation ()
+{
+  m_phy = 0;
+  m_txPhy = 0;
+  m_spectrumModel = 0;
+}
+
+Ptr<BondingTestSpectrumWifiPhy>
+TestPrimaryChannelRelocation::CreatePhy (const Ptr<MultiModelSpectrumChannel> channel,
+                                         uint16_t channelWidth, uint8_t channelNumber,
+                                         uint16_t frequency, uint8_t primaryChannelNumber,
+                                         Vector position)
+{
+  Ptr<BondingTestSpectrumWifiPhy> phy = CreateObject<BondingTestSpectrumWifiPhy> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (position);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211ac);
+  phy->CreateWifiSpectrumPhyInterface (nullptr);
+  phy->SetChannel (channel);
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  phy->SetChannelWidth (channelWidth);
+  phy->SetChannelNumber (channelNumber);
+  phy->SetPrimaryChannelNumber (primaryChannelNumber);
+  phy->SetFrequency (frequency);
+  phy->SetTxPowerStart (0.0);
+  phy->SetTxPowerEnd (0.0);
+  phy->SetRxSensitivity (-91.0);
+  phy->SetAttribute ("TxMaskInnerBandMinimumRejection", DoubleValue (-40.0));
+  phy->SetAttribute ("TxMaskOuterBandMinimumRejection", DoubleValue (-56.0));
+  phy->SetAttribute ("TxMaskOuterBandMaximumRejection", DoubleValue (-80.0));
+  phy->Initialize ();
+  return phy;
+}
+
+void
+TestPrimaryChannelRelocation::SendPacket (void)
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetVhtMcs7 (), 0, WIFI_PREAMBLE_VHT_SU, 800, 1, 1, 0, 20, false, false);
+  Ptr<Packet> pkt = Create<Packet> (1000);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  m_txPhy->Send (WifiPsduMap ({std::make_pair (SU_STA_ID, psdu)}), txVector);
+}
+
+void
+TestPrimaryChannelRelocation::SwitchPrimaryChannel (uint8_t primaryChannelNumber)
+{
+  m_phy->SwitchPrimaryChannel (primaryChannelNumber);
+}
+
+void
+TestPrimaryChannelRelocation::CheckPrimaryChannel (uint8_t expectedPrimaryChannelNumber, uint8_t expectedIndex20, uint8_t expectedIndex40)
+{
+  NS_TEST_ASSERT_MSG_EQ (+m_phy->GetPrimaryChannelNumber (), +expectedPrimaryChannelNumber, "Unexpected primary channel number");
+  NS_TEST_ASSERT_MSG_EQ (+m_phy->GetPrimaryBandIndex (20), +expectedIndex20, "Unexpected primary 20 MHz band index");
+  NS_TEST_ASSERT_MSG_EQ (+m_phy->GetPrimaryBandIndex (40), +expectedIndex40, "Unexpected primary 40 MHz band index");
+  NS_TEST_ASSERT_MSG_EQ (m_phy->GetRxSpectrumModel (), m_spectrumModel, "Spectrum model should not be rebuilt upon primary channel relocation");
+}
+
+void
+TestPrimaryChannelRelocation::CheckPhyState (WifiPhyState expectedState)
+{
+  WifiPhyState currentState = m_phy->GetPhyState ();
+  NS_TEST_ASSERT_MSG_EQ (currentState, expectedState, "PHY State " << currentState << " does not match expected state " << expectedState << " at " << Simulator::Now ());
+}
+
+void
+TestPrimaryChannelRelocation::DoSetup (void)
+{
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+
+  Ptr<MatrixPropagationLossModel> lossModel = CreateObject<MatrixPropagationLossModel> ();
+  lossModel->SetDefaultLoss (50); // set default loss to 50 dB for all links
+  channel->AddPropagationLossModel (lossModel);
+
+  Ptr<ConstantSpeedPropagationDelayModel> delayModel = CreateObject<ConstantSpeedPropagationDelayModel> ();
+  channel->SetPropagationDelayModel (delayModel);
+
+  m_phy = CreatePhy (channel, 80 /* channel width */, 42 /* channel number */, 5210 /* frequency */, 36 /* primary channel number */, Vector (0.0, 0.0, 0.0));
+  m_txPhy = CreatePhy (channel, 20 /* channel width */, 44 /* channel number */, 5220 /* frequency */, 44 /* primary channel number */, Vector (1.0, 0.0, 0.0));
+  m_spectrumModel = m_phy->GetRxSpectrumModel ();
+}
+
+void
+TestPrimaryChannelRelocation::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  int64_t streamNumber = 0;
+  m_phy->AssignStreams (streamNumber);
+  m_txPhy->AssignStreams (streamNumber);
+
+  //CASE 1: relocate primary channel from 36 to 44 and back while the medium is idle
+  Simulator::Schedule (Seconds (1.0), &TestPrimaryChannelRelocation::CheckPrimaryChannel, this, 36, 0, 0);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (1), &TestPrimaryChannelRelocation::SwitchPrimaryChannel, this, 44);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (2), &TestPrimaryChannelRelocation::CheckPrimaryChannel, this, 44, 2, 1);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (3), &TestPrimaryChannelRelocation::SwitchPrimaryChannel, this, 40);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (4), &TestPrimaryChannelRelocation::CheckPrimaryChannel, this, 40, 1, 0);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (5), &TestPrimaryChannelRelocation::SwitchPrimaryChannel, this, 36);
+  Simulator::Schedule (Seconds (1.0) + MicroSeconds (6), &TestPrimaryChannelRelocation::CheckPrimaryChannel, this, 36, 0, 0);
+
+  //CASE 2: channel 44 is occupied, the PHY shall be IDLE with primary 36 and CCA_BUSY once its primary channel is relocated to 44
+  Simulator::Schedule (Seconds (2.0), &TestPrimaryChannelRelocation::SendPacket, this);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (50), &TestPrimaryChannelRelocation::CheckPhyState, this, WifiPhyState::IDLE);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (60), &TestPrimaryChannelRelocation::SwitchPrimaryChannel, this, 44);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (61), &TestPrimaryChannelRelocation::CheckPhyState, this, WifiPhyState::CCA_BUSY);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (61), &TestPrimaryChannelRelocation::CheckPrimaryChannel, this, 44, 2, 1);
+
+  //CASE 3: relocating the primary channel back to 36 while channel 44 is still occupied shall make the PHY IDLE again
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (70), &TestPrimaryChannelRelocation::SwitchPrimaryChannel, this, 36);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (71), &TestPrimaryChannelRelocation::CheckPhyState, this, WifiPhyState::IDLE);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (71), &TestPrimaryChannelRelocation::CheckPrimaryChannel, this, 36, 0, 0);
+
+  Simulator::Run ();
+  Simulator::Destroy ();
+}
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Preamble puncturing test
+ *
+ * In this test, an 802.11ac transmitter using the puncturing channel bonding manager
+ * and an 802.11ac receiver both operate on channel 42 (80 MHz) with channel 36 as
+ * primary 20 MHz channel. A 20 MHz interferer occupies channel 44. We verify that the
+ * manager keeps the 80 MHz channel width with channel 44 punctured, that the punctured
+ * PPDU is successfully received despite the interference on the punctured subchannel,
+ * and that the allowed puncturing patterns are enforced.
+ */
+class TestPreamblePuncturing : public TestCase
+{
+public:
+  TestPreamblePuncturing ();
+  virtual ~TestPreamblePuncturing ();
+
+private:
+  virtual void DoSetup (void);
+  virtual void DoRun (void);
+
+  /**
+   * Create a PHY
+   * \param channel the Spectrum channel
+   * \param channelWidth the channel width
+   * \param channelNumber the operating channel number
+   * \param frequency the operating frequency
+   * \param primaryChannelNumber the channel number of the primary 20 MHz
+   * \param position the position of the PHY
+   * \return the created PHY
+   */
+  Ptr<BondingTestSpectrumWifiPhy> CreatePhy (const Ptr<MultiModelSpectrumChannel> channel,
+                                             uint16_t channelWidth, uint8_t channelNumber,
+                                             uint16_t frequency, uint8_t primaryChannelNumber,
+                                             Vector position);
+
+  /**
+   * Send a packet from the 20 MHz interferer
+   */
+  void SendInterference (void);
+
+  /**
+   * Send a packet from the 80 MHz transmitter using the channel width and
+   * the puncturing pattern selected by the channel bonding manager
+   */
+  void SendPacket (void);
+
+  /**
+   * Check the channel width and the puncturing pattern selected by the channel bonding manager
+   * \param expectedChannelWidth the expected channel width
+   * \param expectedPunctured the expected bitmap of punctured 20 MHz subchannels
+   */
+  void CheckSelection (uint16_t expectedChannelWidth, uint8_t expectedPunctured);
+
+  /**
+   * Callback triggered when a packet has been successfully received by the 80 MHz receiver
+   * \param psdu the PSDU
+   * \param rxSignalInfo the info on the received signal (\see RxSignalInfo)
+   * \param txVector the transmit vector
+   * \param statusPerMpdu reception status per MPDU
+   */
+  void RxSuccess (Ptr<WifiPsdu> psdu, RxSignalInfo rxSignalInfo,
+                  WifiTxVector txVector, std::vector<bool> statusPerMpdu);
+
+  Ptr<BondingTestSpectrumWifiPhy> m_txPhy;         ///< 80 MHz transmitter
+  Ptr<BondingTestSpectrumWifiPhy> m_rxPhy;         ///< 80 MHz receiver
+  Ptr<BondingTestSpectrumWifiPhy> m_interfererPhy; ///< 20 MHz interferer on channel 44
+  Ptr<PuncturingChannelBondingManager> m_manager;  ///< channel bonding manager of the transmitter
+  uint16_t m_usableChannelWidth;                   ///< channel width selected by the channel bonding manager
+  uint32_t m_countRxSuccess;                       ///< count RX success
+  uint8_t m_rxPunctured;                           ///< bitmap of punctured 20 MHz subchannels of the received PPDU
+};
+
+TestPreamblePuncturing::TestPreamblePuncturing ()
+  : TestCase ("Preamble puncturing test"),
+    m_usableChannelWidth (0),
+    m_countRxSuccess (0),
+    m_rxPunctured (0)
+{
+}
+
+TestPreamblePuncturing::~TestPreamblePuncturing ()
+{
+  m_txPhy = 0;
+  m_rxPhy = 0;
+  m_interfererPhy = 0;
+  m_manager = 0;
+}
+
+Ptr<BondingTestSpectrumWifiPhy>
+TestPreamblePuncturing::CreatePhy (const Ptr<MultiModelSpectrumChannel> channel,
+                                   uint16_t channelWidth, uint8_t channelNumber,
+                                   uint16_t frequency, uint8_t primaryChannelNumber,
+                                   Vector position)
+{
+  Ptr<BondingTestSpectrumWifiPhy> phy = CreateObject<BondingTestSpectrumWifiPhy> ();
+  Ptr<ConstantPositionMobilityModel> mobility = CreateObject<ConstantPositionMobilityModel> ();
+  mobility->SetPosition (position);
+  phy->SetMobility (mobility);
+  phy->ConfigureStandard (WIFI_PHY_STANDARD_80211ac);
+  phy->CreateWifiSpectrumPhyInterface (nullptr);
+  phy->SetChannel (channel);
+  phy->SetErrorRateModel (CreateObject<NistErrorRateModel> ());
+  phy->SetChannelWidth (channelWidth);
+  phy->SetChannelNumber (channelNumber);
+  phy->SetPrimaryChannelNumber (primaryChannelNumber);
+  phy->SetFrequency (frequency);
+  phy->SetTxPowerStart (0.0);
+  phy->SetTxPowerEnd (0.0);
+  phy->SetRxSensitivity (-91.0);
+  phy->SetAttribute ("TxMaskInnerBandMinimumRejection", DoubleValue (-40.0));
+  phy->SetAttribute ("TxMaskOuterBandMinimumRejection", DoubleValue (-56.0));
+  phy->SetAttribute ("TxMaskOuterBandMaximumRejection", DoubleValue (-80.0));
+  phy->Initialize ();
+  return phy;
+}
+
+void
+TestPreamblePuncturing::SendInterference (void)
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetVhtMcs0 (), 0, WIFI_PREAMBLE_VHT_SU, 800, 1, 1, 0, 20, false, false);
+  Ptr<Packet> pkt = Create<Packet> (1000);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  m_interfererPhy->Send (WifiPsduMap ({std::make_pair (SU_STA_ID, psdu)}), txVector);
+}
+
+void
+TestPreamblePuncturing::SendPacket (void)
+{
+  WifiTxVector txVector = WifiTxVector (WifiPhy::GetVhtMcs5 (), 0, WIFI_PREAMBLE_VHT_SU, 800, 1, 1, 0, m_usableChannelWidth, false, false);
+  txVector.SetPuncturedSubchannels (m_txPhy->GetPuncturedSubchannels (m_usableChannelWidth));
+  Ptr<Packet> pkt = Create<Packet> (1000);
+  WifiMacHeader hdr;
+  hdr.SetType (WIFI_MAC_QOSDATA);
+  Ptr<WifiPsdu> psdu = Create<WifiPsdu> (pkt, hdr);
+  m_txPhy->Send (WifiPsduMap ({std::make_pair (SU_STA_ID, psdu)}), txVector);
+}
+
+void
+TestPreamblePuncturing::CheckSelection (uint16_t expectedChannelWidth, uint8_t expectedPunctured)
+{
+  m_usableChannelWidth = m_txPhy->GetUsableChannelWidth (WifiPhy::GetVhtMcs5 ());
+  NS_TEST_ASSERT_MSG_EQ (m_usableChannelWidth, expectedChannelWidth, "Unexpected channel width at " << Simulator::Now ());
+  NS_TEST_ASSERT_MSG_EQ (+m_txPhy->GetPuncturedSubchannels (m_usableChannelWidth), +expectedPunctured, "Unexpected puncturing pattern at " << Simulator::Now ());
+}
+
+void
+TestPreamblePuncturing::RxSuccess (Ptr<WifiPsdu> psdu, RxSignalInfo rxSignalInfo,
+                                   WifiTxVector txVector, std::vector<bool> statusPerMpdu)
+{
+  NS_LOG_FUNCTION (this << *psdu << rxSignalInfo.snr << txVector);
+  m_countRxSuccess++;
+  m_rxPunctured = txVector.GetPuncturedSubchannels ();
+}
+
+void
+TestPreamblePuncturing::DoSetup (void)
+{
+  Ptr<MultiModelSpectrumChannel> channel = CreateObject<MultiModelSpectrumChannel> ();
+
+  Ptr<MatrixPropagationLossModel> lossModel = CreateObject<MatrixPropagationLossModel> ();
+  lossModel->SetDefaultLoss (50); // set default loss to 50 dB for all links
+  channel->AddPropagationLossModel (lossModel);
+
+  Ptr<ConstantSpeedPropagationDelayModel> delayModel = CreateObject<ConstantSpeedPropagationDelayModel> ();
+  channel->SetPropagationDelayModel (delayModel);
+
+  m_txPhy = CreatePhy (channel, 80 /* channel width */, 42 /* channel number */, 5210 /* frequency */, 36 /* primary channel number */, Vector (0.0, 0.0, 0.0));
+  m_rxPhy = CreatePhy (channel, 80 /* channel width */, 42 /* channel number */, 5210 /* frequency */, 36 /* primary channel number */, Vector (1.0, 0.0, 0.0));
+  m_interfererPhy = CreatePhy (channel, 20 /* channel width */, 44 /* channel number */, 5220 /* frequency */, 44 /* primary channel number */, Vector (2.0, 0.0, 0.0));
+
+  m_manager = CreateObject<PuncturingChannelBondingManager> ();
+  m_txPhy->SetChannelBondingManager (m_manager);
+  m_txPhy->SetPifs (MicroSeconds (25));
+
+  m_rxPhy->SetReceiveOkCallback (MakeCallback (&TestPreamblePuncturing::RxSuccess, this));
+}
+
+void
+TestPreamblePuncturing::DoRun (void)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  int64_t streamNumber = 0;
+  m_txPhy->AssignStreams (streamNumber);
+  m_rxPhy->AssignStreams (streamNumber);
+  m_interfererPhy->AssignStreams (streamNumber);
+
+  //allowed puncturing patterns (primary 20 MHz channel is the lowest one unless stated otherwise)
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (80, 0, 0x02), true, "Secondary 20 MHz can be punctured in 80 MHz");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (80, 0, 0x08), true, "One 20 MHz of the secondary 40 MHz can be punctured in 80 MHz");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (80, 0, 0x0c), false, "Secondary 40 MHz cannot be punctured in 80 MHz");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (80, 2, 0x04), false, "Primary 20 MHz cannot be punctured");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (40, 0, 0x02), false, "40 MHz cannot be punctured");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (160, 0, 0x32), true, "Secondary 20 MHz and part of the secondary 80 MHz can be punctured in 160 MHz");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (160, 5, 0x10), true, "Secondary 20 MHz can be punctured in 160 MHz with primary in the upper 80 MHz");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (160, 0, 0x04), false, "Secondary 40 MHz cannot be punctured in 160 MHz");
+  NS_TEST_EXPECT_MSG_EQ (PuncturingChannelBondingManager::IsPuncturingPatternAllowed (160, 0, 0xf0), false, "Whole secondary 80 MHz cannot be punctured in 160 MHz");
+
+  //CASE 1: the medium is idle, the whole 80 MHz channel is used without puncturing
+  Simulator::Schedule (Seconds (1.0), &TestPreamblePuncturing::CheckSelection, this, 80, 0);
+
+  //CASE 2: channel 44 is occupied, it is punctured and the PPDU is received over the other 20 MHz subchannels
+  Simulator::Schedule (Seconds (2.0), &TestPreamblePuncturing::SendInterference, this);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (50), &TestPreamblePuncturing::CheckSelection, this, 80, 0x04);
+  Simulator::Schedule (Seconds (2.0) + MicroSeconds (51), &TestPreamblePuncturing::SendPacket, this);
+
+  Simulator::Run ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_countRxSuccess, 1, "The punctured PPDU should have been successfully received");
+  NS_TEST_ASSERT_MSG_EQ (+m_rxPunctured, 0x04, "The puncturing pattern should be signaled to the receiver");
+
+  Simulator::Destroy ();
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -2987,6 +3398,8 @@ WifiChannelBondingTestSuite::WifiChannelBondingTestSuite ()
   AddTestCase (new TestConstantThresholdDynamicChannelBonding, TestCase::QUICK);
   AddTestCase (new TestDynamicThresholdDynamicChannelBonding, TestCase::QUICK);
   AddTestCase (new TestEffectiveSnrCalculations, TestCase::QUICK);
+  AddTestCase (new TestPrimaryChannelRelocation, TestCase::QUICK);
+  AddTestCase (new TestPreamblePuncturing, TestCase::QUICK);
 }
 
 static WifiChannelBondingTestSuite wifiChannelBondingTestSuite; ///< the test suite
@@ -202,6 +202,77 @@ SpectrumWifiPhyBasicTest::DoRun (void)
   NS_TEST_ASSERT_MSG_EQ (m_count, 3, "Didn't receive right number of packets");
 }
 
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Spectrum Wifi Phy Serialization Test
+ *
+ * Check that the signal parameters rebuilt from their serialized
+ * representation (used to exchange signals between the systems of a
+ * distributed simulation) match the original ones and are received.
+ */
+class SpectrumWifiPhySerializationTest : public SpectrumWifiPhyBasicTest
+{
+public:
+  SpectrumWifiPhySerializationTest ();
+
+private:
+  virtual void DoRun (void);
+  /**
+   * Send a copy of the given signal rebuilt from its serialized representation
+   * \param txParams the signal parameters
+   */
+  void SendSerializedSignal (Ptr<SpectrumSignalParameters> txParams);
+};
+
+SpectrumWifiPhySerializationTest::SpectrumWifiPhySerializationTest ()
+  : SpectrumWifiPhyBasicTest ("SpectrumWifiPhy test case receives a serialized signal")
+{
+}
+
+void
+SpectrumWifiPhySerializationTest::SendSerializedSignal (Ptr<SpectrumSignalParameters> txParams)
+{
+  Ptr<WifiSpectrumSignalParameters> wifiTxParams = DynamicCast<WifiSpectrumSignalParameters> (txParams);
+  Buffer buffer;
+  buffer.AddAtStart (txParams->GetSerializedSize ());
+  txParams->Serialize (buffer.Begin ());
+
+  Ptr<WifiSpectrumSignalParameters> rxParams = Create<WifiSpectrumSignalParameters> ();
+  rxParams->psd = Create<SpectrumValue> (txParams->psd->GetSpectrumModel ());
+  uint32_t size = rxParams->Deserialize (buffer.Begin ());
+
+  NS_TEST_EXPECT_MSG_EQ (size, buffer.GetSize (), "Unexpected number of bytes read");
+  NS_TEST_EXPECT_MSG_EQ (rxParams->duration, txParams->duration, "Unexpected duration");
+  NS_TEST_EXPECT_MSG_EQ (std::equal (rxParams->psd->ConstValuesBegin (), rxParams->psd->ConstValuesEnd (),
+                                     txParams->psd->ConstValuesBegin ()), true, "Unexpected PSD");
+  NS_TEST_EXPECT_MSG_EQ (rxParams->ppdu->GetUid (), wifiTxParams->ppdu->GetUid (), "Unexpected PPDU UID");
+  NS_TEST_EXPECT_MSG_EQ (rxParams->ppdu->GetTxDuration (), wifiTxParams->ppdu->GetTxDuration (), "Unexpected PPDU duration");
+  NS_TEST_EXPECT_MSG_EQ (rxParams->ppdu->GetTxVector ().GetMode (), wifiTxParams->ppdu->GetTxVector ().GetMode (), "Unexpected mode");
+  NS_TEST_EXPECT_MSG_EQ (rxParams->ppdu->GetTxVector ().GetChannelWidth (), wifiTxParams->ppdu->GetTxVector ().GetChannelWidth (), "Unexpected channel width");
+  Ptr<const WifiPsdu> rxPsdu = rxParams->ppdu->GetPsdu ();
+  Ptr<const WifiPsdu> txPsdu = wifiTxParams->ppdu->GetPsdu ();
+  NS_TEST_EXPECT_MSG_EQ (rxPsdu->GetSize (), txPsdu->GetSize (), "Unexpected PSDU size");
+  NS_TEST_EXPECT_MSG_EQ (rxPsdu->IsAggregate (), txPsdu->IsAggregate (), "Unexpected PSDU aggregation");
+  NS_TEST_EXPECT_MSG_EQ (rxPsdu->GetHeader (0).GetType (), txPsdu->GetHeader (0).GetType (), "Unexpected MAC header");
+  NS_TEST_EXPECT_MSG_EQ (rxPsdu->GetPayload (0)->GetUid (), txPsdu->GetPayload (0)->GetUid (), "Unexpected packet UID");
+
+  m_phy->StartRx (rxParams);
+}
+
+void
+SpectrumWifiPhySerializationTest::DoRun (void)
+{
+  double txPowerWatts = 0.010;
+  Simulator::Schedule (Seconds (1), &SpectrumWifiPhySerializationTest::SendSerializedSignal, this,
+                       MakeSignal (txPowerWatts));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  NS_TEST_ASSERT_MSG_EQ (m_count, 1, "Didn't receive the serialized signal");
+}
+
 /**
  * \ingroup wifi-test
  * \ingroup tests
@@ -676,6 +747,7 @@ SpectrumWifiPhyTestSuite::SpectrumWifiPhyTestSuite ()
   : TestSuite ("spectrum-wifi-phy", UNIT)
 {
   AddTestCase (new SpectrumWifiPhyBasicTest, TestCase::QUICK);
+  AddTestCase (new SpectrumWifiPhySerializationTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyListenerTest, TestCase::QUICK);
   AddTestCase (new SpectrumWifiPhyFilterTest, TestCase::QUICK);
 }
@@ -179,6 +179,17 @@ AmpduAggregationTest::DoRun (void)
   NS_TEST_EXPECT_MSG_EQ (mpduList.size (), 3, "A-MPDU should contain 3 MPDUs");
   NS_TEST_EXPECT_MSG_EQ (m_mac->GetBEQueue ()->GetWifiMacQueue ()->GetNPackets (), 0, "queue should be empty");
 
+  AmpduBuilder builder;
+  for (auto& mpdu : mpduList)
+    {
+      uint32_t expectedSize = builder.GetSizeIfAdded (mpdu->GetSize ());
+      builder.Add (mpdu);
+      NS_TEST_EXPECT_MSG_EQ (builder.GetSize (), expectedSize, "A-MPDU builder size is not consistent");
+    }
+  NS_TEST_EXPECT_MSG_EQ (builder.GetSize (), psdu->GetSize (), "A-MPDU builder size differs from the PSDU size");
+  NS_TEST_EXPECT_MSG_EQ (builder.TakeMpduList ().size (), 3, "A-MPDU builder should contain 3 MPDUs");
+  NS_TEST_EXPECT_MSG_EQ (builder.GetNMpdus (), 0, "A-MPDU builder should be empty");
+
   Ptr <WifiMacQueueItem> dequeuedItem;
   WifiMacHeader dequeuedHdr;
   for (uint32_t i = 0; i < psdu->GetNMpdus (); i++)
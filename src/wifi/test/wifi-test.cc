@@ -47,6 +47,8 @@
 #include "ns3/wifi-ppdu.h"
 #include "ns3/wifi-psdu.h"
 #include "ns3/static-channel-bonding-manager.h"
+#include "ns3/net-device-queue-interface.h"
+#include "ns3/queue-limits.h"
 
 using namespace ns3;
 
@@ -2167,6 +2169,234 @@ Bug2470TestCase::DoRun (void)
   // but before it does not enter RESET state. More tests should be written to verify all possible scenarios.
 }
 
+//-----------------------------------------------------------------------------
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Queue limits counting the bytes reported by the device
+ */
+class BqlTestQueueLimits : public QueueLimits
+{
+public:
+  BqlTestQueueLimits ()
+    : m_queued (0),
+      m_completed (0),
+      m_nCompletions (0)
+  {
+  }
+  virtual void Reset (void)
+  {
+  }
+  virtual void Completed (uint32_t count)
+  {
+    NS_ASSERT (m_completed + count <= m_queued);
+    m_completed += count;
+    m_nCompletions++;
+  }
+  virtual int32_t Available (void) const
+  {
+    return 1;
+  }
+  virtual void Queued (uint32_t count)
+  {
+    m_queued += count;
+  }
+
+  uint32_t m_queued;        ///< bytes reported as queued
+  uint32_t m_completed;     ///< bytes reported as transmitted
+  uint32_t m_nCompletions;  ///< number of times bytes were reported as transmitted
+};
+
+/**
+ * \ingroup wifi-test
+ * \ingroup tests
+ *
+ * \brief Byte queue limits test
+ *
+ * An AP sends bursts of packets to a station, which are acknowledged by
+ * Block Acks, and to the broadcast address. All the bytes reported as queued
+ * to the device transmission queue must be reported as transmitted, once per
+ * acknowledgment rather than once per MPDU.
+ *
+ * In the last subtests, the AP receives no Ack from the station, with and
+ * without QoS. The bytes of the packets discarded after
+ * the maximum number of retransmissions must be reported as transmitted
+ * when discarded, and not only when their lifetime expires.
+ */
+class WifiBqlTestCase : public TestCase
+{
+public:
+  WifiBqlTestCase ();
+  virtual ~WifiBqlTestCase ();
+  virtual void DoRun (void);
+
+private:
+  /**
+   * Triggers the arrival of a burst of 1000 Byte-long packets in the source device
+   * \param numPackets number of packets in burst
+   * \param sourceDevice pointer to the source NetDevice
+   * \param destination address of the destination device
+   */
+  void SendPacketBurst (uint32_t numPackets, Ptr<NetDevice> sourceDevice, Address destination) const;
+  /**
+   * Make the given device discard all the frames it receives
+   * \param device the device
+   */
+  void LoseResponses (Ptr<NetDevice> device) const;
+  /**
+   * Record the bytes reported as transmitted so far
+   * \param queueLimits the queue limits
+   */
+  void RecordCompleted (Ptr<BqlTestQueueLimits> queueLimits);
+  /**
+   * Run subtest for this test case
+   * \param broadcast whether the packets are sent to the broadcast address
+   * \param qos whether the AP and the station support QoS
+   * \param lostResponses whether the AP receives no response from the station
+   * \return the queue limits of the first transmission queue of the AP
+   */
+  Ptr<BqlTestQueueLimits> RunSubtest (bool broadcast, bool qos, bool lostResponses);
+
+  uint32_t m_completedBeforeExpiry; ///< bytes reported as transmitted before the lifetime of the packets expires
+};
+
+WifiBqlTestCase::WifiBqlTestCase ()
+  : TestCase ("Test byte queue limits support"),
+    m_completedBeforeExpiry (0)
+{
+}
+
+WifiBqlTestCase::~WifiBqlTestCase ()
+{
+}
+
+void
+WifiBqlTestCase::SendPacketBurst (uint32_t numPackets, Ptr<NetDevice> sourceDevice,
+                                  Address destination) const
+{
+  for (uint32_t i = 0; i < numPackets; i++)
+    {
+      Ptr<Packet> pkt = Create<Packet> (1000); // 1000 dummy bytes of data
+      sourceDevice->Send (pkt, destination, 0);
+    }
+}
+
+void
+WifiBqlTestCase::LoseResponses (Ptr<NetDevice> device) const
+{
+  Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel> ();
+  errorModel->SetUnit (RateErrorModel::ERROR_UNIT_PACKET);
+  errorModel->SetRate (1.0);
+  DynamicCast<WifiNetDevice> (device)->GetPhy ()->SetPostReceptionErrorModel (errorModel);
+}
+
+void
+WifiBqlTestCase::RecordCompleted (Ptr<BqlTestQueueLimits> queueLimits)
+{
+  m_completedBeforeExpiry = queueLimits->m_completed;
+}
+
+Ptr<BqlTestQueueLimits>
+WifiBqlTestCase::RunSubtest (bool broadcast, bool qos, bool lostResponses)
+{
+  RngSeedManager::SetSeed (1);
+  RngSeedManager::SetRun (1);
+  int64_t streamNumber = 100;
+
+  NodeContainer wifiApNode, wifiStaNode;
+  wifiApNode.Create (1);
+  wifiStaNode.Create (1);
+
+  YansWifiPhyHelper phy = YansWifiPhyHelper::Default ();
+  YansWifiChannelHelper channel = YansWifiChannelHelper::Default ();
+  phy.SetChannel (channel.Create ());
+
+  WifiHelper wifi;
+  if (qos)
+    {
+      wifi.SetStandard (WIFI_PHY_STANDARD_80211n_5GHZ);
+      wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                    "DataMode", StringValue ("HtMcs7"),
+                                    "ControlMode", StringValue ("HtMcs7"));
+    }
+  else
+    {
+      wifi.SetStandard (WIFI_PHY_STANDARD_80211a);
+      wifi.SetRemoteStationManager ("ns3::ConstantRateWifiManager",
+                                    "DataMode", StringValue ("OfdmRate54Mbps"),
+                                    "ControlMode", StringValue ("OfdmRate24Mbps"));
+    }
+
+  WifiMacHelper mac;
+  mac.SetType ("ns3::ApWifiMac",
+               "EnableBeaconJitter", BooleanValue (false),
+               "QosSupported", BooleanValue (qos));
+  NetDeviceContainer apDevice = wifi.Install (phy, mac, wifiApNode);
+  mac.SetType ("ns3::StaWifiMac",
+               "QosSupported", BooleanValue (qos));
+  NetDeviceContainer staDevice = wifi.Install (phy, mac, wifiStaNode);
+
+  wifi.AssignStreams (apDevice, streamNumber);
+  wifi.AssignStreams (staDevice, streamNumber);
+
+  MobilityHelper mobility;
+  Ptr<ListPositionAllocator> positionAlloc = CreateObject<ListPositionAllocator> ();
+  positionAlloc->Add (Vector (0.0, 0.0, 0.0));
+  positionAlloc->Add (Vector (1.0, 0.0, 0.0));
+  mobility.SetPositionAllocator (positionAlloc);
+  mobility.SetMobilityModel ("ns3::ConstantPositionMobilityModel");
+  mobility.Install (wifiApNode);
+  mobility.Install (wifiStaNode);
+
+  Ptr<NetDeviceQueueInterface> ndqi = apDevice.Get (0)->GetObject<NetDeviceQueueInterface> ();
+  NS_ASSERT (ndqi);
+  Ptr<BqlTestQueueLimits> queueLimits = CreateObject<BqlTestQueueLimits> ();
+  ndqi->GetTxQueue (0)->SetQueueLimits (queueLimits);
+
+  Address destination = broadcast ? Mac48Address::GetBroadcast () : staDevice.Get (0)->GetAddress ();
+  if (lostResponses)
+    {
+      // the station is associated by then
+      Simulator::Schedule (Seconds (0.49), &WifiBqlTestCase::LoseResponses, this, apDevice.Get (0));
+    }
+  Simulator::Schedule (Seconds (0.5), &WifiBqlTestCase::SendPacketBurst, this, 20, apDevice.Get (0), destination);
+  Simulator::Schedule (Seconds (0.8), &WifiBqlTestCase::SendPacketBurst, this, 20, apDevice.Get (0), destination);
+  // the lifetime of the packets of the first burst expires at 1 second
+  Simulator::Schedule (Seconds (0.95), &WifiBqlTestCase::RecordCompleted, this, queueLimits);
+
+  Simulator::Stop (lostResponses ? Seconds (2.0) : Seconds (1.0));
+  Simulator::Run ();
+  Simulator::Destroy ();
+
+  return queueLimits;
+}
+
+void
+WifiBqlTestCase::DoRun (void)
+{
+  Ptr<BqlTestQueueLimits> queueLimits = RunSubtest (false, true, false);
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (queueLimits->m_queued, 40 * 1000, "Not all the bytes were reported as queued");
+  NS_TEST_ASSERT_MSG_EQ (queueLimits->m_completed, queueLimits->m_queued, "Not all the bytes were reported as transmitted");
+  // the first packet of each burst is sent in a normal MPDU and the others in an A-MPDU
+  NS_TEST_ASSERT_MSG_LT (queueLimits->m_nCompletions, 40, "The bytes should be reported as transmitted once per Block Ack");
+
+  queueLimits = RunSubtest (true, true, false);
+  NS_TEST_ASSERT_MSG_GT_OR_EQ (queueLimits->m_queued, 40 * 1000, "Not all the bytes were reported as queued");
+  NS_TEST_ASSERT_MSG_EQ (queueLimits->m_completed, queueLimits->m_queued, "Not all the bytes of group addressed frames were reported as transmitted");
+
+  // missed Acks, without QoS (Txop) and with QoS (QosTxop)
+  for (uint8_t i = 0; i < 2; i++)
+    {
+      bool qos = (i == 1);
+      queueLimits = RunSubtest (false, qos, true);
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (queueLimits->m_queued, 40 * 1000, "Not all the bytes were reported as queued (QoS: " << qos << ")");
+      NS_TEST_ASSERT_MSG_GT_OR_EQ (m_completedBeforeExpiry, 20 * 1000,
+                                   "The bytes of the discarded packets should be reported as transmitted when discarded (QoS: " << qos << ")");
+      NS_TEST_ASSERT_MSG_EQ (queueLimits->m_completed, queueLimits->m_queued, "Not all the bytes were reported as transmitted (QoS: " << qos << ")");
+    }
+}
+
 //-----------------------------------------------------------------------------
 /**
  * \ingroup wifi-test
@@ -2282,6 +2512,7 @@ WifiTestSuite::WifiTestSuite ()
   AddTestCase (new StaWifiMacScanningTestCase, TestCase::QUICK); //Bug 2399
   AddTestCase (new Bug2470TestCase, TestCase::QUICK); //Bug 2470
   AddTestCase (new HeRuMcsDataRateTestCase, TestCase::QUICK);
+  AddTestCase (new WifiBqlTestCase, TestCase::QUICK);
 }
 
 static WifiTestSuite g_wifiTestSuite; ///< the test suite
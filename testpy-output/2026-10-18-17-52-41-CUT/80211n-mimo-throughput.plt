@@ -0,0 +1,425 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "80211n-mimo-throughput.eps"
+set xlabel "Distance (Meters)"
+set ylabel "Throughput (Mbit/s)"
+set xrange [0:100]
+set yrange [0:600]
+set ytics 0,50,600
+set style line 1 dashtype 1 linewidth 5
+set style line 2 dashtype 1 linewidth 5
+set style line 3 dashtype 1 linewidth 5
+set style line 4 dashtype 1 linewidth 5
+set style line 5 dashtype 1 linewidth 5
+set style line 6 dashtype 1 linewidth 5
+set style line 7 dashtype 1 linewidth 5
+set style line 8 dashtype 1 linewidth 5
+set style line 9 dashtype 2 linewidth 5
+set style line 10 dashtype 2 linewidth 5
+set style line 11 dashtype 2 linewidth 5
+set style line 12 dashtype 2 linewidth 5
+set style line 13 dashtype 2 linewidth 5
+set style line 14 dashtype 2 linewidth 5
+set style line 15 dashtype 2 linewidth 5
+set style line 16 dashtype 2 linewidth 5
+set style line 17 dashtype 3 linewidth 5
+set style line 18 dashtype 3 linewidth 5
+set style line 19 dashtype 3 linewidth 5
+set style line 20 dashtype 3 linewidth 5
+set style line 21 dashtype 3 linewidth 5
+set style line 22 dashtype 3 linewidth 5
+set style line 23 dashtype 3 linewidth 5
+set style line 24 dashtype 3 linewidth 5
+set style line 25 dashtype 4 linewidth 5
+set style line 26 dashtype 4 linewidth 5
+set style line 27 dashtype 4 linewidth 5
+set style line 28 dashtype 4 linewidth 5
+set style line 29 dashtype 4 linewidth 5
+set style line 30 dashtype 4 linewidth 5
+set style line 31 dashtype 4 linewidth 5
+set style line 32 dashtype 4 linewidth 5
+set style increment user
+plot "-"  title "HtMcs0" with lines, "-"  title "HtMcs1" with lines, "-"  title "HtMcs2" with lines, "-"  title "HtMcs3" with lines, "-"  title "HtMcs4" with lines, "-"  title "HtMcs5" with lines, "-"  title "HtMcs6" with lines, "-"  title "HtMcs7" with lines, "-"  title "HtMcs8" with lines, "-"  title "HtMcs9" with lines, "-"  title "HtMcs10" with lines, "-"  title "HtMcs11" with lines, "-"  title "HtMcs12" with lines, "-"  title "HtMcs13" with lines, "-"  title "HtMcs14" with lines, "-"  title "HtMcs15" with lines, "-"  title "HtMcs16" with lines, "-"  title "HtMcs17" with lines, "-"  title "HtMcs18" with lines, "-"  title "HtMcs19" with lines, "-"  title "HtMcs20" with lines, "-"  title "HtMcs21" with lines, "-"  title "HtMcs22" with lines, "-"  title "HtMcs23" with lines, "-"  title "HtMcs24" with lines, "-"  title "HtMcs25" with lines, "-"  title "HtMcs26" with lines, "-"  title "HtMcs27" with lines, "-"  title "HtMcs28" with lines, "-"  title "HtMcs29" with lines, "-"  title "HtMcs30" with lines, "-"  title "HtMcs31" with lines
+0 5.18144
+10 5.2992
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 11.1872
+10 10.8339
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 17.4285
+10 16.0154
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 23.4342
+10 23.3165
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 33.5616
+10 34.7392
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 43.8067
+10 44.631
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 52.0499
+10 52.6387
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 54.4051
+10 58.5267
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 11.4227
+10 10.5984
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 22.6099
+10 22.7277
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 33.0906
+10 33.7971
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 46.7507
+10 45.2198
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 69.4784
+10 65.7101
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 91.264
+10 92.4416
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 102.216
+10 103.04
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 105.866
+10 105.984
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 17.4285
+10 15.8976
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 32.384
+10 33.4438
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 49.3414
+10 50.048
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 66.7699
+10 65.7101
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 103.982
+10 104.335
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 125.297
+10 128.594
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 152.499
+10 144.727
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 158.269
+10 161.802
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 21.5501
+10 23.1987
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 46.8685
+10 43.689
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 68.3008
+10 66.1811
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 87.2602
+10 87.0246
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 132.833
+10 134.011
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 176.758
+10 178.053
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 199.368
+10 198.661
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
+0 202.076
+10 210.555
+20 0
+30 0
+40 0
+50 0
+60 0
+70 0
+80 0
+90 0
+100 0
+e
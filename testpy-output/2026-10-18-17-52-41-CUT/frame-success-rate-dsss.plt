@@ -0,0 +1,1224 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "frame-success-rate-dsss.eps"
+set xlabel "SNR(dB)"
+set ylabel "Frame Success Rate"
+set xrange [-10:20]
+set yrange [0:1.2]
+set style line 1 linewidth 5
+set style line 2 linewidth 5
+set style line 3 linewidth 5
+set style line 4 linewidth 5
+set style line 5 linewidth 5
+set style line 6 linewidth 5
+set style line 7 linewidth 5
+set style line 8 linewidth 5
+set style increment user
+plot "-"  title "DsssRate1Mbps" with lines, "-"  title "DsssRate2Mbps" with lines, "-"  title "DsssRate5_5Mbps" with lines, "-"  title "DsssRate11Mbps" with lines
+-10 9.25939e-298
+-9.9 1.63373e-282
+-9.8 9.64234e-268
+-9.7 1.89875e-253
+-9.6 1.24625e-239
+-9.5 2.72816e-226
+-9.4 1.99639e-213
+-9.3 4.9026e-201
+-9.2 4.06275e-189
+-9.1 1.14431e-177
+-9 1.10514e-166
+-8.9 3.69802e-156
+-8.8 4.33912e-146
+-8.7 1.80968e-136
+-8.6 2.72341e-127
+-8.5 1.50357e-118
+-8.4 3.10051e-110
+-8.3 2.43471e-102
+-8.2 7.43244e-95
+-8.1 9.01557e-88
+-8 4.44677e-81
+-7.9 9.1363e-75
+-7.8 8.0184e-69
+-7.7 3.08538e-63
+-7.6 5.34682e-58
+-7.5 4.28969e-53
+-7.4 1.63884e-48
+-7.3 3.06821e-44
+-7.2 2.89803e-40
+-7.1 1.42215e-36
+-7 3.73459e-33
+-6.9 5.40578e-30
+-6.8 4.44258e-27
+-6.7 2.13477e-24
+-6.6 6.17556e-22
+-6.5 1.10694e-19
+-6.4 1.26479e-17
+-6.3 9.47186e-16
+-6.2 4.77736e-14
+-6.1 1.66638e-12
+-6 4.12434e-11
+-5.9 7.42533e-10
+-5.8 9.95978e-09
+-5.7 1.01843e-07
+-5.6 8.11517e-07
+-5.5 5.14557e-06
+-5.4 2.64827e-05
+-5.3 0.000112728
+-5.2 0.000403945
+-5.1 0.00123888
+-5 0.00330279
+-4.9 0.00776487
+-4.8 0.016315
+-4.7 0.0310164
+-4.6 0.0539586
+-4.5 0.0867947
+-4.4 0.130312
+-4.3 0.184182
+-4.2 0.246965
+-4.1 0.316343
+-4 0.3895
+-3.9 0.463532
+-3.8 0.535791
+-3.7 0.60412
+-3.6 0.666963
+-3.5 0.723367
+-3.4 0.772918
+-3.3 0.815631
+-3.2 0.851838
+-3.1 0.882074
+-3 0.906987
+-2.9 0.927266
+-2.8 0.943592
+-2.7 0.9566
+-2.6 0.966866
+-2.5 0.974895
+-2.4 0.98112
+-2.3 0.985908
+-2.2 0.989559
+-2.1 0.992322
+-2 0.994396
+-1.9 0.995941
+-1.8 0.997083
+-1.7 0.99792
+-1.6 0.998529
+-1.5 0.998968
+-1.4 0.999282
+-1.3 0.999504
+-1.2 0.999661
+-1.1 0.99977
+-1 0.999846
+-0.9 0.999897
+-0.8 0.999932
+-0.7 0.999956
+-0.6 0.999971
+-0.5 0.999982
+-0.4 0.999988
+-0.3 0.999993
+-0.2 0.999995
+-0.1 0.999997
+-1.87905e-14 0.999998
+0.1 0.999999
+0.2 0.999999
+0.3 1
+0.4 1
+0.5 1
+0.6 1
+0.7 1
+0.8 1
+0.9 1
+1 1
+1.1 1
+1.2 1
+1.3 1
+1.4 1
+1.5 1
+1.6 1
+1.7 1
+1.8 1
+1.9 1
+2 1
+2.1 1
+2.2 1
+2.3 1
+2.4 1
+2.5 1
+2.6 1
+2.7 1
+2.8 1
+2.9 1
+3 1
+3.1 1
+3.2 1
+3.3 1
+3.4 1
+3.5 1
+3.6 1
+3.7 1
+3.8 1
+3.9 1
+4 1
+4.1 1
+4.2 1
+4.3 1
+4.4 1
+4.5 1
+4.6 1
+4.7 1
+4.8 1
+4.9 1
+5 1
+5.1 1
+5.2 1
+5.3 1
+5.4 1
+5.5 1
+5.6 1
+5.7 1
+5.8 1
+5.9 1
+6 1
+6.1 1
+6.2 1
+6.3 1
+6.4 1
+6.5 1
+6.6 1
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+e
+-10 0
+-9.9 0
+-9.8 0
+-9.7 0
+-9.6 0
+-9.5 0
+-9.4 0
+-9.3 0
+-9.2 0
+-9.1 0
+-9 0
+-8.9 0
+-8.8 0
+-8.7 0
+-8.6 0
+-8.5 0
+-8.4 0
+-8.3 0
+-8.2 0
+-8.1 0
+-8 0
+-7.9 0
+-7.8 0
+-7.7 0
+-7.6 0
+-7.5 0
+-7.4 0
+-7.3 0
+-7.2 0
+-7.1 0
+-7 0
+-6.9 0
+-6.8 0
+-6.7 0
+-6.6 0
+-6.5 0
+-6.4 9.77164e-314
+-6.3 2.7649e-299
+-6.2 2.76767e-285
+-6.1 9.92848e-272
+-6 1.29326e-258
+-5.9 6.19913e-246
+-5.8 1.10848e-233
+-5.7 7.49725e-222
+-5.6 1.94538e-210
+-5.5 1.96475e-199
+-5.4 7.83818e-189
+-5.3 1.25392e-178
+-5.2 8.16853e-169
+-5.1 2.2012e-159
+-5 2.49328e-150
+-4.9 1.20665e-141
+-4.8 2.53706e-133
+-4.7 2.35723e-125
+-4.6 9.84731e-118
+-4.5 1.88249e-110
+-4.4 1.67662e-103
+-4.3 7.08497e-97
+-4.2 1.44703e-90
+-4.1 1.45546e-84
+-4 7.34788e-79
+-3.9 1.89808e-73
+-3.8 2.55796e-68
+-3.7 1.83409e-63
+-3.6 7.13635e-59
+-3.5 1.53709e-54
+-3.4 1.86967e-50
+-3.3 1.31034e-46
+-3.2 5.39851e-43
+-3.1 1.33401e-39
+-3 2.01717e-36
+-2.9 1.90415e-33
+-2.8 1.14462e-30
+-2.7 4.46885e-28
+-2.6 1.15556e-25
+-2.5 2.01764e-23
+-2.4 2.42461e-21
+-2.3 2.04339e-19
+-2.2 1.23025e-17
+-2.1 5.38812e-16
+-2 1.74738e-14
+-1.9 4.26939e-13
+-1.8 7.99274e-12
+-1.7 1.16547e-10
+-1.6 1.34487e-09
+-1.5 1.24714e-08
+-1.4 9.43294e-08
+-1.3 5.903e-07
+-1.2 3.09843e-06
+-1.1 1.38212e-05
+-1 5.30548e-05
+-0.9 0.000177357
+-0.8 0.000522187
+-0.7 0.0013687
+-0.6 0.00322609
+-0.5 0.00690329
+-0.4 0.0135306
+-0.3 0.0244946
+-0.2 0.0412751
+-0.1 0.0652077
+-1.87905e-14 0.0972292
+0.1 0.137674
+0.2 0.186175
+0.3 0.241686
+0.4 0.302615
+0.5 0.367034
+0.6 0.432898
+0.7 0.498253
+0.8 0.561394
+0.9 0.620958
+1 0.675964
+1.1 0.725803
+1.2 0.770196
+1.3 0.80914
+1.4 0.842833
+1.5 0.871623
+1.6 0.895945
+1.7 0.916278
+1.8 0.933116
+1.9 0.946933
+2 0.958178
+2.1 0.967256
+2.2 0.97453
+2.3 0.980315
+2.4 0.984884
+2.5 0.988467
+2.6 0.991257
+2.7 0.993416
+2.8 0.995074
+2.9 0.996339
+3 0.997298
+3.1 0.99802
+3.2 0.998559
+3.3 0.998958
+3.4 0.999253
+3.5 0.999468
+3.6 0.999624
+3.7 0.999737
+3.8 0.999817
+3.9 0.999874
+4 0.999914
+4.1 0.999941
+4.2 0.999961
+4.3 0.999974
+4.4 0.999983
+4.5 0.999989
+4.6 0.999993
+4.7 0.999995
+4.8 0.999997
+4.9 0.999998
+5 0.999999
+5.1 0.999999
+5.2 1
+5.3 1
+5.4 1
+5.5 1
+5.6 1
+5.7 1
+5.8 1
+5.9 1
+6 1
+6.1 1
+6.2 1
+6.3 1
+6.4 1
+6.5 1
+6.6 1
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+e
+-10 0
+-9.9 0
+-9.8 0
+-9.7 0
+-9.6 0
+-9.5 0
+-9.4 0
+-9.3 0
+-9.2 0
+-9.1 0
+-9 0
+-8.9 0
+-8.8 0
+-8.7 0
+-8.6 0
+-8.5 0
+-8.4 0
+-8.3 0
+-8.2 0
+-8.1 0
+-8 0
+-7.9 0
+-7.8 0
+-7.7 0
+-7.6 0
+-7.5 0
+-7.4 0
+-7.3 0
+-7.2 0
+-7.1 0
+-7 0
+-6.9 0
+-6.8 0
+-6.7 0
+-6.6 0
+-6.5 0
+-6.4 0
+-6.3 0
+-6.2 0
+-6.1 0
+-6 0
+-5.9 0
+-5.8 0
+-5.7 0
+-5.6 0
+-5.5 0
+-5.4 0
+-5.3 0
+-5.2 0
+-5.1 0
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 3.50826e-310
+-0.3 1.52798e-293
+-0.2 1.8647e-277
+-0.1 6.37255e-262
+-1.87905e-14 6.10695e-247
+0.1 1.64657e-232
+0.2 1.25565e-218
+0.3 2.72789e-205
+0.4 1.70387e-192
+0.5 3.09401e-180
+0.6 1.65478e-168
+0.7 2.64585e-157
+0.8 1.2861e-146
+0.9 1.93609e-136
+1 9.21166e-127
+1.1 1.41599e-117
+1.2 7.20023e-109
+1.3 1.24197e-100
+1.4 7.46287e-93
+1.5 1.60644e-85
+1.6 1.27546e-78
+1.7 3.85031e-72
+1.8 4.56011e-66
+1.9 2.18841e-60
+2 4.39869e-55
+2.1 3.8301e-50
+2.2 1.4951e-45
+2.3 2.70868e-41
+2.4 2.35851e-37
+2.5 1.02218e-33
+2.6 2.28369e-30
+2.7 2.72346e-27
+2.8 1.79477e-24
+2.9 6.76328e-22
+3 1.50728e-19
+3.1 2.05336e-17
+3.2 1.76605e-15
+3.3 9.89591e-14
+3.4 3.72455e-12
+3.5 9.69738e-11
+3.6 1.79688e-09
+3.7 2.43489e-08
+3.8 2.47639e-07
+3.9 1.93764e-06
+4 1.19403e-05
+4.1 5.92433e-05
+4.2 0.000241641
+4.3 0.000826131
+4.4 0.00241071
+4.5 0.00610603
+4.6 0.0136344
+4.7 0.027226
+4.8 0.0492582
+4.9 0.0817149
+5 0.125646
+5.1 0.180825
+5.2 0.245723
+5.3 0.317769
+5.4 0.393812
+5.5 0.470607
+5.6 0.54523
+5.7 0.615347
+5.8 0.679327
+5.9 0.736232
+6 0.785722
+6.1 0.827926
+6.2 0.863295
+6.3 0.892483
+6.4 0.916238
+6.5 0.935331
+6.6 0.950503
+6.7 0.962431
+6.8 0.971717
+6.9 0.978878
+7 0.984351
+7.1 0.988498
+7.2 0.991613
+7.3 0.993933
+7.4 0.995646
+7.5 0.996902
+7.6 0.997813
+7.7 0.99847
+7.8 0.998938
+7.9 0.99927
+8 0.999503
+8.1 0.999664
+8.2 0.999775
+8.3 0.999851
+8.4 0.999902
+8.5 0.999937
+8.6 0.999959
+8.7 0.999974
+8.8 0.999984
+8.9 0.99999
+9 0.999994
+9.1 0.999996
+9.2 0.999998
+9.3 0.999999
+9.4 0.999999
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+e
+-10 0
+-9.9 0
+-9.8 0
+-9.7 0
+-9.6 0
+-9.5 0
+-9.4 0
+-9.3 0
+-9.2 0
+-9.1 0
+-9 0
+-8.9 0
+-8.8 0
+-8.7 0
+-8.6 0
+-8.5 0
+-8.4 0
+-8.3 0
+-8.2 0
+-8.1 0
+-8 0
+-7.9 0
+-7.8 0
+-7.7 0
+-7.6 0
+-7.5 0
+-7.4 0
+-7.3 0
+-7.2 0
+-7.1 0
+-7 0
+-6.9 0
+-6.8 0
+-6.7 0
+-6.6 0
+-6.5 0
+-6.4 0
+-6.3 0
+-6.2 0
+-6.1 0
+-6 0
+-5.9 0
+-5.8 0
+-5.7 0
+-5.6 0
+-5.5 0
+-5.4 0
+-5.3 0
+-5.2 0
+-5.1 0
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.87905e-14 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 2.81856e-317
+2.8 5.86965e-299
+2.9 1.78214e-281
+3 8.26508e-265
+3.1 6.14983e-249
+3.2 7.72791e-234
+3.3 1.72935e-219
+3.4 7.27741e-206
+3.5 6.08774e-193
+3.6 1.07092e-180
+3.7 4.1928e-169
+3.8 3.86721e-158
+3.9 8.89399e-148
+4 5.39659e-138
+4.1 9.13593e-129
+4.2 4.56007e-120
+4.3 7.08542e-112
+4.4 3.61473e-104
+4.5 6.37882e-97
+4.6 4.09681e-90
+4.7 1.00622e-83
+4.8 9.91639e-78
+4.9 4.10828e-72
+5 7.48465e-67
+5.1 6.26278e-62
+5.2 2.50978e-57
+5.3 5.01495e-53
+5.4 5.19344e-49
+5.5 2.89269e-45
+5.6 8.9788e-42
+5.7 1.60671e-38
+5.8 1.71206e-35
+5.9 1.12041e-32
+6 4.63739e-30
+6.1 1.24841e-27
+6.2 2.2447e-25
+6.3 2.7646e-23
+6.4 2.38866e-21
+6.5 1.48101e-19
+6.6 6.73203e-18
+6.7 2.28933e-16
+6.8 5.93681e-15
+6.9 1.1954e-13
+7 1.901e-12
+7.1 2.42616e-11
+7.2 2.52276e-10
+7.3 2.16779e-09
+7.4 1.56004e-08
+7.5 9.52074e-08
+7.6 4.98577e-07
+7.7 2.2652e-06
+7.8 9.0216e-06
+7.9 3.18028e-05
+8 0.000100135
+8.1 0.000284007
+8.2 0.000731357
+8.3 0.00172266
+8.4 0.00373715
+8.5 0.00751531
+8.6 0.0140937
+8.7 0.0247861
+8.8 0.0410916
+8.9 0.0645304
+9 0.096427
+9.1 0.13768
+9.2 0.188569
+9.3 0.248634
+9.4 0.31666
+9.5 0.39076
+9.6 0.468552
+9.7 0.547375
+9.8 0.624534
+9.9 0.697515
+10 0.764158
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+e
@@ -0,0 +1,5 @@
+plot "-"  title "multirate" with lines
+0 0
+0.1 0
+0.2 0
+e
@@ -0,0 +1,2 @@
+$node_(0) set X_ 10.0
+$node_(0) set Y_ 0.0
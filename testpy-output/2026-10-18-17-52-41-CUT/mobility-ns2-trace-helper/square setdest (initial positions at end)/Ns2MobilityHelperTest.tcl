@@ -0,0 +1,6 @@
+$ns_ at 1.0 "$node_(0) setdest 15  10  5"
+$ns_ at 2.0 "$node_(0) setdest 15  15  5"
+$ns_ at 3.0 "$node_(0) setdest 10  15  5"
+$ns_ at 4.0 "$node_(0) setdest 10  10  5"
+$node_(0) set X_ 10.0
+$node_(0) set Y_ 10.0
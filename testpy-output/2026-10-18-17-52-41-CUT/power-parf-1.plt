@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-parf-1.eps"
+set title "Average transmit power (AP1 to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Untitled" with lines
+0 0
+1 0.00192
+2 0.00192
+3 0.00192
+4 0.00192
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-parf.eps"
+set title "Average transmit power (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Average Transmit Power" with lines
+5 2.65792
+15 23.5145
+25 25.4042
+35 24.7306
+45 24.5381
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "power-rrpaa.eps"
+set title "Average transmit power (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Power (mW)"
+plot "-"  title "Average Transmit Power" with lines
+5 0.00192
+15 0.00192
+25 0.00192
+35 0.00192
+45 0
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "throughput-aparf.eps"
+set title "Throughput (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Throughput (Mb/s)"
+plot "-"  title "Throughput Mbits/s" with lines
+5 0
+15 0
+25 0
+35 0
+45 0
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "throughput-parf-0.eps"
+set title "Throughput (AP0 to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Throughput (Mb/s)"
+plot "-"  title "Throughput Mbits/s" with lines
+0 0
+1 0
+2 0
+3 0
+4 0
+e
@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "throughput-parf.eps"
+set title "Throughput (AP to STA) vs time"
+set xlabel "Time (seconds)"
+set ylabel "Throughput (Mb/s)"
+plot "-"  title "Throughput Mbits/s" with lines
+5 25.6963
+15 0.01136
+25 0
+35 0
+45 0
+e
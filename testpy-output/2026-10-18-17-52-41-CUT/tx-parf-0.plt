@@ -0,0 +1,12 @@
+set terminal post eps color enhanced
+set output "tx-parf-0.eps"
+set title "Percentage time AP0 in TX state vs time"
+set xlabel "Time (seconds)"
+set ylabel "Percent"
+plot "-"  title "TX Time" with lines
+0 0
+1 0.1012
+2 0.1112
+3 0.1112
+4 0.1112
+e
@@ -0,0 +1,5431 @@
+set terminal postscript eps color enh "Times-BoldItalic"
+set output "yans-frame-success-rate-ax.eps"
+set xlabel "SNR(dB)"
+set ylabel "Frame Success Rate"
+set xrange [-5:55]
+set yrange [0:1]
+set style line 1 linewidth 5
+set style line 2 linewidth 5
+set style line 3 linewidth 5
+set style line 4 linewidth 5
+set style line 5 linewidth 5
+set style line 6 linewidth 5
+set style line 7 linewidth 5
+set style line 8 linewidth 5
+set style line 9 linewidth 5
+set style line 10 linewidth 5
+set style line 11 linewidth 5
+set style increment user
+plot "-"  title "HeMcs0" with lines, "-"  title "HeMcs1" with lines, "-"  title "HeMcs2" with lines, "-"  title "HeMcs3" with lines, "-"  title "HeMcs4" with lines, "-"  title "HeMcs5" with lines, "-"  title "HeMcs6" with lines, "-"  title "HeMcs7" with lines, "-"  title "HeMcs8" with lines, "-"  title "HeMcs9" with lines, "-"  title "HeMcs10" with lines, "-"  title "HeMcs11" with lines
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 4.38582e-319
+-3.2 1.08475e-292
+-3.1 4.55807e-268
+-3 3.97239e-245
+-2.9 8.71433e-224
+-2.8 5.80682e-204
+-2.7 1.41045e-185
+-2.6 1.49042e-168
+-2.5 8.13342e-153
+-2.4 2.70655e-138
+-2.3 6.45066e-125
+-2.2 1.28651e-112
+-2.1 2.49531e-101
+-2 5.44174e-91
+-1.9 1.53445e-81
+-1.8 6.3999e-73
+-1.7 4.49253e-65
+-1.6 6.00746e-58
+-1.5 1.72284e-51
+-1.4 1.18662e-45
+-1.3 2.18646e-40
+-1.2 1.19422e-35
+-1.1 2.13109e-31
+-1 1.36236e-27
+-0.9 3.40338e-24
+-0.8 3.60582e-21
+-0.7 1.74963e-18
+-0.6 4.17814e-16
+-0.5 5.25153e-14
+-0.4 3.6983e-12
+-0.3 1.5464e-10
+-0.2 4.05083e-09
+-0.1 6.98469e-08
+-1.02696e-15 8.29592e-07
+0.1 7.07566e-06
+0.2 4.50135e-05
+0.3 0.000221097
+0.4 0.000865094
+0.5 0.00277358
+0.6 0.00747359
+0.7 0.0173139
+0.8 0.035191
+0.9 0.0638933
+1 0.105288
+1.1 0.159692
+1.2 0.225691
+1.3 0.300418
+1.4 0.380164
+1.5 0.461053
+1.6 0.539615
+1.7 0.613131
+1.8 0.679771
+1.9 0.738555
+2 0.789207
+2.1 0.83198
+2.2 0.867471
+2.3 0.896472
+2.4 0.919852
+2.5 0.938475
+2.6 0.953148
+2.7 0.964596
+2.8 0.973445
+2.9 0.980227
+3 0.985383
+3.1 0.98927
+3.2 0.99218
+3.3 0.994341
+3.4 0.995934
+3.5 0.9971
+3.6 0.997947
+3.7 0.998557
+3.8 0.998994
+3.9 0.999304
+4 0.999522
+4.1 0.999674
+4.2 0.99978
+4.3 0.999853
+4.4 0.999902
+4.5 0.999936
+4.6 0.999958
+4.7 0.999973
+4.8 0.999983
+4.9 0.999989
+5 0.999993
+5.1 0.999996
+5.2 0.999997
+5.3 0.999998
+5.4 0.999999
+5.5 0.999999
+5.6 1
+5.7 1
+5.8 1
+5.9 1
+6 1
+6.1 1
+6.2 1
+6.3 1
+6.4 1
+6.5 1
+6.6 1
+6.7 1
+6.8 1
+6.9 1
+7 1
+7.1 1
+7.2 1
+7.3 1
+7.4 1
+7.5 1
+7.6 1
+7.7 1
+7.8 1
+7.9 1
+8 1
+8.1 1
+8.2 1
+8.3 1
+8.4 1
+8.5 1
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 7.17363e-306
+-0.6 3.15683e-284
+-0.5 9.76567e-264
+-0.4 2.30514e-244
+-0.3 4.50799e-226
+-0.2 7.93281e-209
+-0.1 1.36453e-192
+-1.02696e-15 2.49267e-177
+0.1 5.25402e-163
+0.2 1.38823e-149
+0.3 4.99457e-137
+0.4 2.65698e-125
+0.5 2.26853e-114
+0.6 3.37235e-104
+0.7 9.46278e-95
+0.8 5.42882e-86
+0.9 6.89078e-78
+1 2.09166e-70
+1.1 1.63908e-63
+1.2 3.5744e-57
+1.3 2.33468e-51
+1.4 4.90744e-46
+1.5 3.56015e-41
+1.6 9.54095e-37
+1.7 1.00888e-32
+1.8 4.48621e-29
+1.9 8.92009e-26
+2 8.4127e-23
+2.1 3.98231e-20
+2.2 9.98694e-18
+2.3 1.39692e-15
+2.4 1.14437e-13
+2.5 5.75042e-12
+2.6 1.85141e-10
+2.7 3.979e-09
+2.8 5.93184e-08
+2.9 6.35787e-07
+3 5.06539e-06
+3.1 3.09388e-05
+3.2 0.000149062
+3.3 0.000581541
+3.4 0.00188181
+3.5 0.00516252
+3.6 0.0122485
+3.7 0.0255891
+3.8 0.0478437
+3.9 0.0812289
+4 0.126869
+4.1 0.184408
+4.2 0.252012
+4.3 0.326733
+4.4 0.405066
+4.5 0.483516
+4.6 0.559046
+4.7 0.629331
+4.8 0.692843
+4.9 0.748798
+5 0.797021
+5.1 0.837794
+5.2 0.871696
+5.3 0.899471
+5.4 0.921931
+5.5 0.93988
+5.6 0.954071
+5.7 0.965182
+5.8 0.973802
+5.9 0.980432
+6 0.985489
+6.1 0.989317
+6.2 0.992191
+6.3 0.994333
+6.4 0.995917
+6.5 0.99708
+6.6 0.997927
+6.7 0.998539
+6.8 0.998979
+6.9 0.999292
+7 0.999512
+7.1 0.999667
+7.2 0.999775
+7.3 0.999849
+7.4 0.999899
+7.5 0.999934
+7.6 0.999957
+7.7 0.999972
+7.8 0.999982
+7.9 0.999989
+8 0.999993
+8.1 0.999995
+8.2 0.999997
+8.3 0.999998
+8.4 0.999999
+8.5 0.999999
+8.6 1
+8.7 1
+8.8 1
+8.9 1
+9 1
+9.1 1
+9.2 1
+9.3 1
+9.4 1
+9.5 1
+9.6 1
+9.7 1
+9.8 1
+9.9 1
+10 1
+10.1 1
+10.2 1
+10.3 1
+10.4 1
+10.5 1
+10.6 1
+10.7 1
+10.8 1
+10.9 1
+11 1
+11.1 1
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 1.24426e-301
+3.5 1.60311e-270
+3.6 3.93214e-242
+3.7 2.84677e-216
+3.8 9.21358e-193
+3.9 1.97492e-171
+4 4.06701e-152
+4.1 1.14404e-134
+4.2 6.13084e-119
+4.3 8.56929e-105
+4.4 4.2014e-92
+4.5 9.55107e-81
+4.6 1.30876e-70
+4.7 1.38276e-61
+4.8 1.41856e-53
+4.9 1.7528e-46
+5 3.18876e-40
+5.1 1.02947e-34
+5.2 7.01281e-30
+5.3 1.18298e-25
+5.4 5.72721e-22
+5.5 9.11305e-19
+5.6 5.39582e-16
+5.7 1.33148e-13
+5.8 1.51793e-11
+5.9 8.77731e-10
+6 2.80078e-08
+6.1 5.3202e-07
+6.2 6.43873e-06
+6.3 5.27476e-05
+6.4 0.00030868
+6.5 0.00135329
+6.6 0.00463504
+6.7 0.0128667
+6.8 0.0298922
+6.9 0.0597634
+7 0.105332
+7.1 0.167087
+7.2 0.242821
+7.3 0.328216
+7.4 0.417953
+7.5 0.506852
+7.6 0.590682
+7.7 0.666539
+7.8 0.732851
+7.9 0.789165
+8 0.835834
+8.1 0.873715
+8.2 0.903923
+8.3 0.927644
+8.4 0.946021
+8.5 0.960089
+8.6 0.970741
+8.7 0.978726
+8.8 0.984656
+8.9 0.98902
+9 0.992205
+9.1 0.99451
+9.2 0.996164
+9.3 0.997341
+9.4 0.998172
+9.5 0.998754
+9.6 0.999157
+9.7 0.999435
+9.8 0.999625
+9.9 0.999753
+10 0.999839
+10.1 0.999896
+10.2 0.999933
+10.3 0.999958
+10.4 0.999973
+10.5 0.999983
+10.6 0.99999
+10.7 0.999994
+10.8 0.999996
+10.9 0.999998
+11 0.999999
+11.1 0.999999
+11.2 1
+11.3 1
+11.4 1
+11.5 1
+11.6 1
+11.7 1
+11.8 1
+11.9 1
+12 1
+12.1 1
+12.2 1
+12.3 1
+12.4 1
+12.5 1
+12.6 1
+12.7 1
+12.8 1
+12.9 1
+13 1
+13.1 1
+13.2 1
+13.3 1
+13.4 1
+13.5 1
+13.6 1
+13.7 1
+13.8 1
+13.9 1
+14 1
+14.1 1
+14.2 1
+14.3 1
+14.4 1
+14.5 1
+14.6 1
+14.7 1
+14.8 1
+14.9 1
+15 1
+15.1 1
+15.2 1
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 9.88131e-324
+3.3 5.84887e-312
+3.4 2.23007e-300
+3.5 5.24041e-289
+3.6 7.51733e-278
+3.7 6.52302e-267
+3.8 3.3943e-256
+3.9 1.05051e-245
+4 1.9189e-235
+4.1 2.05393e-225
+4.2 1.27972e-215
+4.3 4.61331e-206
+4.4 9.56976e-197
+4.5 1.13679e-187
+4.6 7.70055e-179
+4.7 2.9641e-170
+4.8 6.46478e-162
+4.9 7.97198e-154
+5 5.55017e-146
+5.1 2.18004e-138
+5.2 4.83124e-131
+5.3 6.04542e-124
+5.4 4.278e-117
+5.5 1.71595e-110
+5.6 3.91344e-104
+5.7 5.09414e-98
+5.8 3.80232e-92
+5.9 1.63615e-86
+6 4.08377e-81
+6.1 5.9531e-76
+6.2 5.10702e-71
+6.3 2.59982e-66
+6.4 7.92452e-62
+6.5 1.46033e-57
+6.6 1.64381e-53
+6.7 1.14262e-49
+6.8 4.96125e-46
+6.9 1.36185e-42
+7 2.39307e-39
+7.1 2.72706e-36
+7.2 2.0425e-33
+7.3 1.01936e-30
+7.4 3.43796e-28
+7.5 7.94902e-26
+7.6 1.27847e-23
+7.7 1.45153e-21
+7.8 1.1808e-19
+7.9 6.98582e-18
+8 3.05095e-16
+8.1 9.98391e-15
+8.2 2.48452e-13
+8.3 4.77125e-12
+8.4 7.174e-11
+8.5 8.56682e-10
+8.6 8.23906e-09
+8.7 6.46946e-08
+8.8 4.2031e-07
+8.9 2.28873e-06
+9 1.05771e-05
+9.1 4.19874e-05
+9.2 0.000144836
+9.3 0.000438989
+9.4 0.00118151
+9.5 0.00285224
+9.6 0.00623497
+9.7 0.0124531
+9.8 0.022918
+9.9 0.039171
+10 0.0626379
+10.1 0.0943556
+10.2 0.134743
+10.3 0.18348
+10.4 0.239521
+10.5 0.301228
+10.6 0.366593
+10.7 0.433474
+10.8 0.499823
+10.9 0.563857
+11 0.624155
+11.1 0.679705
+11.2 0.729892
+11.3 0.774447
+11.4 0.813388
+11.5 0.846946
+11.6 0.8755
+11.7 0.899516
+11.8 0.919503
+11.9 0.935976
+12 0.949431
+12.1 0.960326
+12.2 0.96908
+12.3 0.976058
+12.4 0.981581
+12.5 0.985921
+12.6 0.989307
+12.7 0.991931
+12.8 0.99395
+12.9 0.995494
+13 0.996666
+13.1 0.99755
+13.2 0.998212
+13.3 0.998704
+13.4 0.999067
+13.5 0.999333
+13.6 0.999527
+13.7 0.999667
+13.8 0.999767
+13.9 0.999839
+14 0.999889
+14.1 0.999924
+14.2 0.999949
+14.3 0.999966
+14.4 0.999977
+14.5 0.999985
+14.6 0.99999
+14.7 0.999994
+14.8 0.999996
+14.9 0.999997
+15 0.999998
+15.1 0.999999
+15.2 0.999999
+15.3 1
+15.4 1
+15.5 1
+15.6 1
+15.7 1
+15.8 1
+15.9 1
+16 1
+16.1 1
+16.2 1
+16.3 1
+16.4 1
+16.5 1
+16.6 1
+16.7 1
+16.8 1
+16.9 1
+17 1
+17.1 1
+17.2 1
+17.3 1
+17.4 1
+17.5 1
+17.6 1
+17.7 1
+17.8 1
+17.9 1
+18 1
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 2.27538e-315
+9.5 4.78604e-289
+9.6 1.79278e-264
+9.7 1.43817e-241
+9.8 2.96037e-220
+9.9 1.86669e-200
+10 4.28868e-182
+10.1 4.25416e-165
+10.2 2.15076e-149
+10.3 6.51639e-135
+10.4 1.38564e-121
+10.5 2.41161e-109
+10.6 3.98929e-98
+10.7 7.2512e-88
+10.8 1.66672e-78
+10.9 5.54908e-70
+11 3.05043e-62
+11.1 3.14058e-55
+11.2 6.83446e-49
+11.3 3.52982e-43
+11.4 4.83281e-38
+11.5 1.94899e-33
+11.6 2.55884e-29
+11.7 1.20244e-25
+11.8 2.21171e-22
+11.9 1.73227e-19
+12 6.25238e-17
+12.1 1.11971e-14
+12.2 1.06587e-12
+12.3 5.74936e-11
+12.4 1.86449e-09
+12.5 3.83913e-08
+12.6 5.27735e-07
+12.7 5.07042e-06
+12.8 3.55052e-05
+12.9 0.000188219
+13 0.000781783
+13.1 0.00262428
+13.2 0.00731974
+13.3 0.0173907
+13.4 0.0359799
+13.5 0.0661006
+13.6 0.109706
+13.7 0.166994
+13.8 0.236234
+13.9 0.314149
+14 0.396633
+14.1 0.479522
+14.2 0.559204
+14.3 0.632961
+14.4 0.699072
+14.5 0.756723
+14.6 0.805828
+14.7 0.846815
+14.8 0.880433
+14.9 0.907588
+15 0.929229
+15.1 0.946268
+15.2 0.959539
+15.3 0.969773
+15.4 0.977591
+15.5 0.983512
+15.6 0.987959
+15.7 0.991272
+15.8 0.99372
+15.9 0.995515
+16 0.996822
+16.1 0.997765
+16.2 0.99844
+16.3 0.99892
+16.4 0.999258
+16.5 0.999495
+16.6 0.999659
+16.7 0.999771
+16.8 0.999848
+16.9 0.9999
+17 0.999935
+17.1 0.999958
+17.2 0.999973
+17.3 0.999983
+17.4 0.999989
+17.5 0.999993
+17.6 0.999996
+17.7 0.999998
+17.8 0.999999
+17.9 0.999999
+18 0.999999
+18.1 1
+18.2 1
+18.3 1
+18.4 1
+18.5 1
+18.6 1
+18.7 1
+18.8 1
+18.9 1
+19 1
+19.1 1
+19.2 1
+19.3 1
+19.4 1
+19.5 1
+19.6 1
+19.7 1
+19.8 1
+19.9 1
+20 1
+20.1 1
+20.2 1
+20.3 1
+20.4 1
+20.5 1
+20.6 1
+20.7 1
+20.8 1
+20.9 1
+21 1
+21.1 1
+21.2 1
+21.3 1
+21.4 1
+21.5 1
+21.6 1
+21.7 1
+21.8 1
+21.9 1
+22 1
+22.1 1
+22.2 1
+22.3 1
+22.4 1
+22.5 1
+22.6 1
+22.7 1
+22.8 1
+22.9 1
+23 1
+23.1 1
+23.2 1
+23.3 1
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 5.38532e-322
+10.4 2.75968e-311
+10.5 1.01073e-300
+10.6 2.62138e-290
+10.7 4.75822e-280
+10.8 5.9759e-270
+10.9 5.13532e-260
+11 2.98711e-250
+11.1 1.16394e-240
+11.2 3.00784e-231
+11.3 5.10583e-222
+11.4 5.64165e-213
+11.5 4.02279e-204
+11.6 1.83615e-195
+11.7 5.32434e-187
+11.8 9.74002e-179
+11.9 1.1169e-170
+12 7.98206e-163
+12.1 3.53699e-155
+12.2 9.67446e-148
+12.3 1.62722e-140
+12.4 1.67783e-133
+12.5 1.05804e-126
+12.6 4.07366e-120
+12.7 9.56771e-114
+12.8 1.37056e-107
+12.9 1.19816e-101
+13 6.40097e-96
+13.1 2.09414e-90
+13.2 4.20769e-85
+13.3 5.21111e-80
+13.4 3.99544e-75
+13.5 1.90616e-70
+13.6 5.6917e-66
+13.7 1.07065e-61
+13.8 1.2779e-57
+13.9 9.75457e-54
+14 4.80249e-50
+14.1 1.53893e-46
+14.2 3.24087e-43
+14.3 4.53125e-40
+14.4 4.25138e-37
+14.5 2.70667e-34
+14.6 1.18291e-31
+14.7 3.59132e-29
+14.8 7.66767e-27
+14.9 1.16578e-24
+15 1.27835e-22
+15.1 1.02418e-20
+15.2 6.07387e-19
+15.3 2.70163e-17
+15.4 9.13215e-16
+15.5 2.37696e-14
+15.6 4.82675e-13
+15.7 7.74659e-12
+15.8 9.9531e-11
+15.9 1.03678e-09
+16 8.86487e-09
+16.1 6.29777e-08
+16.2 3.7615e-07
+16.3 1.91064e-06
+16.4 8.34578e-06
+16.5 3.16871e-05
+16.6 0.000105658
+16.7 0.000312475
+16.8 0.000827407
+16.9 0.00197931
+17 0.00431415
+17.1 0.00863694
+17.2 0.0160029
+17.3 0.0276374
+17.4 0.0447867
+17.5 0.0685239
+17.6 0.0995582
+17.7 0.138091
+17.8 0.183755
+17.9 0.235643
+18 0.292418
+18.1 0.352468
+18.2 0.414079
+18.3 0.475597
+18.4 0.535544
+18.5 0.592704
+18.6 0.646159
+18.7 0.695288
+18.8 0.739746
+18.9 0.779421
+19 0.814391
+19.1 0.844868
+19.2 0.871163
+19.3 0.893641
+19.4 0.912696
+19.5 0.928727
+19.6 0.942117
+19.7 0.953228
+19.8 0.962391
+19.9 0.969904
+20 0.97603
+20.1 0.980998
+20.2 0.985006
+20.3 0.988224
+20.4 0.990794
+20.5 0.992837
+20.6 0.994453
+20.7 0.995725
+20.8 0.996721
+20.9 0.997498
+21 0.998101
+21.1 0.998565
+21.2 0.998922
+21.3 0.999195
+21.4 0.999402
+21.5 0.999558
+21.6 0.999675
+21.7 0.999763
+21.8 0.999828
+21.9 0.999876
+22 0.999911
+22.1 0.999937
+22.2 0.999955
+22.3 0.999969
+22.4 0.999978
+22.5 0.999985
+22.6 0.99999
+22.7 0.999993
+22.8 0.999995
+22.9 0.999997
+23 0.999998
+23.1 0.999999
+23.2 0.999999
+23.3 0.999999
+23.4 1
+23.5 1
+23.6 1
+23.7 1
+23.8 1
+23.9 1
+24 1
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 3.44003e-317
+14.7 4.94001e-296
+14.8 6.6884e-276
+14.9 9.02568e-257
+15 1.28537e-238
+15.1 2.04863e-221
+15.2 3.88055e-205
+15.3 9.28982e-190
+15.4 2.9924e-175
+15.5 1.38234e-161
+15.6 9.77015e-149
+15.7 1.12806e-136
+15.8 2.27328e-125
+15.9 8.54739e-115
+16 6.41203e-105
+16.1 1.02645e-95
+16.2 3.75029e-87
+16.3 3.34437e-79
+16.4 7.7817e-72
+16.5 5.04793e-65
+16.6 9.74774e-59
+16.7 5.97786e-53
+16.8 1.24079e-47
+16.9 9.27903e-43
+17 2.65783e-38
+17.1 3.09521e-34
+17.2 1.55314e-30
+17.3 3.55264e-27
+17.4 3.91167e-24
+17.5 2.18496e-21
+17.6 6.5119e-19
+17.7 1.08677e-16
+17.8 1.06358e-14
+17.9 6.37778e-13
+18 2.44296e-11
+18.1 6.21719e-10
+18.2 1.09093e-08
+18.3 1.36655e-07
+18.4 1.26241e-06
+18.5 8.865e-06
+18.6 4.86711e-05
+18.7 0.000214422
+18.8 0.000776379
+18.9 0.00236172
+19 0.00615826
+19.1 0.0140184
+19.2 0.0283236
+19.3 0.051559
+19.4 0.0857053
+19.5 0.131669
+19.6 0.18897
+19.7 0.255779
+19.8 0.32927
+19.9 0.406127
+20 0.48306
+20.1 0.557205
+20.2 0.626357
+20.3 0.689047
+20.4 0.744497
+20.5 0.792504
+20.6 0.833299
+20.7 0.867403
+20.8 0.895504
+20.9 0.918363
+21 0.936743
+21.1 0.951368
+21.2 0.962892
+21.3 0.971893
+21.4 0.978862
+21.5 0.984216
+21.6 0.988296
+21.7 0.991383
+21.8 0.9937
+21.9 0.995426
+22 0.996703
+22.1 0.997641
+22.2 0.998325
+22.3 0.998819
+22.4 0.999174
+22.5 0.999427
+22.6 0.999605
+22.7 0.99973
+22.8 0.999817
+22.9 0.999877
+23 0.999918
+23.1 0.999946
+23.2 0.999965
+23.3 0.999977
+23.4 0.999985
+23.5 0.999991
+23.6 0.999994
+23.7 0.999996
+23.8 0.999998
+23.9 0.999999
+24 0.999999
+24.1 1
+24.2 1
+24.3 1
+24.4 1
+24.5 1
+24.6 1
+24.7 1
+24.8 1
+24.9 1
+25 1
+25.1 1
+25.2 1
+25.3 1
+25.4 1
+25.5 1
+25.6 1
+25.7 1
+25.8 1
+25.9 1
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 5.4009e-318
+16.7 1.69252e-292
+16.8 1.10514e-268
+16.9 1.81701e-246
+17 9.0424e-226
+17.1 1.62862e-206
+17.2 1.26274e-188
+17.3 4.98698e-172
+17.4 1.18086e-156
+17.5 1.96304e-142
+17.6 2.66866e-129
+17.7 3.43773e-117
+17.8 4.83686e-106
+17.9 8.52269e-96
+18 2.145e-86
+18.1 8.74865e-78
+18.2 6.52608e-70
+18.3 9.99571e-63
+18.4 3.51081e-56
+18.5 3.14168e-50
+18.6 7.91722e-45
+18.7 6.17911e-40
+18.8 1.63432e-35
+18.9 1.59508e-31
+19 6.22508e-28
+19.1 1.04775e-24
+19.2 8.16502e-22
+19.3 3.1488e-19
+19.4 6.39495e-17
+19.5 7.24834e-15
+19.6 4.8395e-13
+19.7 2.00122e-11
+19.8 5.36891e-10
+19.9 9.75435e-09
+20 1.24852e-07
+20.1 1.16748e-06
+20.2 8.24552e-06
+20.3 4.53444e-05
+20.4 0.000199626
+20.5 0.000721535
+20.6 0.00219068
+20.7 0.00570378
+20.8 0.0129749
+20.9 0.0262227
+21 0.0477969
+21.1 0.0796322
+21.2 0.122722
+21.3 0.176807
+21.4 0.240367
+21.5 0.310904
+21.6 0.385386
+21.7 0.460708
+21.8 0.534081
+21.9 0.603272
+22 0.666708
+22.1 0.723463
+22.2 0.773169
+22.3 0.8159
+22.4 0.852039
+22.5 0.882164
+22.6 0.906955
+22.7 0.927122
+22.8 0.943356
+22.9 0.956299
+23 0.966526
+23.1 0.974539
+23.2 0.980768
+23.3 0.985572
+23.4 0.989251
+23.5 0.992046
+23.6 0.994155
+23.7 0.995735
+23.8 0.99691
+23.9 0.997777
+24 0.998413
+24.1 0.998875
+24.2 0.999209
+24.3 0.999448
+24.4 0.999618
+24.5 0.999737
+24.6 0.999821
+24.7 0.999879
+24.8 0.999919
+24.9 0.999946
+25 0.999965
+25.1 0.999977
+25.2 0.999985
+25.3 0.999991
+25.4 0.999994
+25.5 0.999996
+25.6 0.999998
+25.7 0.999999
+25.8 0.999999
+25.9 0.999999
+26 1
+26.1 1
+26.2 1
+26.3 1
+26.4 1
+26.5 1
+26.6 1
+26.7 1
+26.8 1
+26.9 1
+27 1
+27.1 1
+27.2 1
+27.3 1
+27.4 1
+27.5 1
+27.6 1
+27.7 1
+27.8 1
+27.9 1
+28 1
+28.1 1
+28.2 1
+28.3 1
+28.4 1
+28.5 1
+28.6 1
+28.7 1
+28.8 1
+28.9 1
+29 1
+29.1 1
+29.2 1
+29.3 1
+29.4 1
+29.5 1
+29.6 1
+29.7 1
+29.8 1
+29.9 1
+30 1
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 5.31759e-308
+19.7 8.9742e-292
+19.8 4.35179e-276
+19.9 6.08116e-261
+20 2.45998e-246
+20.1 2.89878e-232
+20.2 1.00294e-218
+20.3 1.02868e-205
+20.4 3.16317e-193
+20.5 2.95392e-181
+20.6 8.49993e-170
+20.7 7.65893e-159
+20.8 2.19949e-148
+20.9 2.0521e-138
+21 6.3496e-129
+21.1 6.66078e-120
+21.2 2.42476e-111
+21.3 3.1395e-103
+21.4 1.48353e-95
+21.5 2.62815e-88
+21.6 1.7949e-81
+21.7 4.86382e-75
+21.8 5.38687e-69
+21.9 2.51364e-63
+22 5.09715e-58
+22.1 4.63537e-53
+22.2 1.95174e-48
+22.3 3.92923e-44
+22.4 3.90652e-40
+22.5 1.98126e-36
+22.6 5.29434e-33
+22.7 7.69813e-30
+22.8 6.28821e-27
+22.9 2.97812e-24
+23 8.43591e-22
+23.1 1.4735e-19
+23.2 1.63518e-17
+23.3 1.18694e-15
+23.4 5.79739e-14
+23.5 1.95832e-12
+23.6 4.69761e-11
+23.7 8.20866e-10
+23.8 1.07071e-08
+23.9 1.06711e-07
+24 8.30851e-07
+24.1 5.16137e-06
+24.2 2.60965e-05
+24.3 0.000109425
+24.4 0.000387273
+24.5 0.00117605
+24.6 0.00311166
+24.7 0.00727605
+24.8 0.0152349
+24.9 0.028912
+25 0.0502838
+25.1 0.0809629
+25.2 0.121802
+25.3 0.172645
+25.4 0.232302
+25.5 0.298736
+25.6 0.369386
+25.7 0.441537
+25.8 0.512646
+25.9 0.580574
+26 0.64371
+26.1 0.700998
+26.2 0.751892
+26.3 0.796271
+26.4 0.834336
+26.5 0.86651
+26.6 0.893351
+26.7 0.915481
+26.8 0.933532
+26.9 0.948111
+27 0.95978
+27.1 0.96904
+27.2 0.97633
+27.3 0.982024
+27.4 0.98644
+27.5 0.989839
+27.6 0.992436
+27.7 0.994408
+27.8 0.995893
+27.9 0.997005
+28 0.997831
+28.1 0.99844
+28.2 0.998887
+28.3 0.999211
+28.4 0.999445
+28.5 0.999613
+28.6 0.999732
+28.7 0.999816
+28.8 0.999874
+28.9 0.999915
+29 0.999943
+29.1 0.999962
+29.2 0.999975
+29.3 0.999984
+29.4 0.99999
+29.5 0.999993
+29.6 0.999996
+29.7 0.999997
+29.8 0.999998
+29.9 0.999999
+30 0.999999
+30.1 1
+30.2 1
+30.3 1
+30.4 1
+30.5 1
+30.6 1
+30.7 1
+30.8 1
+30.9 1
+31 1
+31.1 1
+31.2 1
+31.3 1
+31.4 1
+31.5 1
+31.6 1
+31.7 1
+31.8 1
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 0
+21.2 0
+21.3 0
+21.4 0
+21.5 0
+21.6 0
+21.7 0
+21.8 0
+21.9 0
+22 7.50689e-315
+22.1 5.47004e-293
+22.2 2.62477e-272
+22.3 9.09785e-253
+22.4 2.49831e-234
+22.5 5.95945e-217
+22.6 1.35345e-200
+22.7 3.20595e-185
+22.8 8.67103e-171
+22.9 2.92935e-157
+23 1.35098e-144
+23.1 9.2863e-133
+23.2 1.03747e-121
+23.3 2.05164e-111
+23.4 7.8099e-102
+23.5 6.21361e-93
+23.6 1.11995e-84
+23.7 4.9479e-77
+23.8 5.78601e-70
+23.9 1.93002e-63
+24 1.97482e-57
+24.1 6.65082e-52
+24.2 7.89232e-47
+24.3 3.52443e-42
+24.4 6.31033e-38
+24.5 4.81443e-34
+24.6 1.65934e-30
+24.7 2.73208e-27
+24.8 2.26666e-24
+24.9 9.9697e-22
+25 2.43976e-19
+25.1 3.47741e-17
+25.2 3.01444e-15
+25.3 1.6555e-13
+25.4 5.98568e-12
+25.5 1.47716e-10
+25.6 2.57359e-09
+25.7 3.26707e-08
+25.8 3.11209e-07
+25.9 2.28605e-06
+26 1.32819e-05
+26.1 6.24799e-05
+26.2 0.000243164
+26.3 0.000798648
+26.4 0.00225427
+26.5 0.00555995
+26.6 0.0121656
+26.7 0.0239428
+26.8 0.0429152
+26.9 0.0708497
+27 0.108833
+27.1 0.156974
+27.2 0.214329
+27.3 0.279041
+27.4 0.348647
+27.5 0.420449
+27.6 0.491849
+27.7 0.560609
+27.8 0.624991
+27.9 0.683811
+28 0.736401
+28.1 0.782538
+28.2 0.822342
+28.3 0.856174
+28.4 0.884553
+28.5 0.908075
+28.6 0.927363
+28.7 0.943023
+28.8 0.955622
+28.9 0.965672
+29 0.973625
+29.1 0.97987
+29.2 0.984738
+29.3 0.988505
+29.4 0.991399
+29.5 0.993608
+29.6 0.995281
+29.7 0.99654
+29.8 0.997481
+29.9 0.998179
+30 0.998693
+30.1 0.999069
+30.2 0.999341
+30.3 0.999538
+30.4 0.999678
+30.5 0.999778
+30.6 0.999848
+30.7 0.999896
+30.8 0.99993
+30.9 0.999953
+31 0.999969
+31.1 0.99998
+31.2 0.999987
+31.3 0.999992
+31.4 0.999995
+31.5 0.999997
+31.6 0.999998
+31.7 0.999999
+31.8 0.999999
+31.9 1
+32 1
+32.1 1
+32.2 1
+32.3 1
+32.4 1
+32.5 1
+32.6 1
+32.7 1
+32.8 1
+32.9 1
+33 1
+33.1 1
+33.2 1
+33.3 1
+33.4 1
+33.5 1
+33.6 1
+33.7 1
+33.8 1
+33.9 1
+34 1
+34.1 1
+34.2 1
+34.3 1
+34.4 1
+34.5 1
+34.6 1
+34.7 1
+34.8 1
+34.9 1
+35 1
+35.1 1
+35.2 1
+35.3 1
+35.4 1
+35.5 1
+35.6 1
+35.7 1
+35.8 1
+35.9 1
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 0
+21.2 0
+21.3 0
+21.4 0
+21.5 0
+21.6 0
+21.7 0
+21.8 0
+21.9 0
+22 0
+22.1 0
+22.2 0
+22.3 0
+22.4 0
+22.5 0
+22.6 0
+22.7 0
+22.8 0
+22.9 0
+23 0
+23.1 0
+23.2 0
+23.3 0
+23.4 0
+23.5 0
+23.6 0
+23.7 0
+23.8 0
+23.9 0
+24 0
+24.1 0
+24.2 0
+24.3 1.85644e-317
+24.4 5.48773e-305
+24.5 9.39425e-293
+24.6 9.18977e-281
+24.7 5.07263e-269
+24.8 1.56125e-257
+24.9 2.64958e-246
+25 2.45385e-235
+25.1 1.22842e-224
+25.2 3.2954e-214
+25.3 4.70067e-204
+25.4 3.54102e-194
+25.5 1.40042e-184
+25.6 2.8934e-175
+25.7 3.1109e-166
+25.8 1.73551e-157
+25.9 5.0145e-149
+26 7.49773e-141
+26.1 5.80282e-133
+26.2 2.32766e-125
+26.3 4.85063e-118
+26.4 5.26938e-111
+26.5 2.99742e-104
+26.6 8.97757e-98
+26.7 1.42506e-91
+26.8 1.20795e-85
+26.9 5.51458e-80
+27 1.36881e-74
+27.1 1.86662e-69
+27.2 1.41435e-64
+27.3 6.02715e-60
+27.4 1.46332e-55
+27.5 2.052e-51
+27.6 1.68603e-47
+27.7 8.24e-44
+27.8 2.43295e-40
+27.9 4.41043e-37
+28 4.99076e-34
+28.1 3.58554e-31
+28.2 1.664e-28
+28.3 5.07663e-26
+28.4 1.03639e-23
+28.5 1.44125e-21
+28.6 1.38995e-19
+28.7 9.46374e-18
+28.8 4.63082e-16
+28.9 1.65747e-14
+29 4.41571e-13
+29.1 8.90785e-12
+29.2 1.38382e-10
+29.3 1.68294e-09
+29.4 1.62821e-08
+29.5 1.27281e-07
+29.6 8.16155e-07
+29.7 4.35555e-06
+29.8 1.9617e-05
+29.9 7.55682e-05
+30 0.000252169
+30.1 0.000737807
+30.2 0.00191456
+30.3 0.0044541
+30.4 0.00938486
+30.5 0.0180801
+30.6 0.0321313
+30.7 0.0531115
+30.8 0.0822801
+30.9 0.120309
+31 0.167111
+31.1 0.221807
+31.2 0.282843
+31.3 0.348205
+31.4 0.415675
+31.5 0.483086
+31.6 0.548513
+31.7 0.610399
+31.8 0.667612
+31.9 0.719441
+32 0.76555
+32.1 0.805912
+32.2 0.840736
+32.3 0.870393
+32.4 0.895353
+32.5 0.916137
+32.6 0.933273
+32.7 0.947274
+32.8 0.958616
+32.9 0.967731
+33 0.975
+33.1 0.980755
+33.2 0.985279
+33.3 0.988811
+33.4 0.99155
+33.5 0.993659
+33.6 0.995272
+33.7 0.996498
+33.8 0.997424
+33.9 0.998117
+34 0.998634
+34.1 0.999015
+34.2 0.999295
+34.3 0.999499
+34.4 0.999647
+34.5 0.999753
+34.6 0.999829
+34.7 0.999882
+34.8 0.999919
+34.9 0.999945
+35 0.999963
+35.1 0.999976
+35.2 0.999984
+35.3 0.999989
+35.4 0.999993
+35.5 0.999996
+35.6 0.999997
+35.7 0.999998
+35.8 0.999999
+35.9 0.999999
+36 1
+36.1 1
+36.2 1
+36.3 1
+36.4 1
+36.5 1
+36.6 1
+36.7 1
+36.8 1
+36.9 1
+37 1
+37.1 1
+37.2 1
+37.3 1
+37.4 1
+37.5 1
+37.6 1
+37.7 1
+37.8 1
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e
+-5 0
+-4.9 0
+-4.8 0
+-4.7 0
+-4.6 0
+-4.5 0
+-4.4 0
+-4.3 0
+-4.2 0
+-4.1 0
+-4 0
+-3.9 0
+-3.8 0
+-3.7 0
+-3.6 0
+-3.5 0
+-3.4 0
+-3.3 0
+-3.2 0
+-3.1 0
+-3 0
+-2.9 0
+-2.8 0
+-2.7 0
+-2.6 0
+-2.5 0
+-2.4 0
+-2.3 0
+-2.2 0
+-2.1 0
+-2 0
+-1.9 0
+-1.8 0
+-1.7 0
+-1.6 0
+-1.5 0
+-1.4 0
+-1.3 0
+-1.2 0
+-1.1 0
+-1 0
+-0.9 0
+-0.8 0
+-0.7 0
+-0.6 0
+-0.5 0
+-0.4 0
+-0.3 0
+-0.2 0
+-0.1 0
+-1.02696e-15 0
+0.1 0
+0.2 0
+0.3 0
+0.4 0
+0.5 0
+0.6 0
+0.7 0
+0.8 0
+0.9 0
+1 0
+1.1 0
+1.2 0
+1.3 0
+1.4 0
+1.5 0
+1.6 0
+1.7 0
+1.8 0
+1.9 0
+2 0
+2.1 0
+2.2 0
+2.3 0
+2.4 0
+2.5 0
+2.6 0
+2.7 0
+2.8 0
+2.9 0
+3 0
+3.1 0
+3.2 0
+3.3 0
+3.4 0
+3.5 0
+3.6 0
+3.7 0
+3.8 0
+3.9 0
+4 0
+4.1 0
+4.2 0
+4.3 0
+4.4 0
+4.5 0
+4.6 0
+4.7 0
+4.8 0
+4.9 0
+5 0
+5.1 0
+5.2 0
+5.3 0
+5.4 0
+5.5 0
+5.6 0
+5.7 0
+5.8 0
+5.9 0
+6 0
+6.1 0
+6.2 0
+6.3 0
+6.4 0
+6.5 0
+6.6 0
+6.7 0
+6.8 0
+6.9 0
+7 0
+7.1 0
+7.2 0
+7.3 0
+7.4 0
+7.5 0
+7.6 0
+7.7 0
+7.8 0
+7.9 0
+8 0
+8.1 0
+8.2 0
+8.3 0
+8.4 0
+8.5 0
+8.6 0
+8.7 0
+8.8 0
+8.9 0
+9 0
+9.1 0
+9.2 0
+9.3 0
+9.4 0
+9.5 0
+9.6 0
+9.7 0
+9.8 0
+9.9 0
+10 0
+10.1 0
+10.2 0
+10.3 0
+10.4 0
+10.5 0
+10.6 0
+10.7 0
+10.8 0
+10.9 0
+11 0
+11.1 0
+11.2 0
+11.3 0
+11.4 0
+11.5 0
+11.6 0
+11.7 0
+11.8 0
+11.9 0
+12 0
+12.1 0
+12.2 0
+12.3 0
+12.4 0
+12.5 0
+12.6 0
+12.7 0
+12.8 0
+12.9 0
+13 0
+13.1 0
+13.2 0
+13.3 0
+13.4 0
+13.5 0
+13.6 0
+13.7 0
+13.8 0
+13.9 0
+14 0
+14.1 0
+14.2 0
+14.3 0
+14.4 0
+14.5 0
+14.6 0
+14.7 0
+14.8 0
+14.9 0
+15 0
+15.1 0
+15.2 0
+15.3 0
+15.4 0
+15.5 0
+15.6 0
+15.7 0
+15.8 0
+15.9 0
+16 0
+16.1 0
+16.2 0
+16.3 0
+16.4 0
+16.5 0
+16.6 0
+16.7 0
+16.8 0
+16.9 0
+17 0
+17.1 0
+17.2 0
+17.3 0
+17.4 0
+17.5 0
+17.6 0
+17.7 0
+17.8 0
+17.9 0
+18 0
+18.1 0
+18.2 0
+18.3 0
+18.4 0
+18.5 0
+18.6 0
+18.7 0
+18.8 0
+18.9 0
+19 0
+19.1 0
+19.2 0
+19.3 0
+19.4 0
+19.5 0
+19.6 0
+19.7 0
+19.8 0
+19.9 0
+20 0
+20.1 0
+20.2 0
+20.3 0
+20.4 0
+20.5 0
+20.6 0
+20.7 0
+20.8 0
+20.9 0
+21 0
+21.1 0
+21.2 0
+21.3 0
+21.4 0
+21.5 0
+21.6 0
+21.7 0
+21.8 0
+21.9 0
+22 0
+22.1 0
+22.2 0
+22.3 0
+22.4 0
+22.5 0
+22.6 0
+22.7 0
+22.8 0
+22.9 0
+23 0
+23.1 0
+23.2 0
+23.3 0
+23.4 0
+23.5 0
+23.6 0
+23.7 0
+23.8 0
+23.9 0
+24 0
+24.1 0
+24.2 0
+24.3 0
+24.4 0
+24.5 0
+24.6 0
+24.7 0
+24.8 0
+24.9 0
+25 0
+25.1 0
+25.2 0
+25.3 0
+25.4 0
+25.5 0
+25.6 0
+25.7 0
+25.8 0
+25.9 0
+26 0
+26.1 0
+26.2 0
+26.3 0
+26.4 0
+26.5 0
+26.6 0
+26.7 0
+26.8 0
+26.9 0
+27 0
+27.1 0
+27.2 0
+27.3 2.96439e-323
+27.4 4.72707e-304
+27.5 1.16193e-285
+27.6 4.4181e-268
+27.7 2.70123e-251
+27.8 2.76418e-235
+27.9 4.93428e-220
+28 1.60342e-205
+28.1 9.90927e-192
+28.2 1.21802e-178
+28.3 3.11707e-166
+28.4 1.7399e-154
+28.5 2.2208e-143
+28.6 6.79949e-133
+28.7 5.24096e-123
+28.8 1.0677e-113
+28.9 6.03711e-105
+29 9.95042e-97
+29.1 5.02077e-89
+29.2 8.14413e-82
+29.3 4.45849e-75
+29.4 8.64502e-69
+29.5 6.22783e-63
+29.6 1.74745e-57
+29.7 2.00068e-52
+29.8 9.78395e-48
+29.9 2.13745e-43
+30 2.17962e-39
+30.1 1.08284e-35
+30.2 2.7325e-32
+30.3 3.64714e-29
+30.4 2.67785e-26
+30.5 1.12341e-23
+30.6 2.79311e-21
+30.7 4.26306e-19
+30.8 4.13144e-17
+30.9 2.62581e-15
+31 1.12879e-13
+31.1 3.37996e-12
+31.2 7.24925e-11
+31.3 1.14354e-09
+31.4 1.36037e-08
+31.5 1.24955e-07
+31.6 9.061e-07
+31.7 5.29624e-06
+31.8 2.54439e-05
+31.9 0.000102309
+32 0.000350186
+32.1 0.00103646
+32.2 0.00269139
+32.3 0.00621427
+32.4 0.0129164
+32.5 0.0244422
+32.6 0.0425476
+32.7 0.0687764
+32.8 0.104124
+32.9 0.148794
+33 0.202106
+33.1 0.262589
+33.2 0.328195
+33.3 0.396589
+33.4 0.465436
+33.5 0.532628
+33.6 0.596441
+33.7 0.655602
+33.8 0.709296
+33.9 0.757119
+34 0.799007
+34.1 0.835154
+34.2 0.865932
+34.3 0.891827
+34.4 0.913377
+34.5 0.931132
+34.6 0.945628
+34.7 0.957361
+34.8 0.966783
+34.9 0.97429
+35 0.980227
+35.1 0.984891
+35.2 0.988528
+35.3 0.991346
+35.4 0.993513
+35.5 0.99517
+35.6 0.996427
+35.7 0.997375
+35.8 0.998084
+35.9 0.998612
+36 0.999001
+36.1 0.999287
+36.2 0.999494
+36.3 0.999644
+36.4 0.999752
+36.5 0.999828
+36.6 0.999882
+36.7 0.999919
+36.8 0.999946
+36.9 0.999964
+37 0.999976
+37.1 0.999984
+37.2 0.99999
+37.3 0.999993
+37.4 0.999996
+37.5 0.999997
+37.6 0.999998
+37.7 0.999999
+37.8 0.999999
+37.9 1
+38 1
+38.1 1
+38.2 1
+38.3 1
+38.4 1
+38.5 1
+38.6 1
+38.7 1
+38.8 1
+38.9 1
+39 1
+39.1 1
+39.2 1
+39.3 1
+39.4 1
+39.5 1
+39.6 1
+39.7 1
+39.8 1
+39.9 1
+e